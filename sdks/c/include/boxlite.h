@@ -64,6 +64,17 @@ typedef enum BoxliteErrorCode {
   SessionReaped = 21,
 } BoxliteErrorCode;
 
+// Kind of a `CEventRecord` produced by `boxlite_runtime_drain_records`.
+typedef enum BoxliteEventKind {
+  // `data`/`len` hold a stdout chunk.
+  BoxliteEventKindStdout = 0,
+  // `data`/`len` hold a stderr chunk.
+  BoxliteEventKindStderr = 1,
+  // `code` holds the exit code; `data` is NULL. Always the last record
+  // for its execution.
+  BoxliteEventKindExit = 2,
+} BoxliteEventKind;
+
 // Transport protocol for a port forwarding rule.
 typedef enum BoxlitePortProtocol {
   BoxlitePortProtocolTcp = 0,
@@ -94,12 +105,27 @@ typedef struct BoxRunner BoxRunner;
 // SDKs.
 typedef struct CredentialHandle CredentialHandle;
 
+// Owns the chunk buffers referenced by one batch of `CEventRecord`s.
+typedef struct EventBatch EventBatch;
+
 // Opaque handle to a running command execution.
 typedef struct ExecutionHandle ExecutionHandle;
 
+// Opaque executor options handle. Owns an [`ExecutorConfig`] that the
+// setters mutate in place before construction.
+typedef struct ExecutorOptionsHandle ExecutorOptionsHandle;
+
 // Opaque handle to runtime image operations.
 typedef struct ImageHandle ImageHandle;
 
+// Opaque list filter. Owns a core [`BoxListFilter`] that the setters
+// mutate in place before a listing call reads it.
+typedef struct ListFilterHandle ListFilterHandle;
+
+// A running metrics subscription. Ticks stop on free; the flag also
+// suppresses batches already queued but not yet drained.
+typedef struct MetricsSubscriptionHandle MetricsSubscriptionHandle;
+
 typedef struct OptionsHandle OptionsHandle;
 
 // Opaque REST options handle. Owns a core [`BoxliteRestOptions`] that
@@ -150,9 +176,44 @@ typedef void (*CBoxRemoveBoxCb)(CBoxliteError*, void*);
 // Box start completion.
 typedef void (*CBoxStartBoxCb)(CBoxliteError*, void*);
 
+// Outcome of `boxlite_create_boxes`: one slot per requested box, in
+// request order.
+typedef struct CBoxBatchCreateResult {
+  // Created boxes, NULL where that create failed. The caller owns each
+  // handle and frees it with `boxlite_box_free`.
+  CBoxHandle **handles;
+  // Per-slot error; `code` is `Ok` where the create succeeded.
+  CBoxliteError *errors;
+  int count;
+  // Number of slots whose create failed.
+  int failed;
+} CBoxBatchCreateResult;
+
+// Batch create completion. The callee owns the result and every handle in it.
+typedef void (*CBoxCreateBoxesCb)(struct CBoxBatchCreateResult*, CBoxliteError*, void*);
+
+// Outcome of `boxlite_start_boxes`, `boxlite_stop_boxes` and
+// `boxlite_remove_boxes`: one error slot per box, in request order.
+typedef struct CBoxBatchResult {
+  // Per-slot error; `code` is `Ok` where the operation succeeded.
+  CBoxliteError *errors;
+  int count;
+  // Number of slots whose operation failed.
+  int failed;
+} CBoxBatchResult;
+
+// Batch start/stop/remove completion. The callee owns the result.
+typedef void (*CBoxBatchCb)(struct CBoxBatchResult*, CBoxliteError*, void*);
+
 // Copy (into / out of) completion.
 typedef void (*CBoxCopyCb)(CBoxliteError*, void*);
 
+// Streamed copy progress: running byte count.
+typedef void (*CBoxCopyProgressCb)(uint64_t, void*);
+
+// One tar chunk of a streamed copy out. The data is only valid during the call.
+typedef void (*CBoxCopyChunkCb)(const uint8_t*, uintptr_t, void*);
+
 // C-compatible command descriptor with all BoxCommand options.
 //
 // All string fields are nullable — NULL means "use default".
@@ -178,6 +239,37 @@ typedef struct BoxliteCommand {
   int tty;
 } BoxliteCommand;
 
+// Per-execution stdout/stderr pacing for `boxlite_box_exec_paced`.
+//
+// Kept out of `BoxliteCommand` so that struct keeps the layout callers
+// built against older headers allocate. All fields default to 0 =
+// "deliver every chunk as received, no per-execution limit", so a
+// zero-initialized struct (or a NULL pointer) keeps the historical behavior.
+typedef struct BoxliteOutputPacing {
+  // Merge consecutive stdout (or stderr) chunks into one callback until
+  // at least this many bytes are collected. 0 = no coalescing.
+  int coalesce_bytes;
+  // How long a partially filled coalesced chunk may wait for more
+  // output, in milliseconds. 0 = merge only output that is already
+  // buffered, never wait. Ignored when `coalesce_bytes` is 0.
+  int coalesce_ms;
+  // Maximum stdout/stderr callbacks of this execution that may be queued
+  // but not yet drained. When exhausted the execution's output pumps
+  // stop reading until the drain catches up, instead of flooding the
+  // shared runtime queue. The stall reaches the guest: past 256 KiB of
+  // unread output per stream the host stops reading the process and
+  // the process blocks on its pipe. 0 = unlimited.
+  int output_credits;
+} BoxliteOutputPacing;
+
+// One buffer of a vectored stdin write (`boxlite_execution_stdin_writev`).
+// Same shape as POSIX `struct iovec`, without pulling in `<sys/uio.h>`.
+typedef struct BoxliteIoSlice {
+  // Start of the buffer; may be NULL only when `len` is 0.
+  const uint8_t *data;
+  size_t len;
+} BoxliteIoSlice;
+
 typedef struct ExecutionHandle CExecutionHandle;
 
 // Streaming stdout chunk callback.
@@ -215,8 +307,52 @@ typedef struct ExecResult {
 
 typedef struct ExecResult CBoxliteExecResult;
 
+// Capture limits for `boxlite_simple_run_captured`. A zero-initialized
+// struct (or a NULL pointer) keeps all output, unbounded, without
+// spilling.
+typedef struct BoxliteCaptureOptions {
+  // Most bytes kept in memory per stream. 0 = unlimited.
+  size_t max_bytes;
+  // How many of `max_bytes` come from the end of the stream; the rest
+  // come from its start. Clamped to `max_bytes`. Ignored when
+  // `max_bytes` is 0.
+  size_t tail_bytes;
+  // If non-NULL, all of stdout is also written to this file (created
+  // or truncated), regardless of `max_bytes`.
+  const char *stdout_path;
+  // Same as `stdout_path`, for stderr.
+  const char *stderr_path;
+} BoxliteCaptureOptions;
+
+// One captured stream. `data[..head_len]` is the start of the stream and
+// `data[head_len..len]` its end; when `truncated` is set, the
+// `total_len - len` bytes between them were dropped.
+typedef struct CapturedStream {
+  // Retained bytes; NULL when `len` is 0. May contain NUL bytes.
+  uint8_t *data;
+  size_t len;
+  size_t head_len;
+  // Bytes the command wrote to the stream in total.
+  uint64_t total_len;
+  int truncated;
+} CapturedStream;
+
+// Result of `boxlite_simple_run_captured`. Free with
+// `boxlite_capture_result_free`.
+typedef struct CaptureResult {
+  int exit_code;
+  struct CapturedStream stdout_capture;
+  struct CapturedStream stderr_capture;
+} CaptureResult;
+
+typedef struct CaptureResult CBoxliteCaptureResult;
+
+typedef struct ExecutorOptionsHandle CBoxliteExecutorOptions;
+
 typedef struct ImageHandle CBoxliteImageHandle;
 
+typedef struct ListFilterHandle CBoxliteListFilter;
+
 typedef struct CImagePullResult {
   char *reference;
   char *config_digest;
@@ -226,6 +362,24 @@ typedef struct CImagePullResult {
 // Image pull completion.
 typedef void (*CBoxImagePullCb)(struct CImagePullResult*, CBoxliteError*, void*);
 
+// Snapshot of an image pull in flight, passed to the progress callback of
+// `boxlite_image_pull_with_progress`. Byte counts are compressed blob
+// bytes; rates are averages since the layer downloads started.
+typedef struct CImagePullProgress {
+  uint64_t bytes_downloaded;
+  // Declared size of the layers being downloaded (cached layers excluded).
+  uint64_t bytes_total;
+  // Layers downloaded and verified, including those already cached.
+  int layers_completed;
+  int layers_total;
+  double elapsed_secs;
+  double bytes_per_second;
+  double layers_per_second;
+} CImagePullProgress;
+
+// Image pull progress. The snapshot is only valid during the call.
+typedef void (*CBoxImagePullProgressCb)(const struct CImagePullProgress*, void*);
+
 typedef struct CImageInfo {
   char *reference;
   char *repository;
@@ -254,6 +408,12 @@ typedef struct CBoxInfo {
   int cpus;
   int memory_mib;
   int64_t created_at;
+  // Host CPUs the VMM is pinned to, as a kernel list ("0-3,8"); NULL
+  // when the box is not running or has no placement.
+  char *placement_cpus;
+  // NUMA nodes guest memory is bound to, same format; NULL with
+  // `placement_cpus`, "" on hosts without NUMA (memory left unbound).
+  char *placement_mems;
 } CBoxInfo;
 
 // Box info completion.
@@ -262,11 +422,66 @@ typedef void (*CBoxInfoCb)(struct CBoxInfo*, CBoxliteError*, void*);
 typedef struct CBoxInfoList {
   struct CBoxInfo *items;
   int count;
+  // Boxes matching the filter across all pages (`count` for unfiltered
+  // listings).
+  int total;
 } CBoxInfoList;
 
 // Box info list completion.
 typedef void (*CBoxInfoListCb)(struct CBoxInfoList*, CBoxliteError*, void*);
 
+// One box of a `CBoxInfoArena`. The string fields are byte offsets into
+// the arena's `strings`, each the start of a NUL-terminated string; an
+// unnamed box's `name` and an unplaced box's `placement_*` are "".
+typedef struct CBoxInfoRow {
+  uint32_t id;
+  uint32_t name;
+  uint32_t image;
+  uint32_t status;
+  int running;
+  int pid;
+  int cpus;
+  int memory_mib;
+  int64_t created_at;
+  uint32_t placement_cpus;
+  uint32_t placement_mems;
+} CBoxInfoRow;
+
+// A listing page whose strings all live in one buffer. Freed as a whole
+// by `boxlite_free_box_info_arena`.
+typedef struct CBoxInfoArena {
+  struct CBoxInfoRow *rows;
+  int count;
+  // Boxes matching the filter across all pages.
+  int total;
+  char *strings;
+  size_t strings_len;
+} CBoxInfoArena;
+
+// Box info arena completion. The callee owns the arena.
+typedef void (*CBoxInfoArenaCb)(struct CBoxInfoArena*, CBoxliteError*, void*);
+
+// Summary of a recorded distribution. Quantiles are rounded up to the
+// histogram bucket bound (within 12.5% of the exact value) and capped at
+// `max`. All zero until the first sample.
+typedef struct CHistogramSummary {
+  uint64_t count;
+  uint64_t sum;
+  uint64_t max;
+  uint64_t p50;
+  uint64_t p90;
+  uint64_t p99;
+  uint64_t p999;
+} CHistogramSummary;
+
+// Per-box metrics.
+//
+// The fields up to `network_tcp_errors` keep their original layout.
+// `struct_size` follows them and is `sizeof(CBoxMetrics)` as built into
+// the library; fields after it are only ever appended, so a caller
+// compiled against a newer header checks `struct_size` before reading
+// fields it knows the library may lack. Libraries from before
+// `struct_size` (see `boxlite_version`) end at `network_tcp_errors`.
 typedef struct CBoxMetrics {
   double cpu_percent;
   int64_t memory_bytes;
@@ -280,22 +495,154 @@ typedef struct CBoxMetrics {
   int64_t network_bytes_received;
   int network_tcp_connections;
   int network_tcp_errors;
+  uint32_t struct_size;
+  // Init stage timings in milliseconds (0 = not recorded).
+  int64_t stage_filesystem_setup_ms;
+  int64_t stage_image_prepare_ms;
+  int64_t stage_guest_rootfs_ms;
+  int64_t stage_box_config_ms;
+  int64_t stage_box_spawn_ms;
+  int64_t stage_container_init_ms;
+  // Exec request to first output or exit status, in microseconds.
+  struct CHistogramSummary exec_response_latency_us;
+  // Resident memory of every host process in the box's sandbox, guest
+  // RAM included (0 = not running).
+  int64_t host_rss_bytes;
 } CBoxMetrics;
 
 // Per-box metrics completion.
 typedef void (*CBoxMetricsCb)(struct CBoxMetrics*, CBoxliteError*, void*);
 
+// Guest memory around one `boxlite_box_reclaim_memory` call. "In use" is
+// guest RAM minus free memory, the guest's view of what it holds on the
+// host.
+typedef struct CMemoryReclaimResult {
+  uint64_t total_bytes;
+  uint64_t in_use_before_bytes;
+  uint64_t in_use_after_bytes;
+  uint64_t cached_before_bytes;
+  uint64_t cached_after_bytes;
+  // 0 if in-use memory was already under the target.
+  int reclaimed;
+} CMemoryReclaimResult;
+
+// Guest memory reclaim completion.
+typedef void (*CMemoryReclaimCb)(struct CMemoryReclaimResult*, CBoxliteError*, void*);
+
+// One task of the box's init pipeline; times are relative to init start.
+typedef struct CInitTaskTrace {
+  char *name;
+  int64_t start_ms;
+  int64_t duration_ms;
+  // 1 if the task is on the chain that set `create_duration_ms`.
+  int on_critical_path;
+} CInitTaskTrace;
+
+// Init timeline of a box, ordered by task start time.
+typedef struct CInitTrace {
+  struct CInitTaskTrace *tasks;
+  int count;
+  int64_t create_duration_ms;
+} CInitTrace;
+
+// Box init trace completion. The callee owns the trace.
+typedef void (*CBoxInitTraceCb)(struct CInitTrace*, CBoxliteError*, void*);
+
+// One running box in a `CBoxMetricsBatch`. `box_id` is a byte offset
+// into the batch's `strings`. -1 marks a figure the sample lacks.
+typedef struct CBoxMetricsSample {
+  uint32_t box_id;
+  // CPU since the previous tick, in percent of one CPU (-1 on the box's
+  // first tick).
+  double cpu_percent;
+  // Cumulative CPU time of the box's sandbox (-1 without a cgroup).
+  int64_t cpu_usage_usec;
+  // Host memory charged to the box's cgroup, or the shim's RSS without
+  // one.
+  int64_t memory_bytes;
+} CBoxMetricsSample;
+
+// Every running box at one tick of a metrics subscription. Borrowed: valid
+// only until the callback returns.
+typedef struct CBoxMetricsBatch {
+  const struct CBoxMetricsSample *samples;
+  int count;
+  const char *strings;
+  size_t strings_len;
+} CBoxMetricsBatch;
+
+// Metrics subscription tick. The batch is borrowed for the call.
+typedef void (*CBoxMetricsBatchCb)(const struct CBoxMetricsBatch*, CBoxliteError*, void*);
+
+typedef struct MetricsSubscriptionHandle CMetricsSubscription;
+
+// Runtime-wide metrics. Versioned by `struct_size` like [`CBoxMetrics`];
+// the fields before it predate it.
 typedef struct CRuntimeMetrics {
   int boxes_created_total;
   int boxes_failed_total;
   int num_running_boxes;
   int total_commands_executed;
   int total_exec_errors;
+  // Boxes the warm pool keeps started (0 = no pool).
+  int warm_pool_size;
+  // Pooled boxes ready to be claimed right now.
+  int warm_pool_ready;
+  // Creates served from the pool.
+  int warm_pool_hits;
+  // Creates matching the pool that found it empty.
+  int warm_pool_misses;
+  // Boxes booted into the pool; sample it to get the refill rate.
+  int warm_pool_refills;
+  uint32_t struct_size;
+  // Box create/start call to ready, in microseconds (cold starts and
+  // restarts).
+  struct CHistogramSummary create_latency_us;
+  // VM spawn to guest agent ready, in microseconds.
+  struct CHistogramSummary boot_latency_us;
+  // `exec` call to process started in the guest, in microseconds.
+  struct CHistogramSummary exec_start_latency_us;
+  // Events buffered in this runtime's queue each time a drain call
+  // took one, including it.
+  struct CHistogramSummary drain_queue_depth;
 } CRuntimeMetrics;
 
 // Runtime metrics completion.
 typedef void (*CRuntimeMetricsCb)(struct CRuntimeMetrics*, CBoxliteError*, void*);
 
+// Event queue counters of one runtime. The caller allocates it and sets
+// `struct_size` to `sizeof(CQueueStats)` from its header; the library
+// fills only that many bytes and sets `struct_size` to the bytes it
+// wrote, so callers and libraries built against different headers agree
+// on which fields are valid. An event's age runs from the moment its producer pushed
+// it to the moment a drain call took it: growing ages with a low
+// `callback_us` point at a drain loop that runs too rarely, a high
+// `callback_us` at slow callbacks, and low ages at the backend itself.
+typedef struct CQueueStats {
+  uint32_t struct_size;
+  // Events buffered right now.
+  uint64_t depth;
+  // Largest depth a producer has seen since the runtime was created.
+  uint64_t peak_depth;
+  // Per-lane capacity; producers yield once their lane holds this many.
+  uint64_t capacity;
+  // Times a producer found its lane full and yielded before retrying.
+  uint64_t producer_yields;
+  // Events discarded because they were posted after the queue closed.
+  uint64_t dropped_after_close;
+  // Age of stdout/stderr and copy-out chunks, in microseconds.
+  struct CHistogramSummary output_age_us;
+  // Age of execution exits, in microseconds.
+  struct CHistogramSummary exit_age_us;
+  // Age of op completions (create, start, wait, ...), in microseconds.
+  struct CHistogramSummary completion_age_us;
+  // Age of image pull and copy progress events and metrics batches, in
+  // microseconds.
+  struct CHistogramSummary progress_age_us;
+  // Time spent inside each user callback, in microseconds.
+  struct CHistogramSummary callback_us;
+} CQueueStats;
+
 typedef struct CredentialHandle CBoxliteCredential;
 
 typedef struct RestOptionsHandle CBoxliteRestOptions;
@@ -310,6 +657,20 @@ typedef struct BoxliteImageRegistry {
   const char *bearer_token;
 } BoxliteImageRegistry;
 
+// Plain-C execution event filled by `boxlite_runtime_drain_records`.
+typedef struct CEventRecord {
+  enum BoxliteEventKind kind;
+  // `user_data` the execution's callbacks were registered with.
+  void *user_data;
+  // Chunk bytes, owned by the batch; NULL for exit records.
+  const uint8_t *data;
+  size_t len;
+  // Exit code for exit records; 0 otherwise.
+  int code;
+} CEventRecord;
+
+typedef struct EventBatch CBoxliteEventBatch;
+
 // Runtime shutdown completion.
 typedef void (*CRuntimeShutdownCb)(CBoxliteError*, void*);
 
@@ -338,6 +699,32 @@ void boxlite_advanced_options_free(CAdvancedBoxOptions *opts);
 // genuinely can't sandbox). Null `opts` is a no-op.
 void boxlite_advanced_options_set_security_enabled(CAdvancedBoxOptions *opts, int enabled);
 
+// Have the guest agent reclaim memory periodically: every `interval_secs`
+// (0 = default, 60 s) it drops clean page cache and compacts free memory
+// when in-use memory exceeds `target_mib` (0 = on every check), and the
+// balloon device's free-page reporting returns the freed pages to the host.
+// Off unless called. Null `opts` is a no-op.
+void boxlite_advanced_options_set_memory_reclaim(CAdvancedBoxOptions *opts,
+                                                 uint32_t target_mib,
+                                                 uint32_t interval_secs);
+
+// Pin the box's VMM to the host CPUs in `cpus`, a kernel CPU list such as
+// "0-3,8". Guest memory is bound to the NUMA nodes those CPUs belong to.
+// Linux only; the box fails to start elsewhere, or if a CPU is not usable
+// by the runtime process.
+enum BoxliteErrorCode boxlite_advanced_options_set_cpuset(CAdvancedBoxOptions *opts,
+                                                          const char *cpus,
+                                                          CBoxliteError *out_error);
+
+// Run the box's VMM on the CPUs of NUMA node `node`, with guest memory
+// bound to that node. Null `opts` is a no-op.
+void boxlite_advanced_options_set_numa_node(CAdvancedBoxOptions *opts, uint32_t node);
+
+// Let the runtime place the box: on the NUMA node with the most spare CPUs
+// among running boxes, pinned to that node's least-used CPUs (one per
+// vCPU) with memory bound to it. Null `opts` is a no-op.
+void boxlite_advanced_options_set_auto_placement(CAdvancedBoxOptions *opts);
+
 enum BoxliteErrorCode boxlite_create_box(CBoxliteRuntime *runtime,
                                          CBoxliteOptions *opts,
                                          CBoxCreateBoxCb cb,
@@ -380,6 +767,59 @@ enum BoxliteErrorCode boxlite_start_box(CBoxHandle *handle,
                                         void *user_data,
                                         CBoxliteError *out_error);
 
+// Create `count` boxes in one call, at most `concurrency` at a time
+// (`<= 0` picks the runtime default).
+//
+// Consumes every `opts[i]` once the call returns `Ok`; on an argument error
+// none are consumed. Options with a start snapshot are rejected (create
+// those with `boxlite_create_box`). One failed create does not stop the
+// others, and the callback fires once with every outcome. On local
+// runtimes the database writes of the batch share one fsync.
+enum BoxliteErrorCode boxlite_create_boxes(CBoxliteRuntime *runtime,
+                                           CBoxliteOptions *const *opts,
+                                           int count,
+                                           int concurrency,
+                                           CBoxCreateBoxesCb cb,
+                                           void *user_data,
+                                           CBoxliteError *out_error);
+
+// Start `count` boxes in one call. Concurrency and reporting as for
+// `boxlite_create_boxes`; the handles stay owned by the caller.
+enum BoxliteErrorCode boxlite_start_boxes(CBoxliteRuntime *runtime,
+                                          CBoxHandle *const *handles,
+                                          int count,
+                                          int concurrency,
+                                          CBoxBatchCb cb,
+                                          void *user_data,
+                                          CBoxliteError *out_error);
+
+// Stop `count` boxes in one call. Concurrency and reporting as for
+// `boxlite_create_boxes`; the handles stay owned by the caller.
+enum BoxliteErrorCode boxlite_stop_boxes(CBoxliteRuntime *runtime,
+                                         CBoxHandle *const *handles,
+                                         int count,
+                                         int concurrency,
+                                         CBoxBatchCb cb,
+                                         void *user_data,
+                                         CBoxliteError *out_error);
+
+// Remove `count` boxes by ID or name in one call. Concurrency and
+// reporting as for `boxlite_create_boxes`.
+enum BoxliteErrorCode boxlite_remove_boxes(CBoxliteRuntime *runtime,
+                                           const char *const *ids_or_names,
+                                           int count,
+                                           int force,
+                                           int concurrency,
+                                           CBoxBatchCb cb,
+                                           void *user_data,
+                                           CBoxliteError *out_error);
+
+// Free a `CBoxBatchCreateResult` and its error messages. The box handles
+// in it are not freed.
+void boxlite_free_box_batch_create_result(struct CBoxBatchCreateResult *result);
+
+void boxlite_free_box_batch_result(struct CBoxBatchResult *result);
+
 char *boxlite_box_id(CBoxHandle *handle);
 
 void boxlite_box_free(CBoxHandle *handle);
@@ -391,6 +831,22 @@ enum BoxliteErrorCode boxlite_copy_into(CBoxHandle *handle,
                                         void *user_data,
                                         CBoxliteError *out_error);
 
+// Like `boxlite_copy_into`, but a directory source is synced: only entries
+// that are new or whose size, mtime or mode differ from the destination
+// are sent, so repeating a copy costs about as much as what changed.
+//
+// `checksum` != 0 compares file contents by hash instead of mtime.
+// `block_delta` != 0 updates large changed files in place by sending only
+// the blocks that differ. File sources are copied in full.
+enum BoxliteErrorCode boxlite_copy_into_delta(CBoxHandle *handle,
+                                              const char *host_src,
+                                              const char *guest_dst,
+                                              int checksum,
+                                              int block_delta,
+                                              CBoxCopyCb cb,
+                                              void *user_data,
+                                              CBoxliteError *out_error);
+
 enum BoxliteErrorCode boxlite_copy_out(CBoxHandle *handle,
                                        const char *guest_src,
                                        const char *host_dst,
@@ -398,6 +854,43 @@ enum BoxliteErrorCode boxlite_copy_out(CBoxHandle *handle,
                                        void *user_data,
                                        CBoxliteError *out_error);
 
+// Stream a tar archive read from `fd` into the box at `guest_dst`.
+//
+// `fd` must be a blocking-mode descriptor positioned at the start of an
+// uncompressed tar stream; it is read to EOF. The SDK reads from its own
+// duplicate, so the caller may close `fd` once this returns.
+// `progress_cb` (may be NULL) receives the running byte count, best-effort.
+enum BoxliteErrorCode boxlite_copy_into_fd(CBoxHandle *handle,
+                                           int fd,
+                                           const char *guest_dst,
+                                           CBoxCopyProgressCb progress_cb,
+                                           CBoxCopyCb cb,
+                                           void *user_data,
+                                           CBoxliteError *out_error);
+
+// Stream `guest_src` out of the box as a tar archive written to `fd`.
+//
+// Same descriptor rules as `boxlite_copy_into_fd`.
+enum BoxliteErrorCode boxlite_copy_out_fd(CBoxHandle *handle,
+                                          const char *guest_src,
+                                          int fd,
+                                          CBoxCopyProgressCb progress_cb,
+                                          CBoxCopyCb cb,
+                                          void *user_data,
+                                          CBoxliteError *out_error);
+
+// Stream `guest_src` out of the box as tar chunks passed to `chunk_cb`.
+//
+// Chunks arrive in order on the drain thread and are only valid during
+// the call; `cb` fires after the last one. The transfer pauses while the
+// event queue is full, so a slow consumer bounds memory use.
+enum BoxliteErrorCode boxlite_copy_out_stream(CBoxHandle *handle,
+                                              const char *guest_src,
+                                              CBoxCopyChunkCb chunk_cb,
+                                              CBoxCopyCb cb,
+                                              void *user_data,
+                                              CBoxliteError *out_error);
+
 void boxlite_error_free(CBoxliteError *error);
 
 enum BoxliteErrorCode boxlite_box_exec(CBoxHandle *handle,
@@ -405,6 +898,14 @@ enum BoxliteErrorCode boxlite_box_exec(CBoxHandle *handle,
                                        CExecutionHandle **out_execution,
                                        CBoxliteError *out_error);
 
+// Like `boxlite_box_exec`, with stdout/stderr coalescing and credit
+// limits from `pacing`. NULL `pacing` behaves like `boxlite_box_exec`.
+enum BoxliteErrorCode boxlite_box_exec_paced(CBoxHandle *handle,
+                                             const struct BoxliteCommand *cmd,
+                                             const struct BoxliteOutputPacing *pacing,
+                                             CExecutionHandle **out_execution,
+                                             CBoxliteError *out_error);
+
 enum BoxliteErrorCode boxlite_execution_on_stdout(CExecutionHandle *execution,
                                                   CBoxStdoutCb cb,
                                                   void *user_data,
@@ -425,6 +926,18 @@ enum BoxliteErrorCode boxlite_execution_stdin_write(CExecutionHandle *execution,
                                                     size_t len,
                                                     CBoxliteError *out_error);
 
+// Write several buffers to stdin as one chunk.
+//
+// The buffers are gathered into a single allocation and queued as one
+// message, so a header and payload written together cost one copy and one
+// frame to the guest instead of one per `boxlite_execution_stdin_write`.
+// Like the single-buffer write it never blocks, and the caller's buffers
+// may be reused as soon as it returns.
+enum BoxliteErrorCode boxlite_execution_stdin_writev(CExecutionHandle *execution,
+                                                     const struct BoxliteIoSlice *iov,
+                                                     size_t iovcnt,
+                                                     CBoxliteError *out_error);
+
 // Close the execution's stdin stream, signaling EOF to the guest process.
 //
 // Synchronous and idempotent: dropping the stdin sender closes the underlying
@@ -470,6 +983,37 @@ enum BoxliteErrorCode boxlite_simple_new(const char *image,
                                          CBoxliteSimple **out_box,
                                          CBoxliteError *out_error);
 
+// Like `boxlite_simple_new`, but runs the box's runtime on the executor
+// described by `executor` (see `boxlite_executor_options_new`). NULL
+// `executor` is the default. `executor` is only read during the call.
+enum BoxliteErrorCode boxlite_simple_new_with_executor(const char *image,
+                                                       int cpus,
+                                                       int memory_mib,
+                                                       const CBoxliteExecutorOptions *executor,
+                                                       CBoxliteSimple **out_box,
+                                                       CBoxliteError *out_error);
+
+// Like `boxlite_simple_new`, but creates the box in an existing runtime
+// instead of building a runtime and executor for the runner. Any number
+// of runners can share one runtime; each still owns its box, which
+// `boxlite_simple_free` stops and removes.
+//
+// The runner keeps the runtime's executor alive, so it may outlive
+// `runtime`; once `runtime` is shut down or freed, `boxlite_simple_run`
+// fails with `Stopped`.
+enum BoxliteErrorCode boxlite_simple_new_in(CBoxliteRuntime *runtime,
+                                            const char *image,
+                                            int cpus,
+                                            int memory_mib,
+                                            CBoxliteSimple **out_box,
+                                            CBoxliteError *out_error);
+
+// Run `command` to completion and return its buffered output.
+//
+// Safe to call from several threads at once on the same runner: each
+// call runs on the runner's executor and only parks the calling thread
+// until its own command exits. Must not be called from inside a
+// BoxLite callback, and must not race `boxlite_simple_free`.
 enum BoxliteErrorCode boxlite_simple_run(CBoxliteSimple *box_runner,
                                          const char *command,
                                          const char *const *args,
@@ -477,16 +1021,144 @@ enum BoxliteErrorCode boxlite_simple_run(CBoxliteSimple *box_runner,
                                          CBoxliteExecResult **out_result,
                                          CBoxliteError *out_error);
 
+// Like `boxlite_simple_run`, but captures raw stdout/stderr bytes within
+// the limits in `options` instead of buffering all output as text.
+//
+// Each stream keeps at most `options->max_bytes` in memory (head and
+// tail, see `BoxliteCaptureOptions`), so memory stays bounded however
+// much the command prints, and output keeps its original newlines and
+// any NUL bytes. Streams with a spill path are also written to that file
+// in full. NULL `options` keeps everything in memory.
+//
+// Returns `Storage` if a spill file cannot be written. Free the result
+// with `boxlite_capture_result_free`. Concurrency rules are those of
+// `boxlite_simple_run`.
+enum BoxliteErrorCode boxlite_simple_run_captured(CBoxliteSimple *box_runner,
+                                                  const char *command,
+                                                  const char *const *args,
+                                                  int argc,
+                                                  const struct BoxliteCaptureOptions *options,
+                                                  CBoxliteCaptureResult **out_result,
+                                                  CBoxliteError *out_error);
+
 void boxlite_simple_free(CBoxliteSimple *box_runner);
 
 void boxlite_result_free(CBoxliteExecResult *result);
 
+// Free a `boxlite_simple_run_captured` result and its buffers. No-op on
+// NULL.
+void boxlite_capture_result_free(CBoxliteCaptureResult *result);
+
+// Create executor options with the defaults: a private multi-thread
+// runtime with one worker per CPU, unpinned.
+//
+// Returns `BoxliteErrorCode::Ok` on success. Free the handle with
+// `boxlite_executor_options_free`.
+//
+// # Safety
+// `out_options` must be non-NULL.
+enum BoxliteErrorCode boxlite_executor_options_new(CBoxliteExecutorOptions **out_options,
+                                                   CBoxliteError *out_error);
+
+// Set the number of worker threads. `<= 0` restores the default (one
+// per CPU, or one per pinned CPU when affinity is set). No-op on NULL.
+//
+// # Safety
+// `options` must be a valid handle or NULL.
+void boxlite_executor_options_set_worker_threads(CBoxliteExecutorOptions *options, int threads);
+
+// Cap the blocking thread pool used for file I/O and other blocking
+// work. `<= 0` restores Tokio's default. No-op on NULL.
+//
+// # Safety
+// `options` must be a valid handle or NULL.
+void boxlite_executor_options_set_max_blocking_threads(CBoxliteExecutorOptions *options,
+                                                       int threads);
+
+// Name the runtime's threads (as shown by `top -H`, debuggers and
+// profilers). NULL restores Tokio's default name. No-op if `options` is
+// NULL or `name` is not a valid C string.
+//
+// # Safety
+// `options` must be a valid handle or NULL; `name` a valid C string or
+// NULL.
+void boxlite_executor_options_set_thread_name(CBoxliteExecutorOptions *options, const char *name);
+
+// Pin every runtime thread to the given CPUs. `count == 0` clears the
+// pinning. Linux only: creating a handle with pinning set fails with
+// `Unsupported` elsewhere, and with `InvalidArgument` if a CPU is not
+// available to the process.
+//
+// Returns `InvalidArgument` if `options` is NULL, `count` is negative,
+// `cpus` is NULL with a positive `count`, or a CPU index is negative.
+//
+// # Safety
+// `options` must be a valid handle or NULL; `cpus` must point to
+// `count` ints.
+enum BoxliteErrorCode boxlite_executor_options_set_cpu_affinity(CBoxliteExecutorOptions *options,
+                                                                const int *cpus,
+                                                                int count);
+
+// Pin every runtime thread to the CPUs of NUMA node `node`, intersected
+// with any CPUs set by `boxlite_executor_options_set_cpu_affinity`.
+// `node < 0` clears it. Linux only, like CPU affinity. No-op on NULL.
+//
+// # Safety
+// `options` must be a valid handle or NULL.
+void boxlite_executor_options_set_numa_node(CBoxliteExecutorOptions *options, int node);
+
+// Run all async work on a single worker thread (non-zero) instead of a
+// pool. Overrides the worker count; the blocking pool is unaffected.
+// No-op on NULL.
+//
+// A dedicated worker, rather than a current-thread scheduler driven by
+// the caller, keeps the post-and-drain contract: operations make
+// progress while the caller is outside the library, and callbacks still
+// only fire inside `boxlite_runtime_drain`.
+//
+// # Safety
+// `options` must be a valid handle or NULL.
+void boxlite_executor_options_set_single_thread(CBoxliteExecutorOptions *options, int enabled);
+
+// Share the executor (non-zero): handles created from options with the
+// same settings run on one Tokio runtime, which stays up until the last
+// of them is freed. Without it every handle builds its own. No-op on
+// NULL.
+//
+// # Safety
+// `options` must be a valid handle or NULL.
+void boxlite_executor_options_set_shared(CBoxliteExecutorOptions *options, int enabled);
+
+// Free an executor options handle. No-op on NULL. Handles created from
+// it are unaffected.
+//
+// # Safety
+// `options` must be a handle from `boxlite_executor_options_new` or
+// NULL, and must not be used after this call.
+void boxlite_executor_options_free(CBoxliteExecutorOptions *options);
+
 enum BoxliteErrorCode boxlite_image_pull(CBoxliteImageHandle *handle,
                                          const char *image_ref,
                                          CBoxImagePullCb cb,
                                          void *user_data,
                                          CBoxliteError *out_error);
 
+// Pull an image like `boxlite_image_pull`, downloading up to
+// `max_concurrent_layers` layers at once (0 = default) and posting
+// progress snapshots to `progress_cb` (may be NULL) before `cb` fires.
+//
+// Progress is best-effort: snapshots are throttled, and dropped while the
+// event queue is half full. None are posted when the image is already
+// cached.
+// Both callbacks receive `user_data`.
+enum BoxliteErrorCode boxlite_image_pull_with_progress(CBoxliteImageHandle *handle,
+                                                       const char *image_ref,
+                                                       size_t max_concurrent_layers,
+                                                       CBoxImagePullProgressCb progress_cb,
+                                                       CBoxImagePullCb cb,
+                                                       void *user_data,
+                                                       CBoxliteError *out_error);
+
 enum BoxliteErrorCode boxlite_image_list(CBoxliteImageHandle *handle,
                                          CBoxImageListCb cb,
                                          void *user_data,
@@ -513,6 +1185,97 @@ enum BoxliteErrorCode boxlite_list_info(CBoxliteRuntime *runtime,
                                         void *user_data,
                                         CBoxliteError *out_error);
 
+// Like `boxlite_list_info`, but only the boxes `filter` selects, one page
+// at a time (see `boxlite_list_filter_new`). NULL `filter` selects every
+// box. `filter` is only read during the call; the caller still frees it.
+// The list's `total` counts the matches across all pages.
+enum BoxliteErrorCode boxlite_list_info_filtered(CBoxliteRuntime *runtime,
+                                                 const CBoxliteListFilter *filter,
+                                                 CBoxInfoListCb cb,
+                                                 void *user_data,
+                                                 CBoxliteError *out_error);
+
+// Like `boxlite_list_info_filtered`, but the callback receives a
+// `CBoxInfoArena`: fixed-size rows plus one buffer holding every string,
+// addressed by offset (`arena->strings + row->id`). The callback owns the
+// arena; `boxlite_free_box_info_arena` releases it in one call.
+enum BoxliteErrorCode boxlite_list_info_arena(CBoxliteRuntime *runtime,
+                                              const CBoxliteListFilter *filter,
+                                              CBoxInfoArenaCb cb,
+                                              void *user_data,
+                                              CBoxliteError *out_error);
+
+void boxlite_free_box_info_arena(struct CBoxInfoArena *arena);
+
+// Create an empty list filter, which selects every box.
+//
+// Free the handle with `boxlite_list_filter_free`.
+//
+// # Safety
+// `out_filter` must be non-NULL.
+enum BoxliteErrorCode boxlite_list_filter_new(CBoxliteListFilter **out_filter,
+                                              CBoxliteError *out_error);
+
+// Also accept boxes in `status` ("running", "stopped", ... as reported in
+// `CBoxInfo::status`). With no status added, any status matches.
+//
+// Returns `InvalidArgument` if `filter` or `status` is NULL or `status`
+// is not a known status.
+//
+// # Safety
+// `filter` must be a valid handle or NULL; `status` a valid C string or
+// NULL.
+enum BoxliteErrorCode boxlite_list_filter_add_status(CBoxliteListFilter *filter,
+                                                     const char *status,
+                                                     CBoxliteError *out_error);
+
+// Only select boxes whose image reference is exactly `image`. NULL
+// clears the criterion. No-op if `filter` is NULL or `image` is not a
+// valid C string.
+//
+// # Safety
+// `filter` must be a valid handle or NULL; `image` a valid C string or
+// NULL.
+void boxlite_list_filter_set_image(CBoxliteListFilter *filter, const char *image);
+
+// Only select boxes whose name starts with `prefix`; unnamed boxes never
+// match. NULL clears the criterion. No-op if `filter` is NULL or
+// `prefix` is not a valid C string.
+//
+// # Safety
+// `filter` must be a valid handle or NULL; `prefix` a valid C string or
+// NULL.
+void boxlite_list_filter_set_name_prefix(CBoxliteListFilter *filter, const char *prefix);
+
+// Only select boxes carrying label `key` with value `value`. Labels
+// added this way must all match.
+//
+// Returns `InvalidArgument` if any argument is NULL or not a valid C
+// string.
+//
+// # Safety
+// `filter` must be a valid handle or NULL; `key` and `value` valid C
+// strings or NULL.
+enum BoxliteErrorCode boxlite_list_filter_add_label(CBoxliteListFilter *filter,
+                                                    const char *key,
+                                                    const char *value,
+                                                    CBoxliteError *out_error);
+
+// Page through the matches: skip the first `offset` (newest first) and
+// return at most `limit`. `offset <= 0` starts at the first match and
+// `limit <= 0` means no limit. No-op on NULL.
+//
+// # Safety
+// `filter` must be a valid handle or NULL.
+void boxlite_list_filter_set_page(CBoxliteListFilter *filter, int offset, int limit);
+
+// Free a list filter. No-op on NULL.
+//
+// # Safety
+// `filter` must be a handle from `boxlite_list_filter_new` or NULL, and
+// must not be used after this call.
+void boxlite_list_filter_free(CBoxliteListFilter *filter);
+
 void boxlite_free_box_info(struct CBoxInfo *info);
 
 void boxlite_free_box_info_list(struct CBoxInfoList *list);
@@ -522,11 +1285,67 @@ enum BoxliteErrorCode boxlite_box_metrics(CBoxHandle *handle,
                                           void *user_data,
                                           CBoxliteError *out_error);
 
+// Return idle guest memory to the host: the guest drops clean page cache
+// and compacts free memory, and the balloon device's free-page reporting
+// hands it back. Skipped when the guest's in-use memory is already at or
+// below `target_bytes`; 0 always reclaims.
+//
+// Guest RAM itself stays fixed at `boxlite_options_set_memory`; watch
+// `host_rss_bytes` in `CBoxMetrics` for the effect on the host.
+enum BoxliteErrorCode boxlite_box_reclaim_memory(CBoxHandle *handle,
+                                                 uint64_t target_bytes,
+                                                 CMemoryReclaimCb cb,
+                                                 void *user_data,
+                                                 CBoxliteError *out_error);
+
+// Per-task init timeline of a box, to see what dominates
+// `create_duration_ms`. The callback owns the trace; free it with
+// `boxlite_free_init_trace`.
+enum BoxliteErrorCode boxlite_box_init_trace(CBoxHandle *handle,
+                                             CBoxInitTraceCb cb,
+                                             void *user_data,
+                                             CBoxliteError *out_error);
+
+void boxlite_free_init_trace(struct CInitTrace *trace);
+
 enum BoxliteErrorCode boxlite_runtime_metrics(CBoxliteRuntime *runtime,
                                               CRuntimeMetricsCb cb,
                                               void *user_data,
                                               CBoxliteError *out_error);
 
+// Sample CPU and memory of every running box every `interval_ms`, in one
+// pass over the boxes' cgroups, and deliver each tick as a single
+// `CBoxMetricsBatch` through the drain queue. The first batch comes
+// right away, with `cpu_percent` -1 throughout.
+//
+// A tick is skipped while the previous batch is still undelivered or the
+// queue is full, so batches never pile up behind a slow drain. If
+// sampling fails the callback gets a NULL batch and the error; once the
+// runtime is gone the subscription ends.
+// `boxlite_metrics_subscription_free` stops it; no callback fires for
+// it in a drain call made after that.
+//
+// Only local runtimes support this (`Unsupported` otherwise).
+enum BoxliteErrorCode boxlite_runtime_subscribe_metrics(CBoxliteRuntime *runtime,
+                                                        uint64_t interval_ms,
+                                                        CBoxMetricsBatchCb cb,
+                                                        void *user_data,
+                                                        CMetricsSubscription **out_subscription,
+                                                        CBoxliteError *out_error);
+
+// Stop a metrics subscription and free it. NULL is a no-op.
+void boxlite_metrics_subscription_free(CMetricsSubscription *subscription);
+
+// Read the runtime's event queue counters into `*out_stats`, whose
+// `struct_size` the caller must set (see [`CQueueStats`]).
+//
+// Synchronous: the snapshot is taken on the calling thread rather than
+// posted through the queue it describes, so it may be called from any
+// thread, including from inside a callback.
+enum BoxliteErrorCode boxlite_runtime_queue_stats(CBoxliteRuntime *runtime,
+                                                  struct CQueueStats *out_stats,
+                                                  CBoxliteError *out_error);
+
 enum BoxliteErrorCode boxlite_options_new(const char *image,
                                           CBoxliteOptions **out_opts,
                                           CBoxliteError *out_error);
@@ -550,6 +1369,16 @@ void boxlite_options_add_volume(CBoxliteOptions *opts,
                                 const char *guest_path,
                                 int read_only);
 
+// Like `boxlite_options_add_volume`, with the sharing performance mode
+// chosen per field. A negative value keeps that field's default for the
+// `read_only` flag.
+void boxlite_options_add_volume_tuned(CBoxliteOptions *opts,
+                                      const char *host_path,
+                                      const char *guest_path,
+                                      int read_only,
+                                      int64_t dax_window_bytes,
+                                      int noatime);
+
 // Forward `host_port` on the host to `guest_port` inside the box.
 //
 // - `host_port`: 0 = use the same number as `guest_port`.
@@ -597,6 +1426,18 @@ void boxlite_options_set_entrypoint(CBoxliteOptions *opts, const char *const *ar
 
 void boxlite_options_set_cmd(CBoxliteOptions *opts, const char *const *args, int argc);
 
+// Make `boxlite_create_box` start the box from snapshot `snapshot` of box
+// `source_box` (ID or name) instead of from the image: its disk becomes a
+// copy-on-write child of the snapshot, shared by every box started from
+// it, and the box is running when the create callback fires. The image
+// set on `opts` is ignored in favour of the source box's.
+//
+// NULL `source_box` or `snapshot` clears the setting. Ignored by
+// `boxlite_get_or_create_box`.
+void boxlite_options_set_start_snapshot(CBoxliteOptions *opts,
+                                        const char *source_box,
+                                        const char *snapshot);
+
 void boxlite_options_free(CBoxliteOptions *opts);
 
 // Create an API-key credential.
@@ -661,6 +1502,54 @@ void boxlite_rest_options_set_credential(CBoxliteRestOptions *options,
 // C string or NULL.
 void boxlite_rest_options_set_path_prefix(CBoxliteRestOptions *options, const char *path_prefix);
 
+// Drive the REST runtime on the executor described by `executor`
+// instead of a private default one (see `boxlite_executor_options_new`).
+// The settings are copied, so the caller still owns `executor` and
+// frees it with `boxlite_executor_options_free`. NULL `executor`
+// restores the default. No-op if `options` is NULL.
+//
+// # Safety
+// `options` and `executor` must be valid handles or NULL.
+void boxlite_rest_options_set_executor(CBoxliteRestOptions *options,
+                                       const CBoxliteExecutorOptions *executor);
+
+// Tune the connection pool shared by every request of the runtime.
+// `max_idle_per_host` caps idle keep-alive connections per host (0
+// disables reuse); `idle_timeout_ms` is how long an idle connection is
+// kept. A negative value restores the default for that setting
+// (unlimited, 90 s). No-op on NULL.
+//
+// # Safety
+// `options` must be a valid handle or NULL.
+void boxlite_rest_options_set_pool(CBoxliteRestOptions *options,
+                                   int max_idle_per_host,
+                                   int idle_timeout_ms);
+
+// Configure HTTP/2. Over `https://` HTTP/2 is negotiated whenever the
+// server offers it, multiplexing all requests over one connection;
+// non-zero `prior_knowledge` also uses it over plain `http://` (h2c),
+// which the server must support. `keep_alive_ms > 0` sends a PING at
+// that interval so idle connections survive NATs and load balancers;
+// `<= 0` disables it. No-op on NULL.
+//
+// # Safety
+// `options` must be a valid handle or NULL.
+void boxlite_rest_options_set_http2(CBoxliteRestOptions *options,
+                                    int prior_knowledge,
+                                    int keep_alive_ms);
+
+// Set how long `GET /v1/config` and `GET /v1/me` responses are cached
+// when the server sends no `Cache-Control` lifetime (a server lifetime
+// always wins). 0 = not cached; negative = cached until the runtime is
+// freed. Defaults: config cached until freed, identity not cached.
+// No-op on NULL.
+//
+// # Safety
+// `options` must be a valid handle or NULL.
+void boxlite_rest_options_set_cache_ttl(CBoxliteRestOptions *options,
+                                        int64_t config_ttl_ms,
+                                        int64_t me_ttl_ms);
+
 // Free a REST options handle. No-op on NULL.
 //
 // # Safety
@@ -694,10 +1583,39 @@ enum BoxliteErrorCode boxlite_runtime_new(const char *home_dir,
                                           CBoxliteRuntime **out_runtime,
                                           CBoxliteError *out_error);
 
+// Like `boxlite_runtime_new`, but drives the runtime on the executor
+// described by `executor` (see `boxlite_executor_options_new`). NULL
+// `executor` is the default: a private runtime with one worker per CPU.
+// `executor` is only read during the call; the caller still frees it.
+//
+// Returns `Unsupported` if the options ask for CPU or NUMA placement on a
+// platform without it, and `InvalidArgument` if the requested CPUs are
+// not available to the process.
+enum BoxliteErrorCode boxlite_runtime_new_with_executor(const char *home_dir,
+                                                        const struct BoxliteImageRegistry *image_registries,
+                                                        int image_registries_count,
+                                                        const CBoxliteExecutorOptions *executor,
+                                                        CBoxliteRuntime **out_runtime,
+                                                        CBoxliteError *out_error);
+
 enum BoxliteErrorCode boxlite_runtime_images(CBoxliteRuntime *runtime,
                                              CBoxliteImageHandle **out_handle,
                                              CBoxliteError *out_error);
 
+// Keep `size` boxes created from `opts` started in the background, so
+// `boxlite_create_box` calls with the same options (and no name) return
+// without booting a VM. The name set on `opts` is ignored; `size == 0`
+// disables the pool. `opts` is only read during the call; the caller
+// still frees it.
+//
+// Returns `InvalidArgument` unless `opts` keeps auto-remove on and detach
+// off, and `Unsupported` on REST runtimes. Pool counters are reported in
+// `CRuntimeMetrics`.
+enum BoxliteErrorCode boxlite_runtime_set_warm_pool(CBoxliteRuntime *runtime,
+                                                    const CBoxliteOptions *opts,
+                                                    size_t size,
+                                                    CBoxliteError *out_error);
+
 // Async + callback variant of runtime shutdown.
 //
 // Spawns a Tokio task that calls `BoxliteRuntime::shutdown` and posts a
@@ -712,7 +1630,14 @@ enum BoxliteErrorCode boxlite_runtime_shutdown(CBoxliteRuntime *runtime,
 void boxlite_runtime_free(CBoxliteRuntime *runtime);
 
 // Drain pending callbacks for `runtime`, dispatching them on the calling
-// thread. The queue lock is released before any user code runs.
+// thread. No queue lock is held while user code runs.
+//
+// Dispatch order: lifecycle completions (create, start, wait, kill, ...)
+// are served ahead of queued stdout/stderr, with output still getting one
+// turn per few completions, and executions with pending output take turns
+// rather than draining one execution's backlog first. Each execution's
+// own stdout, stderr and exit events keep the order they were produced
+// in, and exit always comes last.
 //
 // `timeout_ms`:
 //   - `0`  : non-blocking poll
@@ -722,6 +1647,50 @@ void boxlite_runtime_free(CBoxliteRuntime *runtime);
 // Returns the number of dispatched events, or `-1` on error.
 int boxlite_runtime_drain(CBoxliteRuntime *runtime, int timeout_ms, CBoxliteError *out_error);
 
+// Like `boxlite_runtime_drain`, but stops early once `max_events` events
+// have been dispatched or `budget_ms` milliseconds have elapsed since the
+// first dispatch, whichever comes first. `max_events <= 0` and
+// `budget_ms <= 0` mean "no limit". `timeout_ms` has the same meaning as
+// for `boxlite_runtime_drain`.
+//
+// Returns the number of dispatched events, or `-1` on error.
+int boxlite_runtime_drain_batch(CBoxliteRuntime *runtime,
+                                int timeout_ms,
+                                int max_events,
+                                int budget_ms,
+                                CBoxliteError *out_error);
+
+// Drain execution output into a caller-provided array instead of invoking
+// the stdout/stderr/exit callbacks, so a binding can cross the FFI boundary
+// once per batch rather than once per chunk.
+//
+// Each record carries the `user_data` registered with the execution; the
+// callback that would have run is NOT invoked. Lifecycle events (create,
+// start, wait, ...) are still dispatched through their callbacks: those
+// that arrive before the first record are dispatched inline, and the first
+// one that arrives after a record ends the batch, so no callback runs
+// while a batch is being collected.
+//
+// Blocks up to `timeout_ms` (same meaning as `boxlite_runtime_drain`) only
+// while no record has been filled; afterwards it returns as soon as the
+// array is full or no further event is immediately available.
+//
+// `records[i].data` points into `*out_batch`, which stays valid until
+// `boxlite_event_batch_free(*out_batch)`. `*out_batch` is set to NULL when
+// no record owns a buffer.
+//
+// Returns the number of records written, or `-1` on error.
+int boxlite_runtime_drain_records(CBoxliteRuntime *runtime,
+                                  int timeout_ms,
+                                  struct CEventRecord *records,
+                                  int max_records,
+                                  CBoxliteEventBatch **out_batch,
+                                  CBoxliteError *out_error);
+
+// Free the buffers backing a `boxlite_runtime_drain_records` batch.
+// NULL is a no-op.
+void boxlite_event_batch_free(CBoxliteEventBatch *batch);
+
 void boxlite_free_string(char *s);
 
 #ifdef __cplusplus
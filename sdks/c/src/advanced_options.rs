@@ -1,17 +1,23 @@
 //! C ABI for `boxlite::runtime::advanced_options::AdvancedBoxOptions`.
 //!
 //! Mirrors the core model: advanced knobs (security, mount isolation, health
-//! check) live under `BoxOptions.advanced`, never directly on the box. Build a
-//! `CAdvancedBoxOptions` handle via `boxlite_advanced_options_new`, toggle the
+//! check, memory reclaim, CPU placement) live under `BoxOptions.advanced`, never directly on
+//! the box. Build a `CAdvancedBoxOptions` handle via `boxlite_advanced_options_new`, toggle the
 //! sandbox with `boxlite_advanced_options_set_security_enabled`, then apply it
 //! to a `CBoxliteOptions` via `boxlite_options_set_advanced`.
 
-use std::os::raw::c_int;
+use std::os::raw::{c_char, c_int};
+use std::time::Duration;
 
-use boxlite::runtime::advanced_options::{AdvancedBoxOptions, SecurityOptions};
+use boxlite::BoxliteError;
+use boxlite::runtime::advanced_options::{
+    AdvancedBoxOptions, CpuPlacement, MemoryReclaimOptions, SecurityOptions,
+};
+use boxlite::runtime::placement::parse_cpu_list;
 
 use crate::CAdvancedBoxOptions;
-use crate::error::{BoxliteErrorCode, FFIError, null_pointer_error, write_error};
+use crate::error::{BoxliteErrorCode, FFIError, error_to_code, null_pointer_error, write_error};
+use crate::util::c_str_to_string;
 
 /// Opaque handle wrapping an `AdvancedBoxOptions`. Allocated via
 /// `boxlite_advanced_options_new`, freed via `boxlite_advanced_options_free`.
@@ -77,3 +83,98 @@ pub unsafe extern "C" fn boxlite_advanced_options_set_security_enabled(
         };
     }
 }
+
+/// Have the guest agent reclaim memory periodically: every `interval_secs`
+/// (0 = default, 60 s) it drops clean page cache and compacts free memory
+/// when in-use memory exceeds `target_mib` (0 = on every check), and the
+/// balloon device's free-page reporting returns the freed pages to the host.
+/// Off unless called. Null `opts` is a no-op.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_advanced_options_set_memory_reclaim(
+    opts: *mut CAdvancedBoxOptions,
+    target_mib: u32,
+    interval_secs: u32,
+) {
+    if opts.is_null() {
+        return;
+    }
+    let mut reclaim = MemoryReclaimOptions {
+        target_mib,
+        ..MemoryReclaimOptions::default()
+    };
+    if interval_secs > 0 {
+        reclaim.interval = Duration::from_secs(u64::from(interval_secs));
+    }
+    unsafe {
+        (*opts).options.memory_reclaim = Some(reclaim);
+    }
+}
+
+/// Pin the box's VMM to the host CPUs in `cpus`, a kernel CPU list such as
+/// "0-3,8". Guest memory is bound to the NUMA nodes those CPUs belong to.
+/// Linux only; the box fails to start elsewhere, or if a CPU is not usable
+/// by the runtime process.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_advanced_options_set_cpuset(
+    opts: *mut CAdvancedBoxOptions,
+    cpus: *const c_char,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if opts.is_null() {
+            write_error(out_error, null_pointer_error("opts"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        if cpus.is_null() {
+            write_error(out_error, null_pointer_error("cpus"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let parsed = match c_str_to_string(cpus).and_then(|list| parse_cpu_list(&list)) {
+            Ok(parsed) if !parsed.is_empty() => parsed,
+            Ok(_) => {
+                write_error(
+                    out_error,
+                    BoxliteError::InvalidArgument("cpus is empty".into()),
+                );
+                return BoxliteErrorCode::InvalidArgument;
+            }
+            Err(e) => {
+                let code = error_to_code(&e);
+                write_error(out_error, e);
+                return code;
+            }
+        };
+        (*opts).options.placement = Some(CpuPlacement::Cpus { cpus: parsed });
+        BoxliteErrorCode::Ok
+    }
+}
+
+/// Run the box's VMM on the CPUs of NUMA node `node`, with guest memory
+/// bound to that node. Null `opts` is a no-op.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_advanced_options_set_numa_node(
+    opts: *mut CAdvancedBoxOptions,
+    node: u32,
+) {
+    if opts.is_null() {
+        return;
+    }
+    unsafe {
+        (*opts).options.placement = Some(CpuPlacement::NumaNode { node });
+    }
+}
+
+/// Let the runtime place the box: on the NUMA node with the most spare CPUs
+/// among running boxes, pinned to that node's least-used CPUs (one per
+/// vCPU) with memory bound to it. Null `opts` is a no-op.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_advanced_options_set_auto_placement(
+    opts: *mut CAdvancedBoxOptions,
+) {
+    if opts.is_null() {
+        return;
+    }
+    unsafe {
+        (*opts).options.placement = Some(CpuPlacement::Auto);
+    }
+}
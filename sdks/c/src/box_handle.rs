@@ -16,10 +16,11 @@ use boxlite::BoxID;
 use boxlite::BoxliteError;
 use boxlite::litebox::LiteBox;
 
-use crate::error::{BoxliteErrorCode, FFIError, null_pointer_error, write_error};
+use crate::error::{BoxliteErrorCode, FFIError, error_to_c_error, null_pointer_error, write_error};
 use crate::event_queue::{
-    CBoxCreateBoxCb, CBoxGetBoxCb, CBoxGetOrCreateBoxCb, CBoxRemoveBoxCb, CBoxStartBoxCb,
-    CBoxStopBoxCb, EventQueue, RuntimeEvent, push_event,
+    CBoxBatchCb, CBoxCreateBoxCb, CBoxCreateBoxesCb, CBoxGetBoxCb, CBoxGetOrCreateBoxCb,
+    CBoxRemoveBoxCb, CBoxStartBoxCb, CBoxStopBoxCb, EventQueue, OwnedFfiPtr, RuntimeEvent,
+    push_event,
 };
 use crate::options::OptionsHandle;
 use crate::runtime::RuntimeHandle;
@@ -38,6 +39,31 @@ pub struct BoxHandle {
     pub queue: Arc<EventQueue>,
 }
 
+/// Outcome of `boxlite_create_boxes`: one slot per requested box, in
+/// request order.
+#[repr(C)]
+pub struct CBoxBatchCreateResult {
+    /// Created boxes, NULL where that create failed. The caller owns each
+    /// handle and frees it with `boxlite_box_free`.
+    pub handles: *mut *mut CBoxHandle,
+    /// Per-slot error; `code` is `Ok` where the create succeeded.
+    pub errors: *mut CBoxliteError,
+    pub count: c_int,
+    /// Number of slots whose create failed.
+    pub failed: c_int,
+}
+
+/// Outcome of `boxlite_start_boxes`, `boxlite_stop_boxes` and
+/// `boxlite_remove_boxes`: one error slot per box, in request order.
+#[repr(C)]
+pub struct CBoxBatchResult {
+    /// Per-slot error; `code` is `Ok` where the operation succeeded.
+    pub errors: *mut CBoxliteError,
+    pub count: c_int,
+    /// Number of slots whose operation failed.
+    pub failed: c_int,
+}
+
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn boxlite_create_box(
     runtime: *mut CBoxliteRuntime,
@@ -110,6 +136,112 @@ pub unsafe extern "C" fn boxlite_start_box(
     start_box(handle, cb, user_data, out_error)
 }
 
+/// Create `count` boxes in one call, at most `concurrency` at a time
+/// (`<= 0` picks the runtime default).
+///
+/// Consumes every `opts[i]` once the call returns `Ok`; on an argument error
+/// none are consumed. Options with a start snapshot are rejected (create
+/// those with `boxlite_create_box`). One failed create does not stop the
+/// others, and the callback fires once with every outcome. On local
+/// runtimes the database writes of the batch share one fsync.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_create_boxes(
+    runtime: *mut CBoxliteRuntime,
+    opts: *const *mut CBoxliteOptions,
+    count: c_int,
+    concurrency: c_int,
+    cb: CBoxCreateBoxesCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    create_boxes(runtime, opts, count, concurrency, cb, user_data, out_error)
+}
+
+/// Start `count` boxes in one call. Concurrency and reporting as for
+/// `boxlite_create_boxes`; the handles stay owned by the caller.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_start_boxes(
+    runtime: *mut CBoxliteRuntime,
+    handles: *const *mut CBoxHandle,
+    count: c_int,
+    concurrency: c_int,
+    cb: CBoxBatchCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    start_stop_boxes(
+        runtime,
+        handles,
+        count,
+        concurrency,
+        false,
+        cb,
+        user_data,
+        out_error,
+    )
+}
+
+/// Stop `count` boxes in one call. Concurrency and reporting as for
+/// `boxlite_create_boxes`; the handles stay owned by the caller.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_stop_boxes(
+    runtime: *mut CBoxliteRuntime,
+    handles: *const *mut CBoxHandle,
+    count: c_int,
+    concurrency: c_int,
+    cb: CBoxBatchCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    start_stop_boxes(
+        runtime,
+        handles,
+        count,
+        concurrency,
+        true,
+        cb,
+        user_data,
+        out_error,
+    )
+}
+
+/// Remove `count` boxes by ID or name in one call. Concurrency and
+/// reporting as for `boxlite_create_boxes`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_remove_boxes(
+    runtime: *mut CBoxliteRuntime,
+    ids_or_names: *const *const c_char,
+    count: c_int,
+    force: c_int,
+    concurrency: c_int,
+    cb: CBoxBatchCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    remove_boxes(
+        runtime,
+        ids_or_names,
+        count,
+        force != 0,
+        concurrency,
+        cb,
+        user_data,
+        out_error,
+    )
+}
+
+/// Free a `CBoxBatchCreateResult` and its error messages. The box handles
+/// in it are not freed.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_free_box_batch_create_result(result: *mut CBoxBatchCreateResult) {
+    free_box_batch_create_result(result)
+}
+
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_free_box_batch_result(result: *mut CBoxBatchResult) {
+    free_box_batch_result(result)
+}
+
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn boxlite_box_id(handle: *mut CBoxHandle) -> *mut c_char {
     box_id(handle)
@@ -142,7 +274,11 @@ unsafe fn create_box(
         // enable/disable setters (two-state, nothing to validate), so there is
         // no deferred preset to resolve here.
         let runtime_ref = &*runtime;
-        let opts_handle = Box::from_raw(opts);
+        let OptionsHandle {
+            options,
+            name,
+            start_snapshot,
+        } = *Box::from_raw(opts);
         let runtime_clone = runtime_ref.runtime.clone();
         let tokio_rt = runtime_ref.tokio_rt.clone();
         let queue = runtime_ref.queue.clone();
@@ -151,19 +287,24 @@ unsafe fn create_box(
         let task_queue = queue.clone();
 
         tokio_rt.spawn(async move {
-            let result = runtime_clone
-                .create(opts_handle.options, opts_handle.name)
-                .await
-                .map(|handle| {
-                    let box_id = handle.id().clone();
-                    let boxed = Box::new(BoxHandle {
-                        handle: Arc::new(handle),
-                        box_id,
-                        tokio_rt: task_tokio_rt,
-                        queue: task_queue.clone(),
-                    });
-                    crate::event_queue::OwnedFfiPtr::new(boxed)
+            let created = match start_snapshot {
+                Some(start) => {
+                    runtime_clone
+                        .create_from_snapshot(&start.source, &start.snapshot, options, name)
+                        .await
+                }
+                None => runtime_clone.create(options, name).await,
+            };
+            let result = created.map(|handle| {
+                let box_id = handle.id().clone();
+                let boxed = Box::new(BoxHandle {
+                    handle: Arc::new(handle),
+                    box_id,
+                    tokio_rt: task_tokio_rt,
+                    queue: task_queue.clone(),
                 });
+                crate::event_queue::OwnedFfiPtr::new(boxed)
+            });
             push_event(
                 &queue,
                 RuntimeEvent::CreateBox {
@@ -410,6 +551,324 @@ unsafe fn start_box(
     }
 }
 
+/// `Some(n)` for a usable batch length, writing the error otherwise.
+unsafe fn batch_len<T>(
+    items: *const T,
+    count: c_int,
+    name: &str,
+    out_error: *mut FFIError,
+) -> Option<usize> {
+    unsafe {
+        if count < 0 {
+            write_error(
+                out_error,
+                BoxliteError::InvalidArgument(format!("count is negative: {count}")),
+            );
+            return None;
+        }
+        if count > 0 && items.is_null() {
+            write_error(out_error, null_pointer_error(name));
+            return None;
+        }
+        Some(count as usize)
+    }
+}
+
+fn batch_concurrency(concurrency: c_int) -> usize {
+    concurrency.max(0) as usize
+}
+
+impl CBoxBatchCreateResult {
+    // Synchronous so the raw handle pointers never live across an await.
+    fn from_results(
+        results: Vec<Result<LiteBox, BoxliteError>>,
+        tokio_rt: &Arc<TokioRuntime>,
+        queue: &Arc<EventQueue>,
+    ) -> Self {
+        let mut handles = Vec::with_capacity(results.len());
+        let mut errors = Vec::with_capacity(results.len());
+        let mut failed = 0;
+        for result in results {
+            match result {
+                Ok(handle) => {
+                    let box_id = handle.id().clone();
+                    handles.push(Box::into_raw(Box::new(BoxHandle {
+                        handle: Arc::new(handle),
+                        box_id,
+                        tokio_rt: tokio_rt.clone(),
+                        queue: queue.clone(),
+                    })));
+                    errors.push(FFIError::default());
+                }
+                Err(e) => {
+                    failed += 1;
+                    handles.push(ptr::null_mut());
+                    errors.push(error_to_c_error(e));
+                }
+            }
+        }
+        CBoxBatchCreateResult {
+            count: handles.len() as c_int,
+            handles: Box::into_raw(handles.into_boxed_slice()) as *mut *mut CBoxHandle,
+            errors: Box::into_raw(errors.into_boxed_slice()) as *mut FFIError,
+            failed,
+        }
+    }
+}
+
+impl CBoxBatchResult {
+    fn from_results(results: Vec<Result<(), BoxliteError>>) -> Self {
+        let mut failed = 0;
+        let errors: Box<[FFIError]> = results
+            .into_iter()
+            .map(|result| match result {
+                Ok(()) => FFIError::default(),
+                Err(e) => {
+                    failed += 1;
+                    error_to_c_error(e)
+                }
+            })
+            .collect();
+        CBoxBatchResult {
+            count: errors.len() as c_int,
+            errors: Box::into_raw(errors) as *mut FFIError,
+            failed,
+        }
+    }
+}
+
+/// Free the boxed `errors` array of a batch result and its messages.
+unsafe fn free_batch_errors(errors: *mut FFIError, count: c_int) {
+    unsafe {
+        let mut errors = Box::from_raw(ptr::slice_from_raw_parts_mut(errors, count as usize));
+        for err in errors.iter_mut() {
+            crate::boxlite_error_free(err);
+        }
+    }
+}
+
+pub unsafe fn free_box_batch_result(result: *mut CBoxBatchResult) {
+    unsafe {
+        if result.is_null() {
+            return;
+        }
+        let result = Box::from_raw(result);
+        free_batch_errors(result.errors, result.count);
+    }
+}
+
+pub unsafe fn free_box_batch_create_result(result: *mut CBoxBatchCreateResult) {
+    unsafe {
+        if result.is_null() {
+            return;
+        }
+        let result = Box::from_raw(result);
+        drop(Box::from_raw(ptr::slice_from_raw_parts_mut(
+            result.handles,
+            result.count as usize,
+        )));
+        free_batch_errors(result.errors, result.count);
+    }
+}
+
+/// Destructor for a create batch that never reached its callback: the
+/// handles were never handed out, so release them too.
+unsafe fn drop_undelivered_box_batch_create(result: *mut CBoxBatchCreateResult) {
+    unsafe {
+        let result_ref = &*result;
+        for idx in 0..result_ref.count as usize {
+            box_free(*result_ref.handles.add(idx));
+        }
+        free_box_batch_create_result(result);
+    }
+}
+
+unsafe fn create_boxes(
+    runtime: *mut RuntimeHandle,
+    opts: *const *mut OptionsHandle,
+    count: c_int,
+    concurrency: c_int,
+    cb: CBoxCreateBoxesCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let Some(count) = batch_len(opts, count, "opts", out_error) else {
+            return BoxliteErrorCode::InvalidArgument;
+        };
+        for idx in 0..count {
+            let handle = *opts.add(idx);
+            if handle.is_null() {
+                write_error(out_error, null_pointer_error(&format!("opts[{idx}]")));
+                return BoxliteErrorCode::InvalidArgument;
+            }
+            if (*handle).start_snapshot.is_some() {
+                write_error(
+                    out_error,
+                    BoxliteError::InvalidArgument(format!(
+                        "opts[{idx}] starts from a snapshot; create it with boxlite_create_box"
+                    )),
+                );
+                return BoxliteErrorCode::InvalidArgument;
+            }
+        }
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+
+        let boxes: Vec<_> = (0..count)
+            .map(|idx| {
+                let handle = *Box::from_raw(*opts.add(idx));
+                (handle.options, handle.name)
+            })
+            .collect();
+        let runtime_ref = &*runtime;
+        let runtime_clone = runtime_ref.runtime.clone();
+        let tokio_rt = runtime_ref.tokio_rt.clone();
+        let queue = runtime_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+        let task_tokio_rt = tokio_rt.clone();
+        let concurrency = batch_concurrency(concurrency);
+
+        tokio_rt.spawn(async move {
+            let results = runtime_clone.create_many(boxes, concurrency).await;
+            let batch = CBoxBatchCreateResult::from_results(results, &task_tokio_rt, &queue);
+            push_event(
+                &queue,
+                RuntimeEvent::CreateBoxes {
+                    cb,
+                    user_data: user_data_addr,
+                    result: Ok(OwnedFfiPtr::new_with(
+                        Box::new(batch),
+                        drop_undelivered_box_batch_create,
+                    )),
+                },
+            )
+            .await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
+unsafe fn start_stop_boxes(
+    runtime: *mut RuntimeHandle,
+    handles: *const *mut BoxHandle,
+    count: c_int,
+    concurrency: c_int,
+    stop: bool,
+    cb: CBoxBatchCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let Some(count) = batch_len(handles, count, "handles", out_error) else {
+            return BoxliteErrorCode::InvalidArgument;
+        };
+        let mut boxes = Vec::with_capacity(count);
+        for idx in 0..count {
+            let handle = *handles.add(idx);
+            if handle.is_null() {
+                write_error(out_error, null_pointer_error(&format!("handles[{idx}]")));
+                return BoxliteErrorCode::InvalidArgument;
+            }
+            boxes.push((*handle).handle.clone());
+        }
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+
+        let runtime_ref = &*runtime;
+        let runtime_clone = runtime_ref.runtime.clone();
+        let queue = runtime_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+        let concurrency = batch_concurrency(concurrency);
+
+        runtime_ref.tokio_rt.spawn(async move {
+            let boxes: Vec<&LiteBox> = boxes.iter().map(Arc::as_ref).collect();
+            let results = if stop {
+                runtime_clone.stop_many(&boxes, concurrency).await
+            } else {
+                runtime_clone.start_many(&boxes, concurrency).await
+            };
+            push_batch_result(&queue, cb, user_data_addr, results).await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
+unsafe fn remove_boxes(
+    runtime: *mut RuntimeHandle,
+    ids_or_names: *const *const c_char,
+    count: c_int,
+    force: bool,
+    concurrency: c_int,
+    cb: CBoxBatchCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let Some(count) = batch_len(ids_or_names, count, "ids_or_names", out_error) else {
+            return BoxliteErrorCode::InvalidArgument;
+        };
+        let mut ids = Vec::with_capacity(count);
+        for idx in 0..count {
+            match c_str_to_string(*ids_or_names.add(idx)) {
+                Ok(id) => ids.push(id),
+                Err(e) => {
+                    write_error(out_error, e);
+                    return BoxliteErrorCode::InvalidArgument;
+                }
+            }
+        }
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+
+        let runtime_ref = &*runtime;
+        let runtime_clone = runtime_ref.runtime.clone();
+        let queue = runtime_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+        let concurrency = batch_concurrency(concurrency);
+
+        runtime_ref.tokio_rt.spawn(async move {
+            let ids: Vec<&str> = ids.iter().map(String::as_str).collect();
+            let results = runtime_clone.remove_many(&ids, force, concurrency).await;
+            push_batch_result(&queue, cb, user_data_addr, results).await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
+async fn push_batch_result(
+    queue: &EventQueue,
+    cb: crate::event_queue::CBoxBatchFn,
+    user_data: usize,
+    results: Vec<Result<(), BoxliteError>>,
+) {
+    let batch = OwnedFfiPtr::new_with(
+        Box::new(CBoxBatchResult::from_results(results)),
+        free_box_batch_result,
+    );
+    push_event(
+        queue,
+        RuntimeEvent::BoxBatch {
+            cb,
+            user_data,
+            result: Ok(batch),
+        },
+    )
+    .await;
+}
+
 unsafe fn box_id(handle: *mut BoxHandle) -> *mut c_char {
     unsafe {
         if handle.is_null() {
@@ -1,16 +1,36 @@
 //! File copy operations for the BoxLite C SDK (async + callback variants).
+//!
+//! The path variants take host paths. The streamed variants move a tar
+//! archive through a host file descriptor or a chunk callback, holding only
+//! a bounded window of it in memory and none of it on disk.
 
-use std::os::raw::{c_char, c_void};
+use std::io;
+use std::os::fd::FromRawFd;
+use std::os::raw::{c_char, c_int, c_void};
 use std::path::PathBuf;
+use std::pin::Pin;
+use std::sync::Arc;
+use std::task::{Context, Poll};
 
+use boxlite::BoxliteError;
 use boxlite::litebox::copy::CopyOptions;
+use tokio::io::{AsyncRead, AsyncReadExt, AsyncWrite, ReadBuf};
 
 use crate::box_handle::BoxHandle;
 use crate::error::{BoxliteErrorCode, FFIError, null_pointer_error, write_error};
-use crate::event_queue::{CBoxCopyCb, RuntimeEvent, push_event};
+use crate::event_queue::{
+    CBoxCopyCb, CBoxCopyChunkCb, CBoxCopyProgressCb, EventQueue, RuntimeEvent, push_event,
+};
 use crate::util::c_str_to_string;
 use crate::{CBoxHandle, CBoxliteError};
 
+/// Bytes the streamed copy-out pump reads from the guest transfer per chunk
+/// callback; also the size of the pipe between them.
+const COPY_STREAM_CHUNK: usize = 256 * 1024;
+
+/// Bytes moved between two progress callbacks of the fd variants.
+const COPY_PROGRESS_STEP: u64 = 1024 * 1024;
+
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn boxlite_copy_into(
     handle: *mut CBoxHandle,
@@ -20,7 +40,40 @@ pub unsafe extern "C" fn boxlite_copy_into(
     user_data: *mut c_void,
     out_error: *mut CBoxliteError,
 ) -> BoxliteErrorCode {
-    box_copy_into(handle, host_src, guest_dst, cb, user_data, out_error)
+    box_copy_into(
+        handle,
+        host_src,
+        guest_dst,
+        default_copy_options(),
+        cb,
+        user_data,
+        out_error,
+    )
+}
+
+/// Like `boxlite_copy_into`, but a directory source is synced: only entries
+/// that are new or whose size, mtime or mode differ from the destination
+/// are sent, so repeating a copy costs about as much as what changed.
+///
+/// `checksum` != 0 compares file contents by hash instead of mtime.
+/// `block_delta` != 0 updates large changed files in place by sending only
+/// the blocks that differ. File sources are copied in full.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_copy_into_delta(
+    handle: *mut CBoxHandle,
+    host_src: *const c_char,
+    guest_dst: *const c_char,
+    checksum: c_int,
+    block_delta: c_int,
+    cb: CBoxCopyCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    let opts = default_copy_options()
+        .delta(true)
+        .checksum(checksum != 0)
+        .block_delta(block_delta != 0);
+    box_copy_into(handle, host_src, guest_dst, opts, cb, user_data, out_error)
 }
 
 #[unsafe(no_mangle)]
@@ -35,12 +88,65 @@ pub unsafe extern "C" fn boxlite_copy_out(
     box_copy_out(handle, guest_src, host_dst, cb, user_data, out_error)
 }
 
+/// Stream a tar archive read from `fd` into the box at `guest_dst`.
+///
+/// `fd` must be a blocking-mode descriptor positioned at the start of an
+/// uncompressed tar stream; it is read to EOF. The SDK reads from its own
+/// duplicate, so the caller may close `fd` once this returns.
+/// `progress_cb` (may be NULL) receives the running byte count, best-effort.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_copy_into_fd(
+    handle: *mut CBoxHandle,
+    fd: c_int,
+    guest_dst: *const c_char,
+    progress_cb: CBoxCopyProgressCb,
+    cb: CBoxCopyCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    box_copy_into_fd(handle, fd, guest_dst, progress_cb, cb, user_data, out_error)
+}
+
+/// Stream `guest_src` out of the box as a tar archive written to `fd`.
+///
+/// Same descriptor rules as `boxlite_copy_into_fd`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_copy_out_fd(
+    handle: *mut CBoxHandle,
+    guest_src: *const c_char,
+    fd: c_int,
+    progress_cb: CBoxCopyProgressCb,
+    cb: CBoxCopyCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    box_copy_out_fd(handle, guest_src, fd, progress_cb, cb, user_data, out_error)
+}
+
+/// Stream `guest_src` out of the box as tar chunks passed to `chunk_cb`.
+///
+/// Chunks arrive in order on the drain thread and are only valid during
+/// the call; `cb` fires after the last one. The transfer pauses while the
+/// event queue is full, so a slow consumer bounds memory use.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_copy_out_stream(
+    handle: *mut CBoxHandle,
+    guest_src: *const c_char,
+    chunk_cb: CBoxCopyChunkCb,
+    cb: CBoxCopyCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    box_copy_out_stream(handle, guest_src, chunk_cb, cb, user_data, out_error)
+}
+
 fn default_copy_options() -> CopyOptions {
     CopyOptions {
         recursive: true,
         overwrite: true,
         follow_symlinks: false,
         include_parent: false,
+        ..Default::default()
     }
 }
 
@@ -48,6 +154,7 @@ unsafe fn box_copy_into(
     handle: *mut BoxHandle,
     host_src: *const c_char,
     guest_dst: *const c_char,
+    opts: CopyOptions,
     cb: CBoxCopyCb,
     user_data: *mut c_void,
     out_error: *mut FFIError,
@@ -80,7 +187,7 @@ unsafe fn box_copy_into(
         let user_data_addr = user_data as usize;
 
         handle_ref.tokio_rt.spawn(async move {
-            let result = lite.copy_into(src, dst, default_copy_options()).await;
+            let result = lite.copy_into(src, dst, opts).await;
             push_event(
                 &queue,
                 RuntimeEvent::Copy {
@@ -147,3 +254,307 @@ unsafe fn box_copy_out(
         BoxliteErrorCode::Ok
     }
 }
+
+unsafe fn box_copy_into_fd(
+    handle: *mut BoxHandle,
+    fd: c_int,
+    guest_dst: *const c_char,
+    progress_cb: CBoxCopyProgressCb,
+    cb: CBoxCopyCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if handle.is_null() {
+            write_error(out_error, null_pointer_error("handle"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+
+        let dst = match c_str_to_string(guest_dst) {
+            Ok(s) => s,
+            Err(e) => {
+                write_error(out_error, e);
+                return BoxliteErrorCode::InvalidArgument;
+            }
+        };
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+        let file = match dup_fd(fd) {
+            Ok(f) => f,
+            Err(e) => {
+                write_error(out_error, e);
+                return BoxliteErrorCode::InvalidArgument;
+            }
+        };
+
+        let handle_ref = &*handle;
+        let lite = handle_ref.handle.clone();
+        let queue = handle_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+        let progress = progress_reporter(&queue, progress_cb, user_data_addr);
+
+        handle_ref.tokio_rt.spawn(async move {
+            let tar = Counted::new(file, progress);
+            let result = lite
+                .copy_into_stream(tar, dst, default_copy_options())
+                .await;
+            push_event(
+                &queue,
+                RuntimeEvent::Copy {
+                    cb,
+                    user_data: user_data_addr,
+                    result,
+                },
+            )
+            .await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
+unsafe fn box_copy_out_fd(
+    handle: *mut BoxHandle,
+    guest_src: *const c_char,
+    fd: c_int,
+    progress_cb: CBoxCopyProgressCb,
+    cb: CBoxCopyCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if handle.is_null() {
+            write_error(out_error, null_pointer_error("handle"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+
+        let src = match c_str_to_string(guest_src) {
+            Ok(s) => s,
+            Err(e) => {
+                write_error(out_error, e);
+                return BoxliteErrorCode::InvalidArgument;
+            }
+        };
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+        let file = match dup_fd(fd) {
+            Ok(f) => f,
+            Err(e) => {
+                write_error(out_error, e);
+                return BoxliteErrorCode::InvalidArgument;
+            }
+        };
+
+        let handle_ref = &*handle;
+        let lite = handle_ref.handle.clone();
+        let queue = handle_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+        let progress = progress_reporter(&queue, progress_cb, user_data_addr);
+
+        handle_ref.tokio_rt.spawn(async move {
+            let mut sink = Counted::new(file, progress);
+            let result = lite
+                .copy_out_stream(src, &mut sink, default_copy_options())
+                .await;
+            push_event(
+                &queue,
+                RuntimeEvent::Copy {
+                    cb,
+                    user_data: user_data_addr,
+                    result,
+                },
+            )
+            .await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
+unsafe fn box_copy_out_stream(
+    handle: *mut BoxHandle,
+    guest_src: *const c_char,
+    chunk_cb: CBoxCopyChunkCb,
+    cb: CBoxCopyCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if handle.is_null() {
+            write_error(out_error, null_pointer_error("handle"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+
+        let src = match c_str_to_string(guest_src) {
+            Ok(s) => s,
+            Err(e) => {
+                write_error(out_error, e);
+                return BoxliteErrorCode::InvalidArgument;
+            }
+        };
+        let chunk_cb = crate::unwrap_cb_or_return!(chunk_cb, out_error);
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+
+        let handle_ref = &*handle;
+        let lite = handle_ref.handle.clone();
+        let queue = handle_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+
+        handle_ref.tokio_rt.spawn(async move {
+            let (mut writer, mut reader) = tokio::io::duplex(COPY_STREAM_CHUNK);
+            let transfer = async move {
+                let result = lite
+                    .copy_out_stream(src, &mut writer, default_copy_options())
+                    .await;
+                // Closing the pipe ends the pump below.
+                drop(writer);
+                result
+            };
+            let pump_queue = queue.clone();
+            let pump = async move {
+                let mut buf = vec![0u8; COPY_STREAM_CHUNK];
+                loop {
+                    // A read error only follows a failed transfer, which
+                    // reports the cause.
+                    let n = match reader.read(&mut buf).await {
+                        Ok(0) | Err(_) => break,
+                        Ok(n) => n,
+                    };
+                    push_event(
+                        &pump_queue,
+                        RuntimeEvent::CopyChunk {
+                            cb: chunk_cb,
+                            user_data: user_data_addr,
+                            data: bytes::Bytes::copy_from_slice(&buf[..n]),
+                        },
+                    )
+                    .await;
+                }
+            };
+            let (result, ()) = tokio::join!(transfer, pump);
+            push_event(
+                &queue,
+                RuntimeEvent::CopyDone {
+                    cb,
+                    user_data: user_data_addr,
+                    result,
+                },
+            )
+            .await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
+/// Duplicate `fd` so the transfer owns (and closes) its own descriptor.
+fn dup_fd(fd: c_int) -> Result<tokio::fs::File, BoxliteError> {
+    if fd < 0 {
+        return Err(BoxliteError::InvalidArgument(format!(
+            "invalid file descriptor {}",
+            fd
+        )));
+    }
+    let dup = unsafe { libc::fcntl(fd, libc::F_DUPFD_CLOEXEC, 0) };
+    if dup < 0 {
+        return Err(BoxliteError::InvalidArgument(format!(
+            "cannot use file descriptor {}: {}",
+            fd,
+            io::Error::last_os_error()
+        )));
+    }
+    // SAFETY: `dup` is a freshly duplicated descriptor owned by nobody else.
+    let file = unsafe { std::fs::File::from_raw_fd(dup) };
+    Ok(tokio::fs::File::from_std(file))
+}
+
+type ProgressFn = Arc<dyn Fn(u64) + Send + Sync>;
+
+/// Post the running byte count to `progress_cb`, never waiting: reports are
+/// dropped while the control lane is half full, leaving the rest to
+/// completions.
+fn progress_reporter(
+    queue: &Arc<EventQueue>,
+    progress_cb: CBoxCopyProgressCb,
+    user_data: usize,
+) -> Option<ProgressFn> {
+    let progress_cb = progress_cb?;
+    let queue = queue.clone();
+    Some(Arc::new(move |bytes| {
+        if !queue.has_best_effort_room() {
+            return;
+        }
+        let _ = queue.try_push(RuntimeEvent::CopyProgress {
+            cb: progress_cb,
+            user_data,
+            bytes,
+        });
+    }))
+}
+
+/// Byte-counting pass-through for the fd source/sink.
+struct Counted<T> {
+    inner: T,
+    bytes: u64,
+    reported: u64,
+    progress: Option<ProgressFn>,
+}
+
+impl<T> Counted<T> {
+    fn new(inner: T, progress: Option<ProgressFn>) -> Self {
+        Self {
+            inner,
+            bytes: 0,
+            reported: 0,
+            progress,
+        }
+    }
+
+    fn advance(&mut self, n: usize) {
+        self.bytes += n as u64;
+        if self.bytes - self.reported < COPY_PROGRESS_STEP {
+            return;
+        }
+        self.reported = self.bytes;
+        if let Some(progress) = &self.progress {
+            progress(self.bytes);
+        }
+    }
+}
+
+impl<T: AsyncRead + Unpin> AsyncRead for Counted<T> {
+    fn poll_read(
+        self: Pin<&mut Self>,
+        cx: &mut Context<'_>,
+        buf: &mut ReadBuf<'_>,
+    ) -> Poll<io::Result<()>> {
+        let this = self.get_mut();
+        let before = buf.filled().len();
+        let poll = Pin::new(&mut this.inner).poll_read(cx, buf);
+        if let Poll::Ready(Ok(())) = poll {
+            this.advance(buf.filled().len() - before);
+        }
+        poll
+    }
+}
+
+impl<T: AsyncWrite + Unpin> AsyncWrite for Counted<T> {
+    fn poll_write(
+        self: Pin<&mut Self>,
+        cx: &mut Context<'_>,
+        data: &[u8],
+    ) -> Poll<io::Result<usize>> {
+        let this = self.get_mut();
+        let poll = Pin::new(&mut this.inner).poll_write(cx, data);
+        if let Poll::Ready(Ok(n)) = poll {
+            this.advance(n);
+        }
+        poll
+    }
+
+    fn poll_flush(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<io::Result<()>> {
+        Pin::new(&mut self.get_mut().inner).poll_flush(cx)
+    }
+
+    fn poll_shutdown(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<io::Result<()>> {
+        Pin::new(&mut self.get_mut().inner).poll_shutdown(cx)
+    }
+}
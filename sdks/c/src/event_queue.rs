@@ -3,20 +3,39 @@
 //! Tokio tasks push completion events here; the user thread pops them via
 //! `boxlite_runtime_drain` and dispatches the typed callbacks on the calling
 //! thread. Callbacks therefore NEVER fire on Tokio worker threads.
+//!
+//! Events travel in two lanes so that lifecycle completions never wait
+//! behind a backlog of output; see the "Queue" section below.
 
-use std::collections::VecDeque;
+use std::collections::{HashMap, VecDeque};
 use std::os::raw::{c_int, c_void};
-use std::sync::atomic::{AtomicBool, Ordering};
-use std::sync::{Condvar, Mutex};
-
-use boxlite::BoxliteError;
+use std::sync::atomic::{AtomicBool, AtomicU64, AtomicUsize, Ordering, fence};
+use std::sync::{Arc, Condvar, Mutex};
+use std::time::{Duration, Instant};
+
+use boxlite::{BoxliteError, Histogram, HistogramSnapshot};
+use bytes::Bytes;
+use tokio::sync::OwnedSemaphorePermit;
+
+use crate::event_ring::EventRing;
+use crate::images::{CImageInfoList, CImagePullProgress, CImagePullResult};
+use crate::info::{CBoxInfo, CBoxInfoArena, CBoxInfoList};
+use crate::metrics::{
+    CBoxMetrics, CBoxMetricsBatch, CInitTrace, CMemoryReclaimResult, CRuntimeMetrics, MetricsBatch,
+};
+
+/// Maximum number of buffered events per lane before producer tasks yield.
+pub const QUEUE_CAPACITY: usize = 4096;
 
-use crate::images::{CImageInfoList, CImagePullResult};
-use crate::info::{CBoxInfo, CBoxInfoList};
-use crate::metrics::{CBoxMetrics, CRuntimeMetrics};
+/// Control events a drainer delivers back-to-back while streaming output is
+/// also waiting. Control gets this many turns per streaming turn, so a flood
+/// of output delays a lifecycle completion by at most one chunk's callback,
+/// and a burst of completions still cannot starve output.
+const CONTROL_WEIGHT: usize = 8;
 
-/// Maximum number of buffered events before producer tasks yield.
-pub const QUEUE_CAPACITY: usize = 4096;
+/// Output bytes one execution may deliver per round before the next
+/// execution with pending output gets its turn (deficit round robin).
+const STREAM_QUANTUM: usize = 16 * 1024;
 
 /// Unwrap an `Option<extern "C" fn(...)>` callback parameter. If the C
 /// caller passed NULL, write an `InvalidArgument` error and return
@@ -106,12 +125,29 @@ pub(crate) type CBoxGetBoxFn =
 pub type CBoxRemoveBoxCb = Option<extern "C" fn(*mut crate::CBoxliteError, *mut c_void)>;
 pub(crate) type CBoxRemoveBoxFn = extern "C" fn(*mut crate::CBoxliteError, *mut c_void);
 
+/// Batch create completion. The callee owns the result and every handle in it.
+pub type CBoxCreateBoxesCb = Option<
+    extern "C" fn(*mut crate::CBoxBatchCreateResult, *mut crate::CBoxliteError, *mut c_void),
+>;
+pub(crate) type CBoxCreateBoxesFn =
+    extern "C" fn(*mut crate::CBoxBatchCreateResult, *mut crate::CBoxliteError, *mut c_void);
+
+/// Batch start/stop/remove completion. The callee owns the result.
+pub type CBoxBatchCb =
+    Option<extern "C" fn(*mut crate::CBoxBatchResult, *mut crate::CBoxliteError, *mut c_void)>;
+pub(crate) type CBoxBatchFn =
+    extern "C" fn(*mut crate::CBoxBatchResult, *mut crate::CBoxliteError, *mut c_void);
+
 /// Image pull completion.
 pub type CBoxImagePullCb =
     Option<extern "C" fn(*mut CImagePullResult, *mut crate::CBoxliteError, *mut c_void)>;
 pub(crate) type CBoxImagePullFn =
     extern "C" fn(*mut CImagePullResult, *mut crate::CBoxliteError, *mut c_void);
 
+/// Image pull progress. The snapshot is only valid during the call.
+pub type CBoxImagePullProgressCb = Option<extern "C" fn(*const CImagePullProgress, *mut c_void)>;
+pub(crate) type CBoxImagePullProgressFn = extern "C" fn(*const CImagePullProgress, *mut c_void);
+
 /// Image list completion.
 pub type CBoxImageListCb =
     Option<extern "C" fn(*mut CImageInfoList, *mut crate::CBoxliteError, *mut c_void)>;
@@ -122,6 +158,14 @@ pub(crate) type CBoxImageListFn =
 pub type CBoxCopyCb = Option<extern "C" fn(*mut crate::CBoxliteError, *mut c_void)>;
 pub(crate) type CBoxCopyFn = extern "C" fn(*mut crate::CBoxliteError, *mut c_void);
 
+/// Streamed copy progress: tar bytes transferred so far.
+pub type CBoxCopyProgressCb = Option<extern "C" fn(u64, *mut c_void)>;
+pub(crate) type CBoxCopyProgressFn = extern "C" fn(u64, *mut c_void);
+
+/// Streamed copy-out tar chunk.
+pub type CBoxCopyChunkCb = Option<extern "C" fn(*const u8, usize, *mut c_void)>;
+pub(crate) type CBoxCopyChunkFn = extern "C" fn(*const u8, usize, *mut c_void);
+
 /// Box info completion.
 pub type CBoxInfoCb = Option<extern "C" fn(*mut CBoxInfo, *mut crate::CBoxliteError, *mut c_void)>;
 pub(crate) type CBoxInfoFn = extern "C" fn(*mut CBoxInfo, *mut crate::CBoxliteError, *mut c_void);
@@ -132,12 +176,36 @@ pub type CBoxInfoListCb =
 pub(crate) type CBoxInfoListFn =
     extern "C" fn(*mut CBoxInfoList, *mut crate::CBoxliteError, *mut c_void);
 
+/// Box info arena completion. The callee owns the arena.
+pub type CBoxInfoArenaCb =
+    Option<extern "C" fn(*mut CBoxInfoArena, *mut crate::CBoxliteError, *mut c_void)>;
+pub(crate) type CBoxInfoArenaFn =
+    extern "C" fn(*mut CBoxInfoArena, *mut crate::CBoxliteError, *mut c_void);
+
 /// Per-box metrics completion.
 pub type CBoxMetricsCb =
     Option<extern "C" fn(*mut CBoxMetrics, *mut crate::CBoxliteError, *mut c_void)>;
 pub(crate) type CBoxMetricsFn =
     extern "C" fn(*mut CBoxMetrics, *mut crate::CBoxliteError, *mut c_void);
 
+/// Guest memory reclaim completion.
+pub type CMemoryReclaimCb =
+    Option<extern "C" fn(*mut CMemoryReclaimResult, *mut crate::CBoxliteError, *mut c_void)>;
+pub(crate) type CMemoryReclaimFn =
+    extern "C" fn(*mut CMemoryReclaimResult, *mut crate::CBoxliteError, *mut c_void);
+
+/// Metrics subscription tick. The batch is borrowed for the call.
+pub type CBoxMetricsBatchCb =
+    Option<extern "C" fn(*const CBoxMetricsBatch, *mut crate::CBoxliteError, *mut c_void)>;
+pub(crate) type CBoxMetricsBatchFn =
+    extern "C" fn(*const CBoxMetricsBatch, *mut crate::CBoxliteError, *mut c_void);
+
+/// Box init trace completion. The callee owns the trace.
+pub type CBoxInitTraceCb =
+    Option<extern "C" fn(*mut CInitTrace, *mut crate::CBoxliteError, *mut c_void)>;
+pub(crate) type CBoxInitTraceFn =
+    extern "C" fn(*mut CInitTrace, *mut crate::CBoxliteError, *mut c_void);
+
 /// Runtime metrics completion.
 pub type CRuntimeMetricsCb =
     Option<extern "C" fn(*mut CRuntimeMetrics, *mut crate::CBoxliteError, *mut c_void)>;
@@ -262,15 +330,23 @@ impl<T> Drop for OwnedFfiPtr<T> {
 
 pub enum RuntimeEvent {
     /* Streaming */
+    /// `data` is the chunk as received from the backend (refcounted, not
+    /// copied); it is released as soon as the callback returns.
+    ///
+    /// `credit` is the execution's output credit for this event, if the
+    /// execution was started with `output_credits`. Dropping the event —
+    /// after dispatch, or unread when the queue closes — returns it.
     Stdout {
         cb: CBoxStdoutFn,
         user_data: usize,
-        data: Vec<u8>,
+        data: Bytes,
+        credit: Option<OwnedSemaphorePermit>,
     },
     Stderr {
         cb: CBoxStderrFn,
         user_data: usize,
-        data: Vec<u8>,
+        data: Bytes,
+        credit: Option<OwnedSemaphorePermit>,
     },
     Exit {
         cb: CBoxExitFn,
@@ -309,11 +385,29 @@ pub enum RuntimeEvent {
         user_data: usize,
         result: Result<(), BoxliteError>,
     },
+    CreateBoxes {
+        cb: CBoxCreateBoxesFn,
+        user_data: usize,
+        result: Result<OwnedFfiPtr<crate::CBoxBatchCreateResult>, BoxliteError>,
+    },
+    /// Completion of a batch start, stop or remove.
+    BoxBatch {
+        cb: CBoxBatchFn,
+        user_data: usize,
+        result: Result<OwnedFfiPtr<crate::CBoxBatchResult>, BoxliteError>,
+    },
     ImagePull {
         cb: CBoxImagePullFn,
         user_data: usize,
         result: Result<OwnedFfiPtr<CImagePullResult>, BoxliteError>,
     },
+    /// Pushed (never awaited) from the pull's progress callback, so it is
+    /// dropped rather than delayed when the control lane is full.
+    ImagePullProgress {
+        cb: CBoxImagePullProgressFn,
+        user_data: usize,
+        progress: CImagePullProgress,
+    },
     ImageList {
         cb: CBoxImageListFn,
         user_data: usize,
@@ -324,6 +418,25 @@ pub enum RuntimeEvent {
         user_data: usize,
         result: Result<(), BoxliteError>,
     },
+    /// Pushed (never awaited) from a streamed copy, like `ImagePullProgress`.
+    CopyProgress {
+        cb: CBoxCopyProgressFn,
+        user_data: usize,
+        bytes: u64,
+    },
+    /// One chunk of a streamed copy-out. Travels in the stream lane so the
+    /// lane's capacity back-pressures the guest transfer.
+    CopyChunk {
+        cb: CBoxCopyChunkFn,
+        user_data: usize,
+        data: Bytes,
+    },
+    /// Completion of a streamed copy-out, behind its last `CopyChunk`.
+    CopyDone {
+        cb: CBoxCopyFn,
+        user_data: usize,
+        result: Result<(), BoxliteError>,
+    },
     Info {
         cb: CBoxInfoFn,
         user_data: usize,
@@ -334,11 +447,36 @@ pub enum RuntimeEvent {
         user_data: usize,
         result: Result<OwnedFfiPtr<CBoxInfoList>, BoxliteError>,
     },
+    InfoArena {
+        cb: CBoxInfoArenaFn,
+        user_data: usize,
+        result: Result<OwnedFfiPtr<CBoxInfoArena>, BoxliteError>,
+    },
     Metrics {
         cb: CBoxMetricsFn,
         user_data: usize,
         result: Result<CBoxMetrics, BoxliteError>,
     },
+    MemoryReclaim {
+        cb: CMemoryReclaimFn,
+        user_data: usize,
+        result: Result<CMemoryReclaimResult, BoxliteError>,
+    },
+    InitTrace {
+        cb: CBoxInitTraceFn,
+        user_data: usize,
+        result: Result<OwnedFfiPtr<CInitTrace>, BoxliteError>,
+    },
+    /// One tick of a metrics subscription, pushed without waiting like
+    /// `ImagePullProgress`. Not delivered once `cancelled` is set.
+    /// `in_flight` is the subscription's pending flag; dispatch clears it.
+    MetricsBatch {
+        cb: CBoxMetricsBatchFn,
+        user_data: usize,
+        cancelled: Arc<AtomicBool>,
+        in_flight: Arc<AtomicBool>,
+        result: Result<MetricsBatch, BoxliteError>,
+    },
     RtMetrics {
         cb: CRuntimeMetricsFn,
         user_data: usize,
@@ -374,38 +512,409 @@ pub enum RuntimeEvent {
 // SAFETY: every contained field is `Send`:
 //  - extern "C" fn pointers are Send.
 //  - usize (user_data, encoded handle pointers) is Send.
-//  - Vec<u8>, BoxliteError, CBoxMetrics, CRuntimeMetrics own their data.
+//  - Bytes, OwnedSemaphorePermit, BoxliteError, CBoxMetrics, CRuntimeMetrics own their data.
 // Handles encoded as usize represent ownership transfer from the producing
 // Tokio task to the consuming drain thread; no aliasing occurs in transit.
 unsafe impl Send for RuntimeEvent {}
 
+/// Which queue lane an event travels in.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub(crate) enum Lane {
+    /// One-shot completions of async ops (create/start/wait/kill/…).
+    Control,
+    /// Execution output plus its `Exit`, which must stay behind that
+    /// execution's last chunk.
+    Stream,
+}
+
+impl RuntimeEvent {
+    pub(crate) fn lane(&self) -> Lane {
+        match self {
+            RuntimeEvent::Stdout { .. }
+            | RuntimeEvent::Stderr { .. }
+            | RuntimeEvent::Exit { .. }
+            | RuntimeEvent::CopyChunk { .. }
+            | RuntimeEvent::CopyDone { .. } => Lane::Stream,
+            _ => Lane::Control,
+        }
+    }
+
+    /// Flow key for stream events pushed without an explicit one. The
+    /// execution pumps pass their own key (see `push_flow_event`); this
+    /// fallback groups by `user_data`.
+    fn default_flow(&self) -> usize {
+        match self {
+            RuntimeEvent::Stdout { user_data, .. }
+            | RuntimeEvent::Stderr { user_data, .. }
+            | RuntimeEvent::Exit { user_data, .. }
+            | RuntimeEvent::CopyChunk { user_data, .. }
+            | RuntimeEvent::CopyDone { user_data, .. } => *user_data,
+            _ => 0,
+        }
+    }
+
+    /// Which age histogram the event is counted in.
+    fn class(&self) -> EventClass {
+        match self {
+            RuntimeEvent::Stdout { .. }
+            | RuntimeEvent::Stderr { .. }
+            | RuntimeEvent::CopyChunk { .. } => EventClass::Output,
+            RuntimeEvent::Exit { .. } => EventClass::Exit,
+            RuntimeEvent::ImagePullProgress { .. }
+            | RuntimeEvent::CopyProgress { .. }
+            | RuntimeEvent::MetricsBatch { .. } => EventClass::Progress,
+            _ => EventClass::Completion,
+        }
+    }
+
+    /// Deficit charged for delivering a stream event.
+    fn stream_cost(&self) -> usize {
+        match self {
+            RuntimeEvent::Stdout { data, .. }
+            | RuntimeEvent::Stderr { data, .. }
+            | RuntimeEvent::CopyChunk { data, .. } => data.len().max(1),
+            _ => 1,
+        }
+    }
+}
+
+/// Event groups the queue keeps separate age histograms for, so slow
+/// output delivery can be told apart from slow op completions.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+enum EventClass {
+    /// Stdout/stderr and copy-out chunks.
+    Output = 0,
+    /// Execution exits.
+    Exit = 1,
+    /// One-shot op results (create, start, wait, copy done, ...).
+    Completion = 2,
+    /// Best-effort pull/copy progress and metrics ticks.
+    Progress = 3,
+}
+
+const EVENT_CLASSES: usize = 4;
+
+/// A queued event and when it was pushed.
+struct Stamped {
+    ev: RuntimeEvent,
+    pushed: Instant,
+}
+
+impl Stamped {
+    fn new(ev: RuntimeEvent) -> Self {
+        Self {
+            ev,
+            pushed: Instant::now(),
+        }
+    }
+}
+
 // ─── Queue ─────────────────────────────────────────────────────────────────
+//
+// Producers push into a lock-free ring and only touch `park_lock` when a
+// drainer is actually asleep. The hand-off is an eventcount: the drainer
+// bumps `sleepers` and re-checks the ring before waiting, the producer
+// publishes its event and then reads `sleepers`. The two SeqCst fences
+// guarantee at least one side observes the other, so a wakeup is never lost
+// and the common (drainer busy) path takes no lock at all.
+//
+// There is one ring per lane. `try_pop` alternates between them by weight
+// (`CONTROL_WEIGHT` control events per stream event while both have work),
+// so a `CreateBox` or `Wait` completion is delivered almost immediately no
+// matter how much output is queued ahead of it.
+//
+// Within the stream lane the drainer moves events out of the ring into one
+// FIFO per flow — one flow per execution — and serves the flows by deficit
+// round robin, `STREAM_QUANTUM` bytes per turn. One chatty execution cannot
+// hold back the others, and each execution still sees its stdout, stderr
+// and final `Exit` in the order they were produced. Only drainers touch the
+// scheduler lock; producers stay on the lock-free rings.
+//
+// `requeued` holds events a batch drainer popped but chose not to deliver
+// yet (see `boxlite_runtime_drain_records`). They were already scheduled,
+// so `try_pop` serves them first.
+//
+// Every event is stamped on push; `try_pop` records its age (push to
+// dispatch) per `EventClass`. Producers also count lane-full yields and
+// late pushes dropped after close, and drainers time the user callbacks,
+// so `boxlite_runtime_queue_stats` can tell a slow consumer from a slow
+// backend.
 
 pub struct EventQueue {
-    pub inner: Mutex<VecDeque<RuntimeEvent>>,
-    pub cv: Condvar,
+    control: EventRing<Stamped>,
+    /// Stream ingress, tagged with the flow key the event belongs to.
+    stream: EventRing<(usize, Stamped)>,
+    sched: Mutex<StreamScheduler>,
+    /// Events held in `sched` flows; mirrored here so `len` stays lock-free.
+    staged: AtomicUsize,
+    requeued: Mutex<VecDeque<RuntimeEvent>>,
+    /// Fast-path flag so `try_pop` skips the `requeued` lock when it is empty.
+    has_requeued: AtomicBool,
+    /// Drainers inside `park` (registered before their final emptiness check).
+    sleepers: AtomicUsize,
+    /// Guards only the sleep/wake hand-off; never held while events move.
+    park_lock: Mutex<()>,
+    park_cv: Condvar,
     /// Set by `runtime_free`; signals drainers to exit and producers to drop.
-    pub closed: AtomicBool,
+    closed: AtomicBool,
+    /// Events buffered (including the one taken) at each scheduled pop.
+    depth: Histogram,
+    /// Largest buffered count a producer has seen right after its push.
+    peak_depth: AtomicUsize,
+    /// Times a producer found its lane full and yielded before retrying.
+    producer_yields: AtomicU64,
+    /// Events discarded because they were pushed after `mark_closed`.
+    dropped_after_close: AtomicU64,
+    /// Push-to-pop age in microseconds, indexed by `EventClass`.
+    age: [Histogram; EVENT_CLASSES],
+    /// Microseconds the drainer spent in each user callback.
+    callback: Histogram,
+}
+
+/// Point-in-time counters of one runtime's queue.
+pub struct QueueStats {
+    pub depth: usize,
+    pub peak_depth: usize,
+    pub capacity: usize,
+    pub producer_yields: u64,
+    pub dropped_after_close: u64,
+    pub output_age_us: HistogramSnapshot,
+    pub exit_age_us: HistogramSnapshot,
+    pub completion_age_us: HistogramSnapshot,
+    pub progress_age_us: HistogramSnapshot,
+    pub callback_us: HistogramSnapshot,
 }
 
 impl EventQueue {
     pub fn new() -> Self {
+        Self::with_capacity(QUEUE_CAPACITY)
+    }
+
+    /// Queue holding at least `capacity` events per lane before producers
+    /// yield.
+    pub fn with_capacity(capacity: usize) -> Self {
         Self {
-            inner: Mutex::new(VecDeque::new()),
-            cv: Condvar::new(),
+            control: EventRing::with_capacity(capacity),
+            stream: EventRing::with_capacity(capacity),
+            sched: Mutex::new(StreamScheduler::default()),
+            staged: AtomicUsize::new(0),
+            requeued: Mutex::new(VecDeque::new()),
+            has_requeued: AtomicBool::new(false),
+            sleepers: AtomicUsize::new(0),
+            park_lock: Mutex::new(()),
+            park_cv: Condvar::new(),
             closed: AtomicBool::new(false),
+            depth: Histogram::new(),
+            peak_depth: AtomicUsize::new(0),
+            producer_yields: AtomicU64::new(0),
+            dropped_after_close: AtomicU64::new(0),
+            age: std::array::from_fn(|_| Histogram::new()),
+            callback: Histogram::new(),
+        }
+    }
+
+    /// Per-lane capacity.
+    pub fn capacity(&self) -> usize {
+        self.control.capacity()
+    }
+
+    /// Buffered event count (a snapshot while producers are active).
+    pub fn len(&self) -> usize {
+        let requeued = if self.has_requeued.load(Ordering::Acquire) {
+            self.requeued.lock().unwrap().len()
+        } else {
+            0
+        };
+        self.lane_len(Lane::Control) + self.lane_len(Lane::Stream) + requeued
+    }
+
+    /// Buffered event count of one lane; what producers check against
+    /// capacity, so a full stream lane never holds back a control event.
+    pub(crate) fn lane_len(&self, lane: Lane) -> usize {
+        match lane {
+            Lane::Control => self.control.len(),
+            Lane::Stream => self.stream.len() + self.staged.load(Ordering::Acquire),
+        }
+    }
+
+    /// Whether a best-effort control event (a progress report, dropped
+    /// when there is no room) may be pushed. Such events fill at most half
+    /// the control lane, so a burst of them never makes completions and
+    /// exits wait behind it.
+    pub(crate) fn has_best_effort_room(&self) -> bool {
+        !self.is_closed() && self.lane_len(Lane::Control) < self.capacity() / 2
+    }
+
+    pub fn is_empty(&self) -> bool {
+        !self.has_requeued.load(Ordering::Acquire)
+            && self.control.is_empty()
+            && self.stream.is_empty()
+            && self.staged.load(Ordering::Acquire) == 0
+    }
+
+    /// Enqueue without waiting; hands the event back if its lane is full.
+    /// Stream events are grouped by `user_data`; see `try_push_flow`.
+    pub fn try_push(&self, ev: RuntimeEvent) -> Result<(), RuntimeEvent> {
+        let flow = ev.default_flow();
+        self.try_push_flow(flow, ev)
+    }
+
+    /// Enqueue with an explicit flow key for stream events (ignored for
+    /// control events). Events sharing a key are delivered in push order.
+    pub fn try_push_flow(&self, flow: usize, ev: RuntimeEvent) -> Result<(), RuntimeEvent> {
+        match ev.lane() {
+            Lane::Control => self.control.push(Stamped::new(ev)).map_err(|s| s.ev)?,
+            Lane::Stream => self
+                .stream
+                .push((flow, Stamped::new(ev)))
+                .map_err(|(_, s)| s.ev)?,
+        }
+        let depth = self.lane_len(Lane::Control) + self.lane_len(Lane::Stream);
+        // Plain load first: the RMW only happens while the peak is rising.
+        if depth > self.peak_depth.load(Ordering::Relaxed) {
+            self.peak_depth.fetch_max(depth, Ordering::Relaxed);
+        }
+        self.wake_drainer();
+        Ok(())
+    }
+
+    /// Dequeue the next event without waiting, per the lane weights and
+    /// the per-flow round robin.
+    pub fn try_pop(&self) -> Option<RuntimeEvent> {
+        if self.has_requeued.load(Ordering::Acquire) {
+            let mut requeued = self.requeued.lock().unwrap();
+            if let Some(ev) = requeued.pop_front() {
+                self.has_requeued
+                    .store(!requeued.is_empty(), Ordering::Release);
+                return Some(ev);
+            }
+        }
+
+        // Requeued events were counted when first popped.
+        let depth = self.len();
+        let stamped = self.pop_scheduled()?;
+        self.depth.record(depth as u64);
+        self.age[stamped.ev.class() as usize].record_micros(stamped.pushed.elapsed());
+        Some(stamped.ev)
+    }
+
+    fn pop_scheduled(&self) -> Option<Stamped> {
+        let mut sched = self.sched.lock().unwrap();
+        let stream_waiting = sched.has_pending() || !self.stream.is_empty();
+        if !stream_waiting || sched.control_streak < CONTROL_WEIGHT {
+            if let Some(ev) = self.control.pop() {
+                sched.control_streak = if stream_waiting {
+                    sched.control_streak + 1
+                } else {
+                    0
+                };
+                return Some(ev);
+            }
         }
+        sched.control_streak = 0;
+        while let Some((flow, ev)) = self.stream.pop() {
+            sched.enqueue(flow, ev);
+            self.staged.fetch_add(1, Ordering::AcqRel);
+        }
+        if let Some(ev) = sched.next() {
+            self.staged.fetch_sub(1, Ordering::AcqRel);
+            return Some(ev);
+        }
+        // A producer may have claimed a stream slot it has not filled yet;
+        // fall back to control rather than report empty.
+        self.control.pop()
+    }
+
+    /// Count a producer yield on a full lane.
+    fn note_yield(&self) {
+        self.producer_yields.fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// Count an event discarded because the queue was closed.
+    fn note_dropped(&self) {
+        self.dropped_after_close.fetch_add(1, Ordering::Relaxed);
+    }
+
+    /// Record the time one user callback took.
+    pub(crate) fn record_callback(&self, elapsed: Duration) {
+        self.callback.record_micros(elapsed);
+    }
+
+    /// Snapshot of the queue's counters and histograms.
+    pub fn stats(&self) -> QueueStats {
+        let age = |class: EventClass| self.age[class as usize].snapshot();
+        QueueStats {
+            depth: self.len(),
+            peak_depth: self.peak_depth.load(Ordering::Relaxed),
+            capacity: self.capacity(),
+            producer_yields: self.producer_yields.load(Ordering::Relaxed),
+            dropped_after_close: self.dropped_after_close.load(Ordering::Relaxed),
+            output_age_us: age(EventClass::Output),
+            exit_age_us: age(EventClass::Exit),
+            completion_age_us: age(EventClass::Completion),
+            progress_age_us: age(EventClass::Progress),
+            callback_us: self.callback.snapshot(),
+        }
+    }
+
+    /// Distribution of the queue depth seen by drainers.
+    pub fn depth_histogram(&self) -> boxlite::HistogramSnapshot {
+        self.depth.snapshot()
+    }
+
+    /// Put back an event just returned by `try_pop` so the next pop sees it
+    /// first. Never blocks on capacity: the slot it came from is already
+    /// accounted for.
+    pub fn requeue_front(&self, ev: RuntimeEvent) {
+        let mut requeued = self.requeued.lock().unwrap();
+        requeued.push_front(ev);
+        self.has_requeued.store(true, Ordering::Release);
+    }
+
+    /// Block the calling thread until an event may be available, the queue
+    /// is closed, or `deadline` passes. May return spuriously; callers loop
+    /// on `try_pop`.
+    pub fn park(&self, deadline: Option<Instant>) {
+        let guard = self.park_lock.lock().unwrap();
+        self.sleepers.fetch_add(1, Ordering::SeqCst);
+        fence(Ordering::SeqCst);
+        if self.is_empty() && !self.is_closed() {
+            match deadline {
+                None => drop(self.park_cv.wait(guard).unwrap()),
+                Some(d) => {
+                    let now = Instant::now();
+                    if d > now {
+                        drop(self.park_cv.wait_timeout(guard, d - now).unwrap());
+                    }
+                }
+            }
+        }
+        self.sleepers.fetch_sub(1, Ordering::SeqCst);
     }
 
     /// Mark the queue closed and wake every parked drainer so they observe it.
     pub fn mark_closed(&self) {
         self.closed.store(true, Ordering::Release);
-        self.cv.notify_all();
+        // Taking the lock orders the store before any drainer's re-check.
+        drop(self.park_lock.lock().unwrap());
+        self.park_cv.notify_all();
     }
 
     pub fn is_closed(&self) -> bool {
         self.closed.load(Ordering::Acquire)
     }
+
+    fn wake_drainer(&self) {
+        fence(Ordering::SeqCst);
+        if self.sleepers.load(Ordering::SeqCst) == 0 {
+            return;
+        }
+        // A registered sleeper holds `park_lock` from its re-check until it
+        // is inside `wait`; acquiring it here means the notify cannot slip
+        // into that gap.
+        drop(self.park_lock.lock().unwrap());
+        self.park_cv.notify_one();
+    }
 }
 
 impl Default for EventQueue {
@@ -414,37 +923,110 @@ impl Default for EventQueue {
     }
 }
 
-/// Push an event to the queue. If the queue is full, cooperatively yield and
+/// Drainer-side state of the stream lane.
+#[derive(Default)]
+struct StreamScheduler {
+    flows: HashMap<usize, Flow>,
+    /// Flows with pending events in round-robin order; the front one is
+    /// being served.
+    active: VecDeque<usize>,
+    /// Whether the front flow has received its quantum for this turn.
+    front_granted: bool,
+    /// Control events delivered since the last stream event.
+    control_streak: usize,
+}
+
+#[derive(Default)]
+struct Flow {
+    events: VecDeque<Stamped>,
+    /// Bytes this flow may still deliver before yielding its turn.
+    deficit: usize,
+}
+
+impl StreamScheduler {
+    fn has_pending(&self) -> bool {
+        !self.active.is_empty()
+    }
+
+    fn enqueue(&mut self, key: usize, ev: Stamped) {
+        let flow = self.flows.entry(key).or_insert_with(|| {
+            self.active.push_back(key);
+            Flow::default()
+        });
+        flow.events.push_back(ev);
+    }
+
+    fn next(&mut self) -> Option<Stamped> {
+        loop {
+            let key = *self.active.front()?;
+            let flow = self.flows.get_mut(&key)?;
+            if !self.front_granted {
+                flow.deficit += STREAM_QUANTUM;
+                self.front_granted = true;
+            }
+            let cost = flow.events.front().map_or(0, |s| s.ev.stream_cost());
+            // A lone flow never waits on itself, however large the chunk.
+            if flow.deficit >= cost || self.active.len() == 1 {
+                flow.deficit = flow.deficit.saturating_sub(cost);
+                let ev = flow.events.pop_front();
+                if flow.events.is_empty() {
+                    self.flows.remove(&key);
+                    self.active.pop_front();
+                    self.front_granted = false;
+                }
+                return ev;
+            }
+            // Quantum spent: the flow keeps its leftover deficit and goes
+            // to the back of the round.
+            self.active.rotate_left(1);
+            self.front_granted = false;
+        }
+    }
+}
+
+/// Push an event to the queue. If its lane is full, cooperatively yield and
 /// retry — Tokio workers stay free for other tasks.
 pub async fn push_event(queue: &EventQueue, ev: RuntimeEvent) {
-    push_event_with_capacity(queue, ev, QUEUE_CAPACITY).await;
+    push_event_with_capacity(queue, ev, queue.capacity()).await;
+}
+
+/// `push_event` for a stream event of flow `flow`. The execution pumps key
+/// all of an execution's output and its `Exit` by the execution itself, so
+/// ordering and fairness hold even when each callback gets different
+/// `user_data`.
+pub async fn push_flow_event(queue: &EventQueue, flow: usize, ev: RuntimeEvent) {
+    push_lane_event(queue, flow, ev, queue.capacity()).await;
 }
 
 /// Push an event with a caller-supplied capacity. Used by tests to exercise
 /// the cooperative-yield path without flooding the production-sized queue.
-#[cfg_attr(not(test), allow(dead_code))]
 pub(crate) async fn push_event_with_capacity(
     queue: &EventQueue,
     ev: RuntimeEvent,
     capacity: usize,
 ) {
-    let mut ev = Some(ev);
+    let flow = ev.default_flow();
+    push_lane_event(queue, flow, ev, capacity).await;
+}
+
+async fn push_lane_event(queue: &EventQueue, flow: usize, ev: RuntimeEvent, capacity: usize) {
+    let lane = ev.lane();
+    let mut ev = ev;
     loop {
         // Drop late events posted after the runtime has been freed; the
         // drainer is gone and the typed result/`user_data` would never be
         // observed by anyone.
         if queue.is_closed() {
+            queue.note_dropped();
             return;
         }
-        {
-            let mut g = queue.inner.lock().unwrap();
-            if g.len() < capacity {
-                g.push_back(ev.take().expect("event consumed exactly once"));
-                drop(g);
-                queue.cv.notify_one();
-                return;
+        if queue.lane_len(lane) < capacity {
+            match queue.try_push_flow(flow, ev) {
+                Ok(()) => return,
+                Err(rejected) => ev = rejected,
             }
         }
+        queue.note_yield();
         tokio::task::yield_now().await;
     }
 }
@@ -558,7 +1140,8 @@ mod phase2_regression_tests {
                         RuntimeEvent::Stdout {
                             cb: record_thread_id_cb,
                             user_data: 0,
-                            data: vec![i as u8],
+                            data: vec![i as u8].into(),
+                            credit: None,
                         },
                     )
                     .await;
@@ -644,7 +1227,8 @@ mod phase2_regression_tests {
                         RuntimeEvent::Stdout {
                             cb: sleep_cb,
                             user_data: 0,
-                            data: Vec::new(),
+                            data: Bytes::new(),
+                            credit: None,
                         },
                     )
                     .await;
@@ -734,7 +1318,8 @@ mod phase2_regression_tests {
                         RuntimeEvent::Stdout {
                             cb: noop_stdout,
                             user_data: 0,
-                            data: vec![i as u8],
+                            data: vec![i as u8].into(),
+                            credit: None,
                         },
                         TEST_CAPACITY,
                     )
@@ -890,12 +1475,14 @@ mod close_and_free_tests {
             RuntimeEvent::Stdout {
                 cb: dummy_stdout_cb,
                 user_data: 0,
-                data: vec![1, 2, 3],
+                data: vec![1, 2, 3].into(),
+                credit: None,
             },
             4,
         ));
 
-        assert_eq!(queue.inner.lock().unwrap().len(), 0);
+        assert_eq!(queue.len(), 0);
+        assert_eq!(queue.stats().dropped_after_close, 1);
     }
 
     /// The actual UAF reproducer: drain is parked when runtime_free runs.
@@ -1137,6 +1724,8 @@ mod owned_ffi_ptr_nested_leak_tests {
             cpus: 1,
             memory_mib: 256,
             created_at: 0,
+            placement_cpus: test_cstr("0-1"),
+            placement_mems: test_cstr("0"),
         });
 
         let owned = OwnedFfiPtr::new_with(payload, crate::info::free_box_info_ptr);
@@ -1145,9 +1734,9 @@ mod owned_ffi_ptr_nested_leak_tests {
         let after = FREE_STR_CALLS.load(AtomicOrdering::SeqCst);
         assert_eq!(
             after - before,
-            4,
+            6,
             "OwnedFfiPtr<CBoxInfo>::drop reclaimed {} inner CStrings; \
-             expected 4 (id + name + image + status). Inner allocations leak.",
+             expected 6 (id + name + image + status + placement). Inner allocations leak.",
             after - before
         );
     }
@@ -1204,6 +1793,8 @@ mod owned_ffi_ptr_nested_leak_tests {
             cpus: 2,
             memory_mib: 512,
             created_at: 0,
+            placement_cpus: std::ptr::null_mut(),
+            placement_mems: std::ptr::null_mut(),
         }];
         let items_ptr = items_vec.as_mut_ptr();
         let items_len = items_vec.len();
@@ -1212,6 +1803,7 @@ mod owned_ffi_ptr_nested_leak_tests {
         let payload = Box::new(CBoxInfoList {
             items: items_ptr,
             count: items_len as std::os::raw::c_int,
+            total: items_len as std::os::raw::c_int,
         });
 
         let owned = OwnedFfiPtr::new_with(payload, crate::info::free_box_info_list);
@@ -1357,11 +1949,7 @@ mod exit_dispatch_backpressure_tests {
             let queue = queue.clone();
             async move {
                 tokio::time::sleep(Duration::from_millis(20)).await;
-                {
-                    let mut g = queue.inner.lock().unwrap();
-                    g.pop_front();
-                }
-                queue.cv.notify_all();
+                queue.try_pop();
             }
         });
 
@@ -1373,10 +1961,7 @@ mod exit_dispatch_backpressure_tests {
         let _ = drain_task.await;
 
         // Drain queue and count Exit events for our marker user_data.
-        let events: Vec<RuntimeEvent> = {
-            let mut g = queue.inner.lock().unwrap();
-            g.drain(..).collect()
-        };
+        let events: Vec<RuntimeEvent> = std::iter::from_fn(|| queue.try_pop()).collect();
         let marker_exit_count = events
             .iter()
             .filter(|e| {
@@ -1399,3 +1984,192 @@ mod exit_dispatch_backpressure_tests {
         );
     }
 }
+
+// ─── Lane scheduling ──────────────────────────────────────────────────────
+//
+// Control completions must not queue behind output, output must not starve
+// behind a burst of completions, and one execution's output must not hold
+// back another's — while each execution still sees its own events, `Exit`
+// last, in production order.
+
+#[cfg(test)]
+mod lane_tests {
+    use super::*;
+
+    extern "C" fn noop_stdout_cb(_: *const u8, _: usize, _: *mut c_void) {}
+    extern "C" fn noop_exit_cb(_: c_int, _: *mut c_void) {}
+    extern "C" fn noop_start_cb(_: *mut crate::CBoxliteError, _: *mut c_void) {}
+
+    fn stdout(flow: usize, len: usize) -> RuntimeEvent {
+        RuntimeEvent::Stdout {
+            cb: noop_stdout_cb,
+            user_data: flow,
+            data: vec![0u8; len].into(),
+            credit: None,
+        }
+    }
+
+    fn start(user_data: usize) -> RuntimeEvent {
+        RuntimeEvent::StartBox {
+            cb: noop_start_cb,
+            user_data,
+            result: Ok(()),
+        }
+    }
+
+    /// (lane, user_data) of each event in pop order.
+    fn pop_all(queue: &EventQueue) -> Vec<(Lane, usize)> {
+        std::iter::from_fn(|| queue.try_pop())
+            .map(|ev| {
+                let user_data = match &ev {
+                    RuntimeEvent::StartBox { user_data, .. } => *user_data,
+                    other => other.default_flow(),
+                };
+                (ev.lane(), user_data)
+            })
+            .collect()
+    }
+
+    #[test]
+    fn control_event_overtakes_queued_output() {
+        let queue = EventQueue::new();
+        for _ in 0..1000 {
+            assert!(queue.try_push(stdout(1, 64)).is_ok());
+        }
+        assert!(queue.try_push(start(7)).is_ok());
+
+        let order = pop_all(&queue);
+        assert_eq!(order[0], (Lane::Control, 7));
+        assert_eq!(order.len(), 1001);
+    }
+
+    #[test]
+    fn output_still_flows_during_a_control_burst() {
+        let queue = EventQueue::new();
+        assert!(queue.try_push(stdout(1, 8)).is_ok());
+        for i in 0..(CONTROL_WEIGHT * 3) {
+            assert!(queue.try_push(start(i)).is_ok());
+        }
+
+        let order = pop_all(&queue);
+        let first_stream = order.iter().position(|(lane, _)| *lane == Lane::Stream);
+        assert_eq!(first_stream, Some(CONTROL_WEIGHT));
+    }
+
+    #[test]
+    fn busy_execution_does_not_hold_back_another() {
+        let queue = EventQueue::new();
+        for _ in 0..20 {
+            assert!(queue.try_push(stdout(1, STREAM_QUANTUM)).is_ok());
+        }
+        assert!(queue.try_push(stdout(2, 16)).is_ok());
+
+        let order = pop_all(&queue);
+        let quiet = order.iter().position(|&(_, flow)| flow == 2);
+        assert_eq!(quiet, Some(1), "flow 2 waits one quantum of flow 1, not 20");
+    }
+
+    #[test]
+    fn each_flow_keeps_its_order_and_exit_stays_last() {
+        let queue = EventQueue::new();
+        for flow in [1u8, 2] {
+            for i in 0..3u8 {
+                let mut data = vec![0u8; STREAM_QUANTUM];
+                data[0] = flow;
+                data[1] = i;
+                // `user_data` differs from the flow key on purpose: the key
+                // alone decides grouping.
+                let ev = RuntimeEvent::Stdout {
+                    cb: noop_stdout_cb,
+                    user_data: 0,
+                    data: data.into(),
+                    credit: None,
+                };
+                assert!(queue.try_push_flow(flow as usize, ev).is_ok());
+            }
+            let exit = RuntimeEvent::Exit {
+                cb: noop_exit_cb,
+                user_data: 0,
+                exit_code: flow as i32,
+            };
+            assert!(queue.try_push_flow(flow as usize, exit).is_ok());
+        }
+
+        // (flow, chunk index); `Exit` is index 9.
+        let order: Vec<(u8, u8)> = std::iter::from_fn(|| queue.try_pop())
+            .map(|ev| match ev {
+                RuntimeEvent::Stdout { data, .. } => (data[0], data[1]),
+                RuntimeEvent::Exit { exit_code, .. } => (exit_code as u8, 9),
+                _ => unreachable!(),
+            })
+            .collect();
+        assert_eq!(order[0].0, 1);
+        assert_eq!(order[1].0, 2, "flows take turns");
+        for flow in [1, 2] {
+            let own: Vec<u8> = order
+                .iter()
+                .filter(|(f, _)| *f == flow)
+                .map(|(_, i)| *i)
+                .collect();
+            assert_eq!(own, vec![0, 1, 2, 9]);
+        }
+    }
+
+    #[test]
+    fn full_stream_lane_does_not_block_control_producers() {
+        let queue = EventQueue::with_capacity(4);
+        for _ in 0..4 {
+            assert!(queue.try_push(stdout(1, 1)).is_ok());
+        }
+        assert!(queue.try_push(stdout(1, 1)).is_err());
+        assert_eq!(queue.lane_len(Lane::Stream), 4);
+        assert_eq!(queue.lane_len(Lane::Control), 0);
+        assert!(
+            queue.try_push(start(0)).is_ok(),
+            "control lane has its own capacity"
+        );
+    }
+
+    #[test]
+    fn best_effort_events_leave_half_the_control_lane() {
+        let queue = EventQueue::with_capacity(4);
+        for _ in 0..2 {
+            assert!(queue.has_best_effort_room());
+            assert!(queue.try_push(start(0)).is_ok());
+        }
+        assert!(!queue.has_best_effort_room());
+        assert!(queue.try_push(start(0)).is_ok(), "completions still fit");
+    }
+
+    #[test]
+    fn stats_track_depth_and_age_per_class() {
+        let queue = EventQueue::new();
+        for _ in 0..3 {
+            assert!(queue.try_push(stdout(1, 8)).is_ok());
+        }
+        assert!(queue.try_push(start(0)).is_ok());
+        assert_eq!(queue.stats().depth, 4);
+
+        assert_eq!(pop_all(&queue).len(), 4);
+        let stats = queue.stats();
+        assert_eq!(stats.depth, 0);
+        assert_eq!(stats.peak_depth, 4);
+        assert_eq!(stats.output_age_us.count, 3);
+        assert_eq!(stats.completion_age_us.count, 1);
+        assert_eq!(stats.exit_age_us.count, 0);
+        assert_eq!(queue.depth_histogram().max, 4);
+    }
+
+    #[test]
+    fn requeued_event_is_counted_once() {
+        let queue = EventQueue::new();
+        assert!(queue.try_push(start(0)).is_ok());
+        let ev = queue.try_pop().unwrap();
+        queue.requeue_front(ev);
+        assert!(queue.try_pop().is_some());
+
+        let stats = queue.stats();
+        assert_eq!(stats.completion_age_us.count, 1);
+        assert_eq!(queue.depth_histogram().count, 1);
+    }
+}
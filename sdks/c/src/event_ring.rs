@@ -0,0 +1,249 @@
+//! Bounded lock-free ring backing the per-runtime `EventQueue`.
+//!
+//! Vyukov-style bounded array queue: every slot carries a sequence number
+//! that says whose turn it is (producer or consumer), so a push or a pop is
+//! one CAS on a shared cursor plus one release store on the slot. Producers
+//! on Tokio workers never contend on a lock with the drain thread.
+//!
+//! The C drain is the only consumer in practice, but the algorithm is
+//! multi-consumer safe, so two threads calling `boxlite_runtime_drain` on
+//! the same runtime stay sound.
+
+use std::cell::UnsafeCell;
+use std::mem::MaybeUninit;
+use std::sync::atomic::{AtomicUsize, Ordering};
+
+/// Smallest ring the sequence protocol supports. With one slot the "free"
+/// and "full" sequence values collide, so a pusher would overwrite the
+/// unread value.
+const MIN_RING_SLOTS: usize = 2;
+
+/// Keeps the producer and consumer cursors on separate cache lines so a
+/// busy pump does not bounce the drainer's line on every push.
+#[repr(align(64))]
+struct CachePadded<T>(T);
+
+struct Slot<T> {
+    /// `pos` = free for the producer claiming `pos`;
+    /// `pos + 1` = filled, ready for the consumer claiming `pos`.
+    seq: AtomicUsize,
+    value: UnsafeCell<MaybeUninit<T>>,
+}
+
+pub(crate) struct EventRing<T> {
+    slots: Box<[Slot<T>]>,
+    mask: usize,
+    /// Next position to pop.
+    head: CachePadded<AtomicUsize>,
+    /// Next position to push.
+    tail: CachePadded<AtomicUsize>,
+}
+
+// SAFETY: a slot's value is only touched by the single thread that won the
+// cursor CAS for that position, and hand-off is ordered by the slot's
+// Release/Acquire sequence number. `T: Send` is all that is needed to move
+// values between those threads.
+unsafe impl<T: Send> Send for EventRing<T> {}
+unsafe impl<T: Send> Sync for EventRing<T> {}
+
+impl<T> EventRing<T> {
+    /// Allocate a ring holding at least `capacity` values (rounded up to a
+    /// power of two so the slot index is a mask, not a division).
+    pub(crate) fn with_capacity(capacity: usize) -> Self {
+        let slots_len = capacity.max(MIN_RING_SLOTS).next_power_of_two();
+        let slots = (0..slots_len)
+            .map(|pos| Slot {
+                seq: AtomicUsize::new(pos),
+                value: UnsafeCell::new(MaybeUninit::uninit()),
+            })
+            .collect();
+        Self {
+            slots,
+            mask: slots_len - 1,
+            head: CachePadded(AtomicUsize::new(0)),
+            tail: CachePadded(AtomicUsize::new(0)),
+        }
+    }
+
+    pub(crate) fn capacity(&self) -> usize {
+        self.slots.len()
+    }
+
+    /// Number of values pushed but not yet popped. Exact when producers and
+    /// consumers are quiescent; otherwise a snapshot that may lag by the
+    /// operations in flight.
+    pub(crate) fn len(&self) -> usize {
+        // Load head first: head only moves toward tail, so the later tail
+        // load can never be behind it.
+        let head = self.head.0.load(Ordering::Acquire);
+        let tail = self.tail.0.load(Ordering::Acquire);
+        tail.wrapping_sub(head).min(self.capacity())
+    }
+
+    pub(crate) fn is_empty(&self) -> bool {
+        self.len() == 0
+    }
+
+    /// Push `value`, or hand it back if every slot is occupied.
+    pub(crate) fn push(&self, value: T) -> Result<(), T> {
+        let mut pos = self.tail.0.load(Ordering::Relaxed);
+        loop {
+            let slot = &self.slots[pos & self.mask];
+            let seq = slot.seq.load(Ordering::Acquire);
+            let lag = seq.wrapping_sub(pos) as isize;
+            if lag == 0 {
+                match self.tail.0.compare_exchange_weak(
+                    pos,
+                    pos.wrapping_add(1),
+                    Ordering::Relaxed,
+                    Ordering::Relaxed,
+                ) {
+                    Ok(_) => {
+                        // SAFETY: winning the CAS for `pos` grants exclusive
+                        // write access to this slot until `seq` is published.
+                        unsafe { (*slot.value.get()).write(value) };
+                        slot.seq.store(pos.wrapping_add(1), Ordering::Release);
+                        return Ok(());
+                    }
+                    Err(current) => pos = current,
+                }
+            } else if lag < 0 {
+                // The slot still holds the value from one lap ago: full.
+                return Err(value);
+            } else {
+                pos = self.tail.0.load(Ordering::Relaxed);
+            }
+        }
+    }
+
+    /// Pop the oldest value, or `None` if nothing is ready.
+    pub(crate) fn pop(&self) -> Option<T> {
+        let mut pos = self.head.0.load(Ordering::Relaxed);
+        loop {
+            let slot = &self.slots[pos & self.mask];
+            let seq = slot.seq.load(Ordering::Acquire);
+            let lag = seq.wrapping_sub(pos.wrapping_add(1)) as isize;
+            if lag == 0 {
+                match self.head.0.compare_exchange_weak(
+                    pos,
+                    pos.wrapping_add(1),
+                    Ordering::Relaxed,
+                    Ordering::Relaxed,
+                ) {
+                    Ok(_) => {
+                        // SAFETY: `seq == pos + 1` means the producer for
+                        // `pos` published an initialized value, and winning
+                        // the CAS makes us its only reader.
+                        let value = unsafe { (*slot.value.get()).assume_init_read() };
+                        slot.seq
+                            .store(pos.wrapping_add(self.mask + 1), Ordering::Release);
+                        return Some(value);
+                    }
+                    Err(current) => pos = current,
+                }
+            } else if lag < 0 {
+                // Slot not yet filled for this lap: empty (or a producer has
+                // claimed it and is mid-write).
+                return None;
+            } else {
+                pos = self.head.0.load(Ordering::Relaxed);
+            }
+        }
+    }
+}
+
+impl<T> Drop for EventRing<T> {
+    fn drop(&mut self) {
+        // Undelivered values own real resources (e.g. `OwnedFfiPtr` payloads
+        // holding a live box); run their destructors.
+        while self.pop().is_some() {}
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::collections::HashSet;
+    use std::sync::Arc;
+    use std::sync::atomic::AtomicUsize;
+    use std::thread;
+
+    #[test]
+    fn capacity_rounds_up_to_power_of_two() {
+        assert_eq!(EventRing::<u8>::with_capacity(0).capacity(), 2);
+        assert_eq!(EventRing::<u8>::with_capacity(1).capacity(), 2);
+        assert_eq!(EventRing::<u8>::with_capacity(5).capacity(), 8);
+        assert_eq!(EventRing::<u8>::with_capacity(4096).capacity(), 4096);
+    }
+
+    #[test]
+    fn push_rejects_when_full_and_preserves_fifo_order() {
+        let ring = EventRing::with_capacity(4);
+        for i in 0..4 {
+            ring.push(i).expect("slot available");
+        }
+        assert_eq!(ring.push(99), Err(99), "fifth push must be rejected");
+        assert_eq!(ring.len(), 4);
+
+        assert_eq!(ring.pop(), Some(0));
+        ring.push(4).expect("slot freed by pop");
+        let drained: Vec<_> = std::iter::from_fn(|| ring.pop()).collect();
+        assert_eq!(drained, vec![1, 2, 3, 4]);
+        assert!(ring.is_empty());
+    }
+
+    #[test]
+    fn drop_runs_destructors_of_unpopped_values() {
+        let dropped = Arc::new(AtomicUsize::new(0));
+        struct Tracked(Arc<AtomicUsize>);
+        impl Drop for Tracked {
+            fn drop(&mut self) {
+                self.0.fetch_add(1, Ordering::SeqCst);
+            }
+        }
+
+        let ring = EventRing::with_capacity(8);
+        for _ in 0..3 {
+            assert!(ring.push(Tracked(dropped.clone())).is_ok());
+        }
+        drop(ring);
+        assert_eq!(dropped.load(Ordering::SeqCst), 3);
+    }
+
+    /// Many producers racing one consumer across several laps of a small
+    /// ring: every value arrives exactly once.
+    #[test]
+    fn concurrent_producers_deliver_each_value_exactly_once() {
+        const PRODUCERS: usize = 8;
+        const PER_PRODUCER: usize = 10_000;
+
+        let ring = Arc::new(EventRing::with_capacity(64));
+        let producers: Vec<_> = (0..PRODUCERS)
+            .map(|p| {
+                let ring = ring.clone();
+                thread::spawn(move || {
+                    for i in 0..PER_PRODUCER {
+                        let mut value = p * PER_PRODUCER + i;
+                        while let Err(rejected) = ring.push(value) {
+                            value = rejected;
+                            thread::yield_now();
+                        }
+                    }
+                })
+            })
+            .collect();
+
+        let mut seen = HashSet::with_capacity(PRODUCERS * PER_PRODUCER);
+        while seen.len() < PRODUCERS * PER_PRODUCER {
+            match ring.pop() {
+                Some(value) => assert!(seen.insert(value), "value {value} popped twice"),
+                None => thread::yield_now(),
+            }
+        }
+        for producer in producers {
+            producer.join().expect("producer panicked");
+        }
+        assert!(ring.pop().is_none());
+    }
+}
@@ -0,0 +1,299 @@
+//! Bounded, binary-safe output capture for `boxlite_simple_run_captured`.
+//!
+//! `boxlite_simple_run` buffers each stream as text in full. Capture mode
+//! keeps raw bytes instead, at most `max_bytes` per stream however much the
+//! command prints: the first `max_bytes - tail_bytes` and the last
+//! `tail_bytes`, with the byte count of everything in between reported as
+//! truncated. A stream can also be spilled whole to a file as it arrives,
+//! so the complete output survives without ever sitting in memory.
+
+use std::collections::VecDeque;
+use std::os::raw::{c_char, c_int};
+use std::path::PathBuf;
+use std::ptr;
+
+use boxlite::BoxliteError;
+use bytes::Bytes;
+use futures::{Stream, StreamExt};
+use tokio::io::AsyncWriteExt;
+
+use crate::util::c_str_to_string;
+
+/// Capture limits for `boxlite_simple_run_captured`. A zero-initialized
+/// struct (or a NULL pointer) keeps all output, unbounded, without
+/// spilling.
+#[repr(C)]
+pub struct BoxliteCaptureOptions {
+    /// Most bytes kept in memory per stream. 0 = unlimited.
+    pub max_bytes: usize,
+    /// How many of `max_bytes` come from the end of the stream; the rest
+    /// come from its start. Clamped to `max_bytes`. Ignored when
+    /// `max_bytes` is 0.
+    pub tail_bytes: usize,
+    /// If non-NULL, all of stdout is also written to this file (created
+    /// or truncated), regardless of `max_bytes`.
+    pub stdout_path: *const c_char,
+    /// Same as `stdout_path`, for stderr.
+    pub stderr_path: *const c_char,
+}
+
+/// One captured stream. `data[..head_len]` is the start of the stream and
+/// `data[head_len..len]` its end; when `truncated` is set, the
+/// `total_len - len` bytes between them were dropped.
+#[repr(C)]
+pub struct CapturedStream {
+    /// Retained bytes; NULL when `len` is 0. May contain NUL bytes.
+    pub data: *mut u8,
+    pub len: usize,
+    pub head_len: usize,
+    /// Bytes the command wrote to the stream in total.
+    pub total_len: u64,
+    pub truncated: c_int,
+}
+
+/// Result of `boxlite_simple_run_captured`. Free with
+/// `boxlite_capture_result_free`.
+#[repr(C)]
+pub struct CaptureResult {
+    pub exit_code: c_int,
+    pub stdout_capture: CapturedStream,
+    pub stderr_capture: CapturedStream,
+}
+
+/// Parsed [`BoxliteCaptureOptions`] for one stream.
+#[derive(Clone, Debug, Default, PartialEq, Eq)]
+pub(super) struct StreamCapture {
+    pub(super) max_bytes: usize,
+    pub(super) tail_bytes: usize,
+    pub(super) spill_path: Option<PathBuf>,
+}
+
+pub(super) unsafe fn parse_capture_options(
+    options: *const BoxliteCaptureOptions,
+) -> Result<(StreamCapture, StreamCapture), BoxliteError> {
+    let Some(options) = (unsafe { options.as_ref() }) else {
+        return Ok(Default::default());
+    };
+    let spill_path = |path: *const c_char| -> Result<Option<PathBuf>, BoxliteError> {
+        if path.is_null() {
+            return Ok(None);
+        }
+        Ok(Some(unsafe { c_str_to_string(path) }?.into()))
+    };
+    let stream = |path| -> Result<StreamCapture, BoxliteError> {
+        Ok(StreamCapture {
+            max_bytes: options.max_bytes,
+            tail_bytes: options.tail_bytes.min(options.max_bytes),
+            spill_path: spill_path(path)?,
+        })
+    };
+    Ok((stream(options.stdout_path)?, stream(options.stderr_path)?))
+}
+
+/// Head/tail retention for one stream. Never holds more than
+/// `head_cap + tail_cap` bytes, whatever is pushed.
+pub(super) struct BoundedCapture {
+    head: Vec<u8>,
+    head_cap: usize,
+    tail: VecDeque<u8>,
+    tail_cap: usize,
+    total: u64,
+}
+
+impl BoundedCapture {
+    pub(super) fn new(max_bytes: usize, tail_bytes: usize) -> Self {
+        if max_bytes == 0 {
+            return Self::with_caps(usize::MAX, 0);
+        }
+        let tail_bytes = tail_bytes.min(max_bytes);
+        Self::with_caps(max_bytes - tail_bytes, tail_bytes)
+    }
+
+    fn with_caps(head_cap: usize, tail_cap: usize) -> Self {
+        Self {
+            head: Vec::new(),
+            head_cap,
+            tail: VecDeque::new(),
+            tail_cap,
+            total: 0,
+        }
+    }
+
+    pub(super) fn push(&mut self, chunk: &[u8]) {
+        self.total += chunk.len() as u64;
+        let to_head = chunk.len().min(self.head_cap - self.head.len());
+        self.head.extend_from_slice(&chunk[..to_head]);
+        let rest = &chunk[to_head..];
+        if rest.len() >= self.tail_cap {
+            self.tail.clear();
+            self.tail.extend(&rest[rest.len() - self.tail_cap..]);
+        } else {
+            let overflow = (self.tail.len() + rest.len()).saturating_sub(self.tail_cap);
+            self.tail.drain(..overflow);
+            self.tail.extend(rest);
+        }
+    }
+
+    /// Move the retained bytes into a C-owned [`CapturedStream`].
+    pub(super) fn into_c(self) -> CapturedStream {
+        let head_len = self.head.len();
+        let mut data = self.head;
+        data.extend(self.tail);
+        let len = data.len();
+        CapturedStream {
+            data: if len == 0 {
+                ptr::null_mut()
+            } else {
+                Box::into_raw(data.into_boxed_slice()) as *mut u8
+            },
+            len,
+            head_len,
+            total_len: self.total,
+            truncated: c_int::from(self.total > len as u64),
+        }
+    }
+}
+
+/// Drain `stream` into a [`BoundedCapture`], spilling every chunk to the
+/// configured file first. Chunks are dropped as soon as they are recorded.
+pub(super) async fn capture_stream<S>(
+    stream: Option<S>,
+    config: StreamCapture,
+) -> Result<BoundedCapture, BoxliteError>
+where
+    S: Stream<Item = Bytes> + Unpin,
+{
+    let mut capture = BoundedCapture::new(config.max_bytes, config.tail_bytes);
+    let spill_error = |path: &PathBuf, e: std::io::Error| {
+        BoxliteError::Storage(format!("spill to {}: {}", path.display(), e))
+    };
+    let mut spill = match &config.spill_path {
+        Some(path) => Some(
+            tokio::fs::File::create(path)
+                .await
+                .map_err(|e| spill_error(path, e))?,
+        ),
+        None => None,
+    };
+    if let Some(mut stream) = stream {
+        while let Some(chunk) = stream.next().await {
+            if let (Some(file), Some(path)) = (&mut spill, &config.spill_path) {
+                file.write_all(&chunk)
+                    .await
+                    .map_err(|e| spill_error(path, e))?;
+            }
+            capture.push(&chunk);
+        }
+    }
+    if let (Some(file), Some(path)) = (&mut spill, &config.spill_path) {
+        file.flush().await.map_err(|e| spill_error(path, e))?;
+    }
+    Ok(capture)
+}
+
+unsafe fn captured_stream_free(stream: &mut CapturedStream) {
+    if !stream.data.is_null() {
+        unsafe {
+            drop(Box::from_raw(ptr::slice_from_raw_parts_mut(
+                stream.data,
+                stream.len,
+            )));
+        }
+        stream.data = ptr::null_mut();
+    }
+}
+
+pub(super) unsafe fn capture_result_free(result: *mut CaptureResult) {
+    if !result.is_null() {
+        unsafe {
+            let mut result = Box::from_raw(result);
+            captured_stream_free(&mut result.stdout_capture);
+            captured_stream_free(&mut result.stderr_capture);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn retained(capture: BoundedCapture) -> (Vec<u8>, usize, u64, bool) {
+        let mut c = capture.into_c();
+        let data = if c.data.is_null() {
+            Vec::new()
+        } else {
+            unsafe { std::slice::from_raw_parts(c.data, c.len) }.to_vec()
+        };
+        let out = (data, c.head_len, c.total_len, c.truncated != 0);
+        unsafe { captured_stream_free(&mut c) };
+        out
+    }
+
+    #[test]
+    fn unlimited_capture_keeps_raw_bytes_verbatim() {
+        let mut capture = BoundedCapture::new(0, 0);
+        capture.push(b"line one\n");
+        capture.push(b"bin\0ary\n");
+        assert_eq!(
+            retained(capture),
+            (b"line one\nbin\0ary\n".to_vec(), 17, 17, false)
+        );
+    }
+
+    #[test]
+    fn capped_capture_keeps_head_and_tail_across_chunks() {
+        let mut capture = BoundedCapture::new(6, 2);
+        for chunk in [&b"ab"[..], b"cdef", b"ghij", b"k"] {
+            capture.push(chunk);
+        }
+        // head = first 4, tail = last 2, "efghi" dropped.
+        assert_eq!(retained(capture), (b"abcdjk".to_vec(), 4, 11, true));
+    }
+
+    #[test]
+    fn head_only_and_tail_only_caps() {
+        let mut head = BoundedCapture::new(3, 0);
+        head.push(b"abcdef");
+        assert_eq!(retained(head), (b"abc".to_vec(), 3, 6, true));
+
+        let mut tail = BoundedCapture::new(3, 10);
+        tail.push(b"abcd");
+        tail.push(b"ef");
+        assert_eq!(retained(tail), (b"def".to_vec(), 0, 6, true));
+    }
+
+    #[test]
+    fn output_within_cap_is_not_truncated() {
+        let mut capture = BoundedCapture::new(8, 4);
+        capture.push(b"abc");
+        capture.push(b"de");
+        assert_eq!(retained(capture), (b"abcde".to_vec(), 4, 5, false));
+    }
+
+    #[test]
+    fn spill_file_receives_full_stream_despite_cap() {
+        let path =
+            std::env::temp_dir().join(format!("boxlite-c-capture-spill-{}", std::process::id()));
+        let rt = crate::executor::ExecutorConfig::default()
+            .runtime()
+            .expect("runtime");
+        let chunks = futures::stream::iter(vec![
+            Bytes::from_static(b"hello "),
+            Bytes::from_static(b"big "),
+            Bytes::from_static(b"world"),
+        ]);
+        let capture = rt
+            .block_on(capture_stream(
+                Some(chunks),
+                StreamCapture {
+                    max_bytes: 4,
+                    tail_bytes: 0,
+                    spill_path: Some(path.clone()),
+                },
+            ))
+            .expect("capture");
+        assert_eq!(retained(capture), (b"hell".to_vec(), 4, 15, true));
+        assert_eq!(std::fs::read(&path).expect("spill"), b"hello big world");
+        let _ = std::fs::remove_file(path);
+    }
+}
@@ -1,4 +1,5 @@
 use std::os::raw::{c_char, c_int};
+use std::time::Duration;
 
 use boxlite::BoxliteError;
 
@@ -30,6 +31,63 @@ pub struct BoxliteCommand {
     pub tty: c_int,
 }
 
+/// Per-execution stdout/stderr pacing for `boxlite_box_exec_paced`.
+///
+/// Kept out of [`BoxliteCommand`] so that struct keeps the layout callers
+/// built against older headers allocate. All fields default to 0 =
+/// "deliver every chunk as received, no per-execution limit", so a
+/// zero-initialized struct (or a NULL pointer) keeps the historical behavior.
+#[repr(C)]
+pub struct BoxliteOutputPacing {
+    /// Merge consecutive stdout (or stderr) chunks into one callback until
+    /// at least this many bytes are collected. 0 = no coalescing.
+    pub coalesce_bytes: c_int,
+    /// How long a partially filled coalesced chunk may wait for more
+    /// output, in milliseconds. 0 = merge only output that is already
+    /// buffered, never wait. Ignored when `coalesce_bytes` is 0.
+    pub coalesce_ms: c_int,
+    /// Maximum stdout/stderr callbacks of this execution that may be queued
+    /// but not yet drained. When exhausted the execution's output pumps
+    /// stop reading until the drain catches up, instead of flooding the
+    /// shared runtime queue. The stall reaches the guest: past 256 KiB of
+    /// unread output per stream the host stops reading the process and
+    /// the process blocks on its pipe. 0 = unlimited.
+    pub output_credits: c_int,
+}
+
+/// One buffer of a vectored stdin write (`boxlite_execution_stdin_writev`).
+/// Same shape as POSIX `struct iovec`, without pulling in `<sys/uio.h>`.
+#[repr(C)]
+pub struct BoxliteIoSlice {
+    /// Start of the buffer; may be NULL only when `len` is 0.
+    pub data: *const u8,
+    pub len: usize,
+}
+
+/// Per-execution stdout/stderr pacing parsed from [`BoxliteOutputPacing`].
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub(super) struct OutputPacing {
+    pub(super) coalesce_bytes: usize,
+    pub(super) coalesce_window: Duration,
+    pub(super) credits: Option<usize>,
+}
+
+/// Host-side output buffered per stream, unread, before an execution with
+/// `output_credits` stops reading from the guest.
+const CREDITED_OUTPUT_WINDOW: usize = 256 * 1024;
+
+/// Carry credit-based pacing through to the transport: a drain that falls
+/// behind eventually pauses the process instead of buffering on the host.
+pub(super) fn apply_output_window(
+    command: boxlite::BoxCommand,
+    pacing: &OutputPacing,
+) -> boxlite::BoxCommand {
+    match pacing.credits {
+        Some(_) => command.output_window(CREDITED_OUTPUT_WINDOW),
+        None => command,
+    }
+}
+
 pub(super) unsafe fn parse_boxlite_command(
     cmd: &BoxliteCommand,
 ) -> Result<boxlite::BoxCommand, BoxliteError> {
@@ -64,3 +122,23 @@ pub(super) unsafe fn parse_boxlite_command(
         Ok(box_cmd)
     }
 }
+
+pub(super) unsafe fn parse_output_pacing(
+    pacing: *const BoxliteOutputPacing,
+) -> Result<OutputPacing, BoxliteError> {
+    let Some(pacing) = (unsafe { pacing.as_ref() }) else {
+        return Ok(OutputPacing::default());
+    };
+    let non_negative = |value: c_int, field: &str| {
+        usize::try_from(value)
+            .map_err(|_| BoxliteError::InvalidArgument(format!("{field} must not be negative")))
+    };
+    let coalesce_bytes = non_negative(pacing.coalesce_bytes, "coalesce_bytes")?;
+    let coalesce_ms = non_negative(pacing.coalesce_ms, "coalesce_ms")?;
+    let credits = non_negative(pacing.output_credits, "output_credits")?;
+    Ok(OutputPacing {
+        coalesce_bytes,
+        coalesce_window: Duration::from_millis(coalesce_ms as u64),
+        credits: (credits > 0).then_some(credits),
+    })
+}
@@ -10,14 +10,16 @@
 //! Stdin writes are synchronous: they are routed through the in-process
 //! channel inside `ExecStdin::write` and never block on a Tokio worker.
 
-use futures::StreamExt;
+use bytes::{Bytes, BytesMut};
+use futures::{FutureExt, StreamExt};
 use std::os::raw::{c_int, c_void};
 use std::ptr;
 use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, Mutex};
+use std::time::Duration;
 
 use tokio::runtime::Runtime as TokioRuntime;
-use tokio::sync::oneshot;
+use tokio::sync::{OwnedSemaphorePermit, Semaphore, oneshot};
 use tokio::task::JoinHandle;
 
 /// Synthetic exit code emitted when `boxlite_execution_free` tears down a
@@ -33,13 +35,16 @@ pub(crate) const EXIT_CODE_FORCE_CLOSED: i32 = -129;
 
 use boxlite::{BoxliteError, ExecStderr, ExecStdin, ExecStdout, Execution};
 
-use super::command::{BoxliteCommand, parse_boxlite_command};
+use super::command::{
+    BoxliteCommand, BoxliteIoSlice, BoxliteOutputPacing, OutputPacing, apply_output_window,
+    parse_boxlite_command, parse_output_pacing,
+};
 use crate::box_handle::BoxHandle;
 use crate::error::{BoxliteErrorCode, FFIError, error_to_code, null_pointer_error, write_error};
 use crate::event_queue::{
     CBoxExitCb, CBoxExitFn, CBoxStderrCb, CBoxStderrFn, CBoxStdoutCb, CBoxStdoutFn,
     CExecutionKillCb, CExecutionResizeCb, CExecutionSignalCb, CExecutionWaitCb, EventQueue,
-    RuntimeEvent, push_event,
+    RuntimeEvent, push_event, push_flow_event,
 };
 use crate::{CBoxHandle, CBoxliteError, CExecutionHandle};
 
@@ -52,6 +57,8 @@ pub struct ExecutionHandle {
     /// Streams pending pump-task spawn. Each is moved out on first cb register.
     pending_stdout: Option<ExecStdout>,
     pending_stderr: Option<ExecStderr>,
+    /// Coalescing and credit state shared by both stream pumps.
+    output_gate: OutputGate,
     /// Spawned **stream** pumps (stdout/stderr); aborted on `_free`.
     /// The exit pump is tracked separately in `exit_pump_handle` so that
     /// `_free` can wait for an in-flight Exit push to complete instead of
@@ -101,7 +108,20 @@ pub unsafe extern "C" fn boxlite_box_exec(
     out_execution: *mut *mut CExecutionHandle,
     out_error: *mut CBoxliteError,
 ) -> BoxliteErrorCode {
-    box_exec(handle, cmd, out_execution, out_error)
+    box_exec(handle, cmd, ptr::null(), out_execution, out_error)
+}
+
+/// Like `boxlite_box_exec`, with stdout/stderr coalescing and credit
+/// limits from `pacing`. NULL `pacing` behaves like `boxlite_box_exec`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_box_exec_paced(
+    handle: *mut CBoxHandle,
+    cmd: *const BoxliteCommand,
+    pacing: *const BoxliteOutputPacing,
+    out_execution: *mut *mut CExecutionHandle,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    box_exec(handle, cmd, pacing, out_execution, out_error)
 }
 
 #[unsafe(no_mangle)]
@@ -144,6 +164,23 @@ pub unsafe extern "C" fn boxlite_execution_stdin_write(
     write_stdin(execution, data, len, out_error)
 }
 
+/// Write several buffers to stdin as one chunk.
+///
+/// The buffers are gathered into a single allocation and queued as one
+/// message, so a header and payload written together cost one copy and one
+/// frame to the guest instead of one per `boxlite_execution_stdin_write`.
+/// Like the single-buffer write it never blocks, and the caller's buffers
+/// may be reused as soon as it returns.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_execution_stdin_writev(
+    execution: *mut CExecutionHandle,
+    iov: *const BoxliteIoSlice,
+    iovcnt: usize,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    write_stdin_vectored(execution, iov, iovcnt, out_error)
+}
+
 /// Close the execution's stdin stream, signaling EOF to the guest process.
 ///
 /// Synchronous and idempotent: dropping the stdin sender closes the underlying
@@ -214,6 +251,7 @@ pub unsafe extern "C" fn boxlite_execution_free(execution: *mut CExecutionHandle
 unsafe fn box_exec(
     handle: *mut BoxHandle,
     cmd: *const BoxliteCommand,
+    pacing: *const BoxliteOutputPacing,
     out_execution: *mut *mut ExecutionHandle,
     out_error: *mut FFIError,
 ) -> BoxliteErrorCode {
@@ -233,8 +271,12 @@ unsafe fn box_exec(
         *out_execution = ptr::null_mut();
 
         let handle_ref = &*handle;
-        let command = match parse_boxlite_command(&*cmd) {
-            Ok(command) => command,
+        let parsed = parse_boxlite_command(&*cmd).and_then(|command| {
+            let pacing = parse_output_pacing(pacing)?;
+            Ok((apply_output_window(command, &pacing), pacing))
+        });
+        let (command, pacing) = match parsed {
+            Ok(parsed) => parsed,
             Err(e) => {
                 let code = error_to_code(&e);
                 write_error(out_error, e);
@@ -258,6 +300,7 @@ unsafe fn box_exec(
                     stdin,
                     pending_stdout: stdout,
                     pending_stderr: stderr,
+                    output_gate: OutputGate::new(pacing),
                     pumps: Mutex::new(Vec::new()),
                     exit_pump_handle: Mutex::new(None),
                     stream_done_rx: Mutex::new(Vec::new()),
@@ -303,12 +346,20 @@ unsafe fn register_stdout(
         };
 
         let queue = exec_ref.queue.clone();
+        let gate = exec_ref.output_gate.clone();
+        let flow = stream_flow(&exec_ref.execution);
         let user_data_addr = user_data as usize;
         let (done_tx, done_rx) = oneshot::channel::<()>();
         exec_ref.stream_done_rx.lock().unwrap().push(done_rx);
-        let pump = exec_ref
-            .tokio_rt
-            .spawn(stdout_pump(stream, cb, user_data_addr, queue, done_tx));
+        let pump = exec_ref.tokio_rt.spawn(stdout_pump(
+            stream.into_bytes(),
+            cb,
+            user_data_addr,
+            queue,
+            flow,
+            gate,
+            done_tx,
+        ));
         exec_ref.pumps.lock().unwrap().push(pump);
         BoxliteErrorCode::Ok
     }
@@ -338,12 +389,20 @@ unsafe fn register_stderr(
         };
 
         let queue = exec_ref.queue.clone();
+        let gate = exec_ref.output_gate.clone();
+        let flow = stream_flow(&exec_ref.execution);
         let user_data_addr = user_data as usize;
         let (done_tx, done_rx) = oneshot::channel::<()>();
         exec_ref.stream_done_rx.lock().unwrap().push(done_rx);
-        let pump = exec_ref
-            .tokio_rt
-            .spawn(stderr_pump(stream, cb, user_data_addr, queue, done_tx));
+        let pump = exec_ref.tokio_rt.spawn(stderr_pump(
+            stream.into_bytes(),
+            cb,
+            user_data_addr,
+            queue,
+            flow,
+            gate,
+            done_tx,
+        ));
         exec_ref.pumps.lock().unwrap().push(pump);
         BoxliteErrorCode::Ok
     }
@@ -459,6 +518,60 @@ unsafe fn write_stdin(
     }
 }
 
+unsafe fn write_stdin_vectored(
+    execution: *mut ExecutionHandle,
+    iov: *const BoxliteIoSlice,
+    iovcnt: usize,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if execution.is_null() {
+            write_error(out_error, null_pointer_error("execution"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        if iov.is_null() && iovcnt > 0 {
+            write_error(out_error, null_pointer_error("iov"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let slices = if iovcnt == 0 {
+            &[][..]
+        } else {
+            std::slice::from_raw_parts(iov, iovcnt)
+        };
+        if slices.iter().any(|s| s.data.is_null() && s.len > 0) {
+            write_error(out_error, null_pointer_error("iov[].data"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let bufs: Vec<std::io::IoSlice<'_>> = slices
+            .iter()
+            .filter(|s| s.len > 0)
+            .map(|s| std::io::IoSlice::new(std::slice::from_raw_parts(s.data, s.len)))
+            .collect();
+        if bufs.is_empty() {
+            return BoxliteErrorCode::Ok;
+        }
+
+        let exec_ref = &mut *execution;
+        let Some(stdin) = exec_ref.stdin.as_mut() else {
+            write_error(
+                out_error,
+                BoxliteError::InvalidState("execution stdin is closed".to_string()),
+            );
+            return BoxliteErrorCode::InvalidState;
+        };
+
+        // Non-blocking for the same reason as `write_stdin`.
+        match exec_ref.tokio_rt.block_on(stdin.write_vectored(&bufs)) {
+            Ok(()) => BoxliteErrorCode::Ok,
+            Err(e) => {
+                let code = error_to_code(&e);
+                write_error(out_error, e);
+                code
+            }
+        }
+    }
+}
+
 unsafe fn execution_wait(
     execution: *mut ExecutionHandle,
     cb: CExecutionWaitCb,
@@ -687,9 +800,11 @@ unsafe fn execution_free(execution: *mut ExecutionHandle) {
         if we_claimed_dispatch {
             if let Some((cb, ud)) = exec_box.exit_dispatch.lock().unwrap().take() {
                 let queue = exec_box.queue.clone();
+                let flow = stream_flow(&exec_box.execution);
                 exec_box.tokio_rt.block_on(async move {
-                    push_event(
+                    push_flow_event(
                         &queue,
+                        flow,
                         RuntimeEvent::Exit {
                             cb,
                             user_data: ud,
@@ -718,26 +833,115 @@ unsafe fn execution_free(execution: *mut ExecutionHandle) {
 }
 
 // ─── Pump tasks ────────────────────────────────────────────────────────────
+//
+// The stream pumps read the byte view of stdout/stderr: chunks reach the C
+// callback exactly as the guest wrote them, with no UTF-8 validation and no
+// copy — the event holds the backend's refcounted buffer until dispatch.
+//
+// `OutputGate` paces a chatty execution. With credits, a pump takes one
+// before queueing each event and stops reading its stream while none are
+// left, so output backs up in the execution's own channel rather than in
+// the shared runtime queue. With coalescing, whatever accumulated while the
+// pump was waiting goes out as one event.
+
+/// Per-execution output pacing, cloned into the stdout and stderr pumps.
+#[derive(Clone, Default)]
+struct OutputGate {
+    coalesce_bytes: usize,
+    coalesce_window: Duration,
+    /// Shared by both pumps, so `output_credits` bounds the execution as a
+    /// whole. `None` = unlimited.
+    credits: Option<Arc<Semaphore>>,
+}
+
+impl OutputGate {
+    fn new(pacing: OutputPacing) -> Self {
+        Self {
+            coalesce_bytes: pacing.coalesce_bytes,
+            coalesce_window: pacing.coalesce_window,
+            credits: pacing.credits.map(|n| Arc::new(Semaphore::new(n))),
+        }
+    }
+
+    /// Wait for a free output credit. The permit travels inside the queued
+    /// event and is returned when the drain drops that event.
+    async fn acquire(&self) -> Option<OwnedSemaphorePermit> {
+        let credits = self.credits.clone()?;
+        // The semaphore is never closed; should that change, pass the event
+        // through uncredited rather than lose it.
+        credits.acquire_owned().await.ok()
+    }
+
+    /// Extend `first` with the chunks that follow it until `coalesce_bytes`
+    /// is reached, nothing more arrives within `coalesce_window`, or the
+    /// stream ends. Returns the chunk to deliver and whether the stream
+    /// ended. A lone chunk is returned as-is, without copying.
+    async fn coalesce<S>(&self, first: Bytes, stream: &mut S) -> (Bytes, bool)
+    where
+        S: futures::Stream<Item = Bytes> + Unpin,
+    {
+        if first.len() >= self.coalesce_bytes {
+            return (first, false);
+        }
+        let deadline = tokio::time::Instant::now() + self.coalesce_window;
+        let mut len = first.len();
+        let mut parts = vec![first];
+        let mut ended = false;
+        while len < self.coalesce_bytes {
+            let next = match stream.next().now_or_never() {
+                Some(next) => next,
+                None if self.coalesce_window.is_zero() => break,
+                None => match tokio::time::timeout_at(deadline, stream.next()).await {
+                    Ok(next) => next,
+                    Err(_) => break,
+                },
+            };
+            let Some(chunk) = next else {
+                ended = true;
+                break;
+            };
+            len += chunk.len();
+            parts.push(chunk);
+        }
+        if parts.len() == 1 {
+            return (parts.pop().unwrap_or_default(), ended);
+        }
+        let mut merged = BytesMut::with_capacity(len);
+        for part in &parts {
+            merged.extend_from_slice(part);
+        }
+        (merged.freeze(), ended)
+    }
+}
 
 async fn stdout_pump<S>(
     mut stream: S,
     cb: CBoxStdoutFn,
     user_data_addr: usize,
     queue: Arc<EventQueue>,
+    flow: usize,
+    gate: OutputGate,
     done_tx: oneshot::Sender<()>,
 ) where
-    S: futures::Stream<Item = String> + Unpin,
+    S: futures::Stream<Item = Bytes> + Unpin,
 {
-    while let Some(chunk) = stream.next().await {
-        push_event(
+    while let Some(first) = stream.next().await {
+        let credit = gate.acquire().await;
+        let (data, ended) = gate.coalesce(first, &mut stream).await;
+        push_flow_event(
             &queue,
+            flow,
             RuntimeEvent::Stdout {
                 cb,
                 user_data: user_data_addr,
-                data: chunk.into_bytes(),
+                data,
+                credit,
             },
         )
         .await;
+        if ended {
+            break;
+        }
     }
     // Signal the exit pump we're done. Failure (rx dropped) means exit_pump
     // already completed or was never registered — either way harmless.
@@ -749,20 +953,29 @@ async fn stderr_pump<S>(
     cb: CBoxStderrFn,
     user_data_addr: usize,
     queue: Arc<EventQueue>,
+    flow: usize,
+    gate: OutputGate,
     done_tx: oneshot::Sender<()>,
 ) where
-    S: futures::Stream<Item = String> + Unpin,
+    S: futures::Stream<Item = Bytes> + Unpin,
 {
-    while let Some(chunk) = stream.next().await {
-        push_event(
+    while let Some(first) = stream.next().await {
+        let credit = gate.acquire().await;
+        let (data, ended) = gate.coalesce(first, &mut stream).await;
+        push_flow_event(
             &queue,
+            flow,
             RuntimeEvent::Stderr {
                 cb,
                 user_data: user_data_addr,
-                data: chunk.into_bytes(),
+                data,
+                credit,
             },
         )
         .await;
+        if ended {
+            break;
+        }
     }
     let _ = done_tx.send(());
 }
@@ -794,8 +1007,9 @@ async fn exit_pump(
     {
         return;
     }
-    push_event(
+    push_flow_event(
         &queue,
+        stream_flow(&exec_arc),
         RuntimeEvent::Exit {
             cb,
             user_data: user_data_addr,
@@ -807,6 +1021,12 @@ async fn exit_pump(
 
 // ─── Helpers ───────────────────────────────────────────────────────────────
 
+/// Event-queue flow key for an execution's output and `Exit`: the address
+/// of its shared `Execution` slot, stable for the handle's lifetime.
+fn stream_flow(execution: &Arc<Mutex<Option<Execution>>>) -> usize {
+    Arc::as_ptr(execution) as usize
+}
+
 /// Take a snapshot clone of the underlying Execution so multiple async ops
 /// can call `wait`/`kill`/`resize_tty` against the same backend without
 /// tripping borrow rules. `Execution` is internally `Arc<Mutex<...>>`, so
@@ -859,12 +1079,15 @@ mod tests {
     extern "C" fn noop_wait(_: c_int, _: *mut FFIError, _: *mut c_void) {}
 
     fn empty_handle() -> ExecutionHandle {
-        let runtime = crate::runtime::create_tokio_runtime().expect("runtime");
+        let runtime = crate::executor::ExecutorConfig::default()
+            .runtime()
+            .expect("runtime");
         ExecutionHandle {
             execution: Arc::new(Mutex::new(None)),
             stdin: None,
             pending_stdout: None,
             pending_stderr: None,
+            output_gate: OutputGate::default(),
             pumps: Mutex::new(Vec::new()),
             exit_pump_handle: Mutex::new(None),
             stream_done_rx: Mutex::new(Vec::new()),
@@ -931,6 +1154,44 @@ mod tests {
         unsafe { crate::boxlite_error_free(&mut error as *mut _) };
     }
 
+    #[test]
+    fn writev_stdin_rejects_null_buffer_with_length() {
+        let mut handle = empty_handle();
+        let mut error = FFIError::default();
+        let iov = [
+            BoxliteIoSlice {
+                data: b"hi".as_ptr(),
+                len: 2,
+            },
+            BoxliteIoSlice {
+                data: ptr::null(),
+                len: 3,
+            },
+        ];
+        let code = unsafe {
+            boxlite_execution_stdin_writev(&mut handle as *mut _, iov.as_ptr(), 2, &mut error)
+        };
+        assert_eq!(code, BoxliteErrorCode::InvalidArgument);
+        assert!(!error.message.is_null());
+        unsafe { crate::boxlite_error_free(&mut error as *mut _) };
+    }
+
+    #[test]
+    fn writev_stdin_rejects_closed_stdin() {
+        let mut handle = empty_handle();
+        let mut error = FFIError::default();
+        let iov = [BoxliteIoSlice {
+            data: b"hello".as_ptr(),
+            len: 5,
+        }];
+        let code = unsafe {
+            boxlite_execution_stdin_writev(&mut handle as *mut _, iov.as_ptr(), 1, &mut error)
+        };
+        assert_eq!(code, BoxliteErrorCode::InvalidState);
+        assert!(!error.message.is_null());
+        unsafe { crate::boxlite_error_free(&mut error as *mut _) };
+    }
+
     #[test]
     fn close_stdin_rejects_null_execution() {
         let mut error = FFIError::default();
@@ -1159,11 +1420,8 @@ mod tests {
         // simply needs to wait for the queue to receive the event.
         let deadline = std::time::Instant::now() + std::time::Duration::from_secs(2);
         loop {
-            {
-                let g = queue.inner.lock().unwrap();
-                if !g.is_empty() {
-                    break;
-                }
+            if !queue.is_empty() {
+                break;
             }
             if std::time::Instant::now() >= deadline {
                 break;
@@ -1173,10 +1431,7 @@ mod tests {
             });
         }
 
-        let events: Vec<RuntimeEvent> = {
-            let mut g = queue.inner.lock().unwrap();
-            g.drain(..).collect()
-        };
+        let events: Vec<RuntimeEvent> = std::iter::from_fn(|| queue.try_pop()).collect();
         let signal_count = events
             .iter()
             .filter(|e| matches!(e, RuntimeEvent::Signal { .. }))
@@ -1264,10 +1519,7 @@ mod tests {
 
         let _ = tokio::join!(t1, t2);
 
-        let events: Vec<RuntimeEvent> = {
-            let mut g = queue.inner.lock().unwrap();
-            g.drain(..).collect()
-        };
+        let events: Vec<RuntimeEvent> = std::iter::from_fn(|| queue.try_pop()).collect();
         let exit_count = events
             .iter()
             .filter(|e| {
@@ -1310,28 +1562,22 @@ mod tests {
     extern "C" fn noop_stderr_cb(_: *const u8, _: usize, _: *mut c_void) {}
 
     fn drain_stdout_bytes(queue: &Arc<EventQueue>) -> Vec<Vec<u8>> {
-        let events: Vec<RuntimeEvent> = {
-            let mut g = queue.inner.lock().unwrap();
-            g.drain(..).collect()
-        };
+        let events: Vec<RuntimeEvent> = std::iter::from_fn(|| queue.try_pop()).collect();
         events
             .into_iter()
             .filter_map(|e| match e {
-                RuntimeEvent::Stdout { data, .. } => Some(data),
+                RuntimeEvent::Stdout { data, .. } => Some(data.to_vec()),
                 _ => None,
             })
             .collect()
     }
 
     fn drain_stderr_bytes(queue: &Arc<EventQueue>) -> Vec<Vec<u8>> {
-        let events: Vec<RuntimeEvent> = {
-            let mut g = queue.inner.lock().unwrap();
-            g.drain(..).collect()
-        };
+        let events: Vec<RuntimeEvent> = std::iter::from_fn(|| queue.try_pop()).collect();
         events
             .into_iter()
             .filter_map(|e| match e {
-                RuntimeEvent::Stderr { data, .. } => Some(data),
+                RuntimeEvent::Stderr { data, .. } => Some(data.to_vec()),
                 _ => None,
             })
             .collect()
@@ -1342,14 +1588,23 @@ mod tests {
         let queue = Arc::new(EventQueue::new());
         let (done_tx, _done_rx) = oneshot::channel::<()>();
         let chunks = vec![
-            "hello".to_string(),                    // no trailing \n
-            "world".to_string(),                    // boundary chunk
-            "with\ninternal\nnewlines".to_string(), // already-newlined
-            "tab\there\x00null".to_string(),        // control bytes
+            Bytes::from_static(b"hello"),                    // no trailing \n
+            Bytes::from_static(b"world"),                    // boundary chunk
+            Bytes::from_static(b"with\ninternal\nnewlines"), // already-newlined
+            Bytes::from_static(b"tab\there\x00null"),        // control bytes
         ];
         let stream = stream_iter(chunks.into_iter());
 
-        stdout_pump(stream, noop_stdout_cb, 0xFEED_DEAD, queue.clone(), done_tx).await;
+        stdout_pump(
+            stream,
+            noop_stdout_cb,
+            0xFEED_DEAD,
+            queue.clone(),
+            0,
+            OutputGate::default(),
+            done_tx,
+        )
+        .await;
 
         let bytes = drain_stdout_bytes(&queue);
         assert_eq!(bytes.len(), 4, "expected 4 stdout events");
@@ -1372,10 +1627,19 @@ mod tests {
     async fn stderr_pump_forwards_chunks_byte_exact() {
         let queue = Arc::new(EventQueue::new());
         let (done_tx, _done_rx) = oneshot::channel::<()>();
-        let chunks = vec!["error".to_string(), "trace".to_string()];
+        let chunks = vec![Bytes::from_static(b"error"), Bytes::from_static(b"trace")];
         let stream = stream_iter(chunks.into_iter());
 
-        stderr_pump(stream, noop_stderr_cb, 0xCAFE_BABE, queue.clone(), done_tx).await;
+        stderr_pump(
+            stream,
+            noop_stderr_cb,
+            0xCAFE_BABE,
+            queue.clone(),
+            0,
+            OutputGate::default(),
+            done_tx,
+        )
+        .await;
 
         let bytes = drain_stderr_bytes(&queue);
         assert_eq!(bytes.len(), 2);
@@ -1388,6 +1652,127 @@ mod tests {
         assert_eq!(bytes[1], b"trace");
     }
 
+    /// Binary output (here: a gzip header plus bytes that are not valid
+    /// UTF-8) must reach the callback untouched, and the event must carry
+    /// the backend's buffer itself rather than a copy.
+    #[tokio::test]
+    async fn stdout_pump_forwards_binary_without_copy() {
+        let queue = Arc::new(EventQueue::new());
+        let (done_tx, _done_rx) = oneshot::channel::<()>();
+        let chunk = Bytes::from(vec![0x1F, 0x8B, 0x08, 0xFF, 0xFE, 0x00]);
+        let ptr = chunk.as_ptr();
+
+        stdout_pump(
+            stream_iter([chunk]),
+            noop_stdout_cb,
+            0,
+            queue.clone(),
+            0,
+            OutputGate::default(),
+            done_tx,
+        )
+        .await;
+
+        match queue.try_pop() {
+            Some(RuntimeEvent::Stdout { data, .. }) => {
+                assert_eq!(&data[..], &[0x1F, 0x8B, 0x08, 0xFF, 0xFE, 0x00]);
+                assert_eq!(
+                    data.as_ptr(),
+                    ptr,
+                    "chunk was copied on the way to the queue"
+                );
+            }
+            _ => panic!("expected one stdout event"),
+        }
+        assert!(queue.try_pop().is_none());
+    }
+
+    /// Chunks already buffered when the pump wakes are merged until the
+    /// event reaches `coalesce_bytes`; chunks are never split, so the event
+    /// that crosses the threshold may overshoot it.
+    #[tokio::test]
+    async fn stdout_pump_coalesces_buffered_chunks() {
+        let queue = Arc::new(EventQueue::new());
+        let (done_tx, _done_rx) = oneshot::channel::<()>();
+        let chunks = vec![
+            Bytes::from_static(b"a"),
+            Bytes::from_static(b"b"),
+            Bytes::from_static(b"c"),
+            Bytes::from_static(b"dddd"),
+            Bytes::from_static(b"e"),
+        ];
+        let gate = OutputGate::new(OutputPacing {
+            coalesce_bytes: 4,
+            ..OutputPacing::default()
+        });
+
+        stdout_pump(
+            stream_iter(chunks),
+            noop_stdout_cb,
+            0,
+            queue.clone(),
+            0,
+            gate,
+            done_tx,
+        )
+        .await;
+
+        let bytes = drain_stdout_bytes(&queue);
+        assert_eq!(bytes, vec![b"abcdddd".to_vec(), b"e".to_vec()]);
+    }
+
+    /// With `output_credits = 2` the pump queues two events and then stops
+    /// reading; dropping a queued event returns its credit and lets the
+    /// pump continue.
+    #[tokio::test]
+    async fn stdout_pump_stalls_when_credits_run_out() {
+        let queue = Arc::new(EventQueue::new());
+        let (done_tx, done_rx) = oneshot::channel::<()>();
+        let (tx, rx) = tokio::sync::mpsc::unbounded_channel::<Bytes>();
+        for chunk in [&b"1"[..], b"2", b"3"] {
+            tx.send(Bytes::copy_from_slice(chunk)).unwrap();
+        }
+        drop(tx);
+        let gate = OutputGate::new(OutputPacing {
+            credits: Some(2),
+            ..OutputPacing::default()
+        });
+
+        let pump = tokio::spawn(stdout_pump(
+            tokio_stream_from(rx),
+            noop_stdout_cb,
+            0,
+            queue.clone(),
+            0,
+            gate,
+            done_tx,
+        ));
+        for _ in 0..50 {
+            if queue.len() == 2 {
+                break;
+            }
+            tokio::time::sleep(Duration::from_millis(5)).await;
+        }
+        tokio::time::sleep(Duration::from_millis(20)).await;
+        assert_eq!(queue.len(), 2, "pump must stop at the credit limit");
+        assert!(!pump.is_finished());
+
+        drop(queue.try_pop());
+        done_rx
+            .await
+            .expect("pump finishes once a credit is returned");
+        assert_eq!(
+            drain_stdout_bytes(&queue),
+            vec![b"2".to_vec(), b"3".to_vec()]
+        );
+    }
+
+    fn tokio_stream_from(
+        mut rx: tokio::sync::mpsc::UnboundedReceiver<Bytes>,
+    ) -> impl futures::Stream<Item = Bytes> + Unpin {
+        futures::stream::poll_fn(move |cx| rx.poll_recv(cx))
+    }
+
     use std::sync::atomic::Ordering as ProcessCompletedOrdering;
 
     // ─── Errored wait must NOT mark process_completed ────────────────
@@ -1,9 +1,11 @@
 //! Command execution for the BoxLite C SDK.
 
+mod capture;
 mod command;
 mod execution;
 mod simple;
 
-pub use command::BoxliteCommand;
+pub use capture::{BoxliteCaptureOptions, CaptureResult, CapturedStream};
+pub use command::{BoxliteCommand, BoxliteOutputPacing};
 pub use execution::*;
 pub use simple::*;
@@ -5,23 +5,39 @@ use std::ptr;
 use std::sync::Arc;
 
 use tokio::runtime::Runtime as TokioRuntime;
+use tokio::sync::oneshot;
 
 use boxlite::litebox::LiteBox;
 use boxlite::runtime::BoxliteRuntime;
 use boxlite::runtime::options::{BoxOptions, BoxliteOptions};
 use boxlite::{BoxID, BoxliteError, RootfsSpec};
 
+use super::capture::{
+    BoundedCapture, BoxliteCaptureOptions, CaptureResult, StreamCapture, capture_result_free,
+    capture_stream, parse_capture_options,
+};
 use crate::error::{BoxliteErrorCode, FFIError, error_to_code, null_pointer_error, write_error};
-use crate::runtime::create_tokio_runtime;
-use crate::util::c_str_to_string;
-use crate::{CBoxliteError, CBoxliteExecResult, CBoxliteSimple};
+use crate::executor::{ExecutorOptionsHandle, executor_config};
+use crate::runtime::{RuntimeHandle, RuntimeLiveness};
+use crate::util::{c_str_to_string, ensure_runtime_live};
+use crate::{
+    CBoxliteCaptureResult, CBoxliteError, CBoxliteExecResult, CBoxliteExecutorOptions,
+    CBoxliteRuntime, CBoxliteSimple,
+};
 
 /// Opaque handle for Runner API (auto-manages runtime)
+///
+/// `runtime`, `tokio_rt` and `liveness` are either the runner's own
+/// (`boxlite_simple_new`) or clones of a caller's runtime handle
+/// (`boxlite_simple_new_in`); the runner only ever creates and removes its
+/// own box, so both cases free the same way.
 pub struct BoxRunner {
     pub runtime: BoxliteRuntime,
-    pub handle: Option<LiteBox>,
+    /// Shared with in-flight `boxlite_simple_run` tasks.
+    pub handle: Option<Arc<LiteBox>>,
     pub box_id: Option<BoxID>,
     pub tokio_rt: Arc<TokioRuntime>,
+    pub liveness: Arc<RuntimeLiveness>,
 }
 
 impl BoxRunner {
@@ -30,12 +46,14 @@ impl BoxRunner {
         handle: LiteBox,
         box_id: BoxID,
         tokio_rt: Arc<TokioRuntime>,
+        liveness: Arc<RuntimeLiveness>,
     ) -> Self {
         Self {
             runtime,
-            handle: Some(handle),
+            handle: Some(Arc::new(handle)),
             box_id: Some(box_id),
             tokio_rt,
+            liveness,
         }
     }
 }
@@ -56,9 +74,50 @@ pub unsafe extern "C" fn boxlite_simple_new(
     out_box: *mut *mut CBoxliteSimple,
     out_error: *mut CBoxliteError,
 ) -> BoxliteErrorCode {
-    runner_new(image, cpus, memory_mib, out_box, out_error)
+    runner_new(image, cpus, memory_mib, ptr::null(), out_box, out_error)
 }
 
+/// Like `boxlite_simple_new`, but runs the box's runtime on the executor
+/// described by `executor` (see `boxlite_executor_options_new`). NULL
+/// `executor` is the default. `executor` is only read during the call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_simple_new_with_executor(
+    image: *const c_char,
+    cpus: c_int,
+    memory_mib: c_int,
+    executor: *const CBoxliteExecutorOptions,
+    out_box: *mut *mut CBoxliteSimple,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    runner_new(image, cpus, memory_mib, executor, out_box, out_error)
+}
+
+/// Like `boxlite_simple_new`, but creates the box in an existing runtime
+/// instead of building a runtime and executor for the runner. Any number
+/// of runners can share one runtime; each still owns its box, which
+/// `boxlite_simple_free` stops and removes.
+///
+/// The runner keeps the runtime's executor alive, so it may outlive
+/// `runtime`; once `runtime` is shut down or freed, `boxlite_simple_run`
+/// fails with `Stopped`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_simple_new_in(
+    runtime: *mut CBoxliteRuntime,
+    image: *const c_char,
+    cpus: c_int,
+    memory_mib: c_int,
+    out_box: *mut *mut CBoxliteSimple,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    runner_new_in(runtime, image, cpus, memory_mib, out_box, out_error)
+}
+
+/// Run `command` to completion and return its buffered output.
+///
+/// Safe to call from several threads at once on the same runner: each
+/// call runs on the runner's executor and only parks the calling thread
+/// until its own command exits. Must not be called from inside a
+/// BoxLite callback, and must not race `boxlite_simple_free`.
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn boxlite_simple_run(
     box_runner: *mut CBoxliteSimple,
@@ -71,6 +130,33 @@ pub unsafe extern "C" fn boxlite_simple_run(
     runner_exec(box_runner, command, args, argc, out_result, out_error)
 }
 
+/// Like `boxlite_simple_run`, but captures raw stdout/stderr bytes within
+/// the limits in `options` instead of buffering all output as text.
+///
+/// Each stream keeps at most `options->max_bytes` in memory (head and
+/// tail, see `BoxliteCaptureOptions`), so memory stays bounded however
+/// much the command prints, and output keeps its original newlines and
+/// any NUL bytes. Streams with a spill path are also written to that file
+/// in full. NULL `options` keeps everything in memory.
+///
+/// Returns `Storage` if a spill file cannot be written. Free the result
+/// with `boxlite_capture_result_free`. Concurrency rules are those of
+/// `boxlite_simple_run`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_simple_run_captured(
+    box_runner: *mut CBoxliteSimple,
+    command: *const c_char,
+    args: *const *const c_char,
+    argc: c_int,
+    options: *const BoxliteCaptureOptions,
+    out_result: *mut *mut CBoxliteCaptureResult,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    runner_exec_captured(
+        box_runner, command, args, argc, options, out_result, out_error,
+    )
+}
+
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn boxlite_simple_free(box_runner: *mut CBoxliteSimple) {
     runner_free(box_runner)
@@ -81,10 +167,18 @@ pub unsafe extern "C" fn boxlite_result_free(result: *mut CBoxliteExecResult) {
     result_free(result)
 }
 
+/// Free a `boxlite_simple_run_captured` result and its buffers. No-op on
+/// NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_capture_result_free(result: *mut CBoxliteCaptureResult) {
+    capture_result_free(result)
+}
+
 unsafe fn runner_new(
     image: *const c_char,
     cpus: c_int,
     memory_mib: c_int,
+    executor: *const ExecutorOptionsHandle,
     out_runner: *mut *mut BoxRunner,
     out_error: *mut FFIError,
 ) -> BoxliteErrorCode {
@@ -98,27 +192,27 @@ unsafe fn runner_new(
             return BoxliteErrorCode::InvalidArgument;
         }
 
-        let image_str = match c_str_to_string(image) {
-            Ok(s) => s,
+        let options = match box_options(image, cpus, memory_mib) {
+            Ok(options) => options,
             Err(e) => {
                 write_error(out_error, e);
                 return BoxliteErrorCode::InvalidArgument;
             }
         };
 
-        let tokio_rt = match create_tokio_runtime() {
+        let tokio_rt = match executor_config(executor).runtime() {
             Ok(rt) => rt,
             Err(e) => {
-                let err = BoxliteError::Internal(format!("Failed to create async runtime: {}", e));
-                write_error(out_error, err);
-                return BoxliteErrorCode::Internal;
+                let code = error_to_code(&e);
+                write_error(out_error, e);
+                return code;
             }
         };
 
-        let options = BoxliteOptions::default();
+        let runtime_options = BoxliteOptions::default();
         // Executable-owned logging init (the library no longer auto-installs a subscriber).
-        let _ = boxlite::init_logging_for(&options.home_dir);
-        let runtime = match BoxliteRuntime::new(options) {
+        let _ = boxlite::init_logging_for(&runtime_options.home_dir);
+        let runtime = match BoxliteRuntime::new(runtime_options) {
             Ok(rt) => rt,
             Err(e) => {
                 write_error(out_error, e);
@@ -126,27 +220,147 @@ unsafe fn runner_new(
             }
         };
 
-        let options = BoxOptions {
-            rootfs: RootfsSpec::Image(image_str),
-            cpus: if cpus > 0 { Some(cpus as u8) } else { None },
-            memory_mib: if memory_mib > 0 {
-                Some(memory_mib as u32)
-            } else {
-                None
-            },
-            ..Default::default()
+        start_runner(
+            runtime,
+            tokio_rt,
+            Arc::new(RuntimeLiveness::new()),
+            options,
+            out_runner,
+            out_error,
+        )
+    }
+}
+
+unsafe fn runner_new_in(
+    runtime: *mut RuntimeHandle,
+    image: *const c_char,
+    cpus: c_int,
+    memory_mib: c_int,
+    out_runner: *mut *mut BoxRunner,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        if image.is_null() {
+            write_error(out_error, null_pointer_error("image"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        if out_runner.is_null() {
+            write_error(out_error, null_pointer_error("out_runner"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+
+        let runtime_ref = &*runtime;
+        if let Err(e) = ensure_runtime_live(&runtime_ref.liveness, "create simple box") {
+            let code = error_to_code(&e);
+            write_error(out_error, e);
+            return code;
+        }
+
+        let options = match box_options(image, cpus, memory_mib) {
+            Ok(options) => options,
+            Err(e) => {
+                write_error(out_error, e);
+                return BoxliteErrorCode::InvalidArgument;
+            }
         };
 
-        let result = tokio_rt.block_on(async {
-            let handle = runtime.create(options, None).await?;
-            let box_id = handle.id().clone();
-            Ok::<(LiteBox, BoxID), BoxliteError>((handle, box_id))
-        });
+        start_runner(
+            runtime_ref.runtime.clone(),
+            runtime_ref.tokio_rt.clone(),
+            runtime_ref.liveness.clone(),
+            options,
+            out_runner,
+            out_error,
+        )
+    }
+}
+
+unsafe fn box_options(
+    image: *const c_char,
+    cpus: c_int,
+    memory_mib: c_int,
+) -> Result<BoxOptions, BoxliteError> {
+    let image_str = unsafe { c_str_to_string(image) }?;
+    Ok(BoxOptions {
+        rootfs: RootfsSpec::Image(image_str),
+        cpus: if cpus > 0 { Some(cpus as u8) } else { None },
+        memory_mib: if memory_mib > 0 {
+            Some(memory_mib as u32)
+        } else {
+            None
+        },
+        ..Default::default()
+    })
+}
+
+/// Create the runner's box and hand out the runner.
+unsafe fn start_runner(
+    runtime: BoxliteRuntime,
+    tokio_rt: Arc<TokioRuntime>,
+    liveness: Arc<RuntimeLiveness>,
+    options: BoxOptions,
+    out_runner: *mut *mut BoxRunner,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    let result = tokio_rt.block_on(async {
+        let handle = runtime.create(options, None).await?;
+        let box_id = handle.id().clone();
+        Ok::<(LiteBox, BoxID), BoxliteError>((handle, box_id))
+    });
+
+    match result {
+        Ok((handle, box_id)) => {
+            let runner = Box::new(BoxRunner::new(runtime, handle, box_id, tokio_rt, liveness));
+            unsafe { *out_runner = Box::into_raw(runner) };
+            BoxliteErrorCode::Ok
+        }
+        Err(e) => {
+            let code = error_to_code(&e);
+            unsafe { write_error(out_error, e) };
+            code
+        }
+    }
+}
+
+unsafe fn runner_exec(
+    runner: *mut BoxRunner,
+    command: *const c_char,
+    args: *const *const c_char,
+    argc: c_int,
+    out_result: *mut *mut ExecResult,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if out_result.is_null() {
+            write_error(out_error, null_pointer_error("out_result"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let (runner_ref, handle, cmd) = match prepare_run(runner, command, args, argc, out_error) {
+            Ok(prepared) => prepared,
+            Err(code) => return code,
+        };
 
-        match result {
-            Ok((handle, box_id)) => {
-                let runner = Box::new(BoxRunner::new(runtime, handle, box_id, tokio_rt));
-                *out_runner = Box::into_raw(runner);
+        match run_on_executor(runner_ref, run_buffered(handle, cmd)) {
+            Ok((exit_code, stdout, stderr)) => {
+                let stdout_c = match CString::new(stdout) {
+                    Ok(s) => s.into_raw(),
+                    Err(_) => ptr::null_mut(),
+                };
+                let stderr_c = match CString::new(stderr) {
+                    Ok(s) => s.into_raw(),
+                    Err(_) => ptr::null_mut(),
+                };
+
+                let exec_result = Box::new(ExecResult {
+                    exit_code,
+                    stdout_text: stdout_c,
+                    stderr_text: stderr_c,
+                });
+                *out_result = Box::into_raw(exec_result);
                 BoxliteErrorCode::Ok
             }
             Err(e) => {
@@ -158,34 +372,82 @@ unsafe fn runner_new(
     }
 }
 
-unsafe fn runner_exec(
+unsafe fn runner_exec_captured(
     runner: *mut BoxRunner,
     command: *const c_char,
     args: *const *const c_char,
     argc: c_int,
-    out_result: *mut *mut ExecResult,
+    options: *const BoxliteCaptureOptions,
+    out_result: *mut *mut CaptureResult,
     out_error: *mut FFIError,
 ) -> BoxliteErrorCode {
+    unsafe {
+        if out_result.is_null() {
+            write_error(out_error, null_pointer_error("out_result"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let (stdout_capture, stderr_capture) = match parse_capture_options(options) {
+            Ok(captures) => captures,
+            Err(e) => {
+                write_error(out_error, e);
+                return BoxliteErrorCode::InvalidArgument;
+            }
+        };
+        let (runner_ref, handle, cmd) = match prepare_run(runner, command, args, argc, out_error) {
+            Ok(prepared) => prepared,
+            Err(code) => return code,
+        };
+
+        let run = run_captured(handle, cmd, stdout_capture, stderr_capture);
+        match run_on_executor(runner_ref, run) {
+            Ok((exit_code, stdout, stderr)) => {
+                *out_result = Box::into_raw(Box::new(CaptureResult {
+                    exit_code,
+                    stdout_capture: stdout.into_c(),
+                    stderr_capture: stderr.into_c(),
+                }));
+                BoxliteErrorCode::Ok
+            }
+            Err(e) => {
+                let code = error_to_code(&e);
+                write_error(out_error, e);
+                code
+            }
+        }
+    }
+}
+
+/// Validate a run request and build its command. On failure the error has
+/// already been written to `out_error`.
+unsafe fn prepare_run<'a>(
+    runner: *mut BoxRunner,
+    command: *const c_char,
+    args: *const *const c_char,
+    argc: c_int,
+    out_error: *mut FFIError,
+) -> Result<(&'a BoxRunner, Arc<LiteBox>, boxlite::BoxCommand), BoxliteErrorCode> {
     unsafe {
         if runner.is_null() {
             write_error(out_error, null_pointer_error("runner"));
-            return BoxliteErrorCode::InvalidArgument;
+            return Err(BoxliteErrorCode::InvalidArgument);
         }
         if command.is_null() {
             write_error(out_error, null_pointer_error("command"));
-            return BoxliteErrorCode::InvalidArgument;
-        }
-        if out_result.is_null() {
-            write_error(out_error, null_pointer_error("out_result"));
-            return BoxliteErrorCode::InvalidArgument;
+            return Err(BoxliteErrorCode::InvalidArgument);
         }
 
-        let runner_ref = &mut *runner;
+        // Shared, not `&mut`: concurrent runs on one runner are allowed.
+        let runner_ref = &*runner;
+        if let Err(e) = ensure_runtime_live(&runner_ref.liveness, "run command") {
+            let code = error_to_code(&e);
+            write_error(out_error, e);
+            return Err(code);
+        }
         let cmd_str = match c_str_to_string(command) {
             Ok(s) => s,
             Err(e) => {
                 write_error(out_error, e);
-                return BoxliteErrorCode::InvalidArgument;
+                return Err(BoxliteErrorCode::InvalidArgument);
             }
         };
 
@@ -200,92 +462,120 @@ unsafe fn runner_exec(
                     Ok(s) => arg_vec.push(s),
                     Err(e) => {
                         write_error(out_error, e);
-                        return BoxliteErrorCode::InvalidArgument;
+                        return Err(BoxliteErrorCode::InvalidArgument);
                     }
                 }
             }
         }
 
         let handle = match &runner_ref.handle {
-            Some(h) => h,
+            Some(h) => h.clone(),
             None => {
                 write_error(
                     out_error,
                     BoxliteError::InvalidState("Box not initialized".to_string()),
                 );
-                return BoxliteErrorCode::InvalidState;
+                return Err(BoxliteErrorCode::InvalidState);
             }
         };
 
-        let result = runner_ref.tokio_rt.block_on(async {
-            let mut cmd = boxlite::BoxCommand::new(cmd_str);
-            cmd = cmd.args(arg_vec);
-
-            let mut execution = handle.exec(cmd).await?;
+        Ok((
+            runner_ref,
+            handle,
+            boxlite::BoxCommand::new(cmd_str).args(arg_vec),
+        ))
+    }
+}
 
-            let mut stdout_lines = Vec::new();
-            let mut stderr_lines = Vec::new();
+/// Run `run` on the runner's executor workers rather than `block_on`
+/// here, so concurrent callers each just park on their own reply while
+/// the pool multiplexes the executions.
+fn run_on_executor<T, F>(runner: &BoxRunner, run: F) -> Result<T, BoxliteError>
+where
+    T: Send + 'static,
+    F: Future<Output = Result<T, BoxliteError>> + Send + 'static,
+{
+    let (reply_tx, reply_rx) = oneshot::channel();
+    runner.tokio_rt.spawn(async move {
+        let _ = reply_tx.send(run.await);
+    });
+    reply_rx.blocking_recv().unwrap_or_else(|_| {
+        Err(BoxliteError::Internal(
+            "simple run task ended without a result".to_string(),
+        ))
+    })
+}
 
-            let mut stdout_stream = execution.stdout();
-            let mut stderr_stream = execution.stderr();
+/// Run one command and keep its raw output within the capture limits.
+async fn run_captured(
+    handle: Arc<LiteBox>,
+    cmd: boxlite::BoxCommand,
+    stdout_capture: StreamCapture,
+    stderr_capture: StreamCapture,
+) -> Result<(i32, BoundedCapture, BoundedCapture), BoxliteError> {
+    let mut execution = handle.exec(cmd).await?;
+    let stdout = execution.stdout().map(|s| s.into_bytes());
+    let stderr = execution.stderr().map(|s| s.into_bytes());
+    let captured = futures::try_join!(
+        capture_stream(stdout, stdout_capture),
+        capture_stream(stderr, stderr_capture),
+    );
+    let (stdout, stderr) = match captured {
+        Ok(captured) => captured,
+        Err(e) => {
+            // Nobody reads the output any more; don't leave the process
+            // running unattended. Best-effort: the capture error wins.
+            let _ = execution.kill().await;
+            let _ = execution.wait().await;
+            return Err(e);
+        }
+    };
+    let status = execution.wait().await?;
+    Ok((status.exit_code, stdout, stderr))
+}
 
-            loop {
-                tokio::select! {
-                    Some(line) = async {
-                        match &mut stdout_stream {
-                            Some(s) => s.next().await,
-                            None => None,
-                        }
-                    } => {
-                        stdout_lines.push(line);
-                    }
-                    Some(line) = async {
-                        match &mut stderr_stream {
-                            Some(s) => s.next().await,
-                            None => None,
-                        }
-                    } => {
-                        stderr_lines.push(line);
-                    }
-                    else => break,
+/// Run one command and collect its output, as `boxlite_simple_run` returns it.
+async fn run_buffered(
+    handle: Arc<LiteBox>,
+    cmd: boxlite::BoxCommand,
+) -> Result<(i32, String, String), BoxliteError> {
+    let mut execution = handle.exec(cmd).await?;
+
+    let mut stdout_lines = Vec::new();
+    let mut stderr_lines = Vec::new();
+
+    let mut stdout_stream = execution.stdout();
+    let mut stderr_stream = execution.stderr();
+
+    loop {
+        tokio::select! {
+            Some(line) = async {
+                match &mut stdout_stream {
+                    Some(s) => s.next().await,
+                    None => None,
                 }
+            } => {
+                stdout_lines.push(line);
             }
-
-            let status = execution.wait().await?;
-
-            Ok::<(i32, String, String), BoxliteError>((
-                status.exit_code,
-                stdout_lines.join("\n"),
-                stderr_lines.join("\n"),
-            ))
-        });
-
-        match result {
-            Ok((exit_code, stdout, stderr)) => {
-                let stdout_c = match CString::new(stdout) {
-                    Ok(s) => s.into_raw(),
-                    Err(_) => ptr::null_mut(),
-                };
-                let stderr_c = match CString::new(stderr) {
-                    Ok(s) => s.into_raw(),
-                    Err(_) => ptr::null_mut(),
-                };
-
-                let exec_result = Box::new(ExecResult {
-                    exit_code,
-                    stdout_text: stdout_c,
-                    stderr_text: stderr_c,
-                });
-                *out_result = Box::into_raw(exec_result);
-                BoxliteErrorCode::Ok
-            }
-            Err(e) => {
-                let code = error_to_code(&e);
-                write_error(out_error, e);
-                code
+            Some(line) = async {
+                match &mut stderr_stream {
+                    Some(s) => s.next().await,
+                    None => None,
+                }
+            } => {
+                stderr_lines.push(line);
             }
+            else => break,
         }
     }
+
+    let status = execution.wait().await?;
+
+    Ok((
+        status.exit_code,
+        stdout_lines.join("\n"),
+        stderr_lines.join("\n"),
+    ))
 }
 
 unsafe fn result_free(result: *mut ExecResult) {
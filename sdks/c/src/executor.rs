@@ -0,0 +1,509 @@
+//! Tokio executor configuration for the BoxLite C FFI.
+//!
+//! Every runtime handle drives its async work on a Tokio runtime. By
+//! default each `boxlite_runtime_new`, `boxlite_rest_runtime_new_with_options`
+//! and `boxlite_simple_new` builds its own multi-thread runtime with one
+//! worker per CPU, so a process with many handles on a large host ends up
+//! with hundreds of mostly idle threads. An executor options handle sizes,
+//! names and pins that runtime, and can make handles share one:
+//!
+//! ```c
+//! CBoxliteExecutorOptions *exec = NULL;
+//! boxlite_executor_options_new(&exec, &err);
+//! boxlite_executor_options_set_worker_threads(exec, 4);
+//! boxlite_executor_options_set_numa_node(exec, 1);
+//! boxlite_executor_options_set_shared(exec, 1);
+//!
+//! CBoxliteRuntime *rt = NULL;
+//! boxlite_runtime_new_with_executor(NULL, NULL, 0, exec, &rt, &err);
+//!
+//! boxlite_executor_options_free(exec);
+//! // ... use rt ...
+//! boxlite_runtime_free(rt);
+//! ```
+//!
+//! The options are copied when a handle is created; freeing or changing
+//! them afterwards does not affect existing handles.
+
+use std::os::raw::{c_char, c_int};
+use std::sync::{Arc, Mutex, Weak};
+
+use boxlite::BoxliteError;
+use boxlite::runtime::placement::{allowed_cpus, numa_node_cpus};
+use tokio::runtime::{Builder as TokioBuilder, Runtime as TokioRuntime};
+
+use crate::error::{BoxliteErrorCode, null_pointer_error, write_error};
+use crate::util::c_str_to_string;
+use crate::{CBoxliteError, CBoxliteExecutorOptions};
+
+/// How to build the Tokio runtime behind a handle. `Default` is a
+/// multi-threaded runtime with one worker per CPU.
+#[derive(Clone, Debug, Default, PartialEq, Eq)]
+pub struct ExecutorConfig {
+    /// Worker threads. `None` = one per CPU, or one per pinned CPU.
+    pub worker_threads: Option<usize>,
+    /// Cap on the blocking pool (file I/O, `spawn_blocking`). `None` keeps
+    /// Tokio's default.
+    pub max_blocking_threads: Option<usize>,
+    /// Name given to every runtime thread.
+    pub thread_name: Option<String>,
+    /// CPUs every runtime thread is pinned to. Empty = no pinning.
+    pub cpus: Vec<usize>,
+    /// Pin to the CPUs of this NUMA node (intersected with `cpus`).
+    pub numa_node: Option<usize>,
+    /// Run all async work on a single worker thread.
+    pub single_thread: bool,
+    /// Reuse a live runtime built from an equal config instead of
+    /// building a new one.
+    pub shared: bool,
+}
+
+/// Opaque executor options handle. Owns an [`ExecutorConfig`] that the
+/// setters mutate in place before construction.
+pub struct ExecutorOptionsHandle {
+    pub(crate) config: ExecutorConfig,
+}
+
+/// Runtimes built from `shared` configs. Entries hold `Weak` references so
+/// a shared runtime shuts down with the last handle that uses it.
+static SHARED_EXECUTORS: Mutex<Vec<(ExecutorConfig, Weak<TokioRuntime>)>> = Mutex::new(Vec::new());
+
+impl ExecutorConfig {
+    /// The runtime this config describes: a fresh one, or with `shared`
+    /// the live runtime of an equal config if there is one.
+    pub fn runtime(&self) -> Result<Arc<TokioRuntime>, BoxliteError> {
+        if !self.shared {
+            return self.build().map(Arc::new);
+        }
+        // Held across `build` so two threads asking for the same config
+        // cannot both build one.
+        let mut shared = SHARED_EXECUTORS.lock().unwrap();
+        shared.retain(|(_, rt)| rt.strong_count() > 0);
+        let live = shared
+            .iter()
+            .find(|(config, _)| config == self)
+            .and_then(|(_, rt)| rt.upgrade());
+        if let Some(rt) = live {
+            return Ok(rt);
+        }
+        let rt = Arc::new(self.build()?);
+        shared.push((self.clone(), Arc::downgrade(&rt)));
+        Ok(rt)
+    }
+
+    fn build(&self) -> Result<TokioRuntime, BoxliteError> {
+        let cpus = self.pinned_cpus()?;
+        let mut builder = TokioBuilder::new_multi_thread();
+        builder.enable_all();
+
+        let workers = if self.single_thread {
+            Some(1)
+        } else {
+            self.worker_threads
+                .or((!cpus.is_empty()).then_some(cpus.len()))
+        };
+        if let Some(workers) = workers {
+            builder.worker_threads(workers);
+        }
+        if let Some(max) = self.max_blocking_threads {
+            builder.max_blocking_threads(max);
+        }
+        if let Some(name) = &self.thread_name {
+            builder.thread_name(name.clone());
+        }
+        if !cpus.is_empty() {
+            // Runs on workers and blocking-pool threads alike.
+            builder.on_thread_start(move || pin_current_thread(&cpus));
+        }
+
+        builder
+            .build()
+            .map_err(|e| BoxliteError::Internal(format!("Failed to create async runtime: {}", e)))
+    }
+
+    /// `cpus` narrowed to `numa_node`, checked against the CPUs this
+    /// process may run on so pinning cannot fail later on a worker.
+    fn pinned_cpus(&self) -> Result<Vec<usize>, BoxliteError> {
+        if cfg!(not(target_os = "linux")) && (!self.cpus.is_empty() || self.numa_node.is_some()) {
+            return Err(BoxliteError::Unsupported(
+                "CPU pinning is only supported on Linux".to_string(),
+            ));
+        }
+        let mut cpus = self.cpus.clone();
+        if let Some(node) = self.numa_node {
+            let node = u32::try_from(node).map_err(|_| {
+                BoxliteError::InvalidArgument(format!("NUMA node {} is out of range", node))
+            })?;
+            let node_cpus: Vec<usize> = numa_node_cpus(node)?
+                .into_iter()
+                .map(|cpu| cpu as usize)
+                .collect();
+            cpus = if cpus.is_empty() {
+                node_cpus
+            } else {
+                cpus.retain(|cpu| node_cpus.contains(cpu));
+                if cpus.is_empty() {
+                    return Err(BoxliteError::InvalidArgument(format!(
+                        "none of the requested CPUs are on NUMA node {}",
+                        node
+                    )));
+                }
+                cpus
+            };
+        }
+        if cpus.is_empty() {
+            return Ok(cpus);
+        }
+        let allowed = allowed_cpus();
+        let is_allowed = |cpu: usize| u32::try_from(cpu).is_ok_and(|cpu| allowed.contains(&cpu));
+        if let Some(cpu) = cpus.iter().find(|&&cpu| !is_allowed(cpu)) {
+            return Err(BoxliteError::InvalidArgument(format!(
+                "CPU {} is not available to this process",
+                cpu
+            )));
+        }
+        cpus.sort_unstable();
+        cpus.dedup();
+        Ok(cpus)
+    }
+}
+
+// ─── CPU placement ─────────────────────────────────────────────────────────
+
+#[cfg(target_os = "linux")]
+fn pin_current_thread(cpus: &[usize]) {
+    // SAFETY: `cpu_set_t` is plain data; every index was checked against
+    // the allowed set, which is bounded by CPU_SETSIZE.
+    unsafe {
+        let mut set: libc::cpu_set_t = std::mem::zeroed();
+        for &cpu in cpus {
+            libc::CPU_SET(cpu, &mut set);
+        }
+        // Cannot fail for CPUs from `allowed_cpus` unless the cpuset
+        // shrank since; the thread then keeps running unpinned.
+        libc::sched_setaffinity(0, std::mem::size_of::<libc::cpu_set_t>(), &set);
+    }
+}
+
+#[cfg(not(target_os = "linux"))]
+fn pin_current_thread(_cpus: &[usize]) {}
+
+// ─── FFI ───────────────────────────────────────────────────────────────────
+
+/// Create executor options with the defaults: a private multi-thread
+/// runtime with one worker per CPU, unpinned.
+///
+/// Returns `BoxliteErrorCode::Ok` on success. Free the handle with
+/// `boxlite_executor_options_free`.
+///
+/// # Safety
+/// `out_options` must be non-NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_new(
+    out_options: *mut *mut CBoxliteExecutorOptions,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if out_options.is_null() {
+            write_error(out_error, null_pointer_error("out_options"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        *out_options = Box::into_raw(Box::new(ExecutorOptionsHandle {
+            config: ExecutorConfig::default(),
+        }));
+        BoxliteErrorCode::Ok
+    }
+}
+
+/// Set the number of worker threads. `<= 0` restores the default (one
+/// per CPU, or one per pinned CPU when affinity is set). No-op on NULL.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_set_worker_threads(
+    options: *mut CBoxliteExecutorOptions,
+    threads: c_int,
+) {
+    unsafe {
+        if !options.is_null() {
+            (*options).config.worker_threads = (threads > 0).then_some(threads as usize);
+        }
+    }
+}
+
+/// Cap the blocking thread pool used for file I/O and other blocking
+/// work. `<= 0` restores Tokio's default. No-op on NULL.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_set_max_blocking_threads(
+    options: *mut CBoxliteExecutorOptions,
+    threads: c_int,
+) {
+    unsafe {
+        if !options.is_null() {
+            (*options).config.max_blocking_threads = (threads > 0).then_some(threads as usize);
+        }
+    }
+}
+
+/// Name the runtime's threads (as shown by `top -H`, debuggers and
+/// profilers). NULL restores Tokio's default name. No-op if `options` is
+/// NULL or `name` is not a valid C string.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL; `name` a valid C string or
+/// NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_set_thread_name(
+    options: *mut CBoxliteExecutorOptions,
+    name: *const c_char,
+) {
+    unsafe {
+        if options.is_null() {
+            return;
+        }
+        if name.is_null() {
+            (*options).config.thread_name = None;
+        } else if let Ok(name) = c_str_to_string(name) {
+            (*options).config.thread_name = Some(name);
+        }
+    }
+}
+
+/// Pin every runtime thread to the given CPUs. `count == 0` clears the
+/// pinning. Linux only: creating a handle with pinning set fails with
+/// `Unsupported` elsewhere, and with `InvalidArgument` if a CPU is not
+/// available to the process.
+///
+/// Returns `InvalidArgument` if `options` is NULL, `count` is negative,
+/// `cpus` is NULL with a positive `count`, or a CPU index is negative.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL; `cpus` must point to
+/// `count` ints.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_set_cpu_affinity(
+    options: *mut CBoxliteExecutorOptions,
+    cpus: *const c_int,
+    count: c_int,
+) -> BoxliteErrorCode {
+    unsafe {
+        if options.is_null() || count < 0 || (cpus.is_null() && count > 0) {
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let requested = if count == 0 {
+            &[][..]
+        } else {
+            std::slice::from_raw_parts(cpus, count as usize)
+        };
+        let Ok(parsed) = requested
+            .iter()
+            .map(|&cpu| usize::try_from(cpu))
+            .collect::<Result<Vec<_>, _>>()
+        else {
+            return BoxliteErrorCode::InvalidArgument;
+        };
+        (*options).config.cpus = parsed;
+        BoxliteErrorCode::Ok
+    }
+}
+
+/// Pin every runtime thread to the CPUs of NUMA node `node`, intersected
+/// with any CPUs set by `boxlite_executor_options_set_cpu_affinity`.
+/// `node < 0` clears it. Linux only, like CPU affinity. No-op on NULL.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_set_numa_node(
+    options: *mut CBoxliteExecutorOptions,
+    node: c_int,
+) {
+    unsafe {
+        if !options.is_null() {
+            (*options).config.numa_node = usize::try_from(node).ok();
+        }
+    }
+}
+
+/// Run all async work on a single worker thread (non-zero) instead of a
+/// pool. Overrides the worker count; the blocking pool is unaffected.
+/// No-op on NULL.
+///
+/// A dedicated worker, rather than a current-thread scheduler driven by
+/// the caller, keeps the post-and-drain contract: operations make
+/// progress while the caller is outside the library, and callbacks still
+/// only fire inside `boxlite_runtime_drain`.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_set_single_thread(
+    options: *mut CBoxliteExecutorOptions,
+    enabled: c_int,
+) {
+    unsafe {
+        if !options.is_null() {
+            (*options).config.single_thread = enabled != 0;
+        }
+    }
+}
+
+/// Share the executor (non-zero): handles created from options with the
+/// same settings run on one Tokio runtime, which stays up until the last
+/// of them is freed. Without it every handle builds its own. No-op on
+/// NULL.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_set_shared(
+    options: *mut CBoxliteExecutorOptions,
+    enabled: c_int,
+) {
+    unsafe {
+        if !options.is_null() {
+            (*options).config.shared = enabled != 0;
+        }
+    }
+}
+
+/// Free an executor options handle. No-op on NULL. Handles created from
+/// it are unaffected.
+///
+/// # Safety
+/// `options` must be a handle from `boxlite_executor_options_new` or
+/// NULL, and must not be used after this call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_executor_options_free(options: *mut CBoxliteExecutorOptions) {
+    if !options.is_null() {
+        unsafe {
+            drop(Box::from_raw(options));
+        }
+    }
+}
+
+/// Config behind a nullable options handle; NULL means the defaults.
+pub(crate) unsafe fn executor_config(options: *const ExecutorOptionsHandle) -> ExecutorConfig {
+    unsafe { options.as_ref() }
+        .map(|handle| handle.config.clone())
+        .unwrap_or_default()
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn worker_count_and_thread_name_are_applied() {
+        let config = ExecutorConfig {
+            worker_threads: Some(2),
+            thread_name: Some("bl-test-worker".to_string()),
+            ..ExecutorConfig::default()
+        };
+        let rt = config.runtime().expect("runtime");
+        assert_eq!(rt.metrics().num_workers(), 2);
+        let name = rt.block_on(async {
+            tokio::spawn(async { std::thread::current().name().map(str::to_owned) })
+                .await
+                .expect("task")
+        });
+        assert_eq!(name.as_deref(), Some("bl-test-worker"));
+    }
+
+    #[test]
+    fn single_thread_overrides_worker_count() {
+        let config = ExecutorConfig {
+            worker_threads: Some(8),
+            single_thread: true,
+            ..ExecutorConfig::default()
+        };
+        assert_eq!(
+            config.runtime().expect("runtime").metrics().num_workers(),
+            1
+        );
+    }
+
+    /// Equal shared configs get the same runtime while one is alive; once
+    /// every user is gone the next request builds a fresh one.
+    #[test]
+    fn shared_configs_reuse_one_runtime() {
+        let config = ExecutorConfig {
+            worker_threads: Some(1),
+            thread_name: Some("bl-shared-test".to_string()),
+            shared: true,
+            ..ExecutorConfig::default()
+        };
+        let a = config.runtime().expect("runtime");
+        let b = config.runtime().expect("runtime");
+        assert!(Arc::ptr_eq(&a, &b));
+
+        let private = ExecutorConfig {
+            shared: false,
+            ..config.clone()
+        };
+        assert!(!Arc::ptr_eq(&a, &private.runtime().expect("runtime")));
+
+        let weak = Arc::downgrade(&a);
+        drop((a, b));
+        assert!(weak.upgrade().is_none(), "registry must not keep it alive");
+    }
+
+    #[cfg(target_os = "linux")]
+    #[test]
+    fn pinned_threads_run_only_on_requested_cpus() {
+        let cpu = *allowed_cpus().first().expect("affinity");
+        let config = ExecutorConfig {
+            cpus: vec![cpu as usize],
+            ..ExecutorConfig::default()
+        };
+        let rt = config.runtime().expect("runtime");
+        assert_eq!(rt.metrics().num_workers(), 1, "one worker per pinned CPU");
+        let on_worker =
+            rt.block_on(async { tokio::spawn(async { allowed_cpus() }).await.expect("task") });
+        assert_eq!(on_worker.into_iter().collect::<Vec<_>>(), vec![cpu]);
+    }
+
+    #[cfg(target_os = "linux")]
+    #[test]
+    fn unavailable_cpu_is_rejected() {
+        let config = ExecutorConfig {
+            cpus: vec![libc::CPU_SETSIZE as usize + 1],
+            ..ExecutorConfig::default()
+        };
+        assert!(matches!(
+            config.runtime(),
+            Err(BoxliteError::InvalidArgument(_))
+        ));
+    }
+
+    #[test]
+    fn cpu_affinity_setter_validates_input() {
+        let mut handle = ExecutorOptionsHandle {
+            config: ExecutorConfig::default(),
+        };
+        let cpus = [0, 2];
+        let code =
+            unsafe { boxlite_executor_options_set_cpu_affinity(&mut handle, cpus.as_ptr(), 2) };
+        assert_eq!(code, BoxliteErrorCode::Ok);
+        assert_eq!(handle.config.cpus, vec![0, 2]);
+
+        let bad = [1, -1];
+        let code =
+            unsafe { boxlite_executor_options_set_cpu_affinity(&mut handle, bad.as_ptr(), 2) };
+        assert_eq!(code, BoxliteErrorCode::InvalidArgument);
+        assert_eq!(
+            handle.config.cpus,
+            vec![0, 2],
+            "rejected call leaves it unchanged"
+        );
+
+        let code =
+            unsafe { boxlite_executor_options_set_cpu_affinity(&mut handle, std::ptr::null(), 0) };
+        assert_eq!(code, BoxliteErrorCode::Ok);
+        assert!(handle.config.cpus.is_empty());
+    }
+}
@@ -2,6 +2,8 @@
 //!
 //! Async methods (`boxlite_image_pull`, `boxlite_image_list`) follow the
 //! post-and-drain pattern; results are dispatched on the user's drain thread.
+//! `boxlite_image_pull_with_progress` also posts progress snapshots ahead of
+//! its completion.
 
 use std::ffi::CString;
 use std::os::raw::{c_char, c_int, c_void};
@@ -13,7 +15,9 @@ use tokio::runtime::Runtime as TokioRuntime;
 use boxlite::ImageHandle as CoreImageHandle;
 
 use crate::error::{BoxliteErrorCode, FFIError, error_to_code, null_pointer_error, write_error};
-use crate::event_queue::{CBoxImageListCb, CBoxImagePullCb, EventQueue, RuntimeEvent, push_event};
+use crate::event_queue::{
+    CBoxImageListCb, CBoxImagePullCb, CBoxImagePullProgressCb, EventQueue, RuntimeEvent, push_event,
+};
 use crate::runtime::RuntimeLiveness;
 use crate::{CBoxliteError, CBoxliteImageHandle};
 
@@ -49,6 +53,37 @@ pub struct CImagePullResult {
     pub layer_count: c_int,
 }
 
+/// Snapshot of an image pull in flight, passed to the progress callback of
+/// `boxlite_image_pull_with_progress`. Byte counts are compressed blob
+/// bytes; rates are averages since the layer downloads started.
+#[repr(C)]
+#[derive(Clone, Copy, Debug, Default)]
+pub struct CImagePullProgress {
+    pub bytes_downloaded: u64,
+    /// Declared size of the layers being downloaded (cached layers excluded).
+    pub bytes_total: u64,
+    /// Layers downloaded and verified, including those already cached.
+    pub layers_completed: c_int,
+    pub layers_total: c_int,
+    pub elapsed_secs: f64,
+    pub bytes_per_second: f64,
+    pub layers_per_second: f64,
+}
+
+impl CImagePullProgress {
+    pub fn from_progress(progress: &boxlite::ImagePullProgress) -> Self {
+        Self {
+            bytes_downloaded: progress.bytes_downloaded,
+            bytes_total: progress.bytes_total,
+            layers_completed: progress.layers_completed as c_int,
+            layers_total: progress.layers_total as c_int,
+            elapsed_secs: progress.elapsed.as_secs_f64(),
+            bytes_per_second: progress.bytes_per_second(),
+            layers_per_second: progress.layers_per_second(),
+        }
+    }
+}
+
 fn to_c_str(s: &str) -> *mut c_char {
     CString::new(s)
         .map(|c| c.into_raw())
@@ -138,7 +173,36 @@ pub unsafe extern "C" fn boxlite_image_pull(
     user_data: *mut c_void,
     out_error: *mut CBoxliteError,
 ) -> BoxliteErrorCode {
-    image_pull(handle, image_ref, cb, user_data, out_error)
+    image_pull(handle, image_ref, 0, None, cb, user_data, out_error)
+}
+
+/// Pull an image like `boxlite_image_pull`, downloading up to
+/// `max_concurrent_layers` layers at once (0 = default) and posting
+/// progress snapshots to `progress_cb` (may be NULL) before `cb` fires.
+///
+/// Progress is best-effort: snapshots are throttled, and dropped while the
+/// event queue is half full. None are posted when the image is already
+/// cached.
+/// Both callbacks receive `user_data`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_image_pull_with_progress(
+    handle: *mut CBoxliteImageHandle,
+    image_ref: *const c_char,
+    max_concurrent_layers: usize,
+    progress_cb: CBoxImagePullProgressCb,
+    cb: CBoxImagePullCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    image_pull(
+        handle,
+        image_ref,
+        max_concurrent_layers,
+        progress_cb,
+        cb,
+        user_data,
+        out_error,
+    )
 }
 
 #[unsafe(no_mangle)]
@@ -222,6 +286,8 @@ unsafe fn image_list(
 unsafe fn image_pull(
     handle: *mut ImageHandle,
     image_ref: *const c_char,
+    max_concurrent_layers: usize,
+    progress_cb: CBoxImagePullProgressCb,
     cb: CBoxImagePullCb,
     user_data: *mut c_void,
     out_error: *mut FFIError,
@@ -252,17 +318,39 @@ unsafe fn image_pull(
         let queue = handle_ref.queue.clone();
         let user_data_addr = user_data as usize;
 
-        handle_ref.tokio_rt.spawn(async move {
-            let result = core_handle.pull(&image_ref).await.map(|image| {
-                crate::event_queue::OwnedFfiPtr::new_with(
-                    Box::new(CImagePullResult::new(
-                        image.reference(),
-                        image.config_digest(),
-                        image.layer_count(),
-                    )),
-                    free_image_pull_result,
-                )
+        let mut options = boxlite::ImagePullOptions::default();
+        if max_concurrent_layers > 0 {
+            options = options.with_max_concurrent_layers(max_concurrent_layers);
+        }
+        if let Some(progress_cb) = progress_cb {
+            let queue = queue.clone();
+            options = options.with_progress(move |progress| {
+                // Never wait here: this runs inside the layer downloads.
+                if !queue.has_best_effort_room() {
+                    return;
+                }
+                let _ = queue.try_push(RuntimeEvent::ImagePullProgress {
+                    cb: progress_cb,
+                    user_data: user_data_addr,
+                    progress: CImagePullProgress::from_progress(progress),
+                });
             });
+        }
+
+        handle_ref.tokio_rt.spawn(async move {
+            let result = core_handle
+                .pull_with(&image_ref, options)
+                .await
+                .map(|image| {
+                    crate::event_queue::OwnedFfiPtr::new_with(
+                        Box::new(CImagePullResult::new(
+                            image.reference(),
+                            image.config_digest(),
+                            image.layer_count(),
+                        )),
+                        free_image_pull_result,
+                    )
+                });
             push_event(
                 &queue,
                 RuntimeEvent::ImagePull {
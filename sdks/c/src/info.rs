@@ -1,20 +1,25 @@
 //! Box information types and operations for the BoxLite C SDK.
 //!
 //! `boxlite_box_info` is synchronous (reads cached fields on the handle).
-//! `boxlite_get_info` and `boxlite_list_info` are async + callback.
+//! `boxlite_get_info` and the `boxlite_list_info*` calls are async +
+//! callback. `boxlite_list_info_arena` returns the whole page in one string
+//! buffer so large listings cost a single free.
 
 use std::ffi::CString;
 use std::os::raw::{c_char, c_int, c_void};
 use std::ptr;
 
-use boxlite::BoxliteError;
 use boxlite::runtime::types::BoxStatus;
+use boxlite::{BoxInfoPage, BoxListFilter, BoxliteError};
 
 use crate::box_handle::BoxHandle;
 use crate::error::{BoxliteErrorCode, FFIError, null_pointer_error, write_error};
-use crate::event_queue::{CBoxInfoCb, CBoxInfoListCb, RuntimeEvent, push_event};
+use crate::event_queue::{
+    CBoxInfoArenaCb, CBoxInfoCb, CBoxInfoListCb, OwnedFfiPtr, RuntimeEvent, push_event,
+};
 use crate::runtime::RuntimeHandle;
-use crate::{CBoxHandle, CBoxliteError, CBoxliteRuntime};
+use crate::util::c_str_to_string;
+use crate::{CBoxHandle, CBoxliteError, CBoxliteListFilter, CBoxliteRuntime};
 
 #[repr(C)]
 pub struct CBoxInfo {
@@ -27,12 +32,57 @@ pub struct CBoxInfo {
     pub cpus: c_int,
     pub memory_mib: c_int,
     pub created_at: i64,
+    /// Host CPUs the VMM is pinned to, as a kernel list ("0-3,8"); NULL
+    /// when the box is not running or has no placement.
+    pub placement_cpus: *mut c_char,
+    /// NUMA nodes guest memory is bound to, same format; NULL with
+    /// `placement_cpus`.
+    pub placement_mems: *mut c_char,
 }
 
 #[repr(C)]
 pub struct CBoxInfoList {
     pub items: *mut CBoxInfo,
     pub count: c_int,
+    /// Boxes matching the filter across all pages (`count` for unfiltered
+    /// listings).
+    pub total: c_int,
+}
+
+/// One box of a `CBoxInfoArena`. The string fields are byte offsets into
+/// the arena's `strings`, each the start of a NUL-terminated string; an
+/// unnamed box's `name` and an unplaced box's `placement_*` are "".
+#[repr(C)]
+pub struct CBoxInfoRow {
+    pub id: u32,
+    pub name: u32,
+    pub image: u32,
+    pub status: u32,
+    pub running: c_int,
+    pub pid: c_int,
+    pub cpus: c_int,
+    pub memory_mib: c_int,
+    pub created_at: i64,
+    pub placement_cpus: u32,
+    pub placement_mems: u32,
+}
+
+/// A listing page whose strings all live in one buffer. Freed as a whole
+/// by `boxlite_free_box_info_arena`.
+#[repr(C)]
+pub struct CBoxInfoArena {
+    pub rows: *mut CBoxInfoRow,
+    pub count: c_int,
+    /// Boxes matching the filter across all pages.
+    pub total: c_int,
+    pub strings: *mut c_char,
+    pub strings_len: usize,
+}
+
+/// Opaque list filter. Owns a core [`BoxListFilter`] that the setters
+/// mutate in place before a listing call reads it.
+pub struct ListFilterHandle {
+    pub(crate) filter: BoxListFilter,
 }
 
 fn to_c_str(s: &str) -> *mut c_char {
@@ -69,10 +119,113 @@ impl CBoxInfo {
             cpus: info.cpus as c_int,
             memory_mib: info.memory_mib as c_int,
             created_at: info.created_at.timestamp(),
+            placement_cpus: info
+                .placement
+                .as_ref()
+                .map_or(ptr::null_mut(), |p| to_c_str(&p.cpu_list())),
+            placement_mems: info
+                .placement
+                .as_ref()
+                .map_or(ptr::null_mut(), |p| to_c_str(&p.mem_list())),
+        }
+    }
+}
+
+impl CBoxInfoList {
+    fn from_page(page: &BoxInfoPage) -> Self {
+        let mut items: Vec<CBoxInfo> = page.items.iter().map(CBoxInfo::from_box_info).collect();
+        let count = items.len() as c_int;
+        let ptr = items.as_mut_ptr();
+        std::mem::forget(items);
+        CBoxInfoList {
+            items: ptr,
+            count,
+            total: page.total.min(c_int::MAX as usize) as c_int,
+        }
+    }
+}
+
+impl CBoxInfoArena {
+    fn from_page(page: &BoxInfoPage) -> Self {
+        // Offset 0 is the empty string; each status is stored once.
+        let bytes: usize = page
+            .items
+            .iter()
+            .map(|b| b.id.as_str().len() + b.name.as_deref().map_or(0, str::len) + b.image.len())
+            .sum();
+        let mut strings: Vec<u8> = Vec::with_capacity(1 + bytes + 3 * page.items.len() + 64);
+        strings.push(0);
+        let mut status_offsets = [None::<u32>; BoxStatus::COUNT];
+
+        let rows: Vec<CBoxInfoRow> = page
+            .items
+            .iter()
+            .map(|info| {
+                let status = *status_offsets[info.status as usize]
+                    .get_or_insert_with(|| push_str(&mut strings, status_to_str(info.status)));
+                CBoxInfoRow {
+                    id: push_str(&mut strings, info.id.as_str()),
+                    name: info
+                        .name
+                        .as_deref()
+                        .map_or(0, |n| push_str(&mut strings, n)),
+                    image: push_str(&mut strings, &info.image),
+                    status,
+                    running: if info.status.is_running() { 1 } else { 0 },
+                    pid: info.pid.map(|p| p as c_int).unwrap_or(0),
+                    cpus: info.cpus as c_int,
+                    memory_mib: info.memory_mib as c_int,
+                    created_at: info.created_at.timestamp(),
+                    placement_cpus: info
+                        .placement
+                        .as_ref()
+                        .map_or(0, |p| push_str(&mut strings, &p.cpu_list())),
+                    placement_mems: info
+                        .placement
+                        .as_ref()
+                        .map_or(0, |p| push_str(&mut strings, &p.mem_list())),
+                }
+            })
+            .collect();
+
+        let count = rows.len() as c_int;
+        let strings = strings.into_boxed_slice();
+        let strings_len = strings.len();
+        CBoxInfoArena {
+            rows: Box::into_raw(rows.into_boxed_slice()) as *mut CBoxInfoRow,
+            count,
+            total: page.total.min(c_int::MAX as usize) as c_int,
+            strings: Box::into_raw(strings) as *mut c_char,
+            strings_len,
         }
     }
 }
 
+/// Append `s` and its terminator to the arena buffer, returning its offset.
+fn push_str(strings: &mut Vec<u8>, s: &str) -> u32 {
+    let offset = strings.len() as u32;
+    strings.extend_from_slice(s.as_bytes());
+    strings.push(0);
+    offset
+}
+
+pub unsafe fn free_box_info_arena(arena: *mut CBoxInfoArena) {
+    unsafe {
+        if arena.is_null() {
+            return;
+        }
+        let arena = Box::from_raw(arena);
+        drop(Box::from_raw(ptr::slice_from_raw_parts_mut(
+            arena.rows,
+            arena.count as usize,
+        )));
+        drop(Box::from_raw(ptr::slice_from_raw_parts_mut(
+            arena.strings as *mut u8,
+            arena.strings_len,
+        )));
+    }
+}
+
 pub unsafe fn free_box_info(info: *mut CBoxInfo) {
     unsafe {
         if info.is_null() {
@@ -83,6 +236,8 @@ pub unsafe fn free_box_info(info: *mut CBoxInfo) {
         free_str(info_ref.name);
         free_str(info_ref.image);
         free_str(info_ref.status);
+        free_str(info_ref.placement_cpus);
+        free_str(info_ref.placement_mems);
     }
 }
 
@@ -156,6 +311,227 @@ pub unsafe extern "C" fn boxlite_list_info(
     box_list(runtime, cb, user_data, out_error)
 }
 
+/// Like `boxlite_list_info`, but only the boxes `filter` selects, one page
+/// at a time (see `boxlite_list_filter_new`). NULL `filter` selects every
+/// box. `filter` is only read during the call; the caller still frees it.
+/// The list's `total` counts the matches across all pages.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_info_filtered(
+    runtime: *mut CBoxliteRuntime,
+    filter: *const CBoxliteListFilter,
+    cb: CBoxInfoListCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    box_list_filtered(runtime, filter, cb, user_data, out_error)
+}
+
+/// Like `boxlite_list_info_filtered`, but the callback receives a
+/// `CBoxInfoArena`: fixed-size rows plus one buffer holding every string,
+/// addressed by offset (`arena->strings + row->id`). The callback owns the
+/// arena; `boxlite_free_box_info_arena` releases it in one call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_info_arena(
+    runtime: *mut CBoxliteRuntime,
+    filter: *const CBoxliteListFilter,
+    cb: CBoxInfoArenaCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    box_list_arena(runtime, filter, cb, user_data, out_error)
+}
+
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_free_box_info_arena(arena: *mut CBoxInfoArena) {
+    free_box_info_arena(arena)
+}
+
+/// Create an empty list filter, which selects every box.
+///
+/// Free the handle with `boxlite_list_filter_free`.
+///
+/// # Safety
+/// `out_filter` must be non-NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_filter_new(
+    out_filter: *mut *mut CBoxliteListFilter,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if out_filter.is_null() {
+            write_error(out_error, null_pointer_error("out_filter"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        *out_filter = Box::into_raw(Box::new(ListFilterHandle {
+            filter: BoxListFilter::default(),
+        }));
+        BoxliteErrorCode::Ok
+    }
+}
+
+/// Also accept boxes in `status` ("running", "stopped", ... as reported in
+/// `CBoxInfo::status`). With no status added, any status matches.
+///
+/// Returns `InvalidArgument` if `filter` or `status` is NULL or `status`
+/// is not a known status.
+///
+/// # Safety
+/// `filter` must be a valid handle or NULL; `status` a valid C string or
+/// NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_filter_add_status(
+    filter: *mut CBoxliteListFilter,
+    status: *const c_char,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if filter.is_null() {
+            write_error(out_error, null_pointer_error("filter"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let parsed = c_str_to_string(status).and_then(|s| {
+            s.parse::<BoxStatus>()
+                .map_err(|()| BoxliteError::InvalidArgument(format!("unknown box status: {s}")))
+        });
+        match parsed {
+            Ok(status) => {
+                let statuses = &mut (*filter).filter.statuses;
+                if !statuses.contains(&status) {
+                    statuses.push(status);
+                }
+                BoxliteErrorCode::Ok
+            }
+            Err(e) => {
+                write_error(out_error, e);
+                BoxliteErrorCode::InvalidArgument
+            }
+        }
+    }
+}
+
+/// Only select boxes whose image reference is exactly `image`. NULL
+/// clears the criterion. No-op if `filter` is NULL or `image` is not a
+/// valid C string.
+///
+/// # Safety
+/// `filter` must be a valid handle or NULL; `image` a valid C string or
+/// NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_filter_set_image(
+    filter: *mut CBoxliteListFilter,
+    image: *const c_char,
+) {
+    unsafe {
+        if let Some(handle) = filter.as_mut() {
+            set_optional_str(&mut handle.filter.image, image);
+        }
+    }
+}
+
+/// Only select boxes whose name starts with `prefix`; unnamed boxes never
+/// match. NULL clears the criterion. No-op if `filter` is NULL or
+/// `prefix` is not a valid C string.
+///
+/// # Safety
+/// `filter` must be a valid handle or NULL; `prefix` a valid C string or
+/// NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_filter_set_name_prefix(
+    filter: *mut CBoxliteListFilter,
+    prefix: *const c_char,
+) {
+    unsafe {
+        if let Some(handle) = filter.as_mut() {
+            set_optional_str(&mut handle.filter.name_prefix, prefix);
+        }
+    }
+}
+
+/// Only select boxes carrying label `key` with value `value`. Labels
+/// added this way must all match.
+///
+/// Returns `InvalidArgument` if any argument is NULL or not a valid C
+/// string.
+///
+/// # Safety
+/// `filter` must be a valid handle or NULL; `key` and `value` valid C
+/// strings or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_filter_add_label(
+    filter: *mut CBoxliteListFilter,
+    key: *const c_char,
+    value: *const c_char,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if filter.is_null() {
+            write_error(out_error, null_pointer_error("filter"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        match (c_str_to_string(key), c_str_to_string(value)) {
+            (Ok(key), Ok(value)) => {
+                (*filter).filter.labels.push((key, value));
+                BoxliteErrorCode::Ok
+            }
+            (Err(e), _) | (_, Err(e)) => {
+                write_error(out_error, e);
+                BoxliteErrorCode::InvalidArgument
+            }
+        }
+    }
+}
+
+/// Page through the matches: skip the first `offset` (newest first) and
+/// return at most `limit`. `offset <= 0` starts at the first match and
+/// `limit <= 0` means no limit. No-op on NULL.
+///
+/// # Safety
+/// `filter` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_filter_set_page(
+    filter: *mut CBoxliteListFilter,
+    offset: c_int,
+    limit: c_int,
+) {
+    unsafe {
+        if let Some(handle) = filter.as_mut() {
+            handle.filter.offset = offset.max(0) as usize;
+            handle.filter.limit = (limit > 0).then_some(limit as usize);
+        }
+    }
+}
+
+/// Free a list filter. No-op on NULL.
+///
+/// # Safety
+/// `filter` must be a handle from `boxlite_list_filter_new` or NULL, and
+/// must not be used after this call.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_list_filter_free(filter: *mut CBoxliteListFilter) {
+    if !filter.is_null() {
+        unsafe {
+            drop(Box::from_raw(filter));
+        }
+    }
+}
+
+/// Setter shared by the optional string criteria: NULL clears, invalid
+/// strings leave the criterion unchanged.
+unsafe fn set_optional_str(field: &mut Option<String>, value: *const c_char) {
+    if value.is_null() {
+        *field = None;
+    } else if let Ok(value) = unsafe { c_str_to_string(value) } {
+        *field = Some(value);
+    }
+}
+
+/// Filter behind a nullable handle; NULL selects every box.
+unsafe fn list_filter(filter: *const ListFilterHandle) -> BoxListFilter {
+    unsafe { filter.as_ref() }
+        .map(|handle| handle.filter.clone())
+        .unwrap_or_default()
+}
+
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn boxlite_free_box_info(info: *mut CBoxInfo) {
     free_box_info_ptr(info)
@@ -261,14 +637,50 @@ unsafe fn box_list(
 
         runtime_ref.tokio_rt.spawn(async move {
             let result = runtime_clone.list_info().await.map(|boxes| {
-                let mut items: Vec<CBoxInfo> = boxes.iter().map(CBoxInfo::from_box_info).collect();
-                let count = items.len() as c_int;
-                let ptr = items.as_mut_ptr();
-                std::mem::forget(items);
-                crate::event_queue::OwnedFfiPtr::new_with(
-                    Box::new(CBoxInfoList { items: ptr, count }),
-                    free_box_info_list,
-                )
+                let page = BoxInfoPage {
+                    total: boxes.len(),
+                    items: boxes,
+                };
+                OwnedFfiPtr::new_with(Box::new(CBoxInfoList::from_page(&page)), free_box_info_list)
+            });
+            push_event(
+                &queue,
+                RuntimeEvent::InfoList {
+                    cb,
+                    user_data: user_data_addr,
+                    result,
+                },
+            )
+            .await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
+unsafe fn box_list_filtered(
+    runtime: *mut RuntimeHandle,
+    filter: *const ListFilterHandle,
+    cb: CBoxInfoListCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+        let filter = list_filter(filter);
+
+        let runtime_ref = &*runtime;
+        let runtime_clone = runtime_ref.runtime.clone();
+        let queue = runtime_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+
+        runtime_ref.tokio_rt.spawn(async move {
+            let result = runtime_clone.list_info_filtered(&filter).await.map(|page| {
+                OwnedFfiPtr::new_with(Box::new(CBoxInfoList::from_page(&page)), free_box_info_list)
             });
             push_event(
                 &queue,
@@ -284,3 +696,45 @@ unsafe fn box_list(
         BoxliteErrorCode::Ok
     }
 }
+
+unsafe fn box_list_arena(
+    runtime: *mut RuntimeHandle,
+    filter: *const ListFilterHandle,
+    cb: CBoxInfoArenaCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+        let filter = list_filter(filter);
+
+        let runtime_ref = &*runtime;
+        let runtime_clone = runtime_ref.runtime.clone();
+        let queue = runtime_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+
+        runtime_ref.tokio_rt.spawn(async move {
+            let result = runtime_clone.list_info_filtered(&filter).await.map(|page| {
+                OwnedFfiPtr::new_with(
+                    Box::new(CBoxInfoArena::from_page(&page)),
+                    free_box_info_arena,
+                )
+            });
+            push_event(
+                &queue,
+                RuntimeEvent::InfoArena {
+                    cb,
+                    user_data: user_data_addr,
+                    result,
+                },
+            )
+            .await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
@@ -12,7 +12,9 @@ mod box_handle;
 mod copy;
 mod error;
 mod event_queue;
+mod event_ring;
 mod exec;
+mod executor;
 mod images;
 mod info;
 mod metrics;
@@ -48,15 +50,26 @@ pub type CBoxliteCredential = rest::CredentialHandle;
 pub type CBoxliteRestOptions = rest::RestOptionsHandle;
 pub type CBoxliteSimple = exec::BoxRunner;
 pub type CBoxliteError = error::FFIError;
+pub type CBoxliteEventBatch = runtime::EventBatch;
 pub type CBoxliteExecResult = exec::ExecResult;
+pub type CBoxliteCaptureResult = exec::CaptureResult;
 pub type CBoxInfo = info::CBoxInfo;
 pub type CBoxInfoList = info::CBoxInfoList;
+pub type CBoxInfoArena = info::CBoxInfoArena;
+pub type CBoxliteListFilter = info::ListFilterHandle;
 pub type CBoxMetrics = metrics::CBoxMetrics;
+pub type CInitTrace = metrics::CInitTrace;
+pub type CBoxMetricsBatch = metrics::CBoxMetricsBatch;
+pub type CMetricsSubscription = metrics::MetricsSubscriptionHandle;
+pub type CMemoryReclaimResult = metrics::CMemoryReclaimResult;
 pub type CExecutionHandle = exec::ExecutionHandle;
+pub type CBoxliteExecutorOptions = executor::ExecutorOptionsHandle;
 pub type CImageInfoList = images::CImageInfoList;
 pub type CImagePullResult = images::CImagePullResult;
+pub type CImagePullProgress = images::CImagePullProgress;
 pub type CRuntimeMetrics = metrics::CRuntimeMetrics;
 pub type BoxliteCommand = exec::BoxliteCommand;
+pub type BoxliteOutputPacing = exec::BoxliteOutputPacing;
 pub type CAdvancedBoxOptions = advanced_options::AdvancedBoxOptionsHandle;
 
 pub use advanced_options::*;
@@ -65,6 +78,7 @@ pub use copy::*;
 pub use error::*;
 pub use event_queue::*;
 pub use exec::*;
+pub use executor::*;
 pub use images::*;
 pub use info::*;
 pub use metrics::*;
@@ -1,13 +1,61 @@
 //! Metrics types and operations for the BoxLite C SDK (async + callback).
 
-use std::os::raw::{c_int, c_void};
+use std::ffi::CString;
+use std::os::raw::{c_char, c_int, c_void};
+use std::ptr;
+use std::sync::Arc;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::time::Duration;
+
+use boxlite::{BoxMetricsSample, BoxliteError};
+use tokio::task::JoinHandle;
 
 use crate::box_handle::BoxHandle;
-use crate::error::{BoxliteErrorCode, FFIError, null_pointer_error, write_error};
-use crate::event_queue::{CBoxMetricsCb, CRuntimeMetricsCb, RuntimeEvent, push_event};
+use crate::error::{BoxliteErrorCode, FFIError, error_to_code, null_pointer_error, write_error};
+use crate::event_queue::{
+    CBoxInitTraceCb, CBoxMetricsBatchCb, CBoxMetricsCb, CMemoryReclaimCb, CRuntimeMetricsCb, Lane,
+    OwnedFfiPtr, QueueStats, RuntimeEvent, push_event,
+};
 use crate::runtime::RuntimeHandle;
-use crate::{CBoxHandle, CBoxliteError, CBoxliteRuntime};
+use crate::{CBoxHandle, CBoxliteError, CBoxliteRuntime, CMetricsSubscription};
 
+/// Summary of a recorded distribution. Quantiles are rounded up to the
+/// histogram bucket bound (within 12.5% of the exact value) and capped at
+/// `max`. All zero until the first sample.
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+pub struct CHistogramSummary {
+    pub count: u64,
+    pub sum: u64,
+    pub max: u64,
+    pub p50: u64,
+    pub p90: u64,
+    pub p99: u64,
+    pub p999: u64,
+}
+
+impl From<&boxlite::HistogramSnapshot> for CHistogramSummary {
+    fn from(h: &boxlite::HistogramSnapshot) -> Self {
+        Self {
+            count: h.count,
+            sum: h.sum,
+            max: h.max,
+            p50: h.value_at_quantile(0.5),
+            p90: h.value_at_quantile(0.9),
+            p99: h.value_at_quantile(0.99),
+            p999: h.value_at_quantile(0.999),
+        }
+    }
+}
+
+/// Per-box metrics.
+///
+/// The fields up to `network_tcp_errors` keep their original layout.
+/// `struct_size` follows them and is `sizeof(CBoxMetrics)` as built into
+/// the library; fields after it are only ever appended, so a caller
+/// compiled against a newer header checks `struct_size` before reading
+/// fields it knows the library may lack. Libraries from before
+/// `struct_size` (see `boxlite_version`) end at `network_tcp_errors`.
 #[repr(C)]
 #[derive(Clone, Copy)]
 pub struct CBoxMetrics {
@@ -23,8 +71,129 @@ pub struct CBoxMetrics {
     pub network_bytes_received: i64,
     pub network_tcp_connections: c_int,
     pub network_tcp_errors: c_int,
+    pub struct_size: u32,
+    /// Init stage timings in milliseconds (0 = not recorded).
+    pub stage_filesystem_setup_ms: i64,
+    pub stage_image_prepare_ms: i64,
+    pub stage_guest_rootfs_ms: i64,
+    pub stage_box_config_ms: i64,
+    pub stage_box_spawn_ms: i64,
+    pub stage_container_init_ms: i64,
+    /// Exec request to first output or exit status, in microseconds.
+    pub exec_response_latency_us: CHistogramSummary,
+    /// Resident memory of every host process in the box's sandbox, guest
+    /// RAM included (0 = not running).
+    pub host_rss_bytes: i64,
+}
+
+/// Guest memory around one `boxlite_box_reclaim_memory` call. "In use" is
+/// guest RAM minus free memory, the guest's view of what it holds on the
+/// host.
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+pub struct CMemoryReclaimResult {
+    pub total_bytes: u64,
+    pub in_use_before_bytes: u64,
+    pub in_use_after_bytes: u64,
+    pub cached_before_bytes: u64,
+    pub cached_after_bytes: u64,
+    /// 0 if in-use memory was already under the target.
+    pub reclaimed: c_int,
+}
+
+impl From<boxlite::MemoryReclaimResult> for CMemoryReclaimResult {
+    fn from(r: boxlite::MemoryReclaimResult) -> Self {
+        Self {
+            total_bytes: r.after.total_bytes,
+            in_use_before_bytes: r.before.in_use_bytes(),
+            in_use_after_bytes: r.after.in_use_bytes(),
+            cached_before_bytes: r.before.cached_bytes,
+            cached_after_bytes: r.after.cached_bytes,
+            reclaimed: r.reclaimed as c_int,
+        }
+    }
+}
+
+/// One running box in a `CBoxMetricsBatch`. `box_id` is a byte offset
+/// into the batch's `strings`. -1 marks a figure the sample lacks.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct CBoxMetricsSample {
+    pub box_id: u32,
+    /// CPU since the previous tick, in percent of one CPU (-1 on the box's
+    /// first tick).
+    pub cpu_percent: f64,
+    /// Cumulative CPU time of the box's sandbox (-1 without a cgroup).
+    pub cpu_usage_usec: i64,
+    /// Host memory charged to the box's cgroup, or the shim's RSS without
+    /// one.
+    pub memory_bytes: i64,
+}
+
+/// Every running box at one tick of a metrics subscription. Borrowed: valid
+/// only until the callback returns.
+#[repr(C)]
+pub struct CBoxMetricsBatch {
+    pub samples: *const CBoxMetricsSample,
+    pub count: c_int,
+    pub strings: *const c_char,
+    pub strings_len: usize,
+}
+
+/// Owned storage behind a [`CBoxMetricsBatch`], carried by the event.
+pub(crate) struct MetricsBatch {
+    samples: Vec<CBoxMetricsSample>,
+    strings: Vec<u8>,
 }
 
+impl MetricsBatch {
+    pub(crate) fn from_samples(samples: &[BoxMetricsSample]) -> Self {
+        let bytes: usize = samples.iter().map(|s| s.box_id.as_str().len() + 1).sum();
+        let mut strings = Vec::with_capacity(bytes);
+        let samples = samples
+            .iter()
+            .map(|s| {
+                let box_id = strings.len() as u32;
+                strings.extend_from_slice(s.box_id.as_str().as_bytes());
+                strings.push(0);
+                CBoxMetricsSample {
+                    box_id,
+                    cpu_percent: s.cpu_percent.map_or(-1.0, f64::from),
+                    cpu_usage_usec: s.cpu_usage_usec.map_or(-1, |v| v as i64),
+                    memory_bytes: s.memory_bytes.map_or(-1, |v| v as i64),
+                }
+            })
+            .collect();
+        Self { samples, strings }
+    }
+
+    /// C view of the batch, valid while `self` is.
+    pub(crate) fn as_c(&self) -> CBoxMetricsBatch {
+        CBoxMetricsBatch {
+            samples: self.samples.as_ptr(),
+            count: self.samples.len() as c_int,
+            strings: self.strings.as_ptr() as *const c_char,
+            strings_len: self.strings.len(),
+        }
+    }
+}
+
+/// A running metrics subscription. Ticks stop on free; the flag also
+/// suppresses batches already queued but not yet drained.
+pub struct MetricsSubscriptionHandle {
+    task: JoinHandle<()>,
+    cancelled: Arc<AtomicBool>,
+}
+
+impl Drop for MetricsSubscriptionHandle {
+    fn drop(&mut self) {
+        self.cancelled.store(true, Ordering::Release);
+        self.task.abort();
+    }
+}
+
+/// Runtime-wide metrics. Versioned by `struct_size` like [`CBoxMetrics`];
+/// the fields before it predate it.
 #[repr(C)]
 #[derive(Clone, Copy)]
 pub struct CRuntimeMetrics {
@@ -33,6 +202,93 @@ pub struct CRuntimeMetrics {
     pub num_running_boxes: c_int,
     pub total_commands_executed: c_int,
     pub total_exec_errors: c_int,
+    /// Boxes the warm pool keeps started (0 = no pool).
+    pub warm_pool_size: c_int,
+    /// Pooled boxes ready to be claimed right now.
+    pub warm_pool_ready: c_int,
+    /// Creates served from the pool.
+    pub warm_pool_hits: c_int,
+    /// Creates matching the pool that found it empty.
+    pub warm_pool_misses: c_int,
+    /// Boxes booted into the pool; sample it to get the refill rate.
+    pub warm_pool_refills: c_int,
+    pub struct_size: u32,
+    /// Box create/start call to ready, in microseconds (cold starts and
+    /// restarts).
+    pub create_latency_us: CHistogramSummary,
+    /// VM spawn to guest agent ready, in microseconds.
+    pub boot_latency_us: CHistogramSummary,
+    /// `exec` call to process started in the guest, in microseconds.
+    pub exec_start_latency_us: CHistogramSummary,
+    /// Events buffered in this runtime's queue each time a drain call
+    /// took one, including it.
+    pub drain_queue_depth: CHistogramSummary,
+}
+
+/// One task of the box's init pipeline; times are relative to init start.
+#[repr(C)]
+pub struct CInitTaskTrace {
+    pub name: *mut c_char,
+    pub start_ms: i64,
+    pub duration_ms: i64,
+    /// 1 if the task is on the chain that set `create_duration_ms`.
+    pub on_critical_path: c_int,
+}
+
+/// Init timeline of a box, ordered by task start time.
+#[repr(C)]
+pub struct CInitTrace {
+    pub tasks: *mut CInitTaskTrace,
+    pub count: c_int,
+    pub create_duration_ms: i64,
+}
+
+impl CInitTrace {
+    fn from_metrics(m: &boxlite::BoxMetrics) -> Self {
+        let mut tasks: Vec<CInitTaskTrace> = m
+            .init_trace()
+            .iter()
+            .map(|t| CInitTaskTrace {
+                name: CString::new(t.name.as_str())
+                    .map(|c| c.into_raw())
+                    .unwrap_or(ptr::null_mut()),
+                start_ms: t.start_ms as i64,
+                duration_ms: t.duration_ms as i64,
+                on_critical_path: t.on_critical_path as c_int,
+            })
+            .collect();
+        tasks.shrink_to_fit();
+        let count = tasks.len() as c_int;
+        let ptr = tasks.as_mut_ptr();
+        std::mem::forget(tasks);
+        Self {
+            tasks: ptr,
+            count,
+            create_duration_ms: m.total_create_duration_ms.unwrap_or(0) as i64,
+        }
+    }
+}
+
+pub unsafe fn free_init_trace(trace: *mut CInitTrace) {
+    unsafe {
+        if trace.is_null() {
+            return;
+        }
+        let trace_ref = &mut *trace;
+        if !trace_ref.tasks.is_null() {
+            let tasks = Vec::from_raw_parts(
+                trace_ref.tasks,
+                trace_ref.count as usize,
+                trace_ref.count as usize,
+            );
+            for task in tasks {
+                if !task.name.is_null() {
+                    drop(CString::from_raw(task.name));
+                }
+            }
+        }
+        drop(Box::from_raw(trace));
+    }
 }
 
 #[unsafe(no_mangle)]
@@ -45,6 +301,95 @@ pub unsafe extern "C" fn boxlite_box_metrics(
     box_metrics(handle, cb, user_data, out_error)
 }
 
+/// Return idle guest memory to the host: the guest drops clean page cache
+/// and compacts free memory, and the balloon device's free-page reporting
+/// hands it back. Skipped when the guest's in-use memory is already at or
+/// below `target_bytes`; 0 always reclaims.
+///
+/// Guest RAM itself stays fixed at `boxlite_options_set_memory`; watch
+/// `host_rss_bytes` in `CBoxMetrics` for the effect on the host.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_box_reclaim_memory(
+    handle: *mut CBoxHandle,
+    target_bytes: u64,
+    cb: CMemoryReclaimCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    box_reclaim_memory(handle, target_bytes, cb, user_data, out_error)
+}
+
+/// Per-task init timeline of a box, to see what dominates
+/// `create_duration_ms`. The callback owns the trace; free it with
+/// `boxlite_free_init_trace`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_box_init_trace(
+    handle: *mut CBoxHandle,
+    cb: CBoxInitTraceCb,
+    user_data: *mut c_void,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    box_init_trace(handle, cb, user_data, out_error)
+}
+
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_free_init_trace(trace: *mut CInitTrace) {
+    free_init_trace(trace)
+}
+
+/// Event queue counters of one runtime. The caller allocates it and sets
+/// `struct_size` to `sizeof(CQueueStats)` from its header; the library
+/// fills only that many bytes and sets `struct_size` to the bytes it
+/// wrote, so callers and libraries built against different headers agree
+/// on which fields are valid. An event's age runs from the moment its producer pushed
+/// it to the moment a drain call took it: growing ages with a low
+/// `callback_us` point at a drain loop that runs too rarely, a high
+/// `callback_us` at slow callbacks, and low ages at the backend itself.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct CQueueStats {
+    pub struct_size: u32,
+    /// Events buffered right now.
+    pub depth: u64,
+    /// Largest depth a producer has seen since the runtime was created.
+    pub peak_depth: u64,
+    /// Per-lane capacity; producers yield once their lane holds this many.
+    pub capacity: u64,
+    /// Times a producer found its lane full and yielded before retrying.
+    pub producer_yields: u64,
+    /// Events discarded because they were posted after the queue closed.
+    pub dropped_after_close: u64,
+    /// Age of stdout/stderr and copy-out chunks, in microseconds.
+    pub output_age_us: CHistogramSummary,
+    /// Age of execution exits, in microseconds.
+    pub exit_age_us: CHistogramSummary,
+    /// Age of op completions (create, start, wait, ...), in microseconds.
+    pub completion_age_us: CHistogramSummary,
+    /// Age of image pull and copy progress events and metrics batches, in
+    /// microseconds.
+    pub progress_age_us: CHistogramSummary,
+    /// Time spent inside each user callback, in microseconds.
+    pub callback_us: CHistogramSummary,
+}
+
+impl From<&QueueStats> for CQueueStats {
+    fn from(stats: &QueueStats) -> Self {
+        Self {
+            struct_size: std::mem::size_of::<CQueueStats>() as u32,
+            depth: stats.depth as u64,
+            peak_depth: stats.peak_depth as u64,
+            capacity: stats.capacity as u64,
+            producer_yields: stats.producer_yields,
+            dropped_after_close: stats.dropped_after_close,
+            output_age_us: (&stats.output_age_us).into(),
+            exit_age_us: (&stats.exit_age_us).into(),
+            completion_age_us: (&stats.completion_age_us).into(),
+            progress_age_us: (&stats.progress_age_us).into(),
+            callback_us: (&stats.callback_us).into(),
+        }
+    }
+}
+
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn boxlite_runtime_metrics(
     runtime: *mut CBoxliteRuntime,
@@ -55,6 +400,65 @@ pub unsafe extern "C" fn boxlite_runtime_metrics(
     runtime_metrics(runtime, cb, user_data, out_error)
 }
 
+/// Sample CPU and memory of every running box every `interval_ms`, in one
+/// pass over the boxes' cgroups, and deliver each tick as a single
+/// `CBoxMetricsBatch` through the drain queue. The first batch comes
+/// right away, with `cpu_percent` -1 throughout.
+///
+/// A tick is skipped while the previous batch is still undelivered or the
+/// queue is full, so batches never pile up behind a slow drain. If
+/// sampling fails the callback gets a NULL batch and the error; once the
+/// runtime is gone the subscription ends.
+/// `boxlite_metrics_subscription_free` stops it; no callback fires for
+/// it in a drain call made after that.
+///
+/// Only local runtimes support this (`Unsupported` otherwise).
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_runtime_subscribe_metrics(
+    runtime: *mut CBoxliteRuntime,
+    interval_ms: u64,
+    cb: CBoxMetricsBatchCb,
+    user_data: *mut c_void,
+    out_subscription: *mut *mut CMetricsSubscription,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    runtime_subscribe_metrics(
+        runtime,
+        interval_ms,
+        cb,
+        user_data,
+        out_subscription,
+        out_error,
+    )
+}
+
+/// Stop a metrics subscription and free it. NULL is a no-op.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_metrics_subscription_free(
+    subscription: *mut CMetricsSubscription,
+) {
+    unsafe {
+        if !subscription.is_null() {
+            drop(Box::from_raw(subscription));
+        }
+    }
+}
+
+/// Read the runtime's event queue counters into `*out_stats`, whose
+/// `struct_size` the caller must set (see [`CQueueStats`]).
+///
+/// Synchronous: the snapshot is taken on the calling thread rather than
+/// posted through the queue it describes, so it may be called from any
+/// thread, including from inside a callback.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_runtime_queue_stats(
+    runtime: *mut CBoxliteRuntime,
+    out_stats: *mut CQueueStats,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    runtime_queue_stats(runtime, out_stats, out_error)
+}
+
 unsafe fn box_metrics(
     handle: *mut BoxHandle,
     cb: CBoxMetricsCb,
@@ -87,6 +491,15 @@ unsafe fn box_metrics(
                 network_bytes_received: m.network_bytes_received.unwrap_or(0) as i64,
                 network_tcp_connections: m.network_tcp_connections.unwrap_or(0) as c_int,
                 network_tcp_errors: m.network_tcp_errors.unwrap_or(0) as c_int,
+                struct_size: std::mem::size_of::<CBoxMetrics>() as u32,
+                stage_filesystem_setup_ms: m.stage_filesystem_setup_ms.unwrap_or(0) as i64,
+                stage_image_prepare_ms: m.stage_image_prepare_ms.unwrap_or(0) as i64,
+                stage_guest_rootfs_ms: m.stage_guest_rootfs_ms.unwrap_or(0) as i64,
+                stage_box_config_ms: m.stage_box_config_ms.unwrap_or(0) as i64,
+                stage_box_spawn_ms: m.stage_box_spawn_ms.unwrap_or(0) as i64,
+                stage_container_init_ms: m.stage_container_init_ms.unwrap_or(0) as i64,
+                exec_response_latency_us: m.exec_response_latency_us().into(),
+                host_rss_bytes: m.host_rss_bytes.unwrap_or(0) as i64,
             });
             push_event(
                 &queue,
@@ -103,6 +516,82 @@ unsafe fn box_metrics(
     }
 }
 
+unsafe fn box_reclaim_memory(
+    handle: *mut BoxHandle,
+    target_bytes: u64,
+    cb: CMemoryReclaimCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if handle.is_null() {
+            write_error(out_error, null_pointer_error("handle"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+
+        let handle_ref = &*handle;
+        let lite = handle_ref.handle.clone();
+        let queue = handle_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+
+        handle_ref.tokio_rt.spawn(async move {
+            let result = lite
+                .reclaim_memory(target_bytes)
+                .await
+                .map(CMemoryReclaimResult::from);
+            push_event(
+                &queue,
+                RuntimeEvent::MemoryReclaim {
+                    cb,
+                    user_data: user_data_addr,
+                    result,
+                },
+            )
+            .await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
+unsafe fn box_init_trace(
+    handle: *mut BoxHandle,
+    cb: CBoxInitTraceCb,
+    user_data: *mut c_void,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if handle.is_null() {
+            write_error(out_error, null_pointer_error("handle"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+
+        let handle_ref = &*handle;
+        let lite = handle_ref.handle.clone();
+        let queue = handle_ref.queue.clone();
+        let user_data_addr = user_data as usize;
+
+        handle_ref.tokio_rt.spawn(async move {
+            let result = lite.metrics().await.map(|m| {
+                OwnedFfiPtr::new_with(Box::new(CInitTrace::from_metrics(&m)), free_init_trace)
+            });
+            push_event(
+                &queue,
+                RuntimeEvent::InitTrace {
+                    cb,
+                    user_data: user_data_addr,
+                    result,
+                },
+            )
+            .await;
+        });
+
+        BoxliteErrorCode::Ok
+    }
+}
+
 unsafe fn runtime_metrics(
     runtime: *mut RuntimeHandle,
     cb: CRuntimeMetricsCb,
@@ -128,6 +617,16 @@ unsafe fn runtime_metrics(
                 num_running_boxes: m.num_running_boxes() as c_int,
                 total_commands_executed: m.total_commands_executed() as c_int,
                 total_exec_errors: m.total_exec_errors() as c_int,
+                warm_pool_size: m.warm_pool_size() as c_int,
+                warm_pool_ready: m.warm_pool_ready() as c_int,
+                warm_pool_hits: m.warm_pool_hits_total() as c_int,
+                warm_pool_misses: m.warm_pool_misses_total() as c_int,
+                warm_pool_refills: m.warm_pool_refills_total() as c_int,
+                struct_size: std::mem::size_of::<CRuntimeMetrics>() as u32,
+                create_latency_us: (&m.create_latency_us()).into(),
+                boot_latency_us: (&m.boot_latency_us()).into(),
+                exec_start_latency_us: (&m.exec_start_latency_us()).into(),
+                drain_queue_depth: (&queue.depth_histogram()).into(),
             });
             push_event(
                 &queue,
@@ -143,3 +642,130 @@ unsafe fn runtime_metrics(
         BoxliteErrorCode::Ok
     }
 }
+
+unsafe fn runtime_subscribe_metrics(
+    runtime: *mut RuntimeHandle,
+    interval_ms: u64,
+    cb: CBoxMetricsBatchCb,
+    user_data: *mut c_void,
+    out_subscription: *mut *mut MetricsSubscriptionHandle,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        if out_subscription.is_null() {
+            write_error(out_error, null_pointer_error("out_subscription"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let cb = crate::unwrap_cb_or_return!(cb, out_error);
+        if interval_ms == 0 {
+            let err = BoxliteError::InvalidArgument("interval_ms must be positive".into());
+            write_error(out_error, err);
+            return BoxliteErrorCode::InvalidArgument;
+        }
+
+        let runtime_ref = &*runtime;
+        let mut sampler = match runtime_ref.runtime.box_metrics_sampler() {
+            Ok(sampler) => sampler,
+            Err(e) => {
+                let code = error_to_code(&e);
+                write_error(out_error, e);
+                return code;
+            }
+        };
+        let queue = runtime_ref.queue.clone();
+        let cancelled = Arc::new(AtomicBool::new(false));
+        let task_cancelled = cancelled.clone();
+        let user_data_addr = user_data as usize;
+        // Set while a batch sits in the queue, so a slow drain gets the
+        // latest sample instead of a backlog of stale ones.
+        let in_flight = Arc::new(AtomicBool::new(false));
+
+        let task = runtime_ref.tokio_rt.spawn(async move {
+            let mut ticker = tokio::time::interval(Duration::from_millis(interval_ms));
+            ticker.set_missed_tick_behavior(tokio::time::MissedTickBehavior::Skip);
+            loop {
+                ticker.tick().await;
+                if queue.is_closed() {
+                    return;
+                }
+                // A batch nobody is draining is stale by the next tick.
+                if in_flight.load(Ordering::Acquire)
+                    || queue.lane_len(Lane::Control) >= queue.capacity()
+                {
+                    continue;
+                }
+                let Ok((returned, result)) = tokio::task::spawn_blocking(move || {
+                    let result = sampler.sample();
+                    (sampler, result)
+                })
+                .await
+                else {
+                    return;
+                };
+                sampler = returned;
+
+                let stopped = matches!(result, Err(BoxliteError::Stopped(_)));
+                in_flight.store(true, Ordering::Release);
+                let pushed = queue.try_push(RuntimeEvent::MetricsBatch {
+                    cb,
+                    user_data: user_data_addr,
+                    cancelled: task_cancelled.clone(),
+                    in_flight: in_flight.clone(),
+                    result: result.map(|samples| MetricsBatch::from_samples(&samples)),
+                });
+                if pushed.is_err() {
+                    in_flight.store(false, Ordering::Release);
+                }
+                if stopped {
+                    return;
+                }
+            }
+        });
+
+        *out_subscription = Box::into_raw(Box::new(MetricsSubscriptionHandle { task, cancelled }));
+        BoxliteErrorCode::Ok
+    }
+}
+
+unsafe fn runtime_queue_stats(
+    runtime: *mut RuntimeHandle,
+    out_stats: *mut CQueueStats,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        if out_stats.is_null() {
+            write_error(out_error, null_pointer_error("out_stats"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        // Only `struct_size` is read: the caller's struct may be shorter
+        // (or longer) than ours.
+        let caller_size = ptr::addr_of!((*out_stats).struct_size).read_unaligned() as usize;
+        if caller_size < std::mem::size_of::<u32>() {
+            write_error(
+                out_error,
+                BoxliteError::InvalidArgument(format!(
+                    "out_stats->struct_size is {}; set it to sizeof(CQueueStats)",
+                    caller_size
+                )),
+            );
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        let len = caller_size.min(std::mem::size_of::<CQueueStats>());
+        let mut stats = CQueueStats::from(&(*runtime).queue.stats());
+        stats.struct_size = len as u32;
+        ptr::copy_nonoverlapping(
+            &stats as *const CQueueStats as *const u8,
+            out_stats as *mut u8,
+            len,
+        );
+        BoxliteErrorCode::Ok
+    }
+}
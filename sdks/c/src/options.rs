@@ -1,7 +1,7 @@
 use std::os::raw::{c_char, c_int};
 
 use boxlite::runtime::options::{
-    BoxOptions, NetworkSpec, PortProtocol, PortSpec, RootfsSpec, Secret, VolumeSpec,
+    BoxOptions, NetworkSpec, PortProtocol, PortSpec, RootfsSpec, Secret, VolumeSpec, VolumeTuning,
 };
 
 use crate::error::{BoxliteErrorCode, FFIError, null_pointer_error, write_error};
@@ -11,6 +11,15 @@ use crate::{CBoxliteError, CBoxliteOptions};
 pub struct OptionsHandle {
     pub options: BoxOptions,
     pub name: Option<String>,
+    /// Set by `boxlite_options_set_start_snapshot`.
+    pub start_snapshot: Option<StartSnapshot>,
+}
+
+/// Snapshot a box created with these options starts from.
+pub struct StartSnapshot {
+    /// Source box ID or name.
+    pub source: String,
+    pub snapshot: String,
 }
 
 #[unsafe(no_mangle)]
@@ -80,6 +89,28 @@ pub unsafe extern "C" fn boxlite_options_add_volume(
     options_add_volume(opts, host_path, guest_path, read_only)
 }
 
+/// Like `boxlite_options_add_volume`, with the sharing performance mode
+/// chosen per field. A negative value keeps that field's default for the
+/// `read_only` flag.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_options_add_volume_tuned(
+    opts: *mut CBoxliteOptions,
+    host_path: *const c_char,
+    guest_path: *const c_char,
+    read_only: c_int,
+    dax_window_bytes: i64,
+    noatime: c_int,
+) {
+    options_add_volume_tuned(
+        opts,
+        host_path,
+        guest_path,
+        read_only,
+        dax_window_bytes,
+        noatime,
+    )
+}
+
 /// Transport protocol for a port forwarding rule.
 #[repr(C)]
 #[derive(Clone, Copy, Debug, PartialEq, Eq)]
@@ -188,6 +219,23 @@ pub unsafe extern "C" fn boxlite_options_set_cmd(
     options_set_cmd(opts, args, argc)
 }
 
+/// Make `boxlite_create_box` start the box from snapshot `snapshot` of box
+/// `source_box` (ID or name) instead of from the image: its disk becomes a
+/// copy-on-write child of the snapshot, shared by every box started from
+/// it, and the box is running when the create callback fires. The image
+/// set on `opts` is ignored in favour of the source box's.
+///
+/// NULL `source_box` or `snapshot` clears the setting. Ignored by
+/// `boxlite_get_or_create_box`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_options_set_start_snapshot(
+    opts: *mut CBoxliteOptions,
+    source_box: *const c_char,
+    snapshot: *const c_char,
+) {
+    options_set_start_snapshot(opts, source_box, snapshot)
+}
+
 #[unsafe(no_mangle)]
 pub unsafe extern "C" fn boxlite_options_free(opts: *mut CBoxliteOptions) {
     options_free(opts)
@@ -218,6 +266,7 @@ pub unsafe fn options_new(
                 ..Default::default()
             },
             name: None,
+            start_snapshot: None,
         });
 
         *out_opts = Box::into_raw(handle);
@@ -247,6 +296,26 @@ pub unsafe fn options_set_name(handle: *mut OptionsHandle, name: *const c_char)
     }
 }
 
+pub unsafe fn options_set_start_snapshot(
+    handle: *mut OptionsHandle,
+    source_box: *const c_char,
+    snapshot: *const c_char,
+) {
+    unsafe {
+        if handle.is_null() {
+            return;
+        }
+        if source_box.is_null() || snapshot.is_null() {
+            (*handle).start_snapshot = None;
+            return;
+        }
+        if let (Ok(source), Ok(snapshot)) = (c_str_to_string(source_box), c_str_to_string(snapshot))
+        {
+            (*handle).start_snapshot = Some(StartSnapshot { source, snapshot });
+        }
+    }
+}
+
 pub unsafe fn options_set_cpus(handle: *mut OptionsHandle, cpus: c_int) {
     unsafe {
         if !handle.is_null() && cpus > 0 {
@@ -308,11 +377,43 @@ pub unsafe fn options_add_volume(
                 host_path: h,
                 guest_path: g,
                 read_only: read_only != 0,
+                tuning: None,
             });
         }
     }
 }
 
+pub unsafe fn options_add_volume_tuned(
+    handle: *mut OptionsHandle,
+    host_path: *const c_char,
+    guest_path: *const c_char,
+    read_only: c_int,
+    dax_window_bytes: i64,
+    noatime: c_int,
+) {
+    unsafe {
+        let Some(handle) = handle.as_mut() else {
+            return;
+        };
+        let before = handle.options.volumes.len();
+        options_add_volume(handle, host_path, guest_path, read_only);
+        if handle.options.volumes.len() == before {
+            return;
+        }
+        let Some(volume) = handle.options.volumes.last_mut() else {
+            return;
+        };
+        let mut tuning = VolumeTuning::defaults_for(volume.read_only);
+        if dax_window_bytes >= 0 {
+            tuning.dax_window_bytes = dax_window_bytes as u64;
+        }
+        if noatime >= 0 {
+            tuning.noatime = noatime != 0;
+        }
+        volume.tuning = Some(tuning);
+    }
+}
+
 pub unsafe fn options_add_port(
     handle: *mut OptionsHandle,
     host_port: u16,
@@ -28,19 +28,23 @@
 //! image, and metrics operation works against it unchanged. Free it
 //! with `boxlite_runtime_free` like any other runtime handle.
 
-use std::os::raw::c_char;
+use std::os::raw::{c_char, c_int};
 use std::sync::Arc;
+use std::time::Duration;
 
-use boxlite::BoxliteError;
 use boxlite::BoxliteRestOptions;
 use boxlite::runtime::BoxliteRuntime;
 use boxlite::{ApiKeyCredential, Credential};
 
 use crate::error::{BoxliteErrorCode, error_to_code, null_pointer_error, write_error};
 use crate::event_queue::EventQueue;
-use crate::runtime::{RuntimeHandle, RuntimeLiveness, create_tokio_runtime};
+use crate::executor::{ExecutorConfig, executor_config};
+use crate::runtime::{RuntimeHandle, RuntimeLiveness};
 use crate::util::c_str_to_string;
-use crate::{CBoxliteCredential, CBoxliteError, CBoxliteRestOptions, CBoxliteRuntime};
+use crate::{
+    CBoxliteCredential, CBoxliteError, CBoxliteExecutorOptions, CBoxliteRestOptions,
+    CBoxliteRuntime,
+};
 
 /// Opaque credential handle. Wraps a core `Arc<dyn Credential>` so the
 /// concrete credential kind (today only `ApiKeyCredential`) is hidden
@@ -54,6 +58,7 @@ pub struct CredentialHandle {
 /// the setters mutate in place before construction.
 pub struct RestOptionsHandle {
     opts: BoxliteRestOptions,
+    executor: ExecutorConfig,
 }
 
 /// Create an API-key credential.
@@ -144,6 +149,7 @@ pub unsafe extern "C" fn boxlite_rest_options_new(
 
         let handle = RestOptionsHandle {
             opts: BoxliteRestOptions::new(url),
+            executor: ExecutorConfig::default(),
         };
         *out_options = Box::into_raw(Box::new(handle));
         BoxliteErrorCode::Ok
@@ -196,6 +202,103 @@ pub unsafe extern "C" fn boxlite_rest_options_set_path_prefix(
     }
 }
 
+/// Drive the REST runtime on the executor described by `executor`
+/// instead of a private default one (see `boxlite_executor_options_new`).
+/// The settings are copied, so the caller still owns `executor` and
+/// frees it with `boxlite_executor_options_free`. NULL `executor`
+/// restores the default. No-op if `options` is NULL.
+///
+/// # Safety
+/// `options` and `executor` must be valid handles or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_rest_options_set_executor(
+    options: *mut CBoxliteRestOptions,
+    executor: *const CBoxliteExecutorOptions,
+) {
+    unsafe {
+        if !options.is_null() {
+            (*options).executor = executor_config(executor);
+        }
+    }
+}
+
+/// Tune the connection pool shared by every request of the runtime.
+/// `max_idle_per_host` caps idle keep-alive connections per host (0
+/// disables reuse); `idle_timeout_ms` is how long an idle connection is
+/// kept. A negative value restores the default for that setting
+/// (unlimited, 90 s). No-op on NULL.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_rest_options_set_pool(
+    options: *mut CBoxliteRestOptions,
+    max_idle_per_host: c_int,
+    idle_timeout_ms: c_int,
+) {
+    unsafe {
+        if options.is_null() {
+            return;
+        }
+        let http = &mut (*options).opts.http;
+        http.pool_max_idle_per_host = usize::try_from(max_idle_per_host).ok();
+        http.pool_idle_timeout = u64::try_from(idle_timeout_ms)
+            .ok()
+            .map(Duration::from_millis);
+    }
+}
+
+/// Configure HTTP/2. Over `https://` HTTP/2 is negotiated whenever the
+/// server offers it, multiplexing all requests over one connection;
+/// non-zero `prior_knowledge` also uses it over plain `http://` (h2c),
+/// which the server must support. `keep_alive_ms > 0` sends a PING at
+/// that interval so idle connections survive NATs and load balancers;
+/// `<= 0` disables it. No-op on NULL.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_rest_options_set_http2(
+    options: *mut CBoxliteRestOptions,
+    prior_knowledge: c_int,
+    keep_alive_ms: c_int,
+) {
+    unsafe {
+        if options.is_null() {
+            return;
+        }
+        let http = &mut (*options).opts.http;
+        http.http2_prior_knowledge = prior_knowledge != 0;
+        http.http2_keep_alive_interval =
+            (keep_alive_ms > 0).then(|| Duration::from_millis(keep_alive_ms as u64));
+    }
+}
+
+/// Set how long `GET /v1/config` and `GET /v1/me` responses are cached
+/// when the server sends no `Cache-Control` lifetime (a server lifetime
+/// always wins). 0 = not cached; negative = cached until the runtime is
+/// freed. Defaults: config cached until freed, identity not cached.
+/// No-op on NULL.
+///
+/// # Safety
+/// `options` must be a valid handle or NULL.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_rest_options_set_cache_ttl(
+    options: *mut CBoxliteRestOptions,
+    config_ttl_ms: i64,
+    me_ttl_ms: i64,
+) {
+    unsafe {
+        if options.is_null() {
+            return;
+        }
+        let ttl = |ms: i64| u64::try_from(ms).ok().map(Duration::from_millis);
+        let http = &mut (*options).opts.http;
+        http.config_ttl = ttl(config_ttl_ms);
+        http.me_ttl = ttl(me_ttl_ms);
+    }
+}
+
 /// Free a REST options handle. No-op on NULL.
 ///
 /// # Safety
@@ -242,11 +345,12 @@ pub unsafe extern "C" fn boxlite_rest_runtime_new_with_options(
 
         let opts = (*options).opts.clone();
 
-        let tokio_rt = match create_tokio_runtime() {
+        let tokio_rt = match (*options).executor.runtime() {
             Ok(rt) => rt,
             Err(e) => {
-                write_error(out_error, BoxliteError::Internal(e));
-                return BoxliteErrorCode::Internal;
+                let code = error_to_code(&e);
+                write_error(out_error, e);
+                return code;
             }
         };
 
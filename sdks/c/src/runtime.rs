@@ -16,12 +16,18 @@ use boxlite::runtime::BoxliteRuntime;
 use boxlite::runtime::options::{
     BoxliteOptions, ImageRegistry, ImageRegistryAuth, RegistryTransport,
 };
+use bytes::Bytes;
 
 use crate::error::{BoxliteErrorCode, FFIError, error_to_code, null_pointer_error, write_error};
 use crate::event_queue::{CRuntimeShutdownCb, EventQueue, RuntimeEvent, push_event};
+use crate::executor::{ExecutorOptionsHandle, executor_config};
 use crate::images::ImageHandle;
+use crate::options::OptionsHandle;
 use crate::util::c_str_to_string;
-use crate::{CBoxliteError, CBoxliteImageHandle, CBoxliteRuntime};
+use crate::{
+    CBoxliteError, CBoxliteEventBatch, CBoxliteExecutorOptions, CBoxliteImageHandle,
+    CBoxliteOptions, CBoxliteRuntime,
+};
 
 /// Opaque handle to a BoxliteRuntime instance with its Tokio runtime and the
 /// per-runtime event queue used by the post-and-drain callback API.
@@ -62,13 +68,6 @@ impl Default for RuntimeLiveness {
     }
 }
 
-/// Create a new Tokio runtime
-pub fn create_tokio_runtime() -> Result<Arc<TokioRuntime>, String> {
-    TokioRuntime::new()
-        .map(Arc::new)
-        .map_err(|e| format!("Failed to create async runtime: {}", e))
-}
-
 #[repr(C)]
 #[derive(Clone, Copy, Debug, PartialEq, Eq)]
 pub enum BoxliteRegistryTransport {
@@ -105,6 +104,34 @@ pub unsafe extern "C" fn boxlite_runtime_new(
         home_dir,
         image_registries,
         image_registries_count,
+        ptr::null(),
+        out_runtime,
+        out_error,
+    )
+}
+
+/// Like `boxlite_runtime_new`, but drives the runtime on the executor
+/// described by `executor` (see `boxlite_executor_options_new`). NULL
+/// `executor` is the default: a private runtime with one worker per CPU.
+/// `executor` is only read during the call; the caller still frees it.
+///
+/// Returns `Unsupported` if the options ask for CPU or NUMA placement on a
+/// platform without it, and `InvalidArgument` if the requested CPUs are
+/// not available to the process.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_runtime_new_with_executor(
+    home_dir: *const c_char,
+    image_registries: *const BoxliteImageRegistry,
+    image_registries_count: c_int,
+    executor: *const CBoxliteExecutorOptions,
+    out_runtime: *mut *mut CBoxliteRuntime,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    runtime_new(
+        home_dir,
+        image_registries,
+        image_registries_count,
+        executor,
         out_runtime,
         out_error,
     )
@@ -119,6 +146,25 @@ pub unsafe extern "C" fn boxlite_runtime_images(
     runtime_images(runtime, out_handle, out_error)
 }
 
+/// Keep `size` boxes created from `opts` started in the background, so
+/// `boxlite_create_box` calls with the same options (and no name) return
+/// without booting a VM. The name set on `opts` is ignored; `size == 0`
+/// disables the pool. `opts` is only read during the call; the caller
+/// still frees it.
+///
+/// Returns `InvalidArgument` unless `opts` keeps auto-remove on and detach
+/// off, and `Unsupported` on REST runtimes. Pool counters are reported in
+/// `CRuntimeMetrics`.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_runtime_set_warm_pool(
+    runtime: *mut CBoxliteRuntime,
+    opts: *const CBoxliteOptions,
+    size: usize,
+    out_error: *mut CBoxliteError,
+) -> BoxliteErrorCode {
+    set_warm_pool(runtime, opts, size, out_error)
+}
+
 /// Async + callback variant of runtime shutdown.
 ///
 /// Spawns a Tokio task that calls `BoxliteRuntime::shutdown` and posts a
@@ -146,7 +192,14 @@ pub unsafe extern "C" fn boxlite_runtime_free(runtime: *mut CBoxliteRuntime) {
 }
 
 /// Drain pending callbacks for `runtime`, dispatching them on the calling
-/// thread. The queue lock is released before any user code runs.
+/// thread. No queue lock is held while user code runs.
+///
+/// Dispatch order: lifecycle completions (create, start, wait, kill, ...)
+/// are served ahead of queued stdout/stderr, with output still getting one
+/// turn per few completions, and executions with pending output take turns
+/// rather than draining one execution's backlog first. Each execution's
+/// own stdout, stderr and exit events keep the order they were produced
+/// in, and exit always comes last.
 ///
 /// `timeout_ms`:
 ///   - `0`  : non-blocking poll
@@ -163,10 +216,75 @@ pub unsafe extern "C" fn boxlite_runtime_drain(
     drain(runtime, timeout_ms, out_error)
 }
 
+/// Like `boxlite_runtime_drain`, but stops early once `max_events` events
+/// have been dispatched or `budget_ms` milliseconds have elapsed since the
+/// first dispatch, whichever comes first. `max_events <= 0` and
+/// `budget_ms <= 0` mean "no limit". `timeout_ms` has the same meaning as
+/// for `boxlite_runtime_drain`.
+///
+/// Returns the number of dispatched events, or `-1` on error.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_runtime_drain_batch(
+    runtime: *mut CBoxliteRuntime,
+    timeout_ms: c_int,
+    max_events: c_int,
+    budget_ms: c_int,
+    out_error: *mut CBoxliteError,
+) -> c_int {
+    drain_batch(runtime, timeout_ms, max_events, budget_ms, out_error)
+}
+
+/// Drain execution output into a caller-provided array instead of invoking
+/// the stdout/stderr/exit callbacks, so a binding can cross the FFI boundary
+/// once per batch rather than once per chunk.
+///
+/// Each record carries the `user_data` registered with the execution; the
+/// callback that would have run is NOT invoked. Lifecycle events (create,
+/// start, wait, ...) are still dispatched through their callbacks: those
+/// that arrive before the first record are dispatched inline, and the first
+/// one that arrives after a record ends the batch, so no callback runs
+/// while a batch is being collected.
+///
+/// Blocks up to `timeout_ms` (same meaning as `boxlite_runtime_drain`) only
+/// while no record has been filled; afterwards it returns as soon as the
+/// array is full or no further event is immediately available.
+///
+/// `records[i].data` points into `*out_batch`, which stays valid until
+/// `boxlite_event_batch_free(*out_batch)`. `*out_batch` is set to NULL when
+/// no record owns a buffer.
+///
+/// Returns the number of records written, or `-1` on error.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_runtime_drain_records(
+    runtime: *mut CBoxliteRuntime,
+    timeout_ms: c_int,
+    records: *mut CEventRecord,
+    max_records: c_int,
+    out_batch: *mut *mut CBoxliteEventBatch,
+    out_error: *mut CBoxliteError,
+) -> c_int {
+    drain_records(
+        runtime,
+        timeout_ms,
+        records,
+        max_records,
+        out_batch,
+        out_error,
+    )
+}
+
+/// Free the buffers backing a `boxlite_runtime_drain_records` batch.
+/// NULL is a no-op.
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn boxlite_event_batch_free(batch: *mut CBoxliteEventBatch) {
+    event_batch_free(batch)
+}
+
 unsafe fn runtime_new(
     home_dir: *const c_char,
     image_registries: *const BoxliteImageRegistry,
     image_registries_count: c_int,
+    executor: *const ExecutorOptionsHandle,
     out_runtime: *mut *mut RuntimeHandle,
     out_error: *mut FFIError,
 ) -> BoxliteErrorCode {
@@ -176,12 +294,12 @@ unsafe fn runtime_new(
             return BoxliteErrorCode::InvalidArgument;
         }
 
-        let tokio_rt = match create_tokio_runtime() {
+        let tokio_rt = match executor_config(executor).runtime() {
             Ok(rt) => rt,
             Err(e) => {
-                let err = BoxliteError::Internal(e);
-                write_error(out_error, err);
-                return BoxliteErrorCode::Internal;
+                let code = error_to_code(&e);
+                write_error(out_error, e);
+                return code;
             }
         };
 
@@ -347,6 +465,48 @@ unsafe fn runtime_images(
     }
 }
 
+unsafe fn set_warm_pool(
+    runtime: *mut RuntimeHandle,
+    opts: *const OptionsHandle,
+    size: usize,
+    out_error: *mut FFIError,
+) -> BoxliteErrorCode {
+    unsafe {
+        if runtime.is_null() {
+            write_error(out_error, null_pointer_error("runtime"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+        if opts.is_null() {
+            write_error(out_error, null_pointer_error("opts"));
+            return BoxliteErrorCode::InvalidArgument;
+        }
+
+        let runtime_ref = &*runtime;
+        if let Err(e) =
+            crate::util::ensure_runtime_live(&runtime_ref.liveness, "configure warm pool")
+        {
+            let code = error_to_code(&e);
+            write_error(out_error, e);
+            return code;
+        }
+
+        let options = (*opts).options.clone();
+        let runtime_clone = runtime_ref.runtime.clone();
+        // Returns once the pool is reconfigured; boxes boot in the background.
+        match runtime_ref
+            .tokio_rt
+            .block_on(runtime_clone.configure_warm_pool(options, size))
+        {
+            Ok(()) => BoxliteErrorCode::Ok,
+            Err(e) => {
+                let code = error_to_code(&e);
+                write_error(out_error, e);
+                code
+            }
+        }
+    }
+}
+
 unsafe fn shutdown_runtime(
     runtime: *mut RuntimeHandle,
     timeout: Option<i32>,
@@ -401,78 +561,290 @@ unsafe fn runtime_free(runtime: *mut RuntimeHandle) {
     }
 }
 
+/// Early-exit limits for one drain call; `None` means unlimited.
+#[derive(Clone, Copy, Default)]
+struct DrainLimits {
+    max_events: Option<usize>,
+    /// Measured from the first dispatch, not from entry, so time spent
+    /// waiting for the first event does not eat into it.
+    budget: Option<Duration>,
+}
+
+/// Kind of a `CEventRecord` produced by `boxlite_runtime_drain_records`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum BoxliteEventKind {
+    /// `data`/`len` hold a stdout chunk.
+    BoxliteEventKindStdout = 0,
+    /// `data`/`len` hold a stderr chunk.
+    BoxliteEventKindStderr = 1,
+    /// `code` holds the exit code; `data` is NULL. Always the last record
+    /// for its execution.
+    BoxliteEventKindExit = 2,
+}
+
+/// Plain-C execution event filled by `boxlite_runtime_drain_records`.
+#[repr(C)]
+#[derive(Debug, Clone, Copy)]
+pub struct CEventRecord {
+    pub kind: BoxliteEventKind,
+    /// `user_data` the execution's callbacks were registered with.
+    pub user_data: *mut c_void,
+    /// Chunk bytes, owned by the batch; NULL for exit records.
+    pub data: *const u8,
+    pub len: usize,
+    /// Exit code for exit records; 0 otherwise.
+    pub code: c_int,
+}
+
+/// Owns the chunk buffers referenced by one batch of `CEventRecord`s.
+pub struct EventBatch {
+    buffers: Vec<Bytes>,
+}
+
 unsafe fn drain(rt: *mut RuntimeHandle, timeout_ms: c_int, out_error: *mut FFIError) -> c_int {
+    unsafe { drain_bounded(rt, timeout_ms, DrainLimits::default(), out_error) }
+}
+
+unsafe fn drain_batch(
+    rt: *mut RuntimeHandle,
+    timeout_ms: c_int,
+    max_events: c_int,
+    budget_ms: c_int,
+    out_error: *mut FFIError,
+) -> c_int {
+    let limits = DrainLimits {
+        max_events: (max_events > 0).then_some(max_events as usize),
+        budget: (budget_ms > 0).then(|| Duration::from_millis(budget_ms as u64)),
+    };
+    unsafe { drain_bounded(rt, timeout_ms, limits, out_error) }
+}
+
+unsafe fn drain_bounded(
+    rt: *mut RuntimeHandle,
+    timeout_ms: c_int,
+    limits: DrainLimits,
+    out_error: *mut FFIError,
+) -> c_int {
     if rt.is_null() {
         unsafe { write_error(out_error, null_pointer_error("runtime")) };
         return -1;
     }
 
-    // Clone the queue Arc once at entry so the queue's Mutex/Condvar stay
+    // Clone the queue Arc once at entry so the queue's ring and park state stay
     // valid for the rest of the call even if `runtime_free` drops the
     // RuntimeHandle concurrently. After this line we never re-deref `rt`.
     let queue = unsafe { (*rt).queue.clone() };
+    unsafe { drain_queue(&queue, drain_deadline(timeout_ms), limits) }
+}
 
-    let deadline = if timeout_ms < 0 {
+unsafe fn drain_queue(queue: &EventQueue, deadline: Option<Instant>, limits: DrainLimits) -> c_int {
+    let mut count: usize = 0;
+    let mut budget_end: Option<Instant> = None;
+    loop {
+        // Honour close — `runtime_free` set this and woke parked drainers.
+        if queue.is_closed() {
+            break;
+        }
+        if limits.max_events.is_some_and(|max| count >= max) {
+            break;
+        }
+        if budget_end.is_some_and(|end| Instant::now() >= end) {
+            break;
+        }
+        if let Some(event) = queue.try_pop() {
+            if count == 0 {
+                budget_end = limits.budget.map(|budget| Instant::now() + budget);
+            }
+            // No lock is held here; producers keep pushing while user code runs.
+            unsafe { dispatch_timed(queue, event) };
+            count += 1;
+            continue;
+        }
+        if !wait_for_event(queue, deadline) {
+            break;
+        }
+    }
+    count.min(c_int::MAX as usize) as c_int
+}
+
+/// `timeout_ms` → absolute deadline; negative means wait forever.
+fn drain_deadline(timeout_ms: c_int) -> Option<Instant> {
+    if timeout_ms < 0 {
         None
     } else {
         Some(Instant::now() + Duration::from_millis(timeout_ms as u64))
-    };
+    }
+}
 
-    let mut count: c_int = 0;
-    loop {
-        // ─── Pop one event ───
-        let event_opt: Option<RuntimeEvent> = {
-            let mut g = queue.inner.lock().unwrap();
-            let mut popped: Option<RuntimeEvent> = None;
-            while popped.is_none() {
-                // Honour close — `runtime_free` set this and signalled the cv.
-                if queue.is_closed() {
-                    return count;
-                }
-                if let Some(ev) = g.pop_front() {
-                    popped = Some(ev);
-                    break;
-                }
-                match deadline {
-                    None => g = queue.cv.wait(g).unwrap(),
-                    Some(d) => {
-                        let now = Instant::now();
-                        if now >= d {
-                            return count;
-                        }
-                        let (new_g, _timeout) = queue.cv.wait_timeout(g, d - now).unwrap();
-                        g = new_g;
-                        if g.is_empty() && Instant::now() >= d {
-                            return count;
-                        }
-                    }
-                }
+/// Park until an event may be available. Returns `false` once `deadline`
+/// has passed; the caller re-checks the queue (and close) either way.
+fn wait_for_event(queue: &EventQueue, deadline: Option<Instant>) -> bool {
+    match deadline {
+        None => queue.park(None),
+        Some(d) => {
+            if Instant::now() >= d {
+                return false;
             }
-            popped
-        };
+            queue.park(Some(d));
+        }
+    }
+    true
+}
 
-        let Some(event) = event_opt else {
-            return count;
+unsafe fn drain_records(
+    rt: *mut RuntimeHandle,
+    timeout_ms: c_int,
+    records: *mut CEventRecord,
+    max_records: c_int,
+    out_batch: *mut *mut EventBatch,
+    out_error: *mut FFIError,
+) -> c_int {
+    if rt.is_null() {
+        unsafe { write_error(out_error, null_pointer_error("runtime")) };
+        return -1;
+    }
+    if records.is_null() {
+        unsafe { write_error(out_error, null_pointer_error("records")) };
+        return -1;
+    }
+    if out_batch.is_null() {
+        unsafe { write_error(out_error, null_pointer_error("out_batch")) };
+        return -1;
+    }
+    if max_records <= 0 {
+        let err = BoxliteError::InvalidArgument("max_records must be positive".to_string());
+        unsafe { write_error(out_error, err) };
+        return -1;
+    }
+    unsafe { *out_batch = ptr::null_mut() };
+
+    // See `drain_bounded`: never re-deref `rt` after this.
+    let queue = unsafe { (*rt).queue.clone() };
+    let deadline = drain_deadline(timeout_ms);
+    let (filled, buffers) =
+        unsafe { fill_records(&queue, deadline, records, max_records as usize) };
+
+    if !buffers.is_empty() {
+        unsafe { *out_batch = Box::into_raw(Box::new(EventBatch { buffers })) };
+    }
+    filled as c_int
+}
+
+/// Pop execution events into `records[..max_records]`, returning how many
+/// were filled and the buffers their `data` pointers reference. Moving a
+/// `Bytes` into `buffers` does not move its heap allocation, so the
+/// pointers stay valid.
+///
+/// Slots are written through the raw pointer: the caller's array may be
+/// uninitialized, so no reference to it is ever formed.
+unsafe fn fill_records(
+    queue: &EventQueue,
+    deadline: Option<Instant>,
+    records: *mut CEventRecord,
+    max_records: usize,
+) -> (usize, Vec<Bytes>) {
+    let mut filled = 0;
+    let mut buffers = Vec::new();
+    while filled < max_records && !queue.is_closed() {
+        let Some(event) = queue.try_pop() else {
+            if filled > 0 || !wait_for_event(queue, deadline) {
+                break;
+            }
+            continue;
+        };
+        let record = match event {
+            RuntimeEvent::Stdout {
+                user_data, data, ..
+            } => data_record(
+                BoxliteEventKind::BoxliteEventKindStdout,
+                user_data,
+                data,
+                &mut buffers,
+            ),
+            RuntimeEvent::Stderr {
+                user_data, data, ..
+            } => data_record(
+                BoxliteEventKind::BoxliteEventKindStderr,
+                user_data,
+                data,
+                &mut buffers,
+            ),
+            RuntimeEvent::Exit {
+                user_data,
+                exit_code,
+                ..
+            } => CEventRecord {
+                kind: BoxliteEventKind::BoxliteEventKindExit,
+                user_data: user_data as *mut c_void,
+                data: ptr::null(),
+                len: 0,
+                code: exit_code,
+            },
+            other if filled == 0 => {
+                // Nothing collected yet, so dispatching now cannot reorder it
+                // relative to any record.
+                unsafe { dispatch_timed(queue, other) };
+                continue;
+            }
+            other => {
+                // Leave it for the next drain; the caller must see the
+                // records ahead of it first.
+                queue.requeue_front(other);
+                break;
+            }
         };
+        unsafe { records.add(filled).write(record) };
+        filled += 1;
+    }
+    (filled, buffers)
+}
+
+fn data_record(
+    kind: BoxliteEventKind,
+    user_data: usize,
+    data: Bytes,
+    buffers: &mut Vec<Bytes>,
+) -> CEventRecord {
+    let record = CEventRecord {
+        kind,
+        user_data: user_data as *mut c_void,
+        data: data.as_ptr(),
+        len: data.len(),
+        code: 0,
+    };
+    buffers.push(data);
+    record
+}
 
-        // ─── Lock RELEASED — dispatch to user callback ───
-        unsafe { dispatch_event(event) };
-        count = count.saturating_add(1);
+unsafe fn event_batch_free(batch: *mut EventBatch) {
+    if !batch.is_null() {
+        unsafe { drop(Box::from_raw(batch)) };
     }
 }
 
+/// `dispatch_event`, with the callback's run time added to the queue stats.
+unsafe fn dispatch_timed(queue: &EventQueue, event: RuntimeEvent) {
+    let start = Instant::now();
+    unsafe { dispatch_event(event) };
+    queue.record_callback(start.elapsed());
+}
+
 unsafe fn dispatch_event(event: RuntimeEvent) {
     unsafe {
         match event {
+            // `credit` is left in `event` and dropped after the callback.
             RuntimeEvent::Stdout {
                 cb,
                 user_data,
                 data,
+                ..
             } => cb(data.as_ptr(), data.len(), user_data as *mut c_void),
             RuntimeEvent::Stderr {
                 cb,
                 user_data,
                 data,
+                ..
             } => cb(data.as_ptr(), data.len(), user_data as *mut c_void),
             RuntimeEvent::Exit {
                 cb,
@@ -509,11 +881,26 @@ unsafe fn dispatch_event(event: RuntimeEvent) {
                 user_data,
                 result,
             } => dispatch_unit_event(result, user_data, cb),
+            RuntimeEvent::CreateBoxes {
+                cb,
+                user_data,
+                result,
+            } => dispatch_handle_event::<crate::CBoxBatchCreateResult>(result, user_data, cb),
+            RuntimeEvent::BoxBatch {
+                cb,
+                user_data,
+                result,
+            } => dispatch_handle_event::<crate::CBoxBatchResult>(result, user_data, cb),
             RuntimeEvent::ImagePull {
                 cb,
                 user_data,
                 result,
             } => dispatch_handle_event::<crate::CImagePullResult>(result, user_data, cb),
+            RuntimeEvent::ImagePullProgress {
+                cb,
+                user_data,
+                progress,
+            } => cb(&progress, user_data as *mut c_void),
             RuntimeEvent::ImageList {
                 cb,
                 user_data,
@@ -524,6 +911,21 @@ unsafe fn dispatch_event(event: RuntimeEvent) {
                 user_data,
                 result,
             } => dispatch_unit_event(result, user_data, cb),
+            RuntimeEvent::CopyProgress {
+                cb,
+                user_data,
+                bytes,
+            } => cb(bytes, user_data as *mut c_void),
+            RuntimeEvent::CopyChunk {
+                cb,
+                user_data,
+                data,
+            } => cb(data.as_ptr(), data.len(), user_data as *mut c_void),
+            RuntimeEvent::CopyDone {
+                cb,
+                user_data,
+                result,
+            } => dispatch_unit_event(result, user_data, cb),
             RuntimeEvent::Info {
                 cb,
                 user_data,
@@ -534,11 +936,38 @@ unsafe fn dispatch_event(event: RuntimeEvent) {
                 user_data,
                 result,
             } => dispatch_handle_event::<crate::CBoxInfoList>(result, user_data, cb),
+            RuntimeEvent::InfoArena {
+                cb,
+                user_data,
+                result,
+            } => dispatch_handle_event::<crate::CBoxInfoArena>(result, user_data, cb),
             RuntimeEvent::Metrics {
                 cb,
                 user_data,
                 result,
             } => dispatch_value_event::<crate::CBoxMetrics>(result, user_data, cb),
+            RuntimeEvent::MemoryReclaim {
+                cb,
+                user_data,
+                result,
+            } => dispatch_value_event::<crate::CMemoryReclaimResult>(result, user_data, cb),
+            RuntimeEvent::InitTrace {
+                cb,
+                user_data,
+                result,
+            } => dispatch_handle_event::<crate::CInitTrace>(result, user_data, cb),
+            RuntimeEvent::MetricsBatch {
+                cb,
+                user_data,
+                cancelled,
+                in_flight,
+                result,
+            } => {
+                if !cancelled.load(Ordering::Acquire) {
+                    dispatch_metrics_batch_event(result, user_data, cb);
+                }
+                in_flight.store(false, Ordering::Release);
+            }
             RuntimeEvent::RtMetrics {
                 cb,
                 user_data,
@@ -656,6 +1085,31 @@ unsafe fn dispatch_get_or_create_event(
     }
 }
 
+/// Dispatch a metrics subscription tick. The batch is lent for the call and
+/// released with the event.
+unsafe fn dispatch_metrics_batch_event(
+    result: Result<crate::metrics::MetricsBatch, BoxliteError>,
+    user_data: usize,
+    cb: crate::event_queue::CBoxMetricsBatchFn,
+) {
+    unsafe {
+        let mut err = FFIError::default();
+        match result {
+            Ok(batch) => {
+                let view = batch.as_c();
+                cb(&view, &mut err as *mut _, user_data as *mut c_void);
+            }
+            Err(e) => {
+                err = crate::error::error_to_c_error(e);
+                cb(ptr::null(), &mut err as *mut _, user_data as *mut c_void);
+            }
+        }
+        if !err.message.is_null() {
+            crate::boxlite_error_free(&mut err);
+        }
+    }
+}
+
 /// Dispatch a "value-by-pointer + error" event for events whose success
 /// payload is a value-typed C struct (e.g. CBoxMetrics). Stack-allocates
 /// the value, hands a pointer to it to the callback, then drops it.
@@ -787,4 +1241,219 @@ mod tests {
             assert!(result.is_err());
         }
     }
+
+    // ─── Batched drain ───────────────────────────────────────────────────
+    //
+    // These drive `drain_queue` / `fill_records` against a bare `EventQueue`:
+    // the limits and record mapping are queue-level logic, and a deadline of
+    // "now" keeps every call non-blocking.
+
+    use std::sync::Mutex;
+    use std::sync::atomic::AtomicUsize;
+
+    static BATCH_STDOUT_CALLS: AtomicUsize = AtomicUsize::new(0);
+
+    extern "C" fn count_stdout_cb(_data: *const u8, _len: usize, _ud: *mut c_void) {
+        BATCH_STDOUT_CALLS.fetch_add(1, Ordering::SeqCst);
+    }
+
+    fn stdout_event(cb: crate::event_queue::CBoxStdoutFn, byte: u8) -> RuntimeEvent {
+        RuntimeEvent::Stdout {
+            cb,
+            user_data: 0x10,
+            data: vec![byte].into(),
+            credit: None,
+        }
+    }
+
+    #[test]
+    fn drain_batch_stops_at_max_events() {
+        let queue = EventQueue::new();
+        for i in 0..5 {
+            assert!(queue.try_push(stdout_event(count_stdout_cb, i)).is_ok());
+        }
+        BATCH_STDOUT_CALLS.store(0, Ordering::SeqCst);
+
+        let limits = DrainLimits {
+            max_events: Some(2),
+            budget: None,
+        };
+        let n = unsafe { drain_queue(&queue, Some(Instant::now()), limits) };
+
+        assert_eq!(n, 2);
+        assert_eq!(BATCH_STDOUT_CALLS.load(Ordering::SeqCst), 2);
+        assert_eq!(queue.len(), 3, "undispatched events stay queued");
+    }
+
+    #[test]
+    fn drain_records_maps_output_and_exit_without_callbacks() {
+        extern "C" fn must_not_run(_data: *const u8, _len: usize, _ud: *mut c_void) {
+            panic!("record drain must not invoke the stdout callback");
+        }
+        extern "C" fn exit_must_not_run(_code: c_int, _ud: *mut c_void) {
+            panic!("record drain must not invoke the exit callback");
+        }
+
+        let queue = EventQueue::new();
+        assert!(
+            queue
+                .try_push(RuntimeEvent::Stdout {
+                    cb: must_not_run,
+                    user_data: 0x10,
+                    data: Bytes::from_static(b"ab"),
+                    credit: None,
+                })
+                .is_ok()
+        );
+        assert!(
+            queue
+                .try_push(RuntimeEvent::Stderr {
+                    cb: must_not_run,
+                    user_data: 0x10,
+                    data: Bytes::from_static(b"c"),
+                    credit: None,
+                })
+                .is_ok()
+        );
+        assert!(
+            queue
+                .try_push(RuntimeEvent::Exit {
+                    cb: exit_must_not_run,
+                    user_data: 0x10,
+                    exit_code: 7,
+                })
+                .is_ok()
+        );
+
+        let empty = CEventRecord {
+            kind: BoxliteEventKind::BoxliteEventKindStdout,
+            user_data: ptr::null_mut(),
+            data: ptr::null(),
+            len: 0,
+            code: 0,
+        };
+        let mut slots = [empty; 8];
+        let (filled, buffers) = unsafe {
+            fill_records(
+                &queue,
+                Some(Instant::now()),
+                slots.as_mut_ptr(),
+                slots.len(),
+            )
+        };
+
+        assert_eq!(filled, 3);
+        assert_eq!(buffers.len(), 2);
+        let bytes =
+            |r: &CEventRecord| unsafe { std::slice::from_raw_parts(r.data, r.len) }.to_vec();
+        assert_eq!(slots[0].kind, BoxliteEventKind::BoxliteEventKindStdout);
+        assert_eq!(bytes(&slots[0]), b"ab");
+        assert_eq!(slots[1].kind, BoxliteEventKind::BoxliteEventKindStderr);
+        assert_eq!(bytes(&slots[1]), b"c");
+        assert_eq!(slots[2].kind, BoxliteEventKind::BoxliteEventKindExit);
+        assert_eq!(slots[2].code, 7);
+        assert!(slots[2].data.is_null());
+        assert!(slots.iter().take(3).all(|r| r.user_data as usize == 0x10));
+    }
+
+    /// A lifecycle event travels in the control lane, so it is not stuck
+    /// behind queued output: the record drain dispatches it before
+    /// collecting the records.
+    #[test]
+    fn drain_records_dispatches_lifecycle_event_ahead_of_records() {
+        static ORDER: Mutex<Vec<&'static str>> = Mutex::new(Vec::new());
+        extern "C" fn stdout_cb(_data: *const u8, _len: usize, _ud: *mut c_void) {
+            ORDER.lock().unwrap().push("stdout");
+        }
+        extern "C" fn start_cb(_err: *mut CBoxliteError, _ud: *mut c_void) {
+            ORDER.lock().unwrap().push("start");
+        }
+
+        let queue = EventQueue::new();
+        assert!(queue.try_push(stdout_event(stdout_cb, 1)).is_ok());
+        assert!(
+            queue
+                .try_push(RuntimeEvent::StartBox {
+                    cb: start_cb,
+                    user_data: 0,
+                    result: Ok(()),
+                })
+                .is_ok()
+        );
+        assert!(queue.try_push(stdout_event(stdout_cb, 2)).is_ok());
+
+        let empty = CEventRecord {
+            kind: BoxliteEventKind::BoxliteEventKindStdout,
+            user_data: ptr::null_mut(),
+            data: ptr::null(),
+            len: 0,
+            code: 0,
+        };
+        let mut slots = [empty; 8];
+        let (filled, _buffers) = unsafe {
+            fill_records(
+                &queue,
+                Some(Instant::now()),
+                slots.as_mut_ptr(),
+                slots.len(),
+            )
+        };
+        assert_eq!(filled, 2);
+        assert!(queue.is_empty());
+        assert_eq!(*ORDER.lock().unwrap(), vec!["start"]);
+        let bytes =
+            |r: &CEventRecord| unsafe { std::slice::from_raw_parts(r.data, r.len) }.to_vec();
+        assert_eq!(bytes(&slots[0]), [1]);
+        assert_eq!(bytes(&slots[1]), [2]);
+    }
+
+    /// A lifecycle event that arrives once records are being collected is
+    /// left for the next drain instead of being dispatched mid-batch.
+    #[test]
+    fn drain_records_requeues_lifecycle_event_after_records() {
+        static STARTS: AtomicUsize = AtomicUsize::new(0);
+        extern "C" fn start_cb(_err: *mut CBoxliteError, _ud: *mut c_void) {
+            STARTS.fetch_add(1, Ordering::SeqCst);
+        }
+        extern "C" fn stdout_cb(_data: *const u8, _len: usize, _ud: *mut c_void) {}
+
+        let queue = EventQueue::new();
+        assert!(queue.try_push(stdout_event(stdout_cb, 1)).is_ok());
+        // Collect the stdout event, then let the StartBox land.
+        let ev = queue.try_pop().expect("stdout event");
+        assert!(
+            queue
+                .try_push(RuntimeEvent::StartBox {
+                    cb: start_cb,
+                    user_data: 0,
+                    result: Ok(()),
+                })
+                .is_ok()
+        );
+        queue.requeue_front(ev);
+
+        let empty = CEventRecord {
+            kind: BoxliteEventKind::BoxliteEventKindStdout,
+            user_data: ptr::null_mut(),
+            data: ptr::null(),
+            len: 0,
+            code: 0,
+        };
+        let mut slots = [empty; 8];
+        let (filled, _buffers) = unsafe {
+            fill_records(
+                &queue,
+                Some(Instant::now()),
+                slots.as_mut_ptr(),
+                slots.len(),
+            )
+        };
+        assert_eq!(filled, 1, "batch ends at the lifecycle event");
+        assert_eq!(queue.len(), 1);
+        assert_eq!(STARTS.load(Ordering::SeqCst), 0);
+
+        let n = unsafe { drain_queue(&queue, Some(Instant::now()), DrainLimits::default()) };
+        assert_eq!(n, 1);
+        assert_eq!(STARTS.load(Ordering::SeqCst), 1);
+    }
 }
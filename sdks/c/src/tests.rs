@@ -206,14 +206,19 @@ fn test_free_functions_null_safe() {
         boxlite_free_string(ptr::null_mut());
         boxlite_error_free(ptr::null_mut());
         boxlite_result_free(ptr::null_mut());
+        boxlite_capture_result_free(ptr::null_mut());
         boxlite_simple_free(ptr::null_mut());
         boxlite_execution_free(ptr::null_mut());
+        boxlite_free_box_batch_create_result(ptr::null_mut());
+        boxlite_free_box_batch_result(ptr::null_mut());
     }
 }
 
 #[test]
 fn test_runtime_images_unsupported_on_rest_runtime() {
-    let tokio_rt = crate::runtime::create_tokio_runtime().expect("create tokio runtime");
+    let tokio_rt = crate::executor::ExecutorConfig::default()
+        .runtime()
+        .expect("create tokio runtime");
     let runtime = BoxliteRuntime::rest(boxlite::BoxliteRestOptions::new("http://localhost:1"))
         .expect("create rest runtime");
     let mut runtime_handle = crate::runtime::RuntimeHandle {
@@ -284,6 +289,59 @@ fn test_runtime_images_rejected_after_shutdown() {
     let _ = std::fs::remove_dir_all(home_dir);
 }
 
+#[test]
+fn test_simple_new_in_rejected_after_shutdown() {
+    let (runtime, home_dir) = unsafe { new_test_runtime_handle("simple-in-shutdown") };
+    let mut error = FFIError::default();
+    let mut runner: *mut CBoxliteSimple = ptr::null_mut();
+    let image = CString::new("alpine:latest").expect("image cstring");
+
+    let code = unsafe {
+        boxlite_simple_new_in(
+            ptr::null_mut(),
+            image.as_ptr(),
+            0,
+            0,
+            &mut runner as *mut _,
+            &mut error as *mut _,
+        )
+    };
+    assert_eq!(code, BoxliteErrorCode::InvalidArgument);
+    unsafe { boxlite_error_free(&mut error as *mut _) };
+
+    let shutdown_code = unsafe {
+        boxlite_runtime_shutdown(
+            runtime,
+            0,
+            Some(noop_shutdown_cb),
+            ptr::null_mut(),
+            &mut error as *mut _,
+        )
+    };
+    assert_eq!(shutdown_code, BoxliteErrorCode::Ok);
+    let _ = unsafe { boxlite_runtime_drain(runtime, 1000, &mut error as *mut _) };
+    unsafe { boxlite_error_free(&mut error as *mut _) };
+
+    let code = unsafe {
+        boxlite_simple_new_in(
+            runtime,
+            image.as_ptr(),
+            0,
+            0,
+            &mut runner as *mut _,
+            &mut error as *mut _,
+        )
+    };
+    assert_eq!(code, BoxliteErrorCode::Stopped);
+    assert!(runner.is_null());
+
+    unsafe {
+        boxlite_error_free(&mut error as *mut _);
+        boxlite_runtime_free(runtime);
+    }
+    let _ = std::fs::remove_dir_all(home_dir);
+}
+
 #[test]
 fn test_image_pull_rejected_after_boxlite_runtime_free() {
     let (runtime, home_dir) = unsafe { new_test_runtime_handle("images-free") };
@@ -376,6 +434,67 @@ fn create_box_rejects_null_callback() {
     let _ = std::fs::remove_dir_all(home_dir);
 }
 
+#[test]
+fn batch_lifecycle_rejects_null_callback() {
+    let (runtime, home_dir) = unsafe { new_test_runtime_handle("null-cb-batch") };
+
+    let image = CString::new("alpine:latest").expect("image cstring");
+    let mut opts: *mut CBoxliteOptions = ptr::null_mut();
+    let mut error = FFIError::default();
+    let opts_code =
+        unsafe { boxlite_options_new(image.as_ptr(), &mut opts as *mut _, &mut error as *mut _) };
+    assert_eq!(opts_code, BoxliteErrorCode::Ok);
+
+    let code = unsafe {
+        boxlite_create_boxes(
+            runtime,
+            &opts as *const _,
+            1,
+            0,
+            None,
+            ptr::null_mut(),
+            &mut error as *mut _,
+        )
+    };
+    assert_null_cb_rejected(code, &mut error);
+
+    let id = CString::new("missing").expect("id cstring");
+    let ids = [id.as_ptr()];
+    let code = unsafe {
+        boxlite_remove_boxes(
+            runtime,
+            ids.as_ptr(),
+            1,
+            0,
+            0,
+            None,
+            ptr::null_mut(),
+            &mut error as *mut _,
+        )
+    };
+    assert_null_cb_rejected(code, &mut error);
+
+    let code = unsafe {
+        boxlite_start_boxes(
+            runtime,
+            ptr::null(),
+            0,
+            0,
+            None,
+            ptr::null_mut(),
+            &mut error as *mut _,
+        )
+    };
+    assert_null_cb_rejected(code, &mut error);
+
+    // Nothing is consumed on an argument error.
+    unsafe {
+        boxlite_options_free(opts);
+        boxlite_runtime_free(runtime);
+    }
+    let _ = std::fs::remove_dir_all(home_dir);
+}
+
 // Security is toggled through the advanced layer:
 // `boxlite_advanced_options_set_security_enabled` selects the enabled/disabled
 // profile on a `CAdvancedBoxOptions`, then `boxlite_options_set_advanced`
@@ -445,6 +564,75 @@ fn list_info_rejects_null_callback() {
     let _ = std::fs::remove_dir_all(home_dir);
 }
 
+#[test]
+fn list_info_filtered_and_arena_reject_null_callback() {
+    let (runtime, home_dir) = unsafe { new_test_runtime_handle("null-cb-listfilter") };
+    let mut error = FFIError::default();
+    let code = unsafe {
+        boxlite_list_info_filtered(
+            runtime,
+            ptr::null(),
+            None,
+            ptr::null_mut(),
+            &mut error as *mut _,
+        )
+    };
+    assert_null_cb_rejected(code, &mut error);
+    let code = unsafe {
+        boxlite_list_info_arena(
+            runtime,
+            ptr::null(),
+            None,
+            ptr::null_mut(),
+            &mut error as *mut _,
+        )
+    };
+    assert_null_cb_rejected(code, &mut error);
+    unsafe { boxlite_runtime_free(runtime) };
+    let _ = std::fs::remove_dir_all(home_dir);
+}
+
+#[test]
+fn list_filter_setters_build_core_filter() {
+    let mut filter: *mut CBoxliteListFilter = ptr::null_mut();
+    let mut error = FFIError::default();
+    let code = unsafe { boxlite_list_filter_new(&mut filter, &mut error) };
+    assert_eq!(code, BoxliteErrorCode::Ok);
+
+    let running = CString::new("running").unwrap();
+    let bogus = CString::new("sleeping").unwrap();
+    let prefix = CString::new("web-").unwrap();
+    let (key, value) = (
+        CString::new("tier").unwrap(),
+        CString::new("front").unwrap(),
+    );
+    unsafe {
+        assert_eq!(
+            boxlite_list_filter_add_status(filter, running.as_ptr(), &mut error),
+            BoxliteErrorCode::Ok
+        );
+        assert_eq!(
+            boxlite_list_filter_add_status(filter, bogus.as_ptr(), &mut error),
+            BoxliteErrorCode::InvalidArgument
+        );
+        boxlite_error_free(&mut error);
+        boxlite_list_filter_set_name_prefix(filter, prefix.as_ptr());
+        assert_eq!(
+            boxlite_list_filter_add_label(filter, key.as_ptr(), value.as_ptr(), &mut error),
+            BoxliteErrorCode::Ok
+        );
+        boxlite_list_filter_set_page(filter, -5, 50);
+
+        let core = &(*filter).filter;
+        assert_eq!(core.statuses, vec![boxlite::BoxStatus::Running]);
+        assert_eq!(core.name_prefix.as_deref(), Some("web-"));
+        assert_eq!(core.labels, vec![("tier".to_string(), "front".to_string())]);
+        assert_eq!((core.offset, core.limit), (0, Some(50)));
+
+        boxlite_list_filter_free(filter);
+    }
+}
+
 #[test]
 fn shutdown_rejects_null_callback() {
     let (runtime, home_dir) = unsafe { new_test_runtime_handle("null-cb-shutdown") };
@@ -556,3 +744,248 @@ fn add_port_rejects_zero_guest_port_and_null_options() {
     assert!(ports.is_empty(), "rejected spec must not be stored");
     unsafe { boxlite_options_free(opts) };
 }
+
+extern "C" fn noop_metrics_batch_cb(
+    _batch: *const CBoxMetricsBatch,
+    _err: *mut FFIError,
+    _ud: *mut c_void,
+) {
+}
+
+static METRICS_BATCHES: std::sync::atomic::AtomicUsize = std::sync::atomic::AtomicUsize::new(0);
+
+extern "C" fn count_metrics_batch_cb(
+    batch: *const CBoxMetricsBatch,
+    _err: *mut FFIError,
+    _ud: *mut c_void,
+) {
+    if !batch.is_null() {
+        METRICS_BATCHES.fetch_add(1, std::sync::atomic::Ordering::SeqCst);
+    }
+}
+
+#[test]
+fn subscribe_metrics_rejects_null_callback_and_zero_interval() {
+    let (runtime, home_dir) = unsafe { new_test_runtime_handle("metrics-sub-args") };
+    let mut subscription: *mut CMetricsSubscription = ptr::null_mut();
+    let mut error = FFIError::default();
+
+    let code = unsafe {
+        boxlite_runtime_subscribe_metrics(
+            runtime,
+            1000,
+            None,
+            ptr::null_mut(),
+            &mut subscription as *mut _,
+            &mut error as *mut _,
+        )
+    };
+    assert_null_cb_rejected(code, &mut error);
+
+    let code = unsafe {
+        boxlite_runtime_subscribe_metrics(
+            runtime,
+            0,
+            Some(noop_metrics_batch_cb),
+            ptr::null_mut(),
+            &mut subscription as *mut _,
+            &mut error as *mut _,
+        )
+    };
+    assert_eq!(code, BoxliteErrorCode::InvalidArgument);
+    assert!(subscription.is_null());
+    unsafe {
+        boxlite_error_free(&mut error as *mut _);
+        boxlite_runtime_free(runtime);
+    }
+    let _ = std::fs::remove_dir_all(home_dir);
+}
+
+#[test]
+fn queue_stats_fill_only_the_callers_struct_size() {
+    use std::mem::{offset_of, size_of};
+
+    let tokio_rt = crate::executor::ExecutorConfig::default()
+        .runtime()
+        .expect("create tokio runtime");
+    let runtime = BoxliteRuntime::rest(boxlite::BoxliteRestOptions::new("http://localhost:1"))
+        .expect("create rest runtime");
+    let mut runtime_handle = crate::runtime::RuntimeHandle {
+        runtime,
+        tokio_rt,
+        liveness: Arc::new(crate::runtime::RuntimeLiveness::new()),
+        queue: Arc::new(crate::event_queue::EventQueue::new()),
+    };
+    let mut error = FFIError::default();
+
+    // A caller whose header ends after `capacity`.
+    let old_size = offset_of!(CQueueStats, producer_yields);
+    let mut buf = vec![0xAAu8; size_of::<CQueueStats>()];
+    buf[..4].copy_from_slice(&(old_size as u32).to_ne_bytes());
+    let code = unsafe {
+        boxlite_runtime_queue_stats(
+            &mut runtime_handle as *mut _,
+            buf.as_mut_ptr() as *mut CQueueStats,
+            &mut error as *mut _,
+        )
+    };
+    assert_eq!(code, BoxliteErrorCode::Ok);
+    assert_eq!(
+        u32::from_ne_bytes(buf[..4].try_into().unwrap()),
+        old_size as u32
+    );
+    let capacity = offset_of!(CQueueStats, capacity);
+    assert_eq!(
+        u64::from_ne_bytes(buf[capacity..capacity + 8].try_into().unwrap()),
+        runtime_handle.queue.stats().capacity as u64
+    );
+    assert!(buf[old_size..].iter().all(|&b| b == 0xAA));
+
+    // A caller that left `struct_size` unset.
+    let mut stats = unsafe { std::mem::zeroed::<CQueueStats>() };
+    let code = unsafe {
+        boxlite_runtime_queue_stats(
+            &mut runtime_handle as *mut _,
+            &mut stats as *mut _,
+            &mut error as *mut _,
+        )
+    };
+    assert_eq!(code, BoxliteErrorCode::InvalidArgument);
+    unsafe { boxlite_error_free(&mut error as *mut _) };
+}
+
+#[test]
+fn subscribe_metrics_unsupported_on_rest_runtime() {
+    let tokio_rt = crate::executor::ExecutorConfig::default()
+        .runtime()
+        .expect("create tokio runtime");
+    let runtime = BoxliteRuntime::rest(boxlite::BoxliteRestOptions::new("http://localhost:1"))
+        .expect("create rest runtime");
+    let mut runtime_handle = crate::runtime::RuntimeHandle {
+        runtime,
+        tokio_rt,
+        liveness: Arc::new(crate::runtime::RuntimeLiveness::new()),
+        queue: Arc::new(crate::event_queue::EventQueue::new()),
+    };
+    let mut subscription: *mut CMetricsSubscription = ptr::null_mut();
+    let mut error = FFIError::default();
+
+    let code = unsafe {
+        boxlite_runtime_subscribe_metrics(
+            &mut runtime_handle as *mut _,
+            1000,
+            Some(noop_metrics_batch_cb),
+            ptr::null_mut(),
+            &mut subscription as *mut _,
+            &mut error as *mut _,
+        )
+    };
+
+    assert_eq!(code, BoxliteErrorCode::Unsupported);
+    assert!(subscription.is_null());
+    unsafe { boxlite_error_free(&mut error as *mut _) };
+}
+
+#[test]
+fn subscribe_metrics_delivers_batches_until_freed() {
+    use std::sync::atomic::Ordering;
+
+    let (runtime, home_dir) = unsafe { new_test_runtime_handle("metrics-sub-ticks") };
+    let mut subscription: *mut CMetricsSubscription = ptr::null_mut();
+    let mut error = FFIError::default();
+
+    let code = unsafe {
+        boxlite_runtime_subscribe_metrics(
+            runtime,
+            10,
+            Some(count_metrics_batch_cb),
+            ptr::null_mut(),
+            &mut subscription as *mut _,
+            &mut error as *mut _,
+        )
+    };
+    assert_eq!(code, BoxliteErrorCode::Ok);
+    assert!(!subscription.is_null());
+
+    for _ in 0..50 {
+        if METRICS_BATCHES.load(Ordering::SeqCst) >= 2 {
+            break;
+        }
+        let _ = unsafe { boxlite_runtime_drain(runtime, 100, &mut error as *mut _) };
+    }
+    assert!(METRICS_BATCHES.load(Ordering::SeqCst) >= 2);
+
+    unsafe { boxlite_metrics_subscription_free(subscription) };
+    let delivered = METRICS_BATCHES.load(Ordering::SeqCst);
+    std::thread::sleep(std::time::Duration::from_millis(50));
+    let _ = unsafe { boxlite_runtime_drain(runtime, 0, &mut error as *mut _) };
+    assert_eq!(METRICS_BATCHES.load(Ordering::SeqCst), delivered);
+
+    unsafe { boxlite_runtime_free(runtime) };
+    let _ = std::fs::remove_dir_all(home_dir);
+}
+
+#[test]
+fn metrics_batch_addresses_box_ids_by_offset() {
+    let samples = vec![
+        boxlite::BoxMetricsSample {
+            box_id: boxlite::BoxID::parse("box-a").expect("valid id"),
+            cpu_percent: Some(12.5),
+            cpu_usage_usec: Some(7),
+            memory_bytes: None,
+        },
+        boxlite::BoxMetricsSample {
+            box_id: boxlite::BoxID::parse("box-b").expect("valid id"),
+            cpu_percent: None,
+            cpu_usage_usec: None,
+            memory_bytes: Some(4096),
+        },
+    ];
+    let batch = crate::metrics::MetricsBatch::from_samples(&samples);
+    let view = batch.as_c();
+    assert_eq!(view.count, 2);
+
+    let rows = unsafe { std::slice::from_raw_parts(view.samples, view.count as usize) };
+    let id = |row: &CBoxMetricsSample| unsafe {
+        CStr::from_ptr(view.strings.add(row.box_id as usize))
+            .to_str()
+            .unwrap()
+            .to_string()
+    };
+    assert_eq!(id(&rows[0]), "box-a");
+    assert_eq!(id(&rows[1]), "box-b");
+    assert_eq!(rows[0].cpu_percent, 12.5);
+    assert_eq!(rows[0].cpu_usage_usec, 7);
+    assert_eq!(rows[0].memory_bytes, -1);
+    assert_eq!(rows[1].cpu_percent, -1.0);
+    assert_eq!(rows[1].cpu_usage_usec, -1);
+    assert_eq!(rows[1].memory_bytes, 4096);
+}
+
+#[test]
+fn test_metrics_structs_keep_their_original_prefix() {
+    use std::mem::offset_of;
+
+    // Callers built against headers from before `struct_size` read these
+    // offsets; new fields may only follow them.
+    assert_eq!(offset_of!(CBoxMetrics, cpu_percent), 0);
+    assert_eq!(offset_of!(CBoxMetrics, commands_executed), 16);
+    assert_eq!(offset_of!(CBoxMetrics, bytes_sent), 24);
+    assert_eq!(offset_of!(CBoxMetrics, network_tcp_errors), 76);
+    assert_eq!(offset_of!(CBoxMetrics, struct_size), 80);
+
+    assert_eq!(offset_of!(CRuntimeMetrics, boxes_created_total), 0);
+    assert_eq!(offset_of!(CRuntimeMetrics, warm_pool_refills), 36);
+    assert_eq!(offset_of!(CRuntimeMetrics, struct_size), 40);
+}
+
+#[test]
+#[cfg(target_pointer_width = "64")]
+fn test_boxlite_command_keeps_its_original_layout() {
+    use std::mem::{offset_of, size_of};
+
+    // Callers allocate BoxliteCommand themselves, so it must not grow;
+    // output pacing travels in BoxliteOutputPacing instead.
+    assert_eq!(offset_of!(BoxliteCommand, tty), 64);
+    assert_eq!(size_of::<BoxliteCommand>(), 72);
+}
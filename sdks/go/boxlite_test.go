@@ -366,6 +366,22 @@ func TestRuntimeOptions(t *testing.T) {
 	}
 }
 
+func TestWithExecutor(t *testing.T) {
+	node := 1
+	cfg := &runtimeConfig{}
+	WithExecutor(ExecutorOptions{WorkerThreads: 4, CPUs: []int{0, 1}, NUMANode: &node, Shared: true})(cfg)
+
+	if cfg.executor == nil {
+		t.Fatal("executor: got nil")
+	}
+	if cfg.executor.WorkerThreads != 4 || !cfg.executor.Shared {
+		t.Errorf("executor: got %+v", *cfg.executor)
+	}
+	if len(cfg.executor.CPUs) != 2 || *cfg.executor.NUMANode != 1 {
+		t.Errorf("executor placement: got %+v", *cfg.executor)
+	}
+}
+
 func TestToCImageRegistryArray(t *testing.T) {
 	password := testRegistryPassword()
 	token := testBearerToken()
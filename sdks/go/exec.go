@@ -69,6 +69,19 @@ type ExecutionOptions struct {
 	// means no timeout (the C side treats `timeout_secs <= 0` as
 	// unbounded — see `sdks/c/src/exec/command.rs`).
 	Timeout time.Duration
+	// CoalesceBytes merges consecutive small output chunks into one
+	// OnStdout/OnStderr delivery of at least this many bytes. Zero
+	// delivers every chunk as the guest produced it.
+	CoalesceBytes int
+	// CoalesceWindow is how long a partially filled chunk may wait for
+	// more output before it is delivered. Zero merges only output that
+	// is already buffered. Ignored when CoalesceBytes is zero.
+	CoalesceWindow time.Duration
+	// OutputCredits bounds how many output deliveries of this execution
+	// may be queued ahead of the drain loop; when they run out the
+	// execution's output is held back instead of crowding out other
+	// executions. Zero means unlimited.
+	OutputCredits int
 }
 
 // executionStreamState holds the user-provided sinks for streaming output
@@ -205,7 +218,7 @@ func (b *Box) Exec(ctx context.Context, name string, arg ...string) (*ExecResult
 
 // StartExecution starts a command and returns a streaming execution handle.
 //
-// boxlite_box_exec is synchronous on the C side; once it returns, we
+// boxlite_box_exec_paced is synchronous on the C side; once it returns, we
 // register stream callbacks (which post events into the runtime queue).
 func (b *Box) StartExecution(_ context.Context, name string, args []string, opts *ExecutionOptions) (*Execution, error) {
 	b.runtime.ensureDrainRunning()
@@ -241,10 +254,15 @@ func (b *Box) StartExecution(_ context.Context, name string, args []string, opts
 		timeout_secs: C.double(cfg.Timeout.Seconds()),
 		tty:          boolToCInt(cfg.TTY),
 	}
+	cPacing := C.BoxliteOutputPacing{
+		coalesce_bytes: C.int(cfg.CoalesceBytes),
+		coalesce_ms:    C.int(cfg.CoalesceWindow.Milliseconds()),
+		output_credits: C.int(cfg.OutputCredits),
+	}
 
 	var handle *C.CExecutionHandle
 	var cerr C.CBoxliteError
-	code := C.boxlite_box_exec(b.handle, &cCommand, &handle, &cerr)
+	code := C.boxlite_box_exec_paced(b.handle, &cCommand, &cPacing, &handle, &cerr)
 	if code != C.Ok {
 		return nil, freeError(&cerr)
 	}
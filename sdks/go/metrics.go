@@ -16,6 +16,16 @@ type RuntimeMetrics struct {
 	RunningBoxes          int
 	TotalCommandsExecuted int
 	TotalExecErrors       int
+	// WarmPoolSize is how many boxes the warm pool keeps started (0 = no pool).
+	WarmPoolSize int
+	// WarmPoolReady is how many pooled boxes are ready to be claimed.
+	WarmPoolReady int
+	// WarmPoolHits counts creates served from the pool.
+	WarmPoolHits int
+	// WarmPoolMisses counts creates matching the pool that found it empty.
+	WarmPoolMisses int
+	// WarmPoolRefills counts boxes booted into the pool.
+	WarmPoolRefills int
 }
 
 // BoxMetrics holds per-box metrics.
@@ -118,5 +128,10 @@ func cRuntimeMetricsToGo(cm *C.CRuntimeMetrics) RuntimeMetrics {
 		RunningBoxes:          int(cm.num_running_boxes),
 		TotalCommandsExecuted: int(cm.total_commands_executed),
 		TotalExecErrors:       int(cm.total_exec_errors),
+		WarmPoolSize:          int(cm.warm_pool_size),
+		WarmPoolReady:         int(cm.warm_pool_ready),
+		WarmPoolHits:          int(cm.warm_pool_hits),
+		WarmPoolMisses:        int(cm.warm_pool_misses),
+		WarmPoolRefills:       int(cm.warm_pool_refills),
 	}
 }
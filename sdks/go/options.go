@@ -18,6 +18,7 @@ type RuntimeOption func(*runtimeConfig)
 type runtimeConfig struct {
 	homeDir         string
 	imageRegistries []ImageRegistry
+	executor        *ExecutorOptions
 }
 
 // RegistryTransport selects the transport used to contact an OCI registry.
@@ -59,6 +60,81 @@ func WithImageRegistries(registries ...ImageRegistry) RuntimeOption {
 	return func(c *runtimeConfig) { c.imageRegistries = append(c.imageRegistries, registries...) }
 }
 
+// ExecutorOptions sizes and places the threads that drive a runtime's
+// async work. The zero value is the default: a private pool with one
+// worker per CPU, unpinned.
+type ExecutorOptions struct {
+	// WorkerThreads is the worker pool size. 0 = one per CPU, or one per
+	// pinned CPU when CPUs or NUMANode is set.
+	WorkerThreads int
+	// MaxBlockingThreads caps the pool used for file I/O and other
+	// blocking work. 0 = library default.
+	MaxBlockingThreads int
+	// ThreadName names every runtime thread (as shown by top -H and
+	// profilers). Empty = library default.
+	ThreadName string
+	// SingleThread runs all async work on one dedicated worker thread,
+	// overriding WorkerThreads.
+	SingleThread bool
+	// CPUs pins every runtime thread to these CPUs. Linux only.
+	CPUs []int
+	// NUMANode pins every runtime thread to the CPUs of this NUMA node,
+	// intersected with CPUs. Nil = no NUMA placement. Linux only.
+	NUMANode *int
+	// Shared makes runtimes created with equal ExecutorOptions run on one
+	// pool, which stays up until the last of them is closed.
+	Shared bool
+}
+
+// WithExecutor configures the threads that drive the runtime.
+func WithExecutor(executor ExecutorOptions) RuntimeOption {
+	return func(c *runtimeConfig) { c.executor = &executor }
+}
+
+// toCExecutorOptions builds C executor options. A nil executor returns a
+// nil handle, which the C API treats as the defaults. The returned
+// function frees the handle.
+func toCExecutorOptions(executor *ExecutorOptions) (*C.CBoxliteExecutorOptions, func(), error) {
+	if executor == nil {
+		return nil, func() {}, nil
+	}
+
+	var cerr C.CBoxliteError
+	var cOpts *C.CBoxliteExecutorOptions
+	if code := C.boxlite_executor_options_new(&cOpts, &cerr); code != C.Ok {
+		return nil, nil, freeError(&cerr)
+	}
+	free := func() { C.boxlite_executor_options_free(cOpts) }
+
+	C.boxlite_executor_options_set_worker_threads(cOpts, C.int(executor.WorkerThreads))
+	C.boxlite_executor_options_set_max_blocking_threads(cOpts, C.int(executor.MaxBlockingThreads))
+	if executor.ThreadName != "" {
+		cName := toCString(executor.ThreadName)
+		defer C.free(unsafe.Pointer(cName))
+		C.boxlite_executor_options_set_thread_name(cOpts, cName)
+	}
+	C.boxlite_executor_options_set_single_thread(cOpts, boolToCInt(executor.SingleThread))
+	C.boxlite_executor_options_set_shared(cOpts, boolToCInt(executor.Shared))
+	if executor.NUMANode != nil {
+		if *executor.NUMANode < 0 {
+			free()
+			return nil, nil, fmt.Errorf("boxlite: invalid NUMA node %d", *executor.NUMANode)
+		}
+		C.boxlite_executor_options_set_numa_node(cOpts, C.int(*executor.NUMANode))
+	}
+	if len(executor.CPUs) > 0 {
+		cCPUs := make([]C.int, len(executor.CPUs))
+		for i, cpu := range executor.CPUs {
+			cCPUs[i] = C.int(cpu)
+		}
+		if code := C.boxlite_executor_options_set_cpu_affinity(cOpts, &cCPUs[0], C.int(len(cCPUs))); code != C.Ok {
+			free()
+			return nil, nil, fmt.Errorf("boxlite: invalid CPU affinity %v", executor.CPUs)
+		}
+	}
+	return cOpts, free, nil
+}
+
 // BoxOption configures a Box.
 type BoxOption func(*boxConfig)
 
@@ -187,6 +263,9 @@ type boxConfig struct {
 	network    *NetworkSpec
 	secrets    []Secret
 	advanced   *AdvancedBoxOptions // nil = runtime defaults; non-nil = caller-owned advanced opts applied via boxlite_options_set_advanced
+	// startSource/startSnapshot: start Create from this box's snapshot instead of the image.
+	startSource   string
+	startSnapshot string
 }
 
 type volumeEntry struct {
@@ -200,6 +279,18 @@ func WithName(name string) BoxOption {
 	return func(c *boxConfig) { c.name = name }
 }
 
+// WithStartSnapshot makes Create start the box from the named snapshot of
+// box source (ID or name) instead of the image. The new box's disk is a
+// copy-on-write child of the snapshot shared by every box started from
+// it, and the image passed to Create is replaced by the source box's.
+// GetOrCreate ignores this option.
+func WithStartSnapshot(source, snapshot string) BoxOption {
+	return func(c *boxConfig) {
+		c.startSource = source
+		c.startSnapshot = snapshot
+	}
+}
+
 // WithCPUs sets the number of virtual CPUs.
 func WithCPUs(n int) BoxOption {
 	return func(c *boxConfig) { c.cpus = n }
@@ -487,6 +578,13 @@ func buildCOptions(image string, cfg *boxConfig) (*C.CBoxliteOptions, error) {
 		C.boxlite_options_set_cmd(cOpts, cArgs, C.int(argc))
 		freeCStringArray(cArgs, argc)
 	}
+	if cfg.startSource != "" && cfg.startSnapshot != "" {
+		cSource := toCString(cfg.startSource)
+		cSnapshot := toCString(cfg.startSnapshot)
+		C.boxlite_options_set_start_snapshot(cOpts, cSource, cSnapshot)
+		C.free(unsafe.Pointer(cSource))
+		C.free(unsafe.Pointer(cSnapshot))
+	}
 
 	return cOpts, nil
 }
@@ -32,6 +32,10 @@ type BoxliteRestOptions struct {
 	// segment entirely (/v1/boxes/...) — the single-tenant
 	// deployment shape.
 	PathPrefix string
+
+	// Executor configures the threads that drive the runtime. Nil =
+	// defaults.
+	Executor *ExecutorOptions
 }
 
 // NewRest creates a runtime that connects to a remote BoxLite REST
@@ -85,6 +89,15 @@ func NewRest(opts BoxliteRestOptions) (*Runtime, error) {
 		C.boxlite_rest_options_set_path_prefix(cOpts, cPathPrefix)
 	}
 
+	if opts.Executor != nil {
+		cExecutor, freeExecutor, err := toCExecutorOptions(opts.Executor)
+		if err != nil {
+			return nil, err
+		}
+		defer freeExecutor()
+		C.boxlite_rest_options_set_executor(cOpts, cExecutor)
+	}
+
 	var handle *C.CBoxliteRuntime
 	if code := C.boxlite_rest_runtime_new_with_options(cOpts, &handle, &cerr); code != C.Ok {
 		return nil, freeError(&cerr)
@@ -8,6 +8,7 @@ package boxlite
 import "C"
 import (
 	"context"
+	"fmt"
 	"runtime/cgo"
 	"sync"
 	"time"
@@ -24,6 +25,10 @@ func Version() string {
 // no events are flowing.
 const drainTimeoutMs = 100
 
+// drainBatchSize is the number of execution output records collected per
+// boxlite_runtime_drain_records call, i.e. per cgo crossing.
+const drainBatchSize = 256
+
 // Runtime manages BoxLite boxes. Create one with NewRuntime.
 type Runtime struct {
 	handle *C.CBoxliteRuntime
@@ -60,12 +65,19 @@ func NewRuntime(opts ...RuntimeOption) (*Runtime, error) {
 	}
 	defer freeImageRegistries()
 
+	cExecutor, freeExecutor, err := toCExecutorOptions(cfg.executor)
+	if err != nil {
+		return nil, err
+	}
+	defer freeExecutor()
+
 	var handle *C.CBoxliteRuntime
 	var cerr C.CBoxliteError
-	code := C.boxlite_runtime_new(
+	code := C.boxlite_runtime_new_with_executor(
 		homeDir,
 		cImageRegistries,
 		C.int(imageRegistriesCount),
+		cExecutor,
 		&handle,
 		&cerr,
 	)
@@ -182,6 +194,35 @@ func (r *Runtime) Create(ctx context.Context, image string, opts ...BoxOption) (
 	}
 }
 
+// SetWarmPool keeps size boxes of image, configured by opts, started in the
+// background. A later unnamed Create with the same image and options takes
+// one of them instead of booting a VM, and the pool refills behind it. Any
+// WithName option is ignored. A size of 0 disables the pool.
+//
+// The options must keep auto-remove on and detach off. Pool counters are
+// reported by Metrics.
+func (r *Runtime) SetWarmPool(image string, size int, opts ...BoxOption) error {
+	if size < 0 {
+		return fmt.Errorf("boxlite: warm pool size must be >= 0, got %d", size)
+	}
+	cfg := &boxConfig{}
+	for _, o := range opts {
+		o(cfg)
+	}
+
+	cOpts, err := buildCOptions(image, cfg)
+	if err != nil {
+		return err
+	}
+	defer C.boxlite_options_free(cOpts)
+
+	var cerr C.CBoxliteError
+	if code := C.boxlite_runtime_set_warm_pool(r.handle, cOpts, C.size_t(size), &cerr); code != C.Ok {
+		return freeError(&cerr)
+	}
+	return nil
+}
+
 // GetOrCreate returns the box with the given name, creating it only if no box
 // with that name exists. Unlike Create it does not fail with "already exists"
 // when the box is already present — it adopts it. This mirrors the core
@@ -345,6 +386,14 @@ func (r *Runtime) ensureDrainRunning() {
 
 func (r *Runtime) drainLoop() {
 	defer close(r.drainDone)
+
+	// The record array lives in C memory: libboxlite writes C pointers
+	// (chunk data, cgo handle values) into it, which must never sit in
+	// Go-managed memory the GC scans.
+	cRecords := (*C.CEventRecord)(C.malloc(C.size_t(drainBatchSize) * C.size_t(unsafe.Sizeof(C.CEventRecord{}))))
+	defer C.free(unsafe.Pointer(cRecords))
+	records := unsafe.Slice(cRecords, drainBatchSize)
+
 	for {
 		select {
 		case <-r.drainStop:
@@ -353,13 +402,34 @@ func (r *Runtime) drainLoop() {
 		}
 
 		var cerr C.CBoxliteError
+		var batch *C.CBoxliteEventBatch
 		// Block in C up to drainTimeoutMs waiting for events. When the
 		// runtime is freed elsewhere, libboxlite signals the queue so this
-		// returns immediately.
-		_ = C.boxlite_runtime_drain(r.handle, C.int(drainTimeoutMs), &cerr)
+		// returns immediately. Stdout/stderr/exit come back as records, one
+		// cgo crossing per batch; lifecycle callbacks still fire inline.
+		n := C.boxlite_runtime_drain_records(r.handle, C.int(drainTimeoutMs),
+			cRecords, C.int(drainBatchSize), &batch, &cerr)
 		if cerr.code != C.Ok {
 			C.boxlite_error_free(&cerr)
 		}
+		for i := 0; i < int(n); i++ {
+			dispatchRecord(&records[i])
+		}
+		C.boxlite_event_batch_free(batch)
+	}
+}
+
+// dispatchRecord routes one drained record to the same handlers the
+// per-event C callbacks use, so ordering and Exit-last semantics are
+// unchanged.
+func dispatchRecord(rec *C.CEventRecord) {
+	switch rec.kind {
+	case C.BoxliteEventKindStdout:
+		dispatchStreamWrite(rec.user_data, rec.data, rec.len, false)
+	case C.BoxliteEventKindStderr:
+		dispatchStreamWrite(rec.user_data, rec.data, rec.len, true)
+	case C.BoxliteEventKindExit:
+		dispatchExit(int(rec.code), ptrToHandle(rec.user_data))
 	}
 }
 
@@ -257,6 +257,7 @@ impl From<JsVolumeSpec> for VolumeSpec {
             host_path: v.host_path,
             guest_path: v.guest_path,
             read_only: v.read_only.unwrap_or(false),
+            tuning: None,
         }
     }
 }
@@ -238,6 +238,7 @@ impl From<PyCopyOptions> for CopyOptions {
             overwrite: opt.overwrite,
             follow_symlinks: opt.follow_symlinks,
             include_parent: opt.include_parent,
+            ..Default::default()
         }
     }
 }
@@ -576,6 +577,7 @@ impl From<PyVolumeSpec> for VolumeSpec {
             host_path: v.host,
             guest_path: v.guest,
             read_only: v.read_only,
+            tuning: None,
         }
     }
 }
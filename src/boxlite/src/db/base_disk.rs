@@ -76,6 +76,37 @@ fn row_to_record(row: &rusqlite::Row) -> rusqlite::Result<BaseDiskInfo> {
     Ok(BaseDiskInfo { disk })
 }
 
+/// The base named `name` of `source_box_id`, on `conn` (or a transaction).
+fn find_named(
+    conn: &rusqlite::Connection,
+    source_box_id: &str,
+    name: &str,
+) -> BoxliteResult<Option<BaseDiskInfo>> {
+    db_err!(
+        conn.query_row(
+            "SELECT id, source_box_id, name, kind, base_path, \
+             created_at, json FROM base_disk \
+             WHERE source_box_id = ?1 AND name = ?2",
+            rusqlite::params![source_box_id, name],
+            row_to_record,
+        )
+        .optional()
+    )
+}
+
+/// Record that `box_id` depends on `base_disk_id` (idempotent).
+fn insert_ref(
+    conn: &rusqlite::Connection,
+    base_disk_id: &BaseDiskID,
+    box_id: &str,
+) -> BoxliteResult<()> {
+    db_err!(conn.execute(
+        "INSERT OR IGNORE INTO base_disk_ref (base_disk_id, box_id) VALUES (?1, ?2)",
+        rusqlite::params![base_disk_id, box_id],
+    ))?;
+    Ok(())
+}
+
 /// Storage operations for the `base_disk` table.
 #[derive(Clone)]
 pub(crate) struct BaseDiskStore {
@@ -111,6 +142,81 @@ impl BaseDiskStore {
         Ok(())
     }
 
+    /// Ref the base named `name` of `source_box_id` for `box_id` if it is
+    /// recorded and `is_live` accepts it, returning it.
+    ///
+    /// Lookup and ref share one immediate transaction, so the base cannot be
+    /// collected between the caller finding it and holding it.
+    pub(crate) fn ref_named(
+        &self,
+        source_box_id: &str,
+        name: &str,
+        box_id: &str,
+        is_live: impl Fn(&BaseDiskInfo) -> bool,
+    ) -> BoxliteResult<Option<BaseDiskInfo>> {
+        let mut conn = self.db.conn();
+        let tx = db_err!(conn.transaction_with_behavior(rusqlite::TransactionBehavior::Immediate))?;
+        let Some(existing) = find_named(&tx, source_box_id, name)?.filter(|e| is_live(e)) else {
+            return Ok(None);
+        };
+        insert_ref(&tx, existing.id(), box_id)?;
+        db_err!(tx.commit())?;
+        Ok(Some(existing))
+    }
+
+    /// Insert `disk` unless a base with the same source box and name is
+    /// already recorded and `is_live` accepts it; that record is returned
+    /// instead. Either way `box_id` gets a ref on the base that won. Lookup,
+    /// insert and ref share one immediate transaction, so concurrent
+    /// callers, in this process or another, agree on one base, and it
+    /// cannot be collected before the ref is taken.
+    /// A same-named record `is_live` rejects (its file is gone) is replaced.
+    pub(crate) fn insert_named_or_get(
+        &self,
+        disk: &BaseDisk,
+        box_id: &str,
+        is_live: impl Fn(&BaseDiskInfo) -> bool,
+    ) -> BoxliteResult<Option<BaseDiskInfo>> {
+        let json = serde_json::to_string(disk)
+            .map_err(|e| BoxliteError::Database(format!("Failed to serialize BaseDisk: {}", e)))?;
+        let mut conn = self.db.conn();
+        let tx = db_err!(conn.transaction_with_behavior(rusqlite::TransactionBehavior::Immediate))?;
+
+        let existing = match disk.name.as_deref() {
+            Some(name) => find_named(&tx, &disk.source_box_id, name)?,
+            None => None,
+        };
+        if let Some(existing) = existing {
+            if is_live(&existing) {
+                insert_ref(&tx, existing.id(), box_id)?;
+                db_err!(tx.commit())?;
+                return Ok(Some(existing));
+            }
+            db_err!(tx.execute(
+                "DELETE FROM base_disk WHERE id = ?1",
+                rusqlite::params![existing.id()],
+            ))?;
+        }
+
+        db_err!(tx.execute(
+            "INSERT INTO base_disk \
+             (id, source_box_id, name, kind, base_path, created_at, json) \
+             VALUES (?1, ?2, ?3, ?4, ?5, ?6, ?7)",
+            rusqlite::params![
+                &disk.id,
+                &disk.source_box_id,
+                &disk.name,
+                disk.kind.as_str(),
+                &disk.disk_info.base_path,
+                disk.created_at,
+                json,
+            ],
+        ))?;
+        insert_ref(&tx, &disk.id, box_id)?;
+        db_err!(tx.commit())?;
+        Ok(None)
+    }
+
     /// Find a base disk by its ID.
     #[allow(dead_code)] // used in lineage.rs tests
     pub(crate) fn find_by_id(&self, id: &BaseDiskID) -> BoxliteResult<Option<BaseDiskInfo>> {
@@ -148,18 +254,7 @@ impl BaseDiskStore {
         source_box_id: &str,
         name: &str,
     ) -> BoxliteResult<Option<BaseDiskInfo>> {
-        let conn = self.db.conn();
-        let result = db_err!(
-            conn.query_row(
-                "SELECT id, source_box_id, name, kind, base_path, \
-                 created_at, json FROM base_disk \
-                 WHERE source_box_id = ?1 AND name = ?2",
-                rusqlite::params![source_box_id, name],
-                row_to_record,
-            )
-            .optional()
-        )?;
-        Ok(result)
+        find_named(&self.db.conn(), source_box_id, name)
     }
 
     /// List all base disks for a box, optionally filtered by kind. Newest first.
@@ -229,12 +324,7 @@ impl BaseDiskStore {
     ///
     /// Idempotent: INSERT OR IGNORE on the composite primary key.
     pub(crate) fn add_ref(&self, base_disk_id: &BaseDiskID, box_id: &str) -> BoxliteResult<()> {
-        let conn = self.db.conn();
-        db_err!(conn.execute(
-            "INSERT OR IGNORE INTO base_disk_ref (base_disk_id, box_id) VALUES (?1, ?2)",
-            rusqlite::params![base_disk_id, box_id],
-        ))?;
-        Ok(())
+        insert_ref(&self.db.conn(), base_disk_id, box_id)
     }
 
     /// Remove all refs for a box and return the affected base_disk_ids.
@@ -268,6 +358,7 @@ impl BaseDiskStore {
     }
 
     /// Check if any box depends on `base_disk_id`.
+    #[allow(dead_code)] // used in tests
     pub(crate) fn has_dependents(&self, base_disk_id: &BaseDiskID) -> BoxliteResult<bool> {
         let conn = self.db.conn();
         let exists: bool = db_err!(conn.query_row(
@@ -278,6 +369,21 @@ impl BaseDiskStore {
         Ok(exists)
     }
 
+    /// Delete the record of `base_disk_id` if no box references it.
+    ///
+    /// Check and delete are one statement, so a concurrent ref either lands
+    /// first (and keeps the base) or finds it gone. Returns whether the
+    /// record was deleted.
+    pub(crate) fn delete_if_unreferenced(&self, base_disk_id: &BaseDiskID) -> BoxliteResult<bool> {
+        let conn = self.db.conn();
+        let deleted = db_err!(conn.execute(
+            "DELETE FROM base_disk WHERE id = ?1 AND NOT EXISTS \
+             (SELECT 1 FROM base_disk_ref WHERE base_disk_id = ?1)",
+            rusqlite::params![base_disk_id],
+        ))?;
+        Ok(deleted > 0)
+    }
+
     /// List all box IDs that depend on `base_disk_id`.
     pub(crate) fn dependent_boxes(&self, base_disk_id: &BaseDiskID) -> BoxliteResult<Vec<String>> {
         let conn = self.db.conn();
@@ -333,6 +439,69 @@ mod tests {
         }
     }
 
+    #[test]
+    fn insert_named_or_get_keeps_one_base_per_name() {
+        let store = BaseDiskStore::new(test_db());
+        let first = make_disk(
+            "named001",
+            "box-1",
+            Some("snapshot-start:s1"),
+            BaseDiskKind::CloneBase,
+            "/bases/named001.qcow2",
+        );
+        let second = make_disk(
+            "named002",
+            "box-1",
+            Some("snapshot-start:s1"),
+            BaseDiskKind::CloneBase,
+            "/bases/named002.qcow2",
+        );
+
+        assert!(
+            store
+                .insert_named_or_get(&first, "box-a", |_| true)
+                .unwrap()
+                .is_none()
+        );
+        let winner = store
+            .insert_named_or_get(&second, "box-b", |_| true)
+            .unwrap();
+        assert_eq!(winner.unwrap().id(), &id("named001"));
+        assert!(store.find_by_id(&id("named002")).unwrap().is_none());
+        // Both callers hold the base that won.
+        let mut holders = store.dependent_boxes(&id("named001")).unwrap();
+        holders.sort();
+        assert_eq!(holders, vec!["box-a".to_string(), "box-b".to_string()]);
+        let found = store
+            .ref_named("box-1", "snapshot-start:s1", "box-d", |_| true)
+            .unwrap();
+        assert_eq!(found.unwrap().id(), &id("named001"));
+        assert!(
+            store
+                .ref_named("box-1", "snapshot-start:s1", "box-e", |_| false)
+                .unwrap()
+                .is_none()
+        );
+        assert!(!store.delete_if_unreferenced(&id("named001")).unwrap());
+
+        // A record whose file is gone gives way to the new base.
+        assert!(
+            store
+                .insert_named_or_get(&second, "box-c", |_| false)
+                .unwrap()
+                .is_none()
+        );
+        assert!(store.find_by_id(&id("named001")).unwrap().is_none());
+        let found = store.find_by_name("box-1", "snapshot-start:s1").unwrap();
+        assert_eq!(found.unwrap().id(), &id("named002"));
+        assert_eq!(
+            store.dependent_boxes(&id("named002")).unwrap(),
+            vec!["box-c".to_string()]
+        );
+        store.remove_all_refs_for_box("box-c").unwrap();
+        assert!(store.delete_if_unreferenced(&id("named002")).unwrap());
+    }
+
     #[test]
     fn test_insert_and_find_clone_base() {
         let db = test_db();
@@ -32,7 +32,6 @@ impl BoxStore {
     }
 
     /// Get a reference to the underlying database.
-    #[allow(dead_code)] // Used by snapshots (temporarily disabled)
     pub(crate) fn db(&self) -> Database {
         self.db.clone()
     }
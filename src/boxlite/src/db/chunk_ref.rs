@@ -0,0 +1,155 @@
+//! Chunk reference tracking for the chunk store (`chunk_ref` table).
+//!
+//! Same shape as `base_disk_ref`: one row per (chunk, box) pair, so a
+//! chunk can be collected once no row names it.
+
+use super::{Database, db_err};
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+
+/// Chunk reference storage wrapping Database.
+#[derive(Clone)]
+pub(crate) struct ChunkRefStore {
+    db: Database,
+}
+
+impl ChunkRefStore {
+    pub(crate) fn new(db: Database) -> Self {
+        Self { db }
+    }
+
+    /// Record that `box_id` references every chunk in `digests`.
+    ///
+    /// Idempotent: INSERT OR IGNORE on the composite primary key.
+    pub(crate) fn add_refs<'a>(
+        &self,
+        box_id: &str,
+        digests: impl IntoIterator<Item = &'a String>,
+    ) -> BoxliteResult<()> {
+        let mut conn = self.db.conn();
+        let tx = db_err!(conn.transaction())?;
+        {
+            let mut stmt = db_err!(
+                tx.prepare("INSERT OR IGNORE INTO chunk_ref (digest, box_id) VALUES (?1, ?2)")
+            )?;
+            for digest in digests {
+                db_err!(stmt.execute(rusqlite::params![digest, box_id]))?;
+            }
+        }
+        db_err!(tx.commit())
+    }
+
+    /// Move every ref of `from` to `to` (a provisional import owner to the
+    /// box it created).
+    pub(crate) fn rename_owner(&self, from: &str, to: &str) -> BoxliteResult<()> {
+        let conn = self.db.conn();
+        db_err!(conn.execute(
+            "UPDATE chunk_ref SET box_id = ?2 WHERE box_id = ?1",
+            rusqlite::params![from, to],
+        ))?;
+        Ok(())
+    }
+
+    /// Remove all refs of `box_id` and return the chunks no box references
+    /// any more.
+    pub(crate) fn remove_all_refs_for_box(&self, box_id: &str) -> BoxliteResult<Vec<String>> {
+        let mut conn = self.db.conn();
+        let tx = db_err!(conn.transaction())?;
+        let orphans = {
+            let mut stmt = db_err!(tx.prepare(
+                "SELECT digest FROM chunk_ref AS mine WHERE box_id = ?1 AND NOT EXISTS \
+                 (SELECT 1 FROM chunk_ref AS other \
+                  WHERE other.digest = mine.digest AND other.box_id != ?1)"
+            ))?;
+            let rows = db_err!(stmt.query_map(rusqlite::params![box_id], |row| row.get(0)))?;
+            let mut orphans = Vec::new();
+            for row in rows {
+                orphans.push(db_err!(row)?);
+            }
+            orphans
+        };
+        db_err!(tx.execute(
+            "DELETE FROM chunk_ref WHERE box_id = ?1",
+            rusqlite::params![box_id],
+        ))?;
+        db_err!(tx.commit())?;
+        Ok(orphans)
+    }
+
+    /// Check if any box references `digest`.
+    pub(crate) fn is_referenced(&self, digest: &str) -> BoxliteResult<bool> {
+        let conn = self.db.conn();
+        let exists: bool = db_err!(conn.query_row(
+            "SELECT EXISTS(SELECT 1 FROM chunk_ref WHERE digest = ?1)",
+            rusqlite::params![digest],
+            |row| row.get(0),
+        ))?;
+        Ok(exists)
+    }
+
+    /// Owners whose id starts with `prefix`.
+    pub(crate) fn owners_with_prefix(&self, prefix: &str) -> BoxliteResult<Vec<String>> {
+        let conn = self.db.conn();
+        let mut stmt = db_err!(
+            conn.prepare("SELECT DISTINCT box_id FROM chunk_ref WHERE substr(box_id, 1, ?2) = ?1")
+        )?;
+        let rows = db_err!(
+            stmt.query_map(rusqlite::params![prefix, prefix.len() as i64], |row| row
+                .get(0))
+        )?;
+        let mut owners = Vec::new();
+        for row in rows {
+            owners.push(db_err!(row)?);
+        }
+        Ok(owners)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use tempfile::TempDir;
+
+    fn test_store() -> ChunkRefStore {
+        let dir = TempDir::new().unwrap();
+        let db_path = dir.keep().join("test.db");
+        ChunkRefStore::new(Database::open(&db_path).unwrap())
+    }
+
+    fn digests(names: &[&str]) -> Vec<String> {
+        names.iter().map(|s| s.to_string()).collect()
+    }
+
+    #[test]
+    fn removing_a_box_orphans_only_unshared_chunks() {
+        let store = test_store();
+        store.add_refs("box-a", &digests(&["x", "y"])).unwrap();
+        store.add_refs("box-b", &digests(&["y", "z"])).unwrap();
+
+        let mut orphans = store.remove_all_refs_for_box("box-a").unwrap();
+        orphans.sort();
+        assert_eq!(orphans, digests(&["x"]));
+        assert!(store.is_referenced("y").unwrap());
+        assert!(!store.is_referenced("x").unwrap());
+
+        let mut orphans = store.remove_all_refs_for_box("box-b").unwrap();
+        orphans.sort();
+        assert_eq!(orphans, digests(&["y", "z"]));
+    }
+
+    #[test]
+    fn provisional_owner_is_renamed() {
+        let store = test_store();
+        store.add_refs("import-1", &digests(&["x"])).unwrap();
+        assert_eq!(
+            store.owners_with_prefix("import-").unwrap(),
+            digests(&["import-1"])
+        );
+
+        store.rename_owner("import-1", "box-a").unwrap();
+        assert!(store.owners_with_prefix("import-").unwrap().is_empty());
+        assert_eq!(
+            store.remove_all_refs_for_box("box-a").unwrap(),
+            digests(&["x"])
+        );
+    }
+}
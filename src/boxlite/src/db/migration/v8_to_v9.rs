@@ -0,0 +1,30 @@
+//! Migration v8 → v9: Add chunk_ref table.
+//!
+//! Chunks imported before this version have no refs and stay in the chunk
+//! store; only chunks of later imports are collected.
+
+use rusqlite::Connection;
+
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+
+use super::{Migration, db_err};
+use crate::db::schema;
+
+pub(crate) struct AddChunkRefs;
+
+impl Migration for AddChunkRefs {
+    fn source_version(&self) -> i32 {
+        8
+    }
+    fn target_version(&self) -> i32 {
+        9
+    }
+    fn description(&self) -> &str {
+        "Add chunk_ref table"
+    }
+
+    fn run(&self, conn: &Connection, _home_dir: Option<&std::path::Path>) -> BoxliteResult<()> {
+        db_err!(conn.execute_batch(schema::CHUNK_REF_TABLE))?;
+        Ok(())
+    }
+}
@@ -8,11 +8,14 @@
 
 pub(crate) mod base_disk;
 mod boxes;
+mod chunk_ref;
 mod images;
 pub(crate) mod migration;
 mod schema;
 pub(crate) mod snapshot;
 
+use std::future::Future;
+use std::ops::{Deref, DerefMut};
 use std::path::Path;
 use std::sync::Arc;
 
@@ -24,6 +27,7 @@ use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 
 pub(crate) use base_disk::BaseDiskStore;
 pub use boxes::BoxStore;
+pub(crate) use chunk_ref::ChunkRefStore;
 pub use images::{CachedImage, ImageIndexStore};
 pub(crate) use snapshot::SnapshotStore;
 
@@ -45,6 +49,11 @@ pub struct Database {
     conn: Arc<Mutex<Connection>>,
 }
 
+tokio::task_local! {
+    /// Set while a task runs inside [`WriteBatch::run`].
+    static IN_WRITE_BATCH: ();
+}
+
 impl Database {
     /// Open or create the database.
     ///
@@ -79,8 +88,27 @@ impl Database {
     }
 
     /// Acquire the database connection.
-    pub(crate) fn conn(&self) -> MutexGuard<'_, Connection> {
-        self.conn.lock()
+    ///
+    /// Inside [`WriteBatch::run`] the connection runs at
+    /// `synchronous=NORMAL` until the returned guard drops, so only the
+    /// batch's own commits skip their fsync; every other caller of the
+    /// shared connection keeps `FULL`.
+    pub(crate) fn conn(&self) -> Conn<'_> {
+        let guard = self.conn.lock();
+        let relaxed = IN_WRITE_BATCH.try_with(|_| ()).is_ok()
+            && match guard.execute_batch("PRAGMA synchronous=NORMAL;") {
+                Ok(()) => true,
+                Err(e) => {
+                    tracing::warn!("Failed to relax database sync for write batch: {}", e);
+                    false
+                }
+            };
+        Conn { guard, relaxed }
+    }
+
+    /// Open a write batch for [`WriteBatch::run`].
+    pub(crate) fn batch_writes(&self) -> WriteBatch {
+        WriteBatch { db: self.clone() }
     }
 
     /// Initialize database schema.
@@ -159,6 +187,67 @@ impl Database {
     }
 }
 
+/// Connection guard from [`Database::conn`].
+pub(crate) struct Conn<'a> {
+    guard: MutexGuard<'a, Connection>,
+    /// Acquired inside a write batch: restore `FULL` on drop.
+    relaxed: bool,
+}
+
+impl Deref for Conn<'_> {
+    type Target = Connection;
+
+    fn deref(&self) -> &Connection {
+        &self.guard
+    }
+}
+
+impl DerefMut for Conn<'_> {
+    fn deref_mut(&mut self) -> &mut Connection {
+        &mut self.guard
+    }
+}
+
+impl Drop for Conn<'_> {
+    fn drop(&mut self) {
+        if self.relaxed
+            && let Err(e) = self.guard.execute_batch("PRAGMA synchronous=FULL;")
+        {
+            tracing::warn!("Failed to restore database sync after batch write: {}", e);
+        }
+    }
+}
+
+/// Defers the fsyncs of a group of store writes to one sync at the end.
+///
+/// Store calls made by the future given to [`run`](Self::run), on its own
+/// task, still commit one transaction each, so readers and constraints see
+/// every write immediately and a process crash loses nothing. Only those
+/// commits run at `synchronous=NORMAL`, which in WAL mode skips the
+/// per-commit fsync; writers outside the batch and tasks it spawns keep
+/// `FULL`. When the batch ends (or is dropped) a checkpoint syncs the
+/// accumulated WAL once. A power loss before then can lose the batch's
+/// writes but never corrupts the database.
+pub(crate) struct WriteBatch {
+    db: Database,
+}
+
+impl WriteBatch {
+    /// Run `fut` with its store writes batched, then sync them.
+    pub(crate) async fn run<F: Future>(self, fut: F) -> F::Output {
+        IN_WRITE_BATCH.scope((), fut).await
+    }
+}
+
+impl Drop for WriteBatch {
+    fn drop(&mut self) {
+        let conn = self.db.conn.lock();
+        if let Err(e) = conn.execute_batch("PRAGMA wal_checkpoint(FULL);") {
+            tracing::warn!("Failed to sync database after write batch: {}", e);
+        }
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -171,6 +260,41 @@ mod tests {
         let _db = Database::open(&db_path).unwrap();
     }
 
+    #[tokio::test]
+    async fn test_write_batch_relaxes_sync_only_for_its_own_writes() {
+        let temp_dir = TempDir::new().unwrap();
+        let db = Database::open(&temp_dir.path().join("test.db")).unwrap();
+        let sync = |db: &Database| -> i64 {
+            db.conn()
+                .query_row("PRAGMA synchronous", [], |row| row.get(0))
+                .unwrap()
+        };
+        let raw_sync = |db: &Database| -> i64 {
+            db.conn
+                .lock()
+                .query_row("PRAGMA synchronous", [], |row| row.get(0))
+                .unwrap()
+        };
+        const NORMAL: i64 = 1;
+        const FULL: i64 = 2;
+
+        assert_eq!(sync(&db), FULL);
+        let inside = db
+            .batch_writes()
+            .run(async {
+                let inside = sync(&db);
+                // Another task writing while the batch is open.
+                let other = tokio::spawn({
+                    let db = db.clone();
+                    async move { sync(&db) }
+                });
+                (inside, other.await.unwrap(), raw_sync(&db))
+            })
+            .await;
+        assert_eq!(inside, (NORMAL, FULL, FULL));
+        assert_eq!(sync(&db), FULL);
+    }
+
     #[test]
     fn test_db_open_creates_all_tables() {
         let temp_dir = TempDir::new().unwrap();
@@ -198,6 +322,7 @@ mod tests {
         assert!(tables.contains(&"base_disk".to_string()));
         assert!(tables.contains(&"base_disk_ref".to_string()));
         assert!(tables.contains(&"snapshot".to_string()));
+        assert!(tables.contains(&"chunk_ref".to_string()));
     }
 
     #[test]
@@ -236,8 +361,8 @@ mod tests {
             .unwrap();
         assert_eq!(version, schema::SCHEMA_VERSION);
 
-        // Verify v7 tables exist
-        for table in ["base_disk", "base_disk_ref", "snapshot"] {
+        // Verify v7 and v9 tables exist
+        for table in ["base_disk", "base_disk_ref", "snapshot", "chunk_ref"] {
             let exists: bool = conn
                 .query_row(
                     "SELECT COUNT(*) > 0 FROM sqlite_master WHERE type='table' AND name=?1",
@@ -311,7 +436,7 @@ mod tests {
         assert_eq!(version, schema::SCHEMA_VERSION);
 
         // v7 tables should exist
-        for table in ["base_disk", "base_disk_ref", "snapshot"] {
+        for table in ["base_disk", "base_disk_ref", "snapshot", "chunk_ref"] {
             let exists: bool = conn
                 .query_row(
                     "SELECT COUNT(*) > 0 FROM sqlite_master WHERE type='table' AND name=?1",
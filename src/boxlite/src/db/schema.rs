@@ -7,7 +7,7 @@
 //! Each table has queryable columns for efficient filtering + JSON blob for full data.
 
 /// Current schema version.
-pub const SCHEMA_VERSION: i32 = 8;
+pub const SCHEMA_VERSION: i32 = 9;
 
 /// Schema version tracking table.
 pub const SCHEMA_VERSION_TABLE: &str = r#"
@@ -150,6 +150,20 @@ CREATE TABLE IF NOT EXISTS snapshot (
 CREATE INDEX IF NOT EXISTS idx_snapshot_box ON snapshot(box_id);
 "#;
 
+/// Chunk reference table (added in v9).
+///
+/// Tracks which boxes were rebuilt from which chunks of the chunk store
+/// (chunked archive imports). A chunk no row references is deleted.
+/// `box_id` is a provisional `import-<uuid>` owner while an import runs.
+pub const CHUNK_REF_TABLE: &str = r#"
+CREATE TABLE IF NOT EXISTS chunk_ref (
+    digest TEXT NOT NULL,
+    box_id TEXT NOT NULL,
+    PRIMARY KEY (digest, box_id)
+);
+CREATE INDEX IF NOT EXISTS idx_chunk_ref_box ON chunk_ref(box_id);
+"#;
+
 /// Get all schema creation statements.
 pub fn all_schemas() -> Vec<&'static str> {
     vec![
@@ -161,5 +175,6 @@ pub fn all_schemas() -> Vec<&'static str> {
         BASE_DISK_TABLE,
         BASE_DISK_REF_TABLE,
         SNAPSHOT_TABLE,
+        CHUNK_REF_TABLE,
     ]
 }
@@ -140,6 +140,72 @@ impl BaseDiskManager {
         Ok(disk)
     }
 
+    /// Shared base for boxes started from a snapshot.
+    ///
+    /// A thin clone base whose backing file is the snapshot disk, created on
+    /// first use and reused after that, so every box started from the same
+    /// snapshot shares one backing chain (and its host page cache). Being a
+    /// clone base, it keeps the snapshot and its source box from being
+    /// removed while started boxes depend on it, and is garbage-collected
+    /// with the last of them.
+    ///
+    /// The returned base is already ref'd for `box_id`, in the same
+    /// transaction that found or recorded it; a caller that fails to create
+    /// the box releases it with `remove_all_refs_for_box` and `try_gc_base`.
+    pub(crate) fn snapshot_base(
+        &self,
+        snapshot: &crate::litebox::snapshot_mgr::SnapshotInfo,
+        box_id: &str,
+    ) -> BoxliteResult<(BaseDiskID, super::DiskInfo)> {
+        let name = format!("snapshot-start:{}", snapshot.id);
+        let is_live = |existing: &crate::db::base_disk::BaseDiskInfo| existing.disk_info().exists();
+        if let Some(existing) = self
+            .store
+            .ref_named(&snapshot.box_id, &name, box_id, is_live)?
+        {
+            return Ok((existing.id().clone(), existing.disk_info().clone()));
+        }
+
+        let base_disk_id = BaseDiskIDMint::mint();
+        let base_file = self.bases_dir.join(format!("{}.qcow2", base_disk_id));
+        let virtual_size = snapshot.disk_info.container_disk_bytes;
+        super::Qcow2Helper::create_cow_child_disk(
+            snapshot.disk_info.as_path(),
+            super::BackingFormat::Qcow2,
+            &base_file,
+            virtual_size,
+        )?
+        .leak();
+
+        let on_disk_size = std::fs::metadata(&base_file).map(|m| m.len()).unwrap_or(0);
+        let disk_info = super::DiskInfo {
+            base_path: base_file.to_string_lossy().to_string(),
+            container_disk_bytes: virtual_size,
+            size_bytes: on_disk_size,
+        };
+        let disk = BaseDisk {
+            id: base_disk_id,
+            source_box_id: snapshot.box_id.clone(),
+            name: Some(name),
+            kind: BaseDiskKind::CloneBase,
+            disk_info: disk_info.clone(),
+            created_at: chrono::Utc::now().timestamp(),
+        };
+        // A concurrent first start of the same snapshot may have recorded
+        // its base meanwhile; the store picks one and ours is discarded.
+        match self.store.insert_named_or_get(&disk, box_id, is_live) {
+            Ok(None) => Ok((disk.id, disk_info)),
+            Ok(Some(existing)) => {
+                let _ = std::fs::remove_file(&base_file);
+                Ok((existing.id().clone(), existing.disk_info().clone()))
+            }
+            Err(e) => {
+                let _ = std::fs::remove_file(&base_file);
+                Err(e)
+            }
+        }
+    }
+
     /// Attempt to garbage-collect a clone base by ID and cascade to parent.
     ///
     /// Queries the `base_disk_ref` table for dependents. If none exist,
@@ -155,18 +221,20 @@ impl BaseDiskManager {
             return;
         }
 
-        // DB query for dependents — if any exist, keep the base
-        if self.store.has_dependents(base_disk_id).unwrap_or(true) {
+        // Delete the DB record unless a box references it. One statement,
+        // so a ref taken meanwhile keeps the base.
+        if !self
+            .store
+            .delete_if_unreferenced(base_disk_id)
+            .unwrap_or(false)
+        {
             return;
         }
 
         // Read parent BEFORE deleting file (we need the qcow2 header)
         let base_file = record.disk_info().to_path_buf();
         let parent = self.find_parent_base(&base_file);
-
-        // Delete DB record and file
-        let _ = self.store.delete(record.id());
-        let _ = std::fs::remove_file(record.disk_info().as_path());
+        let _ = std::fs::remove_file(&base_file);
 
         tracing::info!(
             base_disk_id = %record.id(),
@@ -375,6 +443,65 @@ mod tests {
         assert!(mgr.store().find_by_id(&bd2.id).unwrap().is_some());
     }
 
+    #[test]
+    fn test_snapshot_base_is_shared_and_gc_on_last_ref() {
+        let (dir, mgr) = setup();
+
+        let snap_disk = dir
+            .path()
+            .join("boxes")
+            .join("box-1")
+            .join("snapshots")
+            .join("snap-1")
+            .join(disk_filenames::CONTAINER_DISK);
+        std::fs::create_dir_all(snap_disk.parent().unwrap()).unwrap();
+        write_qcow2_with_backing(&snap_disk, None);
+        let snapshot = crate::litebox::snapshot_mgr::SnapshotInfo {
+            id: "snapid01".to_string(),
+            box_id: "box-1".to_string(),
+            name: "snap-1".to_string(),
+            created_at: 0,
+            disk_info: DiskInfo {
+                base_path: snap_disk.to_string_lossy().to_string(),
+                container_disk_bytes: 1024 * 1024 * 1024,
+                size_bytes: 1024,
+            },
+        };
+
+        let (id1, base1) = mgr.snapshot_base(&snapshot, "started-1").unwrap();
+        let (id2, base2) = mgr.snapshot_base(&snapshot, "started-2").unwrap();
+        assert_eq!(id1, id2, "second start should reuse the base");
+        assert_eq!(base1, base2);
+        assert_eq!(
+            crate::disk::read_backing_file_path(base1.as_path()).unwrap(),
+            Some(
+                snap_disk
+                    .canonicalize()
+                    .unwrap()
+                    .to_string_lossy()
+                    .to_string()
+            )
+        );
+
+        // Each start took its ref along with the base.
+        let mut started = mgr.store().dependent_boxes(&id1).unwrap();
+        started.sort();
+        assert_eq!(
+            started,
+            vec!["started-1".to_string(), "started-2".to_string()]
+        );
+
+        mgr.store().remove_all_refs_for_box("started-1").unwrap();
+        mgr.try_gc_base(&id1);
+        assert!(base1.exists(), "started-2 still holds the base");
+
+        mgr.store().remove_all_refs_for_box("started-2").unwrap();
+        mgr.try_gc_base(&id1);
+        assert!(mgr.store().find_by_id(&id1).unwrap().is_none());
+        assert!(!base1.exists());
+        assert!(snap_disk.exists(), "GC must not touch the snapshot itself");
+    }
+
     #[test]
     fn test_find_parent_base() {
         let (dir, mgr) = setup();
@@ -31,6 +31,14 @@ pub mod qcow2 {
 
     /// Block size for QCOW2 formatting (512 bytes)
     pub const BLOCK_SIZE: usize = 512;
+
+    /// Largest virtual size `Qcow2Writer` builds (64 TiB). Geometry can come
+    /// from an imported archive, so it is bounded before anything is sized
+    /// from it.
+    pub const MAX_WRITER_VIRTUAL_SIZE: u64 = 64 << 40;
+
+    /// Largest L1 table `Qcow2Writer` builds, in entries (QEMU's 32 MiB cap).
+    pub const MAX_WRITER_L1_ENTRIES: u64 = 32 * 1024 * 1024 / 8;
 }
 
 /// Ext4 filesystem configuration
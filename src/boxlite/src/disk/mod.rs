@@ -6,6 +6,7 @@
 //! - `create_ext4_from_dir` - Create ext4 filesystem from directory
 //! - `Qcow2Helper` - QCOW2 copy-on-write disk creation
 //! - `fork_qcow2` - Atomic fork: rename + COW child creation
+//! - `SharedDiskCache` - Host-wide base disk store shared across homes
 
 use std::path::{Path, PathBuf};
 
@@ -131,12 +132,15 @@ pub(crate) mod base_disk;
 pub mod constants;
 pub(crate) mod ext4;
 pub(crate) mod qcow2;
+pub(crate) mod shared_cache;
 
 pub(crate) use base_disk::{BaseDisk, BaseDiskKind, BaseDiskManager};
 pub use ext4::{create_ext4_from_dir, inject_file_into_ext4};
 pub use qcow2::{
-    BackingFormat, Qcow2Helper, is_backing_dependency, read_backing_chain, read_backing_file_path,
+    BackingFormat, FlattenProgress, Qcow2Geometry, Qcow2Helper, Qcow2Writer, is_backing_dependency,
+    read_backing_chain, read_backing_file_path,
 };
+pub(crate) use shared_cache::SharedDiskCache;
 
 // ============================================================================
 // DiskInfo — serde DTO for disk path + size metadata
@@ -2,6 +2,7 @@
 //!
 //! Creates and manages qcow2 disk images for Box block devices.
 
+use std::collections::BTreeMap;
 use std::fs::OpenOptions;
 use std::io::{ErrorKind, Read, Write};
 use std::path::{Path, PathBuf};
@@ -10,17 +11,18 @@ use std::process::Command;
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 use qcow2_rs::meta::Qcow2Header;
 
-use super::constants::qcow2::{BLOCK_SIZE, CLUSTER_BITS, DEFAULT_DISK_SIZE_GB, REFCOUNT_ORDER};
+use super::constants::qcow2::{
+    BLOCK_SIZE, CLUSTER_BITS, DEFAULT_DISK_SIZE_GB, MAX_WRITER_L1_ENTRIES, MAX_WRITER_VIRTUAL_SIZE,
+    REFCOUNT_ORDER,
+};
 use super::{Disk, DiskFormat};
 
 /// Parsed qcow2 header information.
-#[allow(dead_code)]
 #[derive(Debug)]
 struct Qcow2HeaderInfo {
     #[allow(dead_code)]
     version: u32,
     size: u64,
-    #[allow(dead_code)]
     cluster_bits: u32,
 }
 
@@ -251,16 +253,65 @@ impl Qcow2Helper {
     ///
     /// Errors on compressed clusters (bit 62 in L2 entries).
     pub fn flatten(src: &Path, dst: &Path) -> BoxliteResult<()> {
-        use std::io::{Seek, SeekFrom, Write};
+        Self::flatten_with_progress(src, dst, &|_| {})
+    }
 
+    /// [`flatten`](Self::flatten), reporting progress after every batch of
+    /// clusters and once more when the data is complete.
+    pub fn flatten_with_progress(
+        src: &Path,
+        dst: &Path,
+        progress: &dyn Fn(&FlattenProgress),
+    ) -> BoxliteResult<()> {
         tracing::info!(
             src = %src.display(),
             dst = %dst.display(),
             "Flattening QCOW2 disk image"
         );
 
+        let mut writer = Qcow2Writer::create(dst, Self::chain_geometry(src)?)?;
+        Self::read_chain_clusters(src, progress, &mut |vc, data| {
+            writer.write_cluster(vc, data)
+        })?;
+        let data_clusters = writer.finish()?;
+
+        tracing::info!(
+            dst = %dst.display(),
+            data_clusters,
+            "Flattened QCOW2 disk image"
+        );
+
+        Ok(())
+    }
+
+    /// Virtual size and cluster size of the top layer of a QCOW2 chain.
+    pub fn chain_geometry(path: &Path) -> BoxliteResult<Qcow2Geometry> {
+        let header = Self::read_qcow2_header(path)?;
+        Ok(Qcow2Geometry {
+            virtual_size: header.size,
+            cluster_bits: header.cluster_bits,
+        })
+    }
+
+    /// Call `emit(virtual_cluster, data)` for every non-zero cluster of the
+    /// merged view of `src` and its backing chain, in ascending order.
+    ///
+    /// Cluster lookup runs over whole L2 tables first, so unallocated and
+    /// zero-flagged clusters (and holes in a raw base) are never read. The
+    /// remaining clusters are read and zero-checked in parallel, one batch
+    /// at a time; `emit` always runs on the calling thread. `progress` is
+    /// called after every batch and once more when the data is complete.
+    ///
+    /// Errors on compressed clusters (bit 62 in L2 entries).
+    pub fn read_chain_clusters(
+        src: &Path,
+        progress: &dyn Fn(&FlattenProgress),
+        emit: &mut dyn FnMut(u64, &[u8]) -> BoxliteResult<()>,
+    ) -> BoxliteResult<Qcow2Geometry> {
+        use rayon::prelude::*;
+
         // Open the full backing chain (top layer first, base last).
-        let mut chain = Self::open_flatten_chain(src)?;
+        let chain = Self::open_flatten_chain(src)?;
 
         let (virtual_size, cluster_bits) = match &chain[0] {
             FlattenLayer::Qcow2 {
@@ -274,205 +325,41 @@ impl Qcow2Helper {
                 ));
             }
         };
-
         let cluster_size = 1u64 << cluster_bits;
         let num_virtual_clusters = virtual_size.div_ceil(cluster_size);
-        let l2_entries = cluster_size / 8;
-        let num_l1 = num_virtual_clusters.div_ceil(l2_entries) as u32;
-        let l1_clusters = ((num_l1 as u64) * 8).div_ceil(cluster_size);
-
-        // Output layout:
-        //   Cluster 0:                             Header
-        //   Clusters 1..1+l1_clusters:             L1 table
-        //   Clusters l2_start..l2_start+num_l1:    L2 tables (pre-allocated slots)
-        //   Clusters data_start..:                 Data clusters
-        //   After data:                            Refcount table + blocks
-        let l2_start = 1 + l1_clusters;
-        let data_start = l2_start + num_l1 as u64;
-
-        let mut output = OpenOptions::new()
-            .create(true)
-            .write(true)
-            .truncate(true)
-            .open(dst)
-            .map_err(|e| {
-                BoxliteError::Storage(format!("Failed to create {}: {}", dst.display(), e))
-            })?;
-
-        // Phase 1: Write data clusters, building L2 tables in memory.
-        let mut l2_tables: Vec<Vec<u64>> = vec![vec![0u64; l2_entries as usize]; num_l1 as usize];
-        let mut next_data_cluster = data_start;
-        let zero_cluster = vec![0u8; cluster_size as usize];
-
-        for vc in 0..num_virtual_clusters {
-            // Resolve cluster through the chain (top-to-bottom).
-            let mut data = None;
-            for layer in chain.iter_mut() {
-                if let Some(d) = layer.read_cluster(vc, cluster_size)? {
-                    data = Some(d);
-                    break;
-                }
-            }
-
-            if let Some(ref d) = data
-                && d.as_slice() != zero_cluster.as_slice()
-            {
-                let offset = next_data_cluster * cluster_size;
-                output
-                    .seek(SeekFrom::Start(offset))
-                    .map_err(|e| BoxliteError::Storage(format!("flatten: data seek: {}", e)))?;
-                output
-                    .write_all(d)
-                    .map_err(|e| BoxliteError::Storage(format!("flatten: data write: {}", e)))?;
-
-                let l1_idx = (vc / l2_entries) as usize;
-                let l2_idx = (vc % l2_entries) as usize;
-                l2_tables[l1_idx][l2_idx] = offset;
-                next_data_cluster += 1;
-            }
-        }
-
-        // Phase 2: Calculate refcount layout.
-        let rc_entries_per_block = cluster_size / 2; // 16-bit refcounts
-        let rc_table_cluster = next_data_cluster;
-        let rc_block_start = rc_table_cluster + 1;
-        // Iterate to handle the circular dependency (rc structures count themselves).
-        let mut total_clusters = rc_block_start;
-        loop {
-            let blocks_needed = total_clusters.div_ceil(rc_entries_per_block);
-            let new_total = rc_block_start + blocks_needed;
-            if new_total <= total_clusters {
-                break;
-            }
-            total_clusters = new_total;
-        }
-        let num_rc_blocks = total_clusters - rc_block_start;
-        let rc_table_offset = rc_table_cluster * cluster_size;
 
-        // Phase 3: Write L1 table.
-        output
-            .seek(SeekFrom::Start(cluster_size))
-            .map_err(|e| BoxliteError::Storage(format!("flatten: L1 seek: {}", e)))?;
-        for (i, l2) in l2_tables.iter().enumerate() {
-            let has_data = l2.iter().any(|&e| e != 0);
-            let entry: u64 = if has_data {
-                (l2_start + i as u64) * cluster_size
-            } else {
-                0
-            };
-            output
-                .write_all(&entry.to_be_bytes())
-                .map_err(|e| BoxliteError::Storage(format!("flatten: L1 write: {}", e)))?;
-        }
+        // Resolve every virtual cluster to the layer holding its data.
+        let sources = plan_flatten(&chain, cluster_bits, num_virtual_clusters)?;
 
-        // Phase 4: Write L2 tables (only those with data).
-        for (i, l2) in l2_tables.iter().enumerate() {
-            if l2.iter().all(|&e| e == 0) {
-                continue;
-            }
-            let offset = (l2_start + i as u64) * cluster_size;
-            output
-                .seek(SeekFrom::Start(offset))
-                .map_err(|e| BoxliteError::Storage(format!("flatten: L2 seek: {}", e)))?;
-            for entry in l2 {
-                output
-                    .write_all(&entry.to_be_bytes())
-                    .map_err(|e| BoxliteError::Storage(format!("flatten: L2 write: {}", e)))?;
+        let mut report = FlattenProgress {
+            bytes_total: virtual_size,
+            ..Default::default()
+        };
+        for batch in sources.chunks(FLATTEN_BATCH_CLUSTERS) {
+            let chunks = batch
+                .par_chunks(FLATTEN_TASK_CLUSTERS)
+                .map(|task| read_nonzero_clusters(&chain, task, cluster_size))
+                .collect::<BoxliteResult<Vec<_>>>()?;
+
+            for (vc, data) in chunks.into_iter().flatten() {
+                emit(vc, &data)?;
+                report.bytes_written += cluster_size;
             }
-        }
-
-        // Phase 5: Write refcount table.
-        output
-            .seek(SeekFrom::Start(rc_table_offset))
-            .map_err(|e| BoxliteError::Storage(format!("flatten: rc table seek: {}", e)))?;
-        for i in 0..num_rc_blocks {
-            let block_offset = (rc_block_start + i) * cluster_size;
-            output
-                .write_all(&block_offset.to_be_bytes())
-                .map_err(|e| BoxliteError::Storage(format!("flatten: rc table write: {}", e)))?;
-        }
 
-        // Phase 6: Write refcount blocks.
-        // Mark used clusters: header, L1, referenced L2 tables, data, rc table, rc blocks.
-        let mut used = vec![false; total_clusters as usize];
-        used[0] = true; // header
-        for c in 1..1 + l1_clusters {
-            used[c as usize] = true; // L1
-        }
-        for (i, l2) in l2_tables.iter().enumerate() {
-            if l2.iter().any(|&e| e != 0) {
-                used[(l2_start + i as u64) as usize] = true; // L2
+            if let Some(last) = batch.last() {
+                report.bytes_done = ((last.vc + 1) * cluster_size).min(virtual_size);
+                progress(&report);
             }
         }
-        for c in data_start..next_data_cluster {
-            used[c as usize] = true; // data
-        }
-        used[rc_table_cluster as usize] = true; // rc table
-        for c in rc_block_start..total_clusters {
-            used[c as usize] = true; // rc blocks
+        if report.bytes_done < virtual_size || sources.is_empty() {
+            report.bytes_done = virtual_size;
+            progress(&report);
         }
 
-        for bi in 0..num_rc_blocks {
-            let block_offset = (rc_block_start + bi) * cluster_size;
-            output
-                .seek(SeekFrom::Start(block_offset))
-                .map_err(|e| BoxliteError::Storage(format!("flatten: rc block seek: {}", e)))?;
-            let first = (bi * rc_entries_per_block) as usize;
-            for c in 0..rc_entries_per_block as usize {
-                let refcount: u16 = if first + c < used.len() && used[first + c] {
-                    1
-                } else {
-                    0
-                };
-                output.write_all(&refcount.to_be_bytes()).map_err(|e| {
-                    BoxliteError::Storage(format!("flatten: rc block write: {}", e))
-                })?;
-            }
-        }
-
-        // Phase 7: Write QCOW2 v3 header at cluster 0 (standalone, no backing).
-        output
-            .seek(SeekFrom::Start(0))
-            .map_err(|e| BoxliteError::Storage(format!("flatten: header seek: {}", e)))?;
-        let mut hdr = [0u8; 112]; // 104 bytes header + 8 bytes end-of-extensions
-        // Magic
-        hdr[0..4].copy_from_slice(&QCOW2_MAGIC.to_be_bytes());
-        // Version 3
-        hdr[4..8].copy_from_slice(&3u32.to_be_bytes());
-        // No backing file (offset=0, size=0) — bytes 8-19 stay zero
-        // Cluster bits
-        hdr[20..24].copy_from_slice(&cluster_bits.to_be_bytes());
-        // Virtual size
-        hdr[24..32].copy_from_slice(&virtual_size.to_be_bytes());
-        // Crypt method 0
-        // L1 size
-        hdr[36..40].copy_from_slice(&num_l1.to_be_bytes());
-        // L1 table offset (cluster 1)
-        hdr[40..48].copy_from_slice(&cluster_size.to_be_bytes());
-        // Refcount table offset
-        hdr[48..56].copy_from_slice(&rc_table_offset.to_be_bytes());
-        // Refcount table clusters
-        hdr[56..60].copy_from_slice(&1u32.to_be_bytes());
-        // Refcount order (4 = 16-bit)
-        hdr[96..100].copy_from_slice(&(REFCOUNT_ORDER as u32).to_be_bytes());
-        // Header length
-        hdr[100..104].copy_from_slice(&104u32.to_be_bytes());
-        // Bytes 104-111: end-of-extensions marker (all zeros, already initialized)
-        output
-            .write_all(&hdr)
-            .map_err(|e| BoxliteError::Storage(format!("flatten: header write: {}", e)))?;
-
-        output
-            .sync_all()
-            .map_err(|e| BoxliteError::Storage(format!("flatten: sync: {}", e)))?;
-
-        tracing::info!(
-            dst = %dst.display(),
-            data_clusters = next_data_cluster - data_start,
-            "Flattened QCOW2 disk image"
-        );
-
-        Ok(())
+        Ok(Qcow2Geometry {
+            virtual_size,
+            cluster_bits,
+        })
     }
 
     /// Open the full backing chain starting from `path`.
@@ -499,7 +386,6 @@ impl Qcow2Helper {
     }
 
     /// Read qcow2 header from disk file.
-    #[allow(dead_code)]
     fn read_qcow2_header(path: &Path) -> BoxliteResult<Qcow2HeaderInfo> {
         use std::io::Read;
 
@@ -1166,6 +1052,495 @@ pub fn is_backing_dependency(target: &Path, chain_root: &Path) -> bool {
 /// QCOW2 magic number: "QFI\xfb".
 const QCOW2_MAGIC: u32 = 0x514649fb;
 
+/// Virtual size and cluster size of a QCOW2 image.
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub struct Qcow2Geometry {
+    pub virtual_size: u64,
+    pub cluster_bits: u32,
+}
+
+/// Writes a standalone QCOW2 v3 image from data clusters supplied in
+/// ascending virtual-cluster order. Clusters never written read as zeros.
+///
+/// Output layout:
+///   Cluster 0:                             Header
+///   Clusters 1..1+l1_clusters:             L1 table
+///   Clusters l2_start..l2_start+num_l1:    L2 tables (pre-allocated slots)
+///   Clusters data_start..:                 Data clusters
+///   After data:                            Refcount table + blocks
+pub struct Qcow2Writer {
+    output: std::fs::File,
+    geometry: Qcow2Geometry,
+    num_l1: u32,
+    l1_clusters: u64,
+    l2_start: u64,
+    data_start: u64,
+    /// L2 tables built in memory by L1 index, written by `finish`. Only
+    /// tables with data exist, so memory follows the data, not the disk size.
+    l2_tables: BTreeMap<u64, Vec<u64>>,
+    next_data_cluster: u64,
+    /// Clusters below this one can no longer be written.
+    next_vc: u64,
+}
+
+impl Qcow2Writer {
+    /// Create (or truncate) `dst` for an image of the given geometry.
+    ///
+    /// Fails if the geometry is outside what the writer supports: cluster
+    /// bits 9..=21, a virtual size up to [`MAX_WRITER_VIRTUAL_SIZE`] and an
+    /// L1 table up to [`MAX_WRITER_L1_ENTRIES`].
+    pub fn create(dst: &Path, geometry: Qcow2Geometry) -> BoxliteResult<Self> {
+        if !(9..=21).contains(&geometry.cluster_bits) {
+            return Err(BoxliteError::Storage(format!(
+                "qcow2 writer: unsupported cluster_bits {}",
+                geometry.cluster_bits
+            )));
+        }
+        if geometry.virtual_size > MAX_WRITER_VIRTUAL_SIZE {
+            return Err(BoxliteError::Storage(format!(
+                "qcow2 writer: virtual size {} exceeds the {}-byte limit",
+                geometry.virtual_size, MAX_WRITER_VIRTUAL_SIZE
+            )));
+        }
+        let cluster_size = 1u64 << geometry.cluster_bits;
+        let num_virtual_clusters = geometry.virtual_size.div_ceil(cluster_size);
+        let l2_entries = cluster_size / 8;
+        let num_l1 = num_virtual_clusters.div_ceil(l2_entries);
+        let num_l1 = u32::try_from(num_l1)
+            .ok()
+            .filter(|&n| u64::from(n) <= MAX_WRITER_L1_ENTRIES)
+            .ok_or_else(|| {
+                BoxliteError::Storage(format!(
+                    "qcow2 writer: {} L1 entries for a {}-byte disk with {}-byte clusters \
+                     exceed the {} limit",
+                    num_l1, geometry.virtual_size, cluster_size, MAX_WRITER_L1_ENTRIES
+                ))
+            })?;
+        let l1_clusters = ((num_l1 as u64) * 8).div_ceil(cluster_size);
+        let l2_start = 1 + l1_clusters;
+        let data_start = l2_start + num_l1 as u64;
+
+        let output = OpenOptions::new()
+            .create(true)
+            .write(true)
+            .truncate(true)
+            .open(dst)
+            .map_err(|e| {
+                BoxliteError::Storage(format!("Failed to create {}: {}", dst.display(), e))
+            })?;
+
+        Ok(Self {
+            output,
+            geometry,
+            num_l1,
+            l1_clusters,
+            l2_start,
+            data_start,
+            l2_tables: BTreeMap::new(),
+            next_data_cluster: data_start,
+            next_vc: 0,
+        })
+    }
+
+    /// Write the data of virtual cluster `vc`. `data` shorter than a cluster
+    /// is zero-padded.
+    pub fn write_cluster(&mut self, vc: u64, data: &[u8]) -> BoxliteResult<()> {
+        use std::os::unix::fs::FileExt;
+
+        let cluster_size = 1u64 << self.geometry.cluster_bits;
+        let l2_entries = cluster_size / 8;
+        if vc < self.next_vc || vc >= self.geometry.virtual_size.div_ceil(cluster_size) {
+            return Err(BoxliteError::Storage(format!(
+                "qcow2 writer: cluster {} out of order or beyond the disk",
+                vc
+            )));
+        }
+        if data.len() as u64 > cluster_size {
+            return Err(BoxliteError::Storage(format!(
+                "qcow2 writer: {} bytes do not fit a {}-byte cluster",
+                data.len(),
+                cluster_size
+            )));
+        }
+
+        let offset = self.next_data_cluster * cluster_size;
+        self.output
+            .write_all_at(data, offset)
+            .map_err(|e| BoxliteError::Storage(format!("flatten: data write: {}", e)))?;
+        if (data.len() as u64) < cluster_size {
+            let pad = vec![0u8; cluster_size as usize - data.len()];
+            self.output
+                .write_all_at(&pad, offset + data.len() as u64)
+                .map_err(|e| BoxliteError::Storage(format!("flatten: data write: {}", e)))?;
+        }
+
+        // `vc` is below the cluster count, so its L1 index is below `num_l1`.
+        let l2 = self
+            .l2_tables
+            .entry(vc / l2_entries)
+            .or_insert_with(|| vec![0u64; l2_entries as usize]);
+        l2[(vc % l2_entries) as usize] = offset;
+        self.next_data_cluster += 1;
+        self.next_vc = vc + 1;
+        Ok(())
+    }
+
+    /// Write metadata and the header, sync, and return the number of data
+    /// clusters in the image.
+    pub fn finish(self) -> BoxliteResult<u64> {
+        use std::io::{Seek, SeekFrom, Write};
+
+        let Qcow2Writer {
+            mut output,
+            geometry,
+            num_l1,
+            l1_clusters,
+            l2_start,
+            data_start,
+            l2_tables,
+            next_data_cluster,
+            ..
+        } = self;
+        let Qcow2Geometry {
+            virtual_size,
+            cluster_bits,
+        } = geometry;
+        let cluster_size = 1u64 << cluster_bits;
+
+        // Phase 1: Calculate refcount layout.
+        let rc_entries_per_block = cluster_size / 2; // 16-bit refcounts
+        let rc_table_cluster = next_data_cluster;
+        let rc_block_start = rc_table_cluster + 1;
+        // Iterate to handle the circular dependency (rc structures count themselves).
+        let mut total_clusters = rc_block_start;
+        loop {
+            let blocks_needed = total_clusters.div_ceil(rc_entries_per_block);
+            let new_total = rc_block_start + blocks_needed;
+            if new_total <= total_clusters {
+                break;
+            }
+            total_clusters = new_total;
+        }
+        let num_rc_blocks = total_clusters - rc_block_start;
+        let rc_table_offset = rc_table_cluster * cluster_size;
+
+        // Phase 2: Write L1 table.
+        output
+            .seek(SeekFrom::Start(cluster_size))
+            .map_err(|e| BoxliteError::Storage(format!("flatten: L1 seek: {}", e)))?;
+        for i in 0..num_l1 as u64 {
+            let entry: u64 = if l2_tables.contains_key(&i) {
+                (l2_start + i) * cluster_size
+            } else {
+                0
+            };
+            output
+                .write_all(&entry.to_be_bytes())
+                .map_err(|e| BoxliteError::Storage(format!("flatten: L1 write: {}", e)))?;
+        }
+
+        // Phase 3: Write L2 tables (only those with data).
+        for (&i, l2) in &l2_tables {
+            let offset = (l2_start + i) * cluster_size;
+            output
+                .seek(SeekFrom::Start(offset))
+                .map_err(|e| BoxliteError::Storage(format!("flatten: L2 seek: {}", e)))?;
+            for entry in l2 {
+                output
+                    .write_all(&entry.to_be_bytes())
+                    .map_err(|e| BoxliteError::Storage(format!("flatten: L2 write: {}", e)))?;
+            }
+        }
+
+        // Phase 4: Write refcount table.
+        output
+            .seek(SeekFrom::Start(rc_table_offset))
+            .map_err(|e| BoxliteError::Storage(format!("flatten: rc table seek: {}", e)))?;
+        for i in 0..num_rc_blocks {
+            let block_offset = (rc_block_start + i) * cluster_size;
+            output
+                .write_all(&block_offset.to_be_bytes())
+                .map_err(|e| BoxliteError::Storage(format!("flatten: rc table write: {}", e)))?;
+        }
+
+        // Phase 5: Write refcount blocks.
+        // Mark used clusters: header, L1, referenced L2 tables, data, rc table, rc blocks.
+        let mut used = vec![false; total_clusters as usize];
+        used[0] = true; // header
+        for c in 1..1 + l1_clusters {
+            used[c as usize] = true; // L1
+        }
+        for &i in l2_tables.keys() {
+            used[(l2_start + i) as usize] = true; // L2
+        }
+        for c in data_start..next_data_cluster {
+            used[c as usize] = true; // data
+        }
+        used[rc_table_cluster as usize] = true; // rc table
+        for c in rc_block_start..total_clusters {
+            used[c as usize] = true; // rc blocks
+        }
+
+        for bi in 0..num_rc_blocks {
+            let block_offset = (rc_block_start + bi) * cluster_size;
+            output
+                .seek(SeekFrom::Start(block_offset))
+                .map_err(|e| BoxliteError::Storage(format!("flatten: rc block seek: {}", e)))?;
+            let first = (bi * rc_entries_per_block) as usize;
+            for c in 0..rc_entries_per_block as usize {
+                let refcount: u16 = if first + c < used.len() && used[first + c] {
+                    1
+                } else {
+                    0
+                };
+                output.write_all(&refcount.to_be_bytes()).map_err(|e| {
+                    BoxliteError::Storage(format!("flatten: rc block write: {}", e))
+                })?;
+            }
+        }
+
+        // Phase 6: Write QCOW2 v3 header at cluster 0 (standalone, no backing).
+        output
+            .seek(SeekFrom::Start(0))
+            .map_err(|e| BoxliteError::Storage(format!("flatten: header seek: {}", e)))?;
+        let mut hdr = [0u8; 112]; // 104 bytes header + 8 bytes end-of-extensions
+        // Magic
+        hdr[0..4].copy_from_slice(&QCOW2_MAGIC.to_be_bytes());
+        // Version 3
+        hdr[4..8].copy_from_slice(&3u32.to_be_bytes());
+        // No backing file (offset=0, size=0) — bytes 8-19 stay zero
+        // Cluster bits
+        hdr[20..24].copy_from_slice(&cluster_bits.to_be_bytes());
+        // Virtual size
+        hdr[24..32].copy_from_slice(&virtual_size.to_be_bytes());
+        // Crypt method 0
+        // L1 size
+        hdr[36..40].copy_from_slice(&num_l1.to_be_bytes());
+        // L1 table offset (cluster 1)
+        hdr[40..48].copy_from_slice(&cluster_size.to_be_bytes());
+        // Refcount table offset
+        hdr[48..56].copy_from_slice(&rc_table_offset.to_be_bytes());
+        // Refcount table clusters
+        hdr[56..60].copy_from_slice(&1u32.to_be_bytes());
+        // Refcount order (4 = 16-bit)
+        hdr[96..100].copy_from_slice(&(REFCOUNT_ORDER as u32).to_be_bytes());
+        // Header length
+        hdr[100..104].copy_from_slice(&104u32.to_be_bytes());
+        // Bytes 104-111: end-of-extensions marker (all zeros, already initialized)
+        output
+            .write_all(&hdr)
+            .map_err(|e| BoxliteError::Storage(format!("flatten: header write: {}", e)))?;
+
+        output
+            .sync_all()
+            .map_err(|e| BoxliteError::Storage(format!("flatten: sync: {}", e)))?;
+
+        Ok(next_data_cluster - data_start)
+    }
+}
+
+/// Clusters whose data is held in memory at once during flatten.
+const FLATTEN_BATCH_CLUSTERS: usize = 256;
+
+/// Clusters read by one parallel flatten task.
+const FLATTEN_TASK_CLUSTERS: usize = 16;
+
+/// L1/L2 entry bits 9-55: offset of the L2 table or data cluster.
+const QCOW2_OFFSET_MASK: u64 = 0x00FF_FFFF_FFFF_FE00;
+
+/// L2 entry bit 62: compressed cluster.
+const QCOW2_COMPRESSED_FLAG: u64 = 1 << 62;
+
+/// L2 entry bit 0 (v3): cluster reads as zeros.
+const QCOW2_ZERO_FLAG: u64 = 1;
+
+/// Progress of a [`Qcow2Helper::flatten_with_progress`] run.
+#[derive(Clone, Copy, Debug, Default, PartialEq)]
+pub struct FlattenProgress {
+    /// Virtual size of the disk.
+    pub bytes_total: u64,
+    /// Virtual bytes resolved and copied so far.
+    pub bytes_done: u64,
+    /// Data written to the output so far (allocated clusters only).
+    pub bytes_written: u64,
+}
+
+/// A virtual cluster whose data lives in `chain[layer]` at `offset`.
+struct ClusterSource {
+    vc: u64,
+    layer: usize,
+    offset: u64,
+    /// Bytes to read; shorter than a cluster only at the end of a raw base.
+    len: usize,
+}
+
+/// Resolve every virtual cluster top-down through `chain`, one L2 table at
+/// a time. Unallocated clusters, v3 zero clusters and holes in a raw base
+/// are left out: they read as zeros and flatten never writes them.
+fn plan_flatten(
+    chain: &[FlattenLayer],
+    cluster_bits: u32,
+    num_virtual_clusters: u64,
+) -> BoxliteResult<Vec<ClusterSource>> {
+    let cluster_size = 1u64 << cluster_bits;
+    let l2_entries = cluster_size / 8;
+
+    // L2 indices are per layer, so the whole chain must share one geometry.
+    for layer in chain {
+        if let FlattenLayer::Qcow2 {
+            cluster_bits: bits, ..
+        } = layer
+            && *bits != cluster_bits
+        {
+            return Err(BoxliteError::Storage(format!(
+                "flatten: backing chain mixes cluster sizes ({} and {} bits)",
+                cluster_bits, bits
+            )));
+        }
+    }
+
+    let raw_extents: Vec<Vec<(u64, u64)>> = chain
+        .iter()
+        .map(|layer| match layer {
+            FlattenLayer::Raw { file, size } => data_extents(file, *size),
+            FlattenLayer::Qcow2 { .. } => Vec::new(),
+        })
+        .collect();
+
+    let mut sources = Vec::new();
+    for l1_idx in 0..num_virtual_clusters.div_ceil(l2_entries) {
+        let tables = chain
+            .iter()
+            .map(|layer| layer.l2_table(l1_idx as usize, cluster_size))
+            .collect::<BoxliteResult<Vec<_>>>()?;
+
+        let first = l1_idx * l2_entries;
+        let end = (first + l2_entries).min(num_virtual_clusters);
+        'cluster: for vc in first..end {
+            for (layer_idx, layer) in chain.iter().enumerate() {
+                match layer {
+                    FlattenLayer::Qcow2 { .. } => {
+                        let Some(table) = &tables[layer_idx] else {
+                            continue;
+                        };
+                        let entry = table[(vc - first) as usize];
+                        if entry & QCOW2_COMPRESSED_FLAG != 0 {
+                            return Err(BoxliteError::Storage(
+                                "flatten: compressed QCOW2 clusters are not supported".into(),
+                            ));
+                        }
+                        if entry & QCOW2_ZERO_FLAG != 0 {
+                            continue 'cluster;
+                        }
+                        let offset = entry & QCOW2_OFFSET_MASK;
+                        if offset != 0 {
+                            sources.push(ClusterSource {
+                                vc,
+                                layer: layer_idx,
+                                offset,
+                                len: cluster_size as usize,
+                            });
+                            continue 'cluster;
+                        }
+                    }
+                    FlattenLayer::Raw { size, .. } => {
+                        let offset = vc * cluster_size;
+                        if offset >= *size {
+                            continue;
+                        }
+                        let len = (*size - offset).min(cluster_size);
+                        if overlaps_extent(&raw_extents[layer_idx], offset, len) {
+                            sources.push(ClusterSource {
+                                vc,
+                                layer: layer_idx,
+                                offset,
+                                len: len as usize,
+                            });
+                        }
+                        continue 'cluster;
+                    }
+                }
+            }
+        }
+    }
+    Ok(sources)
+}
+
+/// Read the clusters in `task`, dropping those that turn out to be all zeros.
+fn read_nonzero_clusters(
+    chain: &[FlattenLayer],
+    task: &[ClusterSource],
+    cluster_size: u64,
+) -> BoxliteResult<Vec<(u64, Vec<u8>)>> {
+    use std::os::unix::fs::FileExt;
+
+    let mut clusters = Vec::with_capacity(task.len());
+    for source in task {
+        let file = match &chain[source.layer] {
+            FlattenLayer::Qcow2 { file, .. } | FlattenLayer::Raw { file, .. } => file,
+        };
+        let mut buf = vec![0u8; cluster_size as usize];
+        file.read_exact_at(&mut buf[..source.len], source.offset)
+            .map_err(|e| BoxliteError::Storage(format!("flatten: data read: {}", e)))?;
+        if !is_zero(&buf) {
+            clusters.push((source.vc, buf));
+        }
+    }
+    Ok(clusters)
+}
+
+/// Whether `buf` holds only zero bytes, compared 16 bytes at a time.
+fn is_zero(buf: &[u8]) -> bool {
+    let words = buf.chunks_exact(16);
+    let tail = words.remainder();
+    words
+        .map(|w| u128::from_ne_bytes(w.try_into().unwrap()))
+        .all(|w| w == 0)
+        && tail.iter().all(|&b| b == 0)
+}
+
+/// Allocated `(start, end)` byte ranges of a sparse file, found with
+/// `SEEK_DATA`/`SEEK_HOLE`. Falls back to the whole file when the
+/// filesystem cannot report holes.
+fn data_extents(file: &std::fs::File, size: u64) -> Vec<(u64, u64)> {
+    use std::os::fd::AsRawFd;
+
+    let fd = file.as_raw_fd();
+    let mut extents = Vec::new();
+    let mut pos = 0u64;
+    while pos < size {
+        // SAFETY: lseek on a descriptor owned by `file`; the position it
+        // leaves behind is never used, all reads go through read_at.
+        let start = unsafe { libc::lseek(fd, pos as libc::off_t, libc::SEEK_DATA) };
+        if start < 0 {
+            if std::io::Error::last_os_error().raw_os_error() == Some(libc::ENXIO) {
+                break; // only a hole remains
+            }
+            return vec![(0, size)];
+        }
+        // SAFETY: as above.
+        let end = unsafe { libc::lseek(fd, start, libc::SEEK_HOLE) };
+        if end < 0 {
+            return vec![(0, size)];
+        }
+        let (start, end) = (start as u64, (end as u64).min(size));
+        if end <= start {
+            break;
+        }
+        extents.push((start, end));
+        pos = end;
+    }
+    extents
+}
+
+/// Whether `[offset, offset + len)` intersects one of the sorted `extents`.
+fn overlaps_extent(extents: &[(u64, u64)], offset: u64, len: u64) -> bool {
+    let idx = extents.partition_point(|&(_, end)| end <= offset);
+    extents
+        .get(idx)
+        .is_some_and(|&(start, _)| start < offset + len)
+}
+
 /// A layer in a QCOW2 backing chain, used during flatten.
 enum FlattenLayer {
     /// A QCOW2 layer with L1/L2 indirection.
@@ -1274,10 +1649,45 @@ impl FlattenLayer {
         ))
     }
 
+    /// L2 table `l1_idx` of a QCOW2 layer, or `None` when it is unallocated
+    /// (or this is a raw layer).
+    fn l2_table(&self, l1_idx: usize, cluster_size: u64) -> BoxliteResult<Option<Vec<u64>>> {
+        use std::os::unix::fs::FileExt;
+
+        let FlattenLayer::Qcow2 { file, l1_table, .. } = self else {
+            return Ok(None);
+        };
+        let Some(&l1_entry) = l1_table.get(l1_idx) else {
+            return Ok(None);
+        };
+        let l2_table_offset = l1_entry & QCOW2_OFFSET_MASK;
+        if l2_table_offset == 0 {
+            return Ok(None);
+        }
+
+        // A table cut short by the end of the file reads as unallocated.
+        let mut buf = vec![0u8; cluster_size as usize];
+        let mut filled = 0;
+        while filled < buf.len() {
+            match file.read_at(&mut buf[filled..], l2_table_offset + filled as u64) {
+                Ok(0) => break,
+                Ok(n) => filled += n,
+                Err(e) if e.kind() == ErrorKind::Interrupted => {}
+                Err(e) => return Err(BoxliteError::Storage(format!("flatten: L2 read: {}", e))),
+            }
+        }
+        Ok(Some(
+            buf.chunks_exact(8)
+                .map(|c| u64::from_be_bytes(c.try_into().unwrap()))
+                .collect(),
+        ))
+    }
+
     /// Read a single virtual cluster from this layer.
     ///
     /// Returns `Some(data)` if the cluster is allocated in this layer,
     /// `None` if unallocated (should fall through to backing layer).
+    #[cfg(test)]
     fn read_cluster(
         &mut self,
         virtual_cluster: u64,
@@ -1778,6 +2188,164 @@ mod tests {
         assert_eq!(val, 2, "cluster 1 marker should be 2 (cluster_idx + 1)");
     }
 
+    /// Point L1 entry 0 of `path` at a fresh L2 table in cluster 10 holding
+    /// `entries` as `(l2_index, entry)`.
+    fn write_fake_l2(path: &Path, entries: &[(u64, u64)]) {
+        use std::os::unix::fs::FileExt;
+
+        let cluster_size = 1u64 << CLUSTER_BITS;
+        let f = std::fs::OpenOptions::new()
+            .write(true)
+            .read(true)
+            .open(path)
+            .unwrap();
+        let mut hdr = [0u8; 48];
+        f.read_exact_at(&mut hdr, 0).unwrap();
+        let l1_offset = u64::from_be_bytes(hdr[40..48].try_into().unwrap());
+
+        let l2_offset = 10 * cluster_size;
+        f.write_all_at(&l2_offset.to_be_bytes(), l1_offset).unwrap();
+        let mut table = vec![0u8; cluster_size as usize];
+        for &(idx, entry) in entries {
+            let at = idx as usize * 8;
+            table[at..at + 8].copy_from_slice(&entry.to_be_bytes());
+        }
+        f.write_all_at(&table, l2_offset).unwrap();
+    }
+
+    fn cluster_marker(chain: &mut [FlattenLayer], vc: u64) -> Option<u64> {
+        let cluster_size = 1u64 << CLUSTER_BITS;
+        chain[0]
+            .read_cluster(vc, cluster_size)
+            .unwrap()
+            .map(|d| u64::from_be_bytes(d[0..8].try_into().unwrap()))
+    }
+
+    #[test]
+    fn test_flatten_honors_zero_flag_and_overlay_data() {
+        use std::os::unix::fs::FileExt;
+
+        let dir = TempDir::new().unwrap();
+        let cluster_size = 1u64 << CLUSTER_BITS;
+        let raw_size = cluster_size * 4;
+
+        let base = dir.path().join("base.raw");
+        write_raw_disk(&base, raw_size);
+        let child = dir.path().join("child.qcow2");
+        let _child_disk =
+            Qcow2Helper::create_cow_child_disk(&base, BackingFormat::Raw, &child, raw_size)
+                .unwrap();
+
+        // Cluster 1 is zeroed in the child; cluster 2 is overwritten by it.
+        let data_offset = 11 * cluster_size;
+        write_fake_l2(&child, &[(1, QCOW2_ZERO_FLAG), (2, data_offset)]);
+        let mut data = vec![0u8; cluster_size as usize];
+        data[0..8].copy_from_slice(&42u64.to_be_bytes());
+        let f = std::fs::OpenOptions::new()
+            .write(true)
+            .open(&child)
+            .unwrap();
+        f.write_all_at(&data, data_offset).unwrap();
+
+        let dst = dir.path().join("flat.qcow2");
+        Qcow2Helper::flatten(&child, &dst).unwrap();
+        verify_flatten_output(&dst, raw_size);
+
+        let mut chain = Qcow2Helper::open_flatten_chain(&dst).unwrap();
+        assert_eq!(cluster_marker(&mut chain, 0), Some(1));
+        assert_eq!(
+            cluster_marker(&mut chain, 1),
+            None,
+            "zero flag must win over base"
+        );
+        assert_eq!(cluster_marker(&mut chain, 2), Some(42));
+        assert_eq!(cluster_marker(&mut chain, 3), Some(4));
+    }
+
+    #[test]
+    fn test_flatten_skips_raw_holes() {
+        use std::os::unix::fs::FileExt;
+
+        let dir = TempDir::new().unwrap();
+        let cluster_size = 1u64 << CLUSTER_BITS;
+        let raw_size = cluster_size * 64;
+
+        // Sparse base: only cluster 5 is written.
+        let base = dir.path().join("base.raw");
+        let f = std::fs::File::create(&base).unwrap();
+        f.set_len(raw_size).unwrap();
+        f.write_all_at(&6u64.to_be_bytes(), 5 * cluster_size)
+            .unwrap();
+        drop(f);
+
+        let child = dir.path().join("child.qcow2");
+        let _child_disk =
+            Qcow2Helper::create_cow_child_disk(&base, BackingFormat::Raw, &child, raw_size)
+                .unwrap();
+
+        let reports = std::sync::Mutex::new(Vec::new());
+        let dst = dir.path().join("flat.qcow2");
+        Qcow2Helper::flatten_with_progress(&child, &dst, &|p| reports.lock().unwrap().push(*p))
+            .unwrap();
+
+        let mut chain = Qcow2Helper::open_flatten_chain(&dst).unwrap();
+        for vc in 0..64 {
+            let expected = (vc == 5).then_some(6);
+            assert_eq!(cluster_marker(&mut chain, vc), expected, "cluster {vc}");
+        }
+        let last = *reports.lock().unwrap().last().unwrap();
+        assert_eq!(
+            last,
+            FlattenProgress {
+                bytes_total: raw_size,
+                bytes_done: raw_size,
+                bytes_written: cluster_size,
+            }
+        );
+    }
+
+    #[test]
+    fn test_flatten_keeps_cluster_order_across_batches() {
+        let dir = TempDir::new().unwrap();
+        let cluster_size = 1u64 << CLUSTER_BITS;
+        let clusters = FLATTEN_BATCH_CLUSTERS as u64 + 40;
+        let raw_size = cluster_size * clusters;
+
+        let base = dir.path().join("base.raw");
+        write_raw_disk(&base, raw_size);
+        let child = dir.path().join("child.qcow2");
+        let _child_disk =
+            Qcow2Helper::create_cow_child_disk(&base, BackingFormat::Raw, &child, raw_size)
+                .unwrap();
+
+        let reports = std::sync::Mutex::new(Vec::new());
+        let dst = dir.path().join("flat.qcow2");
+        Qcow2Helper::flatten_with_progress(&child, &dst, &|p| reports.lock().unwrap().push(*p))
+            .unwrap();
+
+        let mut chain = Qcow2Helper::open_flatten_chain(&dst).unwrap();
+        for vc in 0..clusters {
+            assert_eq!(cluster_marker(&mut chain, vc), Some(vc + 1), "cluster {vc}");
+        }
+
+        let reports = reports.into_inner().unwrap();
+        assert_eq!(reports.len(), 2, "one report per batch");
+        assert!(reports[0].bytes_done < reports[1].bytes_done);
+        assert_eq!(reports[1].bytes_done, raw_size);
+        assert_eq!(reports[1].bytes_written, raw_size);
+    }
+
+    #[test]
+    fn test_overlaps_extent() {
+        let extents = [(0, 10), (100, 200)];
+        assert!(overlaps_extent(&extents, 0, 5));
+        assert!(overlaps_extent(&extents, 8, 50));
+        assert!(!overlaps_extent(&extents, 10, 90));
+        assert!(overlaps_extent(&extents, 50, 51));
+        assert!(!overlaps_extent(&extents, 200, 10));
+        assert!(!overlaps_extent(&[], 0, 10));
+    }
+
     #[test]
     fn test_flatten_compressed_cluster_errors() {
         // Create a QCOW2 with a manually crafted compressed L2 entry.
@@ -0,0 +1,349 @@
+//! Host-wide, digest-keyed store of immutable base disks.
+//!
+//! Runtimes with different `BOXLITE_HOME`s build identical image disks and
+//! guest rootfs disks for the same image. When `BOXLITE_SHARED_DISK_CACHE`
+//! points at a directory on the same filesystem as the homes, each built
+//! disk is hard-linked into that store and later runtimes hard-link it back
+//! into their own cache instead of rebuilding. All homes then share one
+//! inode, so the disk is stored once and its page cache stays warm across
+//! runtimes. Paths inside each home are unchanged, so COW children, the
+//! jailer and GC keep working on home-local paths.
+//!
+//! # Layout
+//!
+//! ```text
+//! {root}/
+//! ├── disks/{key}    # one link per cached disk
+//! ├── used/{key}     # empty stamp; mtime = last publish or hit (LRU order)
+//! └── locks/0        # flock(2) lock guarding the store
+//! ```
+//!
+//! # Reference Counting
+//!
+//! A home that uses an entry holds a hard link to it, so the inode link
+//! count minus the store's own link is the number of homes referencing it.
+//! Eviction only removes entries nobody else links to, least recently used
+//! first, until the store fits `max_bytes`. Referenced entries are never
+//! evicted, even over budget.
+
+use std::fs;
+use std::os::unix::fs::MetadataExt;
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+use std::time::SystemTime;
+
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+
+use crate::lock::{FileLockManager, LockGuard, LockId, LockManager, Locker};
+
+/// Directory of the host-wide store. Unset disables sharing.
+const SHARED_DISK_CACHE_ENV: &str = "BOXLITE_SHARED_DISK_CACHE";
+/// Byte budget for unreferenced entries.
+const SHARED_DISK_CACHE_MAX_BYTES_ENV: &str = "BOXLITE_SHARED_DISK_CACHE_MAX_BYTES";
+const DEFAULT_MAX_BYTES: u64 = 20 * 1024 * 1024 * 1024;
+
+/// The single lock guarding the whole store.
+const STORE_LOCK: LockId = LockId(0);
+
+/// Host-wide store of immutable base disks shared across runtimes.
+#[derive(Clone)]
+pub(crate) struct SharedDiskCache {
+    root: PathBuf,
+    max_bytes: u64,
+    locks: Arc<FileLockManager>,
+}
+
+impl SharedDiskCache {
+    /// Open the store configured by `BOXLITE_SHARED_DISK_CACHE`, if any.
+    ///
+    /// A store that cannot be opened is logged and skipped: sharing is an
+    /// optimization and never blocks runtime startup.
+    pub(crate) fn from_env() -> Option<Self> {
+        let root = std::env::var_os(SHARED_DISK_CACHE_ENV).filter(|v| !v.is_empty())?;
+        let max_bytes = std::env::var(SHARED_DISK_CACHE_MAX_BYTES_ENV)
+            .ok()
+            .and_then(|s| s.parse().ok())
+            .unwrap_or(DEFAULT_MAX_BYTES);
+        match Self::open(PathBuf::from(root), max_bytes) {
+            Ok(cache) => Some(cache),
+            Err(e) => {
+                tracing::warn!(error = %e, "Shared disk cache unavailable, disks stay per-home");
+                None
+            }
+        }
+    }
+
+    pub(crate) fn open(root: PathBuf, max_bytes: u64) -> BoxliteResult<Self> {
+        for dir in [root.join("disks"), root.join("used")] {
+            fs::create_dir_all(&dir).map_err(|e| {
+                BoxliteError::Storage(format!(
+                    "Failed to create shared disk cache directory {}: {}",
+                    dir.display(),
+                    e
+                ))
+            })?;
+        }
+        let locks = FileLockManager::new(root.join("locks"))?;
+        Ok(Self {
+            root,
+            max_bytes,
+            locks: Arc::new(locks),
+        })
+    }
+
+    /// Hard-link the cached disk for `key` to `dest`.
+    ///
+    /// Returns `Ok(false)` on a miss, or when `dest` is on another
+    /// filesystem and the entry cannot be shared.
+    pub(crate) fn link_into(&self, key: &str, dest: &Path) -> BoxliteResult<bool> {
+        let entry = self.entry_path(key)?;
+        let lock = self.lock()?;
+        let _guard = LockGuard::new(lock.as_ref());
+
+        if !entry.exists() {
+            return Ok(false);
+        }
+        if !link_replacing(&entry, dest)? {
+            return Ok(false);
+        }
+        self.touch(key);
+        tracing::info!(key = %key, dest = %dest.display(), "Reused disk from shared cache");
+        Ok(true)
+    }
+
+    /// Publish the disk installed at `installed` under `key`.
+    ///
+    /// If another runtime published the same key first, `installed` is
+    /// replaced by a link to the existing entry so both share one inode.
+    /// Evicts unreferenced entries afterwards.
+    pub(crate) fn publish(&self, key: &str, installed: &Path) -> BoxliteResult<()> {
+        let entry = self.entry_path(key)?;
+        let lock = self.lock()?;
+        let _guard = LockGuard::new(lock.as_ref());
+
+        let shared = if entry.exists() {
+            link_replacing(&entry, installed)?
+        } else {
+            link_replacing(installed, &entry)?
+        };
+        if shared {
+            self.touch(key);
+            tracing::debug!(key = %key, "Published disk to shared cache");
+        }
+        self.evict_locked();
+        Ok(())
+    }
+
+    /// Evict unreferenced entries, least recently used first, until the
+    /// store fits its budget. Returns the bytes freed.
+    pub(crate) fn evict(&self) -> BoxliteResult<u64> {
+        let lock = self.lock()?;
+        let _guard = LockGuard::new(lock.as_ref());
+        Ok(self.evict_locked())
+    }
+
+    fn evict_locked(&self) -> u64 {
+        let Ok(dir) = fs::read_dir(self.root.join("disks")) else {
+            return 0;
+        };
+        let mut total = 0u64;
+        let mut idle: Vec<(SystemTime, u64, String)> = Vec::new();
+        for entry in dir.flatten() {
+            let Ok(meta) = entry.metadata() else { continue };
+            let Some(key) = entry.file_name().to_str().map(str::to_string) else {
+                continue;
+            };
+            let bytes = meta.blocks() * 512;
+            total += bytes;
+            if meta.nlink() <= 1 {
+                let used = fs::metadata(self.root.join("used").join(&key))
+                    .and_then(|m| m.modified())
+                    .unwrap_or(SystemTime::UNIX_EPOCH);
+                idle.push((used, bytes, key));
+            }
+        }
+
+        idle.sort();
+        let mut freed = 0u64;
+        for (_, bytes, key) in idle {
+            if total <= self.max_bytes {
+                break;
+            }
+            if fs::remove_file(self.root.join("disks").join(&key)).is_ok() {
+                let _ = fs::remove_file(self.root.join("used").join(&key));
+                total -= bytes;
+                freed += bytes;
+                tracing::info!(key = %key, bytes, "Evicted disk from shared cache");
+            }
+        }
+        freed
+    }
+
+    /// Record a use of `key` for LRU ordering.
+    fn touch(&self, key: &str) {
+        let stamp = self.root.join("used").join(key);
+        let result = fs::File::create(&stamp).and_then(|f| f.set_modified(SystemTime::now()));
+        if let Err(e) = result {
+            tracing::debug!(key = %key, error = %e, "Failed to stamp shared disk cache entry");
+        }
+    }
+
+    /// A fresh lock handle per operation: flock(2) excludes other open file
+    /// descriptions, so this serializes threads as well as processes.
+    fn lock(&self) -> BoxliteResult<Arc<dyn Locker>> {
+        self.locks
+            .retrieve(STORE_LOCK)
+            .or_else(|_| self.locks.allocate_and_retrieve(STORE_LOCK))
+            .or_else(|_| self.locks.retrieve(STORE_LOCK))
+    }
+
+    fn entry_path(&self, key: &str) -> BoxliteResult<PathBuf> {
+        if key.is_empty() || key.contains('/') || key.starts_with('.') {
+            return Err(BoxliteError::InvalidArgument(format!(
+                "invalid shared disk cache key: {:?}",
+                key
+            )));
+        }
+        Ok(self.root.join("disks").join(key))
+    }
+}
+
+/// Atomically make `dest` a hard link to `src`.
+///
+/// Returns `Ok(false)` when the two paths are on different filesystems.
+fn link_replacing(src: &Path, dest: &Path) -> BoxliteResult<bool> {
+    if let (Ok(a), Ok(b)) = (fs::metadata(src), fs::metadata(dest))
+        && a.dev() == b.dev()
+        && a.ino() == b.ino()
+    {
+        return Ok(true);
+    }
+
+    let staged = dest.with_extension("shared-link");
+    let _ = fs::remove_file(&staged);
+    if let Err(e) = fs::hard_link(src, &staged) {
+        if e.raw_os_error() == Some(libc::EXDEV) {
+            tracing::warn!(
+                src = %src.display(),
+                dest = %dest.display(),
+                "Shared disk cache is on another filesystem, not sharing"
+            );
+            return Ok(false);
+        }
+        return Err(BoxliteError::Storage(format!(
+            "Failed to link {} to {}: {}",
+            src.display(),
+            staged.display(),
+            e
+        )));
+    }
+    fs::rename(&staged, dest).map_err(|e| {
+        let _ = fs::remove_file(&staged);
+        BoxliteError::Storage(format!(
+            "Failed to install shared disk link {}: {}",
+            dest.display(),
+            e
+        ))
+    })?;
+    Ok(true)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use tempfile::TempDir;
+
+    const MIB: usize = 1024 * 1024;
+
+    fn write_disk(path: &Path, len: usize) {
+        fs::create_dir_all(path.parent().unwrap()).unwrap();
+        fs::write(path, vec![0xa5u8; len]).unwrap();
+    }
+
+    fn same_inode(a: &Path, b: &Path) -> bool {
+        let (a, b) = (fs::metadata(a).unwrap(), fs::metadata(b).unwrap());
+        a.dev() == b.dev() && a.ino() == b.ino()
+    }
+
+    #[test]
+    fn test_second_home_reuses_published_disk() {
+        let dir = TempDir::new().unwrap();
+        let cache = SharedDiskCache::open(dir.path().join("shared"), u64::MAX).unwrap();
+        let home_a = dir.path().join("a/disk-images/sha256-abc.ext4");
+        let home_b = dir.path().join("b/disk-images/sha256-abc.ext4");
+        fs::create_dir_all(home_b.parent().unwrap()).unwrap();
+
+        assert!(!cache.link_into("sha256-abc.ext4", &home_b).unwrap());
+
+        write_disk(&home_a, 4096);
+        cache.publish("sha256-abc.ext4", &home_a).unwrap();
+        assert!(cache.link_into("sha256-abc.ext4", &home_b).unwrap());
+
+        assert!(same_inode(&home_a, &home_b));
+        assert_eq!(fs::metadata(&home_a).unwrap().nlink(), 3);
+    }
+
+    #[test]
+    fn test_publish_race_adopts_existing_entry() {
+        let dir = TempDir::new().unwrap();
+        let cache = SharedDiskCache::open(dir.path().join("shared"), u64::MAX).unwrap();
+        let first = dir.path().join("a/disk.ext4");
+        let second = dir.path().join("b/disk.ext4");
+        write_disk(&first, 4096);
+        write_disk(&second, 4096);
+
+        cache.publish("disk.ext4", &first).unwrap();
+        cache.publish("disk.ext4", &second).unwrap();
+
+        assert!(same_inode(&first, &second));
+    }
+
+    #[test]
+    fn test_evicts_only_unreferenced_entries_lru_first() {
+        let dir = TempDir::new().unwrap();
+        let cache = SharedDiskCache::open(dir.path().join("shared"), u64::MAX).unwrap();
+        for key in ["old.ext4", "new.ext4", "held.ext4"] {
+            let home = dir.path().join("home").join(key);
+            write_disk(&home, MIB);
+            cache.publish(key, &home).unwrap();
+        }
+        // Homes let go of "old" and "new"; "held" keeps its reference.
+        fs::remove_file(dir.path().join("home/old.ext4")).unwrap();
+        fs::remove_file(dir.path().join("home/new.ext4")).unwrap();
+        let past = SystemTime::now() - std::time::Duration::from_secs(3600);
+        fs::File::options()
+            .write(true)
+            .open(cache.root.join("used/old.ext4"))
+            .unwrap()
+            .set_modified(past)
+            .unwrap();
+
+        let tight = SharedDiskCache {
+            max_bytes: 5 * MIB as u64 / 2,
+            ..cache.clone()
+        };
+        assert!(tight.evict().unwrap() >= MIB as u64);
+        assert!(!cache.root.join("disks/old.ext4").exists());
+        assert!(cache.root.join("disks/new.ext4").exists());
+
+        let empty = SharedDiskCache {
+            max_bytes: 0,
+            ..cache.clone()
+        };
+        empty.evict().unwrap();
+        assert!(!cache.root.join("disks/new.ext4").exists());
+        assert!(
+            cache.root.join("disks/held.ext4").exists(),
+            "referenced entries are never evicted"
+        );
+    }
+
+    #[test]
+    fn test_rejects_path_like_keys() {
+        let dir = TempDir::new().unwrap();
+        let cache = SharedDiskCache::open(dir.path().to_path_buf(), u64::MAX).unwrap();
+        let dest = dir.path().join("x");
+        assert!(cache.link_into("../escape", &dest).is_err());
+        assert!(cache.link_into("", &dest).is_err());
+    }
+}
@@ -1,55 +1,275 @@
 //! Auto-detecting decompressor for OCI layer tarballs.
 //!
-//! OCI allows both gzip-compressed (`application/vnd.oci.image.layer.v1.tar+gzip`)
-//! and uncompressed layer media types. We sniff the 2-byte gzip magic instead
-//! of trusting the media type, so the extractor and the diff-ID verifier share
-//! one source of truth.
+//! OCI allows gzip (`application/vnd.oci.image.layer.v1.tar+gzip`), zstd
+//! (`...tar+zstd`) and uncompressed layer media types. We sniff the magic
+//! bytes instead of trusting the media type, so the extractor and the
+//! diff-ID verifier share one source of truth.
+//!
+//! Seekable layer formats decode through the same path: eStargz is a
+//! sequence of concatenated gzip members (one per file chunk plus a TOC
+//! member), and zstd:chunked is a sequence of zstd frames followed by a
+//! skippable metadata frame.
 
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
-use flate2::read::GzDecoder;
+use flate2::read::MultiGzDecoder;
+use std::cell::RefCell;
 use std::fs;
-use std::io::{BufReader, Read};
+use std::io::{BufReader, Cursor, Read};
 use std::path::Path;
+use std::rc::Rc;
 use tracing::debug;
 
-/// Opens OCI layer tarballs, transparently decompressing gzip when present.
+const GZIP_MAGIC: [u8; 2] = [0x1f, 0x8b];
+const ZSTD_MAGIC: [u8; 4] = [0x28, 0xb5, 0x2f, 0xfd];
+
+/// Gzip header flag: an extra field follows the fixed header.
+const GZIP_FEXTRA: u8 = 0x04;
+
+/// The eStargz footer: an empty gzip member whose extra field (subfield
+/// `SG`) carries the TOC offset as 16 hex digits followed by `STARGZ`.
+const ESTARGZ_FOOTER_SIZE: usize = 51;
+
+/// The legacy stargz footer: the same, without the subfield header.
+const LEGACY_STARGZ_FOOTER_SIZE: usize = 47;
+
+/// Opens OCI layer tarballs, transparently decompressing gzip or zstd when
+/// present.
 pub(super) struct TarballReader;
 
 impl TarballReader {
-    /// Return a reader over the uncompressed tar stream. Detects gzip by the
-    /// two-byte magic `1f 8b`; anything else is treated as raw tar.
+    /// Return a reader over the uncompressed tar stream of `tarball_path`.
     pub(super) fn open(tarball_path: &Path) -> BoxliteResult<Box<dyn Read>> {
-        let mut header = [0u8; 2];
-        {
-            let probe = fs::File::open(tarball_path).map_err(|e| {
-                BoxliteError::Storage(format!(
-                    "Failed to open layer tarball {}: {}",
-                    tarball_path.display(),
-                    e
-                ))
-            })?;
-            (&probe).take(2).read_exact(&mut header).map_err(|e| {
-                BoxliteError::Storage(format!("Failed to read layer header: {}", e))
-            })?;
-        }
+        let file = fs::File::open(tarball_path).map_err(|e| {
+            BoxliteError::Storage(format!(
+                "Failed to open layer tarball {}: {}",
+                tarball_path.display(),
+                e
+            ))
+        })?;
+        debug!("Opening layer tarball {}", tarball_path.display());
+        Self::wrap(BufReader::new(file))
+    }
 
+    /// Like [`Self::open`], also returning a probe that tells, once the
+    /// stream has been read to the end, whether the layer is eStargz.
+    pub(super) fn open_probed(tarball_path: &Path) -> BoxliteResult<(Box<dyn Read>, EstargzProbe)> {
         let file = fs::File::open(tarball_path).map_err(|e| {
             BoxliteError::Storage(format!(
-                "Failed to reopen layer tarball {}: {}",
+                "Failed to open layer tarball {}: {}",
                 tarball_path.display(),
                 e
             ))
         })?;
+        debug!("Opening layer tarball {}", tarball_path.display());
+        Self::wrap_probed(BufReader::new(file))
+    }
 
-        if header == [0x1f, 0x8b] {
-            debug!("Detected gzip compression for {}", tarball_path.display());
-            Ok(Box::new(GzDecoder::new(BufReader::new(file))))
+    /// Like [`Self::wrap`], also returning an [`EstargzProbe`].
+    pub(super) fn wrap_probed<R: Read + 'static>(
+        reader: R,
+    ) -> BoxliteResult<(Box<dyn Read>, EstargzProbe)> {
+        let probe = EstargzProbe::default();
+        let reader = Self::wrap(Probed {
+            inner: reader,
+            probe: probe.clone(),
+        })?;
+        Ok((reader, probe))
+    }
+
+    /// Return a reader over the uncompressed tar stream carried by `reader`.
+    ///
+    /// Detects gzip by the magic `1f 8b` and zstd by `28 b5 2f fd`; anything
+    /// else is treated as raw tar. Gzip is decoded member by member to the
+    /// end of the stream, so eStargz layers yield every entry. Only the first
+    /// four bytes are consumed up front, so `reader` may be a non-seekable
+    /// stream such as a blob still being downloaded.
+    pub(super) fn wrap<R: Read + 'static>(mut reader: R) -> BoxliteResult<Box<dyn Read>> {
+        let mut header = [0u8; 4];
+        let mut len = 0;
+        while len < header.len() {
+            match reader.read(&mut header[len..]) {
+                Ok(0) => break,
+                Ok(n) => len += n,
+                Err(e) if e.kind() == std::io::ErrorKind::Interrupted => {}
+                Err(e) => {
+                    return Err(BoxliteError::Storage(format!(
+                        "Failed to read layer header: {}",
+                        e
+                    )));
+                }
+            }
+        }
+        if len < GZIP_MAGIC.len() {
+            return Err(BoxliteError::Storage(format!(
+                "Failed to read layer header: only {} bytes",
+                len
+            )));
+        }
+
+        let stream = Cursor::new(header[..len].to_vec()).chain(reader);
+        if header[..2] == GZIP_MAGIC {
+            debug!("Detected gzip compression");
+            Ok(Box::new(MultiGzDecoder::new(stream)))
+        } else if header[..len] == ZSTD_MAGIC {
+            debug!("Detected zstd compression");
+            let decoder = zstd::stream::read::Decoder::new(stream).map_err(|e| {
+                BoxliteError::Storage(format!("Failed to create zstd decoder: {}", e))
+            })?;
+            Ok(Box::new(decoder))
         } else {
-            debug!(
-                "Detected uncompressed tarball for {}",
-                tarball_path.display()
-            );
-            Ok(Box::new(BufReader::new(file)))
+            debug!("Detected uncompressed tarball");
+            Ok(Box::new(stream))
+        }
+    }
+}
+
+/// Keeps the last compressed bytes of a layer to recognise the eStargz
+/// footer, which only the end of the stream carries.
+#[derive(Clone, Default)]
+pub(super) struct EstargzProbe {
+    tail: Rc<RefCell<Vec<u8>>>,
+}
+
+impl EstargzProbe {
+    /// Whether the bytes read so far end with an eStargz (or legacy
+    /// stargz) footer. Meaningful once the stream is at its end.
+    pub(super) fn is_estargz(&self) -> bool {
+        is_estargz_footer(&self.tail.borrow())
+    }
+
+    fn record(&self, data: &[u8]) {
+        let mut tail = self.tail.borrow_mut();
+        tail.extend_from_slice(&data[data.len().saturating_sub(ESTARGZ_FOOTER_SIZE)..]);
+        let excess = tail.len().saturating_sub(ESTARGZ_FOOTER_SIZE);
+        tail.drain(..excess);
+    }
+}
+
+/// Feeds everything read from `inner` to an [`EstargzProbe`].
+struct Probed<R> {
+    inner: R,
+    probe: EstargzProbe,
+}
+
+impl<R: Read> Read for Probed<R> {
+    fn read(&mut self, buf: &mut [u8]) -> std::io::Result<usize> {
+        let n = self.inner.read(buf)?;
+        self.probe.record(&buf[..n]);
+        Ok(n)
+    }
+}
+
+fn is_estargz_footer(tail: &[u8]) -> bool {
+    let footer = |size: usize| tail.len().checked_sub(size).map(|start| &tail[start..]);
+    let has_extra = |footer: &[u8], xlen: u16| {
+        footer[..2] == GZIP_MAGIC
+            && footer[3] & GZIP_FEXTRA != 0
+            && footer[10..12] == xlen.to_le_bytes()
+    };
+    if let Some(footer) = footer(ESTARGZ_FOOTER_SIZE)
+        && has_extra(footer, 26)
+        && footer[12..14] == *b"SG"
+        && footer[32..38] == *b"STARGZ"
+    {
+        return true;
+    }
+    footer(LEGACY_STARGZ_FOOTER_SIZE)
+        .is_some_and(|footer| has_extra(footer, 22) && footer[28..34] == *b"STARGZ")
+}
+
+/// The eStargz footer for a TOC at `toc_offset`, byte for byte as eStargz
+/// writers emit it.
+#[cfg(test)]
+pub(super) fn estargz_footer(toc_offset: u64) -> Vec<u8> {
+    let mut footer = vec![0x1f, 0x8b, 0x08, GZIP_FEXTRA, 0, 0, 0, 0, 0, 0xff];
+    footer.extend_from_slice(&26u16.to_le_bytes());
+    footer.extend_from_slice(b"SG");
+    footer.extend_from_slice(&22u16.to_le_bytes());
+    footer.extend_from_slice(format!("{:016x}STARGZ", toc_offset).as_bytes());
+    // Empty final stored block, then CRC32 and size of no data.
+    footer.extend_from_slice(&[0x01, 0x00, 0x00, 0xff, 0xff]);
+    footer.extend_from_slice(&[0; 8]);
+    footer
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::io::Write;
+
+    fn tar_bytes() -> Vec<u8> {
+        let mut builder = tar::Builder::new(Vec::new());
+        let mut header = tar::Header::new_gnu();
+        header.set_path("hello.txt").unwrap();
+        header.set_size(5);
+        header.set_mode(0o644);
+        header.set_cksum();
+        builder.append(&header, &b"hello"[..]).unwrap();
+        builder.into_inner().unwrap()
+    }
+
+    fn decoded(bytes: Vec<u8>) -> Vec<u8> {
+        let mut out = Vec::new();
+        TarballReader::wrap(Cursor::new(bytes))
+            .unwrap()
+            .read_to_end(&mut out)
+            .unwrap();
+        out
+    }
+
+    #[test]
+    fn wrap_detects_raw_gzip_and_zstd() {
+        let tar = tar_bytes();
+
+        let mut gz = flate2::write::GzEncoder::new(Vec::new(), flate2::Compression::fast());
+        gz.write_all(&tar).unwrap();
+        let gz = gz.finish().unwrap();
+
+        let zst = zstd::encode_all(&tar[..], 3).unwrap();
+
+        assert_eq!(decoded(tar.clone()), tar);
+        assert_eq!(decoded(gz), tar);
+        assert_eq!(decoded(zst), tar);
+    }
+
+    #[test]
+    fn wrap_decodes_every_gzip_member_and_zstd_frame() {
+        let tar = tar_bytes();
+        let (head, tail) = tar.split_at(512);
+
+        let mut gz = Vec::new();
+        let mut zst = Vec::new();
+        for part in [head, tail] {
+            let mut member = flate2::write::GzEncoder::new(Vec::new(), flate2::Compression::fast());
+            member.write_all(part).unwrap();
+            gz.extend(member.finish().unwrap());
+            zst.extend(zstd::encode_all(part, 3).unwrap());
         }
+
+        assert_eq!(decoded(gz), tar);
+        assert_eq!(decoded(zst), tar);
+    }
+
+    #[test]
+    fn probe_recognises_the_estargz_footer() {
+        let mut layer = flate2::write::GzEncoder::new(Vec::new(), flate2::Compression::fast());
+        layer.write_all(&tar_bytes()).unwrap();
+        let plain = layer.finish().unwrap();
+        let mut estargz = plain.clone();
+        estargz.extend(estargz_footer(plain.len() as u64));
+        assert_eq!(estargz.len() - plain.len(), ESTARGZ_FOOTER_SIZE);
+
+        for (layer, expected) in [(plain, false), (estargz, true)] {
+            let (mut reader, probe) = TarballReader::wrap_probed(Cursor::new(layer)).unwrap();
+            let mut out = Vec::new();
+            reader.read_to_end(&mut out).unwrap();
+            assert_eq!(out, tar_bytes());
+            assert_eq!(probe.is_estargz(), expected);
+        }
+    }
+
+    #[test]
+    fn wrap_rejects_truncated_header() {
+        assert!(TarballReader::wrap(Cursor::new(vec![0x1f])).is_err());
     }
 }
@@ -1,6 +1,6 @@
 //! Streaming OCI tar layer applier (containerd-style).
 
-use super::compression::TarballReader;
+use super::compression::{EstargzProbe, TarballReader};
 use super::metadata::EntryMetadata;
 use super::override_stat::{OverrideFileType, OverrideStat};
 use super::safe_root::SafeRoot;
@@ -63,8 +63,8 @@ impl<'a> LayerExtractor<'a> {
     /// The caller MUST call [`Self::finalize`] after all layers have been
     /// extracted, or directory permissions will not be applied.
     pub fn extract_tarball(&mut self, tarball_path: &Path) -> BoxliteResult<u64> {
-        let reader = TarballReader::open(tarball_path)?;
-        self.extract_reader(reader)
+        let (reader, probe) = TarballReader::open_probed(tarball_path)?;
+        self.extract_reader_with_whiteout_mode(reader, WhiteoutMode::Apply, Some(&probe))
     }
 
     /// Unpack a layer into a standalone cached layer directory.
@@ -75,8 +75,19 @@ impl<'a> LayerExtractor<'a> {
         &mut self,
         tarball_path: &Path,
     ) -> BoxliteResult<u64> {
-        let reader = TarballReader::open(tarball_path)?;
-        self.extract_reader_with_whiteout_mode(reader, WhiteoutMode::Preserve)
+        let (reader, probe) = TarballReader::open_probed(tarball_path)?;
+        self.extract_reader_with_whiteout_mode(reader, WhiteoutMode::Preserve, Some(&probe))
+    }
+
+    /// Like [`Self::extract_tarball_preserving_whiteouts`], but reads the
+    /// (possibly compressed) layer blob from `blob` as it arrives instead of
+    /// from a file. The caller MUST call [`Self::finalize`].
+    pub(crate) fn extract_blob_preserving_whiteouts<R: Read + 'static>(
+        &mut self,
+        blob: R,
+    ) -> BoxliteResult<u64> {
+        let (reader, probe) = TarballReader::wrap_probed(blob)?;
+        self.extract_reader_with_whiteout_mode(reader, WhiteoutMode::Preserve, Some(&probe))
     }
 
     /// Apply an already-decompressed tar stream.
@@ -84,7 +95,7 @@ impl<'a> LayerExtractor<'a> {
     /// The caller MUST call [`Self::finalize`] after all layers have been
     /// extracted, or directory permissions will not be applied.
     pub fn extract_reader<R: Read>(&mut self, reader: R) -> BoxliteResult<u64> {
-        self.extract_reader_with_whiteout_mode(reader, WhiteoutMode::Apply)
+        self.extract_reader_with_whiteout_mode(reader, WhiteoutMode::Apply, None)
     }
 
     /// Apply all deferred directory metadata (deepest-first) and consume
@@ -97,10 +108,13 @@ impl<'a> LayerExtractor<'a> {
         self.deferred_dirs.apply()
     }
 
+    /// `estargz` watches the compressed layer; root-level eStargz metadata
+    /// is removed again if it turns out to be eStargz.
     fn extract_reader_with_whiteout_mode<R: Read>(
         &mut self,
         reader: R,
         whiteout_mode: WhiteoutMode,
+        estargz: Option<&EstargzProbe>,
     ) -> BoxliteResult<u64> {
         let root = SafeRoot::open(self.dest)?;
         let is_root = unsafe { libc::geteuid() } == 0;
@@ -108,6 +122,9 @@ impl<'a> LayerExtractor<'a> {
         let mut unpacked_paths: HashSet<PathBuf> = HashSet::new();
         let mut total_size = 0u64;
         let mut deferred_hardlinks: Vec<DeferredHardlink> = Vec::new();
+        // Only the footer at the end of the layer says whether it is
+        // eStargz, so its metadata entries are unpacked and removed after.
+        let mut seekable_metadata: Vec<PathBuf> = Vec::new();
 
         for entry_result in archive
             .entries()
@@ -133,6 +150,12 @@ impl<'a> LayerExtractor<'a> {
             }
 
             let entry_type = entry.header().entry_type();
+            if estargz.is_some()
+                && entry_type == EntryType::Regular
+                && is_seekable_layer_metadata(&normalized)
+            {
+                seekable_metadata.push(normalized.clone());
+            }
             let mode = entry.header().mode().unwrap_or(0o755);
             let uid = entry.header().uid().unwrap_or(0);
             let gid = entry.header().gid().unwrap_or(0);
@@ -390,6 +413,30 @@ impl<'a> LayerExtractor<'a> {
             apply_permissions_and_times(&link_safe, EntryType::Link, &deferred.meta)?;
         }
 
+        if let Some(probe) = estargz
+            && !seekable_metadata.is_empty()
+        {
+            // The footer follows the end-of-archive blocks.
+            io::copy(&mut archive.into_inner(), &mut io::sink()).map_err(|e| {
+                BoxliteError::Storage(format!("Failed to read layer footer: {}", e))
+            })?;
+            if probe.is_estargz() {
+                for rel in &seekable_metadata {
+                    let path = root.root_path().join(rel);
+                    if fs::symlink_metadata(&path).is_ok_and(|m| m.is_file()) {
+                        debug!("Removing eStargz metadata entry: {}", rel.display());
+                        fs::remove_file(&path).map_err(|e| {
+                            BoxliteError::Storage(format!(
+                                "Failed to remove {}: {}",
+                                rel.display(),
+                                e
+                            ))
+                        })?;
+                    }
+                }
+            }
+        }
+
         // Directory metadata is finalized by the caller via DeferredDirs::apply,
         // not per layer. Hoisting that sweep across layers is what fixes the
         // cross-layer EACCES (cross_layer_overwrite_through_readonly_parent_dir).
@@ -729,6 +776,22 @@ impl DeferredDirs {
     }
 }
 
+/// Root-level entries that eStargz writers add for lazy pulling: the TOC and
+/// the prefetch landmarks. They carry no container content in an eStargz
+/// layer; in any other layer they are ordinary files.
+const SEEKABLE_LAYER_METADATA: [&str; 3] = [
+    "stargz.index.json",
+    ".prefetch.landmark",
+    ".no.prefetch.landmark",
+];
+
+fn is_seekable_layer_metadata(normalized: &Path) -> bool {
+    normalized.components().count() == 1
+        && SEEKABLE_LAYER_METADATA
+            .iter()
+            .any(|name| normalized.as_os_str() == *name)
+}
+
 struct DeferredHardlink {
     link_rel: PathBuf,
     target_rel: PathBuf,
@@ -1467,6 +1530,52 @@ mod tests {
         }
     }
 
+    #[test]
+    fn estargz_layer_extracts_all_members_without_metadata() {
+        let tmp = tempfile::tempdir().unwrap();
+        let dest = tmp.path().join("extract");
+        let tar = create_raw_tar(&[
+            raw_dir("etc"),
+            raw_file("etc/hostname", b"box"),
+            raw_file(".prefetch.landmark", b"\x0f"),
+            raw_file("usr/bin/tool", b"tool"),
+            raw_file("etc/stargz.index.json", b"not toc"),
+            raw_file("stargz.index.json", b"{\"version\":1}"),
+        ]);
+
+        // eStargz splits the stream into one gzip member per entry and
+        // ends it with a footer pointing at the TOC.
+        let mut layer = Vec::new();
+        for chunk in tar.chunks(512) {
+            layer.extend(create_gzipped_tar(chunk));
+        }
+        let plain_path = tmp.path().join("plain.tar.gz");
+        fs::write(&plain_path, &layer).unwrap();
+        layer.extend(super::super::compression::estargz_footer(0));
+        let tar_path = tmp.path().join("layer.tar.gz");
+        fs::write(&tar_path, layer).unwrap();
+
+        extract(&tar_path, &dest).unwrap();
+
+        assert_eq!(fs::read(dest.join("etc/hostname")).unwrap(), b"box");
+        assert_eq!(fs::read(dest.join("usr/bin/tool")).unwrap(), b"tool");
+        assert_eq!(
+            fs::read(dest.join("etc/stargz.index.json")).unwrap(),
+            b"not toc"
+        );
+        assert!(!dest.join("stargz.index.json").exists());
+        assert!(!dest.join(".prefetch.landmark").exists());
+
+        // Without the footer the same names are ordinary files.
+        let plain_dest = tmp.path().join("plain");
+        extract(&plain_path, &plain_dest).unwrap();
+        assert_eq!(
+            fs::read(plain_dest.join("stargz.index.json")).unwrap(),
+            b"{\"version\":1}"
+        );
+        assert!(plain_dest.join(".prefetch.landmark").exists());
+    }
+
     #[test]
     fn umoci_wh_prefix_directory_is_not_a_whiteout() {
         let tmp = tempfile::tempdir().unwrap();
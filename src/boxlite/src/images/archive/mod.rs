@@ -2,7 +2,7 @@
 //!
 //! Mirrors containerd's layout: `extractor` performs the streaming layer
 //! apply, `verifier` checks DiffIDs, `compression` opens tarballs with
-//! transparent gzip detection, `metadata` groups per-entry header data,
+//! transparent gzip/zstd detection, `metadata` groups per-entry header data,
 //! `time` provides time helpers, `override_stat` provides rootless container
 //! support, `safe_root` enforces containment.
 
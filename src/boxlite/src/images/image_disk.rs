@@ -8,7 +8,7 @@ use std::path::PathBuf;
 
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 
-use crate::disk::{Disk, DiskFormat, create_ext4_from_dir};
+use crate::disk::{Disk, DiskFormat, SharedDiskCache, create_ext4_from_dir};
 use crate::rootfs::RootfsBuilder;
 
 use super::ImageObject;
@@ -29,10 +29,14 @@ use super::ImageObject;
 ///
 /// No internal locking is needed.
 ///
+/// With a [`SharedDiskCache`], a miss is first served by hard-linking the
+/// host-wide copy, and freshly built disks are published to it.
+///
 /// Cache location: `~/.boxlite/images/disk-images/`
 pub struct ImageDiskManager {
     cache_dir: PathBuf,
     temp_dir: PathBuf,
+    shared: Option<SharedDiskCache>,
 }
 
 impl ImageDiskManager {
@@ -40,9 +44,16 @@ impl ImageDiskManager {
         Self {
             cache_dir,
             temp_dir,
+            shared: None,
         }
     }
 
+    /// Share built disks with other runtimes on this host.
+    pub(crate) fn with_shared_cache(mut self, shared: Option<SharedDiskCache>) -> Self {
+        self.shared = shared;
+        self
+    }
+
     /// Get or create an ext4 disk image for the given OCI image.
     ///
     /// Returns a persistent `Disk` (won't be cleaned up on drop).
@@ -56,8 +67,40 @@ impl ImageDiskManager {
             return Ok(disk);
         }
 
+        if let Some(disk) = self.find_shared(&digest) {
+            return Ok(disk);
+        }
+
         tracing::info!("Building image disk for {} (first time)", digest);
-        self.build_and_install(image, &digest).await
+        let disk = self.build_and_install(image, &digest).await?;
+        if let Some(shared) = &self.shared
+            && let Err(e) = shared.publish(&Self::disk_filename(&digest), disk.path())
+        {
+            tracing::warn!(
+                "Failed to publish image disk {} to shared cache: {}",
+                digest,
+                e
+            );
+        }
+        Ok(disk)
+    }
+
+    /// Link a disk built by another runtime on this host into the cache.
+    fn find_shared(&self, digest: &str) -> Option<Disk> {
+        let shared = self.shared.as_ref()?;
+        let path = self.disk_path(digest);
+        if let Err(e) = fs::create_dir_all(&self.cache_dir) {
+            tracing::warn!("Failed to create {}: {}", self.cache_dir.display(), e);
+            return None;
+        }
+        match shared.link_into(&Self::disk_filename(digest), &path) {
+            Ok(true) => Some(Disk::new(path, DiskFormat::Ext4, true)),
+            Ok(false) => None,
+            Err(e) => {
+                tracing::warn!("Shared disk cache lookup for {} failed: {}", digest, e);
+                None
+            }
+        }
     }
 
     /// Look up a cached disk by image digest.
@@ -141,8 +184,11 @@ impl ImageDiskManager {
     ///
     /// Format matches `storage.rs:disk_image_path()`: `{digest}.ext4`
     fn disk_path(&self, digest: &str) -> PathBuf {
-        let filename = digest.replace(':', "-");
-        self.cache_dir.join(format!("{}.ext4", filename))
+        self.cache_dir.join(Self::disk_filename(digest))
+    }
+
+    fn disk_filename(digest: &str) -> String {
+        format!("{}.ext4", digest.replace(':', "-"))
     }
 }
 
@@ -211,6 +257,36 @@ mod tests {
         let _ = result.leak();
     }
 
+    #[test]
+    fn test_find_shared_links_disk_from_other_home() {
+        use std::os::unix::fs::MetadataExt;
+
+        let dir = tempfile::TempDir::new().unwrap();
+        let shared = SharedDiskCache::open(dir.path().join("shared"), u64::MAX).unwrap();
+        let home_a = dir.path().join("a");
+        let home_b = dir.path().join("b");
+        let mgr_a = ImageDiskManager::new(home_a.clone(), dir.path().to_path_buf())
+            .with_shared_cache(Some(shared.clone()));
+        let mgr_b = ImageDiskManager::new(home_b.clone(), dir.path().to_path_buf())
+            .with_shared_cache(Some(shared.clone()));
+
+        assert!(mgr_b.find_shared("sha256:abc").is_none());
+
+        let built = home_a.join("sha256-abc.ext4");
+        std::fs::create_dir_all(&home_a).unwrap();
+        std::fs::write(&built, "image disk").unwrap();
+        shared.publish("sha256-abc.ext4", &built).unwrap();
+
+        let disk = mgr_b.find_shared("sha256:abc").unwrap();
+        assert_eq!(disk.path(), home_b.join("sha256-abc.ext4"));
+        assert_eq!(
+            std::fs::metadata(disk.path()).unwrap().ino(),
+            std::fs::metadata(&built).unwrap().ino()
+        );
+        assert!(mgr_a.find("sha256:abc").is_some());
+        let _ = disk.leak();
+    }
+
     #[test]
     fn test_install_race_safe() {
         let dir = tempfile::TempDir::new().unwrap();
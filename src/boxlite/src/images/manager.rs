@@ -16,6 +16,7 @@ use chrono::{DateTime, Utc};
 
 use super::blob_source::{BlobSource, LocalBundleBlobSource, StoreBlobSource};
 use super::object::ImageObject;
+use super::progress::ImagePullOptions;
 use crate::db::Database;
 use crate::images::store::{ImageStore, SharedImageStore};
 use crate::runtime::options::ImageRegistry;
@@ -115,7 +116,18 @@ impl ImageManager {
     /// Thread Safety: `ImageStore` handles locking internally. Multiple
     /// concurrent pulls of the same image will only download once.
     pub async fn pull(&self, image_ref: &str) -> BoxliteResult<ImageObject> {
-        let manifest = self.store.pull(image_ref).await?;
+        self.pull_with(image_ref, &ImagePullOptions::default())
+            .await
+    }
+
+    /// [`pull`](Self::pull) with per-pull layer concurrency and progress
+    /// reporting.
+    pub async fn pull_with(
+        &self,
+        image_ref: &str,
+        options: &ImagePullOptions,
+    ) -> BoxliteResult<ImageObject> {
+        let manifest = self.store.pull_with(image_ref, options).await?;
         let storage = self.store.storage().await;
         let blob_source = BlobSource::Store(StoreBlobSource::new(storage));
 
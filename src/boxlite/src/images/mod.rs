@@ -4,6 +4,7 @@ mod config;
 mod image_disk;
 mod manager;
 mod object;
+mod progress;
 mod storage;
 mod store;
 
@@ -12,6 +13,7 @@ pub use config::ContainerImageConfig;
 pub use image_disk::ImageDiskManager;
 pub use manager::ImageManager;
 pub use object::ImageObject;
+pub use progress::{ImagePullOptions, ImagePullProgress, ImagePullProgressFn};
 
 use oci_client::Reference;
 
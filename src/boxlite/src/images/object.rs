@@ -259,8 +259,8 @@ impl ImageObject {
                 Err(e) => {
                     // The historical comment here claimed this branch
                     // existed for "unsupported format" — but TarballReader
-                    // only distinguishes gzip vs raw (treats anything
-                    // that isn't gzip magic as raw tar), so an
+                    // only distinguishes gzip/zstd vs raw (treats anything
+                    // without a known magic as raw tar), so an
                     // unsupported compression format surfaces as
                     // Ok(false) hash mismatch, not Err. The Err variants
                     // are real IO failures (file missing, mid-stream
@@ -511,7 +511,7 @@ mod tests {
     // A real IO error during verify_tarball (e.g. the layer tarball doesn't
     // exist on disk) is a verification gap, not an unverifiable layer — the
     // historical "skip on Err" branch claimed to be for "unsupported format",
-    // but TarballReader treats anything that isn't gzip magic as raw tar
+    // but TarballReader treats anything without gzip/zstd magic as raw tar
     // (unsupported-compression surfaces as Ok(false) hash mismatch). With the
     // fix reverted to skip-on-Err, this returns Ok and the assertion fails.
     #[test]
@@ -0,0 +1,259 @@
+//! Image pull options and progress reporting.
+//!
+//! `ImagePullOptions` is threaded from `ImageHandle::pull_with` down to the
+//! layer downloads in `ImageStore`. `PullTracker` aggregates byte and layer
+//! counts across the concurrent downloads and forwards throttled
+//! `ImagePullProgress` snapshots to the caller's callback.
+
+use std::sync::{Arc, Mutex};
+use std::time::{Duration, Instant};
+
+/// Layer blobs fetched at once when `max_concurrent_layers` is unset.
+pub(super) const DEFAULT_MAX_CONCURRENT_LAYERS: usize = 3;
+
+/// Minimum time between two byte-progress callbacks. Layer completions
+/// and the final snapshot are always reported.
+const PROGRESS_INTERVAL: Duration = Duration::from_millis(200);
+
+/// Callback receiving pull progress snapshots.
+pub type ImagePullProgressFn = Arc<dyn Fn(&ImagePullProgress) + Send + Sync>;
+
+/// Snapshot of an image pull in flight.
+#[derive(Clone, Debug, Default, PartialEq)]
+pub struct ImagePullProgress {
+    /// Layers in the image.
+    pub layers_total: usize,
+    /// Layers downloaded and verified, including those already cached.
+    pub layers_completed: usize,
+    /// Compressed bytes of the layers that need downloading, as declared by
+    /// the manifest.
+    pub bytes_total: u64,
+    /// Compressed bytes downloaded so far.
+    pub bytes_downloaded: u64,
+    /// Time since the layer downloads started.
+    pub elapsed: Duration,
+}
+
+impl ImagePullProgress {
+    /// Average download throughput since the pull started.
+    pub fn bytes_per_second(&self) -> f64 {
+        per_second(self.bytes_downloaded as f64, self.elapsed)
+    }
+
+    /// Average layer completion rate since the pull started.
+    pub fn layers_per_second(&self) -> f64 {
+        per_second(self.layers_completed as f64, self.elapsed)
+    }
+}
+
+fn per_second(count: f64, elapsed: Duration) -> f64 {
+    let secs = elapsed.as_secs_f64();
+    if secs > 0.0 { count / secs } else { 0.0 }
+}
+
+/// Per-pull tuning for `ImageHandle::pull_with`.
+#[derive(Clone, Default)]
+pub struct ImagePullOptions {
+    /// Layer blobs downloaded concurrently. `None` uses the default (3).
+    pub max_concurrent_layers: Option<usize>,
+    /// Called with progress snapshots while layers download. Never called
+    /// concurrently, and not called at all when the image is already cached.
+    pub progress: Option<ImagePullProgressFn>,
+}
+
+impl ImagePullOptions {
+    pub fn with_max_concurrent_layers(mut self, layers: usize) -> Self {
+        self.max_concurrent_layers = Some(layers);
+        self
+    }
+
+    pub fn with_progress<F>(mut self, progress: F) -> Self
+    where
+        F: Fn(&ImagePullProgress) + Send + Sync + 'static,
+    {
+        self.progress = Some(Arc::new(progress));
+        self
+    }
+
+    pub(super) fn concurrency(&self) -> usize {
+        self.max_concurrent_layers
+            .unwrap_or(DEFAULT_MAX_CONCURRENT_LAYERS)
+            .max(1)
+    }
+}
+
+impl std::fmt::Debug for ImagePullOptions {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        f.debug_struct("ImagePullOptions")
+            .field("max_concurrent_layers", &self.max_concurrent_layers)
+            .field("progress", &self.progress.is_some())
+            .finish()
+    }
+}
+
+/// Shared progress counters for one pull's layer downloads.
+pub(super) struct PullTracker {
+    callback: Option<ImagePullProgressFn>,
+    started: Instant,
+    interval: Duration,
+    state: Mutex<TrackerState>,
+}
+
+struct TrackerState {
+    progress: ImagePullProgress,
+    last_emit: Option<Instant>,
+}
+
+impl PullTracker {
+    pub(super) fn new(
+        callback: Option<ImagePullProgressFn>,
+        layers_total: usize,
+        layers_cached: usize,
+        bytes_total: u64,
+    ) -> Self {
+        Self::with_interval(
+            callback,
+            layers_total,
+            layers_cached,
+            bytes_total,
+            PROGRESS_INTERVAL,
+        )
+    }
+
+    fn with_interval(
+        callback: Option<ImagePullProgressFn>,
+        layers_total: usize,
+        layers_cached: usize,
+        bytes_total: u64,
+        interval: Duration,
+    ) -> Self {
+        Self {
+            callback,
+            started: Instant::now(),
+            interval,
+            state: Mutex::new(TrackerState {
+                progress: ImagePullProgress {
+                    layers_total,
+                    layers_completed: layers_cached,
+                    bytes_total,
+                    ..Default::default()
+                },
+                last_emit: None,
+            }),
+        }
+    }
+
+    /// Record downloaded bytes; reports at most once per interval.
+    pub(super) fn add_bytes(&self, bytes: u64) {
+        self.update(false, |p| p.bytes_downloaded += bytes);
+    }
+
+    /// Take back the bytes of a failed attempt before it is retried.
+    pub(super) fn rewind_bytes(&self, bytes: u64) {
+        self.update(false, |p| {
+            p.bytes_downloaded = p.bytes_downloaded.saturating_sub(bytes)
+        });
+    }
+
+    /// Record a verified layer; always reported.
+    pub(super) fn layer_done(&self) {
+        self.update(true, |p| p.layers_completed += 1);
+    }
+
+    /// Report the final snapshot.
+    pub(super) fn finish(&self) {
+        self.update(true, |_| {});
+    }
+
+    fn update(&self, force: bool, apply: impl FnOnce(&mut ImagePullProgress)) {
+        let mut state = self.state.lock().unwrap();
+        apply(&mut state.progress);
+        let Some(callback) = &self.callback else {
+            return;
+        };
+        let now = Instant::now();
+        let due = state
+            .last_emit
+            .is_none_or(|last| now.duration_since(last) >= self.interval);
+        if force || due {
+            state.last_emit = Some(now);
+            state.progress.elapsed = now.duration_since(self.started);
+            // Called under the lock so snapshots arrive in order.
+            callback(&state.progress);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn recording_tracker(interval: Duration) -> (PullTracker, Arc<Mutex<Vec<ImagePullProgress>>>) {
+        let seen = Arc::new(Mutex::new(Vec::new()));
+        let sink = seen.clone();
+        let callback: ImagePullProgressFn = Arc::new(move |p| sink.lock().unwrap().push(p.clone()));
+        (
+            PullTracker::with_interval(Some(callback), 3, 1, 100, interval),
+            seen,
+        )
+    }
+
+    #[test]
+    fn byte_progress_is_throttled_but_layers_and_finish_are_not() {
+        let (tracker, seen) = recording_tracker(Duration::from_secs(3600));
+        tracker.add_bytes(10); // first update always reports
+        tracker.add_bytes(20);
+        tracker.add_bytes(30);
+        tracker.layer_done();
+        tracker.add_bytes(40);
+        tracker.finish();
+
+        let seen = seen.lock().unwrap();
+        let counts: Vec<_> = seen
+            .iter()
+            .map(|p| (p.bytes_downloaded, p.layers_completed))
+            .collect();
+        assert_eq!(counts, vec![(10, 1), (60, 2), (100, 2)]);
+        assert!(
+            seen.iter()
+                .all(|p| p.layers_total == 3 && p.bytes_total == 100)
+        );
+    }
+
+    #[test]
+    fn rewind_drops_bytes_of_failed_attempt() {
+        let (tracker, seen) = recording_tracker(Duration::ZERO);
+        tracker.add_bytes(50);
+        tracker.rewind_bytes(50);
+        tracker.add_bytes(70);
+        let last = seen.lock().unwrap().last().cloned().unwrap();
+        assert_eq!(last.bytes_downloaded, 70);
+    }
+
+    #[test]
+    fn rates_are_averaged_over_elapsed_time() {
+        let progress = ImagePullProgress {
+            layers_completed: 4,
+            bytes_downloaded: 1000,
+            elapsed: Duration::from_secs(2),
+            ..Default::default()
+        };
+        assert_eq!(progress.bytes_per_second(), 500.0);
+        assert_eq!(progress.layers_per_second(), 2.0);
+        assert_eq!(ImagePullProgress::default().bytes_per_second(), 0.0);
+    }
+
+    #[test]
+    fn concurrency_defaults_and_clamps_to_one() {
+        assert_eq!(
+            ImagePullOptions::default().concurrency(),
+            DEFAULT_MAX_CONCURRENT_LAYERS
+        );
+        assert_eq!(
+            ImagePullOptions::default()
+                .with_max_concurrent_layers(0)
+                .concurrency(),
+            1
+        );
+    }
+}
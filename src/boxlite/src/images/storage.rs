@@ -214,19 +214,7 @@ impl ImageStorage {
             return Ok(());
         }
 
-        // Extract to a unique temp directory to avoid race conditions
-        // Use PID + random UUID to ensure uniqueness across threads and processes
-        let temp_suffix = format!("{}.extracting", uuid::Uuid::new_v4().simple());
-        let temp_path = extracted_path.with_extension(temp_suffix);
-
-        // Create temp directory
-        std::fs::create_dir_all(&temp_path).map_err(|e| {
-            BoxliteError::Storage(format!(
-                "Failed to create temp extraction directory {}: {}",
-                temp_path.display(),
-                e
-            ))
-        })?;
+        let temp_path = create_extraction_dir(&extracted_path)?;
 
         // Extract tarball to temp directory - keep .wh.* files!
         let mut extractor = LayerExtractor::new(&temp_path);
@@ -239,37 +227,27 @@ impl ImageStorage {
             return Err(e);
         }
 
-        // Atomic rename: only one thread/process wins
-        match std::fs::rename(&temp_path, &extracted_path) {
-            Ok(()) => {
-                tracing::debug!(
-                    "Extracted layer {} (with whiteout markers) to {}",
-                    digest,
-                    extracted_path.display()
-                );
-            }
-            Err(e) => {
-                // Another thread/process won the race - clean up our temp dir
-                let _ = std::fs::remove_dir_all(&temp_path);
-
-                // Check if the winner succeeded (directory exists)
-                if extracted_path.exists() {
-                    tracing::debug!(
-                        "Layer {} already extracted by another thread/process",
-                        digest
-                    );
-                } else {
-                    // Neither we nor the winner succeeded - this is an error
-                    return Err(BoxliteError::Storage(format!(
-                        "Failed to rename temp directory to {}: {} (and no other extraction succeeded)",
-                        extracted_path.display(),
-                        e
-                    )));
-                }
-            }
-        }
+        publish_extracted_layer(digest, &temp_path, &extracted_path)
+    }
 
-        Ok(())
+    /// Start extracting a layer while its blob is still being downloaded.
+    ///
+    /// **Mutability**: Atomic - unpacks into a unique temp directory on a
+    /// blocking thread and only renames it into place once the caller
+    /// confirms the blob digest via [`StagedExtraction::commit`].
+    ///
+    /// Returns `None` when the layer is already extracted.
+    pub fn stage_layer_extraction(&self, digest: &str) -> BoxliteResult<Option<StagedExtraction>> {
+        let extracted_path = self.layer_extracted_path(digest);
+        if extracted_path.exists() {
+            return Ok(None);
+        }
+        let temp_path = create_extraction_dir(&extracted_path)?;
+        Ok(Some(StagedExtraction::spawn(
+            digest.to_string(),
+            temp_path,
+            extracted_path,
+        )))
     }
 
     /// Start a staged download for a layer blob.
@@ -456,6 +434,61 @@ impl ImageStorage {
     }
 }
 
+/// Create a unique temp directory next to `extracted_path` to unpack into.
+/// The random suffix keeps concurrent extractions of one layer apart.
+fn create_extraction_dir(extracted_path: &Path) -> BoxliteResult<PathBuf> {
+    let temp_suffix = format!("{}.extracting", uuid::Uuid::new_v4().simple());
+    let temp_path = extracted_path.with_extension(temp_suffix);
+
+    std::fs::create_dir_all(&temp_path).map_err(|e| {
+        BoxliteError::Storage(format!(
+            "Failed to create temp extraction directory {}: {}",
+            temp_path.display(),
+            e
+        ))
+    })?;
+    Ok(temp_path)
+}
+
+/// Atomically move an unpacked layer into the extracted cache. Only one
+/// thread/process wins; losers clean up their temp directory.
+fn publish_extracted_layer(
+    digest: &str,
+    temp_path: &Path,
+    extracted_path: &Path,
+) -> BoxliteResult<()> {
+    match std::fs::rename(temp_path, extracted_path) {
+        Ok(()) => {
+            tracing::debug!(
+                "Extracted layer {} (with whiteout markers) to {}",
+                digest,
+                extracted_path.display()
+            );
+        }
+        Err(e) => {
+            // Another thread/process won the race - clean up our temp dir
+            let _ = std::fs::remove_dir_all(temp_path);
+
+            // Check if the winner succeeded (directory exists)
+            if extracted_path.exists() {
+                tracing::debug!(
+                    "Layer {} already extracted by another thread/process",
+                    digest
+                );
+            } else {
+                // Neither we nor the winner succeeded - this is an error
+                return Err(BoxliteError::Storage(format!(
+                    "Failed to rename temp directory to {}: {} (and no other extraction succeeded)",
+                    extracted_path.display(),
+                    e
+                )));
+            }
+        }
+    }
+
+    Ok(())
+}
+
 // ============================================================================
 // HASHING WRITER
 // ============================================================================
@@ -656,6 +689,128 @@ impl StagedDownload {
     }
 }
 
+// ============================================================================
+// STAGED EXTRACTION
+// ============================================================================
+
+/// Chunks buffered between the download and the extractor thread.
+const EXTRACT_CHANNEL_CHUNKS: usize = 16;
+
+/// Handle for a layer being unpacked while its blob downloads.
+///
+/// Blob chunks passed to [`feed`](Self::feed) are decompressed and untarred
+/// on a blocking thread into a temp directory. The result is only published
+/// to the extracted-layer cache by [`commit`](Self::commit), which the caller
+/// invokes once the blob's digest has been verified; [`abort`](Self::abort),
+/// or dropping the handle, discards it.
+///
+/// # Example
+/// ```ignore
+/// let mut extraction = storage.stage_layer_extraction(digest)?;
+/// while let Some(chunk) = blob.next().await {
+///     extraction.feed(chunk?).await;
+/// }
+/// if staged.commit().await? {
+///     extraction.commit().await?;
+/// }
+/// ```
+pub struct StagedExtraction {
+    /// `None` once the extractor stopped reading (finished or failed).
+    chunks: Option<tokio::sync::mpsc::Sender<bytes::Bytes>>,
+    verdict: Option<tokio::sync::oneshot::Sender<bool>>,
+    worker: tokio::task::JoinHandle<BoxliteResult<()>>,
+}
+
+impl StagedExtraction {
+    fn spawn(digest: String, temp_path: PathBuf, extracted_path: PathBuf) -> Self {
+        let (chunks, rx) = tokio::sync::mpsc::channel(EXTRACT_CHANNEL_CHUNKS);
+        let (verdict, verdict_rx) = tokio::sync::oneshot::channel();
+        let worker = tokio::task::spawn_blocking(move || {
+            let mut extractor = LayerExtractor::new(&temp_path);
+            let extracted = extractor
+                .extract_blob_preserving_whiteouts(ChunkReader::new(rx))
+                .and_then(|_| extractor.finalize());
+            // The reader is gone here, so `feed` no longer waits on us while
+            // the caller finishes the download and verifies it.
+            match (extracted, verdict_rx.blocking_recv()) {
+                (Ok(()), Ok(true)) => publish_extracted_layer(&digest, &temp_path, &extracted_path),
+                (extracted, _) => {
+                    let _ = std::fs::remove_dir_all(&temp_path);
+                    extracted
+                }
+            }
+        });
+        Self {
+            chunks: Some(chunks),
+            verdict: Some(verdict),
+            worker,
+        }
+    }
+
+    /// Hand the next blob chunk to the extractor. Waits while the extractor
+    /// is behind; a no-op once it has stopped reading.
+    pub async fn feed(&mut self, chunk: bytes::Bytes) {
+        if let Some(chunks) = &self.chunks
+            && chunks.send(chunk).await.is_err()
+        {
+            self.chunks = None;
+        }
+    }
+
+    /// Publish the unpacked layer. Call only after the blob digest has been
+    /// verified. Returns the extraction error, if any; the layer can still be
+    /// extracted later from the committed tarball.
+    pub async fn commit(self) -> BoxliteResult<()> {
+        self.finish(true).await
+    }
+
+    /// Discard the unpacked layer.
+    pub async fn abort(self) {
+        let _ = self.finish(false).await;
+    }
+
+    async fn finish(mut self, publish: bool) -> BoxliteResult<()> {
+        // End of stream, then the verdict.
+        self.chunks.take();
+        if let Some(verdict) = self.verdict.take() {
+            let _ = verdict.send(publish);
+        }
+        (&mut self.worker)
+            .await
+            .map_err(|e| BoxliteError::Storage(format!("Layer extraction task failed: {}", e)))?
+    }
+}
+
+/// Blocking `Read` over the chunks of a [`StagedExtraction`]. Reports end of
+/// stream once the sender is dropped.
+struct ChunkReader {
+    rx: tokio::sync::mpsc::Receiver<bytes::Bytes>,
+    chunk: bytes::Bytes,
+}
+
+impl ChunkReader {
+    fn new(rx: tokio::sync::mpsc::Receiver<bytes::Bytes>) -> Self {
+        Self {
+            rx,
+            chunk: bytes::Bytes::new(),
+        }
+    }
+}
+
+impl std::io::Read for ChunkReader {
+    fn read(&mut self, buf: &mut [u8]) -> std::io::Result<usize> {
+        while self.chunk.is_empty() {
+            match self.rx.blocking_recv() {
+                Some(chunk) => self.chunk = chunk,
+                None => return Ok(0),
+            }
+        }
+        let n = buf.len().min(self.chunk.len());
+        buf[..n].copy_from_slice(&self.chunk.split_to(n));
+        Ok(n)
+    }
+}
+
 // ============================================================================
 // TESTS
 // ============================================================================
@@ -743,6 +898,43 @@ mod tests {
         );
     }
 
+    #[tokio::test(flavor = "multi_thread")]
+    async fn test_staged_extraction_publishes_only_on_commit() {
+        use std::io::Write;
+
+        let temp_dir = tempfile::tempdir().unwrap();
+        let store = ImageStorage::new(temp_dir.path().to_path_buf()).unwrap();
+        let mut gz = flate2::write::GzEncoder::new(Vec::new(), flate2::Compression::fast());
+        gz.write_all(&tar_with_whiteout_marker()).unwrap();
+        let blob = gz.finish().unwrap();
+
+        for (digest, publish) in [("sha256:streamed", true), ("sha256:aborted", false)] {
+            let mut extraction = store.stage_layer_extraction(digest).unwrap().unwrap();
+            for chunk in blob.chunks(7) {
+                extraction.feed(bytes::Bytes::copy_from_slice(chunk)).await;
+            }
+            if publish {
+                extraction.commit().await.unwrap();
+            } else {
+                extraction.abort().await;
+            }
+        }
+
+        let extracted = store.layer_extracted_path("sha256:streamed");
+        assert!(extracted.join("bin/.wh.sh").exists());
+        assert_eq!(
+            std::fs::read(extracted.join("bin/new-tool")).unwrap(),
+            b"upper"
+        );
+        assert!(
+            store
+                .stage_layer_extraction("sha256:streamed")
+                .unwrap()
+                .is_none()
+        );
+        assert!(!store.layer_extracted_path("sha256:aborted").exists());
+    }
+
     #[test]
     fn test_config_path() {
         let temp_dir = tempfile::tempdir().unwrap();
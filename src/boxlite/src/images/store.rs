@@ -15,7 +15,8 @@
 
 use crate::db::{CachedImage, Database, ImageIndexStore};
 use crate::images::manager::{ImageManifest, LayerInfo};
-use crate::images::storage::ImageStorage;
+use crate::images::progress::{ImagePullOptions, PullTracker};
+use crate::images::storage::{ImageStorage, StagedDownload, StagedExtraction};
 use crate::runtime::options::{ImageRegistry, ImageRegistryAuth, RegistryTransport};
 use boxlite_shared::{BoxliteError, BoxliteResult};
 use oci_client::Reference;
@@ -153,6 +154,17 @@ impl ImageStore {
     /// Thread-safe: Multiple concurrent pulls of the same image will only
     /// download once; others will get the cached result.
     pub async fn pull(&self, image_ref: &str) -> BoxliteResult<ImageManifest> {
+        self.pull_with(image_ref, &ImagePullOptions::default())
+            .await
+    }
+
+    /// [`pull`](Self::pull) with per-pull layer concurrency and progress
+    /// reporting.
+    pub async fn pull_with(
+        &self,
+        image_ref: &str,
+        options: &ImagePullOptions,
+    ) -> BoxliteResult<ImageManifest> {
         use super::ReferenceIter;
 
         tracing::debug!(
@@ -181,7 +193,7 @@ impl ImageStore {
 
             // Slow path: pull from registry
             tracing::info!("Pulling image from registry: {}", ref_str);
-            match self.pull_from_registry(&reference).await {
+            match self.pull_from_registry(&reference, options).await {
                 Ok(manifest) => {
                     if !errors.is_empty() {
                         tracing::info!(
@@ -570,7 +582,11 @@ impl ImageStore {
     ///
     /// This method handles the actual network I/O - manifest pull, layer download, etc.
     /// Lock is released during network I/O to allow other operations.
-    async fn pull_from_registry(&self, reference: &Reference) -> BoxliteResult<ImageManifest> {
+    async fn pull_from_registry(
+        &self,
+        reference: &Reference,
+        options: &ImagePullOptions,
+    ) -> BoxliteResult<ImageManifest> {
         let client = self.client_for(reference);
         let auth = registry_auth_for(reference.registry(), &self.image_registries);
 
@@ -594,7 +610,7 @@ impl ImageStore {
             .await?;
 
         // Step 4: Download layers (no lock during download, atomic file writes)
-        self.download_layers(&client, reference, &image_manifest.layers)
+        self.download_layers(&client, reference, &image_manifest.layers, options)
             .await?;
 
         // Step 5: Download config (no lock during download)
@@ -809,8 +825,9 @@ impl ImageStore {
         client: &oci_client::Client,
         reference: &Reference,
         layers: &[LayerInfo],
+        options: &ImagePullOptions,
     ) -> BoxliteResult<()> {
-        use futures::future::join_all;
+        use futures::stream::{self, TryStreamExt};
 
         // Check which layers need downloading (quick read lock)
         let layers_to_download: Vec<_> = {
@@ -845,30 +862,46 @@ impl ImageStore {
             return Ok(());
         }
 
+        let concurrency = options.concurrency();
         tracing::info!(
-            "Downloading {} layers in parallel",
-            layers_to_download.len()
+            "Downloading {} layers, {} at a time",
+            layers_to_download.len(),
+            concurrency
         );
 
-        // Download in parallel (no lock held)
-        let download_futures = layers_to_download
-            .iter()
-            .map(|layer| self.download_layer(client, reference, layer));
-
-        let results = join_all(download_futures).await;
+        let tracker = PullTracker::new(
+            options.progress.clone(),
+            layers.len(),
+            layers.len() - layers_to_download.len(),
+            layers_to_download
+                .iter()
+                .map(|layer| layer.size.max(0) as u64)
+                .sum(),
+        );
 
-        for result in results {
-            result?;
-        }
+        // Download with bounded parallelism (no lock held). The first
+        // failure stops scheduling further layers.
+        let progress = &tracker;
+        stream::iter(layers_to_download.iter().map(Ok))
+            .try_for_each_concurrent(concurrency, |layer| {
+                self.download_layer(client, reference, layer, progress)
+            })
+            .await?;
 
+        tracker.finish();
         Ok(())
     }
 
+    /// Download one layer blob, unpacking it into the extracted-layer cache
+    /// as the bytes arrive. The unpacked layer is only published once the
+    /// blob digest checks out; if unpacking fails, the verified tarball is
+    /// still committed and extracted later on first use.
     async fn download_layer(
         &self,
         client: &oci_client::Client,
         reference: &Reference,
         layer: &LayerInfo,
+        tracker: &PullTracker,
     ) -> BoxliteResult<()> {
         const MAX_RETRIES: u32 = 3;
 
@@ -886,10 +919,10 @@ impl ImageStore {
                 );
             }
 
-            // Stage download (quick read lock for path computation)
-            let mut staged = {
+            // Stage download and extraction (quick read lock for path computation)
+            let (mut staged, mut extraction) = {
                 let inner = self.inner.read().await;
-                match inner
+                let staged = match inner
                     .storage
                     .stage_layer_download(&layer.digest, layer.size)
                     .await
@@ -902,27 +935,48 @@ impl ImageStore {
                         ));
                         continue;
                     }
-                }
+                };
+                let extraction = inner
+                    .storage
+                    .stage_layer_extraction(&layer.digest)
+                    .unwrap_or_else(|e| {
+                        tracing::warn!(
+                            "Cannot unpack layer {} during download, will extract on first use: {}",
+                            layer.digest,
+                            e
+                        );
+                        None
+                    });
+                (staged, extraction)
             };
 
             // Download (no lock)
-            match client
-                .pull_blob(
-                    reference,
-                    &OciDescriptor {
-                        digest: layer.digest.clone(),
-                        media_type: layer.media_type.clone(),
-                        size: layer.size,
-                        urls: None,
-                        annotations: None,
-                    },
-                    staged.file(),
-                )
-                .await
-            {
-                Ok(_) => match staged.commit().await {
+            let mut received = 0u64;
+            let streamed = Self::stream_layer(
+                client,
+                reference,
+                layer,
+                &mut staged,
+                extraction.as_mut(),
+                tracker,
+                &mut received,
+            )
+            .await;
+
+            match streamed {
+                Ok(()) => match staged.commit().await {
                     Ok(true) => {
+                        if let Some(extraction) = extraction
+                            && let Err(e) = extraction.commit().await
+                        {
+                            tracing::warn!(
+                                "Unpacking layer {} during download failed, will extract on first use: {}",
+                                layer.digest,
+                                e
+                            );
+                        }
                         tracing::info!("Downloaded and verified layer: {}", layer.digest);
+                        tracker.layer_done();
                         return Ok(());
                     }
                     Ok(false) => {
@@ -945,6 +999,11 @@ impl ImageStore {
                     staged.abort().await;
                 }
             }
+
+            if let Some(extraction) = extraction {
+                extraction.abort().await;
+            }
+            tracker.rewind_bytes(received);
         }
 
         Err(BoxliteError::Storage(last_error.unwrap_or_else(|| {
@@ -952,6 +1011,55 @@ impl ImageStore {
         })))
     }
 
+    /// Stream a layer blob into `staged`, handing each chunk to `extraction`
+    /// too. `received` counts the bytes taken from the network, also when
+    /// the stream fails part way.
+    async fn stream_layer(
+        client: &oci_client::Client,
+        reference: &Reference,
+        layer: &LayerInfo,
+        staged: &mut StagedDownload,
+        mut extraction: Option<&mut StagedExtraction>,
+        tracker: &PullTracker,
+        received: &mut u64,
+    ) -> Result<(), String> {
+        use futures::StreamExt;
+        use tokio::io::AsyncWriteExt;
+
+        let mut blob = client
+            .pull_blob_stream(
+                reference,
+                &OciDescriptor {
+                    digest: layer.digest.clone(),
+                    media_type: layer.media_type.clone(),
+                    size: layer.size,
+                    urls: None,
+                    annotations: None,
+                },
+            )
+            .await
+            .map_err(|e| e.to_string())?;
+
+        while let Some(chunk) = blob.stream.next().await {
+            let chunk = chunk.map_err(|e| e.to_string())?;
+            staged
+                .file()
+                .write_all(&chunk)
+                .await
+                .map_err(|e| format!("write failed: {e}"))?;
+            *received += chunk.len() as u64;
+            tracker.add_bytes(chunk.len() as u64);
+            if let Some(extraction) = extraction.as_deref_mut() {
+                extraction.feed(chunk).await;
+            }
+        }
+        staged
+            .file()
+            .flush()
+            .await
+            .map_err(|e| format!("flush failed: {e}"))
+    }
+
     async fn download_config(
         &self,
         client: &oci_client::Client,
@@ -5,6 +5,7 @@ use super::sandbox::{PlatformSandbox, Sandbox};
 use crate::runtime::advanced_options::{ResourceLimits, SecurityOptions};
 use crate::runtime::layout::BoxFilesystemLayout;
 use crate::runtime::options::VolumeSpec;
+use crate::runtime::placement::BoxPlacement;
 use std::os::fd::RawFd;
 use std::path::PathBuf;
 
@@ -30,6 +31,7 @@ pub struct JailerBuilder {
     layout: Option<BoxFilesystemLayout>,
     preserved_fds: Vec<(RawFd, i32)>,
     detach: bool,
+    placement: Option<BoxPlacement>,
 }
 
 impl Default for JailerBuilder {
@@ -48,6 +50,7 @@ impl JailerBuilder {
             layout: None,
             preserved_fds: Vec::new(),
             detach: false,
+            placement: None,
         }
     }
 
@@ -282,6 +285,14 @@ impl JailerBuilder {
         self
     }
 
+    /// Confine the child to a host CPU / NUMA placement: cgroup
+    /// `cpuset.cpus`/`cpuset.mems` when the jailer is enabled, plus CPU
+    /// affinity and memory policy in `pre_exec` either way.
+    pub fn with_placement(mut self, placement: Option<BoxPlacement>) -> Self {
+        self.placement = placement;
+        self
+    }
+
     /// Build with the platform-default sandbox.
     ///
     /// On Linux: [`BwrapSandbox`](super::sandbox::BwrapSandbox)
@@ -328,6 +339,7 @@ impl JailerBuilder {
             layout,
             preserved_fds: self.preserved_fds,
             detach: self.detach,
+            placement: self.placement,
         })
     }
 }
@@ -412,11 +424,13 @@ mod tests {
                 host_path: "/data".to_string(),
                 guest_path: "/mnt/data".to_string(),
                 read_only: true,
+                tuning: None,
             })
             .with_volume(VolumeSpec {
                 host_path: "/output".to_string(),
                 guest_path: "/mnt/output".to_string(),
                 read_only: false,
+                tuning: None,
             })
             .build()
             .expect("Should build successfully");
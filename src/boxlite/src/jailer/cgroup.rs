@@ -27,6 +27,8 @@
 //!         ├── memory.max        # Memory limit
 //!         ├── memory.high       # Memory throttle threshold
 //!         ├── pids.max          # Max processes
+//!         ├── cpuset.cpus       # Host CPUs (box placement)
+//!         ├── cpuset.mems       # NUMA memory nodes (box placement)
 //!         └── cgroup.procs      # Add process here
 //! ```
 
@@ -115,6 +117,12 @@ pub struct CgroupConfig {
 
     /// Maximum number of processes (pids.max).
     pub pids_max: Option<u64>,
+
+    /// Host CPUs in kernel list format (cpuset.cpus).
+    pub cpuset_cpus: Option<String>,
+
+    /// NUMA memory nodes in kernel list format (cpuset.mems).
+    pub cpuset_mems: Option<String>,
 }
 
 /// Check if cgroup v2 is available and unified hierarchy is used.
@@ -168,6 +176,47 @@ pub(super) fn kill_cgroup(box_id: &BoxID) -> bool {
     std::fs::write(&kill_file, "1").is_ok()
 }
 
+/// Processes in a box's cgroup, read from `cgroup.procs`.
+///
+/// Empty if the cgroup is gone or was never created (no jailer). Same
+/// `BoxID` reasoning and `pub(super)` scope as [`kill_cgroup`].
+pub(super) fn cgroup_pids(box_id: &BoxID) -> Vec<u32> {
+    std::fs::read_to_string(cgroup_path(box_id.as_str()).join("cgroup.procs"))
+        .map(|procs| {
+            procs
+                .lines()
+                .filter_map(|line| line.trim().parse().ok())
+                .collect()
+        })
+        .unwrap_or_default()
+}
+
+/// Usage counters of a box's cgroup, for [`super::box_usage`].
+///
+/// `None` if the cgroup is gone or was never created. Same `BoxID`
+/// reasoning and `pub(super)` scope as [`kill_cgroup`].
+pub(super) fn cgroup_usage(box_id: &BoxID) -> Option<super::BoxUsage> {
+    let path = cgroup_path(box_id.as_str());
+    let cpu_stat = fs::read_to_string(path.join("cpu.stat")).ok()?;
+    let cpu_usage_usec = parse_usage_usec(&cpu_stat)?;
+    let memory_bytes = fs::read_to_string(path.join("memory.current"))
+        .ok()
+        .and_then(|v| v.trim().parse().ok());
+    Some(super::BoxUsage {
+        cpu_usage_usec,
+        memory_bytes,
+    })
+}
+
+/// `usage_usec` from a `cpu.stat` file (present even without the cpu
+/// controller).
+fn parse_usage_usec(cpu_stat: &str) -> Option<u64> {
+    cpu_stat.lines().find_map(|line| {
+        line.strip_prefix("usage_usec ")
+            .and_then(|v| v.trim().parse().ok())
+    })
+}
+
 /// Setup cgroup for a box.
 ///
 /// Creates the cgroup directory and configures resource limits.
@@ -223,6 +272,7 @@ pub fn setup_cgroup(box_id: &str, config: &CgroupConfig) -> Result<PathBuf, Jail
 
     // Apply limits
     apply_limits(&box_cgroup, config)?;
+    apply_cpuset(&boxlite_cgroup, &box_cgroup, config);
 
     tracing::debug!(
         box_id = %box_id,
@@ -243,6 +293,38 @@ fn enable_controllers(cgroup_path: &Path) -> Result<(), JailerError> {
     Ok(())
 }
 
+/// Confine a box cgroup to its placement.
+///
+/// Best-effort: the cpuset controller is often not delegated to rootless
+/// users. The shim still gets the placement as its CPU affinity and memory
+/// policy from the pre_exec hook, so a failure here only loses enforcement
+/// against the box changing its own affinity.
+fn apply_cpuset(boxlite_cgroup: &Path, box_cgroup: &Path, config: &CgroupConfig) {
+    if config.cpuset_cpus.is_none() && config.cpuset_mems.is_none() {
+        return;
+    }
+
+    // Enabled separately from the other controllers: a parent that does not
+    // delegate cpuset would otherwise reject the whole write. Idempotent, so
+    // boxlite cgroups created before placement existed pick it up too.
+    let result = write_file(&boxlite_cgroup.join("cgroup.subtree_control"), "+cpuset")
+        .and_then(|()| match &config.cpuset_mems {
+            Some(mems) => write_file(&box_cgroup.join("cpuset.mems"), mems),
+            None => Ok(()),
+        })
+        .and_then(|()| match &config.cpuset_cpus {
+            Some(cpus) => write_file(&box_cgroup.join("cpuset.cpus"), cpus),
+            None => Ok(()),
+        });
+    if let Err(e) = result {
+        tracing::warn!(
+            path = %box_cgroup.display(),
+            error = %e,
+            "Cgroup cpuset unavailable, placement applied as affinity only"
+        );
+    }
+}
+
 /// Apply resource limits to a cgroup.
 fn apply_limits(cgroup_path: &Path, config: &CgroupConfig) -> Result<(), JailerError> {
     // Memory limit
@@ -339,6 +421,8 @@ impl From<&ResourceLimits> for CgroupConfig {
                 (t * 1_000_000, 1_000_000)
             }),
             pids_max: limits.max_processes,
+            cpuset_cpus: None,
+            cpuset_mems: None,
         }
     }
 }
@@ -474,6 +558,16 @@ mod tests {
     // ids (see `id::tests::test_parse_rejects_unsafe_characters`). A non-component
     // id is now unrepresentable at this call site, not merely rejected at runtime.
 
+    #[test]
+    fn parse_usage_usec_reads_cpu_stat() {
+        let stat = "usage_usec 1234567\nuser_usec 1000000\nsystem_usec 234567\n";
+        assert_eq!(parse_usage_usec(stat), Some(1_234_567));
+        assert_eq!(parse_usage_usec("user_usec 5\n"), None);
+
+        let box_id = BoxID::parse("nonexistentbox000000000000").expect("valid id");
+        assert!(cgroup_usage(&box_id).is_none());
+    }
+
     #[test]
     fn test_cgroup_config_from_limits() {
         let limits = ResourceLimits {
@@ -186,6 +186,7 @@ mod tests {
                 host_path: "/data".to_string(),
                 guest_path: "/mnt/data".to_string(),
                 read_only: true,
+                tuning: None,
             })
             .build_with(sandbox)
             .unwrap();
@@ -0,0 +1,114 @@
+//! CPU affinity and NUMA memory policy for a box placement.
+//!
+//! The masks are built in the parent; only the async-signal-safe
+//! [`PlacementMasks::apply_raw`] runs in the `pre_exec` hook. Both the
+//! affinity and the memory policy survive `exec()` and are inherited by
+//! every thread the shim starts, libkrun's vCPU threads included.
+
+use crate::runtime::placement::{BoxPlacement, MAX_PLACEMENT_IDS};
+
+/// `MPOL_BIND` from `<linux/mempolicy.h>`.
+const MPOL_BIND: libc::c_int = 2;
+
+/// Node mask words; [`MAX_PLACEMENT_IDS`] nodes, matching `CPU_SETSIZE`.
+const NODE_WORDS: usize = MAX_PLACEMENT_IDS as usize / libc::c_ulong::BITS as usize;
+
+/// Pre-computed affinity and node masks for one placement.
+#[derive(Clone, Copy)]
+pub struct PlacementMasks {
+    cpus: libc::cpu_set_t,
+    nodes: [libc::c_ulong; NODE_WORDS],
+    has_nodes: bool,
+}
+
+impl PlacementMasks {
+    /// Build the masks. The planner rejects ids at or past
+    /// [`MAX_PLACEMENT_IDS`], so every id fits.
+    pub fn new(placement: &BoxPlacement) -> Self {
+        // SAFETY: cpu_set_t is plain data; all-zero is the empty set.
+        let mut cpus: libc::cpu_set_t = unsafe { std::mem::zeroed() };
+        for &cpu in &placement.cpus {
+            if (cpu as usize) < libc::CPU_SETSIZE as usize {
+                unsafe { libc::CPU_SET(cpu as usize, &mut cpus) };
+            }
+        }
+
+        let bits = libc::c_ulong::BITS as usize;
+        let mut nodes = [0; NODE_WORDS];
+        let mut has_nodes = false;
+        for &node in &placement.mems {
+            let node = node as usize;
+            if node < NODE_WORDS * bits {
+                nodes[node / bits] |= 1 << (node % bits);
+                has_nodes = true;
+            }
+        }
+
+        Self {
+            cpus,
+            nodes,
+            has_nodes,
+        }
+    }
+
+    /// Apply to the calling process - async-signal-safe version for pre_exec.
+    ///
+    /// Only uses the `sched_setaffinity` and `set_mempolicy` syscalls. Do NOT
+    /// add logging, allocation or locking.
+    ///
+    /// # Returns
+    /// * `Ok(())` - Affinity (and memory policy, if any nodes) applied. A
+    ///   kernel built without NUMA (`ENOSYS` from `set_mempolicy`) leaves
+    ///   memory unbound.
+    /// * `Err(errno)` - A syscall failed (returns raw errno)
+    pub fn apply_raw(&self) -> Result<(), i32> {
+        let size = std::mem::size_of::<libc::cpu_set_t>();
+        if unsafe { libc::sched_setaffinity(0, size, &self.cpus) } != 0 {
+            return Err(super::get_errno());
+        }
+
+        if self.has_nodes {
+            // maxnode counts one past the last bit, as numactl passes it.
+            let maxnode = (NODE_WORDS * libc::c_ulong::BITS as usize + 1) as libc::c_ulong;
+            let ret = unsafe {
+                libc::syscall(
+                    libc::SYS_set_mempolicy,
+                    MPOL_BIND,
+                    self.nodes.as_ptr(),
+                    maxnode,
+                )
+            };
+            if ret != 0 {
+                let errno = super::get_errno();
+                if errno != libc::ENOSYS {
+                    return Err(errno);
+                }
+            }
+        }
+
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn masks_hold_placement_ids() {
+        let masks = PlacementMasks::new(&BoxPlacement {
+            cpus: vec![0, 3, 65],
+            mems: vec![1, 64],
+        });
+        unsafe {
+            assert!(libc::CPU_ISSET(0, &masks.cpus));
+            assert!(libc::CPU_ISSET(3, &masks.cpus));
+            assert!(libc::CPU_ISSET(65, &masks.cpus));
+            assert!(!libc::CPU_ISSET(1, &masks.cpus));
+        }
+        let bits = libc::c_ulong::BITS as usize;
+        assert_eq!(masks.nodes[1 / bits] & (1 << (1 % bits)), 1 << (1 % bits));
+        assert_ne!(masks.nodes[64 / bits] & (1 << (64 % bits)), 0);
+        assert!(masks.has_nodes);
+    }
+}
@@ -4,12 +4,15 @@
 //! - [`fd`]: File descriptor cleanup (async-signal-safe for pre_exec)
 //! - [`rlimit`]: Resource limit management (async-signal-safe for pre_exec)
 //! - [`fs`]: Filesystem utilities (copy-if-newer, etc.)
+//! - [`affinity`]: CPU affinity + NUMA memory policy (async-signal-safe for pre_exec, Linux)
 //!
 //! Note: PID file writing lives in [`crate::util::pid_file::PidFileWriter`]
 //! (the format is owned by `PidRecord` / `PidFileReader` / `PidFileWriter`
 //! in `util/pid_file.rs`). Environment sanitization is handled by
 //! bwrap/sandbox-exec at spawn time.
 
+#[cfg(target_os = "linux")]
+pub mod affinity;
 pub mod fd;
 pub mod fs;
 pub mod rlimit;
@@ -111,6 +111,46 @@ pub(crate) fn reap_box(_box_id: &crate::runtime::id::BoxID) -> bool {
     false
 }
 
+/// Host processes belonging to a box's sandbox (best-effort).
+///
+/// On Linux this is every process in the box's cgroup — launcher, shim and
+/// VM alike — so per-box accounting does not depend on which pid the
+/// runtime recorded. Empty when there is no sandbox tree to inspect.
+#[cfg(target_os = "linux")]
+pub(crate) fn box_pids(box_id: &crate::runtime::id::BoxID) -> Vec<u32> {
+    cgroup::cgroup_pids(box_id)
+}
+
+/// See the Linux variant. No host-side sandbox process tree here.
+#[cfg(not(target_os = "linux"))]
+pub(crate) fn box_pids(_box_id: &crate::runtime::id::BoxID) -> Vec<u32> {
+    Vec::new()
+}
+
+/// Cumulative resource usage of a box's sandbox, from its cgroup.
+#[cfg_attr(not(target_os = "linux"), allow(dead_code))]
+#[derive(Debug, Clone, Copy, Default)]
+pub(crate) struct BoxUsage {
+    /// CPU time of every process in the sandbox (`cpu.stat` `usage_usec`).
+    pub cpu_usage_usec: u64,
+    /// Memory charged to the sandbox (`memory.current`); `None` when the
+    /// memory controller is not enabled for it.
+    pub memory_bytes: Option<u64>,
+}
+
+/// Read a box's usage in two small sysfs reads, without walking its
+/// processes. `None` when the box has no cgroup (no jailer, cgroup v1).
+#[cfg(target_os = "linux")]
+pub(crate) fn box_usage(box_id: &crate::runtime::id::BoxID) -> Option<BoxUsage> {
+    cgroup::cgroup_usage(box_id)
+}
+
+/// See the Linux variant. No box cgroups here.
+#[cfg(not(target_os = "linux"))]
+pub(crate) fn box_usage(_box_id: &crate::runtime::id::BoxID) -> Option<BoxUsage> {
+    None
+}
+
 // Volume specification (convenience re-export)
 pub use crate::runtime::options::VolumeSpec;
 
@@ -171,6 +211,7 @@ pub trait Jail: Send + Sync {
 
 use crate::disk::read_backing_chain;
 use crate::runtime::layout::BoxFilesystemLayout;
+use crate::runtime::placement::BoxPlacement;
 use crate::volumes::{VolumeShare, classify_volume_share};
 use std::path::PathBuf;
 
@@ -390,6 +431,9 @@ pub struct Jailer<S: Sandbox> {
     /// — `true` adds `setsid()` to the pre_exec chain, `false` sets the
     /// child's process group to itself at `Command` build time.
     pub(crate) detach: bool,
+    /// Host CPU / NUMA placement, applied as the cgroup cpuset and as the
+    /// child's affinity and memory policy.
+    pub(crate) placement: Option<BoxPlacement>,
 }
 
 impl<S: Sandbox> Jail for Jailer<S> {
@@ -485,6 +529,7 @@ impl<S: Sandbox> Jail for Jailer<S> {
         pre_exec::add_pre_exec_hook(
             &mut cmd,
             resource_limits,
+            self.placement.as_ref(),
             pid_writer,
             self.preserved_fds.clone(),
             self.detach,
@@ -551,6 +596,7 @@ impl<S: Sandbox> Jailer<S> {
             network_enabled: self.security.network_enabled,
             sandbox_profile: self.security.sandbox_profile.as_deref(),
             detached: self.detach,
+            placement: self.placement.as_ref(),
         }
     }
 
@@ -821,11 +867,13 @@ mod tests {
                 host_path: vol_ro.to_string_lossy().to_string(),
                 guest_path: "/mnt/input".to_string(),
                 read_only: true,
+                tuning: None,
             },
             VolumeSpec {
                 host_path: vol_rw.to_string_lossy().to_string(),
                 guest_path: "/mnt/output".to_string(),
                 read_only: false,
+                tuning: None,
             },
         ];
 
@@ -853,6 +901,7 @@ mod tests {
             host_path: "/does/not/exist".to_string(),
             guest_path: "/mnt/data".to_string(),
             read_only: true,
+            tuning: None,
         }];
 
         let paths = build_path_access(&layout, &volumes);
@@ -877,6 +926,7 @@ mod tests {
             host_path: file.to_string_lossy().to_string(),
             guest_path: "/etc/app.conf".to_string(),
             read_only: true,
+            tuning: None,
         }];
 
         let paths = build_path_access(&layout, &volumes);
@@ -1014,6 +1064,7 @@ mod tests {
                 host_path: vol_dir.to_string_lossy().to_string(),
                 guest_path: "/mnt/data".to_string(),
                 read_only: false,
+                tuning: None,
             }])
             .build()
             .unwrap();
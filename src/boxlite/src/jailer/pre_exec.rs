@@ -7,7 +7,8 @@
 //!
 //! 1. **Close inherited FDs** - Prevents information leakage
 //! 2. **Apply rlimits** - Resource limits (max files, memory, CPU time, etc.)
-//! 3. **Write PID file** - Single source of truth for process tracking
+//! 3. **Apply placement** - CPU affinity + NUMA memory policy (Linux)
+//! 4. **Write PID file** - Single source of truth for process tracking
 //!
 //! Sandbox-specific pre_exec hooks (cgroup join, Landlock restriction) are
 //! added by each sandbox's `apply()` method — they run before this hook
@@ -25,6 +26,7 @@
 
 use crate::jailer::common;
 use crate::runtime::advanced_options::ResourceLimits;
+use crate::runtime::placement::BoxPlacement;
 use crate::util::{PidFileWriter, PidRecord};
 use std::os::fd::RawFd;
 use std::process::Command;
@@ -38,6 +40,7 @@ use std::process::Command;
 ///
 /// * `cmd` - The Command to add the hook to
 /// * `resource_limits` - Resource limits to apply
+/// * `placement` - CPUs / NUMA nodes to confine the child to (Linux; ignored elsewhere)
 /// * `pid_writer` - Async-signal-safe writer (pre-allocated in the parent)
 /// * `preserved_fds` - FDs to preserve: each `(source, target)` is dup2'd before cleanup.
 ///   After dup2, all FDs above the highest target are closed.
@@ -49,6 +52,7 @@ use std::process::Command;
 /// only uses async-signal-safe operations:
 /// - `dup2()` / `close()` / `close_range()` syscalls
 /// - `setrlimit()` syscall
+/// - `sched_setaffinity()` / `set_mempolicy()` syscalls
 /// - `open()` / `write()` / `close()` syscalls (for PID file)
 /// - `getpid()` syscall
 ///
@@ -60,6 +64,7 @@ use std::process::Command;
 pub fn add_pre_exec_hook(
     cmd: &mut Command,
     resource_limits: ResourceLimits,
+    placement: Option<&BoxPlacement>,
     pid_writer: Option<PidFileWriter>,
     preserved_fds: Vec<(RawFd, i32)>,
     detach: bool,
@@ -81,6 +86,12 @@ pub fn add_pre_exec_hook(
         cmd.process_group(0);
     }
 
+    // Masks are built here, in the parent: the hook must not allocate.
+    #[cfg(target_os = "linux")]
+    let placement = placement.map(common::affinity::PlacementMasks::new);
+    #[cfg(not(target_os = "linux"))]
+    let _ = placement;
+
     // SAFETY: The hook only uses async-signal-safe syscalls.
     // See module documentation for details.
     unsafe {
@@ -106,14 +117,23 @@ pub fn add_pre_exec_hook(
             common::rlimit::apply_limits_raw(&resource_limits)
                 .map_err(std::io::Error::from_raw_os_error)?;
 
-            // 3. Write PID file
+            // 3. Apply placement. Joining a cpuset cgroup (an earlier hook)
+            // already confines the CPUs; this also covers boxes without one.
+            #[cfg(target_os = "linux")]
+            if let Some(ref masks) = placement {
+                masks
+                    .apply_raw()
+                    .map_err(std::io::Error::from_raw_os_error)?;
+            }
+
+            // 4. Write PID file
             if let Some(ref writer) = pid_writer {
                 writer
                     .write(&PidRecord::current())
                     .map_err(std::io::Error::from_raw_os_error)?;
             }
 
-            // 4. Detach=true → setsid: child becomes a session leader,
+            // 5. Detach=true → setsid: child becomes a session leader,
             // detaching from the parent's controlling terminal. Without
             // this a SIGHUP on the parent's terminal cascades into the
             // daemon (the `BoxOptions::detach` contract relies on it).
@@ -136,7 +156,7 @@ mod tests {
         let mut cmd = Command::new("/bin/echo");
         let limits = ResourceLimits::default();
 
-        add_pre_exec_hook(&mut cmd, limits, None, vec![], false);
+        add_pre_exec_hook(&mut cmd, limits, None, None, vec![], false);
     }
 
     #[test]
@@ -144,7 +164,7 @@ mod tests {
         let mut cmd = Command::new("/bin/echo");
         let limits = ResourceLimits::default();
         let writer = PidFileWriter::at(std::path::Path::new("/tmp/test.pid")).ok();
-        add_pre_exec_hook(&mut cmd, limits, writer, vec![], false);
+        add_pre_exec_hook(&mut cmd, limits, None, writer, vec![], false);
     }
 
     #[test]
@@ -153,6 +173,6 @@ mod tests {
         let limits = ResourceLimits::default();
 
         // Simulate preserving fd 5 → target fd 3
-        add_pre_exec_hook(&mut cmd, limits, None, vec![(5, 3)], false);
+        add_pre_exec_hook(&mut cmd, limits, None, None, vec![(5, 3)], false);
     }
 }
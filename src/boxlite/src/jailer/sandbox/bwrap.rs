@@ -42,7 +42,13 @@ impl Sandbox for BwrapSandbox {
             )));
         }
 
-        let cgroup_config = cgroup::CgroupConfig::from(ctx.resource_limits);
+        let mut cgroup_config = cgroup::CgroupConfig::from(ctx.resource_limits);
+        if let Some(placement) = ctx.placement {
+            cgroup_config.cpuset_cpus = Some(placement.cpu_list());
+            if !placement.mems.is_empty() {
+                cgroup_config.cpuset_mems = Some(placement.mem_list());
+            }
+        }
 
         match cgroup::setup_cgroup(ctx.id, &cgroup_config) {
             Ok(path) => {
@@ -185,6 +191,7 @@ mod tests {
             network_enabled: false,
             sandbox_profile: None,
             detached: false,
+            placement: None,
         };
 
         let shim = "/var/lib/boxlite/boxes/abc/bin/boxlite-shim";
@@ -229,6 +236,7 @@ mod tests {
                 network_enabled: false,
                 sandbox_profile: None,
                 detached,
+                placement: None,
             };
             let mut cmd = Command::new("/var/lib/boxlite/boxes/abc/bin/boxlite-shim");
             BwrapSandbox::new().apply(&ctx, &mut cmd);
@@ -129,6 +129,7 @@ mod tests {
             network_enabled: false,
             sandbox_profile: None,
             detached: false,
+            placement: None,
         }
     }
 
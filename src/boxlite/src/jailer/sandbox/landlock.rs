@@ -92,6 +92,7 @@ mod tests {
             network_enabled: false,
             sandbox_profile: None,
             detached: false,
+            placement: None,
         }
     }
 
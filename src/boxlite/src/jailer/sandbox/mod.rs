@@ -44,6 +44,7 @@ pub use landlock::LandlockSandbox;
 pub use seatbelt::SeatbeltSandbox;
 
 use crate::runtime::advanced_options::ResourceLimits;
+use crate::runtime::placement::BoxPlacement;
 use boxlite_shared::errors::BoxliteResult;
 use std::path::{Path, PathBuf};
 use std::process::Command;
@@ -129,6 +130,8 @@ pub struct SandboxContext<'a> {
     /// launching process, so the sandbox must not tie their lifetime to it
     /// (e.g. bwrap's `--die-with-parent`).
     pub detached: bool,
+    /// Host CPU / NUMA placement (for the cgroup cpuset).
+    pub placement: Option<&'a BoxPlacement>,
 }
 
 impl SandboxContext<'_> {
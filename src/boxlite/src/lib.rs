@@ -39,31 +39,38 @@ pub use runtime::{AuthHandle, BoxliteRuntime, ImageHandle, Principal};
 pub use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 pub use disk::DiskInfo;
 pub use event_listener::{AuditEvent, AuditEventKind, AuditEventListener, EventListener};
+pub use images::{ImagePullOptions, ImagePullProgress, ImagePullProgressFn};
 pub use litebox::SnapshotHandle;
 pub use litebox::archive::ArchiveManifest;
 pub use litebox::snapshot_mgr::SnapshotInfo;
 pub use litebox::{
-    BoxCommand, CopyOptions, ExecResult, ExecStderr, ExecStdin, ExecStdout, Execution, ExecutionId,
-    HealthState, HealthStatus,
+    BoxCommand, CopyOptions, ExecOutputBytes, ExecResult, ExecStderr, ExecStdin, ExecStdout,
+    Execution, ExecutionId, HealthState, HealthStatus,
+};
+pub use metrics::{
+    BoxMetrics, BoxMetricsSample, BoxMetricsSampler, GuestMemoryStats, Histogram,
+    HistogramSnapshot, InitTaskTrace, MemoryReclaimResult, RuntimeMetrics,
 };
-pub use metrics::{BoxMetrics, RuntimeMetrics};
 pub use runtime::advanced_options::{
-    AdvancedBoxOptions, HealthCheckOptions, ResourceLimits, SecurityOptions,
+    AdvancedBoxOptions, CpuPlacement, HealthCheckOptions, MemoryReclaimOptions, ResourceLimits,
+    SecurityOptions,
 };
 pub use runtime::options::{
-    BoxArchive, BoxOptions, BoxliteOptions, CloneOptions, ExportOptions, ImageRegistry,
-    ImageRegistryAuth, NetworkSpec, RegistryTransport, RootfsSpec, Secret, SnapshotOptions,
+    BoxArchive, BoxOptions, BoxliteOptions, CloneOptions, ExportOptions, ExportProgress,
+    ExportProgressFn, ImageRegistry, ImageRegistryAuth, NetworkSpec, RegistryTransport, RootfsSpec,
+    Secret, SnapshotOptions,
 };
 /// Boxlite library version (from CARGO_PKG_VERSION at compile time).
 pub const VERSION: &str = env!("CARGO_PKG_VERSION");
 pub use runtime::id::{BaseDiskID, BaseDiskIDMint, BoxID, BoxIDMint};
+pub use runtime::placement::BoxPlacement;
 pub use runtime::types::ContainerID;
-pub use runtime::types::{BoxInfo, BoxState, BoxStateInfo, BoxStatus};
+pub use runtime::types::{BoxInfo, BoxInfoPage, BoxListFilter, BoxState, BoxStateInfo, BoxStatus};
 
 #[cfg(feature = "rest")]
 pub use rest::credential::{AccessToken, ApiKeyCredential, Credential};
 #[cfg(feature = "rest")]
-pub use rest::options::BoxliteRestOptions;
+pub use rest::options::{BoxliteRestOptions, RestHttpOptions};
 
 /// Opt-in helper for executables (SDK bindings, daemons, embedders) that want
 /// the default Boxlite file logger at `<home_dir>/logs/boxlite.log` with daily
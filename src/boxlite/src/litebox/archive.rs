@@ -1,7 +1,8 @@
 //! Archive operations for box export and import.
 //!
 //! Handles `.boxlite` archive files: zstd-compressed tarballs containing
-//! disk images and a JSON manifest.
+//! disk images and a JSON manifest. Chunked (v4) archives hold disks as
+//! content-addressed `chunks/` entries instead; see [`super::chunks`].
 
 use std::io::Write;
 use std::path::Path;
@@ -10,6 +11,7 @@ use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 use serde::{Deserialize, Serialize};
 use sha2::{Digest, Sha256};
 
+use super::chunks::{ChunkImport, MAX_CHUNK, chunk_digest, chunk_entry_digest};
 use crate::disk::constants::filenames as disk_filenames;
 
 /// Manifest filename inside the archive.
@@ -18,14 +20,19 @@ pub(crate) const MANIFEST_FILENAME: &str = "manifest.json";
 /// Current archive format version.
 pub(crate) const ARCHIVE_VERSION: u32 = 3;
 
+/// Version of archives whose disks are stored as chunks.
+pub(crate) const CHUNKED_ARCHIVE_VERSION: u32 = 4;
+
 /// Maximum archive version this build can import.
-pub(crate) const MAX_SUPPORTED_VERSION: u32 = 3;
+pub(crate) const MAX_SUPPORTED_VERSION: u32 = 4;
 
 /// Archive manifest stored as `manifest.json` inside exported archives.
 ///
 /// v1: plain tar, no checksums
 /// v2: tar.zst with checksums
 /// v3: adds `box_options` for full configuration preservation
+/// v4: disks stored as chunks (`chunked_disks`), optionally incremental
+///     to a `parent` archive; the manifest is the last entry
 #[derive(Debug, Serialize, Deserialize)]
 pub struct ArchiveManifest {
     /// Archive format version (1, 2, or 3).
@@ -43,6 +50,40 @@ pub struct ArchiveManifest {
     pub container_disk_checksum: String,
     /// Timestamp when the archive was created.
     pub exported_at: String,
+    /// Disks rebuilt from chunks on import (v4+). The disk checksums are
+    /// empty then; every chunk is verified against its digest instead.
+    #[serde(default, skip_serializing_if = "Vec::is_empty")]
+    pub chunked_disks: Vec<ChunkedDisk>,
+    /// Id of the archive this one is incremental to (v4+). Chunks listed in
+    /// `chunked_disks` but missing here come from that parent.
+    #[serde(default, skip_serializing_if = "Option::is_none")]
+    pub parent: Option<String>,
+}
+
+/// A QCOW2 disk stored as content-defined chunks.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct ChunkedDisk {
+    /// Disk filename (`disk.qcow2` or `guest-rootfs.qcow2`).
+    pub name: String,
+    pub virtual_size: u64,
+    pub cluster_bits: u32,
+    /// Runs of allocated clusters, in ascending order.
+    pub extents: Vec<ChunkedExtent>,
+}
+
+/// Contiguous allocated clusters starting at virtual byte `offset`.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct ChunkedExtent {
+    pub offset: u64,
+    pub chunks: Vec<ChunkRef>,
+}
+
+/// One chunk of an extent, stored in the archive as `chunks/<hex>`.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct ChunkRef {
+    /// `sha256:<hex>` of the chunk bytes.
+    pub digest: String,
+    pub len: u64,
 }
 
 // ── Build ───────────────────────────────────────────────────────────────
@@ -113,6 +154,16 @@ const ZSTD_MAGIC: [u8; 4] = [0x28, 0xB5, 0x2F, 0xFD];
 
 /// Extract an archive, detecting format via magic bytes (zstd or plain tar).
 pub(crate) fn extract_archive(archive_path: &Path, dest_dir: &Path) -> BoxliteResult<()> {
+    extract_archive_with_chunks(archive_path, dest_dir, None)
+}
+
+/// [`extract_archive`], storing `chunks/` entries through `chunks` (verified
+/// against their digests) instead of unpacking them into `dest_dir`.
+pub(crate) fn extract_archive_with_chunks(
+    archive_path: &Path,
+    dest_dir: &Path,
+    chunks: Option<&mut ChunkImport>,
+) -> BoxliteResult<()> {
     use std::io::Read;
 
     let mut file = std::fs::File::open(archive_path).map_err(|e| {
@@ -143,30 +194,96 @@ pub(crate) fn extract_archive(archive_path: &Path, dest_dir: &Path) -> BoxliteRe
     })?;
 
     if magic == ZSTD_MAGIC {
-        extract_zstd_tar(file, dest_dir)
+        extract_zstd_tar(file, dest_dir, chunks)
     } else {
-        extract_plain_tar(file, dest_dir)
+        extract_plain_tar(file, dest_dir, chunks)
     }
 }
 
-fn extract_zstd_tar(file: std::fs::File, dest_dir: &Path) -> BoxliteResult<()> {
+fn extract_zstd_tar(
+    file: std::fs::File,
+    dest_dir: &Path,
+    chunks: Option<&mut ChunkImport>,
+) -> BoxliteResult<()> {
     let decoder = zstd::Decoder::new(file)
         .map_err(|e| BoxliteError::Storage(format!("Failed to create zstd decoder: {}", e)))?;
-    let mut archive = tar::Archive::new(decoder);
-    archive
-        .unpack(dest_dir)
-        .map_err(|e| BoxliteError::Storage(format!("Failed to extract zstd tar: {}", e)))?;
-    Ok(())
+    unpack_tar(tar::Archive::new(decoder), dest_dir, chunks)
+        .map_err(|e| BoxliteError::Storage(format!("Failed to extract zstd tar: {}", e)))
 }
 
-fn extract_plain_tar(file: std::fs::File, dest_dir: &Path) -> BoxliteResult<()> {
-    let mut archive = tar::Archive::new(file);
-    archive
-        .unpack(dest_dir)
-        .map_err(|e| BoxliteError::Storage(format!("Failed to extract archive: {}", e)))?;
+fn extract_plain_tar(
+    file: std::fs::File,
+    dest_dir: &Path,
+    chunks: Option<&mut ChunkImport>,
+) -> BoxliteResult<()> {
+    unpack_tar(tar::Archive::new(file), dest_dir, chunks)
+        .map_err(|e| BoxliteError::Storage(format!("Failed to extract archive: {}", e)))
+}
+
+fn unpack_tar<R: std::io::Read>(
+    mut archive: tar::Archive<R>,
+    dest_dir: &Path,
+    chunks: Option<&mut ChunkImport>,
+) -> Result<(), String> {
+    use std::io::Read;
+
+    let Some(store) = chunks else {
+        return archive.unpack(dest_dir).map_err(|e| e.to_string());
+    };
+    for entry in archive.entries().map_err(|e| e.to_string())? {
+        let mut entry = entry.map_err(|e| e.to_string())?;
+        let path = entry.path().map_err(|e| e.to_string())?.into_owned();
+        match chunk_entry_digest(&path) {
+            Some(digest) => {
+                if entry.size() > MAX_CHUNK as u64 {
+                    return Err(format!("chunk {} exceeds {} bytes", digest, MAX_CHUNK));
+                }
+                let mut data = Vec::with_capacity(entry.size() as usize);
+                entry.read_to_end(&mut data).map_err(|e| e.to_string())?;
+                store.put(&digest, &data).map_err(|e| e.to_string())?;
+            }
+            None => {
+                entry.unpack_in(dest_dir).map_err(|e| e.to_string())?;
+            }
+        }
+    }
     Ok(())
 }
 
+/// Read only the manifest of an archive, returning it with the archive id
+/// (`sha256:` of the manifest bytes) that incremental children refer to.
+pub(crate) fn read_manifest(archive_path: &Path) -> BoxliteResult<(ArchiveManifest, String)> {
+    use std::io::Read;
+
+    let file = std::fs::File::open(archive_path).map_err(|e| {
+        BoxliteError::Storage(format!(
+            "Failed to open archive {}: {}",
+            archive_path.display(),
+            e
+        ))
+    })?;
+    let decoder = zstd::Decoder::new(file)
+        .map_err(|e| BoxliteError::Storage(format!("Failed to create zstd decoder: {}", e)))?;
+    let mut archive = tar::Archive::new(decoder);
+    let read_err =
+        |e: std::io::Error| BoxliteError::Storage(format!("Failed to read archive: {}", e));
+    for entry in archive.entries().map_err(read_err)? {
+        let mut entry = entry.map_err(read_err)?;
+        if entry.path().map_err(read_err)?.as_os_str() != MANIFEST_FILENAME {
+            continue;
+        }
+        let mut json = Vec::new();
+        entry.read_to_end(&mut json).map_err(read_err)?;
+        let manifest = serde_json::from_slice(&json)
+            .map_err(|e| BoxliteError::Storage(format!("Invalid manifest: {}", e)))?;
+        return Ok((manifest, chunk_digest(&json)));
+    }
+    Err(BoxliteError::Storage(format!(
+        "Invalid archive {}: manifest.json not found",
+        archive_path.display()
+    )))
+}
+
 // ── File Operations ─────────────────────────────────────────────────────
 
 /// Move a file, falling back to copy+remove if rename fails with EXDEV
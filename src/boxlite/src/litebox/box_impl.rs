@@ -10,6 +10,7 @@ use std::sync::atomic::Ordering;
 use std::time::{Duration, Instant};
 
 use parking_lot::RwLock;
+use tokio::io::AsyncWrite;
 use tokio::sync::OnceCell;
 use tokio::task::JoinHandle;
 use tokio::time::timeout;
@@ -25,13 +26,17 @@ use crate::event_listener::EventListener;
 #[cfg(target_os = "linux")]
 use crate::fs::BindMountHandle;
 use crate::litebox::BoxTunnel;
-use crate::litebox::copy::CopyOptions;
+use crate::litebox::copy::{ChunkSender, CopyOptions, CopyReader};
 use crate::lock::LockGuard;
-use crate::metrics::{BoxMetrics, BoxMetricsStorage};
+use crate::metrics::{BoxMetrics, BoxMetricsStorage, MemoryReclaimResult};
 use crate::net::NetworkBackend;
 use crate::portal::GuestSession;
 use crate::portal::interfaces::GuestInterface;
+use crate::portal::interfaces::exec::{ExecComponents, ExecutionInterface};
+use crate::portal::interfaces::files::read_chunks;
+use crate::runtime::advanced_options::CpuPlacement;
 use crate::runtime::layout::BoxFilesystemLayout;
+use crate::runtime::placement::PlacementReservation;
 use crate::runtime::rt_impl::SharedRuntimeImpl;
 use crate::runtime::types::BoxStatus;
 use crate::vmm::controller::VmmHandler;
@@ -239,8 +244,77 @@ impl BoxImpl {
     }
 
     pub(crate) async fn exec(&self, command: BoxCommand) -> BoxliteResult<Execution> {
-        use boxlite_shared::constants::executor as executor_const;
+        let live = self.exec_live_state().await?;
+        let command = self.prepare_command(command);
+
+        let exec_start = Instant::now();
+        let mut exec_interface = live.guest_session.execution().await?;
+        let result = exec_interface
+            .exec(
+                command,
+                self.shutdown_token.clone(),
+                live.metrics.exec_response_latency_us.clone(),
+            )
+            .await;
+        if result.is_ok() {
+            self.runtime
+                .runtime_metrics
+                .exec_start_latency_us
+                .record_micros(exec_start.elapsed());
+        }
+        self.record_exec(live, result.is_ok());
+
+        let components = result?;
+        Ok(Self::execution_from(components, exec_interface))
+    }
 
+    /// Start several commands with one guest round trip.
+    ///
+    /// Each command is prepared exactly like [`Self::exec`]; results are in
+    /// command order and one failed spawn does not affect the others.
+    pub(crate) async fn exec_many(
+        &self,
+        commands: Vec<BoxCommand>,
+    ) -> BoxliteResult<Vec<BoxliteResult<Execution>>> {
+        let live = self.exec_live_state().await?;
+        let commands: Vec<BoxCommand> = commands
+            .into_iter()
+            .map(|command| self.prepare_command(command))
+            .collect();
+
+        let exec_start = Instant::now();
+        let mut exec_interface = live.guest_session.execution().await?;
+        let results = exec_interface
+            .exec_batch(
+                &commands,
+                self.shutdown_token.clone(),
+                live.metrics.exec_response_latency_us.clone(),
+            )
+            .await
+            .inspect_err(|_| {
+                for _ in &commands {
+                    self.record_exec(live, false);
+                }
+            })?;
+        let elapsed = exec_start.elapsed();
+
+        Ok(results
+            .into_iter()
+            .map(|result| {
+                if result.is_ok() {
+                    self.runtime
+                        .runtime_metrics
+                        .exec_start_latency_us
+                        .record_micros(elapsed);
+                }
+                self.record_exec(live, result.is_ok());
+                result.map(|components| Self::execution_from(components, exec_interface.clone()))
+            })
+            .collect())
+    }
+
+    /// Live state for an exec, failing once the handle has been stopped.
+    async fn exec_live_state(&self) -> BoxliteResult<&LiveState> {
         // Check if box is stopped before proceeding (via stop() or runtime shutdown)
         if self.shutdown_token.is_cancelled() {
             return Err(BoxliteError::Stopped(
@@ -248,7 +322,12 @@ impl BoxImpl {
             ));
         }
 
-        let live = self.live_state().await?;
+        self.live_state().await
+    }
+
+    /// Fill in box defaults for a command and notify listeners.
+    fn prepare_command(&self, command: BoxCommand) -> BoxCommand {
+        use boxlite_shared::constants::executor as executor_const;
 
         // Inject container ID into environment if not already set
         let command = if command
@@ -274,36 +353,41 @@ impl BoxImpl {
         for listener in &self.event_listeners {
             listener.on_exec_started(&self.config.id, &command.command, &command.args);
         }
+        command
+    }
 
-        let mut exec_interface = live.guest_session.execution().await?;
-        let result = exec_interface
-            .exec(command, self.shutdown_token.clone())
-            .await;
-
-        // Instrument metrics
+    /// Count one exec attempt in the box and runtime metrics.
+    fn record_exec(&self, live: &LiveState, ok: bool) {
         live.metrics.increment_commands_executed();
         self.runtime
             .runtime_metrics
             .total_commands
             .fetch_add(1, Ordering::Relaxed);
 
-        if result.is_err() {
+        if !ok {
             live.metrics.increment_exec_errors();
             self.runtime
                 .runtime_metrics
                 .total_exec_errors
                 .fetch_add(1, Ordering::Relaxed);
         }
+    }
 
-        let components = result?;
-        Ok(Execution::new(
+    fn execution_from(components: ExecComponents, exec_interface: ExecutionInterface) -> Execution {
+        Execution::new(
             components.execution_id,
             Box::new(exec_interface),
             components.result_rx,
             Some(ExecStdin::new(components.stdin_tx)),
-            Some(ExecStdout::new(components.stdout_rx)),
-            Some(ExecStderr::new(components.stderr_rx)),
-        ))
+            Some(ExecStdout::with_window(
+                components.stdout_rx,
+                components.stdout_window,
+            )),
+            Some(ExecStderr::with_window(
+                components.stderr_rx,
+                components.stderr_window,
+            )),
+        )
     }
 
     pub(crate) async fn metrics(&self) -> BoxliteResult<BoxMetrics> {
@@ -321,15 +405,40 @@ impl BoxImpl {
             .map_err(|e| BoxliteError::Internal(format!("handler lock poisoned: {}", e)))?;
         let raw = handler.metrics()?;
 
-        Ok(BoxMetrics::from_storage(
-            &live.metrics,
-            raw.cpu_percent,
-            raw.memory_bytes,
-            None,
-            None,
-            None,
-            None,
-        ))
+        Ok(BoxMetrics {
+            host_rss_bytes: raw.host_rss_bytes,
+            ..BoxMetrics::from_storage(
+                &live.metrics,
+                raw.cpu_percent,
+                raw.memory_bytes,
+                None,
+                None,
+                None,
+                None,
+            )
+        })
+    }
+
+    pub(crate) async fn reclaim_memory(
+        &self,
+        target_bytes: u64,
+    ) -> BoxliteResult<MemoryReclaimResult> {
+        if self.shutdown_token.is_cancelled() {
+            return Err(BoxliteError::Stopped(
+                "Handle invalidated after stop(). Use runtime.get() to get a new handle.".into(),
+            ));
+        }
+
+        let live = self.live_state().await?;
+        let mut guest = live.guest_session.guest().await?;
+        let result = guest.reclaim_memory(target_bytes).await?;
+        tracing::debug!(
+            box_id = %self.config.id,
+            reclaimed = result.reclaimed,
+            freed_bytes = result.freed_bytes(),
+            "Guest memory reclaim"
+        );
+        Ok(result)
     }
 
     pub(crate) async fn stop(&self) -> BoxliteResult<()> {
@@ -505,34 +614,44 @@ impl BoxImpl {
             ));
         }
 
-        let temp_tar = self.runtime.layout.temp_dir().join(format!(
-            "cp-in-{}-{}.tar",
-            self.config.id.as_str(),
-            uuid::Uuid::new_v4()
-        ));
-
-        boxlite_shared::tar::pack(
-            host_src.to_path_buf(),
-            temp_tar.clone(),
-            boxlite_shared::tar::PackContext {
-                follow_symlinks: opts.follow_symlinks,
-                include_parent: opts.include_parent,
-            },
-        )
-        .await?;
-
         let mut files_iface = live.guest_session.files().await?;
-        files_iface
-            .upload_tar(
-                &temp_tar,
+        if opts.delta && host_src.is_dir() {
+            super::delta::sync_dir(
+                &mut files_iface,
+                host_src,
                 container_dst,
-                Some(self.container_id()),
-                true,
-                opts.overwrite,
+                self.container_id(),
+                &opts,
             )
             .await?;
-
-        let _ = tokio::fs::remove_file(&temp_tar).await;
+        } else {
+            // Pack on a blocking thread straight into the upload, so neither
+            // memory nor scratch disk grows with the size of the source.
+            let (mut sender, chunks) = ChunkSender::channel();
+            let src = host_src.to_path_buf();
+            let pack_ctx = boxlite_shared::tar::PackContext {
+                follow_symlinks: opts.follow_symlinks,
+                include_parent: opts.include_parent,
+            };
+            let packer = tokio::task::spawn_blocking(move || {
+                let packed = boxlite_shared::tar::pack_to_writer(&src, &mut sender, &pack_ctx);
+                sender.finish(packed.map(drop));
+            });
+
+            let uploaded = files_iface
+                .upload_stream(
+                    tokio_stream::wrappers::ReceiverStream::new(chunks),
+                    container_dst,
+                    Some(self.container_id()),
+                    true,
+                    opts.overwrite,
+                )
+                .await;
+            packer
+                .await
+                .map_err(|e| BoxliteError::Internal(format!("pack task join error: {}", e)))?;
+            uploaded?;
+        }
 
         for listener in &self.event_listeners {
             listener.on_file_copied_in(
@@ -621,6 +740,105 @@ impl BoxImpl {
         Ok(())
     }
 
+    /// Upload an uncompressed tar stream and extract it at `container_dst`.
+    ///
+    /// `tar` is read one chunk ahead of the transfer; nothing is staged on
+    /// the host.
+    pub(crate) async fn copy_into_stream(
+        &self,
+        tar: CopyReader,
+        container_dst: &str,
+        opts: CopyOptions,
+    ) -> BoxliteResult<()> {
+        let t0 = Instant::now();
+
+        if self.shutdown_token.is_cancelled() {
+            return Err(BoxliteError::Stopped(
+                "Handle invalidated after stop(). Use runtime.get() to get a new handle.".into(),
+            ));
+        }
+
+        let live = self.live_state().await?;
+
+        if container_dst.is_empty() {
+            return Err(BoxliteError::Config(
+                "destination path cannot be empty".into(),
+            ));
+        }
+
+        let mut files_iface = live.guest_session.files().await?;
+        files_iface
+            .upload_stream(
+                read_chunks(tar),
+                container_dst,
+                Some(self.container_id()),
+                true,
+                opts.overwrite,
+            )
+            .await?;
+
+        for listener in &self.event_listeners {
+            listener.on_file_copied_in(&self.config.id, "-", container_dst);
+        }
+
+        tracing::info!(
+            box_id = %self.config.id,
+            elapsed_ms = t0.elapsed().as_millis() as u64,
+            dst = container_dst,
+            "copy_into_stream completed"
+        );
+        Ok(())
+    }
+
+    /// Archive `container_src` and write the tar stream to `sink`.
+    ///
+    /// Each chunk is written before the next is requested, so a slow sink
+    /// throttles the guest instead of buffering on the host.
+    pub(crate) async fn copy_out_stream(
+        &self,
+        container_src: &str,
+        sink: &mut (dyn AsyncWrite + Send + Unpin),
+        opts: CopyOptions,
+    ) -> BoxliteResult<()> {
+        let t0 = Instant::now();
+
+        if self.shutdown_token.is_cancelled() {
+            return Err(BoxliteError::Stopped(
+                "Handle invalidated after stop(). Use runtime.get() to get a new handle.".into(),
+            ));
+        }
+
+        let live = self.live_state().await?;
+
+        if container_src.is_empty() {
+            return Err(BoxliteError::Config("source path cannot be empty".into()));
+        }
+
+        let mut files_iface = live.guest_session.files().await?;
+        let bytes = files_iface
+            .download_to(
+                container_src,
+                Some(self.container_id()),
+                opts.include_parent,
+                opts.follow_symlinks,
+                sink,
+            )
+            .await?;
+
+        for listener in &self.event_listeners {
+            listener.on_file_copied_out(&self.config.id, container_src, "-");
+        }
+
+        tracing::info!(
+            box_id = %self.config.id,
+            elapsed_ms = t0.elapsed().as_millis() as u64,
+            src = container_src,
+            bytes,
+            "copy_out_stream completed"
+        );
+        Ok(())
+    }
+
     // ========================================================================
     // LIVE STATE INITIALIZATION (internal)
     // ========================================================================
@@ -683,7 +901,18 @@ impl BoxImpl {
         // The returned cleanup_guard stays armed until we disarm it after all
         // operations succeed. If any operation fails, the guard's Drop will
         // cleanup the VM process and directory.
-        let builder = BoxBuilder::new(Arc::clone(&self.runtime), self.config.clone(), state)?;
+        // A fresh VMM gets a placement; a reattached one keeps its own. The
+        // reservation stays held until the placement is saved below.
+        let reservation = match &self.config.options.advanced.placement {
+            Some(policy) if state.status != BoxStatus::Running => {
+                Some(self.reserve_placement(policy)?)
+            }
+            _ => None,
+        };
+        let placement = reservation.as_ref().map(|r| r.placement().clone());
+
+        let builder = BoxBuilder::new(Arc::clone(&self.runtime), self.config.clone(), state)?
+            .with_placement(placement.clone());
         let (live_state, mut cleanup_guard) = builder.build().await?;
 
         // Read PID from file (single source of truth) and update state.
@@ -705,6 +934,9 @@ impl BoxImpl {
             let mut state = self.state.write();
             state.set_pid(Some(pid));
             state.set_status(BoxStatus::Running);
+            if reservation.is_some() {
+                state.set_placement(placement);
+            }
 
             // Initialize health status if health check is configured
             if self.config.options.advanced.health_check.is_some() {
@@ -755,6 +987,26 @@ impl BoxImpl {
         Ok(live_state)
     }
 
+    /// Resolve this box's placement, packing around the placements of the
+    /// other active boxes in this home.
+    fn reserve_placement(&self, policy: &CpuPlacement) -> BoxliteResult<PlacementReservation> {
+        use crate::runtime::constants::vm_defaults::DEFAULT_CPUS;
+
+        let running = self
+            .runtime
+            .box_manager
+            .all_boxes(true)?
+            .into_iter()
+            .filter(|(_, state)| state.status.is_active())
+            .filter_map(|(config, state)| Some((config.id, state.placement?)));
+        self.runtime.placement.reserve(
+            &self.config.id,
+            policy,
+            self.config.options.cpus.unwrap_or(DEFAULT_CPUS),
+            running,
+        )
+    }
+
     pub fn spawn_health_check(
         &self,
         state: Arc<RwLock<BoxState>>,
@@ -1120,10 +1372,21 @@ impl crate::runtime::backend::BoxBackend for BoxImpl {
         self.exec(command).await
     }
 
+    async fn exec_many(
+        &self,
+        commands: Vec<BoxCommand>,
+    ) -> BoxliteResult<Vec<BoxliteResult<Execution>>> {
+        self.exec_many(commands).await
+    }
+
     async fn metrics(&self) -> BoxliteResult<BoxMetrics> {
         self.metrics().await
     }
 
+    async fn reclaim_memory(&self, target_bytes: u64) -> BoxliteResult<MemoryReclaimResult> {
+        self.reclaim_memory(target_bytes).await
+    }
+
     async fn stop(&self) -> BoxliteResult<()> {
         self.stop().await
     }
@@ -1146,6 +1409,24 @@ impl crate::runtime::backend::BoxBackend for BoxImpl {
         self.copy_out(container_src, host_dst, opts).await
     }
 
+    async fn copy_into_stream(
+        &self,
+        tar: CopyReader,
+        container_dst: &str,
+        opts: CopyOptions,
+    ) -> BoxliteResult<()> {
+        self.copy_into_stream(tar, container_dst, opts).await
+    }
+
+    async fn copy_out_stream(
+        &self,
+        container_src: &str,
+        sink: &mut (dyn AsyncWrite + Send + Unpin),
+        opts: CopyOptions,
+    ) -> BoxliteResult<()> {
+        self.copy_out_stream(container_src, sink, opts).await
+    }
+
     async fn clone_box(
         &self,
         options: crate::runtime::options::CloneOptions,
@@ -0,0 +1,757 @@
+//! Content-defined chunking for chunked (v4) box archives.
+//!
+//! A chunked export reads each disk's backing chain cluster by cluster
+//! (`Qcow2Helper::read_chain_clusters`) and splits every run of allocated
+//! clusters into chunks with a gear rolling hash. Chunk boundaries follow
+//! the content, so a cluster written between two exports only changes the
+//! chunks around it, and data that moved keeps its chunks. Chunks are
+//! stored once per archive as `chunks/<hex>` entries, and an incremental
+//! export also leaves out every chunk its parent archive already has.
+//!
+//! Import stores the chunks in a content-addressed [`ChunkStore`] under the
+//! runtime home and rebuilds the QCOW2 files from the manifest, taking the
+//! chunks an incremental archive omits from earlier imports. A failed
+//! import takes back the chunks it added ([`ChunkImport`]). Each imported
+//! box holds refs on its archive's chunks (`chunk_ref` table), and
+//! [`ChunkManager::release_box`] deletes the chunks its removal orphans.
+
+use std::collections::HashSet;
+use std::io::Write;
+use std::path::{Path, PathBuf};
+use std::sync::Arc;
+
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+use sha2::{Digest, Sha256};
+
+use super::archive::{ArchiveManifest, ChunkRef, ChunkedDisk, ChunkedExtent, MANIFEST_FILENAME};
+use crate::db::ChunkRefStore;
+use crate::disk::constants::filenames as disk_filenames;
+use crate::disk::{Qcow2Geometry, Qcow2Writer};
+
+/// Archive directory holding chunk entries.
+const CHUNKS_DIR: &str = "chunks";
+
+/// Ref owner prefix of an import that has not created its box yet.
+const IMPORT_OWNER_PREFIX: &str = "import-";
+
+/// Chunks are at least this long, except at the end of an extent.
+pub(crate) const MIN_CHUNK: usize = 128 * 1024;
+
+/// Chunks are cut at this length even without a content boundary.
+pub(crate) const MAX_CHUNK: usize = 2 * 1024 * 1024;
+
+/// A boundary needs the top `AVG_CHUNK_BITS` hash bits clear, giving
+/// ~512 KiB chunks on average past `MIN_CHUNK`.
+const AVG_CHUNK_BITS: u32 = 19;
+
+/// Random per-byte values for the gear hash (splitmix64, fixed seed, so
+/// boundaries are stable across builds).
+const GEAR: [u64; 256] = {
+    let mut table = [0u64; 256];
+    let mut state: u64 = 0x9E37_79B9_7F4A_7C15;
+    let mut i = 0;
+    while i < 256 {
+        state = state.wrapping_add(0x9E37_79B9_7F4A_7C15);
+        let mut z = state;
+        z = (z ^ (z >> 30)).wrapping_mul(0xBF58_476D_1CE4_E5B9);
+        z = (z ^ (z >> 27)).wrapping_mul(0x94D0_49BB_1331_11EB);
+        table[i] = z ^ (z >> 31);
+        i += 1;
+    }
+    table
+};
+
+/// `sha256:<hex>` of `data`.
+pub(crate) fn chunk_digest(data: &[u8]) -> String {
+    format!("sha256:{:x}", Sha256::digest(data))
+}
+
+/// The hex part of a well-formed `sha256:<64 lowercase hex>` digest.
+fn digest_hex(digest: &str) -> Option<&str> {
+    let hex = digest.strip_prefix("sha256:")?;
+    (hex.len() == 64 && hex.bytes().all(|b| matches!(b, b'0'..=b'9' | b'a'..=b'f'))).then_some(hex)
+}
+
+/// Digest of an archive entry at `chunks/<hex>`, or `None` for other entries.
+pub(crate) fn chunk_entry_digest(path: &Path) -> Option<String> {
+    let hex = path.strip_prefix(CHUNKS_DIR).ok()?.to_str()?;
+    let digest = format!("sha256:{}", hex);
+    digest_hex(&digest).is_some().then_some(digest)
+}
+
+/// Splits a byte stream into content-defined chunks.
+pub(crate) struct Chunker {
+    buf: Vec<u8>,
+    hash: u64,
+    /// Bytes of `buf` already fed to `hash` without finding a boundary.
+    scanned: usize,
+}
+
+impl Chunker {
+    pub(crate) fn new() -> Self {
+        Self {
+            buf: Vec::with_capacity(MAX_CHUNK),
+            hash: 0,
+            scanned: 0,
+        }
+    }
+
+    /// Append `data`, calling `emit` for every chunk it completes.
+    pub(crate) fn push(
+        &mut self,
+        data: &[u8],
+        emit: &mut dyn FnMut(&[u8]) -> BoxliteResult<()>,
+    ) -> BoxliteResult<()> {
+        self.buf.extend_from_slice(data);
+        while let Some(cut) = self.find_boundary() {
+            emit(&self.buf[..cut])?;
+            self.buf.drain(..cut);
+            self.hash = 0;
+            self.scanned = 0;
+        }
+        Ok(())
+    }
+
+    /// Emit whatever is buffered as the final chunk.
+    pub(crate) fn finish(
+        &mut self,
+        emit: &mut dyn FnMut(&[u8]) -> BoxliteResult<()>,
+    ) -> BoxliteResult<()> {
+        if !self.buf.is_empty() {
+            emit(&self.buf)?;
+        }
+        self.buf.clear();
+        self.hash = 0;
+        self.scanned = 0;
+        Ok(())
+    }
+
+    fn find_boundary(&mut self) -> Option<usize> {
+        for i in self.scanned..self.buf.len() {
+            self.hash = (self.hash << 1).wrapping_add(GEAR[self.buf[i] as usize]);
+            let len = i + 1;
+            if (len >= MIN_CHUNK && self.hash >> (64 - AVG_CHUNK_BITS) == 0) || len >= MAX_CHUNK {
+                return Some(len);
+            }
+        }
+        self.scanned = self.buf.len();
+        None
+    }
+}
+
+/// Content-addressed chunk files: `<root>/<hex[..2]>/<hex>`.
+#[derive(Clone)]
+pub(crate) struct ChunkStore {
+    root: PathBuf,
+}
+
+impl ChunkStore {
+    pub(crate) fn new(root: PathBuf) -> Self {
+        Self { root }
+    }
+
+    fn path(&self, digest: &str) -> BoxliteResult<PathBuf> {
+        let hex = digest_hex(digest)
+            .ok_or_else(|| BoxliteError::Storage(format!("Invalid chunk digest '{}'", digest)))?;
+        Ok(self.root.join(&hex[..2]).join(hex))
+    }
+
+    /// Store `data` under `digest` after checking that it matches. Returns
+    /// whether the chunk was new to the store.
+    pub(crate) fn put(&self, digest: &str, data: &[u8]) -> BoxliteResult<bool> {
+        let path = self.path(digest)?;
+        let actual = chunk_digest(data);
+        if actual != digest {
+            return Err(BoxliteError::Storage(format!(
+                "Chunk checksum mismatch: expected {}, got {}",
+                digest, actual
+            )));
+        }
+        if path.exists() {
+            return Ok(false);
+        }
+
+        let dir = path.parent().expect("chunk path has a parent");
+        std::fs::create_dir_all(dir).map_err(|e| {
+            BoxliteError::Storage(format!(
+                "Failed to create chunk directory {}: {}",
+                dir.display(),
+                e
+            ))
+        })?;
+        // Write then rename, so a crash never leaves a truncated chunk.
+        let mut tmp = tempfile::NamedTempFile::new_in(dir)
+            .map_err(|e| BoxliteError::Storage(format!("Failed to create chunk file: {}", e)))?;
+        tmp.write_all(data)
+            .map_err(|e| BoxliteError::Storage(format!("Failed to write chunk: {}", e)))?;
+        tmp.persist(&path).map_err(|e| {
+            BoxliteError::Storage(format!("Failed to store chunk {}: {}", path.display(), e))
+        })?;
+        Ok(true)
+    }
+
+    pub(crate) fn read(&self, digest: &str) -> BoxliteResult<Option<Vec<u8>>> {
+        match std::fs::read(self.path(digest)?) {
+            Ok(data) => Ok(Some(data)),
+            Err(e) if e.kind() == std::io::ErrorKind::NotFound => Ok(None),
+            Err(e) => Err(BoxliteError::Storage(format!(
+                "Failed to read chunk {}: {}",
+                digest, e
+            ))),
+        }
+    }
+
+    /// Delete a chunk file; a missing chunk is not an error.
+    fn remove(&self, digest: &str) {
+        let Ok(path) = self.path(digest) else {
+            return;
+        };
+        if let Err(e) = std::fs::remove_file(&path)
+            && e.kind() != std::io::ErrorKind::NotFound
+        {
+            tracing::warn!("Failed to remove chunk {}: {}", digest, e);
+        }
+    }
+}
+
+/// A [`ChunkStore`] with per-box refs, collecting chunks no box uses.
+///
+/// `lock` serializes imports with collection: an import holds it while it
+/// stores and reads chunks and records its refs, so a box removal cannot
+/// delete a chunk the import has seen but not yet referenced.
+#[derive(Clone)]
+pub(crate) struct ChunkManager {
+    store: ChunkStore,
+    refs: ChunkRefStore,
+    lock: Arc<parking_lot::Mutex<()>>,
+}
+
+impl ChunkManager {
+    pub(crate) fn new(root: PathBuf, refs: ChunkRefStore) -> Self {
+        Self {
+            store: ChunkStore::new(root),
+            refs,
+            lock: Arc::new(parking_lot::Mutex::new(())),
+        }
+    }
+
+    /// Exclude collection until the guard drops.
+    pub(crate) fn gc_lock(&self) -> parking_lot::MutexGuard<'_, ()> {
+        self.lock.lock()
+    }
+
+    /// Drop the refs of `owner` and delete the chunks nothing else holds.
+    ///
+    /// Best-effort like `BaseDiskManager::try_gc_base`: failures are logged
+    /// and the chunks stay until a later removal.
+    pub(crate) fn release_box(&self, owner: &str) {
+        let _guard = self.lock.lock();
+        self.release_locked(owner);
+    }
+
+    /// Release the refs of imports that died before creating their box.
+    pub(crate) fn release_stale_imports(&self) {
+        let _guard = self.lock.lock();
+        match self.refs.owners_with_prefix(IMPORT_OWNER_PREFIX) {
+            Ok(owners) => owners.iter().for_each(|owner| self.release_locked(owner)),
+            Err(e) => tracing::warn!("Failed to list stale chunk imports: {}", e),
+        }
+    }
+
+    fn release_locked(&self, owner: &str) {
+        let orphans = match self.refs.remove_all_refs_for_box(owner) {
+            Ok(orphans) => orphans,
+            Err(e) => {
+                tracing::warn!(owner, error = %e, "Failed to release chunk refs");
+                return;
+            }
+        };
+        for digest in &orphans {
+            self.store.remove(digest);
+        }
+        if !orphans.is_empty() {
+            tracing::info!(
+                owner,
+                chunks = orphans.len(),
+                "Collected unreferenced chunks"
+            );
+        }
+    }
+}
+
+/// The chunks one import adds to a [`ChunkStore`], and its refs.
+///
+/// Refs go in under a provisional `import-<uuid>` owner
+/// ([`record`](Self::record)) and move to the box once it exists
+/// ([`keep`](Self::keep)). Dropping it before then releases the refs and
+/// removes the chunks it added, so a failed or rejected archive leaves
+/// nothing behind. Chunks other boxes hold are never removed.
+pub(crate) struct ChunkImport {
+    mgr: ChunkManager,
+    owner: String,
+    added: Vec<String>,
+    kept: bool,
+}
+
+impl ChunkImport {
+    pub(crate) fn new(mgr: ChunkManager) -> Self {
+        Self {
+            mgr,
+            owner: format!("{}{}", IMPORT_OWNER_PREFIX, uuid::Uuid::new_v4()),
+            added: Vec::new(),
+            kept: false,
+        }
+    }
+
+    pub(crate) fn store(&self) -> &ChunkStore {
+        &self.mgr.store
+    }
+
+    /// [`ChunkStore::put`], remembering the chunk if it is new.
+    pub(crate) fn put(&mut self, digest: &str, data: &[u8]) -> BoxliteResult<()> {
+        if self.mgr.store.put(digest, data)? {
+            self.added.push(digest.to_string());
+        }
+        Ok(())
+    }
+
+    /// Ref the chunks in `used` (and every chunk this import added) under
+    /// the provisional owner. Call with [`ChunkManager::gc_lock`] held.
+    pub(crate) fn record(&self, used: &HashSet<String>) -> BoxliteResult<()> {
+        let mut digests = used.clone();
+        digests.extend(self.added.iter().cloned());
+        self.mgr.refs.add_refs(&self.owner, &digests)
+    }
+
+    /// The import created `box_id`: its refs now belong to that box.
+    pub(crate) fn keep(mut self, box_id: &str) -> BoxliteResult<()> {
+        self.mgr.refs.rename_owner(&self.owner, box_id)?;
+        self.kept = true;
+        Ok(())
+    }
+}
+
+impl Drop for ChunkImport {
+    fn drop(&mut self) {
+        if self.kept {
+            return;
+        }
+        let _guard = self.mgr.lock.lock();
+        self.mgr.release_locked(&self.owner);
+        // Added chunks the import failed before recording have no refs.
+        for digest in &self.added {
+            if !self.mgr.refs.is_referenced(digest).unwrap_or(true) {
+                self.mgr.store.remove(digest);
+            }
+        }
+    }
+}
+
+/// Every chunk digest a chunked archive's disks refer to.
+pub(crate) fn referenced_chunks(manifest: &ArchiveManifest) -> HashSet<String> {
+    manifest
+        .chunked_disks
+        .iter()
+        .flat_map(|disk| &disk.extents)
+        .flat_map(|extent| &extent.chunks)
+        .map(|chunk| chunk.digest.clone())
+        .collect()
+}
+
+/// Write `disk` as a standalone QCOW2 into `dest_dir`, reading its chunks
+/// from `store`. `parent` names the archive missing chunks should come from.
+pub(crate) fn rebuild_disk(
+    disk: &ChunkedDisk,
+    store: &ChunkStore,
+    dest_dir: &Path,
+    parent: Option<&str>,
+) -> BoxliteResult<()> {
+    // The name becomes a path: only the known disk files are accepted.
+    if disk.name != disk_filenames::CONTAINER_DISK && disk.name != disk_filenames::GUEST_ROOTFS_DISK
+    {
+        return Err(BoxliteError::Storage(format!(
+            "Invalid archive: unexpected chunked disk '{}'",
+            disk.name
+        )));
+    }
+    if !(9..=21).contains(&disk.cluster_bits) {
+        return Err(BoxliteError::Storage(format!(
+            "Invalid archive: cluster_bits {} for {}",
+            disk.cluster_bits, disk.name
+        )));
+    }
+
+    let cluster_size = 1usize << disk.cluster_bits;
+    let mut writer = Qcow2Writer::create(
+        &dest_dir.join(&disk.name),
+        Qcow2Geometry {
+            virtual_size: disk.virtual_size,
+            cluster_bits: disk.cluster_bits,
+        },
+    )?;
+
+    let mut pending = Vec::with_capacity(MAX_CHUNK + cluster_size);
+    for extent in &disk.extents {
+        if extent.offset % cluster_size as u64 != 0 {
+            return Err(BoxliteError::Storage(format!(
+                "Invalid archive: extent at {} of {} is not cluster-aligned",
+                extent.offset, disk.name
+            )));
+        }
+        let mut vc = extent.offset >> disk.cluster_bits;
+        for chunk in &extent.chunks {
+            let data = store.read(&chunk.digest)?.ok_or_else(|| {
+                BoxliteError::Storage(match parent {
+                    Some(parent) => format!(
+                        "Chunk {} is missing: this archive is incremental to {}, \
+                         import that archive first",
+                        chunk.digest, parent
+                    ),
+                    None => format!("Invalid archive: chunk {} is missing", chunk.digest),
+                })
+            })?;
+            if data.len() as u64 != chunk.len {
+                return Err(BoxliteError::Storage(format!(
+                    "Chunk {} has {} bytes, manifest says {}",
+                    chunk.digest,
+                    data.len(),
+                    chunk.len
+                )));
+            }
+            pending.extend_from_slice(&data);
+            let full = pending.len() / cluster_size * cluster_size;
+            for cluster in pending[..full].chunks_exact(cluster_size) {
+                writer.write_cluster(vc, cluster)?;
+                vc += 1;
+            }
+            pending.drain(..full);
+        }
+        if !pending.is_empty() {
+            return Err(BoxliteError::Storage(format!(
+                "Invalid archive: extent at {} of {} ends mid-cluster",
+                extent.offset, disk.name
+            )));
+        }
+    }
+    writer.finish()?;
+    Ok(())
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::disk::{BackingFormat, Qcow2Helper};
+    use crate::litebox::archive::{CHUNKED_ARCHIVE_VERSION, extract_archive_with_chunks};
+    use tempfile::TempDir;
+
+    /// Deterministic pseudo-random bytes.
+    fn noise(len: usize, seed: u64) -> Vec<u8> {
+        let mut state = seed;
+        (0..len)
+            .map(|_| {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                state as u8
+            })
+            .collect()
+    }
+
+    fn chunk_all(data: &[u8]) -> Vec<Vec<u8>> {
+        let mut chunks = Vec::new();
+        let mut chunker = Chunker::new();
+        for piece in data.chunks(64 * 1024) {
+            chunker
+                .push(piece, &mut |c| {
+                    chunks.push(c.to_vec());
+                    Ok(())
+                })
+                .unwrap();
+        }
+        chunker
+            .finish(&mut |c| {
+                chunks.push(c.to_vec());
+                Ok(())
+            })
+            .unwrap();
+        chunks
+    }
+
+    #[test]
+    fn chunks_respect_bounds_and_reassemble() {
+        let data = noise(16 * 1024 * 1024, 7);
+        let chunks = chunk_all(&data);
+        assert!(chunks.len() > 4);
+        for chunk in &chunks[..chunks.len() - 1] {
+            assert!(chunk.len() >= MIN_CHUNK && chunk.len() <= MAX_CHUNK);
+        }
+        assert_eq!(chunks.concat(), data);
+    }
+
+    #[test]
+    fn boundaries_survive_an_insertion() {
+        let data = noise(16 * 1024 * 1024, 11);
+        let mut shifted = b"inserted bytes".to_vec();
+        shifted.extend_from_slice(&data);
+
+        let before: HashSet<_> = chunk_all(&data).into_iter().collect();
+        let after = chunk_all(&shifted);
+        let shared = after.iter().filter(|c| before.contains(*c)).count();
+        assert!(
+            shared + 2 >= after.len(),
+            "only {shared} of {} chunks survived",
+            after.len()
+        );
+    }
+
+    #[test]
+    fn store_verifies_digests() {
+        let dir = TempDir::new().unwrap();
+        let store = ChunkStore::new(dir.path().join("chunks"));
+        let digest = chunk_digest(b"abc");
+
+        store.put(&digest, b"abc").unwrap();
+        assert_eq!(store.read(&digest).unwrap().unwrap(), b"abc");
+        assert!(store.put(&digest, b"abd").is_err());
+        assert!(store.put("sha256:../../etc", b"abc").is_err());
+        assert!(store.read(&chunk_digest(b"other")).unwrap().is_none());
+    }
+
+    fn test_manager(dir: &Path) -> ChunkManager {
+        let db = crate::db::Database::open(&dir.join("test.db")).unwrap();
+        ChunkManager::new(dir.join("chunks"), ChunkRefStore::new(db))
+    }
+
+    /// Import chunks with the given contents into a box.
+    fn import_chunks(mgr: &ChunkManager, box_id: &str, contents: &[&str]) {
+        let mut chunks = ChunkImport::new(mgr.clone());
+        for data in contents {
+            chunks
+                .put(&chunk_digest(data.as_bytes()), data.as_bytes())
+                .unwrap();
+        }
+        let used: HashSet<String> = contents
+            .iter()
+            .map(|data| chunk_digest(data.as_bytes()))
+            .collect();
+        chunks.record(&used).unwrap();
+        chunks.keep(box_id).unwrap();
+    }
+
+    #[test]
+    fn failed_import_removes_only_its_own_chunks() {
+        let dir = TempDir::new().unwrap();
+        let mgr = test_manager(dir.path());
+        let (old, new) = (chunk_digest(b"old"), chunk_digest(b"new"));
+        import_chunks(&mgr, "box-a", &["old"]);
+
+        let mut chunks = ChunkImport::new(mgr.clone());
+        chunks.put(&old, b"old").unwrap();
+        chunks.put(&new, b"new").unwrap();
+        chunks.record(&HashSet::new()).unwrap();
+        drop(chunks);
+        assert!(
+            mgr.store.read(&old).unwrap().is_some(),
+            "earlier import's chunk"
+        );
+        assert!(mgr.store.read(&new).unwrap().is_none());
+
+        // Failing before the refs are recorded cleans up the same way.
+        let mut chunks = ChunkImport::new(mgr.clone());
+        chunks.put(&new, b"new").unwrap();
+        drop(chunks);
+        assert!(mgr.store.read(&new).unwrap().is_none());
+        assert!(mgr.store.read(&old).unwrap().is_some());
+    }
+
+    #[test]
+    fn removing_a_box_collects_only_its_unshared_chunks() {
+        let dir = TempDir::new().unwrap();
+        let mgr = test_manager(dir.path());
+        import_chunks(&mgr, "box-a", &["one", "shared"]);
+        import_chunks(&mgr, "box-b", &["shared", "two"]);
+
+        mgr.release_box("box-a");
+        assert!(mgr.store.read(&chunk_digest(b"one")).unwrap().is_none());
+        assert!(mgr.store.read(&chunk_digest(b"shared")).unwrap().is_some());
+
+        mgr.release_box("box-b");
+        assert_eq!(stored_chunks(&dir.path().join("chunks")), 0);
+    }
+
+    #[test]
+    fn stale_import_refs_are_released() {
+        let dir = TempDir::new().unwrap();
+        let mgr = test_manager(dir.path());
+        let mut chunks = ChunkImport::new(mgr.clone());
+        chunks.put(&chunk_digest(b"data"), b"data").unwrap();
+        chunks.record(&HashSet::new()).unwrap();
+        // A crashed process never runs the drop.
+        std::mem::forget(chunks);
+
+        mgr.release_stale_imports();
+        assert_eq!(stored_chunks(&dir.path().join("chunks")), 0);
+    }
+
+    #[test]
+    fn writer_rejects_oversized_geometry() {
+        let dir = TempDir::new().unwrap();
+        let dst = dir.path().join("disk.qcow2");
+        for (virtual_size, cluster_bits) in [(u64::MAX, 16), (1 << 60, 21), (64 << 40, 9)] {
+            let geometry = Qcow2Geometry {
+                virtual_size,
+                cluster_bits,
+            };
+            assert!(
+                Qcow2Writer::create(&dst, geometry).is_err(),
+                "{virtual_size} / {cluster_bits}"
+            );
+        }
+    }
+
+    #[test]
+    fn chunk_entry_paths() {
+        let hex = "ab".repeat(32);
+        let path = PathBuf::from(format!("chunks/{hex}"));
+        assert_eq!(chunk_entry_digest(&path), Some(format!("sha256:{hex}")));
+        assert_eq!(chunk_entry_digest(Path::new("manifest.json")), None);
+        assert_eq!(chunk_entry_digest(Path::new("chunks/../disk.qcow2")), None);
+    }
+
+    /// Export `disk` (a qcow2 chain) as a chunked archive at `archive`.
+    fn export(disk: &Path, archive: &Path, parent: Option<&Path>) -> ChunkStats {
+        let (known, parent_id) = match parent {
+            Some(parent) => {
+                let (manifest, id) = crate::litebox::archive::read_manifest(parent).unwrap();
+                (referenced_chunks(&manifest), Some(id))
+            }
+            None => (HashSet::new(), None),
+        };
+        let file = std::fs::File::create(archive).unwrap();
+        let mut writer = ChunkedArchiveWriter::new(file, known, 3).unwrap();
+        let geometry = Qcow2Helper::chain_geometry(disk).unwrap();
+        let mut chunker = DiskChunker::new(disk_filenames::CONTAINER_DISK, geometry);
+        Qcow2Helper::read_chain_clusters(disk, &|_| {}, &mut |vc, data| {
+            chunker.push_cluster(vc, data, &mut writer)
+        })
+        .unwrap();
+        let chunked = chunker.finish(&mut writer).unwrap();
+        let manifest = ArchiveManifest {
+            version: CHUNKED_ARCHIVE_VERSION,
+            box_name: None,
+            image: "test".into(),
+            box_options: None,
+            guest_disk_checksum: String::new(),
+            container_disk_checksum: String::new(),
+            exported_at: String::new(),
+            chunked_disks: vec![chunked],
+            parent: parent_id,
+        };
+        let stats = std::mem::take(&mut writer.stats);
+        writer.finish(&manifest).unwrap();
+        stats
+    }
+
+    /// Import `archive` into `dest` as box `box_id`, returning the rebuilt
+    /// disk's clusters.
+    fn import(
+        archive: &Path,
+        mgr: &ChunkManager,
+        dest: &Path,
+        box_id: &str,
+    ) -> BoxliteResult<Vec<(u64, Vec<u8>)>> {
+        std::fs::create_dir_all(dest).unwrap();
+        let mut chunks = ChunkImport::new(mgr.clone());
+        extract_archive_with_chunks(archive, dest, Some(&mut chunks))?;
+        let json = std::fs::read(dest.join(MANIFEST_FILENAME)).unwrap();
+        let manifest: ArchiveManifest = serde_json::from_slice(&json).unwrap();
+        for disk in &manifest.chunked_disks {
+            rebuild_disk(disk, chunks.store(), dest, manifest.parent.as_deref())?;
+        }
+        chunks.record(&referenced_chunks(&manifest))?;
+        chunks.keep(box_id)?;
+        Ok(clusters(&dest.join(disk_filenames::CONTAINER_DISK)))
+    }
+
+    /// Files under a chunk store.
+    fn stored_chunks(store: &Path) -> usize {
+        walkdir::WalkDir::new(store)
+            .into_iter()
+            .filter_map(Result::ok)
+            .filter(|e| e.file_type().is_file())
+            .count()
+    }
+
+    fn clusters(disk: &Path) -> Vec<(u64, Vec<u8>)> {
+        let mut out = Vec::new();
+        Qcow2Helper::read_chain_clusters(disk, &|_| {}, &mut |vc, data| {
+            out.push((vc, data.to_vec()));
+            Ok(())
+        })
+        .unwrap();
+        out
+    }
+
+    #[test]
+    fn incremental_export_ships_only_new_chunks() {
+        use std::os::unix::fs::FileExt;
+
+        let dir = TempDir::new().unwrap();
+        let cluster_size = 64 * 1024u64;
+        let size = cluster_size * 128;
+
+        // Raw base: two allocated runs with a hole between them.
+        let base = dir.path().join("base.raw");
+        let f = std::fs::File::create(&base).unwrap();
+        f.set_len(size).unwrap();
+        f.write_all_at(&noise(40 * cluster_size as usize, 1), 0)
+            .unwrap();
+        f.write_all_at(&noise(60 * cluster_size as usize, 2), 60 * cluster_size)
+            .unwrap();
+        drop(f);
+        let disk = dir.path().join("disk.qcow2");
+        let _disk =
+            Qcow2Helper::create_cow_child_disk(&base, BackingFormat::Raw, &disk, size).unwrap();
+
+        let full = dir.path().join("full.boxlite");
+        let full_stats = export(&disk, &full, None);
+        assert_eq!(full_stats.chunks_written, full_stats.chunks);
+
+        // Change one cluster in place; the rest of the disk is untouched.
+        let f = std::fs::OpenOptions::new().write(true).open(&base).unwrap();
+        f.write_all_at(&noise(cluster_size as usize, 3), 90 * cluster_size)
+            .unwrap();
+        drop(f);
+
+        let incr = dir.path().join("incr.boxlite");
+        let incr_stats = export(&disk, &incr, Some(&full));
+        assert!(incr_stats.chunks_written >= 1);
+        assert!(
+            incr_stats.bytes_written <= 2 * MAX_CHUNK as u64,
+            "incremental archive stored {} bytes",
+            incr_stats.bytes_written
+        );
+
+        // The incremental archive alone is not enough, and the chunks it
+        // did carry are taken back out of the store...
+        let mgr = test_manager(dir.path());
+        let err = import(&incr, &mgr, &dir.path().join("a"), "box-a").unwrap_err();
+        assert!(
+            err.to_string().contains("import that archive first"),
+            "{err}"
+        );
+        assert_eq!(stored_chunks(&dir.path().join("chunks")), 0);
+
+        // ...but on top of the full import it rebuilds the current disk.
+        import(&full, &mgr, &dir.path().join("b"), "box-b").unwrap();
+        let rebuilt = import(&incr, &mgr, &dir.path().join("c"), "box-c").unwrap();
+        assert_eq!(rebuilt, clusters(&disk));
+
+        // box-c still holds the chunks it shares with the full archive; the
+        // store empties only once neither box is left.
+        mgr.release_box("box-b");
+        assert_ne!(stored_chunks(&dir.path().join("chunks")), 0);
+        mgr.release_box("box-c");
+        assert_eq!(stored_chunks(&dir.path().join("chunks")), 0);
+    }
+}
@@ -1,14 +1,17 @@
 //! Clone and export operations for BoxImpl.
 
+use std::cell::Cell;
+use std::collections::HashSet;
 use std::sync::Arc;
-use std::time::Instant;
+use std::time::{Duration, Instant};
 
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 
 use super::box_impl::BoxImpl;
 use crate::disk::BaseDiskKind;
 use crate::disk::constants::filenames as disk_filenames;
-use crate::disk::{BackingFormat, Qcow2Helper};
+use crate::disk::{BackingFormat, FlattenProgress, Qcow2Helper};
+use crate::runtime::options::{ExportProgress, ExportProgressFn};
 use crate::runtime::types::BoxStatus;
 
 // ============================================================================
@@ -172,9 +175,13 @@ impl BoxImpl {
 
     pub(crate) async fn export_box(
         &self,
-        _options: crate::runtime::options::ExportOptions,
+        options: crate::runtime::options::ExportOptions,
         dest: &std::path::Path,
     ) -> BoxliteResult<crate::runtime::options::BoxArchive> {
+        if options.chunked || options.parent.is_some() {
+            return self.export_box_chunked(options, dest).await;
+        }
+
         let t0 = Instant::now();
         let _lock = self.disk_ops.lock().await;
 
@@ -187,7 +194,8 @@ impl BoxImpl {
             .with_quiesce_async(async {
                 let bh = box_home.clone();
                 let rl = runtime_layout.clone();
-                tokio::task::spawn_blocking(move || do_export_flatten(&bh, &rl))
+                let progress = options.progress.clone();
+                tokio::task::spawn_blocking(move || do_export_flatten(&bh, &rl, progress))
                     .await
                     .map_err(|e| {
                         BoxliteError::Internal(format!("Export flatten task panicked: {}", e))
@@ -223,6 +231,175 @@ impl BoxImpl {
 
         result
     }
+
+    /// Export as a chunked (v4) archive, streaming the disks straight from
+    /// their backing chains into `dest` with no flattened scratch copies.
+    /// With a parent archive, chunks the parent already holds are left out.
+    ///
+    /// The box stays quiesced for the whole write, since the chunks are read
+    /// from the live chains.
+    async fn export_box_chunked(
+        &self,
+        options: crate::runtime::options::ExportOptions,
+        dest: &std::path::Path,
+    ) -> BoxliteResult<crate::runtime::options::BoxArchive> {
+        let t0 = Instant::now();
+        let _lock = self.disk_ops.lock().await;
+
+        let parent = options.parent.clone();
+        let (known, parent_id) = tokio::task::spawn_blocking(move || read_parent_chunks(parent))
+            .await
+            .map_err(|e| BoxliteError::Internal(format!("Export parent task panicked: {}", e)))??;
+
+        let output_path = archive_output_path(dest, self.config.name.as_deref());
+        let job = ChunkedExportJob {
+            box_home: self.config.box_home.clone(),
+            output_path: output_path.clone(),
+            known,
+            parent_id,
+            box_name: self.config.name.clone(),
+            box_options: self.config.options.clone(),
+            progress: options.progress.clone(),
+        };
+        let result = self
+            .with_quiesce_async(async {
+                tokio::task::spawn_blocking(move || do_export_chunked(job))
+                    .await
+                    .map_err(|e| {
+                        BoxliteError::Internal(format!("Chunked export task panicked: {}", e))
+                    })?
+            })
+            .await;
+        if result.is_err() {
+            let _ = std::fs::remove_file(&output_path);
+        }
+
+        tracing::info!(
+            box_id = %self.config.id,
+            elapsed_ms = t0.elapsed().as_millis() as u64,
+            ok = result.is_ok(),
+            "export_box completed"
+        );
+
+        let stats = result?;
+        tracing::info!(
+            box_id = %self.config.id,
+            output = %output_path.display(),
+            incremental = options.parent.is_some(),
+            chunks = stats.chunks,
+            chunks_written = stats.chunks_written,
+            bytes_written = stats.bytes_written,
+            "Exported box to chunked archive"
+        );
+        Ok(crate::runtime::options::BoxArchive::new(output_path))
+    }
+}
+
+/// `<dest>/<name>.boxlite` when `dest` is a directory, else `dest` itself.
+fn archive_output_path(dest: &std::path::Path, box_name: Option<&str>) -> std::path::PathBuf {
+    if dest.is_dir() {
+        dest.join(format!("{}.boxlite", box_name.unwrap_or("box")))
+    } else {
+        dest.to_path_buf()
+    }
+}
+
+/// Chunks (and id) of the parent of an incremental export.
+fn read_parent_chunks(
+    parent: Option<crate::runtime::options::BoxArchive>,
+) -> BoxliteResult<(HashSet<String>, Option<String>)> {
+    let Some(parent) = parent else {
+        return Ok((HashSet::new(), None));
+    };
+    let (manifest, id) = super::archive::read_manifest(parent.path())?;
+    if manifest.chunked_disks.is_empty() {
+        return Err(BoxliteError::InvalidArgument(format!(
+            "Parent archive {} is not a chunked archive",
+            parent.path().display()
+        )));
+    }
+    Ok((super::chunks::referenced_chunks(&manifest), Some(id)))
+}
+
+/// Everything the blocking half of a chunked export needs.
+struct ChunkedExportJob {
+    box_home: std::path::PathBuf,
+    output_path: std::path::PathBuf,
+    known: HashSet<String>,
+    parent_id: Option<String>,
+    box_name: Option<String>,
+    box_options: crate::runtime::options::BoxOptions,
+    progress: Option<ExportProgressFn>,
+}
+
+fn do_export_chunked(job: ChunkedExportJob) -> BoxliteResult<super::chunks::ChunkStats> {
+    use super::archive::{ArchiveManifest, CHUNKED_ARCHIVE_VERSION};
+    use super::chunks::{ChunkedArchiveWriter, DiskChunker};
+
+    let disks_dir = job.box_home.join("disks");
+    let container_disk = disks_dir.join(disk_filenames::CONTAINER_DISK);
+    if !container_disk.exists() {
+        return Err(BoxliteError::Storage(format!(
+            "Container disk not found at {}",
+            container_disk.display()
+        )));
+    }
+    let mut disks = vec![(container_disk, disk_filenames::CONTAINER_DISK)];
+    let guest_disk = disks_dir.join(disk_filenames::GUEST_ROOTFS_DISK);
+    if guest_disk.exists() {
+        disks.push((guest_disk, disk_filenames::GUEST_ROOTFS_DISK));
+    }
+
+    let geometries = disks
+        .iter()
+        .map(|(path, _)| Qcow2Helper::chain_geometry(path))
+        .collect::<BoxliteResult<Vec<_>>>()?;
+    let total = geometries.iter().map(|g| g.virtual_size).sum();
+    let tracker = ExportTracker::new(job.progress, total);
+
+    let file = std::fs::File::create(&job.output_path).map_err(|e| {
+        BoxliteError::Storage(format!(
+            "Failed to create archive file {}: {}",
+            job.output_path.display(),
+            e
+        ))
+    })?;
+    let mut writer = ChunkedArchiveWriter::new(std::io::BufWriter::new(file), job.known, 3)?;
+
+    let mut chunked_disks = Vec::with_capacity(disks.len());
+    for ((path, name), geometry) in disks.iter().zip(geometries) {
+        let mut disk = DiskChunker::new(name, geometry);
+        Qcow2Helper::read_chain_clusters(path, &|p| tracker.on_disk(p), &mut |vc, data| {
+            disk.push_cluster(vc, data, &mut writer)
+        })?;
+        chunked_disks.push(disk.finish(&mut writer)?);
+        tracker.finish_disk();
+    }
+
+    let image = match &job.box_options.rootfs {
+        crate::runtime::options::RootfsSpec::Image(img) => img.clone(),
+        crate::runtime::options::RootfsSpec::RootfsPath(path) => path.clone(),
+    };
+    let manifest = ArchiveManifest {
+        version: CHUNKED_ARCHIVE_VERSION,
+        box_name: job.box_name,
+        image,
+        box_options: Some(job.box_options),
+        guest_disk_checksum: String::new(),
+        container_disk_checksum: String::new(),
+        exported_at: chrono::Utc::now().to_rfc3339(),
+        chunked_disks,
+        parent: job.parent_id,
+    };
+
+    let stats = std::mem::take(&mut writer.stats);
+    let file = writer
+        .finish(&manifest)?
+        .into_inner()
+        .map_err(|e| BoxliteError::Storage(format!("Failed to flush archive: {}", e)))?;
+    file.sync_all()
+        .map_err(|e| BoxliteError::Storage(format!("Failed to sync archive: {}", e)))?;
+    Ok(stats)
 }
 
 /// Intermediate result from flatten phase, passed to finalize phase.
@@ -238,6 +415,7 @@ struct FlattenResult {
 fn do_export_flatten(
     box_home: &std::path::Path,
     runtime_layout: &crate::runtime::layout::FilesystemLayout,
+    progress: Option<ExportProgressFn>,
 ) -> BoxliteResult<FlattenResult> {
     use crate::disk::Qcow2Helper;
     use crate::disk::constants::filenames as disk_filenames;
@@ -256,16 +434,26 @@ fn do_export_flatten(
     let temp_dir = tempfile::tempdir_in(runtime_layout.temp_dir())
         .map_err(|e| BoxliteError::Storage(format!("Failed to create temp directory: {}", e)))?;
 
+    let guest_disk = guest_disk.exists().then_some(guest_disk);
+    let mut total = Qcow2Helper::qcow2_virtual_size(&container_disk)?;
+    if let Some(guest_disk) = &guest_disk {
+        total += Qcow2Helper::qcow2_virtual_size(guest_disk)?;
+    }
+    let tracker = ExportTracker::new(progress, total);
+
     let t_flatten = Instant::now();
     let flat_container = temp_dir.path().join(disk_filenames::CONTAINER_DISK);
-    Qcow2Helper::flatten(&container_disk, &flat_container)?;
-
-    let flat_guest = if guest_disk.exists() {
-        let flat = temp_dir.path().join(disk_filenames::GUEST_ROOTFS_DISK);
-        Qcow2Helper::flatten(&guest_disk, &flat)?;
-        Some(flat)
-    } else {
-        None
+    Qcow2Helper::flatten_with_progress(&container_disk, &flat_container, &|p| tracker.on_disk(p))?;
+    tracker.finish_disk();
+
+    let flat_guest = match &guest_disk {
+        Some(guest_disk) => {
+            let flat = temp_dir.path().join(disk_filenames::GUEST_ROOTFS_DISK);
+            Qcow2Helper::flatten_with_progress(guest_disk, &flat, &|p| tracker.on_disk(p))?;
+            tracker.finish_disk();
+            Some(flat)
+        }
+        None => None,
     };
     let flatten_ms = t_flatten.elapsed().as_millis() as u64;
 
@@ -277,6 +465,64 @@ fn do_export_flatten(
     })
 }
 
+/// Folds per-disk [`FlattenProgress`] into throttled [`ExportProgress`]
+/// snapshots covering all exported disks.
+struct ExportTracker {
+    callback: Option<ExportProgressFn>,
+    started: Instant,
+    total: u64,
+    /// Sums over the disks already flattened.
+    finished: Cell<FlattenProgress>,
+    current: Cell<FlattenProgress>,
+    last_report: Cell<Option<Instant>>,
+}
+
+impl ExportTracker {
+    /// Minimum time between two callbacks; disk completions always report.
+    const INTERVAL: Duration = Duration::from_millis(200);
+
+    fn new(callback: Option<ExportProgressFn>, total: u64) -> Self {
+        Self {
+            callback,
+            started: Instant::now(),
+            total,
+            finished: Cell::default(),
+            current: Cell::default(),
+            last_report: Cell::new(None),
+        }
+    }
+
+    fn on_disk(&self, progress: &FlattenProgress) {
+        self.current.set(*progress);
+        let Some(callback) = &self.callback else {
+            return;
+        };
+        let now = Instant::now();
+        let due = self
+            .last_report
+            .get()
+            .is_none_or(|last| now.duration_since(last) >= Self::INTERVAL);
+        if !due && progress.bytes_done < progress.bytes_total {
+            return;
+        }
+        self.last_report.set(Some(now));
+        let finished = self.finished.get();
+        callback(&ExportProgress {
+            bytes_total: self.total,
+            bytes_done: finished.bytes_done + progress.bytes_done,
+            bytes_written: finished.bytes_written + progress.bytes_written,
+            elapsed: self.started.elapsed(),
+        });
+    }
+
+    fn finish_disk(&self) {
+        let (mut finished, current) = (self.finished.get(), self.current.take());
+        finished.bytes_done += current.bytes_total;
+        finished.bytes_written += current.bytes_written;
+        self.finished.set(finished);
+    }
+}
+
 /// Phase 2: Checksum, manifest, and archive.
 /// Runs after the VM resumes — only reads static temp files.
 fn do_export_finalize(
@@ -290,12 +536,7 @@ fn do_export_finalize(
         ARCHIVE_VERSION, ArchiveManifest, MANIFEST_FILENAME, build_zstd_tar_archive, sha256_file,
     };
 
-    let output_path = if dest.is_dir() {
-        let name = config_name.unwrap_or("box");
-        dest.join(format!("{}.boxlite", name))
-    } else {
-        dest.to_path_buf()
-    };
+    let output_path = archive_output_path(dest, config_name);
 
     let t_checksum = Instant::now();
     let container_disk_checksum = sha256_file(&flatten.flat_container)?;
@@ -318,6 +559,8 @@ fn do_export_finalize(
         guest_disk_checksum,
         container_disk_checksum,
         exported_at: chrono::Utc::now().to_rfc3339(),
+        chunked_disks: Vec::new(),
+        parent: None,
     };
 
     let manifest_json = serde_json::to_string_pretty(&manifest)
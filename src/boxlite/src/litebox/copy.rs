@@ -1,5 +1,18 @@
+use boxlite_shared::errors::BoxliteResult;
+use tokio::io::AsyncRead;
+use tokio::sync::mpsc;
+
 use crate::BoxliteError;
 
+/// Size of the tar chunks streamed between host and guest.
+pub(crate) const COPY_CHUNK_SIZE: usize = 1 << 20; // 1 MiB
+/// Chunks buffered between the tar producer and the transfer, bounding a
+/// streamed copy's memory to `COPY_BUFFER_CHUNKS * COPY_CHUNK_SIZE`.
+pub(crate) const COPY_BUFFER_CHUNKS: usize = 4;
+
+/// Tar stream source for `LiteBox::copy_into_stream`.
+pub type CopyReader = Box<dyn AsyncRead + Send + Unpin>;
+
 /// Options controlling copy behavior.
 #[derive(Debug, Clone)]
 pub struct CopyOptions {
@@ -11,6 +24,17 @@ pub struct CopyOptions {
     pub follow_symlinks: bool,
     /// When copying out, include the parent directory in the archive (docker cp semantics).
     pub include_parent: bool,
+    /// When copying a directory in, compare it with what is already at the
+    /// destination and send only new or changed entries. Entries that exist
+    /// only at the destination are kept, as with a full copy.
+    pub delta: bool,
+    /// With `delta`, compare regular files by content hash instead of by
+    /// size and mtime. Both sides read every file, but touched-but-identical
+    /// files are not resent.
+    pub checksum: bool,
+    /// With `delta`, update large files that changed in place by sending only
+    /// the blocks that differ.
+    pub block_delta: bool,
 }
 
 impl Default for CopyOptions {
@@ -20,6 +44,9 @@ impl Default for CopyOptions {
             overwrite: true,
             follow_symlinks: false,
             include_parent: true,
+            delta: false,
+            checksum: false,
+            block_delta: false,
         }
     }
 }
@@ -45,6 +72,23 @@ impl CopyOptions {
         self
     }
 
+    /// Send only what changed since the destination was last synced; see
+    /// [`CopyOptions::delta`].
+    pub fn delta(mut self, delta: bool) -> Self {
+        self.delta = delta;
+        self
+    }
+
+    pub fn checksum(mut self, checksum: bool) -> Self {
+        self.checksum = checksum;
+        self
+    }
+
+    pub fn block_delta(mut self, block_delta: bool) -> Self {
+        self.block_delta = block_delta;
+        self
+    }
+
     pub fn validate_for_dir(&self) -> Result<(), BoxliteError> {
         if !self.recursive {
             return Err(BoxliteError::Config(
@@ -54,3 +98,109 @@ impl CopyOptions {
         Ok(())
     }
 }
+
+/// Blocking `Write` half of a bounded chunk channel.
+///
+/// Lets a synchronous tar builder running on `spawn_blocking` feed an async
+/// upload: bytes are batched into `COPY_CHUNK_SIZE` chunks and each send
+/// blocks while `COPY_BUFFER_CHUNKS` chunks are already queued. Writes fail
+/// with `BrokenPipe` once the receiver is gone.
+pub(crate) struct ChunkSender {
+    tx: mpsc::Sender<BoxliteResult<Vec<u8>>>,
+    buf: Vec<u8>,
+}
+
+impl ChunkSender {
+    pub(crate) fn channel() -> (Self, mpsc::Receiver<BoxliteResult<Vec<u8>>>) {
+        let (tx, rx) = mpsc::channel(COPY_BUFFER_CHUNKS);
+        (
+            Self {
+                tx,
+                buf: Vec::with_capacity(COPY_CHUNK_SIZE),
+            },
+            rx,
+        )
+    }
+
+    /// Send the buffered tail, or `err` in its place so the receiver
+    /// stops with the producer's error instead of a truncated stream.
+    pub(crate) fn finish(mut self, result: BoxliteResult<()>) {
+        match result {
+            Ok(()) => {
+                let _ = self.send_buffered();
+            }
+            Err(e) => {
+                let _ = self.tx.blocking_send(Err(e));
+            }
+        }
+    }
+
+    fn send_buffered(&mut self) -> std::io::Result<()> {
+        if self.buf.is_empty() {
+            return Ok(());
+        }
+        let chunk = std::mem::replace(&mut self.buf, Vec::with_capacity(COPY_CHUNK_SIZE));
+        self.tx
+            .blocking_send(Ok(chunk))
+            .map_err(|_| std::io::ErrorKind::BrokenPipe.into())
+    }
+}
+
+impl std::io::Write for ChunkSender {
+    fn write(&mut self, data: &[u8]) -> std::io::Result<usize> {
+        let n = data.len().min(COPY_CHUNK_SIZE - self.buf.len());
+        self.buf.extend_from_slice(&data[..n]);
+        if self.buf.len() == COPY_CHUNK_SIZE {
+            self.send_buffered()?;
+        }
+        Ok(n)
+    }
+
+    fn flush(&mut self) -> std::io::Result<()> {
+        Ok(())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::io::Write;
+
+    #[tokio::test]
+    async fn chunk_sender_batches_and_forwards_errors() {
+        let (mut sender, mut rx) = ChunkSender::channel();
+        let writer = tokio::task::spawn_blocking(move || {
+            sender
+                .write_all(&vec![7u8; COPY_CHUNK_SIZE * 2 + 10])
+                .unwrap();
+            sender.finish(Ok(()));
+        });
+        let mut sizes = Vec::new();
+        while let Some(chunk) = rx.recv().await {
+            sizes.push(chunk.unwrap().len());
+        }
+        writer.await.unwrap();
+        assert_eq!(sizes, vec![COPY_CHUNK_SIZE, COPY_CHUNK_SIZE, 10]);
+
+        let (sender, mut rx) = ChunkSender::channel();
+        tokio::task::spawn_blocking(move || {
+            sender.finish(Err(BoxliteError::Storage("pack failed".into())))
+        })
+        .await
+        .unwrap();
+        assert!(rx.recv().await.unwrap().is_err());
+        assert!(rx.recv().await.is_none());
+    }
+
+    #[tokio::test]
+    async fn chunk_sender_reports_broken_pipe_when_receiver_is_gone() {
+        let (mut sender, rx) = ChunkSender::channel();
+        drop(rx);
+        let err = tokio::task::spawn_blocking(move || {
+            sender.write_all(&vec![0u8; COPY_CHUNK_SIZE]).unwrap_err()
+        })
+        .await
+        .unwrap();
+        assert_eq!(err.kind(), std::io::ErrorKind::BrokenPipe);
+    }
+}
@@ -0,0 +1,313 @@
+//! Delta `copy_into` for directories.
+//!
+//! Rather than re-archiving the whole source tree, the host compares a
+//! manifest of the source with one the guest builds of the destination and
+//! sends only the difference (see `boxlite_shared::sync`). Repeated syncs of
+//! a mostly unchanged tree cost a directory walk on each side plus the
+//! changed bytes.
+
+use std::collections::{HashMap, HashSet};
+use std::os::unix::fs::FileExt;
+use std::path::{Path, PathBuf};
+use std::time::Instant;
+
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+use boxlite_shared::sync::{self, DELTA_BLOCK_SIZE, ScanOptions, SyncPlan};
+use boxlite_shared::{ManifestEntry, ManifestEntryKind, PatchChunk};
+use tokio::sync::mpsc;
+use tokio_stream::wrappers::ReceiverStream;
+
+use super::copy::{COPY_BUFFER_CHUNKS, COPY_CHUNK_SIZE, ChunkSender, CopyOptions};
+use crate::portal::interfaces::FilesInterface;
+
+/// A changed file to update in place.
+struct FilePatch {
+    path: String,
+    /// `(offset, len)` ranges that differ from the guest copy.
+    ranges: Vec<(u64, u64)>,
+    size: u64,
+    mtime: i64,
+    mode: u32,
+}
+
+/// Sync the host directory `src` into the guest so that it ends up where a
+/// full `copy_into(src, container_dst)` would have put it.
+pub(crate) async fn sync_dir(
+    files: &mut FilesInterface,
+    src: &Path,
+    container_dst: &str,
+    container_id: &str,
+    opts: &CopyOptions,
+) -> BoxliteResult<()> {
+    let t0 = Instant::now();
+    let root = sync_root(src, container_dst, opts.include_parent);
+    let scan_opts = ScanOptions {
+        checksum: opts.checksum,
+        block_size: 0,
+        follow_symlinks: opts.follow_symlinks,
+    };
+
+    let src_root = src.to_path_buf();
+    let source = blocking(move || sync::scan(&src_root, &scan_opts)).await?;
+    let dest = files
+        .manifest(&root, Some(container_id), Vec::new(), opts.checksum, 0)
+        .await?;
+    let mut plan = sync::plan(&source, &dest, opts.block_delta);
+    if !opts.overwrite {
+        // Only add what is missing; never touch existing entries.
+        let existing: HashSet<&str> = dest.iter().map(|e| e.path.as_str()).collect();
+        plan = SyncPlan {
+            send: plan
+                .send
+                .into_iter()
+                .filter(|p| !existing.contains(p.as_str()))
+                .collect(),
+            ..Default::default()
+        };
+    }
+
+    let patches = if plan.patch.is_empty() {
+        Vec::new()
+    } else {
+        plan_patches(files, src, &root, container_id, &source, &mut plan).await?
+    };
+
+    if !plan.send.is_empty() || !plan.remove.is_empty() {
+        upload_entries(files, src, &root, container_id, &plan, opts.follow_symlinks).await?;
+    }
+    let patch_bytes: u64 = patches.iter().flat_map(|p| &p.ranges).map(|r| r.1).sum();
+    if !patches.is_empty() {
+        send_patches(files, src, &root, container_id, patches).await?;
+    }
+
+    tracing::debug!(
+        root = %root,
+        entries = source.len(),
+        sent = plan.send.len(),
+        patched = plan.patch.len(),
+        patch_bytes,
+        removed = plan.remove.len(),
+        elapsed_ms = t0.elapsed().as_millis() as u64,
+        "delta sync finished"
+    );
+    Ok(())
+}
+
+/// Guest directory that holds the contents of `src` after a full copy to
+/// `container_dst`: the destination itself, or a child named after `src`
+/// when the parent directory is included.
+fn sync_root(src: &Path, container_dst: &str, include_parent: bool) -> String {
+    let dst = container_dst.trim_end_matches('/');
+    if !include_parent {
+        return if dst.is_empty() {
+            "/".into()
+        } else {
+            dst.into()
+        };
+    }
+    // Same fallback name as `boxlite_shared::tar::pack_to_writer`.
+    let base = src
+        .file_name()
+        .map(|s| s.to_string_lossy().into_owned())
+        .unwrap_or_else(|| "root".into());
+    format!("{}/{}", dst, base)
+}
+
+/// Compute the changed blocks of each file in `plan.patch`. Files whose
+/// guest copy has gone, or that changed too much for patching to pay off,
+/// move to `plan.send` instead.
+async fn plan_patches(
+    files: &mut FilesInterface,
+    src: &Path,
+    root: &str,
+    container_id: &str,
+    source: &[ManifestEntry],
+    plan: &mut SyncPlan,
+) -> BoxliteResult<Vec<FilePatch>> {
+    let guest = files
+        .manifest(
+            root,
+            Some(container_id),
+            plan.patch.clone(),
+            false,
+            DELTA_BLOCK_SIZE,
+        )
+        .await?;
+    let mut guest_sums: HashMap<String, Vec<Vec<u8>>> = guest
+        .into_iter()
+        .filter(|e| e.kind() == ManifestEntryKind::File)
+        .map(|e| (e.path, e.block_sums))
+        .collect();
+    let host: HashMap<&str, &ManifestEntry> = source.iter().map(|e| (e.path.as_str(), e)).collect();
+
+    let mut candidates = Vec::new();
+    for path in std::mem::take(&mut plan.patch) {
+        match (guest_sums.remove(&path), host.get(path.as_str())) {
+            (Some(sums), Some(entry)) => candidates.push(((*entry).clone(), sums)),
+            _ => plan.send.push(path),
+        }
+    }
+
+    let src_root = src.to_path_buf();
+    let (patches, resend) = blocking(move || {
+        let mut patches = Vec::new();
+        let mut resend = Vec::new();
+        for (entry, sums) in candidates {
+            let ranges =
+                sync::changed_ranges(&src_root.join(&entry.path), &sums, DELTA_BLOCK_SIZE)?;
+            let changed: u64 = ranges.iter().map(|r| r.1).sum();
+            if changed * 2 > entry.size {
+                resend.push(entry.path);
+                continue;
+            }
+            patches.push(FilePatch {
+                path: entry.path,
+                ranges,
+                size: entry.size,
+                mtime: entry.mtime,
+                mode: entry.mode,
+            });
+        }
+        Ok((patches, resend))
+    })
+    .await?;
+
+    plan.patch = patches.iter().map(|p| p.path.clone()).collect();
+    plan.send.extend(resend);
+    plan.send.sort();
+    Ok(patches)
+}
+
+/// Send `plan.send` as one tar extracted under `root`, after the guest has
+/// deleted `plan.remove`.
+async fn upload_entries(
+    files: &mut FilesInterface,
+    src: &Path,
+    root: &str,
+    container_id: &str,
+    plan: &SyncPlan,
+    follow_symlinks: bool,
+) -> BoxliteResult<()> {
+    let (mut sender, chunks) = ChunkSender::channel();
+    let src_root = src.to_path_buf();
+    let send = plan.send.clone();
+    let packer = tokio::task::spawn_blocking(move || {
+        let packed = sync::pack_entries_to_writer(&src_root, &send, &mut sender, follow_symlinks);
+        sender.finish(packed.map(drop));
+    });
+
+    // The trailing '/' makes the guest extract into `root` as a directory.
+    let dest = if root.ends_with('/') {
+        root.to_string()
+    } else {
+        format!("{}/", root)
+    };
+    let uploaded = files
+        .upload_stream_removing(
+            ReceiverStream::new(chunks),
+            &dest,
+            Some(container_id),
+            true,
+            true,
+            plan.remove.clone(),
+        )
+        .await;
+    packer
+        .await
+        .map_err(|e| BoxliteError::Internal(format!("pack task join error: {}", e)))?;
+    uploaded
+}
+
+/// Stream the changed ranges of each file, then its final size and
+/// metadata, as one `Patch` call.
+async fn send_patches(
+    files: &mut FilesInterface,
+    src: &Path,
+    root: &str,
+    container_id: &str,
+    patches: Vec<FilePatch>,
+) -> BoxliteResult<()> {
+    let (tx, rx) = mpsc::channel(COPY_BUFFER_CHUNKS);
+    let src_root = src.to_path_buf();
+    let reader = tokio::task::spawn_blocking(move || {
+        for patch in patches {
+            if let Err(e) = read_patch(&src_root, &patch, &tx) {
+                let _ = tx.blocking_send(Err(e));
+                return;
+            }
+        }
+    });
+
+    let sent = files
+        .patch(ReceiverStream::new(rx), root, Some(container_id))
+        .await;
+    reader
+        .await
+        .map_err(|e| BoxliteError::Internal(format!("patch task join error: {}", e)))?;
+    sent
+}
+
+fn read_patch(
+    src_root: &Path,
+    patch: &FilePatch,
+    tx: &mpsc::Sender<BoxliteResult<PatchChunk>>,
+) -> BoxliteResult<()> {
+    let path: PathBuf = src_root.join(&patch.path);
+    let file = std::fs::File::open(&path)
+        .map_err(|e| BoxliteError::Storage(format!("failed to open {}: {}", path.display(), e)))?;
+    let send = |chunk: PatchChunk| {
+        tx.blocking_send(Ok(chunk))
+            .map_err(|_| BoxliteError::Internal("patch stream closed".into()))
+    };
+
+    for &(start, len) in &patch.ranges {
+        let mut offset = start;
+        while offset < start + len {
+            let n = (start + len - offset).min(COPY_CHUNK_SIZE as u64) as usize;
+            let mut data = vec![0u8; n];
+            file.read_exact_at(&mut data, offset).map_err(|e| {
+                BoxliteError::Storage(format!("failed to read {}: {}", path.display(), e))
+            })?;
+            send(PatchChunk {
+                path: patch.path.clone(),
+                offset,
+                data,
+                ..Default::default()
+            })?;
+            offset += n as u64;
+        }
+    }
+    send(PatchChunk {
+        path: patch.path.clone(),
+        commit: true,
+        size: patch.size,
+        mtime: patch.mtime,
+        mode: patch.mode,
+        ..Default::default()
+    })
+}
+
+async fn blocking<T, F>(f: F) -> BoxliteResult<T>
+where
+    T: Send + 'static,
+    F: FnOnce() -> BoxliteResult<T> + Send + 'static,
+{
+    tokio::task::spawn_blocking(f)
+        .await
+        .map_err(|e| BoxliteError::Internal(format!("delta sync task join error: {}", e)))?
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn sync_root_matches_full_copy_layout() {
+        let src = Path::new("/work/proj");
+        assert_eq!(sync_root(src, "/app", true), "/app/proj");
+        assert_eq!(sync_root(src, "/app/", true), "/app/proj");
+        assert_eq!(sync_root(src, "/app/", false), "/app");
+        assert_eq!(sync_root(src, "/", false), "/");
+        assert_eq!(sync_root(src, "/", true), "/proj");
+    }
+}
@@ -3,13 +3,17 @@
 //! Type definitions for executing commands in a box.
 //! The actual execution logic is in BoxImpl::exec().
 
+use crate::portal::interfaces::exec::Utf8StreamDecoder;
 use crate::runtime::backend::ExecBackend;
 use boxlite_shared::errors::BoxliteResult;
+use bytes::Bytes;
 use futures::Stream;
+use std::io::IoSlice;
 use std::pin::Pin;
+use std::sync::Arc;
 use std::task::{Context, Poll};
 use std::time::Duration;
-use tokio::sync::mpsc;
+use tokio::sync::{Semaphore, mpsc};
 
 /// Command builder for executing programs in a box.
 ///
@@ -35,6 +39,7 @@ pub struct BoxCommand {
     pub(crate) working_dir: Option<String>,
     pub(crate) tty: bool,
     pub(crate) user: Option<String>,
+    pub(crate) output_window: Option<usize>,
 }
 
 impl BoxCommand {
@@ -48,6 +53,7 @@ impl BoxCommand {
             working_dir: None,
             tty: false,
             user: None,
+            output_window: None,
         }
     }
 
@@ -104,6 +110,18 @@ impl BoxCommand {
         self.user = if s.trim().is_empty() { None } else { Some(s) };
         self
     }
+
+    /// Limit unread output buffered on the host to `bytes` per stream.
+    ///
+    /// Once a stream holds that much, the host stops reading the
+    /// execution's output from the guest until the reader catches up, and
+    /// the process blocks on its full pipe as it would locally. Stdout and
+    /// stderr share one transport stream, so a stalled stream holds back
+    /// the other. Default: unbounded. REST-backed boxes ignore it.
+    pub fn output_window(mut self, bytes: usize) -> Self {
+        self.output_window = (bytes > 0).then_some(bytes);
+        self
+    }
 }
 
 /// Handle to a running command execution.
@@ -287,8 +305,8 @@ impl Execution {
         id: &str,
     ) -> (
         Self,
-        mpsc::UnboundedSender<String>,
-        mpsc::UnboundedSender<String>,
+        mpsc::UnboundedSender<Bytes>,
+        mpsc::UnboundedSender<Bytes>,
         mpsc::UnboundedReceiver<Vec<u8>>,
         mpsc::UnboundedSender<ExecResult>,
     ) {
@@ -312,8 +330,8 @@ impl Execution {
             }
         }
 
-        let (stdout_tx, stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, stderr_rx) = mpsc::unbounded_channel::<String>();
+        let (stdout_tx, stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, stderr_rx) = mpsc::unbounded_channel::<Bytes>();
         let (stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
         let (result_tx, result_rx) = mpsc::unbounded_channel::<ExecResult>();
 
@@ -365,8 +383,12 @@ impl ExecStdin {
 
     /// Write data to stdin.
     pub async fn write(&mut self, data: &[u8]) -> BoxliteResult<()> {
+        self.send(data.to_vec())
+    }
+
+    fn send(&self, data: Vec<u8>) -> BoxliteResult<()> {
         match &self.sender {
-            Some(sender) => sender.send(data.to_vec()).map_err(|_| {
+            Some(sender) => sender.send(data).map_err(|_| {
                 boxlite_shared::BoxliteError::Internal("stdin channel closed".to_string())
             }),
             None => Err(boxlite_shared::BoxliteError::Internal(
@@ -375,6 +397,16 @@ impl ExecStdin {
         }
     }
 
+    /// Write several buffers as one chunk: they are gathered into a single
+    /// allocation and reach the guest together, in order.
+    pub async fn write_vectored(&mut self, bufs: &[IoSlice<'_>]) -> BoxliteResult<()> {
+        let mut data = Vec::with_capacity(bufs.iter().map(|buf| buf.len()).sum());
+        for buf in bufs {
+            data.extend_from_slice(buf);
+        }
+        self.send(data)
+    }
+
     /// Write all data to stdin.
     pub async fn write_all(&mut self, data: &[u8]) -> BoxliteResult<()> {
         self.write(data).await
@@ -391,14 +423,146 @@ impl ExecStdin {
     }
 }
 
+/// Byte credit for one output stream, sized by [`BoxCommand::output_window`].
+///
+/// The transport reserves each chunk's length before queueing it and the
+/// stream gives it back as the chunk is read, so no more than the window
+/// sits unread on the host. A chunk larger than the window takes all of it.
+#[derive(Clone)]
+pub(crate) struct OutputWindow {
+    credit: Arc<Semaphore>,
+    bytes: usize,
+}
+
+impl OutputWindow {
+    pub(crate) fn new(bytes: usize) -> Self {
+        let bytes = bytes.clamp(1, u32::MAX as usize);
+        Self {
+            credit: Arc::new(Semaphore::new(bytes)),
+            bytes,
+        }
+    }
+
+    fn cost(&self, len: usize) -> u32 {
+        len.min(self.bytes) as u32
+    }
+
+    /// Wait until `len` more bytes fit. Returns at once when the stream has
+    /// been dropped, so the transport can discard the rest without stalling.
+    pub(crate) async fn reserve(&self, len: usize) {
+        if let Ok(permit) = self.credit.acquire_many(self.cost(len)).await {
+            permit.forget();
+        }
+    }
+
+    fn release(&self, len: usize) {
+        self.credit.add_permits(self.cost(len) as usize);
+    }
+}
+
+/// Reader end of an [`OutputWindow`]; closes the window when dropped.
+struct WindowReader(OutputWindow);
+
+impl Drop for WindowReader {
+    fn drop(&mut self) {
+        self.0.credit.close();
+    }
+}
+
+/// Receiving half shared by [`ExecStdout`] and [`ExecStderr`].
+///
+/// Backends forward output as raw, refcounted chunks. UTF-8 decoding runs
+/// only when the stream is read as text, and holds a codepoint split across
+/// two chunks until its continuation arrives (the transport cuts the byte
+/// stream at arbitrary offsets, e.g. `─` is 3 bytes).
+struct OutputReceiver {
+    receiver: mpsc::UnboundedReceiver<Bytes>,
+    decoder: Utf8StreamDecoder,
+    window: Option<WindowReader>,
+}
+
+impl OutputReceiver {
+    fn new(receiver: mpsc::UnboundedReceiver<Bytes>, window: Option<OutputWindow>) -> Self {
+        Self {
+            receiver,
+            decoder: Utf8StreamDecoder::default(),
+            window: window.map(WindowReader),
+        }
+    }
+
+    fn poll_text(&mut self, cx: &mut Context<'_>) -> Poll<Option<String>> {
+        loop {
+            match poll_chunk(&mut self.receiver, self.window.as_ref(), cx) {
+                Poll::Pending => return Poll::Pending,
+                Poll::Ready(Some(chunk)) => {
+                    // `Vec::from` reclaims the allocation when this is the
+                    // only reference, so valid text is not copied.
+                    let text = self.decoder.decode(Vec::from(chunk));
+                    if !text.is_empty() {
+                        return Poll::Ready(Some(text));
+                    }
+                    // Only a partial codepoint so far; wait for the rest.
+                }
+                Poll::Ready(None) => {
+                    // End of stream: a held partial becomes one U+FFFD,
+                    // matching `from_utf8_lossy` on a truncated tail.
+                    let tail = self.decoder.flush();
+                    return Poll::Ready((!tail.is_empty()).then_some(tail));
+                }
+            }
+        }
+    }
+
+    fn into_bytes(mut self) -> ExecOutputBytes {
+        let pending = self.decoder.take_pending();
+        ExecOutputBytes {
+            pending: (!pending.is_empty()).then(|| Bytes::from(pending)),
+            receiver: self.receiver,
+            window: self.window,
+        }
+    }
+}
+
+/// Receive one chunk and hand its window credit back to the transport.
+fn poll_chunk(
+    receiver: &mut mpsc::UnboundedReceiver<Bytes>,
+    window: Option<&WindowReader>,
+    cx: &mut Context<'_>,
+) -> Poll<Option<Bytes>> {
+    let polled = receiver.poll_recv(cx);
+    if let (Poll::Ready(Some(chunk)), Some(window)) = (&polled, window) {
+        window.0.release(chunk.len());
+    }
+    polled
+}
+
 /// Standard output stream (read-only).
+///
+/// Yields UTF-8 text (invalid sequences become U+FFFD). Use
+/// [`ExecStdout::into_bytes`] for binary-safe output.
 pub struct ExecStdout {
-    receiver: mpsc::UnboundedReceiver<String>,
+    output: OutputReceiver,
 }
 
 impl ExecStdout {
-    pub(crate) fn new(receiver: mpsc::UnboundedReceiver<String>) -> Self {
-        Self { receiver }
+    pub(crate) fn new(receiver: mpsc::UnboundedReceiver<Bytes>) -> Self {
+        Self::with_window(receiver, None)
+    }
+
+    pub(crate) fn with_window(
+        receiver: mpsc::UnboundedReceiver<Bytes>,
+        window: Option<OutputWindow>,
+    ) -> Self {
+        Self {
+            output: OutputReceiver::new(receiver, window),
+        }
+    }
+
+    /// Switch to raw chunks exactly as the guest wrote them: no UTF-8
+    /// validation and no copy. Bytes of a codepoint still held from earlier
+    /// text reads are yielded first, so nothing is lost.
+    pub fn into_bytes(self) -> ExecOutputBytes {
+        self.output.into_bytes()
     }
 }
 
@@ -406,18 +570,35 @@ impl Stream for ExecStdout {
     type Item = String;
 
     fn poll_next(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Option<Self::Item>> {
-        self.receiver.poll_recv(cx)
+        self.output.poll_text(cx)
     }
 }
 
 /// Standard error stream (read-only).
+///
+/// Yields UTF-8 text (invalid sequences become U+FFFD). Use
+/// [`ExecStderr::into_bytes`] for binary-safe output.
 pub struct ExecStderr {
-    receiver: mpsc::UnboundedReceiver<String>,
+    output: OutputReceiver,
 }
 
 impl ExecStderr {
-    pub(crate) fn new(receiver: mpsc::UnboundedReceiver<String>) -> Self {
-        Self { receiver }
+    pub(crate) fn new(receiver: mpsc::UnboundedReceiver<Bytes>) -> Self {
+        Self::with_window(receiver, None)
+    }
+
+    pub(crate) fn with_window(
+        receiver: mpsc::UnboundedReceiver<Bytes>,
+        window: Option<OutputWindow>,
+    ) -> Self {
+        Self {
+            output: OutputReceiver::new(receiver, window),
+        }
+    }
+
+    /// Switch to raw chunks; see [`ExecStdout::into_bytes`].
+    pub fn into_bytes(self) -> ExecOutputBytes {
+        self.output.into_bytes()
     }
 }
 
@@ -425,7 +606,28 @@ impl Stream for ExecStderr {
     type Item = String;
 
     fn poll_next(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Option<Self::Item>> {
-        self.receiver.poll_recv(cx)
+        self.output.poll_text(cx)
+    }
+}
+
+/// Raw byte view of an output stream, from [`ExecStdout::into_bytes`] or
+/// [`ExecStderr::into_bytes`]. Chunk boundaries are the transport's, not
+/// lines.
+pub struct ExecOutputBytes {
+    pending: Option<Bytes>,
+    receiver: mpsc::UnboundedReceiver<Bytes>,
+    window: Option<WindowReader>,
+}
+
+impl Stream for ExecOutputBytes {
+    type Item = Bytes;
+
+    fn poll_next(mut self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Option<Self::Item>> {
+        if let Some(pending) = self.pending.take() {
+            return Poll::Ready(Some(pending));
+        }
+        let this = &mut *self;
+        poll_chunk(&mut this.receiver, this.window.as_ref(), cx)
     }
 }
 
@@ -537,4 +739,99 @@ mod tests {
         assert!(result.is_ok());
         assert!(kill_observed.load(AtomicOrdering::SeqCst));
     }
+
+    // ─── Output streams: text decoding vs raw bytes ───────────────────
+
+    use futures::StreamExt;
+
+    /// A 3-byte char split across two transport chunks reads back as one
+    /// char, not two U+FFFD. Regression guard for the TUI cursor desync.
+    #[tokio::test]
+    async fn stdout_text_joins_codepoint_split_across_chunks() {
+        let (tx, rx) = tokio_mpsc::unbounded_channel::<Bytes>();
+        let mut stdout = ExecStdout::new(rx);
+        tx.send(Bytes::from_static(&[0xE2])).unwrap();
+        tx.send(Bytes::from_static(&[0x94, 0x80])).unwrap();
+        drop(tx);
+
+        assert_eq!(stdout.next().await.as_deref(), Some("─"));
+        assert_eq!(stdout.next().await, None);
+    }
+
+    /// A partial codepoint still held at EOF surfaces as one U+FFFD instead
+    /// of being silently dropped.
+    #[tokio::test]
+    async fn stderr_text_flushes_held_partial_at_eof() {
+        let (tx, rx) = tokio_mpsc::unbounded_channel::<Bytes>();
+        let mut stderr = ExecStderr::new(rx);
+        tx.send(Bytes::from_static(b"ok\xE2")).unwrap();
+        drop(tx);
+
+        assert_eq!(stderr.next().await.as_deref(), Some("ok"));
+        assert_eq!(stderr.next().await.as_deref(), Some("\u{FFFD}"));
+        assert_eq!(stderr.next().await, None);
+    }
+
+    /// Byte mode hands back the exact buffers the backend sent: invalid
+    /// UTF-8 survives and the allocation is shared, not copied.
+    #[tokio::test]
+    async fn stdout_bytes_mode_is_binary_safe_and_zero_copy() {
+        let (tx, rx) = tokio_mpsc::unbounded_channel::<Bytes>();
+        let mut bytes = ExecStdout::new(rx).into_bytes();
+        let chunk = Bytes::from(vec![0x1F, 0x8B, 0xFF, 0x00]);
+        let ptr = chunk.as_ptr();
+        tx.send(chunk).unwrap();
+        drop(tx);
+
+        let got = bytes.next().await.expect("one chunk");
+        assert_eq!(&got[..], &[0x1F, 0x8B, 0xFF, 0x00]);
+        assert_eq!(got.as_ptr(), ptr);
+        assert!(bytes.next().await.is_none());
+    }
+
+    /// Switching to bytes after a text read returns the held partial
+    /// codepoint raw, ahead of later chunks.
+    #[tokio::test]
+    async fn into_bytes_after_text_read_keeps_held_partial() {
+        let (tx, rx) = tokio_mpsc::unbounded_channel::<Bytes>();
+        let mut stdout = ExecStdout::new(rx);
+        tx.send(Bytes::from_static(b"hi\xE2\x94")).unwrap();
+        assert_eq!(stdout.next().await.as_deref(), Some("hi"));
+
+        let mut bytes = stdout.into_bytes();
+        tx.send(Bytes::from_static(&[0x80])).unwrap();
+        drop(tx);
+
+        assert_eq!(bytes.next().await.as_deref(), Some(&[0xE2, 0x94][..]));
+        assert_eq!(bytes.next().await.as_deref(), Some(&[0x80][..]));
+        assert!(bytes.next().await.is_none());
+    }
+
+    // ─── Output window ────────────────────────────────────────────────
+
+    /// The transport can queue one window of output; the next reserve
+    /// waits until the reader takes a chunk, and never once it is dropped.
+    #[tokio::test]
+    async fn output_window_blocks_until_read_and_opens_on_drop() {
+        use std::time::Duration;
+
+        let window = OutputWindow::new(4);
+        let (tx, rx) = tokio_mpsc::unbounded_channel::<Bytes>();
+        let mut bytes = ExecStdout::with_window(rx, Some(window.clone())).into_bytes();
+
+        window.reserve(4).await;
+        tx.send(Bytes::from_static(b"full")).unwrap();
+        let blocked = tokio::time::timeout(Duration::from_millis(50), window.reserve(1)).await;
+        assert!(blocked.is_err(), "a full window must hold the transport");
+
+        assert_eq!(bytes.next().await.as_deref(), Some(&b"full"[..]));
+        tokio::time::timeout(Duration::from_millis(500), window.reserve(4))
+            .await
+            .expect("reading a chunk returns its credit");
+
+        drop(bytes);
+        tokio::time::timeout(Duration::from_millis(500), window.reserve(4))
+            .await
+            .expect("a dropped stream never holds the transport");
+    }
 }
@@ -5,27 +5,28 @@
 //! Initialization is table-driven with different execution plans based on BoxStatus:
 //!
 //! ```text
-//! Starting (new box):
-//!   1. Filesystem           (create layout)
-//!   2. ContainerRootfs ─┬─  (pull image, create COW disk)
-//!      GuestRootfs     ─┘   (prepare guest, create COW disk)
-//!   3. VmmSpawn             (build config + spawn VM)
-//!   4. GuestConnect         (wait for guest ready)
-//!   5. GuestInit            (initialize container)
-//!
-//! Stopped (restart):
-//!   1. Filesystem           (load existing layout)
-//!   2. ContainerRootfs ─┬─  (reuse existing COW disk - preserves user data)
-//!      GuestRootfs     ─┘   (reuse existing COW disk)
-//!   3. VmmSpawn             (build config + spawn NEW VM)
-//!   4. GuestConnect         (wait for guest ready)
-//!   5. GuestInit            (re-initialize container in new VM)
+//! Starting (new box) / Stopped (restart) - dependency graph:
+//!   Filesystem              (create or load layout)
+//!   ContainerRootfs         (pull image, prepare base rootfs; restart: config only)
+//!   GuestRootfs             (prepare shared guest rootfs)
+//!   ContainerDisk  ← Filesystem, ContainerRootfs
+//!                           (create COW disk; restart: reuse it, keeping user data)
+//!   GuestDisk      ← Filesystem, GuestRootfs
+//!                           (create or reuse guest COW disk)
+//!   VmmSpawn       ← ContainerDisk, GuestDisk
+//!                           (build config + spawn VM)
+//!   GuestConnect   ← VmmSpawn (wait for guest ready)
+//!   GuestInit      ← GuestConnect (initialize container)
 //!
 //! Running (reattach):
 //!   1. VmmAttach            (attach to running VM)
 //!   2. GuestConnect         (reconnect to guest)
 //! ```
 //!
+//! The three tasks with no inputs start together, so image pulls and rootfs
+//! builds overlap filesystem setup. `PipelineMetrics::critical_path` shows
+//! which chain set `create_duration_ms`.
+//!
 //! `CleanupGuard` provides RAII cleanup on failure.
 
 mod tasks;
@@ -35,19 +36,21 @@ pub(crate) use crate::litebox::box_impl::LiveState;
 
 use crate::litebox::BoxStatus;
 use crate::litebox::config::BoxConfig;
-use crate::metrics::BoxMetricsStorage;
+use crate::metrics::{BoxMetricsStorage, InitTaskTrace};
 use crate::pipeline::{
-    BoxedTask, ExecutionPlan, PipelineBuilder, PipelineExecutor, PipelineMetrics, Stage,
+    ExecutionPlan, GraphNode, PipelineBuilder, PipelineExecutor, PipelineMetrics, Stage,
 };
+use crate::runtime::placement::BoxPlacement;
 use crate::runtime::rt_impl::SharedRuntimeImpl;
 use crate::runtime::types::BoxState;
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+use std::collections::HashSet;
 use std::sync::Arc;
 use tokio::sync::Mutex;
 
 use tasks::{
-    ContainerRootfsTask, FilesystemTask, GuestConnectTask, GuestInitTask, GuestRootfsTask, InitCtx,
-    VmmAttachTask, VmmSpawnTask,
+    ContainerDiskTask, ContainerRootfsTask, FilesystemTask, GuestConnectTask, GuestDiskTask,
+    GuestInitTask, GuestRootfsTask, InitCtx, VmmAttachTask, VmmSpawnTask,
 };
 use types::InitPipelineContext;
 
@@ -61,44 +64,34 @@ use types::InitPipelineContext;
 /// (e.g. Unknown from a corrupted DB row, or future variants). Callers
 /// should treat this as a user-facing precondition error.
 fn get_execution_plan(status: BoxStatus) -> BoxliteResult<ExecutionPlan<InitCtx>> {
-    let stages: Vec<Stage<BoxedTask<InitCtx>>> = match status {
-        BoxStatus::Configured => vec![
-            // First start: Full pipeline
-            // Phase 1: Setup filesystem layout first
-            Stage::sequential(vec![Box::new(FilesystemTask)]),
-            // Phase 2: Prepare rootfs (now has access to layout for disk paths)
-            Stage::parallel(vec![
-                Box::new(ContainerRootfsTask),
-                Box::new(GuestRootfsTask),
-            ]),
-            // Phase 3: Build config and spawn VM
-            Stage::sequential(vec![Box::new(VmmSpawnTask)]),
-            // Phase 4: Connect to guest and initialize container
-            Stage::sequential(vec![Box::new(GuestConnectTask)]),
-            Stage::sequential(vec![Box::new(GuestInitTask)]),
-        ],
-        // Stopped and Failed both run the restart pipeline. A Failed box
-        // has its rootfs preserved (per BoxStatus::Failed doc) and is
-        // retryable per BoxStatus::can_start.
-        BoxStatus::Stopped | BoxStatus::Failed => vec![
-            // Restart: Same flow but rootfs tasks reuse existing COW disks
-            // (preserves user modifications from previous run)
-            Stage::sequential(vec![Box::new(FilesystemTask)]),
-            Stage::parallel(vec![
-                Box::new(ContainerRootfsTask),
-                Box::new(GuestRootfsTask),
-            ]),
-            Stage::sequential(vec![Box::new(VmmSpawnTask)]),
-            Stage::sequential(vec![Box::new(GuestConnectTask)]),
-            // GuestInit must run - new VM process has fresh guest daemon
-            Stage::sequential(vec![Box::new(GuestInitTask)]),
-        ],
-        BoxStatus::Running => vec![
+    let plan = match status {
+        // First start and restart share one graph; the rootfs and disk tasks
+        // check `reuse_rootfs` to keep existing COW disks (preserving user
+        // modifications from the previous run). Stopped and Failed both
+        // restart: a Failed box has its rootfs preserved (per
+        // BoxStatus::Failed doc) and is retryable per BoxStatus::can_start.
+        // GuestInit must run - new VM process has fresh guest daemon.
+        BoxStatus::Configured | BoxStatus::Stopped | BoxStatus::Failed => {
+            ExecutionPlan::graph(vec![
+                GraphNode::new(Box::new(FilesystemTask)),
+                GraphNode::new(Box::new(ContainerRootfsTask)),
+                GraphNode::new(Box::new(GuestRootfsTask)),
+                GraphNode::new(Box::new(ContainerDiskTask))
+                    .after(&["filesystem_setup", "container_rootfs_prep"]),
+                GraphNode::new(Box::new(GuestDiskTask))
+                    .after(&["filesystem_setup", "guest_rootfs_init"]),
+                // Needs both disks and the image config (ports, entrypoint)
+                GraphNode::new(Box::new(VmmSpawnTask)).after(&["container_disk", "guest_disk"]),
+                GraphNode::new(Box::new(GuestConnectTask)).after(&["vmm_spawn"]),
+                GraphNode::new(Box::new(GuestInitTask)).after(&["guest_connect"]),
+            ])
+        }
+        BoxStatus::Running => ExecutionPlan::new(vec![
             // Reattach: vmm_attach gates on ProcessIdentity AND surfaces
             // any crash via exit_file, then connect to guest.
             Stage::sequential(vec![Box::new(VmmAttachTask)]),
             Stage::sequential(vec![Box::new(GuestConnectTask)]),
-        ],
+        ]),
         other => {
             return Err(BoxliteError::InvalidState(format!(
                 "Cannot initialize box in {other} state"
@@ -106,7 +99,7 @@ fn get_execution_plan(status: BoxStatus) -> BoxliteResult<ExecutionPlan<InitCtx>
         }
     };
 
-    Ok(ExecutionPlan::new(stages))
+    Ok(plan)
 }
 
 fn box_metrics_from_pipeline(pipeline_metrics: &PipelineMetrics) -> BoxMetricsStorage {
@@ -115,10 +108,17 @@ fn box_metrics_from_pipeline(pipeline_metrics: &PipelineMetrics) -> BoxMetricsSt
     if let Some(duration_ms) = pipeline_metrics.task_duration_ms("filesystem_setup") {
         metrics.set_stage_filesystem_setup(duration_ms);
     }
-    if let Some(duration_ms) = pipeline_metrics.task_duration_ms("container_rootfs_prep") {
+    // Rootfs stages cover both the shared preparation and the per-box disk.
+    let stage_total = |names: &[&str]| {
+        names
+            .iter()
+            .filter_map(|name| pipeline_metrics.task_duration_ms(name))
+            .reduce(|a, b| a + b)
+    };
+    if let Some(duration_ms) = stage_total(&["container_rootfs_prep", "container_disk"]) {
         metrics.set_stage_image_prepare(duration_ms);
     }
-    if let Some(duration_ms) = pipeline_metrics.task_duration_ms("guest_rootfs_init") {
+    if let Some(duration_ms) = stage_total(&["guest_rootfs_init", "guest_disk"]) {
         metrics.set_stage_guest_rootfs(duration_ms);
     }
     if let Some(duration_ms) = pipeline_metrics.task_duration_ms("vmm_spawn") {
@@ -134,6 +134,29 @@ fn box_metrics_from_pipeline(pipeline_metrics: &PipelineMetrics) -> BoxMetricsSt
     if let Some(duration_ms) = pipeline_metrics.task_duration_ms("guest_init") {
         metrics.set_stage_container_init(duration_ms);
     }
+    // Guest boot: VM spawn start until the guest agent answers.
+    let task = |name: &str| pipeline_metrics.tasks.iter().find(|t| t.name == name);
+    if let (Some(spawn), Some(connect)) = (task("vmm_spawn"), task("guest_connect")) {
+        metrics.set_guest_boot_duration(connect.end_ms().saturating_sub(spawn.start_ms));
+    }
+
+    let critical_path: HashSet<&str> = pipeline_metrics
+        .critical_path()
+        .into_iter()
+        .map(|task| task.name.as_str())
+        .collect();
+    let mut trace: Vec<InitTaskTrace> = pipeline_metrics
+        .tasks
+        .iter()
+        .map(|task| InitTaskTrace {
+            name: task.name.clone(),
+            start_ms: task.start_ms,
+            duration_ms: task.duration_ms,
+            on_critical_path: critical_path.contains(task.name.as_str()),
+        })
+        .collect();
+    trace.sort_by_key(|task| task.start_ms);
+    metrics.set_init_trace(trace);
 
     metrics
 }
@@ -151,6 +174,7 @@ pub(crate) struct BoxBuilder {
     runtime: SharedRuntimeImpl,
     config: BoxConfig,
     state: BoxState,
+    placement: Option<BoxPlacement>,
 }
 
 impl BoxBuilder {
@@ -178,9 +202,16 @@ impl BoxBuilder {
             runtime,
             config,
             state,
+            placement: None,
         })
     }
 
+    /// Spawn the VMM confined to `placement` (ignored on reattach).
+    pub(crate) fn with_placement(mut self, placement: Option<BoxPlacement>) -> Self {
+        self.placement = placement;
+        self
+    }
+
     /// Build and initialize LiveState.
     ///
     /// Executes all initialization stages with automatic cleanup on failure.
@@ -195,13 +226,16 @@ impl BoxBuilder {
             runtime,
             config,
             state,
+            placement,
         } = self;
 
         let status = state.status;
         let reuse_rootfs = status == BoxStatus::Stopped;
         let skip_guest_wait = status == BoxStatus::Running;
 
-        let ctx = InitPipelineContext::new(config, runtime.clone(), reuse_rootfs, skip_guest_wait);
+        let mut ctx =
+            InitPipelineContext::new(config, runtime.clone(), reuse_rootfs, skip_guest_wait);
+        ctx.placement = placement;
         let ctx = Arc::new(Mutex::new(ctx));
         let ctx_for_cleanup = Arc::clone(&ctx);
 
@@ -216,7 +250,8 @@ impl BoxBuilder {
             let pipeline_metrics = PipelineExecutor::execute(pipeline, Arc::clone(&ctx)).await?;
 
             let mut ctx = ctx.lock().await;
-            let total_create_duration_ms = total_start.elapsed().as_millis();
+            let total_create_duration = total_start.elapsed();
+            let total_create_duration_ms = total_create_duration.as_millis();
             let handler = ctx
                 .guard
                 .take_handler()
@@ -225,6 +260,19 @@ impl BoxBuilder {
             let mut metrics = box_metrics_from_pipeline(&pipeline_metrics);
             metrics.set_total_create_duration(total_create_duration_ms);
 
+            // Reattach is not a boot; keep it out of the latency distributions.
+            if status != BoxStatus::Running {
+                let runtime_metrics = &ctx.runtime.runtime_metrics;
+                runtime_metrics
+                    .create_latency_us
+                    .record_micros(total_create_duration);
+                if let Some(boot_ms) = metrics.guest_boot_duration_ms {
+                    runtime_metrics
+                        .boot_latency_us
+                        .record(boot_ms.saturating_mul(1000) as u64);
+                }
+            }
+
             metrics.log_init_stages();
 
             // Note: Guard is NOT disarmed here. Caller is responsible for disarming
@@ -1,10 +1,14 @@
-//! Task: Container rootfs preparation.
+//! Tasks: Container rootfs preparation and per-box disk.
 //!
-//! Pulls container image and prepares container rootfs:
+//! `ContainerRootfsTask` pulls the container image and prepares the rootfs:
 //! - Disk-based: Creates ext4 disk image from merged layers (fast boot)
 //! - Overlayfs: Extracts layers for guest-side overlayfs (flexible)
 //!
-//! For restart (reuse_rootfs=true), opens existing COW disk instead of creating new.
+//! It needs nothing from the box layout, so it runs alongside filesystem
+//! setup. `ContainerDiskTask` then creates the per-box COW disk in the layout.
+//!
+//! For restart (reuse_rootfs=true), only the image config is loaded and the
+//! disk task opens the existing COW disk instead of creating a new one.
 
 use super::{InitCtx, log_task_error, task_start};
 use crate::disk::{BackingFormat, Disk, DiskFormat, Qcow2Helper};
@@ -29,18 +33,12 @@ impl PipelineTask<InitCtx> for ContainerRootfsTask {
             rootfs_spec,
             env,
             runtime,
-            layout,
             reuse_rootfs,
-            disk_size_gb,
             entrypoint_override,
             cmd_override,
             user_override,
         ) = {
             let ctx = ctx.lock().await;
-            let layout = ctx
-                .layout
-                .clone()
-                .ok_or_else(|| BoxliteError::Internal("filesystem task must run first".into()))?;
             let mut env = ctx.config.options.env.clone();
             // Inject secret placeholder env vars (e.g., BOXLITE_SECRET_OPENAI=<BOXLITE_SECRET:openai>).
             // The MITM proxy substitutes real values at the network boundary.
@@ -50,22 +48,18 @@ impl PipelineTask<InitCtx> for ContainerRootfsTask {
                 ctx.config.options.rootfs.clone(),
                 env,
                 ctx.runtime.clone(),
-                layout,
                 ctx.reuse_rootfs,
-                ctx.config.options.disk_size_gb,
                 ctx.config.options.entrypoint.clone(),
                 ctx.config.options.cmd.clone(),
                 ctx.config.options.user.clone(),
             )
         };
 
-        let (container_image_config, disk) = run_container_rootfs(
+        let (container_image_config, rootfs) = run_container_rootfs(
             &rootfs_spec,
             &env,
             &runtime,
-            &layout,
             reuse_rootfs,
-            disk_size_gb,
             entrypoint_override.as_deref(),
             cmd_override.as_deref(),
             user_override.as_deref(),
@@ -75,7 +69,7 @@ impl PipelineTask<InitCtx> for ContainerRootfsTask {
 
         let mut ctx = ctx.lock().await;
         ctx.container_image_config = Some(container_image_config);
-        ctx.container_disk = Some(disk);
+        ctx.container_rootfs = rootfs;
 
         Ok(())
     }
@@ -85,72 +79,60 @@ impl PipelineTask<InitCtx> for ContainerRootfsTask {
     }
 }
 
-/// Pull image and prepare rootfs, then create or reuse COW disk.
-#[allow(clippy::too_many_arguments)]
+pub struct ContainerDiskTask;
+
+#[async_trait]
+impl PipelineTask<InitCtx> for ContainerDiskTask {
+    async fn run(self: Box<Self>, ctx: InitCtx) -> BoxliteResult<()> {
+        let task_name = self.name();
+        let box_id = task_start(&ctx, task_name).await;
+
+        let (layout, rootfs, reuse_rootfs, disk_size_gb) = {
+            let mut ctx = ctx.lock().await;
+            let layout = ctx
+                .layout
+                .clone()
+                .ok_or_else(|| BoxliteError::Internal("filesystem task must run first".into()))?;
+            (
+                layout,
+                ctx.container_rootfs.take(),
+                ctx.reuse_rootfs,
+                ctx.config.options.disk_size_gb,
+            )
+        };
+
+        let disk = match rootfs {
+            Some(rootfs) => create_cow_disk(&rootfs, &layout, disk_size_gb),
+            None if reuse_rootfs => open_existing_disk(&layout),
+            None => Err(BoxliteError::Internal(
+                "container rootfs task must run first".into(),
+            )),
+        }
+        .inspect_err(|e| log_task_error(&box_id, task_name, e))?;
+
+        let mut ctx = ctx.lock().await;
+        ctx.container_disk = Some(disk);
+
+        Ok(())
+    }
+
+    fn name(&self) -> &str {
+        "container_disk"
+    }
+}
+
+/// Pull or load the image and build the container config. On a fresh start
+/// also prepare the base rootfs; on restart the existing COW disk already
+/// holds it, so no rootfs is returned.
 async fn run_container_rootfs(
     rootfs_spec: &RootfsSpec,
     env: &[(String, String)],
     runtime: &SharedRuntimeImpl,
-    layout: &BoxFilesystemLayout,
     reuse_rootfs: bool,
-    disk_size_gb: Option<u64>,
     entrypoint_override: Option<&[String]>,
     cmd_override: Option<&[String]>,
     user_override: Option<&str>,
-) -> BoxliteResult<(ContainerImageConfig, Disk)> {
-    let disk_path = layout.disk_path();
-
-    // For restart, reuse existing COW disk
-    if reuse_rootfs {
-        tracing::info!(
-            disk_path = %disk_path.display(),
-            "Restart mode: reusing existing container rootfs disk"
-        );
-
-        if !disk_path.exists() {
-            return Err(BoxliteError::Storage(format!(
-                "Cannot restart: container rootfs disk not found at {}",
-                disk_path.display()
-            )));
-        }
-
-        let disk = Disk::new(disk_path.clone(), DiskFormat::Qcow2, true);
-
-        // Load container config
-        let image = match rootfs_spec {
-            RootfsSpec::Image(r) => pull_image(runtime, r).await?,
-            RootfsSpec::RootfsPath(path) => {
-                let bundle_dir = std::path::Path::new(path);
-
-                if !bundle_dir.exists() {
-                    return Err(BoxliteError::Storage(format!(
-                        "Rootfs path does not exist: {}",
-                        path
-                    )));
-                }
-
-                runtime
-                    .image_manager
-                    .load_from_local(bundle_dir.to_path_buf(), format!("local:{}", path))
-                    .await?
-            }
-        };
-        let image_config = image.load_config().await?;
-        let mut container_image_config = ContainerImageConfig::from_oci_config(&image_config)?;
-        if !env.is_empty() {
-            container_image_config.merge_env(env.to_vec());
-        }
-        apply_user_overrides(
-            &mut container_image_config,
-            entrypoint_override,
-            cmd_override,
-            user_override,
-        );
-
-        return Ok((container_image_config, disk));
-    }
-
-    // Fresh start: pull or load image
+) -> BoxliteResult<(ContainerImageConfig, Option<ContainerRootfsPrepResult>)> {
     let image = match rootfs_spec {
         RootfsSpec::Image(r) => pull_image(runtime, r).await?,
         RootfsSpec::RootfsPath(path) => {
@@ -170,11 +152,13 @@ async fn run_container_rootfs(
         }
     };
 
-    // Prepare rootfs from image
-    let rootfs_result = if USE_DISK_ROOTFS {
-        prepare_disk_rootfs(&runtime.image_disk_mgr, &image).await?
+    // Prepare rootfs from image (fresh start only)
+    let rootfs_result = if reuse_rootfs {
+        None
+    } else if USE_DISK_ROOTFS {
+        Some(prepare_disk_rootfs(&runtime.image_disk_mgr, &image).await?)
     } else if USE_OVERLAYFS {
-        prepare_overlayfs_layers(&image).await?
+        Some(prepare_overlayfs_layers(&image).await?)
     } else {
         return Err(BoxliteError::Storage(
             "Merged rootfs not supported. Use overlayfs or disk rootfs.".into(),
@@ -194,9 +178,25 @@ async fn run_container_rootfs(
         user_override,
     );
 
-    let disk = create_cow_disk(&rootfs_result, layout, disk_size_gb)?;
+    Ok((container_image_config, rootfs_result))
+}
 
-    Ok((container_image_config, disk))
+/// Open the COW disk left by a previous run (restart preserves user data).
+fn open_existing_disk(layout: &BoxFilesystemLayout) -> BoxliteResult<Disk> {
+    let disk_path = layout.disk_path();
+    tracing::info!(
+        disk_path = %disk_path.display(),
+        "Restart mode: reusing existing container rootfs disk"
+    );
+
+    if !disk_path.exists() {
+        return Err(BoxliteError::Storage(format!(
+            "Cannot restart: container rootfs disk not found at {}",
+            disk_path.display()
+        )));
+    }
+
+    Ok(Disk::new(disk_path, DiskFormat::Qcow2, true))
 }
 
 /// Create COW disk from base rootfs.
@@ -208,7 +208,7 @@ async fn run_container_rootfs(
 ///   will have this virtual size (or the base disk size, whichever is larger).
 fn create_cow_disk(
     rootfs_result: &ContainerRootfsPrepResult,
-    layout: &crate::runtime::layout::BoxFilesystemLayout,
+    layout: &BoxFilesystemLayout,
     disk_size_gb: Option<u64>,
 ) -> BoxliteResult<Disk> {
     match rootfs_result {
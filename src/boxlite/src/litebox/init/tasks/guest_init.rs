@@ -9,6 +9,7 @@ use crate::net::constants::{GATEWAY_IP, GUEST_CIDR, GUEST_INTERFACE};
 use crate::pipeline::PipelineTask;
 use crate::portal::GuestSession;
 use crate::portal::interfaces::{ContainerRootfsInitConfig, GuestInitConfig, NetworkInitConfig};
+use crate::runtime::advanced_options::MemoryReclaimOptions;
 use crate::runtime::options::NetworkSpec;
 use crate::runtime::types::ContainerID;
 use crate::volumes::{ContainerMount, GuestVolumeManager};
@@ -31,6 +32,7 @@ impl PipelineTask<InitCtx> for GuestInitTask {
             rootfs_init,
             container_mounts,
             network_spec,
+            memory_reclaim,
             ca_cert_pem,
         ) =
             {
@@ -53,6 +55,7 @@ impl PipelineTask<InitCtx> for GuestInitTask {
                     BoxliteError::Internal("vmm_spawn task must run first".into())
                 })?;
                 let network_spec = ctx.config.options.network.clone();
+                let memory_reclaim = ctx.config.options.advanced.memory_reclaim.clone();
                 let ca_cert_pem = ctx.ca_cert_pem.clone();
                 (
                     guest_session,
@@ -62,6 +65,7 @@ impl PipelineTask<InitCtx> for GuestInitTask {
                     rootfs_init,
                     container_mounts,
                     network_spec,
+                    memory_reclaim,
                     ca_cert_pem,
                 )
             };
@@ -74,6 +78,7 @@ impl PipelineTask<InitCtx> for GuestInitTask {
             &rootfs_init,
             &container_mounts,
             &network_spec,
+            memory_reclaim,
             ca_cert_pem.as_deref(),
         )
         .await
@@ -103,6 +108,7 @@ async fn run_guest_init(
     rootfs_init: &ContainerRootfsInitConfig,
     container_mounts: &[ContainerMount],
     network_spec: &NetworkSpec,
+    memory_reclaim: Option<MemoryReclaimOptions>,
     ca_cert_pem: Option<&str>,
 ) -> BoxliteResult<()> {
     let container_id_str = container_id.as_str();
@@ -122,6 +128,7 @@ async fn run_guest_init(
     let guest_init_config = GuestInitConfig {
         volumes: guest_volumes,
         network,
+        memory_reclaim,
     };
 
     // Step 1: Guest Init (volumes + network)
@@ -1,7 +1,9 @@
-//! Task: Guest rootfs preparation.
+//! Tasks: Guest rootfs preparation and per-box disk.
 //!
-//! Lazily initializes the bootstrap guest rootfs as a disk image (shared across all boxes).
-//! Then creates or reuses per-box COW overlay disk.
+//! `GuestRootfsTask` lazily initializes the bootstrap guest rootfs as a disk
+//! image (shared across all boxes); it needs nothing from the box layout, so
+//! it runs alongside filesystem setup. `GuestDiskTask` then creates or reuses
+//! the per-box COW overlay disk.
 
 use super::{InitCtx, log_task_error, task_start};
 use crate::disk::{BackingFormat, Disk, DiskFormat, Qcow2Helper};
@@ -23,21 +25,14 @@ impl PipelineTask<InitCtx> for GuestRootfsTask {
         let task_name = self.name();
         let box_id = task_start(&ctx, task_name).await;
 
-        let (runtime, layout, reuse_rootfs) = {
-            let ctx = ctx.lock().await;
-            let layout = ctx
-                .layout
-                .clone()
-                .ok_or_else(|| BoxliteError::Internal("filesystem task must run first".into()))?;
-            (ctx.runtime.clone(), layout, ctx.reuse_rootfs)
-        };
+        let runtime = { ctx.lock().await.runtime.clone() };
 
-        let disk = run_guest_rootfs(&runtime, &layout, reuse_rootfs)
+        let guest_rootfs = run_guest_rootfs(&runtime)
             .await
             .inspect_err(|e| log_task_error(&box_id, task_name, e))?;
 
         let mut ctx = ctx.lock().await;
-        ctx.guest_disk = disk;
+        ctx.guest_rootfs = Some(guest_rootfs);
 
         Ok(())
     }
@@ -47,13 +42,44 @@ impl PipelineTask<InitCtx> for GuestRootfsTask {
     }
 }
 
-/// Get or initialize bootstrap guest rootfs, then create/reuse per-box COW disk.
-async fn run_guest_rootfs(
-    runtime: &SharedRuntimeImpl,
-    layout: &BoxFilesystemLayout,
-    reuse_rootfs: bool,
-) -> BoxliteResult<Option<Disk>> {
-    // First, get or create the shared base guest rootfs
+pub struct GuestDiskTask;
+
+#[async_trait]
+impl PipelineTask<InitCtx> for GuestDiskTask {
+    async fn run(self: Box<Self>, ctx: InitCtx) -> BoxliteResult<()> {
+        let task_name = self.name();
+        let box_id = task_start(&ctx, task_name).await;
+
+        let (guest_rootfs, layout, reuse_rootfs) = {
+            let ctx = ctx.lock().await;
+            (
+                ctx.guest_rootfs.clone(),
+                ctx.layout.clone(),
+                ctx.reuse_rootfs,
+            )
+        };
+        let layout = layout
+            .ok_or_else(|| BoxliteError::Internal("filesystem task must run first".into()))?;
+        let guest_rootfs = guest_rootfs
+            .ok_or_else(|| BoxliteError::Internal("guest rootfs task must run first".into()))?;
+
+        let (_updated_guest_rootfs, disk) =
+            create_or_reuse_cow_disk(&guest_rootfs, &layout, reuse_rootfs)
+                .inspect_err(|e| log_task_error(&box_id, task_name, e))?;
+
+        let mut ctx = ctx.lock().await;
+        ctx.guest_disk = disk;
+
+        Ok(())
+    }
+
+    fn name(&self) -> &str {
+        "guest_disk"
+    }
+}
+
+/// Get or initialize the shared bootstrap guest rootfs.
+async fn run_guest_rootfs(runtime: &SharedRuntimeImpl) -> BoxliteResult<GuestRootfs> {
     let guest_rootfs = runtime
         .guest_rootfs
         .get_or_try_init(|| async {
@@ -79,11 +105,7 @@ async fn run_guest_rootfs(
         .await?
         .clone();
 
-    // Now create or reuse the per-box COW disk
-    let (_updated_guest_rootfs, disk) =
-        create_or_reuse_cow_disk(&guest_rootfs, layout, reuse_rootfs)?;
-
-    Ok(disk)
+    Ok(guest_rootfs)
 }
 
 /// Create new COW disk or reuse existing one for restart.
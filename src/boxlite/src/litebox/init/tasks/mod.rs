@@ -3,21 +3,20 @@
 //! ## Dependency Graph
 //!
 //! ```text
-//! Filesystem ─────┐
-//!                 │
-//! ContainerRootfs ┼──→ VmmSpawn ──→ GuestConnect ──→ GuestInit
-//!                 │
-//! GuestRootfs ────┘
+//! Task              Waits for
+//! ----------------  ---------------------------
+//! Filesystem        -
+//! ContainerRootfs   -
+//! GuestRootfs       -
+//! ContainerDisk     Filesystem, ContainerRootfs
+//! GuestDisk         Filesystem, GuestRootfs
+//! VmmSpawn          ContainerDisk, GuestDisk
+//! GuestConnect      VmmSpawn
+//! GuestInit         GuestConnect
 //!
-//! Starting (new box):
-//! - Stage 1 (sequential): [Filesystem]
-//! - Stage 2 (parallel):   [ContainerRootfs, GuestRootfs]
-//! - Stage 3 (sequential): [VmmSpawn, GuestConnect, GuestInit]
-//!
-//! Stopped (restart):
-//! - Stage 1 (sequential): [Filesystem]
-//! - Stage 2 (parallel):   [ContainerRootfs, GuestRootfs]
-//! - Stage 3 (sequential): [VmmSpawn, GuestConnect]
+//! Starting (new box) and Stopped (restart) run this graph: each task
+//! starts as soon as the tasks it waits for have finished, so image
+//! pulls and rootfs builds overlap filesystem setup.
 //!
 //! Running (reattach):
 //! - Stage 1 (sequential): [VmmAttach, GuestConnect]
@@ -50,10 +49,10 @@ fn log_task_error(box_id: &BoxID, task_name: &str, err: &BoxliteError) {
     tracing::error!(box_id = %box_id, task = %task_name, "Task failed: {}", err);
 }
 
-pub use container_rootfs::ContainerRootfsTask;
+pub use container_rootfs::{ContainerDiskTask, ContainerRootfsTask};
 pub use filesystem::FilesystemTask;
 pub use guest_connect::GuestConnectTask;
 pub use guest_init::GuestInitTask;
-pub use guest_rootfs::GuestRootfsTask;
+pub use guest_rootfs::{GuestDiskTask, GuestRootfsTask};
 pub use vmm_attach::VmmAttachTask;
 pub use vmm_spawn::VmmSpawnTask;
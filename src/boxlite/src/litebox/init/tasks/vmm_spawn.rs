@@ -14,7 +14,8 @@ use crate::rootfs::guest::{GuestRootfs, Strategy};
 use crate::runtime::constants::{guest_paths, mount_tags};
 use crate::runtime::id::BoxID;
 use crate::runtime::layout::BoxFilesystemLayout;
-use crate::runtime::options::BoxOptions;
+use crate::runtime::options::{BoxOptions, VolumeTuning};
+use crate::runtime::placement::BoxPlacement;
 use crate::runtime::rt_impl::SharedRuntimeImpl;
 use crate::runtime::types::ContainerID;
 use crate::util::find_binary;
@@ -47,6 +48,7 @@ impl PipelineTask<InitCtx> for VmmSpawnTask {
             container_id,
             runtime,
             reuse_rootfs,
+            placement,
         ) = {
             let ctx = ctx.lock().await;
             let layout = ctx
@@ -73,6 +75,7 @@ impl PipelineTask<InitCtx> for VmmSpawnTask {
                 ctx.config.container.id.clone(),
                 ctx.runtime.clone(),
                 ctx.reuse_rootfs,
+                ctx.placement.clone(),
             )
         };
 
@@ -93,7 +96,7 @@ impl PipelineTask<InitCtx> for VmmSpawnTask {
             .inspect_err(|e| log_task_error(&box_id, task_name, e))?;
 
         // Spawn VM
-        let handler = spawn_vm(&box_id, &instance_spec, &options, &layout)
+        let handler = spawn_vm(&box_id, &instance_spec, &options, &layout, placement)
             .await
             .inspect_err(|e| log_task_error(&box_id, task_name, e))?;
 
@@ -150,7 +153,14 @@ async fn build_config(
     let mut volume_mgr = GuestVolumeManager::new();
 
     // SHARED virtiofs - needed by all strategies
-    volume_mgr.add_fs_share(mount_tags::SHARED, layout.shared_dir(), None, false, None);
+    volume_mgr.add_fs_share(
+        mount_tags::SHARED,
+        layout.shared_dir(),
+        None,
+        false,
+        None,
+        VolumeTuning::default(),
+    );
 
     // Add container rootfs disk (COW overlay workflow):
     // 1. Base disk: Pre-built ext4 image with container layers merged
@@ -201,6 +211,7 @@ async fn build_config(
             vol.owner_uid,
             vol.owner_gid,
             vol.subpath.clone(),
+            vol.tuning,
         );
     }
     let container_mounts = container_mgr.build_container_mounts();
@@ -389,6 +400,7 @@ async fn spawn_vm(
     config: &InstanceSpec,
     options: &BoxOptions,
     layout: &BoxFilesystemLayout,
+    placement: Option<BoxPlacement>,
 ) -> BoxliteResult<Box<dyn VmmHandler>> {
     let mut controller = ShimController::new(
         find_binary("boxlite-shim")?,
@@ -396,7 +408,8 @@ async fn spawn_vm(
         box_id.clone(),
         options.clone(),
         layout.clone(),
-    )?;
+    )?
+    .with_placement(placement);
 
     controller.start(config).await
 }
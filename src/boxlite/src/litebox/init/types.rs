@@ -8,8 +8,10 @@ use crate::images::ContainerImageConfig;
 use crate::litebox::config::BoxConfig;
 use crate::portal::GuestSession;
 use crate::portal::interfaces::ContainerRootfsInitConfig;
+use crate::rootfs::guest::GuestRootfs;
 use crate::runtime::layout::BoxFilesystemLayout;
-use crate::runtime::options::VolumeSpec;
+use crate::runtime::options::{VolumeSpec, VolumeTuning};
+use crate::runtime::placement::BoxPlacement;
 use crate::runtime::rt_impl::SharedRuntimeImpl;
 use crate::vmm::controller::VmmHandler;
 use crate::volumes::{ContainerMount, GuestVolumeManager, VolumeShare, classify_volume_share};
@@ -44,6 +46,8 @@ pub struct ResolvedVolume {
     /// For a single-file mount, the file's name (staged and bind-mounted on its
     /// own); `None` for a whole-directory mount.
     pub subpath: Option<String>,
+    /// Sharing performance mode, defaults already applied.
+    pub tuning: VolumeTuning,
 }
 
 pub fn resolve_user_volumes(volumes: &[VolumeSpec]) -> BoxliteResult<Vec<ResolvedVolume>> {
@@ -103,6 +107,7 @@ pub fn resolve_user_volumes(volumes: &[VolumeSpec]) -> BoxliteResult<Vec<Resolve
             read_only = vol.read_only,
             owner_uid,
             owner_gid,
+            tuning = ?vol.effective_tuning(),
             "Resolved user volume"
         );
 
@@ -114,6 +119,7 @@ pub fn resolve_user_volumes(volumes: &[VolumeSpec]) -> BoxliteResult<Vec<Resolve
             owner_uid,
             owner_gid,
             subpath,
+            tuning: vol.effective_tuning(),
         });
     }
 
@@ -293,7 +299,12 @@ pub struct InitPipelineContext {
 
     pub layout: Option<BoxFilesystemLayout>,
     pub container_image_config: Option<ContainerImageConfig>,
+    /// Base rootfs prepared by container_rootfs_prep (fresh start only),
+    /// consumed by container_disk.
+    pub container_rootfs: Option<ContainerRootfsPrepResult>,
     pub container_disk: Option<Disk>,
+    /// Shared bootstrap rootfs resolved by guest_rootfs_init, read by guest_disk.
+    pub guest_rootfs: Option<GuestRootfs>,
     pub guest_disk: Option<Disk>,
     pub volume_mgr: Option<GuestVolumeManager>,
     pub rootfs_init: Option<ContainerRootfsInitConfig>,
@@ -304,6 +315,9 @@ pub struct InitPipelineContext {
     pub network_backend: Option<Box<dyn crate::net::NetworkBackend>>,
     /// MITM CA cert PEM (set by vmm_spawn, read by guest_init for Container.Init gRPC).
     pub ca_cert_pem: Option<String>,
+    /// Host CPU / NUMA placement resolved by the box before the pipeline
+    /// runs, applied by vmm_spawn.
+    pub placement: Option<BoxPlacement>,
 
     #[cfg(target_os = "linux")]
     pub bind_mount: Option<BindMountHandle>,
@@ -325,7 +339,9 @@ impl InitPipelineContext {
             skip_guest_wait,
             layout: None,
             container_image_config: None,
+            container_rootfs: None,
             container_disk: None,
+            guest_rootfs: None,
             guest_disk: None,
             volume_mgr: None,
             rootfs_init: None,
@@ -333,6 +349,7 @@ impl InitPipelineContext {
             guest_session: None,
             network_backend: None,
             ca_cert_pem: None,
+            placement: None,
             #[cfg(target_os = "linux")]
             bind_mount: None,
         }
@@ -351,6 +368,7 @@ mod tests {
             host_path: tmp.path().to_str().unwrap().to_string(),
             guest_path: "/data".to_string(),
             read_only: false,
+            tuning: None,
         }];
 
         let resolved = resolve_user_volumes(&volumes).unwrap();
@@ -373,6 +391,7 @@ mod tests {
             host_path: "/nonexistent/path/12345".to_string(),
             guest_path: "/data".to_string(),
             read_only: false,
+            tuning: None,
         }];
 
         let result = resolve_user_volumes(&volumes);
@@ -389,6 +408,7 @@ mod tests {
             host_path: file_path.to_str().unwrap().to_string(),
             guest_path: "/etc/app.conf".to_string(),
             read_only: true,
+            tuning: None,
         }];
 
         let resolved = resolve_user_volumes(&volumes).unwrap();
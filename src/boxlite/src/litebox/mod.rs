@@ -4,10 +4,12 @@
 
 pub(crate) mod archive;
 pub(crate) mod box_impl;
+pub(crate) mod chunks;
 mod clone_export;
 pub(crate) mod config;
 pub mod copy;
 mod crash_report;
+mod delta;
 mod exec;
 mod init;
 pub(crate) mod local_snapshot;
@@ -17,9 +19,13 @@ mod snapshot;
 pub(crate) mod snapshot_mgr;
 mod state;
 
-pub use copy::CopyOptions;
+pub use copy::{CopyOptions, CopyReader};
 pub(crate) use crash_report::CrashReport;
-pub use exec::{BoxCommand, ExecResult, ExecStderr, ExecStdin, ExecStdout, Execution, ExecutionId};
+pub(crate) use exec::OutputWindow;
+pub use exec::{
+    BoxCommand, ExecOutputBytes, ExecResult, ExecStderr, ExecStdin, ExecStdout, Execution,
+    ExecutionId,
+};
 pub(crate) use manager::BoxManager;
 pub use network::{BoxConnection, BoxTunnel, NetworkHandle};
 pub use snapshot::SnapshotHandle;
@@ -32,7 +38,9 @@ pub(crate) use local_snapshot::LocalSnapshotBackend;
 use std::path::Path;
 use std::sync::Arc;
 
-use crate::metrics::BoxMetrics;
+use tokio::io::{AsyncRead, AsyncWrite};
+
+use crate::metrics::{BoxMetrics, MemoryReclaimResult};
 use crate::runtime::backend::{BoxBackend, BoxNetworkBackend, SnapshotBackend};
 use crate::runtime::options::{BoxArchive, CloneOptions, ExportOptions};
 use crate::{BoxID, BoxInfo};
@@ -104,6 +112,20 @@ impl LiteBox {
         self.box_backend.exec(command).await
     }
 
+    /// Start several commands in one call.
+    ///
+    /// On local boxes every spawn travels in a single guest round trip,
+    /// which is what dominates the start time of short commands. Results
+    /// are in command order; one failed spawn does not affect the others.
+    /// The outer error is for failures that hit the whole batch (box
+    /// stopped, guest unreachable).
+    pub async fn exec_many(
+        &self,
+        commands: Vec<BoxCommand>,
+    ) -> BoxliteResult<Vec<BoxliteResult<Execution>>> {
+        self.box_backend.exec_many(commands).await
+    }
+
     /// Reattach to a running execution by id, returning a fresh
     /// `Execution` handle. The caller discards any previous handle for
     /// the same id. Used after a transient WebSocket drop to resume
@@ -118,6 +140,19 @@ impl LiteBox {
         self.box_backend.metrics().await
     }
 
+    /// Return idle guest memory to the host.
+    ///
+    /// Guest RAM is fixed when the box is created, and the VMM does not
+    /// resize it. Its virtio-balloon device does run with free-page
+    /// reporting, though, so memory the guest frees goes back to the host.
+    /// This has the guest drop clean page cache and compact free memory,
+    /// unless its in-use memory is already at or below `target_bytes`
+    /// (0 always reclaims). For a standing target, see
+    /// [`MemoryReclaimOptions`](crate::MemoryReclaimOptions).
+    pub async fn reclaim_memory(&self, target_bytes: u64) -> BoxliteResult<MemoryReclaimResult> {
+        self.box_backend.reclaim_memory(target_bytes).await
+    }
+
     pub async fn stop(&self) -> BoxliteResult<()> {
         self.box_backend.stop().await
     }
@@ -146,6 +181,32 @@ impl LiteBox {
             .await
     }
 
+    /// Stream an uncompressed tar archive from `tar` into the container
+    /// rootfs at `container_dst`, without staging it on the host.
+    pub async fn copy_into_stream(
+        &self,
+        tar: impl AsyncRead + Send + Unpin + 'static,
+        container_dst: impl AsRef<str>,
+        opts: copy::CopyOptions,
+    ) -> BoxliteResult<()> {
+        self.box_backend
+            .copy_into_stream(Box::new(tar), container_dst.as_ref(), opts)
+            .await
+    }
+
+    /// Stream `container_src` out of the container rootfs as a tar archive
+    /// written to `sink`; the sink's pace throttles the transfer.
+    pub async fn copy_out_stream(
+        &self,
+        container_src: impl AsRef<str>,
+        sink: &mut (impl AsyncWrite + Send + Unpin),
+        opts: copy::CopyOptions,
+    ) -> BoxliteResult<()> {
+        self.box_backend
+            .copy_out_stream(container_src.as_ref(), sink, opts)
+            .await
+    }
+
     /// Get a network handle for raw tunnel operations.
     pub fn network(&self) -> NetworkHandle {
         NetworkHandle::new(Arc::clone(&self.network_backend))
@@ -4,6 +4,7 @@
 
 use crate::ContainerID;
 use crate::lock::LockId;
+use crate::runtime::placement::BoxPlacement;
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 use chrono::{DateTime, Utc};
 use serde::{Deserialize, Serialize};
@@ -54,6 +55,21 @@ pub enum BoxStatus {
 }
 
 impl BoxStatus {
+    /// Number of statuses, for tables indexed by `status as usize`.
+    pub const COUNT: usize = {
+        // Exhaustive on purpose: a new status fails to compile here until
+        // it is counted.
+        match BoxStatus::Unknown {
+            BoxStatus::Unknown
+            | BoxStatus::Configured
+            | BoxStatus::Running
+            | BoxStatus::Stopping
+            | BoxStatus::Stopped
+            | BoxStatus::Paused
+            | BoxStatus::Failed => 7,
+        }
+    };
+
     /// Check if this status represents an active VM (process is running or paused).
     pub fn is_active(&self) -> bool {
         matches!(self, BoxStatus::Running | BoxStatus::Paused)
@@ -217,6 +233,10 @@ pub struct BoxState {
     /// Serde default keeps existing DB rows readable without migration.
     #[serde(default)]
     pub error_reason: Option<String>,
+    /// Host CPUs and NUMA nodes the running VMM is confined to, resolved
+    /// from `AdvancedBoxOptions::placement` at spawn. Cleared with the PID.
+    #[serde(default)]
+    pub placement: Option<BoxPlacement>,
 }
 
 /// Health status of a box.
@@ -315,6 +335,7 @@ impl BoxState {
             lock_id: None,
             health_status: HealthStatus::new(),
             error_reason: None,
+            placement: None,
         }
     }
 
@@ -351,12 +372,21 @@ impl BoxState {
         self.force_status(status);
     }
 
-    /// Set PID and update timestamp.
+    /// Set PID and update timestamp. Clearing the PID clears the placement.
     pub fn set_pid(&mut self, pid: Option<u32>) {
+        if pid.is_none() {
+            self.placement = None;
+        }
         self.pid = pid;
         self.last_updated = Utc::now();
     }
 
+    /// Record the placement the VMM was spawned with.
+    pub fn set_placement(&mut self, placement: Option<BoxPlacement>) {
+        self.placement = placement;
+        self.last_updated = Utc::now();
+    }
+
     /// Mark box as crashed (sets status to Stopped since VM is no longer running).
     ///
     /// In our simplified state model, crashed VMs become Stopped
@@ -365,6 +395,7 @@ impl BoxState {
     pub fn mark_stop(&mut self) {
         self.status = BoxStatus::Stopped;
         self.pid = None;
+        self.placement = None;
         self.last_updated = Utc::now();
     }
 
@@ -380,6 +411,7 @@ impl BoxState {
         self.status = BoxStatus::Failed;
         self.error_reason = Some(reason.to_string());
         self.pid = None;
+        self.placement = None;
         self.last_updated = Utc::now();
     }
 
@@ -392,6 +424,7 @@ impl BoxState {
             self.status = BoxStatus::Stopped;
         }
         self.pid = None;
+        self.placement = None;
         self.last_updated = Utc::now();
     }
 
@@ -442,6 +475,11 @@ mod tests {
         assert!(!BoxStatus::Unknown.is_active());
     }
 
+    #[test]
+    fn test_status_count_covers_every_discriminant() {
+        assert_eq!(BoxStatus::COUNT, BoxStatus::Failed as usize + 1);
+    }
+
     #[test]
     fn test_status_is_configured() {
         assert!(BoxStatus::Configured.is_configured());
@@ -1,7 +1,23 @@
 //! Per-box metrics (individual LiteBox statistics).
 
+use std::sync::Arc;
 use std::sync::atomic::{AtomicU64, Ordering};
 
+use super::{Histogram, HistogramSnapshot};
+
+/// Timing of one box-initialization task, relative to the start of init.
+#[derive(Clone, Debug, PartialEq, Eq)]
+pub struct InitTaskTrace {
+    /// Pipeline task name (e.g. "container_rootfs_prep", "vmm_spawn")
+    pub name: String,
+    /// Offset of the task start from the start of init (milliseconds)
+    pub start_ms: u128,
+    /// Task duration (milliseconds)
+    pub duration_ms: u128,
+    /// Whether the task is on the chain that determined the create duration
+    pub on_critical_path: bool,
+}
+
 /// Storage for per-box metrics.
 ///
 /// Stored in `BoxMetadata`, one instance per box.
@@ -16,6 +32,8 @@ pub struct BoxMetricsStorage {
     pub(crate) bytes_sent: AtomicU64,
     /// Bytes received from this box (via stdout/stderr)
     pub(crate) bytes_received: AtomicU64,
+    /// Exec request to first output chunk or exit status (microseconds)
+    pub(crate) exec_response_latency_us: Arc<Histogram>,
 
     // Timing metrics (set once, never change)
     /// Total time from create() call to LiteBox ready (includes all stages)
@@ -36,6 +54,8 @@ pub struct BoxMetricsStorage {
     pub(crate) stage_box_spawn_ms: Option<u128>,
     /// Time to initialize container inside guest (Stage 6)
     pub(crate) stage_container_init_ms: Option<u128>,
+    /// Per-task init timeline, ordered by start time (set once during initialization)
+    pub(crate) init_trace: Vec<InitTaskTrace>,
 }
 
 impl Clone for BoxMetricsStorage {
@@ -45,6 +65,9 @@ impl Clone for BoxMetricsStorage {
             exec_errors: AtomicU64::new(self.exec_errors.load(Ordering::Relaxed)),
             bytes_sent: AtomicU64::new(self.bytes_sent.load(Ordering::Relaxed)),
             bytes_received: AtomicU64::new(self.bytes_received.load(Ordering::Relaxed)),
+            // Shared rather than copied: a histogram is too large to
+            // snapshot per clone, and clones describe the same box.
+            exec_response_latency_us: self.exec_response_latency_us.clone(),
             total_create_duration_ms: self.total_create_duration_ms,
             guest_boot_duration_ms: self.guest_boot_duration_ms,
             stage_filesystem_setup_ms: self.stage_filesystem_setup_ms,
@@ -53,6 +76,7 @@ impl Clone for BoxMetricsStorage {
             stage_box_config_ms: self.stage_box_config_ms,
             stage_box_spawn_ms: self.stage_box_spawn_ms,
             stage_container_init_ms: self.stage_container_init_ms,
+            init_trace: self.init_trace.clone(),
         }
     }
 }
@@ -69,7 +93,6 @@ impl BoxMetricsStorage {
     }
 
     /// Set guest boot duration (called once after guest is ready).
-    #[allow(dead_code)] // API designed but not yet wired up
     pub(crate) fn set_guest_boot_duration(&mut self, duration_ms: u128) {
         self.guest_boot_duration_ms = Some(duration_ms);
     }
@@ -105,6 +128,11 @@ impl BoxMetricsStorage {
         self.stage_container_init_ms = Some(duration_ms);
     }
 
+    /// Set the per-task init timeline.
+    pub(crate) fn set_init_trace(&mut self, trace: Vec<InitTaskTrace>) {
+        self.init_trace = trace;
+    }
+
     /// Log init stage durations for debugging.
     pub(crate) fn log_init_stages(&self) {
         tracing::debug!(
@@ -117,6 +145,16 @@ impl BoxMetricsStorage {
             stage_container_init_ms = self.stage_container_init_ms.unwrap_or(0),
             "Box initialization stages completed"
         );
+        let critical_path: Vec<&str> = self
+            .init_trace
+            .iter()
+            .filter(|t| t.on_critical_path)
+            .map(|t| t.name.as_str())
+            .collect();
+        tracing::debug!(
+            critical_path = %critical_path.join(" -> "),
+            "Box initialization critical path"
+        );
     }
 
     /// Increment commands executed counter.
@@ -164,6 +202,8 @@ pub struct BoxMetrics {
     pub cpu_percent: Option<f32>,
     /// Memory usage in bytes
     pub memory_bytes: Option<u64>,
+    /// Resident memory of all host processes in the box's sandbox (bytes)
+    pub host_rss_bytes: Option<u64>,
     /// Network bytes sent (host to guest)
     pub network_bytes_sent: Option<u64>,
     /// Network bytes received (guest to host)
@@ -186,6 +226,10 @@ pub struct BoxMetrics {
     pub stage_box_spawn_ms: Option<u128>,
     /// Time to initialize container inside guest (milliseconds)
     pub stage_container_init_ms: Option<u128>,
+    /// Per-task init timeline, ordered by start time
+    pub init_trace: Vec<InitTaskTrace>,
+    /// Exec request to first output chunk or exit status (microseconds)
+    pub exec_response_latency_us: HistogramSnapshot,
 }
 
 impl BoxMetrics {
@@ -208,6 +252,7 @@ impl BoxMetrics {
             guest_boot_duration_ms: storage.guest_boot_duration_ms,
             cpu_percent,
             memory_bytes,
+            host_rss_bytes: None,
             network_bytes_sent,
             network_bytes_received,
             network_tcp_connections,
@@ -218,6 +263,8 @@ impl BoxMetrics {
             stage_box_config_ms: storage.stage_box_config_ms,
             stage_box_spawn_ms: storage.stage_box_spawn_ms,
             stage_container_init_ms: storage.stage_container_init_ms,
+            init_trace: storage.init_trace.clone(),
+            exec_response_latency_us: storage.exec_response_latency_us.snapshot(),
         }
     }
 
@@ -282,6 +329,16 @@ impl BoxMetrics {
         self.memory_bytes
     }
 
+    /// Host resident memory of the whole box, in bytes.
+    ///
+    /// Sums every host process in the box's sandbox (on Linux, its cgroup),
+    /// so it includes the guest RAM the VM has touched and drops as
+    /// free-page reporting returns memory. Falls back to `memory_bytes` when
+    /// there is no sandbox tree. Returns None if the box is not running.
+    pub fn host_rss_bytes(&self) -> Option<u64> {
+        self.host_rss_bytes
+    }
+
     /// Network bytes sent from host to guest.
     ///
     /// Returns None if network backend doesn't support metrics.
@@ -364,4 +421,59 @@ impl BoxMetrics {
     pub fn stage_container_init_ms(&self) -> Option<u128> {
         self.stage_container_init_ms
     }
+
+    /// Per-task initialization timeline, ordered by start time.
+    ///
+    /// Init tasks run as a dependency graph, so several can overlap; the
+    /// entries with `on_critical_path` set are the chain that determined
+    /// `total_create_duration_ms`. Empty for boxes not initialized by this
+    /// process (e.g. REST-backed boxes).
+    pub fn init_trace(&self) -> &[InitTaskTrace] {
+        &self.init_trace
+    }
+
+    /// Distribution of exec response latency in microseconds: from sending
+    /// the exec request until the first output chunk or the exit status
+    /// reaches the host, whichever comes first. Empty for REST boxes.
+    pub fn exec_response_latency_us(&self) -> &HistogramSnapshot {
+        &self.exec_response_latency_us
+    }
+}
+
+/// Guest memory as reported by the guest kernel (`/proc/meminfo`).
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct GuestMemoryStats {
+    /// Guest RAM (bytes)
+    pub total_bytes: u64,
+    /// Unused guest RAM, including pages already returned to the host (bytes)
+    pub free_bytes: u64,
+    /// Estimate of memory available without swapping (bytes)
+    pub available_bytes: u64,
+    /// Page cache (bytes)
+    pub cached_bytes: u64,
+}
+
+impl GuestMemoryStats {
+    /// Memory the guest is holding: total minus free.
+    pub fn in_use_bytes(&self) -> u64 {
+        self.total_bytes.saturating_sub(self.free_bytes)
+    }
+}
+
+/// Outcome of `LiteBox::reclaim_memory`.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq)]
+pub struct MemoryReclaimResult {
+    /// Guest memory before reclaim
+    pub before: GuestMemoryStats,
+    /// Guest memory after reclaim
+    pub after: GuestMemoryStats,
+    /// False when in-use memory was already under the target
+    pub reclaimed: bool,
+}
+
+impl MemoryReclaimResult {
+    /// Bytes the guest freed (0 when nothing was reclaimed).
+    pub fn freed_bytes(&self) -> u64 {
+        self.after.free_bytes.saturating_sub(self.before.free_bytes)
+    }
 }
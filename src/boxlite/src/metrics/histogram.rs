@@ -0,0 +1,195 @@
+//! Lock-free latency histogram.
+//!
+//! Values land in power-of-two ranges, each split into 8 linear
+//! sub-buckets. This is the HdrHistogram layout at one significant digit of
+//! precision: any recorded value is reported within 12.5% across the whole
+//! `u64` range, in a fixed 496 buckets (~4 KiB). Recording is four relaxed
+//! atomic operations, so it is safe on hot paths and from any thread.
+
+use std::sync::atomic::{AtomicU64, Ordering};
+
+const SUB_BUCKET_BITS: u32 = 3;
+const SUB_BUCKETS: usize = 1 << SUB_BUCKET_BITS;
+const BUCKETS: usize = (64 - SUB_BUCKET_BITS as usize + 1) * SUB_BUCKETS;
+
+/// Bucket holding `value`. Values below `SUB_BUCKETS` get one bucket each.
+fn bucket_index(value: u64) -> usize {
+    if value < SUB_BUCKETS as u64 {
+        return value as usize;
+    }
+    let exp = 63 - value.leading_zeros();
+    let sub = (value >> (exp - SUB_BUCKET_BITS)) as usize & (SUB_BUCKETS - 1);
+    (exp - SUB_BUCKET_BITS + 1) as usize * SUB_BUCKETS + sub
+}
+
+/// Largest value that falls into bucket `index`.
+fn bucket_high(index: usize) -> u64 {
+    if index < SUB_BUCKETS {
+        return index as u64;
+    }
+    let exp = (index / SUB_BUCKETS) as u32 + SUB_BUCKET_BITS - 1;
+    let width = 1u64 << (exp - SUB_BUCKET_BITS);
+    let low = (1u64 << exp) + (index % SUB_BUCKETS) as u64 * width;
+    low + (width - 1)
+}
+
+/// Concurrent histogram of `u64` samples (latencies, queue depths).
+///
+/// Monotonic like the counters around it: samples are never removed.
+/// Callers compare snapshots taken over time for windowed figures.
+pub struct Histogram {
+    buckets: Box<[AtomicU64]>,
+    count: AtomicU64,
+    sum: AtomicU64,
+    max: AtomicU64,
+}
+
+impl Histogram {
+    pub fn new() -> Self {
+        Self {
+            buckets: (0..BUCKETS).map(|_| AtomicU64::new(0)).collect(),
+            count: AtomicU64::new(0),
+            sum: AtomicU64::new(0),
+            max: AtomicU64::new(0),
+        }
+    }
+
+    /// Record one sample.
+    pub fn record(&self, value: u64) {
+        self.buckets[bucket_index(value)].fetch_add(1, Ordering::Relaxed);
+        self.count.fetch_add(1, Ordering::Relaxed);
+        self.sum.fetch_add(value, Ordering::Relaxed);
+        self.max.fetch_max(value, Ordering::Relaxed);
+    }
+
+    /// Record a duration in microseconds.
+    pub fn record_micros(&self, elapsed: std::time::Duration) {
+        self.record(elapsed.as_micros().min(u64::MAX as u128) as u64);
+    }
+
+    /// Point-in-time copy. Concurrent recording may make `count` and the
+    /// bucket totals differ by the samples in flight.
+    pub fn snapshot(&self) -> HistogramSnapshot {
+        HistogramSnapshot {
+            buckets: self
+                .buckets
+                .iter()
+                .map(|b| b.load(Ordering::Relaxed))
+                .collect(),
+            count: self.count.load(Ordering::Relaxed),
+            sum: self.sum.load(Ordering::Relaxed),
+            max: self.max.load(Ordering::Relaxed),
+        }
+    }
+}
+
+impl Default for Histogram {
+    fn default() -> Self {
+        Self::new()
+    }
+}
+
+impl std::fmt::Debug for Histogram {
+    fn fmt(&self, f: &mut std::fmt::Formatter<'_>) -> std::fmt::Result {
+        let snapshot = self.snapshot();
+        f.debug_struct("Histogram")
+            .field("count", &snapshot.count)
+            .field("p50", &snapshot.value_at_quantile(0.5))
+            .field("p99", &snapshot.value_at_quantile(0.99))
+            .field("max", &snapshot.max)
+            .finish()
+    }
+}
+
+/// Snapshot of a [`Histogram`].
+#[derive(Clone, Debug, Default)]
+pub struct HistogramSnapshot {
+    buckets: Vec<u64>,
+    /// Number of samples recorded
+    pub count: u64,
+    /// Sum of all samples (wraps on overflow)
+    pub sum: u64,
+    /// Largest sample recorded (0 when empty)
+    pub max: u64,
+}
+
+impl HistogramSnapshot {
+    /// Mean sample value, or 0 when empty.
+    pub fn mean(&self) -> f64 {
+        if self.count == 0 {
+            0.0
+        } else {
+            self.sum as f64 / self.count as f64
+        }
+    }
+
+    /// Smallest value at or above the `quantile` (0.0–1.0) of samples,
+    /// rounded up to its bucket bound and capped at `max`. 0 when empty.
+    pub fn value_at_quantile(&self, quantile: f64) -> u64 {
+        let total: u64 = self.buckets.iter().sum();
+        if total == 0 {
+            return 0;
+        }
+        let rank = ((quantile.clamp(0.0, 1.0) * total as f64).ceil() as u64).max(1);
+        let mut seen = 0;
+        for (index, &n) in self.buckets.iter().enumerate() {
+            seen += n;
+            if seen >= rank {
+                return bucket_high(index).min(self.max);
+            }
+        }
+        self.max
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn buckets_are_contiguous_and_cover_u64() {
+        assert_eq!(bucket_index(0), 0);
+        assert_eq!(bucket_index(7), 7);
+        assert_eq!(bucket_index(u64::MAX), BUCKETS - 1);
+        assert_eq!(bucket_high(BUCKETS - 1), u64::MAX);
+        for index in 1..BUCKETS {
+            let low = bucket_high(index - 1) + 1;
+            assert_eq!(bucket_index(low), index, "low edge of bucket {index}");
+            assert_eq!(
+                bucket_index(bucket_high(index)),
+                index,
+                "high edge of bucket {index}"
+            );
+        }
+    }
+
+    #[test]
+    fn quantiles_stay_within_bucket_precision() {
+        let histogram = Histogram::new();
+        for value in 1..=1000 {
+            histogram.record(value * 1000);
+        }
+        let snapshot = histogram.snapshot();
+        assert_eq!(snapshot.count, 1000);
+        assert_eq!(snapshot.max, 1_000_000);
+        assert!((snapshot.mean() - 500_500.0).abs() < 1e-6);
+
+        for (quantile, exact) in [(0.5, 500_000.0), (0.9, 900_000.0), (0.99, 990_000.0)] {
+            let reported = snapshot.value_at_quantile(quantile) as f64;
+            assert!(
+                reported >= exact && reported <= exact * 1.125,
+                "p{quantile}: {reported} vs {exact}"
+            );
+        }
+        assert_eq!(snapshot.value_at_quantile(1.0), 1_000_000);
+    }
+
+    #[test]
+    fn empty_histogram_reports_zero() {
+        let snapshot = Histogram::new().snapshot();
+        assert_eq!(snapshot.count, 0);
+        assert_eq!(snapshot.value_at_quantile(0.99), 0);
+        assert_eq!(snapshot.mean(), 0.0);
+        assert_eq!(HistogramSnapshot::default().value_at_quantile(0.5), 0);
+    }
+}
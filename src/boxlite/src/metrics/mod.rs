@@ -31,7 +31,13 @@
 //! ```
 
 mod box_metrics;
+mod histogram;
 mod runtime_metrics;
+mod sampler;
 
-pub use box_metrics::{BoxMetrics, BoxMetricsStorage};
+pub use box_metrics::{
+    BoxMetrics, BoxMetricsStorage, GuestMemoryStats, InitTaskTrace, MemoryReclaimResult,
+};
+pub use histogram::{Histogram, HistogramSnapshot};
 pub use runtime_metrics::{RuntimeMetrics, RuntimeMetricsStorage};
+pub use sampler::{BoxMetricsSample, BoxMetricsSampler};
@@ -3,10 +3,13 @@
 use std::sync::Arc;
 use std::sync::atomic::{AtomicU64, Ordering};
 
+use super::histogram::{Histogram, HistogramSnapshot};
+
 /// Storage for runtime-wide metrics.
 ///
 /// Stored in `RuntimeState`, shared across all operations.
-/// All counters are monotonic (never decrease).
+/// All counters are monotonic (never decrease), except the warm pool
+/// gauges `warm_pool_size` and `warm_pool_ready`.
 #[derive(Clone, Default)]
 pub struct RuntimeMetricsStorage {
     /// Total boxes created since runtime startup
@@ -19,6 +22,22 @@ pub struct RuntimeMetricsStorage {
     pub(crate) total_commands: Arc<AtomicU64>,
     /// Total command execution errors across all boxes
     pub(crate) total_exec_errors: Arc<AtomicU64>,
+    /// Configured warm pool size (gauge)
+    pub(crate) warm_pool_size: Arc<AtomicU64>,
+    /// Pre-started boxes currently waiting in the warm pool (gauge)
+    pub(crate) warm_pool_ready: Arc<AtomicU64>,
+    /// Creates served from the warm pool
+    pub(crate) warm_pool_hits: Arc<AtomicU64>,
+    /// Creates the warm pool serves but found empty
+    pub(crate) warm_pool_misses: Arc<AtomicU64>,
+    /// Boxes booted into the warm pool
+    pub(crate) warm_pool_refills: Arc<AtomicU64>,
+    /// Box initialization time, create/start call to ready (microseconds)
+    pub(crate) create_latency_us: Arc<Histogram>,
+    /// VM spawn to guest agent ready (microseconds)
+    pub(crate) boot_latency_us: Arc<Histogram>,
+    /// `exec()` call to process started in the guest (microseconds)
+    pub(crate) exec_start_latency_us: Arc<Histogram>,
 }
 
 impl RuntimeMetricsStorage {
@@ -92,6 +111,61 @@ impl RuntimeMetrics {
     pub fn total_exec_errors(&self) -> u64 {
         self.storage.total_exec_errors.load(Ordering::Relaxed)
     }
+
+    /// Number of pre-started boxes the warm pool tries to keep ready.
+    ///
+    /// 0 when no warm pool is configured.
+    pub fn warm_pool_size(&self) -> u64 {
+        self.storage.warm_pool_size.load(Ordering::Relaxed)
+    }
+
+    /// Number of pre-started boxes currently ready to be claimed.
+    pub fn warm_pool_ready(&self) -> u64 {
+        self.storage.warm_pool_ready.load(Ordering::Relaxed)
+    }
+
+    /// Total `create()` calls served by a pre-started box.
+    ///
+    /// Never decreases (monotonic counter).
+    pub fn warm_pool_hits_total(&self) -> u64 {
+        self.storage.warm_pool_hits.load(Ordering::Relaxed)
+    }
+
+    /// Total `create()` calls matching the warm pool's shape that found it
+    /// empty and booted from scratch.
+    ///
+    /// Never decreases (monotonic counter).
+    pub fn warm_pool_misses_total(&self) -> u64 {
+        self.storage.warm_pool_misses.load(Ordering::Relaxed)
+    }
+
+    /// Total boxes booted into the warm pool. Sampled over time, this gives
+    /// the refill rate.
+    ///
+    /// Never decreases (monotonic counter).
+    pub fn warm_pool_refills_total(&self) -> u64 {
+        self.storage.warm_pool_refills.load(Ordering::Relaxed)
+    }
+
+    /// Distribution of box initialization times in microseconds, from the
+    /// create/start call until the box is ready (cold starts and restarts;
+    /// reattaching to a running box is not counted).
+    pub fn create_latency_us(&self) -> HistogramSnapshot {
+        self.storage.create_latency_us.snapshot()
+    }
+
+    /// Distribution of guest boot times in microseconds, from VM spawn until
+    /// the guest agent answers.
+    pub fn boot_latency_us(&self) -> HistogramSnapshot {
+        self.storage.boot_latency_us.snapshot()
+    }
+
+    /// Distribution of `exec()` start latency in microseconds, from the call
+    /// until the guest reports the process started. Failed execs are not
+    /// counted.
+    pub fn exec_start_latency_us(&self) -> HistogramSnapshot {
+        self.storage.exec_start_latency_us.snapshot()
+    }
 }
 
 #[cfg(test)]
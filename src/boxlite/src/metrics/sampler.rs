@@ -0,0 +1,155 @@
+//! Batched resource sampling across all running boxes.
+//!
+//! [`LiteBox::metrics`](crate::LiteBox::metrics) is one call per box and walks
+//! the box's processes. A [`BoxMetricsSampler`] covers every running box in
+//! one pass instead, reading two counters from each box's jailer cgroup.
+//! CPU percentages are deltas between consecutive samples, so keep one
+//! sampler per subscriber and call [`sample`](BoxMetricsSampler::sample) on
+//! a fixed interval.
+
+use std::collections::HashMap;
+use std::sync::Weak;
+use std::time::Instant;
+
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+
+use crate::runtime::id::BoxID;
+use crate::runtime::rt_impl::RuntimeImpl;
+
+/// Resource usage of one running box at one sample.
+#[derive(Clone, Debug, PartialEq)]
+pub struct BoxMetricsSample {
+    /// Box the sample belongs to.
+    pub box_id: BoxID,
+    /// CPU usage since the previous sample, in percent of one CPU (may
+    /// exceed 100 with several vCPUs). `None` on a box's first sample.
+    pub cpu_percent: Option<f32>,
+    /// Cumulative CPU time of the box's sandbox (microseconds). `None`
+    /// when the box has no cgroup.
+    pub cpu_usage_usec: Option<u64>,
+    /// Host memory charged to the box: its cgroup's charge, or the shim's
+    /// RSS when the box has no cgroup.
+    pub memory_bytes: Option<u64>,
+}
+
+/// Samples every running box of a runtime in one pass.
+///
+/// Holds only a weak reference, so a subscription does not keep the
+/// runtime alive; [`sample`](Self::sample) fails once it is gone.
+pub struct BoxMetricsSampler {
+    runtime: Weak<RuntimeImpl>,
+    /// Last cumulative CPU time per box, for the percentage delta.
+    previous: HashMap<BoxID, (u64, Instant)>,
+    /// Fallback for boxes running without a cgroup (no jailer, cgroup v1).
+    sys: sysinfo::System,
+}
+
+impl BoxMetricsSampler {
+    pub(crate) fn new(runtime: Weak<RuntimeImpl>) -> Self {
+        Self {
+            runtime,
+            previous: HashMap::new(),
+            sys: sysinfo::System::new(),
+        }
+    }
+
+    /// Sample all running boxes. Blocking: one box store read plus two
+    /// small sysfs reads per box; run it on a blocking thread.
+    pub fn sample(&mut self) -> BoxliteResult<Vec<BoxMetricsSample>> {
+        let runtime = self
+            .runtime
+            .upgrade()
+            .ok_or_else(|| BoxliteError::Stopped("Runtime has been dropped".into()))?;
+        let boxes = runtime.box_manager.all_boxes(true)?;
+
+        let mut samples = Vec::new();
+        let mut previous = HashMap::with_capacity(self.previous.len());
+        for (config, state) in boxes {
+            if !state.status.is_running() || runtime.warm_pool.is_member(&config.id) {
+                continue;
+            }
+            let Some(pid) = state.pid else {
+                continue;
+            };
+
+            let sample = match crate::jailer::box_usage(&config.id) {
+                Some(usage) => {
+                    let now = (usage.cpu_usage_usec, Instant::now());
+                    let cpu_percent = self
+                        .previous
+                        .get(&config.id)
+                        .and_then(|&prev| cpu_percent(prev, now));
+                    previous.insert(config.id.clone(), now);
+                    BoxMetricsSample {
+                        box_id: config.id,
+                        cpu_percent,
+                        cpu_usage_usec: Some(usage.cpu_usage_usec),
+                        memory_bytes: usage.memory_bytes,
+                    }
+                }
+                None => self.sample_process(config.id, pid),
+            };
+            samples.push(sample);
+        }
+        // Boxes that stopped since the last sample drop out here.
+        self.previous = previous;
+
+        Ok(samples)
+    }
+
+    /// Per-process fallback, as `LiteBox::metrics` reads a box without a
+    /// cgroup. sysinfo keeps the CPU delta itself.
+    fn sample_process(&mut self, box_id: BoxID, pid: u32) -> BoxMetricsSample {
+        let pid = sysinfo::Pid::from_u32(pid);
+        let process = if self.sys.refresh_process(pid) {
+            self.sys.process(pid)
+        } else {
+            None
+        };
+        BoxMetricsSample {
+            box_id,
+            cpu_percent: process.map(|p| p.cpu_usage()),
+            cpu_usage_usec: None,
+            memory_bytes: process.map(|p| p.memory()),
+        }
+    }
+}
+
+/// CPU percent of one CPU between two `(usage_usec, taken_at)` readings.
+/// `None` if no time passed or the counter went backwards (cgroup recreated
+/// by a restart).
+fn cpu_percent(prev: (u64, Instant), now: (u64, Instant)) -> Option<f32> {
+    let used = now.0.checked_sub(prev.0)?;
+    let elapsed = now.1.checked_duration_since(prev.1)?.as_micros();
+    if elapsed == 0 {
+        return None;
+    }
+    Some((used as f64 * 100.0 / elapsed as f64) as f32)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::time::Duration;
+
+    #[test]
+    fn cpu_percent_is_delta_over_wall_time() {
+        let start = Instant::now();
+        let later = start + Duration::from_secs(2);
+
+        // 3s of CPU over 2s of wall time: one and a half CPUs.
+        assert_eq!(
+            cpu_percent((1_000_000, start), (4_000_000, later)),
+            Some(150.0)
+        );
+        assert_eq!(cpu_percent((5, start), (5, later)), Some(0.0));
+        assert_eq!(cpu_percent((10, start), (5, later)), None);
+        assert_eq!(cpu_percent((0, start), (10, start)), None);
+    }
+
+    #[test]
+    fn sample_fails_once_runtime_is_gone() {
+        let mut sampler = BoxMetricsSampler::new(Weak::new());
+        assert!(matches!(sampler.sample(), Err(BoxliteError::Stopped(_))));
+    }
+}
@@ -0,0 +1,26 @@
+//! Dependency-graph node definition for pipeline execution.
+
+/// A task plus the names of the tasks it must wait for.
+///
+/// In a graph plan there are no stage barriers: each task starts as soon as
+/// every task named in `after` has finished.
+pub struct GraphNode<T> {
+    pub task: T,
+    pub after: Vec<String>,
+}
+
+impl<T> GraphNode<T> {
+    /// Create a node with no dependencies (starts immediately).
+    pub fn new(task: T) -> Self {
+        Self {
+            task,
+            after: Vec::new(),
+        }
+    }
+
+    /// Declare tasks (by name) that must finish before this one starts.
+    pub fn after(mut self, deps: &[&str]) -> Self {
+        self.after.extend(deps.iter().map(|d| d.to_string()));
+        self
+    }
+}
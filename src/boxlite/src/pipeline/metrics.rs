@@ -1,9 +1,21 @@
 use crate::pipeline::ExecutionMode;
+use std::collections::HashMap;
 
 #[derive(Debug, Clone)]
 pub struct TaskMetrics {
     pub name: String,
+    /// Offset of the task start from the pipeline start.
+    pub start_ms: u128,
     pub duration_ms: u128,
+    /// Tasks this one waited for (stage barriers count as dependencies).
+    pub after: Vec<String>,
+}
+
+impl TaskMetrics {
+    /// Offset of the task end from the pipeline start.
+    pub fn end_ms(&self) -> u128 {
+        self.start_ms + self.duration_ms
+    }
 }
 
 #[derive(Debug, Clone)]
@@ -17,15 +29,88 @@ pub struct StageMetrics {
 #[derive(Debug, Clone)]
 pub struct PipelineMetrics {
     pub total_duration_ms: u128,
+    /// Per-stage breakdown (empty for graph plans).
     pub stages: Vec<StageMetrics>,
+    /// Every task that ran, in completion order.
+    pub tasks: Vec<TaskMetrics>,
 }
 
 impl PipelineMetrics {
     pub fn task_duration_ms(&self, name: &str) -> Option<u128> {
-        self.stages
+        self.tasks
             .iter()
-            .flat_map(|stage| stage.tasks.iter())
             .find(|task| task.name == name)
             .map(|task| task.duration_ms)
     }
+
+    /// The chain of tasks that determined the pipeline's duration.
+    ///
+    /// Starts from the task that finished last and walks back through the
+    /// dependency that finished last, so shortening any task not on this
+    /// path would not have made the pipeline faster. Returned in run order.
+    pub fn critical_path(&self) -> Vec<&TaskMetrics> {
+        let by_name: HashMap<&str, &TaskMetrics> =
+            self.tasks.iter().map(|t| (t.name.as_str(), t)).collect();
+
+        let mut path = Vec::new();
+        let mut current = self.tasks.iter().max_by_key(|t| t.end_ms());
+        while let Some(task) = current {
+            path.push(task);
+            current = task
+                .after
+                .iter()
+                .filter_map(|dep| by_name.get(dep.as_str()).copied())
+                .max_by_key(|t| t.end_ms());
+        }
+        path.reverse();
+        path
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn task(name: &str, start_ms: u128, duration_ms: u128, after: &[&str]) -> TaskMetrics {
+        TaskMetrics {
+            name: name.into(),
+            start_ms,
+            duration_ms,
+            after: after.iter().map(|s| s.to_string()).collect(),
+        }
+    }
+
+    #[test]
+    fn critical_path_follows_latest_finishing_dependency() {
+        let metrics = PipelineMetrics {
+            total_duration_ms: 100,
+            stages: Vec::new(),
+            tasks: vec![
+                task("fs", 0, 5, &[]),
+                task("pull", 0, 60, &[]),
+                task("disk", 60, 10, &["fs", "pull"]),
+                task("guest", 0, 20, &[]),
+                task("spawn", 70, 30, &["disk", "guest"]),
+            ],
+        };
+
+        let path: Vec<&str> = metrics
+            .critical_path()
+            .iter()
+            .map(|t| t.name.as_str())
+            .collect();
+        assert_eq!(path, ["pull", "disk", "spawn"]);
+        assert_eq!(metrics.task_duration_ms("disk"), Some(10));
+        assert_eq!(metrics.task_duration_ms("missing"), None);
+    }
+
+    #[test]
+    fn critical_path_of_empty_pipeline_is_empty() {
+        let metrics = PipelineMetrics {
+            total_duration_ms: 0,
+            stages: Vec::new(),
+            tasks: Vec::new(),
+        };
+        assert!(metrics.critical_path().is_empty());
+    }
 }
@@ -3,7 +3,9 @@
 //! This module provides a reusable pipeline infrastructure that supports:
 //! - Table-driven execution plans based on state
 //! - Parallel and sequential task execution modes
+//! - Dependency-graph plans where each task starts once its inputs are ready
 //! - Arbitrary number of stages and tasks
+//! - Per-task timing with a critical-path view ([`PipelineMetrics::critical_path`])
 //!
 //! ## Architecture
 //!
@@ -13,12 +15,16 @@
 //! - Pipeline: Orchestrates execution of all stages
 //! - Stage: Groups related tasks with an execution mode (parallel/sequential)
 //! - Task: Atomic unit of work
+//!
+//! Pipeline → GraphNodes → Tasks
+//!
+//! - GraphNode: A task plus the names of the tasks it waits for (no barriers)
 //! ```
 //!
 //! ## Example
 //!
 //! ```ignore
-//! use pipeline::{ExecutionPlan, PipelineBuilder, PipelineExecutor, Stage};
+//! use pipeline::{ExecutionPlan, GraphNode, PipelineBuilder, PipelineExecutor, Stage};
 //! use std::sync::Arc;
 //! use tokio::sync::Mutex;
 //!
@@ -35,14 +41,22 @@
 //! let pipeline = PipelineBuilder::from_plan(plan);
 //! let metrics = PipelineExecutor::execute(pipeline, ctx).await?;
 //! println!("pipeline took {}ms", metrics.total_duration_ms);
+//!
+//! // Same tasks as a graph: TaskB waits only for TaskA.
+//! let plan = ExecutionPlan::graph(vec![
+//!     GraphNode::new(Box::new(TaskA)),
+//!     GraphNode::new(Box::new(TaskB)).after(&["task_a"]),
+//! ]);
 //! ```
 
+mod graph;
 mod metrics;
 #[allow(clippy::module_inception)]
 mod pipeline;
 mod stage;
 mod task;
 
+pub use graph::GraphNode;
 pub use metrics::{PipelineMetrics, StageMetrics, TaskMetrics};
 pub use pipeline::{ExecutionPlan, Pipeline, PipelineBuilder, PipelineExecutor};
 pub use stage::{ExecutionMode, Stage};
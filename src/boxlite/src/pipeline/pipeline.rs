@@ -1,36 +1,57 @@
 //! Generic pipeline execution framework.
 //!
 //! Provides a table-driven pipeline executor that can run stages containing tasks
-//! in parallel or sequential mode.
+//! in parallel or sequential mode, or a dependency graph of tasks where each
+//! task starts as soon as its inputs are ready.
 
+use super::graph::GraphNode;
 use super::metrics::{PipelineMetrics, StageMetrics, TaskMetrics};
 use super::stage::{ExecutionMode, Stage};
 use super::task::BoxedTask;
-use boxlite_shared::errors::BoxliteResult;
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+use futures::StreamExt;
 use futures::future::try_join_all;
+use futures::stream::FuturesUnordered;
+use std::collections::{HashMap, HashSet};
 use std::time::Instant;
 
+enum Schedule<Ctx> {
+    /// Stages run in order with a barrier between them.
+    Stages(Vec<Stage<BoxedTask<Ctx>>>),
+    /// Tasks run as soon as their declared dependencies finish.
+    Graph(Vec<GraphNode<BoxedTask<Ctx>>>),
+}
+
 pub struct ExecutionPlan<Ctx> {
-    stages: Vec<Stage<BoxedTask<Ctx>>>,
+    schedule: Schedule<Ctx>,
 }
 
 impl<Ctx> ExecutionPlan<Ctx> {
     pub fn new(stages: Vec<Stage<BoxedTask<Ctx>>>) -> Self {
-        Self { stages }
+        Self {
+            schedule: Schedule::Stages(stages),
+        }
     }
 
-    pub fn stages(self) -> Vec<Stage<BoxedTask<Ctx>>> {
-        self.stages
+    /// Plan from a dependency graph. Task names must be unique and every
+    /// dependency must name a task in the plan; cycles are rejected when the
+    /// pipeline executes.
+    pub fn graph(nodes: Vec<GraphNode<BoxedTask<Ctx>>>) -> Self {
+        Self {
+            schedule: Schedule::Graph(nodes),
+        }
     }
 }
 
 pub struct Pipeline<Ctx> {
-    stages: Vec<Stage<BoxedTask<Ctx>>>,
+    schedule: Schedule<Ctx>,
 }
 
 impl<Ctx> Pipeline<Ctx> {
     pub fn new(stages: Vec<Stage<BoxedTask<Ctx>>>) -> Self {
-        Self { stages }
+        Self {
+            schedule: Schedule::Stages(stages),
+        }
     }
 }
 
@@ -38,7 +59,9 @@ pub struct PipelineBuilder;
 
 impl PipelineBuilder {
     pub fn from_plan<Ctx>(plan: ExecutionPlan<Ctx>) -> Pipeline<Ctx> {
-        Pipeline::new(plan.stages())
+        Pipeline {
+            schedule: plan.schedule,
+        }
     }
 }
 
@@ -51,53 +74,63 @@ pub struct PipelineExecutor;
 impl PipelineExecutor {
     /// Execute a pipeline.
     ///
-    /// This is the core pipeline execution loop. It iterates through stages
-    /// and executes their tasks according to the stage's execution mode.
+    /// Stage plans iterate through stages and execute their tasks according
+    /// to the stage's execution mode. Graph plans start every task whose
+    /// dependencies have finished, so independent chains overlap. Either way
+    /// the first task error aborts the pipeline and drops in-flight tasks.
     ///
     /// Generic over:
     /// - `Ctx`: Shared pipeline context (use interior mutability for writes)
     pub async fn execute<Ctx>(pipeline: Pipeline<Ctx>, ctx: Ctx) -> BoxliteResult<PipelineMetrics>
+    where
+        Ctx: Clone,
+    {
+        match pipeline.schedule {
+            Schedule::Stages(stages) => Self::execute_stages(stages, ctx).await,
+            Schedule::Graph(nodes) => Self::execute_graph(nodes, ctx).await,
+        }
+    }
+
+    async fn execute_stages<Ctx>(
+        stages: Vec<Stage<BoxedTask<Ctx>>>,
+        ctx: Ctx,
+    ) -> BoxliteResult<PipelineMetrics>
     where
         Ctx: Clone,
     {
         let total_start = Instant::now();
         let mut stage_metrics = Vec::new();
+        // Names of the tasks the next stage waits for.
+        let mut barrier: Vec<String> = Vec::new();
 
-        for (index, stage) in pipeline.stages.into_iter().enumerate() {
+        for (index, stage) in stages.into_iter().enumerate() {
             let execution = stage.execution;
             let stage_start = Instant::now();
 
             let task_metrics = match execution {
                 ExecutionMode::Parallel => {
-                    let futures = stage.tasks.into_iter().map(|task| {
-                        let ctx = ctx.clone();
-                        async move {
-                            let name = task.name().to_string();
-                            let task_start = Instant::now();
-                            task.run(ctx).await?;
-                            Ok::<TaskMetrics, boxlite_shared::errors::BoxliteError>(TaskMetrics {
-                                name,
-                                duration_ms: task_start.elapsed().as_millis(),
-                            })
-                        }
-                    });
+                    let futures = stage
+                        .tasks
+                        .into_iter()
+                        .map(|task| run_task(task, ctx.clone(), barrier.clone(), total_start));
                     try_join_all(futures).await?
                 }
                 ExecutionMode::Sequential => {
-                    let mut task_metrics = Vec::new();
+                    let mut task_metrics: Vec<TaskMetrics> = Vec::new();
                     for task in stage.tasks {
-                        let name = task.name().to_string();
-                        let task_start = Instant::now();
-                        task.run(ctx.clone()).await?;
-                        task_metrics.push(TaskMetrics {
-                            name,
-                            duration_ms: task_start.elapsed().as_millis(),
-                        });
+                        let after = match task_metrics.last() {
+                            Some(prev) => vec![prev.name.clone()],
+                            None => barrier.clone(),
+                        };
+                        task_metrics.push(run_task(task, ctx.clone(), after, total_start).await?);
                     }
                     task_metrics
                 }
             };
 
+            if !task_metrics.is_empty() {
+                barrier = task_metrics.iter().map(|t| t.name.clone()).collect();
+            }
             stage_metrics.push(StageMetrics {
                 index,
                 execution,
@@ -106,9 +139,316 @@ impl PipelineExecutor {
             });
         }
 
+        let tasks = stage_metrics
+            .iter()
+            .flat_map(|stage| stage.tasks.iter().cloned())
+            .collect();
         Ok(PipelineMetrics {
             total_duration_ms: total_start.elapsed().as_millis(),
             stages: stage_metrics,
+            tasks,
+        })
+    }
+
+    async fn execute_graph<Ctx>(
+        nodes: Vec<GraphNode<BoxedTask<Ctx>>>,
+        ctx: Ctx,
+    ) -> BoxliteResult<PipelineMetrics>
+    where
+        Ctx: Clone,
+    {
+        let total_start = Instant::now();
+        let deps = resolve_dependencies(&nodes)?;
+
+        let mut dependents = vec![Vec::new(); nodes.len()];
+        let mut waiting: Vec<usize> = deps.iter().map(Vec::len).collect();
+        for (index, node_deps) in deps.iter().enumerate() {
+            for &dep in node_deps {
+                dependents[dep].push(index);
+            }
+        }
+
+        let mut pending: Vec<Option<GraphNode<BoxedTask<Ctx>>>> =
+            nodes.into_iter().map(Some).collect();
+        let mut ready: Vec<usize> = (0..pending.len()).filter(|&i| waiting[i] == 0).collect();
+        let mut running = FuturesUnordered::new();
+        let mut tasks = Vec::with_capacity(pending.len());
+
+        loop {
+            for index in ready.drain(..) {
+                let Some(node) = pending[index].take() else {
+                    continue;
+                };
+                let ctx = ctx.clone();
+                running.push(async move {
+                    run_task(node.task, ctx, node.after, total_start)
+                        .await
+                        .map(|metrics| (index, metrics))
+                });
+            }
+            let Some(finished) = running.next().await else {
+                break;
+            };
+            let (index, metrics) = finished?;
+            for &next in &dependents[index] {
+                waiting[next] -= 1;
+                if waiting[next] == 0 {
+                    ready.push(next);
+                }
+            }
+            tasks.push(metrics);
+        }
+
+        Ok(PipelineMetrics {
+            total_duration_ms: total_start.elapsed().as_millis(),
+            stages: Vec::new(),
+            tasks,
         })
     }
 }
+
+async fn run_task<Ctx>(
+    task: BoxedTask<Ctx>,
+    ctx: Ctx,
+    after: Vec<String>,
+    origin: Instant,
+) -> BoxliteResult<TaskMetrics> {
+    let name = task.name().to_string();
+    let task_start = Instant::now();
+    task.run(ctx).await?;
+    Ok(TaskMetrics {
+        name,
+        start_ms: task_start.duration_since(origin).as_millis(),
+        duration_ms: task_start.elapsed().as_millis(),
+        after,
+    })
+}
+
+/// Map each node's dependency names to node indices, rejecting duplicate
+/// task names, unknown dependencies and cycles before anything runs.
+fn resolve_dependencies<T>(nodes: &[GraphNode<BoxedTask<T>>]) -> BoxliteResult<Vec<Vec<usize>>> {
+    let mut index_of = HashMap::new();
+    for (index, node) in nodes.iter().enumerate() {
+        let name = node.task.name();
+        if index_of.insert(name, index).is_some() {
+            return Err(BoxliteError::Internal(format!(
+                "pipeline task '{}' is declared twice",
+                name
+            )));
+        }
+    }
+
+    let mut deps = Vec::with_capacity(nodes.len());
+    for node in nodes {
+        let mut seen = HashSet::new();
+        let mut node_deps = Vec::new();
+        for dep in &node.after {
+            let index = *index_of.get(dep.as_str()).ok_or_else(|| {
+                BoxliteError::Internal(format!(
+                    "pipeline task '{}' depends on unknown task '{}'",
+                    node.task.name(),
+                    dep
+                ))
+            })?;
+            if seen.insert(index) {
+                node_deps.push(index);
+            }
+        }
+        deps.push(node_deps);
+    }
+
+    // Kahn's algorithm: anything never released is part of a cycle.
+    let mut waiting: Vec<usize> = deps.iter().map(Vec::len).collect();
+    let mut ready: Vec<usize> = (0..nodes.len()).filter(|&i| waiting[i] == 0).collect();
+    let mut released = 0;
+    while let Some(index) = ready.pop() {
+        released += 1;
+        for (next, node_deps) in deps.iter().enumerate() {
+            if node_deps.contains(&index) {
+                waiting[next] -= 1;
+                if waiting[next] == 0 {
+                    ready.push(next);
+                }
+            }
+        }
+    }
+    if released < nodes.len() {
+        let stuck: Vec<&str> = (0..nodes.len())
+            .filter(|&i| waiting[i] > 0)
+            .map(|i| nodes[i].task.name())
+            .collect();
+        return Err(BoxliteError::Internal(format!(
+            "pipeline has a dependency cycle among: {}",
+            stuck.join(", ")
+        )));
+    }
+
+    Ok(deps)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::pipeline::PipelineTask;
+    use async_trait::async_trait;
+    use std::sync::{Arc, Mutex};
+    use std::time::Duration;
+    use tokio::sync::Notify;
+
+    #[derive(Clone, Default)]
+    struct TestCtx {
+        log: Arc<Mutex<Vec<String>>>,
+        /// Signalled by the task named "signal".
+        signal: Arc<Notify>,
+    }
+
+    impl TestCtx {
+        fn events(&self) -> Vec<String> {
+            self.log.lock().unwrap().clone()
+        }
+    }
+
+    enum Behavior {
+        Done,
+        Fail,
+        /// Notify `TestCtx::signal` before finishing.
+        Signal,
+        /// Finish only once `TestCtx::signal` fires.
+        WaitForSignal,
+    }
+
+    struct TestTask {
+        name: &'static str,
+        behavior: Behavior,
+    }
+
+    fn task(name: &'static str, behavior: Behavior) -> BoxedTask<TestCtx> {
+        Box::new(TestTask { name, behavior })
+    }
+
+    #[async_trait]
+    impl PipelineTask<TestCtx> for TestTask {
+        async fn run(self: Box<Self>, ctx: TestCtx) -> BoxliteResult<()> {
+            ctx.log.lock().unwrap().push(format!("start:{}", self.name));
+            match self.behavior {
+                Behavior::Done => {}
+                Behavior::Fail => return Err(BoxliteError::Internal("boom".into())),
+                Behavior::Signal => ctx.signal.notify_one(),
+                Behavior::WaitForSignal => ctx.signal.notified().await,
+            }
+            ctx.log.lock().unwrap().push(format!("end:{}", self.name));
+            Ok(())
+        }
+
+        fn name(&self) -> &str {
+            self.name
+        }
+    }
+
+    async fn run(plan: ExecutionPlan<TestCtx>, ctx: &TestCtx) -> BoxliteResult<PipelineMetrics> {
+        let pipeline = PipelineBuilder::from_plan(plan);
+        tokio::time::timeout(
+            Duration::from_secs(5),
+            PipelineExecutor::execute(pipeline, ctx.clone()),
+        )
+        .await
+        .expect("pipeline deadlocked")
+    }
+
+    fn position(events: &[String], event: &str) -> usize {
+        events
+            .iter()
+            .position(|e| e == event)
+            .unwrap_or_else(|| panic!("{event} missing from {events:?}"))
+    }
+
+    #[tokio::test]
+    async fn graph_starts_tasks_as_soon_as_inputs_are_ready() {
+        // "slow" cannot finish until "signal" runs, and "signal" only waits
+        // for "fast", so a stage barrier after "slow" would deadlock.
+        let plan = ExecutionPlan::graph(vec![
+            GraphNode::new(task("slow", Behavior::WaitForSignal)),
+            GraphNode::new(task("fast", Behavior::Done)),
+            GraphNode::new(task("signal", Behavior::Signal)).after(&["fast"]),
+            GraphNode::new(task("join", Behavior::Done)).after(&["slow", "signal"]),
+        ]);
+        let ctx = TestCtx::default();
+        let metrics = run(plan, &ctx).await.unwrap();
+
+        let events = ctx.events();
+        assert!(position(&events, "end:fast") < position(&events, "start:signal"));
+        assert!(position(&events, "end:slow") < position(&events, "start:join"));
+        assert!(position(&events, "end:signal") < position(&events, "start:join"));
+        assert_eq!(metrics.tasks.len(), 4);
+        assert!(metrics.stages.is_empty());
+        assert_eq!(metrics.tasks.last().unwrap().name, "join");
+        assert_eq!(metrics.critical_path().last().unwrap().name, "join");
+    }
+
+    #[tokio::test]
+    async fn graph_rejects_unknown_dependency_duplicate_name_and_cycle() {
+        let ctx = TestCtx::default();
+
+        let unknown = ExecutionPlan::graph(vec![
+            GraphNode::new(task("a", Behavior::Done)).after(&["missing"]),
+        ]);
+        let err = run(unknown, &ctx).await.unwrap_err();
+        assert!(err.to_string().contains("unknown task 'missing'"), "{err}");
+
+        let duplicate = ExecutionPlan::graph(vec![
+            GraphNode::new(task("a", Behavior::Done)),
+            GraphNode::new(task("a", Behavior::Done)),
+        ]);
+        let err = run(duplicate, &ctx).await.unwrap_err();
+        assert!(err.to_string().contains("declared twice"), "{err}");
+
+        let cycle = ExecutionPlan::graph(vec![
+            GraphNode::new(task("root", Behavior::Done)),
+            GraphNode::new(task("a", Behavior::Done)).after(&["root", "b"]),
+            GraphNode::new(task("b", Behavior::Done)).after(&["a"]),
+        ]);
+        let err = run(cycle, &ctx).await.unwrap_err();
+        assert!(err.to_string().contains("cycle among: a, b"), "{err}");
+
+        assert!(
+            ctx.events().is_empty(),
+            "no task may run for an invalid plan"
+        );
+    }
+
+    #[tokio::test]
+    async fn graph_stops_at_first_error() {
+        let plan = ExecutionPlan::graph(vec![
+            GraphNode::new(task("fail", Behavior::Fail)),
+            GraphNode::new(task("next", Behavior::Done)).after(&["fail"]),
+        ]);
+        let ctx = TestCtx::default();
+        assert!(run(plan, &ctx).await.is_err());
+        assert_eq!(ctx.events(), ["start:fail"]);
+    }
+
+    #[tokio::test]
+    async fn stages_record_barriers_as_dependencies() {
+        let plan = ExecutionPlan::new(vec![
+            Stage::parallel(vec![task("a", Behavior::Done), task("b", Behavior::Done)]),
+            Stage::sequential(vec![task("c", Behavior::Done), task("d", Behavior::Done)]),
+        ]);
+        let ctx = TestCtx::default();
+        let metrics = run(plan, &ctx).await.unwrap();
+
+        assert_eq!(metrics.stages.len(), 2);
+        let after = |name: &str| {
+            metrics
+                .tasks
+                .iter()
+                .find(|t| t.name == name)
+                .unwrap()
+                .after
+                .clone()
+        };
+        assert!(after("a").is_empty());
+        assert_eq!(after("c"), ["a", "b"]);
+        assert_eq!(after("d"), ["c"]);
+        assert_eq!(metrics.critical_path().last().unwrap().name, "d");
+    }
+}
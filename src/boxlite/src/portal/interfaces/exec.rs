@@ -3,11 +3,17 @@
 //! High-level API for execution operations (unary Exec + output-only Attach +
 //! blocking Wait).
 
-use crate::litebox::{BoxCommand, ExecResult};
+use std::sync::Arc;
+use std::sync::atomic::{AtomicBool, Ordering};
+use std::time::Instant;
+
+use crate::litebox::{BoxCommand, ExecResult, OutputWindow};
+use crate::metrics::Histogram;
 use boxlite_shared::{
-    AttachRequest, BoxliteError, BoxliteResult, ExecOutput, ExecRequest, ExecStdin,
-    ExecutionClient, KillRequest, WaitRequest, WaitResponse, exec_output,
+    AttachRequest, BoxliteError, BoxliteResult, ExecBatchRequest, ExecOutput, ExecRequest,
+    ExecResponse, ExecStdin, ExecutionClient, KillRequest, WaitRequest, WaitResponse, exec_output,
 };
+use bytes::Bytes;
 use tokio::sync::mpsc;
 use tokio_stream::wrappers::ReceiverStream;
 use tokio_util::sync::CancellationToken;
@@ -23,8 +29,10 @@ pub struct ExecutionInterface {
 pub struct ExecComponents {
     pub execution_id: String,
     pub stdin_tx: mpsc::UnboundedSender<Vec<u8>>,
-    pub stdout_rx: mpsc::UnboundedReceiver<String>,
-    pub stderr_rx: mpsc::UnboundedReceiver<String>,
+    pub stdout_rx: mpsc::UnboundedReceiver<Bytes>,
+    pub stderr_rx: mpsc::UnboundedReceiver<Bytes>,
+    pub stdout_window: Option<OutputWindow>,
+    pub stderr_window: Option<OutputWindow>,
     pub result_rx: mpsc::UnboundedReceiver<ExecResult>,
 }
 
@@ -41,24 +49,98 @@ impl ExecutionInterface {
     /// # Arguments
     /// * `command` - The command to execute
     /// * `shutdown_token` - Cancellation token to abort background tasks on shutdown
+    /// * `response_latency` - Records request-to-first-output-or-exit time
     pub async fn exec(
         &mut self,
         command: BoxCommand,
         shutdown_token: CancellationToken,
+        response_latency: Arc<Histogram>,
     ) -> BoxliteResult<ExecComponents> {
-        // Create channels
-        let (stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
-        let (stdout_tx, stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, stderr_rx) = mpsc::unbounded_channel::<String>();
-        let (result_tx, result_rx) = mpsc::unbounded_channel();
-
         // Build request
         let request = ExecProtocol::build_exec_request(&command);
 
         tracing::debug!(command = %command.command, "exec RPC: sending request");
 
         // Start execution
+        let sent = Instant::now();
         let exec_response = self.client.exec(request).await?.into_inner();
+        self.start_streams(
+            exec_response,
+            command.output_window,
+            FirstResponse::new(sent, response_latency),
+            shutdown_token,
+        )
+    }
+
+    /// Execute several commands with a single `ExecBatch` round trip.
+    ///
+    /// Results are in command order; a command the guest fails to spawn
+    /// does not affect the others. Guests without `ExecBatch` get one
+    /// `Exec` per command instead.
+    pub async fn exec_batch(
+        &mut self,
+        commands: &[BoxCommand],
+        shutdown_token: CancellationToken,
+        response_latency: Arc<Histogram>,
+    ) -> BoxliteResult<Vec<BoxliteResult<ExecComponents>>> {
+        let request = ExecBatchRequest {
+            requests: commands
+                .iter()
+                .map(ExecProtocol::build_exec_request)
+                .collect(),
+        };
+
+        tracing::debug!(count = commands.len(), "exec_batch RPC: sending request");
+
+        let sent = Instant::now();
+        let responses = match self.client.exec_batch(request).await {
+            Ok(response) => response.into_inner().responses,
+            Err(status) if status.code() == tonic::Code::Unimplemented => {
+                let mut results = Vec::with_capacity(commands.len());
+                for command in commands {
+                    results.push(
+                        self.exec(
+                            command.clone(),
+                            shutdown_token.clone(),
+                            response_latency.clone(),
+                        )
+                        .await,
+                    );
+                }
+                return Ok(results);
+            }
+            Err(status) => return Err(status.into()),
+        };
+        if responses.len() != commands.len() {
+            return Err(BoxliteError::Internal(format!(
+                "exec_batch: guest answered {} of {} commands",
+                responses.len(),
+                commands.len()
+            )));
+        }
+
+        Ok(responses
+            .into_iter()
+            .zip(commands)
+            .map(|(exec_response, command)| {
+                self.start_streams(
+                    exec_response,
+                    command.output_window,
+                    FirstResponse::new(sent, response_latency.clone()),
+                    shutdown_token.clone(),
+                )
+            })
+            .collect())
+    }
+
+    /// Wire stdin/attach/wait streams for a started execution.
+    fn start_streams(
+        &self,
+        exec_response: ExecResponse,
+        output_window: Option<usize>,
+        first: Arc<FirstResponse>,
+        shutdown_token: CancellationToken,
+    ) -> BoxliteResult<ExecComponents> {
         if let Some(err) = exec_response.error {
             return Err(BoxliteError::Internal(format!(
                 "{}: {}",
@@ -66,6 +148,14 @@ impl ExecutionInterface {
             )));
         }
 
+        // Create channels
+        let (stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
+        let (stdout_tx, stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, stderr_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (result_tx, result_rx) = mpsc::unbounded_channel();
+        let stdout_window = output_window.map(OutputWindow::new);
+        let stderr_window = output_window.map(OutputWindow::new);
+
         let execution_id = exec_response.execution_id.clone();
 
         tracing::debug!(execution_id = %execution_id, "spawning background streams");
@@ -82,8 +172,9 @@ impl ExecutionInterface {
         ExecProtocol::spawn_attach(
             self.client.clone(),
             execution_id.clone(),
-            stdout_tx,
-            stderr_tx,
+            OutputSink::new(stdout_tx, stdout_window.clone()),
+            OutputSink::new(stderr_tx, stderr_window.clone()),
+            first.clone(),
             shutdown_token.clone(),
         );
 
@@ -92,6 +183,7 @@ impl ExecutionInterface {
             self.client.clone(),
             execution_id.clone(),
             result_tx,
+            first,
             shutdown_token,
         );
 
@@ -100,6 +192,8 @@ impl ExecutionInterface {
             stdin_tx,
             stdout_rx,
             stderr_rx,
+            stdout_window,
+            stderr_window,
             result_rx,
         })
     }
@@ -200,6 +294,59 @@ impl crate::runtime::backend::ExecBackend for ExecutionInterface {
 // Helper: Protocol wiring
 // ============================================================================
 
+/// Records, once, the time from an exec request to the first output
+/// chunk or exit status the host receives for it.
+struct FirstResponse {
+    sent: Instant,
+    latency: Arc<Histogram>,
+    seen: AtomicBool,
+}
+
+impl FirstResponse {
+    fn new(sent: Instant, latency: Arc<Histogram>) -> Arc<Self> {
+        Arc::new(Self {
+            sent,
+            latency,
+            seen: AtomicBool::new(false),
+        })
+    }
+
+    fn mark(&self) {
+        if !self.seen.swap(true, Ordering::Relaxed) {
+            self.latency.record_micros(self.sent.elapsed());
+        }
+    }
+}
+
+/// Host end of one output stream: the channel the stream reads from and
+/// the window, if any, that bounds how much may queue unread on it.
+struct OutputSink {
+    tx: mpsc::UnboundedSender<Bytes>,
+    window: Option<OutputWindow>,
+}
+
+impl OutputSink {
+    fn new(tx: mpsc::UnboundedSender<Bytes>, window: Option<OutputWindow>) -> Self {
+        Self { tx, window }
+    }
+
+    async fn send(&self, data: Bytes) {
+        if let Some(window) = &self.window {
+            window.reserve(data.len()).await;
+        }
+        let _ = self.tx.send(data);
+    }
+
+    /// Report a transport failure in-band. Bypasses the window: it is the
+    /// last thing the stream sees.
+    fn send_error(&self, message: String) {
+        let _ = self.tx.send(message.into());
+    }
+}
+
+/// Upper bound for one stdin frame when queued writes are merged.
+const STDIN_FRAME_BYTES: usize = 64 * 1024;
+
 struct ExecProtocol;
 
 impl ExecProtocol {
@@ -253,8 +400,9 @@ impl ExecProtocol {
     fn spawn_attach(
         mut client: ExecutionClient<Channel>,
         execution_id: String,
-        stdout_tx: mpsc::UnboundedSender<String>,
-        stderr_tx: mpsc::UnboundedSender<String>,
+        stdout: OutputSink,
+        stderr: OutputSink,
+        first: Arc<FirstResponse>,
         shutdown_token: CancellationToken,
     ) {
         tokio::spawn(async move {
@@ -277,16 +425,9 @@ impl ExecProtocol {
                     tracing::debug!(execution_id = %execution_id, "attach stream connected");
                     let mut stream = response.into_inner();
                     let mut message_count = 0u64;
-                    // Per-stream UTF-8 decoder state. The gRPC layer chunks the
-                    // PTY's byte stream at arbitrary offsets, which can land
-                    // mid-codepoint for any multi-byte char (e.g. `─` is 3
-                    // bytes, `👋` is 4). Decoding each chunk independently with
-                    // `from_utf8_lossy` substitutes U+FFFD on both sides of the
-                    // cut, doubling visible columns and desyncing TUI cursor
-                    // math (see https://github.com/.../issues/...). Holding
-                    // the trailing partial across chunks fixes this.
-                    let mut stdout = DecodedStream::new(stdout_tx);
-                    let mut stderr = DecodedStream::new(stderr_tx);
+                    // Chunks are forwarded as raw `Bytes`; UTF-8 decoding
+                    // (with split-codepoint carry-over) happens in
+                    // `ExecStdout`/`ExecStderr` only for text consumers.
 
                     loop {
                         // Use select! to handle cancellation while streaming
@@ -298,8 +439,6 @@ impl ExecProtocol {
                                     message_count,
                                     "Attach stream cancelled during shutdown"
                                 );
-                                stdout.flush();
-                                stderr.flush();
                                 break;
                             }
                             msg = stream.message() => msg,
@@ -307,8 +446,15 @@ impl ExecProtocol {
 
                         match output.transpose() {
                             Some(Ok(output)) => {
+                                first.mark();
                                 message_count += 1;
-                                Self::route_output(output, &mut stdout, &mut stderr);
+                                // Waits while the target stream's window is
+                                // full, which stops reading from the guest.
+                                tokio::select! {
+                                    biased;
+                                    _ = shutdown_token.cancelled() => break,
+                                    _ = Self::route_output(output, &stdout, &stderr) => {}
+                                }
                             }
                             Some(Err(e)) => {
                                 tracing::debug!(
@@ -317,24 +463,10 @@ impl ExecProtocol {
                                     message_count,
                                     "Attach stream error, breaking"
                                 );
-                                // Flush before pushing the error message so
-                                // the held-over partial bytes (as U+FFFD)
-                                // arrive in correct order ahead of the
-                                // synthesized "Attach stream error: …" line.
-                                stdout.flush();
-                                stderr.flush();
-                                let _ = stderr.tx.send(format!("Attach stream error: {}", e));
-                                break;
-                            }
-                            None => {
-                                // Stream ended normally — flush any partial
-                                // bytes still in the decoders as U+FFFD,
-                                // matching `from_utf8_lossy` semantics for
-                                // a truncated input at EOF.
-                                stdout.flush();
-                                stderr.flush();
+                                stderr.send_error(format!("Attach stream error: {}", e));
                                 break;
                             }
+                            None => break,
                         }
                     }
 
@@ -346,21 +478,21 @@ impl ExecProtocol {
                 }
                 Err(e) => {
                     tracing::debug!(execution_id = %execution_id, error = %e, "Attach failed");
-                    let _ = stderr_tx.send(format!("Attach failed: {}", e));
+                    stderr.send_error(format!("Attach failed: {}", e));
                 }
             }
         });
     }
 
-    fn route_output(output: ExecOutput, stdout: &mut DecodedStream, stderr: &mut DecodedStream) {
+    async fn route_output(output: ExecOutput, stdout: &OutputSink, stderr: &OutputSink) {
         match output.event {
             Some(exec_output::Event::Stdout(chunk)) => {
                 tracing::trace!(len = chunk.data.len(), "Received exec stdout");
-                stdout.send_bytes(chunk.data);
+                stdout.send(chunk.data).await;
             }
             Some(exec_output::Event::Stderr(chunk)) => {
                 tracing::trace!(len = chunk.data.len(), "Received exec stderr");
-                stderr.send_bytes(chunk.data);
+                stderr.send(chunk.data).await;
             }
             None => {}
         }
@@ -370,6 +502,7 @@ impl ExecProtocol {
         mut client: ExecutionClient<Channel>,
         execution_id: String,
         result_tx: mpsc::UnboundedSender<ExecResult>,
+        first: Arc<FirstResponse>,
         shutdown_token: CancellationToken,
     ) {
         tokio::spawn(async move {
@@ -394,6 +527,7 @@ impl ExecProtocol {
 
             match result {
                 Ok(resp) => {
+                    first.mark();
                     let mapped = Self::map_wait_response(resp.into_inner());
                     let _ = result_tx.send(mapped);
                 }
@@ -425,7 +559,15 @@ impl ExecProtocol {
             // Producer: forward stdin channel into tonic stream
             let exec_id_clone = execution_id.clone();
             tokio::spawn(async move {
-                while let Some(data) = stdin_rx.recv().await {
+                while let Some(mut data) = stdin_rx.recv().await {
+                    // Fold writes already queued behind this one into the
+                    // same frame instead of sending one frame per write.
+                    while data.len() < STDIN_FRAME_BYTES {
+                        match stdin_rx.try_recv() {
+                            Ok(more) => data.extend_from_slice(&more),
+                            Err(_) => break,
+                        }
+                    }
                     let msg = ExecStdin {
                         execution_id: exec_id_clone.clone(),
                         data,
@@ -486,7 +628,7 @@ impl ExecProtocol {
 /// `flush()` returns U+FFFD for any bytes still held when the stream ends —
 /// matches `from_utf8_lossy` semantics for a truncated tail.
 #[derive(Default)]
-struct Utf8StreamDecoder {
+pub(crate) struct Utf8StreamDecoder {
     /// 1-3 trailing bytes from the previous chunk that form the start of an
     /// incomplete-but-valid multi-byte codepoint, held until the continuation
     /// bytes arrive. Definitively invalid bytes are emitted as U+FFFD
@@ -505,7 +647,7 @@ impl Utf8StreamDecoder {
     /// Takes the chunk by value so the hot path — no held partial and the
     /// whole chunk valid (clean boundaries, ASCII traffic) — can hand the
     /// allocation straight to the returned `String` without copying.
-    fn decode(&mut self, chunk: Vec<u8>) -> String {
+    pub(crate) fn decode(&mut self, chunk: Vec<u8>) -> String {
         if self.partial_len == 0 {
             return match String::from_utf8(chunk) {
                 Ok(text) => text,
@@ -625,45 +767,21 @@ impl Utf8StreamDecoder {
     /// ends so callers don't silently lose trailing invalid bytes. The held
     /// bytes are always a single incomplete codepoint prefix, so this is
     /// exactly one replacement char — same as `from_utf8_lossy` on the tail.
-    fn flush(&mut self) -> String {
+    pub(crate) fn flush(&mut self) -> String {
         if self.partial_len == 0 {
             return String::new();
         }
         self.partial_len = 0;
         "\u{FFFD}".to_string()
     }
-}
-
-/// One output stream's channel sender paired with its UTF-8 decoder state,
-/// so the two can't drift apart across the attach loop's branches (the same
-/// co-location tungstenite uses in `StringCollector`).
-struct DecodedStream {
-    tx: mpsc::UnboundedSender<String>,
-    decoder: Utf8StreamDecoder,
-}
-
-impl DecodedStream {
-    fn new(tx: mpsc::UnboundedSender<String>) -> Self {
-        Self {
-            tx,
-            decoder: Utf8StreamDecoder::default(),
-        }
-    }
 
-    /// Decode a wire chunk and forward any completed text to the receiver.
-    fn send_bytes(&mut self, data: Vec<u8>) {
-        let text = self.decoder.decode(data);
-        if !text.is_empty() {
-            let _ = self.tx.send(text);
-        }
-    }
-
-    /// Drain a held partial codepoint as U+FFFD when the stream ends.
-    fn flush(&mut self) {
-        let tail = self.decoder.flush();
-        if !tail.is_empty() {
-            let _ = self.tx.send(tail);
-        }
+    /// Hand back the held partial codepoint bytes undecoded, leaving the
+    /// decoder empty. Used when a consumer switches from text to raw bytes
+    /// mid-stream so no byte is lost or replaced.
+    pub(crate) fn take_pending(&mut self) -> Vec<u8> {
+        let held = self.partial[..self.partial_len as usize].to_vec();
+        self.partial_len = 0;
+        held
     }
 }
 
@@ -792,6 +910,15 @@ mod tests {
         assert!(elapsed >= Duration::from_millis(40)); // Allow some variance
     }
 
+    #[test]
+    fn first_response_records_only_the_first_event() {
+        let latency = Arc::new(Histogram::new());
+        let first = FirstResponse::new(Instant::now(), latency.clone());
+        first.mark(); // e.g. first stdout chunk
+        first.mark(); // later exit status
+        assert_eq!(latency.snapshot().count, 1);
+    }
+
     /// Test simulating spawn_wait cancellation behavior.
     /// When token is cancelled, the result channel should receive exit_code -1.
     #[tokio::test]
@@ -1085,68 +1212,41 @@ mod tests {
         assert_eq!(out.as_ptr(), ptr);
     }
 
-    /// route_output uses the decoder; verify it doesn't double-emit U+FFFD
-    /// when a 3-byte char straddles two ExecOutput messages. This is the
-    /// integration-shaped reproducer for the original bug.
+    /// route_output forwards each wire chunk untouched: a 3-byte char split
+    /// across two ExecOutput messages arrives as the same two raw chunks.
+    /// Joining it back into one char is `ExecStdout`'s job (see the
+    /// split-codepoint test in `litebox::exec`), and only for text readers.
     #[test]
-    fn route_output_recovers_split_codepoint_across_messages() {
+    fn route_output_forwards_raw_chunks() {
         use boxlite_shared::{Stdout as StdoutMsg, exec_output};
 
-        let (stdout_tx, mut stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, mut stderr_rx) = mpsc::unbounded_channel::<String>();
-        let mut stdout = DecodedStream::new(stdout_tx);
-        let mut stderr = DecodedStream::new(stderr_tx);
+        let (stdout_tx, mut stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, mut stderr_rx) = mpsc::unbounded_channel::<Bytes>();
 
         let mk_stdout = |bytes: Vec<u8>| ExecOutput {
-            event: Some(exec_output::Event::Stdout(StdoutMsg { data: bytes })),
+            event: Some(exec_output::Event::Stdout(StdoutMsg { data: bytes.into() })),
         };
 
         // "─" split into [E2] and [94 80] across two messages.
-        ExecProtocol::route_output(mk_stdout(vec![0xE2]), &mut stdout, &mut stderr);
-        ExecProtocol::route_output(mk_stdout(vec![0x94, 0x80]), &mut stdout, &mut stderr);
-
-        // First message: holdover only, no emission.
-        // Second message: complete "─" emitted.
-        let mut received = String::new();
-        while let Ok(s) = stdout_rx.try_recv() {
-            received.push_str(&s);
-        }
-        assert_eq!(received, "─");
-        assert!(stderr_rx.try_recv().is_err());
-    }
+        ExecProtocol::route_output(mk_stdout(vec![0xE2]), &stdout_tx, &stderr_tx);
+        ExecProtocol::route_output(mk_stdout(vec![0x94, 0x80]), &stdout_tx, &stderr_tx);
 
-    /// Flushing a DecodedStream must drain held-over bytes, leave the
-    /// decoder in a valid drained state, and be idempotent. The attach loop
-    /// flushes both streams on every exit path (clean EOF, transport error,
-    /// shutdown cancellation) so trailing partial UTF-8 bytes are never
-    /// silently dropped — keeping the helper correct keeps all three paths
-    /// correct.
-    #[test]
-    fn decoded_stream_flush_drains_held_bytes_on_any_exit_path() {
-        let (stdout_tx, mut stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, mut stderr_rx) = mpsc::unbounded_channel::<String>();
-        let mut stdout = DecodedStream::new(stdout_tx);
-        let mut stderr = DecodedStream::new(stderr_tx);
-
-        // Seed each stream with the first byte of a 3-byte codepoint so it
-        // has held-over bytes that would be lost without an explicit flush.
-        stdout.send_bytes(vec![0xE2]);
-        stderr.send_bytes(vec![0xE2]);
+        assert_eq!(stdout_rx.try_recv().ok(), Some(Bytes::from_static(&[0xE2])));
+        assert_eq!(
+            stdout_rx.try_recv().ok(),
+            Some(Bytes::from_static(&[0x94, 0x80]))
+        );
         assert!(stdout_rx.try_recv().is_err());
         assert!(stderr_rx.try_recv().is_err());
+    }
 
-        stdout.flush();
-        stderr.flush();
-
-        // Both channels must receive U+FFFD (matches from_utf8_lossy on a
-        // truncated tail). Without the flush, error/shutdown paths silently
-        // dropped these bytes.
-        assert_eq!(stdout_rx.try_recv().ok(), Some("\u{FFFD}".to_string()));
-        assert_eq!(stderr_rx.try_recv().ok(), Some("\u{FFFD}".to_string()));
-        // Idempotent: a second flush is a no-op (channels stay empty).
-        stdout.flush();
-        stderr.flush();
-        assert!(stdout_rx.try_recv().is_err());
-        assert!(stderr_rx.try_recv().is_err());
+    #[test]
+    fn utf8_decoder_take_pending_returns_held_bytes_raw() {
+        let mut d = Utf8StreamDecoder::default();
+        assert_eq!(d.decode(vec![b'a', 0xE2, 0x94]), "a");
+        assert_eq!(d.take_pending(), vec![0xE2, 0x94]);
+        // Nothing left to flush or hand back.
+        assert_eq!(d.flush(), "");
+        assert!(d.take_pending().is_empty());
     }
 }
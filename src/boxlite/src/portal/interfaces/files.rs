@@ -1,10 +1,18 @@
 //! Files service interface.
 //!
-//! Provides tar-based upload/download to the guest container rootfs.
+//! Provides tar-based upload/download to the guest container rootfs, from
+//! files on disk or streamed, and the manifest/patch calls used by delta
+//! sync.
 
-use boxlite_shared::{BoxliteError, BoxliteResult, DownloadRequest, FilesClient, UploadChunk};
+use std::sync::{Arc, Mutex};
+
+use boxlite_shared::{
+    BoxliteError, BoxliteResult, DownloadRequest, FilesClient, ManifestEntry, ManifestRequest,
+    PatchChunk, UploadChunk,
+};
+use futures::{Stream, StreamExt};
 use tokio::fs::File;
-use tokio::io::{AsyncReadExt, AsyncWriteExt};
+use tokio::io::{AsyncRead, AsyncReadExt, AsyncWrite, AsyncWriteExt};
 use tonic::transport::Channel;
 
 const CHUNK_SIZE: usize = 1 << 20; // 1 MiB
@@ -31,57 +39,160 @@ impl FilesInterface {
         mkdir_parents: bool,
         overwrite: bool,
     ) -> BoxliteResult<()> {
+        let file = File::open(tar_path)
+            .await
+            .map_err(|e| BoxliteError::Storage(format!("Failed to open tar file: {}", e)))?;
+        self.upload_stream(
+            read_chunks(file),
+            dest_path,
+            container_id,
+            mkdir_parents,
+            overwrite,
+        )
+        .await
+    }
+
+    /// Upload a tar stream to the guest and extract at dest_path.
+    ///
+    /// Chunks are sent as they are produced, so only the chunks the
+    /// transport has in flight are held in memory. An `Err` item ends the
+    /// upload and is returned in preference to the guest's verdict on the
+    /// truncated archive.
+    pub async fn upload_stream<S>(
+        &mut self,
+        chunks: S,
+        dest_path: &str,
+        container_id: Option<&str>,
+        mkdir_parents: bool,
+        overwrite: bool,
+    ) -> BoxliteResult<()>
+    where
+        S: Stream<Item = BoxliteResult<Vec<u8>>> + Send + 'static,
+    {
+        self.upload_stream_removing(
+            chunks,
+            dest_path,
+            container_id,
+            mkdir_parents,
+            overwrite,
+            Vec::new(),
+        )
+        .await
+    }
+
+    /// Like `upload_stream`, but the guest first deletes `remove_paths`
+    /// (relative to `dest_path`).
+    pub async fn upload_stream_removing<S>(
+        &mut self,
+        chunks: S,
+        dest_path: &str,
+        container_id: Option<&str>,
+        mkdir_parents: bool,
+        overwrite: bool,
+        remove_paths: Vec<String>,
+    ) -> BoxliteResult<()>
+    where
+        S: Stream<Item = BoxliteResult<Vec<u8>>> + Send + 'static,
+    {
         let dest = dest_path.to_string();
         let cid = container_id.unwrap_or_default().to_string();
+        let mut remove_paths = Some(remove_paths);
 
-        // Read entire tar file and build chunks
-        // Note: For very large files, consider streaming with async_stream crate
-        let mut file = File::open(tar_path)
-            .await
-            .map_err(|e| BoxliteError::Storage(format!("Failed to open tar file: {}", e)))?;
+        // The first chunk carries the destination and removals.
+        let (requests, failure) = until_error(chunks.enumerate().map(move |(i, item)| {
+            item.map(|data| UploadChunk {
+                dest_path: if i == 0 { dest.clone() } else { String::new() },
+                container_id: cid.clone(),
+                data,
+                mkdir_parents,
+                overwrite,
+                remove_paths: remove_paths.take().unwrap_or_default(),
+            })
+        }));
 
-        let mut chunks = Vec::new();
-        let mut buf = vec![0u8; CHUNK_SIZE];
-        let mut first = true;
+        let response = self.client.upload(requests).await;
+        if let Some(e) = failure.lock().unwrap().take() {
+            return Err(e);
+        }
+        let response = response.map_err(map_tonic_err)?.into_inner();
 
-        loop {
-            match file.read(&mut buf).await {
-                Ok(0) => break,
-                Ok(n) => {
-                    let chunk = UploadChunk {
-                        dest_path: if first { dest.clone() } else { String::new() },
-                        container_id: cid.clone(),
-                        data: buf[..n].to_vec(),
-                        mkdir_parents,
-                        overwrite,
-                    };
-                    first = false;
-                    chunks.push(chunk);
-                }
-                Err(e) => {
-                    return Err(BoxliteError::Storage(format!(
-                        "Failed to read tar file: {}",
-                        e
-                    )));
-                }
-            }
+        if response.success {
+            Ok(())
+        } else {
+            Err(BoxliteError::Internal(
+                response.error.unwrap_or_else(|| "Upload failed".into()),
+            ))
         }
+    }
 
-        // Use futures::stream::iter for the upload stream
-        let stream = futures::stream::iter(chunks);
+    /// Describe the entries below `path` in the guest (see
+    /// `boxlite_shared::sync::scan`), or only `paths` when non-empty.
+    pub async fn manifest(
+        &mut self,
+        path: &str,
+        container_id: Option<&str>,
+        paths: Vec<String>,
+        checksum: bool,
+        block_size: u32,
+    ) -> BoxliteResult<Vec<ManifestEntry>> {
+        let request = ManifestRequest {
+            path: path.to_string(),
+            container_id: container_id.unwrap_or_default().to_string(),
+            paths,
+            checksum,
+            block_size,
+        };
 
-        let response = self
+        let mut stream = self
             .client
-            .upload(stream)
+            .manifest(request)
             .await
             .map_err(map_tonic_err)?
             .into_inner();
 
+        let mut entries = Vec::new();
+        while let Some(chunk) = stream.message().await.map_err(map_tonic_err)? {
+            entries.extend(chunk.entries);
+        }
+        Ok(entries)
+    }
+
+    /// Stream block patches to files below `dest_path` in the guest.
+    ///
+    /// `dest_path` and `container_id` are filled in on the first chunk. An
+    /// `Err` item ends the stream and is returned, as in `upload_stream`.
+    pub async fn patch<S>(
+        &mut self,
+        chunks: S,
+        dest_path: &str,
+        container_id: Option<&str>,
+    ) -> BoxliteResult<()>
+    where
+        S: Stream<Item = BoxliteResult<PatchChunk>> + Send + 'static,
+    {
+        let dest = dest_path.to_string();
+        let cid = container_id.unwrap_or_default().to_string();
+        let (requests, failure) = until_error(chunks.enumerate().map(move |(i, item)| {
+            item.map(|mut chunk| {
+                if i == 0 {
+                    chunk.dest_path = dest.clone();
+                    chunk.container_id = cid.clone();
+                }
+                chunk
+            })
+        }));
+
+        let response = self.client.patch(requests).await;
+        if let Some(e) = failure.lock().unwrap().take() {
+            return Err(e);
+        }
+        let response = response.map_err(map_tonic_err)?.into_inner();
+
         if response.success {
             Ok(())
         } else {
             Err(BoxliteError::Internal(
-                response.error.unwrap_or_else(|| "Upload failed".into()),
+                response.error.unwrap_or_else(|| "Patch failed".into()),
             ))
         }
     }
@@ -95,6 +206,36 @@ impl FilesInterface {
         follow_symlinks: bool,
         tar_dest: &std::path::Path,
     ) -> BoxliteResult<()> {
+        let mut file = File::create(tar_dest)
+            .await
+            .map_err(|e| BoxliteError::Storage(format!("Failed to create tar file: {}", e)))?;
+        self.download_to(
+            container_src,
+            container_id,
+            include_parent,
+            follow_symlinks,
+            &mut file,
+        )
+        .await
+        .map(drop)
+    }
+
+    /// Download a path from guest as a tar stream written to `sink`.
+    ///
+    /// Each chunk is written before the next is requested, so memory use
+    /// does not depend on the size of the archive. Returns the bytes
+    /// written.
+    pub async fn download_to<W>(
+        &mut self,
+        container_src: &str,
+        container_id: Option<&str>,
+        include_parent: bool,
+        follow_symlinks: bool,
+        sink: &mut W,
+    ) -> BoxliteResult<u64>
+    where
+        W: AsyncWrite + Unpin + ?Sized,
+    {
         let request = DownloadRequest {
             src_path: container_src.to_string(),
             container_id: container_id.unwrap_or_default().to_string(),
@@ -109,31 +250,81 @@ impl FilesInterface {
             .map_err(map_tonic_err)?
             .into_inner();
 
-        let mut file = File::create(tar_dest)
-            .await
-            .map_err(|e| BoxliteError::Storage(format!("Failed to create tar file: {}", e)))?;
-
         // Use explicit match for proper error handling
+        let mut written = 0u64;
         loop {
             match stream.message().await {
                 Ok(Some(chunk)) => {
-                    file.write_all(&chunk.data).await.map_err(|e| {
-                        BoxliteError::Storage(format!("Failed to write tar file: {}", e))
+                    sink.write_all(&chunk.data).await.map_err(|e| {
+                        BoxliteError::Storage(format!("Failed to write tar stream: {}", e))
                     })?;
+                    written += chunk.data.len() as u64;
                 }
                 Ok(None) => break, // Stream ended
                 Err(e) => return Err(map_tonic_err(e)),
             }
         }
 
-        file.flush()
+        sink.flush()
             .await
-            .map_err(|e| BoxliteError::Storage(format!("Failed to flush tar file: {}", e)))?;
+            .map_err(|e| BoxliteError::Storage(format!("Failed to flush tar stream: {}", e)))?;
 
-        Ok(())
+        Ok(written)
     }
 }
 
+/// Read `reader` as a stream of `CHUNK_SIZE` chunks.
+pub(crate) fn read_chunks<R>(reader: R) -> impl Stream<Item = BoxliteResult<Vec<u8>>> + Send
+where
+    R: AsyncRead + Send + Unpin,
+{
+    futures::stream::unfold(Some(reader), |reader| async move {
+        let mut reader = reader?;
+        let mut buf = vec![0u8; CHUNK_SIZE];
+        match reader.read(&mut buf).await {
+            Ok(0) => None,
+            Ok(n) => {
+                buf.truncate(n);
+                Some((Ok(buf), Some(reader)))
+            }
+            Err(e) => Some((
+                Err(BoxliteError::Storage(format!(
+                    "Failed to read tar stream: {}",
+                    e
+                ))),
+                None,
+            )),
+        }
+    })
+}
+
+/// Items of `items` up to its first error, which is kept in the returned
+/// slot so the caller can report it instead of the truncated RPC's verdict.
+#[allow(clippy::type_complexity)]
+fn until_error<T, S>(
+    items: S,
+) -> (
+    impl Stream<Item = T> + Send + 'static,
+    Arc<Mutex<Option<BoxliteError>>>,
+)
+where
+    T: Send + 'static,
+    S: Stream<Item = BoxliteResult<T>> + Send + 'static,
+{
+    let failure = Arc::new(Mutex::new(None));
+    let slot = failure.clone();
+    let stream = items.scan((), move |_, item| {
+        futures::future::ready(match item {
+            Ok(value) => Some(value),
+            Err(e) => {
+                *slot.lock().unwrap() = Some(e);
+                None
+            }
+        })
+    });
+    (stream, failure)
+}
+
 fn map_tonic_err(err: tonic::Status) -> BoxliteError {
     BoxliteError::Internal(err.to_string())
 }
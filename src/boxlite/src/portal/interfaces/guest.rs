@@ -2,11 +2,15 @@
 
 use boxlite_shared::{
     BlockDeviceSource, BoxliteError, BoxliteResult, Filesystem, GuestClient, GuestInitRequest,
-    NetworkInit, PingRequest, QuiesceRequest, ShutdownRequest, ThawRequest, VirtiofsSource, Volume,
-    guest_init_response,
+    GuestMemory, MemoryReclaim, NetworkInit, PingRequest, QuiesceRequest, ReclaimMemoryRequest,
+    ShutdownRequest, ThawRequest, VirtiofsSource, Volume, guest_init_response,
 };
 use tonic::transport::Channel;
 
+use crate::metrics::{GuestMemoryStats, MemoryReclaimResult};
+use crate::runtime::advanced_options::MemoryReclaimOptions;
+use crate::runtime::options::VolumeTuning;
+
 /// Guest service interface.
 pub struct GuestInterface {
     client: GuestClient<Channel>,
@@ -39,6 +43,10 @@ impl GuestInterface {
                 ip: n.ip,
                 gateway: n.gateway,
             }),
+            memory_reclaim: config.memory_reclaim.map(|r| MemoryReclaim {
+                target_bytes: u64::from(r.target_mib) * 1024 * 1024,
+                interval_secs: r.interval.as_secs().clamp(1, u64::from(u32::MAX)) as u32,
+            }),
         };
 
         let response = self.client.init(request).await?.into_inner();
@@ -91,6 +99,37 @@ impl GuestInterface {
         let response = self.client.thaw(ThawRequest {}).await?.into_inner();
         Ok(response.thawed_count)
     }
+
+    /// Drop guest page cache and compact free memory, so free-page
+    /// reporting returns it to the host.
+    ///
+    /// Skipped by the guest when in-use memory is already at or below
+    /// `target_bytes` (0 always reclaims).
+    pub async fn reclaim_memory(
+        &mut self,
+        target_bytes: u64,
+    ) -> BoxliteResult<MemoryReclaimResult> {
+        let response = self
+            .client
+            .reclaim_memory(ReclaimMemoryRequest { target_bytes })
+            .await?
+            .into_inner();
+        Ok(MemoryReclaimResult {
+            before: memory_stats(response.before),
+            after: memory_stats(response.after),
+            reclaimed: response.reclaimed,
+        })
+    }
+}
+
+fn memory_stats(memory: Option<GuestMemory>) -> GuestMemoryStats {
+    let memory = memory.unwrap_or_default();
+    GuestMemoryStats {
+        total_bytes: memory.total_bytes,
+        free_bytes: memory.free_bytes,
+        available_bytes: memory.available_bytes,
+        cached_bytes: memory.cached_bytes,
+    }
 }
 
 /// Configuration for guest initialization.
@@ -100,6 +139,8 @@ pub struct GuestInitConfig {
     pub volumes: Vec<VolumeConfig>,
     /// Network configuration (optional)
     pub network: Option<NetworkInitConfig>,
+    /// Periodic memory reclaim run by the guest agent (optional)
+    pub memory_reclaim: Option<MemoryReclaimOptions>,
 }
 
 /// Volume configuration.
@@ -114,6 +155,10 @@ pub enum VolumeConfig {
         read_only: bool,
         /// Optional container_id for convention-based paths
         container_id: Option<String>,
+        /// Mount with DAX (the VMM reserved a window for this share)
+        dax: bool,
+        /// Mount with `noatime`
+        noatime: bool,
     },
     /// Block device mount
     BlockDevice {
@@ -137,12 +182,15 @@ impl VolumeConfig {
         mount_point: impl Into<String>,
         read_only: bool,
         container_id: Option<String>,
+        tuning: VolumeTuning,
     ) -> Self {
         Self::Virtiofs {
             tag: tag.into(),
             mount_point: mount_point.into(),
             read_only,
             container_id,
+            dax: tuning.dax_window_bytes > 0,
+            noatime: tuning.noatime,
         }
     }
 
@@ -170,11 +218,15 @@ impl VolumeConfig {
                 mount_point,
                 read_only,
                 container_id,
+                dax,
+                noatime,
             } => Volume {
                 mount_point,
                 source: Some(boxlite_shared::volume::Source::Virtiofs(VirtiofsSource {
                     tag,
                     read_only,
+                    dax,
+                    noatime,
                 })),
                 container_id: container_id.unwrap_or_default(),
             },
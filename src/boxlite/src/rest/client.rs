@@ -1,8 +1,10 @@
 //! HTTP client for the BoxLite REST API.
 
 use std::sync::Arc;
-use std::time::{Duration, SystemTime};
+use std::time::{Duration, Instant, SystemTime};
 
+use bytes::Bytes;
+use reqwest::header::{CACHE_CONTROL, HeaderMap};
 use reqwest::{Client, Method, RequestBuilder, StatusCode};
 use serde::Serialize;
 use serde::de::DeserializeOwned;
@@ -13,12 +15,33 @@ use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 use super::credential::{AccessToken, Credential};
 use super::error::{map_http_error, map_http_status};
 use super::options::BoxliteRestOptions;
+use super::single_flight::SingleFlight;
 use super::types::{ErrorResponse, FlatErrorResponse, ServerConfig};
 use crate::runtime::auth::Principal;
 
 /// Re-request a token once it is within this leeway of `expires_at`.
 const REFRESH_LEEWAY: Duration = Duration::from_secs(60);
 
+/// A fully read GET response, shareable between the callers merged onto it.
+#[derive(Clone)]
+struct RawResponse {
+    status: StatusCode,
+    body: Bytes,
+    /// Lifetime from `Cache-Control`; see [`cache_lifetime`].
+    max_age: Option<Duration>,
+}
+
+/// Outcome of a shared GET. Transport errors travel as text because
+/// `reqwest::Error` is not `Clone`.
+type SharedResponse = Result<RawResponse, String>;
+
+/// A cached response value. `expires_at == None` → never expires.
+#[derive(Clone)]
+struct Cached<T> {
+    value: T,
+    expires_at: Option<Instant>,
+}
+
 /// HTTP client for the BoxLite REST API.
 ///
 /// Handles base URL construction, bearer auth (any [`Credential`] impl),
@@ -39,13 +62,35 @@ pub(crate) struct ApiClient {
     /// `Credential` impl — API keys (`expires_at == None`) are fetched
     /// once and cached forever.
     cached: Arc<RwLock<Option<AccessToken>>>,
-    config_cache: Arc<RwLock<Option<ServerConfig>>>,
+    /// Identical GETs in flight, merged onto one request.
+    gets: Arc<SingleFlight<SharedResponse>>,
+    config_cache: Arc<RwLock<Option<Cached<ServerConfig>>>>,
+    me_cache: Arc<RwLock<Option<Cached<Principal>>>>,
+    /// Fallback lifetimes when the server sends no `Cache-Control`; from
+    /// `RestHttpOptions`.
+    config_ttl: Option<Duration>,
+    me_ttl: Option<Duration>,
 }
 
 impl ApiClient {
     pub fn new(config: &BoxliteRestOptions) -> BoxliteResult<Self> {
-        let http = Client::builder()
-            .timeout(std::time::Duration::from_secs(300))
+        let opts = &config.http;
+        let mut builder = Client::builder().timeout(std::time::Duration::from_secs(300));
+        if let Some(max) = opts.pool_max_idle_per_host {
+            builder = builder.pool_max_idle_per_host(max);
+        }
+        if let Some(timeout) = opts.pool_idle_timeout {
+            builder = builder.pool_idle_timeout(timeout);
+        }
+        if opts.http2_prior_knowledge {
+            builder = builder.http2_prior_knowledge();
+        }
+        if let Some(interval) = opts.http2_keep_alive_interval {
+            builder = builder
+                .http2_keep_alive_interval(interval)
+                .http2_keep_alive_while_idle(true);
+        }
+        let http = builder
             .build()
             .map_err(|e| BoxliteError::Config(format!("failed to create HTTP client: {}", e)))?;
 
@@ -58,7 +103,11 @@ impl ApiClient {
             path_prefix,
             credential: config.credential.clone(),
             cached: Arc::new(RwLock::new(None)),
+            gets: Arc::new(SingleFlight::new()),
             config_cache: Arc::new(RwLock::new(None)),
+            me_cache: Arc::new(RwLock::new(None)),
+            config_ttl: opts.config_ttl,
+            me_ttl: opts.me_ttl,
         })
     }
 
@@ -144,24 +193,47 @@ impl ApiClient {
             .bytes()
             .await
             .map_err(|e| BoxliteError::Internal(format!("reading response body: {}", e)))?;
-        serde_json::from_slice::<T>(&bytes).map_err(|e| {
-            let preview = String::from_utf8_lossy(&bytes);
-            let preview = if preview.len() > 4096 {
-                format!(
-                    "{}… (truncated, {} bytes total)",
-                    &preview[..4096],
-                    bytes.len()
-                )
-            } else {
-                preview.into_owned()
-            };
-            BoxliteError::Internal(format!(
-                "failed to parse response: {} \n--- response body ({} bytes) ---\n{}\n--- end ---",
-                e,
-                bytes.len(),
-                preview
-            ))
-        })
+        parse_json(&bytes)
+    }
+
+    /// Send an authorized GET, sharing the response with identical GETs
+    /// already in flight. Followers' own requests are never sent.
+    async fn get_shared(&self, url: String) -> BoxliteResult<RawResponse> {
+        let builder = self.authorize(self.http.get(&url)).await?;
+        self.gets
+            .run(&url, || read_response(builder))
+            .await
+            .map_err(BoxliteError::Network)
+    }
+
+    /// GET through [`Self::get_shared`], answering from `cache` while it is
+    /// fresh. The server's `Cache-Control` sets the lifetime; `default_ttl`
+    /// applies when it says nothing (`None` = never expires).
+    async fn cached_get<T: DeserializeOwned + Clone>(
+        &self,
+        cache: &RwLock<Option<Cached<T>>>,
+        url: String,
+        default_ttl: Option<Duration>,
+    ) -> BoxliteResult<T> {
+        {
+            let cache = cache.read().await;
+            if let Some(entry) = cache.as_ref()
+                && entry.expires_at.is_none_or(|at| Instant::now() < at)
+            {
+                return Ok(entry.value.clone());
+            }
+        }
+
+        let raw = self.get_shared(url).await?;
+        let value: T = decode_response(&raw)?;
+        let ttl = raw.max_age.map_or(default_ttl, Some);
+        if ttl != Some(Duration::ZERO) {
+            *cache.write().await = Some(Cached {
+                value: value.clone(),
+                expires_at: ttl.map(|ttl| Instant::now() + ttl),
+            });
+        }
+        Ok(value)
     }
 
     /// Send a request and expect no response body (204).
@@ -184,13 +256,7 @@ impl ApiClient {
         resp: reqwest::Response,
     ) -> BoxliteResult<T> {
         let text = resp.text().await.unwrap_or_default();
-        if let Ok(err_resp) = serde_json::from_str::<ErrorResponse>(&text) {
-            Err(map_http_error(status, &err_resp.error))
-        } else if let Ok(err_resp) = serde_json::from_str::<FlatErrorResponse>(&text) {
-            Err(map_http_error(status, &err_resp.into_error_model()))
-        } else {
-            Err(map_http_status(status, &text))
-        }
+        Err(error_from_body(status, &text))
     }
 
     // ========================================================================
@@ -198,13 +264,11 @@ impl ApiClient {
     // ========================================================================
 
     pub async fn get<T: DeserializeOwned>(&self, path: &str) -> BoxliteResult<T> {
-        let builder = self.http.get(self.url(path));
-        self.send_json(builder).await
+        decode_response(&self.get_shared(self.url(path)).await?)
     }
 
     pub async fn get_root<T: DeserializeOwned>(&self, path: &str) -> BoxliteResult<T> {
-        let builder = self.http.get(self.url_root(path));
-        self.send_json(builder).await
+        decode_response(&self.get_shared(self.url_root(path)).await?)
     }
 
     pub async fn post<B: Serialize, T: DeserializeOwned>(
@@ -327,26 +391,25 @@ impl ApiClient {
         self.authorize(builder).await
     }
 
+    /// `GET /v1/config`, cached for the server's `Cache-Control` lifetime,
+    /// else `RestHttpOptions::config_ttl` (default: for the client's life).
     pub async fn get_config(&self) -> BoxliteResult<ServerConfig> {
-        {
-            let cache = self.config_cache.read().await;
-            if let Some(config) = cache.as_ref() {
-                return Ok(config.clone());
-            }
-        }
-
-        let config: ServerConfig = self.get_root("/config").await?;
-        let mut cache = self.config_cache.write().await;
-        *cache = Some(config.clone());
-        Ok(config)
+        self.cached_get(
+            &self.config_cache,
+            self.url_root("/config"),
+            self.config_ttl,
+        )
+        .await
     }
 
-    /// `GET /v1/me` — identity of the calling credential. Not cached
-    /// (identity is per-credential and cheap; unlike static capabilities).
+    /// `GET /v1/me` — identity of the calling credential. Cached like
+    /// [`Self::get_config`] with `RestHttpOptions::me_ttl`, which defaults to
+    /// zero (not cached) unless the server sends a lifetime.
     /// A 404 surfaces as `BoxliteError::NotFound` (server without `/v1/me`);
     /// 401/403 as `BoxliteError::Config("auth: …")` — callers branch on these.
     pub async fn get_me(&self) -> BoxliteResult<Principal> {
-        self.get_root("/me").await
+        self.cached_get(&self.me_cache, self.url_root("/me"), self.me_ttl)
+            .await
     }
 
     pub async fn require_snapshots_enabled(&self) -> BoxliteResult<()> {
@@ -418,6 +481,10 @@ impl ApiClient {
 /// Clash `:7890` interception that produced bare 502s in
 /// production.
 fn transport_error(err: reqwest::Error) -> BoxliteError {
+    BoxliteError::Network(transport_detail(&err))
+}
+
+fn transport_detail(err: &reqwest::Error) -> String {
     let url_hint = err.url().map(|u| u.as_str().to_string());
     let kind = if err.is_connect() {
         "connect failed"
@@ -430,11 +497,89 @@ fn transport_error(err: reqwest::Error) -> BoxliteError {
     } else {
         "transport error"
     };
-    let detail = match url_hint {
+    match url_hint {
         Some(url) => format!("{kind} reaching {url}: {err}"),
         None => format!("{kind}: {err}"),
-    };
-    BoxliteError::Network(detail)
+    }
+}
+
+/// Send `builder` and read the whole response, for sharing between
+/// callers. Errors come back as the text of a `Network` error.
+async fn read_response(builder: RequestBuilder) -> SharedResponse {
+    let resp = builder.send().await.map_err(|e| transport_detail(&e))?;
+    let status = resp.status();
+    let max_age = cache_lifetime(resp.headers());
+    let body = resp
+        .bytes()
+        .await
+        .map_err(|e| format!("reading response body: {}", e))?;
+    Ok(RawResponse {
+        status,
+        body,
+        max_age,
+    })
+}
+
+/// Map a shared response to the caller's type, or to the error it carries.
+fn decode_response<T: DeserializeOwned>(raw: &RawResponse) -> BoxliteResult<T> {
+    if raw.status.is_success() {
+        parse_json(&raw.body)
+    } else {
+        Err(error_from_body(
+            raw.status,
+            &String::from_utf8_lossy(&raw.body),
+        ))
+    }
+}
+
+/// Parse a JSON body. On failure the body is included (truncated) in the
+/// error; see [`ApiClient::send_json`].
+fn parse_json<T: DeserializeOwned>(bytes: &[u8]) -> BoxliteResult<T> {
+    serde_json::from_slice::<T>(bytes).map_err(|e| {
+        let preview = String::from_utf8_lossy(bytes);
+        let preview = if preview.len() > 4096 {
+            format!(
+                "{}… (truncated, {} bytes total)",
+                &preview[..4096],
+                bytes.len()
+            )
+        } else {
+            preview.into_owned()
+        };
+        BoxliteError::Internal(format!(
+            "failed to parse response: {} \n--- response body ({} bytes) ---\n{}\n--- end ---",
+            e,
+            bytes.len(),
+            preview
+        ))
+    })
+}
+
+fn error_from_body(status: StatusCode, text: &str) -> BoxliteError {
+    if let Ok(err_resp) = serde_json::from_str::<ErrorResponse>(text) {
+        map_http_error(status, &err_resp.error)
+    } else if let Ok(err_resp) = serde_json::from_str::<FlatErrorResponse>(text) {
+        map_http_error(status, &err_resp.into_error_model())
+    } else {
+        map_http_status(status, text)
+    }
+}
+
+/// How long a response may be cached according to its `Cache-Control`:
+/// zero for `no-store`/`no-cache`, `max-age` otherwise, `None` when the
+/// header says neither.
+fn cache_lifetime(headers: &HeaderMap) -> Option<Duration> {
+    let value = headers.get(CACHE_CONTROL)?.to_str().ok()?;
+    let mut max_age = None;
+    for directive in value.split(',').map(|d| d.trim().to_ascii_lowercase()) {
+        if directive == "no-store" || directive == "no-cache" {
+            return Some(Duration::ZERO);
+        }
+        if let Some(secs) = directive.strip_prefix("max-age=") {
+            max_age = secs.trim_matches('"').parse().ok().map(Duration::from_secs);
+        }
+    }
+    max_age
 }
 
 /// Map a tungstenite connect error to a typed `BoxliteError`. The WS
@@ -587,6 +732,161 @@ mod tests {
         }
     }
 
+    #[test]
+    fn cache_lifetime_reads_cache_control() {
+        let lifetime = |value: &str| {
+            let mut headers = HeaderMap::new();
+            headers.insert(CACHE_CONTROL, value.parse().unwrap());
+            cache_lifetime(&headers)
+        };
+        assert_eq!(lifetime("max-age=30"), Some(Duration::from_secs(30)));
+        assert_eq!(lifetime("public, Max-Age=5"), Some(Duration::from_secs(5)));
+        assert_eq!(lifetime("no-store"), Some(Duration::ZERO));
+        assert_eq!(lifetime("max-age=30, no-cache"), Some(Duration::ZERO));
+        assert_eq!(lifetime("public"), None);
+        assert_eq!(cache_lifetime(&HeaderMap::new()), None);
+    }
+
+    /// Minimal HTTP/1.1 server answering every request with `body` after
+    /// `delay`, sending `cache_control` when given. Returns its port and
+    /// the number of requests it has served.
+    async fn counting_server(
+        body: &'static str,
+        cache_control: Option<&'static str>,
+        delay: Duration,
+    ) -> (u16, Arc<AtomicUsize>) {
+        use tokio::io::{AsyncReadExt, AsyncWriteExt};
+
+        let listener = tokio::net::TcpListener::bind("127.0.0.1:0").await.unwrap();
+        let port = listener.local_addr().unwrap().port();
+        let served = Arc::new(AtomicUsize::new(0));
+        let counter = served.clone();
+        tokio::spawn(async move {
+            while let Ok((mut stream, _)) = listener.accept().await {
+                let counter = counter.clone();
+                tokio::spawn(async move {
+                    let mut head = Vec::<u8>::new();
+                    let mut buf = [0u8; 512];
+                    while !head.windows(4).any(|w| w == b"\r\n\r\n") {
+                        match stream.read(&mut buf).await {
+                            Ok(0) | Err(_) => return,
+                            Ok(n) => head.extend_from_slice(&buf[..n]),
+                        }
+                    }
+                    counter.fetch_add(1, Ordering::SeqCst);
+                    tokio::time::sleep(delay).await;
+                    let extra = cache_control
+                        .map(|v| format!("Cache-Control: {v}\r\n"))
+                        .unwrap_or_default();
+                    let response = format!(
+                        "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n{extra}\
+                         Content-Length: {}\r\nConnection: close\r\n\r\n{body}",
+                        body.len()
+                    );
+                    let _ = stream.write_all(response.as_bytes()).await;
+                });
+            }
+        });
+        (port, served)
+    }
+
+    #[tokio::test]
+    async fn concurrent_identical_gets_share_one_request() {
+        let (port, served) =
+            counting_server(r#"{"ok":true}"#, None, Duration::from_millis(100)).await;
+        let client = ApiClient::new(&BoxliteRestOptions::new(format!("http://127.0.0.1:{port}")))
+            .expect("client");
+
+        let calls = (0..5).map(|_| client.get::<serde_json::Value>("/boxes/a"));
+        for result in futures::future::join_all(calls).await {
+            assert_eq!(result.unwrap()["ok"], true);
+        }
+        assert_eq!(served.load(Ordering::SeqCst), 1);
+
+        client.get::<serde_json::Value>("/boxes/a").await.unwrap();
+        assert_eq!(
+            served.load(Ordering::SeqCst),
+            2,
+            "only overlapping calls may be merged"
+        );
+    }
+
+    #[tokio::test]
+    async fn get_me_honors_server_max_age() {
+        let (port, served) = counting_server(
+            r#"{"sub":"u","principal_type":"user","scopes":[]}"#,
+            Some("max-age=60"),
+            Duration::ZERO,
+        )
+        .await;
+        let client = ApiClient::new(&BoxliteRestOptions::new(format!("http://127.0.0.1:{port}")))
+            .expect("client");
+
+        client.get_me().await.unwrap();
+        client.get_me().await.unwrap();
+        assert_eq!(served.load(Ordering::SeqCst), 1);
+    }
+
+    #[tokio::test]
+    async fn get_me_is_uncached_by_default() {
+        let (port, served) = counting_server(
+            r#"{"sub":"u","principal_type":"user","scopes":[]}"#,
+            None,
+            Duration::ZERO,
+        )
+        .await;
+        let client = ApiClient::new(&BoxliteRestOptions::new(format!("http://127.0.0.1:{port}")))
+            .expect("client");
+
+        client.get_me().await.unwrap();
+        client.get_me().await.unwrap();
+        assert_eq!(served.load(Ordering::SeqCst), 2);
+    }
+
+    #[test]
+    fn http_options_configure_the_client() {
+        use crate::rest::options::RestHttpOptions;
+
+        let opts = BoxliteRestOptions::new("http://localhost:1").with_http(RestHttpOptions {
+            pool_max_idle_per_host: Some(2),
+            pool_idle_timeout: Some(Duration::from_secs(5)),
+            http2_prior_knowledge: true,
+            http2_keep_alive_interval: Some(Duration::from_secs(30)),
+            config_ttl: Some(Duration::from_secs(10)),
+            me_ttl: Some(Duration::from_secs(20)),
+        });
+        let client = ApiClient::new(&opts).expect("client");
+        assert_eq!(client.config_ttl, Some(Duration::from_secs(10)));
+        assert_eq!(client.me_ttl, Some(Duration::from_secs(20)));
+
+        let client = ApiClient::new(&BoxliteRestOptions::new("http://localhost:1")).unwrap();
+        assert_eq!(client.config_ttl, None);
+        assert_eq!(client.me_ttl, Some(Duration::ZERO));
+    }
+
+    #[tokio::test]
+    async fn get_me_uses_configured_ttl() {
+        use crate::rest::options::RestHttpOptions;
+
+        let (port, served) = counting_server(
+            r#"{"sub":"u","principal_type":"user","scopes":[]}"#,
+            None,
+            Duration::ZERO,
+        )
+        .await;
+        let opts = BoxliteRestOptions::new(format!("http://127.0.0.1:{port}")).with_http(
+            RestHttpOptions {
+                me_ttl: Some(Duration::from_secs(60)),
+                ..Default::default()
+            },
+        );
+        let client = ApiClient::new(&opts).expect("client");
+
+        client.get_me().await.unwrap();
+        client.get_me().await.unwrap();
+        assert_eq!(served.load(Ordering::SeqCst), 1);
+    }
+
     #[test]
     fn test_ensure_capability_enabled() {
         assert!(ensure_capability("snapshots", Some(true)).is_ok());
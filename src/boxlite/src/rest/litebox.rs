@@ -4,6 +4,7 @@ use std::path::Path;
 use std::sync::Arc;
 
 use async_trait::async_trait;
+use bytes::Bytes;
 use parking_lot::RwLock;
 use reqwest::Method;
 use tokio::sync::mpsc;
@@ -93,8 +94,8 @@ impl BoxBackend for RestBox {
         let execution_id = resp.execution_id;
 
         // 2. Set up channels for stdout, stderr, stdin, and result
-        let (stdout_tx, stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, stderr_rx) = mpsc::unbounded_channel::<String>();
+        let (stdout_tx, stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, stderr_rx) = mpsc::unbounded_channel::<Bytes>();
         let (stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
         let (result_tx, result_rx) = mpsc::unbounded_channel::<ExecResult>();
 
@@ -151,8 +152,8 @@ impl BoxBackend for RestBox {
             other => other,
         })?;
 
-        let (stdout_tx, stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, stderr_rx) = mpsc::unbounded_channel::<String>();
+        let (stdout_tx, stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, stderr_rx) = mpsc::unbounded_channel::<Bytes>();
         let (stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
         let (result_tx, result_rx) = mpsc::unbounded_channel::<ExecResult>();
 
@@ -445,8 +446,8 @@ impl SnapshotBackend for RestBox {
 //
 // One bidirectional WebSocket carries stdin (Binary frames), stdout/stderr
 // with a 1-byte channel prefix (0x01 / 0x02), and control messages (text
-// JSON: resize / signal / stdin_eof / exit / error). Wire format is the
-// authoritative one defined by the server attach handler — see plan D1/D2.
+// JSON: resize / signal / stdin_eof / exit / error / resume). Wire format is
+// the authoritative one defined by the server attach handler — see plan D1/D2.
 
 /// Maximum idle interval before the WS reader gives up on the connection.
 ///
@@ -507,6 +508,48 @@ const WS_CLIENT_PING_INTERVAL: std::time::Duration = std::time::Duration::from_s
 #[cfg(test)]
 const WS_CLIENT_PING_INTERVAL: std::time::Duration = std::time::Duration::from_millis(100);
 
+/// Upper bound on one stdin frame. Writes already queued behind the one
+/// being sent are merged up to this size so a burst of small writes costs
+/// one frame, not one per write.
+const WS_STDIN_FRAME_BYTES: usize = 64 * 1024;
+
+/// Position in one output stream, kept across reconnects so a reattach asks
+/// the server to resume where the caller left off instead of replaying the
+/// whole backlog again.
+#[derive(Debug, Default)]
+struct StreamCursor {
+    /// Stream offset of the next byte the caller has not seen.
+    offset: u64,
+    /// Replayed bytes still to drop because the caller already has them.
+    skip: u64,
+}
+
+impl StreamCursor {
+    /// Apply the server's `resume` frame: its replay starts at `offset`.
+    /// Returns how many bytes were lost to backlog eviction (0 on a clean
+    /// resume).
+    fn resume_at(&mut self, offset: u64) -> u64 {
+        if offset >= self.offset {
+            let lost = offset - self.offset;
+            self.offset = offset;
+            self.skip = 0;
+            lost
+        } else {
+            self.skip = self.offset - offset;
+            0
+        }
+    }
+
+    /// Advance past a received payload, returning the part that is new.
+    fn accept(&mut self, payload: Bytes) -> Option<Bytes> {
+        let dup = self.skip.min(payload.len() as u64);
+        self.skip -= dup;
+        let payload = payload.slice(dup as usize..);
+        self.offset += payload.len() as u64;
+        (!payload.is_empty()).then_some(payload)
+    }
+}
+
 /// Drive the bidirectional WS attach for a single execution.
 ///
 /// Wire contract (mirrors the server's `/executions/{id}/attach` handler):
@@ -517,6 +560,10 @@ const WS_CLIENT_PING_INTERVAL: std::time::Duration = std::time::Duration::from_m
 ///   (`0x01` = stdout, `0x02` = stderr); text JSON frames are
 ///   `{"type":"exit","exit_code":N}` (terminal) or
 ///   `{"type":"error","message":"..."}` (informational, connection stays open).
+/// - On reconnect the client passes `?stdout_offset=N&stderr_offset=M`; a
+///   server that supports resuming answers first with
+///   `{"type":"resume","stdout_offset":N,"stderr_offset":M}` and replays only
+///   from there.
 ///
 /// Always emits exactly one `ExecResult` to `result_tx` before returning,
 /// so `Execution::wait()` can never observe a silent close.
@@ -525,8 +572,8 @@ async fn attach_ws(
     box_id: &str,
     execution_id: &str,
     stdin_rx: mpsc::UnboundedReceiver<Vec<u8>>,
-    stdout_tx: mpsc::UnboundedSender<String>,
-    stderr_tx: mpsc::UnboundedSender<String>,
+    stdout_tx: mpsc::UnboundedSender<Bytes>,
+    stderr_tx: mpsc::UnboundedSender<Bytes>,
     result_tx: mpsc::UnboundedSender<ExecResult>,
 ) {
     let path = format!("/boxes/{}/executions/{}/attach", box_id, execution_id);
@@ -579,8 +626,8 @@ async fn attach_ws_pump(
         tokio_tungstenite::MaybeTlsStream<tokio::net::TcpStream>,
     >,
     mut stdin_rx: mpsc::UnboundedReceiver<Vec<u8>>,
-    stdout_tx: mpsc::UnboundedSender<String>,
-    stderr_tx: mpsc::UnboundedSender<String>,
+    stdout_tx: mpsc::UnboundedSender<Bytes>,
+    stderr_tx: mpsc::UnboundedSender<Bytes>,
     result_tx: mpsc::UnboundedSender<ExecResult>,
 ) {
     use futures::{SinkExt, StreamExt};
@@ -602,6 +649,9 @@ async fn attach_ws_pump(
     // Sticky across reconnects: once the server has ever sent a frame the
     // exec is real, so a later reconnect uses the steady-state watchdog.
     let mut first_frame_seen = false;
+    // Bytes delivered per stream; sent as the resume point on reconnect.
+    let mut stdout_cursor = StreamCursor::default();
+    let mut stderr_cursor = StreamCursor::default();
 
     let mut current_stream = Some(initial_stream);
 
@@ -642,7 +692,15 @@ async fn attach_ws_pump(
                 // still running so we keep waiting for the exit frame.
                 stdin_msg = stdin_rx.recv(), if !user_closed_stdin => {
                     match stdin_msg {
-                        Some(bytes) => {
+                        Some(mut bytes) => {
+                            // If the sender has gone, the next recv() sees
+                            // None and sends stdin_eof after this frame.
+                            while bytes.len() < WS_STDIN_FRAME_BYTES {
+                                match stdin_rx.try_recv() {
+                                    Ok(more) => bytes.extend_from_slice(&more),
+                                    Err(_) => break,
+                                }
+                            }
                             if sink.send(Message::Binary(bytes)).await.is_err() {
                                 disconnect_cause = "stdin write failed (sink closed)".to_string();
                                 break;
@@ -710,16 +768,23 @@ async fn attach_ws_pump(
 
                     match frame {
                         Message::Binary(bytes) => {
-                            if let Some((channel, payload)) = bytes.split_first() {
-                                let text = String::from_utf8_lossy(payload).into_owned();
-                                match *channel {
+                            // Forward the payload as a slice of the frame
+                            // buffer; text decoding is left to the reader.
+                            let frame = Bytes::from(bytes);
+                            if let Some(&channel) = frame.first() {
+                                let payload = frame.slice(1..);
+                                match channel {
                                     0x01 => {
-                                        tracing::trace!(len = text.len(), "WS attach: stdout frame");
-                                        let _ = stdout_tx.send(text);
+                                        tracing::trace!(len = payload.len(), "WS attach: stdout frame");
+                                        if let Some(payload) = stdout_cursor.accept(payload) {
+                                            let _ = stdout_tx.send(payload);
+                                        }
                                     }
                                     0x02 => {
-                                        tracing::trace!(len = text.len(), "WS attach: stderr frame");
-                                        let _ = stderr_tx.send(text);
+                                        tracing::trace!(len = payload.len(), "WS attach: stderr frame");
+                                        if let Some(payload) = stderr_cursor.accept(payload) {
+                                            let _ = stderr_tx.send(payload);
+                                        }
                                     }
                                     other => {
                                         tracing::warn!(channel = other, "WS attach: unknown channel prefix");
@@ -740,6 +805,15 @@ async fn attach_ws_pump(
                                 tracing::warn!(message = %message, "WS attach: server-reported error");
                                 last_error_message = Some(message);
                             }
+                            ControlFrame::Resume { stdout_offset, stderr_offset } => {
+                                let lost = stdout_cursor.resume_at(stdout_offset)
+                                    + stderr_cursor.resume_at(stderr_offset);
+                                if lost > 0 {
+                                    tracing::warn!(lost, "WS attach: output evicted from the server backlog while disconnected");
+                                } else {
+                                    tracing::debug!(stdout_offset, stderr_offset, "WS attach: resumed");
+                                }
+                            }
                             ControlFrame::Unknown => {
                                 tracing::warn!(text = %text, "WS attach: unrecognized text frame");
                             }
@@ -797,7 +871,11 @@ async fn attach_ws_pump(
             tokio::time::sleep(sleep_for).await;
             reconnect_budget = reconnect_budget.saturating_sub(sleep_for);
 
-            match client.connect_ws(&path).await {
+            let resume_path = format!(
+                "{}?stdout_offset={}&stderr_offset={}",
+                path, stdout_cursor.offset, stderr_cursor.offset
+            );
+            match client.connect_ws(&resume_path).await {
                 Ok(new_stream) => {
                     tracing::info!(
                         box_id,
@@ -870,8 +948,16 @@ async fn probe_execution_status(
 
 /// Decoded form of a Server→Client text-JSON frame.
 enum ControlFrame {
-    Exit { exit_code: i32 },
-    Error { message: String },
+    Exit {
+        exit_code: i32,
+    },
+    Error {
+        message: String,
+    },
+    Resume {
+        stdout_offset: u64,
+        stderr_offset: u64,
+    },
     Unknown,
 }
 
@@ -895,6 +981,13 @@ fn parse_control_frame(text: &str) -> ControlFrame {
                 .to_string();
             ControlFrame::Error { message }
         }
+        Some("resume") => {
+            let offset = |key: &str| value.get(key).and_then(|v| v.as_u64()).unwrap_or(0);
+            ControlFrame::Resume {
+                stdout_offset: offset("stdout_offset"),
+                stderr_offset: offset("stderr_offset"),
+            }
+        }
         _ => ControlFrame::Unknown,
     }
 }
@@ -1116,6 +1209,7 @@ fn box_metrics_from_response(resp: &BoxMetricsResponse) -> BoxMetrics {
         guest_boot_duration_ms: guest_boot_ms,
         cpu_percent: resp.cpu_percent,
         memory_bytes: resp.memory_bytes,
+        host_rss_bytes: None,
         network_bytes_sent: resp.network_bytes_sent,
         network_bytes_received: resp.network_bytes_received,
         network_tcp_connections: resp.network_tcp_connections,
@@ -1126,6 +1220,8 @@ fn box_metrics_from_response(resp: &BoxMetricsResponse) -> BoxMetrics {
         stage_box_config_ms: box_config_ms,
         stage_box_spawn_ms: box_spawn_ms,
         stage_container_init_ms: container_init_ms,
+        init_trace: Vec::new(),
+        exec_response_latency_us: Default::default(),
     }
 }
 
@@ -1339,8 +1435,8 @@ mod tests {
         });
 
         let client = client_for(port);
-        let (stdout_tx, mut stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<String>();
+        let (stdout_tx, mut stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<Bytes>();
         let (stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
         let (result_tx, mut result_rx) = mpsc::unbounded_channel::<ExecResult>();
 
@@ -1406,8 +1502,8 @@ mod tests {
         });
 
         let client = client_for(port);
-        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<String>();
+        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<Bytes>();
         let (_stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
         let (result_tx, mut result_rx) = mpsc::unbounded_channel::<ExecResult>();
 
@@ -1462,8 +1558,8 @@ mod tests {
         });
 
         let client = client_for(port);
-        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<String>();
+        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<Bytes>();
         let (_stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
         let (result_tx, mut result_rx) = mpsc::unbounded_channel::<ExecResult>();
 
@@ -1534,8 +1630,8 @@ mod tests {
         });
 
         let client = client_for(port);
-        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<String>();
+        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<Bytes>();
         let (_stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
         let (result_tx, _result_rx) = mpsc::unbounded_channel::<ExecResult>();
 
@@ -1588,8 +1684,8 @@ mod tests {
         });
 
         let client = client_for(port);
-        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<String>();
-        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<String>();
+        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<Bytes>();
         let (_stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
         let (result_tx, mut result_rx) = mpsc::unbounded_channel::<ExecResult>();
 
@@ -1613,4 +1709,88 @@ mod tests {
         attach.await.unwrap();
         server.abort();
     }
+
+    // ─── ws_stdin_writes_merge_into_one_frame ────────────────────────────
+    //
+    // Writes queued while the pump is busy go out as one binary frame.
+    #[tokio::test(flavor = "multi_thread", worker_threads = 2)]
+    async fn ws_stdin_writes_merge_into_one_frame() {
+        let listener = TcpListener::bind("127.0.0.1:0").await.unwrap();
+        let port = listener.local_addr().unwrap().port();
+        let state: SharedState = Arc::new(Mutex::new(ServerState::default()));
+        let state_clone = state.clone();
+        let server = tokio::spawn(async move {
+            run_server(listener, state_clone, None, |mut ws, state| async move {
+                if let Some(Ok(Message::Binary(b))) = ws.next().await {
+                    state.lock().await.received_stdin.push(b);
+                }
+                ws.send(Message::Text(r#"{"type":"exit","exit_code":0}"#.into()))
+                    .await
+                    .unwrap();
+                let _ = ws.close(None).await;
+            })
+            .await;
+        });
+
+        let client = client_for(port);
+        let (stdout_tx, _stdout_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stderr_tx, _stderr_rx) = mpsc::unbounded_channel::<Bytes>();
+        let (stdin_tx, stdin_rx) = mpsc::unbounded_channel::<Vec<u8>>();
+        let (result_tx, mut result_rx) = mpsc::unbounded_channel::<ExecResult>();
+        for part in [&b"ls "[..], b"-la ", b"/tmp\n"] {
+            stdin_tx.send(part.to_vec()).unwrap();
+        }
+
+        let attach = tokio::spawn(async move {
+            attach_ws(
+                &client, "box1", "exec1", stdin_rx, stdout_tx, stderr_tx, result_tx,
+            )
+            .await;
+        });
+        tokio::time::timeout(Duration::from_secs(3), result_rx.recv())
+            .await
+            .expect("result channel timed out")
+            .expect("result channel closed without value");
+
+        attach.await.unwrap();
+        let s = state.lock().await;
+        assert_eq!(s.received_stdin, vec![b"ls -la /tmp\n".to_vec()]);
+        drop(s);
+        server.abort();
+    }
+
+    #[test]
+    fn stream_cursor_drops_replayed_bytes_after_resume() {
+        let mut cursor = StreamCursor::default();
+        assert_eq!(
+            cursor.accept(Bytes::from_static(b"hello ")).unwrap(),
+            "hello "
+        );
+        assert_eq!(cursor.offset, 6);
+
+        // Server replays from offset 4: "o " is a duplicate.
+        assert_eq!(cursor.resume_at(4), 0);
+        assert_eq!(cursor.accept(Bytes::from_static(b"o")), None);
+        assert_eq!(
+            cursor.accept(Bytes::from_static(b" world")).unwrap(),
+            "world"
+        );
+        assert_eq!(cursor.offset, 11);
+
+        // Server's backlog no longer holds 11..15: report the gap, keep going.
+        assert_eq!(cursor.resume_at(15), 4);
+        assert_eq!(cursor.accept(Bytes::from_static(b"!")).unwrap(), "!");
+        assert_eq!(cursor.offset, 16);
+    }
+
+    #[test]
+    fn resume_control_frame_parses_offsets() {
+        match parse_control_frame(r#"{"type":"resume","stdout_offset":12,"stderr_offset":3}"#) {
+            ControlFrame::Resume {
+                stdout_offset,
+                stderr_offset,
+            } => assert_eq!((stdout_offset, stderr_offset), (12, 3)),
+            _ => panic!("expected a resume frame"),
+        }
+    }
 }
@@ -12,4 +12,5 @@ mod exec;
 pub(crate) mod litebox;
 pub mod options;
 pub(crate) mod runtime;
+mod single_flight;
 pub(crate) mod types;
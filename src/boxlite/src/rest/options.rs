@@ -2,6 +2,7 @@
 
 use std::fmt;
 use std::sync::Arc;
+use std::time::Duration;
 
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 
@@ -62,6 +63,48 @@ pub struct BoxliteRestOptions {
     /// `None` or empty → URL skips the segment entirely (single-tenant /
     /// empty-prefix deployment shape).
     pub path_prefix: Option<String>,
+
+    /// Connection pooling, HTTP/2 and response caching.
+    pub http: RestHttpOptions,
+}
+
+/// Connection and caching settings for the REST client.
+///
+/// Every request of one runtime shares a single connection pool. Over
+/// TLS the client negotiates HTTP/2 when the server offers it, and then
+/// all requests multiplex over one connection per host. Defaults keep the
+/// client's historical behavior.
+#[derive(Clone, Debug)]
+pub struct RestHttpOptions {
+    /// Idle keep-alive connections kept per host. `None` = no limit.
+    pub pool_max_idle_per_host: Option<usize>,
+    /// How long an idle pooled connection is kept before closing.
+    /// `None` = the HTTP stack's default (90 s).
+    pub pool_idle_timeout: Option<Duration>,
+    /// Speak HTTP/2 from the first byte, without negotiation. Needed to
+    /// multiplex over plain `http://` (h2c); the server must support it.
+    pub http2_prior_knowledge: bool,
+    /// Interval of HTTP/2 PINGs that keep an idle multiplexed connection
+    /// open through NATs and load balancers. `None` = no pings.
+    pub http2_keep_alive_interval: Option<Duration>,
+    /// How long `GET /v1/config` stays cached when the response carries no
+    /// `Cache-Control` lifetime. `None` = for the life of the runtime.
+    pub config_ttl: Option<Duration>,
+    /// Same as `config_ttl`, for `GET /v1/me`. Zero = not cached.
+    pub me_ttl: Option<Duration>,
+}
+
+impl Default for RestHttpOptions {
+    fn default() -> Self {
+        Self {
+            pool_max_idle_per_host: None,
+            pool_idle_timeout: None,
+            http2_prior_knowledge: false,
+            http2_keep_alive_interval: None,
+            config_ttl: None,
+            me_ttl: Some(Duration::ZERO),
+        }
+    }
 }
 
 impl BoxliteRestOptions {
@@ -71,6 +114,7 @@ impl BoxliteRestOptions {
             url: url.into(),
             credential: None,
             path_prefix: None,
+            http: RestHttpOptions::default(),
         }
     }
 
@@ -94,6 +138,7 @@ impl BoxliteRestOptions {
             url,
             credential,
             path_prefix,
+            http: RestHttpOptions::default(),
         })
     }
 
@@ -115,6 +160,12 @@ impl BoxliteRestOptions {
         self.path_prefix = Some(path_prefix.into());
         self
     }
+
+    /// Builder-style: set connection pooling, HTTP/2 and caching options.
+    pub fn with_http(mut self, http: RestHttpOptions) -> Self {
+        self.http = http;
+        self
+    }
 }
 
 impl fmt::Debug for BoxliteRestOptions {
@@ -126,6 +177,7 @@ impl fmt::Debug for BoxliteRestOptions {
             .field("url", &self.url)
             .field("credential", &self.credential)
             .field("path_prefix", &self.path_prefix)
+            .field("http", &self.http)
             .finish()
     }
 }
@@ -0,0 +1,123 @@
+//! Collapse identical in-flight requests into one.
+
+use std::collections::HashMap;
+use std::future::Future;
+use std::sync::{Arc, Mutex};
+
+use tokio::sync::OnceCell;
+
+/// Calls keyed by string; concurrent calls with the same key share the
+/// first caller's result.
+///
+/// Only calls that overlap are merged: once a result has been handed out
+/// the key is forgotten, so the next call runs again. If the caller doing
+/// the work is cancelled, a waiting caller takes over with its own future.
+pub(crate) struct SingleFlight<V> {
+    calls: Mutex<HashMap<String, Arc<OnceCell<V>>>>,
+}
+
+impl<V: Clone> SingleFlight<V> {
+    pub(crate) fn new() -> Self {
+        Self {
+            calls: Mutex::new(HashMap::new()),
+        }
+    }
+
+    pub(crate) async fn run<F, Fut>(&self, key: &str, make: F) -> V
+    where
+        F: FnOnce() -> Fut,
+        Fut: Future<Output = V>,
+    {
+        let call = self
+            .lock()
+            .entry(key.to_string())
+            .or_insert_with(|| Arc::new(OnceCell::new()))
+            .clone();
+        let value = call.get_or_init(make).await.clone();
+
+        let mut calls = self.lock();
+        if calls
+            .get(key)
+            .is_some_and(|current| Arc::ptr_eq(current, &call))
+        {
+            calls.remove(key);
+        }
+        value
+    }
+
+    fn lock(&self) -> std::sync::MutexGuard<'_, HashMap<String, Arc<OnceCell<V>>>> {
+        // A panic while holding the lock cannot leave the map inconsistent.
+        self.calls.lock().unwrap_or_else(|e| e.into_inner())
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+    use std::time::Duration;
+
+    #[tokio::test]
+    async fn overlapping_calls_run_once() {
+        let flight = Arc::new(SingleFlight::<usize>::new());
+        let runs = Arc::new(AtomicUsize::new(0));
+
+        let tasks: Vec<_> = (0..8)
+            .map(|_| {
+                let flight = flight.clone();
+                let runs = runs.clone();
+                tokio::spawn(async move {
+                    flight
+                        .run("/boxes/a", || async {
+                            tokio::time::sleep(Duration::from_millis(50)).await;
+                            runs.fetch_add(1, Ordering::SeqCst) + 1
+                        })
+                        .await
+                })
+            })
+            .collect();
+        for task in tasks {
+            assert_eq!(task.await.unwrap(), 1);
+        }
+        assert_eq!(runs.load(Ordering::SeqCst), 1);
+
+        // Finished keys are forgotten: the next call does the work again.
+        let again = flight
+            .run("/boxes/a", || async {
+                runs.fetch_add(1, Ordering::SeqCst) + 1
+            })
+            .await;
+        assert_eq!(again, 2);
+    }
+
+    #[tokio::test]
+    async fn different_keys_do_not_share() {
+        let flight = SingleFlight::<&'static str>::new();
+        let a = flight.run("/a", || async { "a" });
+        let b = flight.run("/b", || async { "b" });
+        assert_eq!(tokio::join!(a, b), ("a", "b"));
+    }
+
+    #[tokio::test]
+    async fn waiter_takes_over_when_leader_is_cancelled() {
+        let flight = Arc::new(SingleFlight::<u32>::new());
+
+        let leader = {
+            let flight = flight.clone();
+            tokio::spawn(async move { flight.run("/k", || std::future::pending::<u32>()).await })
+        };
+        tokio::time::sleep(Duration::from_millis(20)).await;
+        let follower = {
+            let flight = flight.clone();
+            tokio::spawn(async move { flight.run("/k", || async { 7 }).await })
+        };
+        tokio::time::sleep(Duration::from_millis(20)).await;
+        leader.abort();
+
+        let value = tokio::time::timeout(Duration::from_millis(500), follower)
+            .await
+            .expect("follower must not wait on a cancelled leader")
+            .unwrap();
+        assert_eq!(value, 7);
+    }
+}
@@ -8,8 +8,8 @@ use std::sync::OnceLock;
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 
 use crate::disk::{
-    BaseDisk, BaseDiskKind, BaseDiskManager, Disk, DiskFormat, inject_file_into_ext4,
-    read_backing_file_path,
+    BaseDisk, BaseDiskKind, BaseDiskManager, Disk, DiskFormat, SharedDiskCache,
+    inject_file_into_ext4, read_backing_file_path,
 };
 use crate::images::{ImageDiskManager, ImageObject};
 #[cfg(test)]
@@ -263,6 +263,7 @@ pub struct GuestRootfsManager {
     base_disk_mgr: BaseDiskManager,
     temp_dir: PathBuf,
     guest_hash: OnceLock<Result<String, String>>,
+    shared: Option<SharedDiskCache>,
 }
 
 /// Sentinel source_box_id for global rootfs cache entries.
@@ -274,9 +275,16 @@ impl GuestRootfsManager {
             base_disk_mgr,
             temp_dir,
             guest_hash: OnceLock::new(),
+            shared: None,
         }
     }
 
+    /// Share built guest rootfs disks with other runtimes on this host.
+    pub(crate) fn with_shared_cache(mut self, shared: Option<SharedDiskCache>) -> Self {
+        self.shared = shared;
+        self
+    }
+
     /// Get the cached guest binary hash, computing it once on first access.
     fn cached_guest_hash(&self) -> BoxliteResult<&str> {
         let cached = self
@@ -329,6 +337,15 @@ impl GuestRootfsManager {
             return Self::disk_to_guest_rootfs(disk, env);
         }
 
+        if let Some(disk) = self.find_shared(&version_key)? {
+            tracing::info!(
+                version_key = %version_key,
+                total_ms = total_start.elapsed().as_millis() as u64,
+                "get_or_create: SHARED CACHE HIT"
+            );
+            return Self::disk_to_guest_rootfs(disk, env);
+        }
+
         tracing::info!(
             version_key = %version_key,
             "get_or_create: CACHE MISS — building guest rootfs"
@@ -336,6 +353,12 @@ impl GuestRootfsManager {
         let disk = self
             .build_and_install(&image_disk, &digest, &version_key)
             .await?;
+        if let Some(shared) = &self.shared
+            && let Some(version_key) = self.version_key_of(disk.path())
+            && let Err(e) = shared.publish(&Self::shared_key(&version_key), disk.path())
+        {
+            tracing::warn!(error = %e, "Failed to publish guest rootfs to shared cache");
+        }
 
         tracing::info!(
             total_ms = total_start.elapsed().as_millis() as u64,
@@ -387,6 +410,50 @@ impl GuestRootfsManager {
         }
     }
 
+    /// Install a guest rootfs built by another runtime on this host.
+    ///
+    /// The shared disk is linked into the temp dir and then installed like a
+    /// freshly built one, so it gets its own `bases/` entry and DB record.
+    fn find_shared(&self, version_key: &str) -> BoxliteResult<Option<Disk>> {
+        let Some(shared) = &self.shared else {
+            return Ok(None);
+        };
+        let temp = tempfile::tempdir_in(&self.temp_dir).map_err(|e| {
+            BoxliteError::Storage(format!(
+                "Failed to create temp directory in {}: {}",
+                self.temp_dir.display(),
+                e
+            ))
+        })?;
+        let staged_path = temp.path().join("guest-rootfs.ext4");
+        match shared.link_into(&Self::shared_key(version_key), &staged_path) {
+            Ok(true) => {
+                let staged_disk = Disk::new(staged_path, DiskFormat::Ext4, false);
+                self.install(version_key, staged_disk).map(Some)
+            }
+            Ok(false) => Ok(None),
+            Err(e) => {
+                tracing::warn!(error = %e, "Shared disk cache lookup failed");
+                Ok(None)
+            }
+        }
+    }
+
+    /// Version key of the installed rootfs at `path` (from its DB record).
+    fn version_key_of(&self, path: &Path) -> Option<String> {
+        let record = self
+            .base_disk_mgr
+            .store()
+            .find_by_base_path(&path.to_string_lossy())
+            .ok()
+            .flatten()?;
+        record.name().map(str::to_string)
+    }
+
+    fn shared_key(version_key: &str) -> String {
+        format!("guest-rootfs-{}.ext4", version_key)
+    }
+
     /// Build guest rootfs from image disk and atomically install.
     ///
     /// Verifies the actual guest binary hash against the expected version key.
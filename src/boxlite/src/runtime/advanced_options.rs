@@ -75,6 +75,71 @@ impl Default for HealthCheckOptions {
     }
 }
 
+// ============================================================================
+// Memory Reclaim Options
+// ============================================================================
+
+/// Periodic guest memory reclaim for densely packed hosts.
+///
+/// The VMM's virtio-balloon device always runs with free-page reporting, so
+/// memory the guest frees goes back to the host. What an idle guest holds on
+/// to is page cache; with this set, the guest agent drops clean cache and
+/// compacts free memory whenever in-use memory exceeds `target_mib`.
+///
+/// Runs inside the guest, so it keeps working for detached boxes. For a
+/// one-off reclaim see `LiteBox::reclaim_memory`.
+#[derive(Clone, Debug, serde::Serialize, serde::Deserialize)]
+pub struct MemoryReclaimOptions {
+    /// Reclaim when guest in-use memory (total - free) exceeds this.
+    /// 0 reclaims on every check.
+    ///
+    /// Default: 0
+    #[serde(default)]
+    pub target_mib: u32,
+
+    /// Time between checks.
+    ///
+    /// Default: 60 seconds
+    #[serde(default = "default_reclaim_interval")]
+    pub interval: Duration,
+}
+
+fn default_reclaim_interval() -> Duration {
+    Duration::from_secs(60)
+}
+
+impl Default for MemoryReclaimOptions {
+    fn default() -> Self {
+        Self {
+            target_mib: 0,
+            interval: default_reclaim_interval(),
+        }
+    }
+}
+
+// ============================================================================
+// CPU Placement
+// ============================================================================
+
+/// Where a box's VMM runs on the host.
+///
+/// Resolved to concrete host CPUs and NUMA memory nodes when the VMM is
+/// spawned. On Linux the jailer confines the whole shim process (and so
+/// every vCPU thread) to those CPUs via the box cgroup's `cpuset`, and
+/// binds guest memory to the chosen nodes. Unsupported elsewhere.
+#[derive(Clone, Debug, PartialEq, Eq, Serialize, Deserialize)]
+#[serde(tag = "policy", rename_all = "snake_case")]
+pub enum CpuPlacement {
+    /// Pin to exactly these host CPUs. Memory is bound to the NUMA nodes
+    /// those CPUs belong to.
+    Cpus { cpus: Vec<u32> },
+    /// Run on any CPU of one NUMA node, with memory bound to that node.
+    NumaNode { node: u32 },
+    /// Let the runtime pick: the NUMA node with the most spare CPUs among
+    /// running boxes, and on it the least-used CPUs, one per vCPU.
+    Auto,
+}
+
 // ============================================================================
 // Security Options
 // ============================================================================
@@ -599,4 +664,17 @@ pub struct AdvancedBoxOptions {
     /// Most users should rely on the defaults.
     #[serde(default)]
     pub health_check: Option<HealthCheckOptions>,
+
+    /// Periodic guest memory reclaim.
+    ///
+    /// Off by default: dropping page cache trades later re-reads for host
+    /// memory, which only pays off when boxes sit idle.
+    #[serde(default)]
+    pub memory_reclaim: Option<MemoryReclaimOptions>,
+
+    /// vCPU and guest memory placement on the host.
+    ///
+    /// Unset leaves scheduling to the host kernel.
+    #[serde(default)]
+    pub placement: Option<CpuPlacement>,
 }
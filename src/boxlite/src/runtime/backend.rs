@@ -4,11 +4,13 @@ use std::net::SocketAddr;
 use std::path::Path;
 
 use async_trait::async_trait;
+use tokio::io::AsyncWrite;
 
-use crate::litebox::copy::CopyOptions;
+use crate::db::WriteBatch;
+use crate::litebox::copy::{CopyOptions, CopyReader};
 use crate::litebox::snapshot_mgr::SnapshotInfo;
 use crate::litebox::{BoxCommand, BoxTunnel, Execution, LiteBox};
-use crate::metrics::{BoxMetrics, RuntimeMetrics};
+use crate::metrics::{BoxMetrics, BoxMetricsSampler, MemoryReclaimResult, RuntimeMetrics};
 use crate::runtime::options::{
     BoxArchive, BoxOptions, CloneOptions, ExportOptions, SnapshotOptions,
 };
@@ -58,9 +60,41 @@ pub(crate) trait RuntimeBackend: Send + Sync {
         ))
     }
 
+    async fn create_from_snapshot(
+        &self,
+        _source: &str,
+        _snapshot: &str,
+        _options: BoxOptions,
+        _name: Option<String>,
+    ) -> BoxliteResult<LiteBox> {
+        Err(BoxliteError::Unsupported(
+            "This operation is only supported for local runtimes (not REST backends)".to_string(),
+        ))
+    }
+
+    async fn configure_warm_pool(&self, _options: BoxOptions, _size: usize) -> BoxliteResult<()> {
+        Err(BoxliteError::Unsupported(
+            "Warm pools are only supported for local runtimes (not REST backends)".to_string(),
+        ))
+    }
+
+    /// A sampler covering all of this runtime's running boxes at once.
+    fn box_metrics_sampler(&self) -> BoxliteResult<BoxMetricsSampler> {
+        Err(BoxliteError::Unsupported(
+            "Batched box metrics are only supported for local runtimes (not REST backends)"
+                .to_string(),
+        ))
+    }
+
     /// Synchronous shutdown for atexit/Drop contexts.
     /// Default no-op (REST backend doesn't manage local processes).
     fn shutdown_sync(&self) {}
+
+    /// Open a write batch on the local box store; see
+    /// [`WriteBatch::run`]. Default `None` (REST backend has no local store).
+    fn batch_writes(&self) -> Option<WriteBatch> {
+        None
+    }
 }
 
 /// Backend abstraction for individual box operations.
@@ -79,6 +113,19 @@ pub(crate) trait BoxBackend: Send + Sync {
 
     async fn exec(&self, command: BoxCommand) -> BoxliteResult<Execution>;
 
+    /// Start several commands, results in command order. Default: one
+    /// `exec` per command (local boxes pipeline them in one guest call).
+    async fn exec_many(
+        &self,
+        commands: Vec<BoxCommand>,
+    ) -> BoxliteResult<Vec<BoxliteResult<Execution>>> {
+        let mut results = Vec::with_capacity(commands.len());
+        for command in commands {
+            results.push(self.exec(command).await);
+        }
+        Ok(results)
+    }
+
     /// Reattach to an already-running execution by id. The returned
     /// `Execution` carries fresh stdin/stdout/stderr/result channels
     /// wired to a new WebSocket; the caller discards any prior handle
@@ -95,6 +142,17 @@ pub(crate) trait BoxBackend: Send + Sync {
 
     async fn metrics(&self) -> BoxliteResult<BoxMetrics>;
 
+    /// Have the guest drop page cache and compact free memory unless its
+    /// in-use memory is already at or below `target_bytes` (0 always
+    /// reclaims). Free-page reporting then returns the memory to the host.
+    ///
+    /// Default impl returns `Unsupported`.
+    async fn reclaim_memory(&self, _target_bytes: u64) -> BoxliteResult<MemoryReclaimResult> {
+        Err(BoxliteError::Unsupported(
+            "this backend does not support memory reclaim".into(),
+        ))
+    }
+
     async fn stop(&self) -> BoxliteResult<()>;
 
     async fn copy_into(
@@ -111,6 +169,35 @@ pub(crate) trait BoxBackend: Send + Sync {
         opts: CopyOptions,
     ) -> BoxliteResult<()>;
 
+    /// Extract an uncompressed tar stream into the container at `container_dst`.
+    ///
+    /// Default impl returns `Unsupported` — backends whose transport cannot
+    /// stream an upload don't need it.
+    async fn copy_into_stream(
+        &self,
+        _tar: CopyReader,
+        _container_dst: &str,
+        _opts: CopyOptions,
+    ) -> BoxliteResult<()> {
+        Err(BoxliteError::Unsupported(
+            "this backend does not support streamed copy_into".into(),
+        ))
+    }
+
+    /// Write `container_src` as a tar stream to `sink`.
+    ///
+    /// Default impl returns `Unsupported`.
+    async fn copy_out_stream(
+        &self,
+        _container_src: &str,
+        _sink: &mut (dyn AsyncWrite + Send + Unpin),
+        _opts: CopyOptions,
+    ) -> BoxliteResult<()> {
+        Err(BoxliteError::Unsupported(
+            "this backend does not support streamed copy_out".into(),
+        ))
+    }
+
     async fn clone_box(
         &self,
         options: CloneOptions,
@@ -4,14 +4,15 @@ use std::sync::atomic::{AtomicBool, Ordering};
 use std::sync::{Arc, OnceLock};
 
 use crate::litebox::LiteBox;
-use crate::metrics::RuntimeMetrics;
+use crate::metrics::{BoxMetricsSampler, RuntimeMetrics};
 use crate::runtime::backend::RuntimeBackend;
 use crate::runtime::images::ImageBackend;
 use crate::runtime::options::{BoxArchive, BoxOptions, BoxliteOptions};
 use crate::runtime::rt_impl::{LocalRuntime, RuntimeImpl};
 use crate::runtime::signal_handler::install_signal_handler;
-use crate::runtime::types::BoxInfo;
+use crate::runtime::types::{BoxInfo, BoxInfoPage, BoxListFilter};
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+use futures::StreamExt;
 
 #[cfg(feature = "rest")]
 use crate::rest::runtime::RestRuntime;
@@ -28,6 +29,9 @@ static DEFAULT_RUNTIME: OnceLock<BoxliteRuntime> = OnceLock::new();
 /// Flag to ensure atexit handler is only registered once.
 static ATEXIT_INSTALLED: AtomicBool = AtomicBool::new(false);
 
+/// Operations in flight for the `*_many` batch calls when the caller passes 0.
+const DEFAULT_BATCH_CONCURRENCY: usize = 8;
+
 /// Atexit handler: stops non-detached boxes on normal process exit.
 ///
 /// The default runtime is `static` (never drops), so `Drop` won't fire.
@@ -304,6 +308,13 @@ impl BoxliteRuntime {
         self.backend.list_info().await
     }
 
+    /// List the boxes matching `filter`, one page at a time, in the same
+    /// order as [`list_info`](Self::list_info). The page also reports how
+    /// many boxes match in total.
+    pub async fn list_info_filtered(&self, filter: &BoxListFilter) -> BoxliteResult<BoxInfoPage> {
+        Ok(filter.apply(self.backend.list_info().await?))
+    }
+
     /// Check if a box with the given ID or name exists.
     pub async fn exists(&self, id_or_name: &str) -> BoxliteResult<bool> {
         self.backend.exists(id_or_name).await
@@ -314,11 +325,132 @@ impl BoxliteRuntime {
         self.backend.metrics().await
     }
 
+    /// A sampler reading CPU and memory of every running box in one pass,
+    /// for monitoring many boxes without one `LiteBox::metrics` call each.
+    /// Only local runtimes support it.
+    pub fn box_metrics_sampler(&self) -> BoxliteResult<BoxMetricsSampler> {
+        self.backend.box_metrics_sampler()
+    }
+
+    /// Create a box from snapshot `snapshot` of box `source` (ID or name)
+    /// and start it.
+    ///
+    /// Instead of unpacking the image, the new box's disk is a copy-on-write
+    /// child of the snapshot, shared with every other box started from it,
+    /// so it goes straight to VM boot. The image is the source box's;
+    /// `options.rootfs` is ignored. While such boxes exist, the snapshot and
+    /// its source box cannot be removed (short of `force`).
+    pub async fn create_from_snapshot(
+        &self,
+        source: &str,
+        snapshot: &str,
+        options: BoxOptions,
+        name: Option<String>,
+    ) -> BoxliteResult<LiteBox> {
+        self.backend
+            .create_from_snapshot(source, snapshot, options, name)
+            .await
+    }
+
+    /// Keep `size` boxes with exactly `options` started in the background.
+    ///
+    /// An unnamed `create()` whose options match takes one of these
+    /// instead of booting a VM, and the pool refills behind it. Named
+    /// creates and any other options boot as usual. Pool progress shows in
+    /// [`RuntimeMetrics`]; pooled boxes are hidden from `list_info()`.
+    ///
+    /// `options` must keep `auto_remove` on and `detach` off. `size == 0`
+    /// disables the pool. Only local runtimes support warm pools.
+    pub async fn configure_warm_pool(&self, options: BoxOptions, size: usize) -> BoxliteResult<()> {
+        self.backend.configure_warm_pool(options, size).await
+    }
+
     /// Remove a box completely by ID or name.
     pub async fn remove(&self, id_or_name: &str, force: bool) -> BoxliteResult<()> {
         self.backend.remove(id_or_name, force).await
     }
 
+    /// Create several boxes, at most `concurrency` at a time (0 picks a
+    /// default).
+    ///
+    /// Results come back in input order and one failure does not stop the
+    /// rest. On local runtimes the store writes of the whole batch share a
+    /// single fsync, taken when the batch finishes; other writers keep
+    /// syncing every commit.
+    pub async fn create_many(
+        &self,
+        boxes: Vec<(BoxOptions, Option<String>)>,
+        concurrency: usize,
+    ) -> Vec<BoxliteResult<LiteBox>> {
+        self.batched(boxes, concurrency, |(options, name)| {
+            self.backend.create(options, name)
+        })
+        .await
+    }
+
+    /// Start several boxes. Same ordering and concurrency as [`Self::create_many`].
+    pub async fn start_many(
+        &self,
+        boxes: &[&LiteBox],
+        concurrency: usize,
+    ) -> Vec<BoxliteResult<()>> {
+        self.batched(boxes.iter().copied(), concurrency, LiteBox::start)
+            .await
+    }
+
+    /// Stop several boxes. Same ordering and concurrency as [`Self::create_many`].
+    pub async fn stop_many(
+        &self,
+        boxes: &[&LiteBox],
+        concurrency: usize,
+    ) -> Vec<BoxliteResult<()>> {
+        self.batched(boxes.iter().copied(), concurrency, LiteBox::stop)
+            .await
+    }
+
+    /// Remove several boxes by ID or name. Same ordering and concurrency as
+    /// [`Self::create_many`].
+    pub async fn remove_many(
+        &self,
+        ids_or_names: &[&str],
+        force: bool,
+        concurrency: usize,
+    ) -> Vec<BoxliteResult<()>> {
+        self.batched(ids_or_names.iter().copied(), concurrency, |id_or_name| {
+            self.backend.remove(id_or_name, force)
+        })
+        .await
+    }
+
+    /// Run `op` over `items` with bounded concurrency inside one store
+    /// write batch, collecting results in input order.
+    async fn batched<T, R, F, Fut>(
+        &self,
+        items: impl IntoIterator<Item = T>,
+        concurrency: usize,
+        op: F,
+    ) -> Vec<R>
+    where
+        F: FnMut(T) -> Fut,
+        Fut: Future<Output = R>,
+    {
+        let concurrency = if concurrency == 0 {
+            DEFAULT_BATCH_CONCURRENCY
+        } else {
+            concurrency
+        };
+        // Build the futures up front: mapping inside the stream trips the
+        // compiler's higher-ranked `Send` check for borrowed items.
+        let pending: Vec<Fut> = items.into_iter().map(op).collect();
+        let run = futures::stream::iter(pending)
+            .buffered(concurrency)
+            .collect();
+        match self.backend.batch_writes() {
+            Some(batch) => batch.run(run).await,
+            None => run.await,
+        }
+    }
+
     /// Import a box from a `.boxlite` archive.
     ///
     /// Creates a new box with a new ID from archived disk images and configuration.
@@ -8,7 +8,7 @@ use async_trait::async_trait;
 use std::sync::Arc;
 
 use crate::BoxliteResult;
-use crate::images::ImageObject;
+use crate::images::{ImageObject, ImagePullOptions};
 use crate::runtime::types::ImageInfo;
 
 /// Internal trait for image management.
@@ -18,7 +18,11 @@ use crate::runtime::types::ImageInfo;
 #[async_trait]
 pub(crate) trait ImageBackend: Send + Sync {
     /// Pull an image from a registry.
-    async fn pull_image(&self, image_ref: &str) -> BoxliteResult<ImageObject>;
+    async fn pull_image(
+        &self,
+        image_ref: &str,
+        options: &ImagePullOptions,
+    ) -> BoxliteResult<ImageObject>;
 
     /// List all locally cached images.
     async fn list_images(&self) -> BoxliteResult<Vec<ImageInfo>>;
@@ -82,7 +86,37 @@ impl ImageHandle {
     /// # }
     /// ```
     pub async fn pull(&self, image_ref: &str) -> BoxliteResult<ImageObject> {
-        self.manager.pull_image(image_ref).await
+        self.pull_with(image_ref, ImagePullOptions::default()).await
+    }
+
+    /// Pull an image, tuning how many layers download at once and receiving
+    /// progress as they do.
+    ///
+    /// Layers are unpacked while they download, so a cold pull is ready for
+    /// box creation as soon as the last blob is verified.
+    ///
+    /// # Example
+    ///
+    /// ```ignore
+    /// # use boxlite::{Boxlite, ImagePullOptions, Options};
+    /// # #[tokio::main]
+    /// # async fn main() -> Result<(), Box<dyn std::error::Error>> {
+    /// # let runtime = Boxlite::new(Options::default())?;
+    /// let options = ImagePullOptions::default()
+    ///     .with_max_concurrent_layers(8)
+    ///     .with_progress(|p| {
+    ///         println!("{}/{} layers, {:.0} B/s", p.layers_completed, p.layers_total, p.bytes_per_second())
+    ///     });
+    /// let image = runtime.images()?.pull_with("python:3.12", options).await?;
+    /// # Ok(())
+    /// # }
+    /// ```
+    pub async fn pull_with(
+        &self,
+        image_ref: &str,
+        options: ImagePullOptions,
+    ) -> BoxliteResult<ImageObject> {
+        self.manager.pull_image(image_ref, &options).await
     }
 
     /// List all locally cached images.
@@ -8,9 +8,10 @@ use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 use crate::disk::constants::filenames as disk_filenames;
 use crate::litebox::LiteBox;
 use crate::litebox::archive::{
-    ArchiveManifest, MANIFEST_FILENAME, MAX_SUPPORTED_VERSION, extract_archive, move_file,
-    sha256_file,
+    ArchiveManifest, MANIFEST_FILENAME, MAX_SUPPORTED_VERSION, extract_archive_with_chunks,
+    move_file, sha256_file,
 };
+use crate::litebox::chunks::{ChunkImport, ChunkManager, rebuild_disk, referenced_chunks};
 use crate::runtime::options::{BoxArchive, BoxOptions, RootfsSpec};
 use crate::runtime::rt_impl::RuntimeImpl;
 use crate::runtime::types::BoxStatus;
@@ -35,12 +36,14 @@ pub(crate) async fn import_box(
 
     // Phase 1: Extract and validate archive (blocking I/O).
     let layout = runtime.layout.clone();
-    let (manifest, temp_dir) =
-        tokio::task::spawn_blocking(move || extract_and_validate(&archive_path, &layout))
-            .await
-            .map_err(|e| {
-                BoxliteError::Internal(format!("Import extraction task panicked: {}", e))
-            })??;
+    let chunk_mgr = runtime.chunk_mgr.clone();
+    // Chunks this archive added stay in the store only if the import
+    // succeeds; `chunks` removes them when dropped on an error path.
+    let (manifest, temp_dir, chunks) = tokio::task::spawn_blocking(move || {
+        extract_and_validate(&archive_path, &layout, &chunk_mgr)
+    })
+    .await
+    .map_err(|e| BoxliteError::Internal(format!("Import extraction task panicked: {}", e)))??;
 
     // Phase 2: Validate disks and install into a staging directory (blocking I/O).
     // The staging dir lives inside temp_dir; provision_box will rename it.
@@ -60,6 +63,20 @@ pub(crate) async fn import_box(
     let litebox = runtime
         .provision_box(staging_dir, name, options, BoxStatus::Stopped)
         .await?;
+    // Without its refs the box's chunks could be collected by the next
+    // removal; undo the import rather than leave them unprotected.
+    if let Err(e) = chunks.keep(litebox.id().as_ref()) {
+        let box_id = litebox.id().clone();
+        drop(litebox);
+        if let Err(remove_err) = runtime.remove_box(&box_id, true) {
+            tracing::warn!(
+                box_id = %box_id,
+                error = %remove_err,
+                "Failed to remove box after chunk refs failed"
+            );
+        }
+        return Err(e);
+    }
 
     tracing::info!(
         box_id = %litebox.id(),
@@ -71,14 +88,24 @@ pub(crate) async fn import_box(
 }
 
 /// Extract archive, parse manifest, verify checksums.
+///
+/// Chunk entries of v4 archives go to the runtime's chunk store, and the
+/// disks are rebuilt from there once the manifest (the last entry) is read.
+/// The returned [`ChunkImport`] holds the chunks that were new to the store
+/// and provisional refs on every chunk the archive uses.
 fn extract_and_validate(
     archive_path: &Path,
     layout: &crate::runtime::layout::FilesystemLayout,
-) -> BoxliteResult<(ArchiveManifest, tempfile::TempDir)> {
+    chunk_mgr: &ChunkManager,
+) -> BoxliteResult<(ArchiveManifest, tempfile::TempDir, ChunkImport)> {
     let temp_dir = tempfile::tempdir_in(layout.temp_dir())
         .map_err(|e| BoxliteError::Storage(format!("Failed to create temp directory: {}", e)))?;
 
-    extract_archive(archive_path, temp_dir.path())?;
+    // Declared before the guard so that, on an error path, the guard drops
+    // first and `chunks` can take the lock to clean up.
+    let mut chunks = ChunkImport::new(chunk_mgr.clone());
+    let _gc = chunk_mgr.gc_lock();
+    extract_archive_with_chunks(archive_path, temp_dir.path(), Some(&mut chunks))?;
 
     let manifest_path = temp_dir.path().join(MANIFEST_FILENAME);
     if !manifest_path.exists() {
@@ -98,6 +125,16 @@ fn extract_and_validate(
         )));
     }
 
+    for disk in &manifest.chunked_disks {
+        rebuild_disk(
+            disk,
+            chunks.store(),
+            temp_dir.path(),
+            manifest.parent.as_deref(),
+        )?;
+    }
+    chunks.record(&referenced_chunks(&manifest))?;
+
     let extracted_container = temp_dir.path().join(disk_filenames::CONTAINER_DISK);
     if !extracted_container.exists() {
         return Err(BoxliteError::Storage(format!(
@@ -128,7 +165,7 @@ fn extract_and_validate(
         }
     }
 
-    Ok((manifest, temp_dir))
+    Ok((manifest, temp_dir, chunks))
 }
 
 /// Validate disk security and move disks into box_home/disks/.
@@ -42,6 +42,9 @@ pub mod dirs {
 
     /// Subdirectory for per-entity locks
     pub const LOCKS_DIR: &str = "locks";
+
+    /// Subdirectory for the chunk store of chunked archive imports
+    pub const CHUNKS_DIR: &str = "chunks";
 }
 
 /// Configuration for filesystem layout behavior.
@@ -178,6 +181,14 @@ impl FilesystemLayout {
         self.home_dir.join(dirs::LOCKS_DIR)
     }
 
+    /// Chunk store for chunked archive imports: ~/.boxlite/chunks
+    ///
+    /// Content-addressed (`<hex[..2]>/<hex>`), so incremental archives can
+    /// reuse chunks from earlier imports.
+    pub fn chunks_dir(&self) -> PathBuf {
+        self.home_dir.join(dirs::CHUNKS_DIR)
+    }
+
     /// Temporary directory for transient files: ~/.boxlite/tmp
     /// Used for disk image creation and other operations that need
     /// temp files on the same filesystem as the final destination.
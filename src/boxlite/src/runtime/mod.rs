@@ -7,6 +7,7 @@ pub mod images;
 pub mod layout;
 pub(crate) mod lock;
 pub mod options;
+pub mod placement;
 pub(crate) mod signal_handler;
 pub mod types;
 
@@ -15,6 +16,7 @@ mod core;
 pub(crate) mod embedded;
 mod import;
 pub(crate) mod rt_impl;
+mod warm_pool;
 
 pub use auth::{AuthHandle, Principal};
 pub use core::BoxliteRuntime;
@@ -552,6 +552,46 @@ pub struct VolumeSpec {
     pub host_path: String,
     pub guest_path: String,
     pub read_only: bool,
+    /// Sharing performance mode. `None` applies
+    /// [`VolumeTuning::defaults_for`] this volume's `read_only` flag.
+    #[serde(default)]
+    pub tuning: Option<VolumeTuning>,
+}
+
+impl VolumeSpec {
+    /// Tuning this volume is mounted with.
+    pub fn effective_tuning(&self) -> VolumeTuning {
+        self.tuning
+            .unwrap_or_else(|| VolumeTuning::defaults_for(self.read_only))
+    }
+}
+
+/// Performance mode of a shared (virtio-fs) volume.
+#[derive(Clone, Copy, Debug, Default, PartialEq, Eq, serde::Serialize, serde::Deserialize)]
+pub struct VolumeTuning {
+    /// Size of the DAX window in bytes; 0 disables DAX. With DAX the guest
+    /// maps file pages straight out of the host page cache instead of
+    /// copying every read through the virtio queue, which is what makes
+    /// small-file-heavy builds slow. The window is guest address space, not
+    /// guest RAM. Falls back to a plain mount if the guest kernel lacks DAX.
+    pub dax_window_bytes: u64,
+    /// Mount with `noatime`, so reads never write access times back to the
+    /// host.
+    pub noatime: bool,
+}
+
+impl VolumeTuning {
+    /// Defaults by access mode. Read-only volumes (source trees, datasets)
+    /// mount with `noatime`, since the guest never writes through them.
+    /// DAX is opt-in for every volume: a DAX mapping of a file that the
+    /// other side truncates faults instead of reading short, so set a window
+    /// only for volumes the host leaves alone while mounted.
+    pub fn defaults_for(read_only: bool) -> Self {
+        Self {
+            dax_window_bytes: 0,
+            noatime: read_only,
+        }
+    }
 }
 
 /// Network mode for public box configuration surfaces.
@@ -702,9 +742,64 @@ impl BoxArchive {
 #[derive(Debug, Clone, Default)]
 pub struct SnapshotOptions {}
 
-/// Forward-compatible options for exporting a box archive.
-#[derive(Debug, Clone, Default)]
-pub struct ExportOptions {}
+/// Callback receiving export disk-copy progress snapshots.
+pub type ExportProgressFn = std::sync::Arc<dyn Fn(&ExportProgress) + Send + Sync>;
+
+/// Snapshot of the disk flatten phase of an export.
+#[derive(Clone, Debug, Default, PartialEq)]
+pub struct ExportProgress {
+    /// Virtual size of all disks being exported.
+    pub bytes_total: u64,
+    /// Virtual bytes flattened so far.
+    pub bytes_done: u64,
+    /// Allocated data written to the flattened images so far.
+    pub bytes_written: u64,
+    /// Time since flattening started.
+    pub elapsed: std::time::Duration,
+}
+
+/// Options for exporting a box archive.
+#[derive(Clone, Default)]
+pub struct ExportOptions {
+    /// Called with throttled progress while the box's disks are flattened.
+    /// Never called concurrently.
+    pub progress: Option<ExportProgressFn>,
+    /// Write a chunked (v4) archive: disks are split into content-defined
+    /// chunks and streamed straight into the archive, with no flattened
+    /// scratch copies. The box stays paused until the archive is written.
+    /// Chunked archives need a build that imports v4.
+    pub chunked: bool,
+    /// Previous chunked export of this box. Chunks it already holds are
+    /// left out, so the archive only carries what changed since; importing
+    /// it requires the parent to have been imported on the same runtime.
+    /// Implies `chunked`.
+    pub parent: Option<BoxArchive>,
+}
+
+impl ExportOptions {
+    pub fn with_progress<F>(mut self, progress: F) -> Self
+    where
+        F: Fn(&ExportProgress) + Send + Sync + 'static,
+    {
+        self.progress = Some(std::sync::Arc::new(progress));
+        self
+    }
+
+    pub fn with_parent(mut self, parent: BoxArchive) -> Self {
+        self.parent = Some(parent);
+        self
+    }
+}
+
+impl fmt::Debug for ExportOptions {
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("ExportOptions")
+            .field("progress", &self.progress.is_some())
+            .field("chunked", &self.chunked)
+            .field("parent", &self.parent)
+            .finish()
+    }
+}
 
 /// Forward-compatible options for cloning a box.
 #[derive(Debug, Clone, Default)]
@@ -927,6 +1022,32 @@ mod tests {
         assert_eq!(from_json, SecurityOptions::default());
     }
 
+    #[test]
+    fn memory_reclaim_is_off_by_default_and_fills_partial_json() {
+        use crate::runtime::advanced_options::{AdvancedBoxOptions, MemoryReclaimOptions};
+
+        assert!(AdvancedBoxOptions::default().memory_reclaim.is_none());
+
+        let reclaim: MemoryReclaimOptions = serde_json::from_str(r#"{"target_mib": 256}"#).unwrap();
+        assert_eq!(reclaim.target_mib, 256);
+        assert_eq!(reclaim.interval, MemoryReclaimOptions::default().interval);
+    }
+
+    #[test]
+    fn placement_policy_serializes_tagged() {
+        use crate::runtime::advanced_options::{AdvancedBoxOptions, CpuPlacement};
+
+        assert!(AdvancedBoxOptions::default().placement.is_none());
+
+        let auto: CpuPlacement = serde_json::from_str(r#"{"policy": "auto"}"#).unwrap();
+        assert_eq!(auto, CpuPlacement::Auto);
+        let node: CpuPlacement =
+            serde_json::from_str(r#"{"policy": "numa_node", "node": 1}"#).unwrap();
+        assert_eq!(node, CpuPlacement::NumaNode { node: 1 });
+        let cpus = serde_json::to_string(&CpuPlacement::Cpus { cpus: vec![2, 3] }).unwrap();
+        assert_eq!(cpus, r#"{"policy":"cpus","cpus":[2,3]}"#);
+    }
+
     // ===========================================================
     // SecurityOptions::from_preset — operator-surface contract
     //
@@ -1374,4 +1495,33 @@ mod tests {
         assert!(opts1.resource_limits.max_processes.is_none());
         assert_eq!(opts2.resource_limits.max_processes, Some(50));
     }
+
+    #[test]
+    fn test_volume_tuning_defaults_follow_read_only() {
+        // Specs serialized before tuning existed still load.
+        let spec: VolumeSpec =
+            serde_json::from_str(r#"{"host_path":"/src","guest_path":"/src","read_only":true}"#)
+                .unwrap();
+        assert!(spec.tuning.is_none());
+        assert_eq!(spec.effective_tuning(), VolumeTuning::defaults_for(true));
+        assert!(spec.effective_tuning().noatime);
+        assert_eq!(spec.effective_tuning().dax_window_bytes, 0, "DAX is opt-in");
+
+        let writable = VolumeSpec {
+            read_only: false,
+            ..spec.clone()
+        };
+        assert_eq!(writable.effective_tuning(), VolumeTuning::default());
+
+        // An explicit tuning wins over the defaults.
+        let explicit = VolumeTuning {
+            dax_window_bytes: 0,
+            noatime: false,
+        };
+        let tuned = VolumeSpec {
+            tuning: Some(explicit),
+            ..spec
+        };
+        assert_eq!(tuned.effective_tuning(), explicit);
+    }
 }
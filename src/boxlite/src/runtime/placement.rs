@@ -0,0 +1,533 @@
+//! Host CPU and NUMA placement for box VMMs.
+//!
+//! A box's [`CpuPlacement`] policy is resolved to a [`BoxPlacement`] — the
+//! host CPUs its VMM may run on and the NUMA nodes its memory comes from —
+//! right before the shim is spawned. The jailer applies it; the resolved
+//! placement is persisted in the box state so `BoxInfo` can report it and
+//! later auto placements can pack around it.
+
+use std::collections::{BTreeSet, HashMap};
+use std::sync::{Arc, OnceLock};
+
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+use parking_lot::Mutex;
+use serde::{Deserialize, Serialize};
+
+use crate::runtime::advanced_options::CpuPlacement;
+use crate::runtime::id::BoxID;
+
+/// CPU and NUMA node ids a placement can address: `CPU_SETSIZE`, and the
+/// size of the node mask the jailer passes to `set_mempolicy`.
+pub(crate) const MAX_PLACEMENT_IDS: u32 = 1024;
+
+/// Resolved placement: the host CPUs and NUMA memory nodes of one box.
+#[derive(Clone, Debug, PartialEq, Eq, Serialize, Deserialize)]
+pub struct BoxPlacement {
+    /// Host CPUs, ascending.
+    pub cpus: Vec<u32>,
+    /// NUMA nodes guest memory is allocated from, ascending. Empty on hosts
+    /// without NUMA, where memory is left unbound.
+    pub mems: Vec<u32>,
+}
+
+impl BoxPlacement {
+    /// CPUs in kernel list format (`"0-3,8"`), as written to `cpuset.cpus`.
+    pub fn cpu_list(&self) -> String {
+        format_cpu_list(&self.cpus)
+    }
+
+    /// Memory nodes in kernel list format, as written to `cpuset.mems`.
+    pub fn mem_list(&self) -> String {
+        format_cpu_list(&self.mems)
+    }
+}
+
+/// Parse a kernel CPU/node list (`"0-3,8,10-11"`) into ascending, unique ids.
+/// Ids must be below [`MAX_PLACEMENT_IDS`].
+pub fn parse_cpu_list(list: &str) -> BoxliteResult<Vec<u32>> {
+    let invalid = || BoxliteError::InvalidArgument(format!("invalid CPU list: {list:?}"));
+    let mut ids = BTreeSet::new();
+    for part in list.trim().split(',').filter(|p| !p.is_empty()) {
+        let (lo, hi) = match part.split_once('-') {
+            Some((lo, hi)) => (lo, hi),
+            None => (part, part),
+        };
+        let lo: u32 = lo.trim().parse().map_err(|_| invalid())?;
+        let hi: u32 = hi.trim().parse().map_err(|_| invalid())?;
+        if lo > hi || hi >= MAX_PLACEMENT_IDS {
+            return Err(invalid());
+        }
+        ids.extend(lo..=hi);
+    }
+    Ok(ids.into_iter().collect())
+}
+
+/// Format ids as a kernel list, collapsing runs into ranges.
+pub fn format_cpu_list(ids: &[u32]) -> String {
+    let mut out = String::new();
+    let mut i = 0;
+    while i < ids.len() {
+        let start = ids[i];
+        while i + 1 < ids.len() && ids[i + 1] == ids[i] + 1 {
+            i += 1;
+        }
+        if !out.is_empty() {
+            out.push(',');
+        }
+        if ids[i] == start {
+            out.push_str(&start.to_string());
+        } else {
+            out.push_str(&format!("{}-{}", start, ids[i]));
+        }
+        i += 1;
+    }
+    out
+}
+
+// ============================================================================
+// Host topology
+// ============================================================================
+
+#[derive(Debug, Clone)]
+struct NumaNode {
+    id: u32,
+    /// CPUs of this node that the runtime process may use.
+    cpus: Vec<u32>,
+}
+
+/// NUMA nodes and their CPUs, restricted to the runtime's own affinity.
+#[derive(Debug, Clone)]
+pub(crate) struct HostTopology {
+    nodes: Vec<NumaNode>,
+    /// Whether the nodes came from sysfs. Without NUMA (no sysfs nodes, or
+    /// a `CONFIG_NUMA=n` kernel) there is one synthetic node 0, and
+    /// placements leave memory unbound because `set_mempolicy` is missing.
+    numa: bool,
+}
+
+impl HostTopology {
+    /// Read the topology from sysfs. Hosts without NUMA information are one
+    /// node 0 holding every usable CPU, with no memory binding.
+    pub(crate) fn detect() -> Self {
+        let allowed = allowed_cpus();
+        let mut nodes = Vec::new();
+        if let Ok(entries) = std::fs::read_dir("/sys/devices/system/node") {
+            for entry in entries.flatten() {
+                let name = entry.file_name();
+                let Some(id) = name
+                    .to_str()
+                    .and_then(|n| n.strip_prefix("node"))
+                    .and_then(|n| n.parse::<u32>().ok())
+                    .filter(|&id| id < MAX_PLACEMENT_IDS)
+                else {
+                    continue;
+                };
+                let cpus: Vec<u32> = numa_node_cpus(id)
+                    .unwrap_or_default()
+                    .into_iter()
+                    .filter(|cpu| allowed.contains(cpu))
+                    .collect();
+                if !cpus.is_empty() {
+                    nodes.push(NumaNode { id, cpus });
+                }
+            }
+        }
+        let numa = !nodes.is_empty();
+        if !numa {
+            nodes.push(NumaNode {
+                id: 0,
+                cpus: allowed.into_iter().collect(),
+            });
+        }
+        nodes.sort_by_key(|n| n.id);
+        Self { nodes, numa }
+    }
+
+    /// Memory nodes of a placement on `nodes`: none without NUMA.
+    fn mems(&self, nodes: impl IntoIterator<Item = u32>) -> Vec<u32> {
+        if !self.numa {
+            return Vec::new();
+        }
+        nodes
+            .into_iter()
+            .collect::<BTreeSet<_>>()
+            .into_iter()
+            .collect()
+    }
+
+    fn node_of(&self, cpu: u32) -> Option<u32> {
+        self.nodes
+            .iter()
+            .find(|n| n.cpus.binary_search(&cpu).is_ok())
+            .map(|n| n.id)
+    }
+
+    /// Resolve `policy` for a box with `vcpus` vCPUs. `load` counts, per
+    /// host CPU, the boxes already placed on it.
+    pub(crate) fn resolve(
+        &self,
+        policy: &CpuPlacement,
+        vcpus: u8,
+        load: &HashMap<u32, usize>,
+    ) -> BoxliteResult<BoxPlacement> {
+        match policy {
+            CpuPlacement::Cpus { cpus } => {
+                let cpus: Vec<u32> = cpus
+                    .iter()
+                    .copied()
+                    .collect::<BTreeSet<_>>()
+                    .into_iter()
+                    .collect();
+                if cpus.is_empty() {
+                    return Err(BoxliteError::InvalidArgument(
+                        "CPU placement needs at least one CPU".into(),
+                    ));
+                }
+                if let Some(&cpu) = cpus.last()
+                    && cpu >= MAX_PLACEMENT_IDS
+                {
+                    return Err(BoxliteError::InvalidArgument(format!(
+                        "CPU {cpu} is out of range: placement supports CPU ids below \
+                         {MAX_PLACEMENT_IDS}"
+                    )));
+                }
+                let mut mems = Vec::with_capacity(cpus.len());
+                for &cpu in &cpus {
+                    let node = self.node_of(cpu).ok_or_else(|| {
+                        BoxliteError::InvalidArgument(format!(
+                            "CPU {cpu} is not available to this runtime"
+                        ))
+                    })?;
+                    mems.push(node);
+                }
+                Ok(BoxPlacement {
+                    cpus,
+                    mems: self.mems(mems),
+                })
+            }
+            CpuPlacement::NumaNode { node } => {
+                if *node >= MAX_PLACEMENT_IDS {
+                    return Err(BoxliteError::InvalidArgument(format!(
+                        "NUMA node {node} is out of range: placement supports node ids \
+                         below {MAX_PLACEMENT_IDS}"
+                    )));
+                }
+                let numa = self.nodes.iter().find(|n| n.id == *node).ok_or_else(|| {
+                    BoxliteError::InvalidArgument(format!(
+                        "NUMA node {node} has no CPUs available to this runtime"
+                    ))
+                })?;
+                Ok(BoxPlacement {
+                    cpus: numa.cpus.clone(),
+                    mems: self.mems([numa.id]),
+                })
+            }
+            CpuPlacement::Auto => Ok(self.pack(usize::from(vcpus.max(1)), load)),
+        }
+    }
+
+    /// Auto placement: keep the box on one node if any node fits it,
+    /// choosing the node with the lowest load per CPU, then its least-used
+    /// CPUs. A box wider than every node gets the whole host.
+    fn pack(&self, vcpus: usize, load: &HashMap<u32, usize>) -> BoxPlacement {
+        let cpu_load = |cpu: &u32| load.get(cpu).copied().unwrap_or(0);
+        let node_load = |node: &NumaNode| node.cpus.iter().map(cpu_load).sum::<usize>();
+
+        // Lowest load/CPUs ratio, compared without division; ties go to the
+        // lower node id (nodes are sorted).
+        let Some(node) = self
+            .nodes
+            .iter()
+            .filter(|n| n.cpus.len() >= vcpus)
+            .min_by(|a, b| (node_load(a) * b.cpus.len()).cmp(&(node_load(b) * a.cpus.len())))
+        else {
+            return BoxPlacement {
+                cpus: self
+                    .nodes
+                    .iter()
+                    .flat_map(|n| n.cpus.iter().copied())
+                    .collect::<BTreeSet<_>>()
+                    .into_iter()
+                    .collect(),
+                mems: self.mems(self.nodes.iter().map(|n| n.id)),
+            };
+        };
+
+        let mut cpus = node.cpus.clone();
+        cpus.sort_by_key(|cpu| (cpu_load(cpu), *cpu));
+        cpus.truncate(vcpus);
+        cpus.sort_unstable();
+        BoxPlacement {
+            cpus,
+            mems: self.mems([node.id]),
+        }
+    }
+}
+
+/// CPUs of NUMA node `node`, as listed in sysfs.
+pub fn numa_node_cpus(node: u32) -> BoxliteResult<Vec<u32>> {
+    if node >= MAX_PLACEMENT_IDS {
+        return Err(BoxliteError::InvalidArgument(format!(
+            "NUMA node {node} is out of range"
+        )));
+    }
+    let path = format!("/sys/devices/system/node/node{node}/cpulist");
+    let list = std::fs::read_to_string(&path)
+        .map_err(|e| BoxliteError::InvalidArgument(format!("NUMA node {node}: {e}")))?;
+    parse_cpu_list(&list)
+}
+
+/// CPUs this process may run on (its own affinity mask), below
+/// [`MAX_PLACEMENT_IDS`].
+#[cfg(target_os = "linux")]
+pub fn allowed_cpus() -> BTreeSet<u32> {
+    // SAFETY: cpu_set_t is plain data; sched_getaffinity fills it for the
+    // calling thread.
+    unsafe {
+        let mut set: libc::cpu_set_t = std::mem::zeroed();
+        if libc::sched_getaffinity(0, std::mem::size_of::<libc::cpu_set_t>(), &mut set) == 0 {
+            return (0..libc::CPU_SETSIZE as usize)
+                .filter(|&cpu| libc::CPU_ISSET(cpu, &set))
+                .map(|cpu| cpu as u32)
+                .collect();
+        }
+    }
+    let count = std::thread::available_parallelism().map_or(1, |n| n.get());
+    (0..(count as u32).min(MAX_PLACEMENT_IDS)).collect()
+}
+
+#[cfg(not(target_os = "linux"))]
+pub fn allowed_cpus() -> BTreeSet<u32> {
+    let count = std::thread::available_parallelism().map_or(1, |n| n.get());
+    (0..(count as u32).min(MAX_PLACEMENT_IDS)).collect()
+}
+
+// ============================================================================
+// Planner
+// ============================================================================
+
+/// Runtime-wide placement state.
+///
+/// Placements of running boxes live in their persisted state; the planner
+/// only remembers placements handed out to boxes that are still starting,
+/// so concurrent auto placements do not pick the same CPUs.
+pub(crate) struct PlacementPlanner {
+    topology: OnceLock<HostTopology>,
+    pending: Arc<Mutex<HashMap<BoxID, BoxPlacement>>>,
+}
+
+impl PlacementPlanner {
+    pub(crate) fn new() -> Self {
+        Self {
+            topology: OnceLock::new(),
+            pending: Arc::new(Mutex::new(HashMap::new())),
+        }
+    }
+
+    /// Resolve `policy` for `box_id`, counting `running` (placements of
+    /// other running boxes) and pending reservations as load.
+    ///
+    /// The reservation is held until dropped, which should happen once the
+    /// placement has been saved with the box's state.
+    pub(crate) fn reserve(
+        &self,
+        box_id: &BoxID,
+        policy: &CpuPlacement,
+        vcpus: u8,
+        running: impl IntoIterator<Item = (BoxID, BoxPlacement)>,
+    ) -> BoxliteResult<PlacementReservation> {
+        if !cfg!(target_os = "linux") {
+            return Err(BoxliteError::Unsupported(
+                "CPU placement is only supported on Linux".into(),
+            ));
+        }
+        let topology = self.topology.get_or_init(HostTopology::detect);
+
+        let mut pending = self.pending.lock();
+        let mut load: HashMap<u32, usize> = HashMap::new();
+        let running = running
+            .into_iter()
+            .filter(|(id, _)| !pending.contains_key(id));
+        for (id, placement) in running.chain(pending.iter().map(|(id, p)| (id.clone(), p.clone())))
+        {
+            if &id == box_id {
+                continue;
+            }
+            for cpu in placement.cpus {
+                *load.entry(cpu).or_default() += 1;
+            }
+        }
+
+        let placement = topology.resolve(policy, vcpus, &load)?;
+        pending.insert(box_id.clone(), placement.clone());
+        tracing::info!(
+            box_id = %box_id,
+            cpus = %placement.cpu_list(),
+            mems = %placement.mem_list(),
+            "Resolved box placement"
+        );
+        Ok(PlacementReservation {
+            box_id: box_id.clone(),
+            placement,
+            pending: Arc::clone(&self.pending),
+        })
+    }
+}
+
+/// A placement handed out by [`PlacementPlanner::reserve`]; counted as load
+/// for other boxes until dropped.
+pub(crate) struct PlacementReservation {
+    box_id: BoxID,
+    placement: BoxPlacement,
+    pending: Arc<Mutex<HashMap<BoxID, BoxPlacement>>>,
+}
+
+impl PlacementReservation {
+    pub(crate) fn placement(&self) -> &BoxPlacement {
+        &self.placement
+    }
+}
+
+impl Drop for PlacementReservation {
+    fn drop(&mut self) {
+        self.pending.lock().remove(&self.box_id);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn two_nodes() -> HostTopology {
+        HostTopology {
+            nodes: vec![
+                NumaNode {
+                    id: 0,
+                    cpus: vec![0, 1, 2, 3],
+                },
+                NumaNode {
+                    id: 1,
+                    cpus: vec![4, 5, 6, 7],
+                },
+            ],
+            numa: true,
+        }
+    }
+
+    #[test]
+    fn cpu_list_round_trips() {
+        assert_eq!(
+            parse_cpu_list("0-3,8,10-11\n").unwrap(),
+            vec![0, 1, 2, 3, 8, 10, 11]
+        );
+        assert_eq!(parse_cpu_list("3,1,2,1").unwrap(), vec![1, 2, 3]);
+        assert_eq!(format_cpu_list(&[0, 1, 2, 3, 8, 10, 11]), "0-3,8,10-11");
+        assert_eq!(format_cpu_list(&[]), "");
+        assert!(parse_cpu_list("3-1").is_err());
+        assert!(parse_cpu_list("a").is_err());
+        assert!(parse_cpu_list("0-4294967295").is_err());
+        assert!(parse_cpu_list(&MAX_PLACEMENT_IDS.to_string()).is_err());
+    }
+
+    #[test]
+    fn explicit_cpus_bind_memory_to_their_nodes() {
+        let placement = two_nodes()
+            .resolve(&CpuPlacement::Cpus { cpus: vec![5, 2] }, 2, &HashMap::new())
+            .unwrap();
+        assert_eq!(placement.cpus, vec![2, 5]);
+        assert_eq!(placement.mems, vec![0, 1]);
+
+        let err = two_nodes().resolve(&CpuPlacement::Cpus { cpus: vec![9] }, 1, &HashMap::new());
+        assert!(matches!(err, Err(BoxliteError::InvalidArgument(_))));
+    }
+
+    #[test]
+    fn ids_past_the_mask_size_are_rejected() {
+        let cpus = CpuPlacement::Cpus {
+            cpus: vec![1, MAX_PLACEMENT_IDS],
+        };
+        let err = two_nodes().resolve(&cpus, 2, &HashMap::new()).unwrap_err();
+        assert!(err.to_string().contains("out of range"), "{err}");
+
+        let node = CpuPlacement::NumaNode {
+            node: MAX_PLACEMENT_IDS,
+        };
+        let err = two_nodes().resolve(&node, 2, &HashMap::new()).unwrap_err();
+        assert!(err.to_string().contains("out of range"), "{err}");
+    }
+
+    #[test]
+    fn hosts_without_numa_leave_memory_unbound() {
+        let topology = HostTopology {
+            nodes: vec![NumaNode {
+                id: 0,
+                cpus: vec![0, 1, 2, 3],
+            }],
+            numa: false,
+        };
+        for policy in [
+            CpuPlacement::Auto,
+            CpuPlacement::NumaNode { node: 0 },
+            CpuPlacement::Cpus { cpus: vec![1] },
+        ] {
+            let placement = topology.resolve(&policy, 2, &HashMap::new()).unwrap();
+            assert!(!placement.cpus.is_empty());
+            assert!(placement.mems.is_empty(), "{policy:?}");
+        }
+    }
+
+    #[test]
+    fn numa_node_takes_the_whole_node() {
+        let placement = two_nodes()
+            .resolve(&CpuPlacement::NumaNode { node: 1 }, 2, &HashMap::new())
+            .unwrap();
+        assert_eq!(placement.cpu_list(), "4-7");
+        assert_eq!(placement.mem_list(), "1");
+        assert!(
+            two_nodes()
+                .resolve(&CpuPlacement::NumaNode { node: 2 }, 2, &HashMap::new())
+                .is_err()
+        );
+    }
+
+    #[test]
+    fn auto_packs_onto_least_loaded_cpus() {
+        let topology = two_nodes();
+        // Node 0 has two boxes on CPUs 0-1; node 1 is idle.
+        let load = HashMap::from([(0, 1), (1, 1)]);
+        let placement = topology.resolve(&CpuPlacement::Auto, 2, &load).unwrap();
+        assert_eq!(placement.cpus, vec![4, 5]);
+        assert_eq!(placement.mems, vec![1]);
+
+        // Both nodes equally loaded: lower node, its idle CPUs.
+        let load = HashMap::from([(0, 1), (1, 1), (4, 1), (5, 1)]);
+        let placement = topology.resolve(&CpuPlacement::Auto, 2, &load).unwrap();
+        assert_eq!(placement.cpus, vec![2, 3]);
+
+        // Wider than any node: the whole host.
+        let placement = topology
+            .resolve(&CpuPlacement::Auto, 6, &HashMap::new())
+            .unwrap();
+        assert_eq!(placement.cpu_list(), "0-7");
+        assert_eq!(placement.mem_list(), "0-1");
+    }
+
+    #[cfg(target_os = "linux")]
+    #[test]
+    fn reservations_count_as_load_until_dropped() {
+        let planner = PlacementPlanner::new();
+        planner.topology.set(two_nodes()).unwrap();
+        let a = BoxID::parse("placementa0000000000000000").unwrap();
+        let b = BoxID::parse("placementb0000000000000000").unwrap();
+
+        let first = planner.reserve(&a, &CpuPlacement::Auto, 4, []).unwrap();
+        assert_eq!(first.placement().mems, vec![0]);
+        let second = planner.reserve(&b, &CpuPlacement::Auto, 4, []).unwrap();
+        assert_eq!(second.placement().mems, vec![1]);
+
+        drop(first);
+        drop(second);
+        let again = planner.reserve(&b, &CpuPlacement::Auto, 4, []).unwrap();
+        assert_eq!(again.placement().mems, vec![0]);
+    }
+}
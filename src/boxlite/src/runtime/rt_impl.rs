@@ -3,14 +3,16 @@ use crate::images::{ImageDiskManager, ImageManager};
 use crate::litebox::config::BoxConfig;
 use crate::litebox::{BoxManager, LiteBox, LocalSnapshotBackend, SharedBoxImpl};
 use crate::lock::{FileLockManager, LockManager};
-use crate::metrics::{RuntimeMetrics, RuntimeMetricsStorage};
+use crate::metrics::{BoxMetricsSampler, RuntimeMetrics, RuntimeMetricsStorage};
 use crate::rootfs::guest::{GuestRootfs, GuestRootfsManager};
 use crate::runtime::id::{BoxID, BoxIDMint};
 use crate::runtime::layout::{BoxFilesystemLayout, FilesystemLayout, FsLayoutConfig};
 use crate::runtime::lock::RuntimeLock;
 use crate::runtime::options::{BoxArchive, BoxOptions, BoxliteOptions};
+use crate::runtime::placement::PlacementPlanner;
 use crate::runtime::signal_handler::timeout_to_duration;
 use crate::runtime::types::{BoxInfo, BoxState, BoxStatus, ContainerID};
+use crate::runtime::warm_pool::{RefillTicket, Take, WarmPool};
 use crate::vmm::VmmKind;
 use crate::vmm::controller::{ShimHandler, VmmHandler};
 use boxlite_shared::{BoxliteError, BoxliteResult};
@@ -120,6 +122,10 @@ pub struct RuntimeImpl {
     pub(crate) guest_rootfs: Arc<OnceCell<GuestRootfs>>,
     /// Runtime-wide metrics (AtomicU64 based, lock-free)
     pub(crate) runtime_metrics: RuntimeMetricsStorage,
+    /// Pre-started boxes handed out by unnamed `create()` calls.
+    pub(crate) warm_pool: WarmPool,
+    /// Host CPU / NUMA placement of box VMMs.
+    pub(crate) placement: PlacementPlanner,
 
     /// Base disk manager for clone base lifecycle and ref-count tracking.
     pub(crate) base_disk_mgr: crate::disk::BaseDiskManager,
@@ -127,6 +133,9 @@ pub struct RuntimeImpl {
     /// Snapshot manager for per-box snapshot lifecycle (create, remove, restore).
     pub(crate) snapshot_mgr: crate::litebox::snapshot_mgr::SnapshotManager,
 
+    /// Chunk store of chunked archive imports, with per-box ref tracking.
+    pub(crate) chunk_mgr: crate::litebox::chunks::ChunkManager,
+
     /// Per-entity lock manager for multiprocess-safe locking.
     ///
     /// Provides locks for individual entities (boxes, volumes, etc.) that work
@@ -247,6 +256,10 @@ impl RuntimeImpl {
             crate::disk::BaseDiskManager::new(layout.bases_dir(), base_disk_store.clone());
         let snapshot_store = crate::db::SnapshotStore::new(db.clone());
         let snapshot_mgr = crate::litebox::snapshot_mgr::SnapshotManager::new(snapshot_store);
+        let chunk_mgr = crate::litebox::chunks::ChunkManager::new(
+            layout.chunks_dir(),
+            crate::db::ChunkRefStore::new(db.clone()),
+        );
         let box_store = BoxStore::new(db);
 
         // Initialize lock manager for per-entity multiprocess-safe locking
@@ -264,10 +277,15 @@ impl RuntimeImpl {
             "Initialized lock manager"
         );
 
+        // Host-wide base disk store, shared with runtimes in other homes.
+        let shared_disk_cache = crate::disk::SharedDiskCache::from_env();
         let image_disk_mgr =
-            ImageDiskManager::new(layout.image_layout().disk_images_dir(), layout.temp_dir());
-        let guest_rootfs_mgr = GuestRootfsManager::new(base_disk_mgr.clone(), layout.temp_dir());
+            ImageDiskManager::new(layout.image_layout().disk_images_dir(), layout.temp_dir())
+                .with_shared_cache(shared_disk_cache.clone());
+        let guest_rootfs_mgr = GuestRootfsManager::new(base_disk_mgr.clone(), layout.temp_dir())
+            .with_shared_cache(shared_disk_cache);
 
+        let runtime_metrics = RuntimeMetricsStorage::new();
         let inner = Arc::new(Self {
             sync_state: RwLock::new(SynchronizedState {
                 active_boxes_by_id: HashMap::new(),
@@ -279,9 +297,12 @@ impl RuntimeImpl {
             image_disk_mgr,
             guest_rootfs_mgr,
             guest_rootfs: Arc::new(OnceCell::new()),
-            runtime_metrics: RuntimeMetricsStorage::new(),
+            runtime_metrics: runtime_metrics.clone(),
+            warm_pool: WarmPool::new(runtime_metrics),
+            placement: PlacementPlanner::new(),
             base_disk_mgr,
             snapshot_mgr,
+            chunk_mgr,
             lock_manager,
             network_factory: crate::net::default_factory(),
             _runtime_lock: runtime_lock,
@@ -293,6 +314,9 @@ impl RuntimeImpl {
         // Recover boxes from database
         inner.recover_boxes()?;
 
+        // Chunks of imports a previous process did not finish.
+        inner.chunk_mgr.release_stale_imports();
+
         Ok(inner)
     }
 
@@ -340,6 +364,107 @@ impl RuntimeImpl {
         super::import::import_box(self, archive, name).await
     }
 
+    /// Create a box from another box's snapshot and start it.
+    ///
+    /// The new container disk is a COW child of a base shared by every box
+    /// started from this snapshot, so no image is unpacked or converted:
+    /// the box goes straight to VM spawn and guest init. The image comes
+    /// from the source box; `options.rootfs` is replaced with it.
+    pub async fn create_from_snapshot(
+        self: &Arc<Self>,
+        source: &str,
+        snapshot: &str,
+        mut options: BoxOptions,
+        name: Option<String>,
+    ) -> BoxliteResult<LiteBox> {
+        use crate::disk::constants::filenames as disk_filenames;
+        use crate::disk::{BackingFormat, Qcow2Helper};
+
+        if self.shutdown_token.is_cancelled() {
+            return Err(BoxliteError::Stopped(
+                "Cannot create box: runtime has been shut down".into(),
+            ));
+        }
+        crate::litebox::snapshot_mgr::validate_snapshot_name(snapshot)?;
+
+        let (source_config, _) = self
+            .box_manager
+            .lookup_box(source)?
+            .ok_or_else(|| BoxliteError::NotFound(format!("box '{}' not found", source)))?;
+        let info = self
+            .snapshot_mgr
+            .get(source_config.id.as_str(), snapshot)?
+            .ok_or_else(|| {
+                BoxliteError::NotFound(format!(
+                    "snapshot '{}' not found for box '{}'",
+                    snapshot, source
+                ))
+            })?;
+        options.rootfs = source_config.options.rootfs.clone();
+
+        let t0 = std::time::Instant::now();
+        let staging = tempfile::tempdir_in(self.layout.boxes_dir())
+            .map_err(|e| {
+                BoxliteError::Storage(format!("Failed to create temp box directory: {}", e))
+            })?
+            .keep();
+        // The ID is minted first so the base is ref'd for the box in the
+        // transaction that finds it; nothing can collect it in between.
+        let box_id = BoxIDMint::mint();
+        let (base_id, base) = match self.base_disk_mgr.snapshot_base(&info, box_id.as_ref()) {
+            Ok(base) => base,
+            Err(e) => {
+                let _ = std::fs::remove_dir_all(&staging);
+                return Err(e);
+            }
+        };
+        let provisioned = match Qcow2Helper::create_cow_child_disk(
+            base.as_path(),
+            BackingFormat::Qcow2,
+            &staging.join("disks").join(disk_filenames::CONTAINER_DISK),
+            base.container_disk_bytes,
+        ) {
+            Ok(disk) => {
+                disk.leak();
+                self.provision_box_as(
+                    box_id.clone(),
+                    staging.clone(),
+                    name,
+                    options,
+                    BoxStatus::Stopped,
+                )
+                .await
+            }
+            Err(e) => Err(e),
+        };
+        let litebox = match provisioned {
+            Ok(litebox) => litebox,
+            Err(e) => {
+                // Release the ref taken for the box that never came to be.
+                let _ = std::fs::remove_dir_all(&staging);
+                let _ = self
+                    .base_disk_mgr
+                    .store()
+                    .remove_all_refs_for_box(box_id.as_ref());
+                self.base_disk_mgr.try_gc_base(&base_id);
+                return Err(e);
+            }
+        };
+        self.runtime_metrics
+            .boxes_created
+            .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
+
+        litebox.start().await?;
+        tracing::info!(
+            box_id = %litebox.id(),
+            source_id = %source_config.id,
+            snapshot = %snapshot,
+            elapsed_ms = t0.elapsed().as_millis() as u64,
+            "Started box from snapshot"
+        );
+        Ok(litebox)
+    }
+
     /// Inner create logic shared by `create()` and `get_or_create()`.
     ///
     /// When `reuse_existing` is false, returns an error if a box with the same
@@ -374,8 +499,28 @@ impl RuntimeImpl {
             };
         }
 
+        // Unnamed creates may take a pre-started box from the warm pool
+        if name.is_none()
+            && let Some(box_impl) = self.claim_pooled(&options)
+        {
+            return Ok((litebox_from_impl(box_impl), true));
+        }
+
+        let (box_impl, created) = self.insert_new_box(&options, name, reuse_existing)?;
+        Ok((litebox_from_impl(box_impl), created))
+    }
+
+    /// Persist a new Configured box and create its `BoxImpl`.
+    ///
+    /// Tail of `create_inner()`, also used to boot warm pool entries.
+    fn insert_new_box(
+        self: &Arc<Self>,
+        options: &BoxOptions,
+        name: Option<String>,
+        reuse_existing: bool,
+    ) -> BoxliteResult<(SharedBoxImpl, bool)> {
         // Initialize box variables with defaults
-        let (config, mut state) = self.init_box_variables(&options, name.clone());
+        let (config, mut state) = self.init_box_variables(options, name.clone());
 
         // Allocate lock for this box
         let lock_id = self.lock_manager.allocate()?;
@@ -405,7 +550,7 @@ impl RuntimeImpl {
                 && let Some((config, state)) = self.box_manager.lookup_box(name)?
             {
                 let (box_impl, _) = self.get_or_create_box_impl(config, state);
-                return Ok((litebox_from_impl(box_impl), false));
+                return Ok((box_impl, false));
             }
 
             return Err(e);
@@ -431,7 +576,7 @@ impl RuntimeImpl {
             .boxes_created
             .fetch_add(1, std::sync::atomic::Ordering::Relaxed);
 
-        Ok((litebox_from_impl(box_impl), true))
+        Ok((box_impl, true))
     }
 
     /// Get a handle to an existing box by ID or name.
@@ -554,6 +699,7 @@ impl RuntimeImpl {
         let mut seen_ids: HashSet<BoxID> = db_boxes.iter().map(|(c, _)| c.id.clone()).collect();
         let mut infos: Vec<_> = db_boxes
             .into_iter()
+            .filter(|(config, _)| !self.warm_pool.is_member(&config.id))
             .map(|(config, state)| BoxInfo::new(&config, &state))
             .collect();
 
@@ -619,6 +765,103 @@ impl RuntimeImpl {
         RuntimeMetrics::new(self.runtime_metrics.clone())
     }
 
+    /// A sampler over every running box, holding this runtime weakly.
+    pub fn box_metrics_sampler(self: &Arc<Self>) -> BoxMetricsSampler {
+        BoxMetricsSampler::new(Arc::downgrade(self))
+    }
+
+    // ========================================================================
+    // PUBLIC API - WARM POOL
+    // ========================================================================
+
+    /// Keep `size` boxes with exactly `options` started in the background,
+    /// for unnamed `create()` calls with the same options to claim.
+    ///
+    /// `size == 0` disables the pool. Changing the options replaces the
+    /// pooled boxes. Returns once the pool is reconfigured; boxes boot and
+    /// stale ones stop in the background.
+    pub async fn configure_warm_pool(
+        self: &Arc<Self>,
+        options: BoxOptions,
+        size: usize,
+    ) -> BoxliteResult<()> {
+        if self.shutdown_token.is_cancelled() {
+            return Err(BoxliteError::Stopped(
+                "Cannot configure warm pool: runtime has been shut down".into(),
+            ));
+        }
+        let stale = self.warm_pool.configure(options, size)?;
+        tracing::info!(size, discarded = stale.len(), "Configured warm pool");
+        self.discard_pooled(stale);
+        self.refill_warm_pool();
+        Ok(())
+    }
+
+    /// Take a ready box from the warm pool, if it serves `options`.
+    fn claim_pooled(self: &Arc<Self>, options: &BoxOptions) -> Option<SharedBoxImpl> {
+        let mut dead = Vec::new();
+        let take = self.warm_pool.take(
+            options,
+            |box_impl| box_impl.info().status == BoxStatus::Running,
+            &mut dead,
+        );
+        self.discard_pooled(dead);
+        match take {
+            Take::Hit(box_impl) => {
+                tracing::debug!(box_id = %box_impl.id(), "Claimed box from warm pool");
+                self.refill_warm_pool();
+                Some(box_impl)
+            }
+            Take::Miss => {
+                self.refill_warm_pool();
+                None
+            }
+            Take::Unpooled => None,
+        }
+    }
+
+    /// Start booting every missing warm pool entry.
+    fn refill_warm_pool(self: &Arc<Self>) {
+        for ticket in self.warm_pool.reserve() {
+            let this = Arc::clone(self);
+            tokio::spawn(async move { this.boot_pooled(ticket).await });
+        }
+    }
+
+    async fn boot_pooled(self: &Arc<Self>, ticket: RefillTicket) {
+        let box_impl = match self.insert_new_box(&ticket.options, None, false) {
+            Ok((box_impl, _)) => box_impl,
+            Err(e) => {
+                tracing::warn!(error = %e, "Failed to create warm pool box");
+                self.warm_pool.abandon(ticket, None);
+                return;
+            }
+        };
+        let box_id = box_impl.id().clone();
+        self.warm_pool.adopt(&box_id);
+
+        if let Err(e) = box_impl.start().await {
+            tracing::warn!(box_id = %box_id, error = %e, "Failed to start warm pool box");
+            self.warm_pool.abandon(ticket, Some(&box_id));
+            self.discard_pooled(vec![box_impl]);
+            return;
+        }
+        if let Some(unwanted) = self.warm_pool.fill(ticket, box_id, box_impl) {
+            self.discard_pooled(vec![unwanted]);
+        }
+    }
+
+    /// Stop boxes the warm pool gave up; `auto_remove` then deletes them.
+    fn discard_pooled(&self, boxes: Vec<SharedBoxImpl>) {
+        for box_impl in boxes {
+            tokio::spawn(async move {
+                if let Err(e) = box_impl.stop().await {
+                    tracing::warn!(box_id = %box_impl.id(), error = %e, "Failed to stop warm pool box");
+                }
+            });
+        }
+    }
+
     // ========================================================================
     // PUBLIC API - SHUTDOWN
     // ========================================================================
@@ -649,6 +892,10 @@ impl RuntimeImpl {
         // Cancel the shutdown token - marks shutdown and signals all in-flight operations
         self.shutdown_token.cancel();
 
+        // Pooled boxes are stopped below with the rest; keep them alive
+        // until then so they show up as active.
+        let _pooled = self.warm_pool.drain();
+
         // Collect all active non-detached boxes
         let active_boxes: Vec<SharedBoxImpl> = {
             let sync = self.sync_state.read().unwrap();
@@ -920,6 +1167,9 @@ impl RuntimeImpl {
                 self.base_disk_mgr.try_gc_base(&base_id);
             }
 
+            // 5. Release the box's archive chunks and collect orphans
+            self.chunk_mgr.release_box(id.as_ref());
+
             // Delete box directory + its socket binding symlink
             config.sockets().remove();
             let box_home = config.box_home;
@@ -981,6 +1231,9 @@ impl RuntimeImpl {
                 self.base_disk_mgr.try_gc_base(&base_id);
             }
 
+            // 5. Release the box's archive chunks and collect orphans
+            self.chunk_mgr.release_box(id.as_ref());
+
             // Invalidate cache (removes from in-memory maps)
             self.invalidate_box_impl(id, box_impl.config.name.as_deref());
 
@@ -1068,10 +1321,29 @@ impl RuntimeImpl {
         name: Option<String>,
         options: BoxOptions,
         initial_status: BoxStatus,
+    ) -> BoxliteResult<LiteBox> {
+        self.provision_box_as(
+            BoxIDMint::mint(),
+            staging_dir,
+            name,
+            options,
+            initial_status,
+        )
+        .await
+    }
+
+    /// [`provision_box`](Self::provision_box) under an ID the caller minted,
+    /// for callers that record state against the box before it exists.
+    pub(crate) async fn provision_box_as(
+        self: &Arc<Self>,
+        box_id: BoxID,
+        staging_dir: std::path::PathBuf,
+        name: Option<String>,
+        options: BoxOptions,
+        initial_status: BoxStatus,
     ) -> BoxliteResult<LiteBox> {
         use crate::litebox::config::ContainerRuntimeConfig;
 
-        let box_id = BoxIDMint::mint();
         let container_id = ContainerID::new();
         let now = Utc::now();
 
@@ -1595,6 +1867,10 @@ impl super::backend::RuntimeBackend for LocalRuntime {
         Ok(self.0.metrics().await)
     }
 
+    fn box_metrics_sampler(&self) -> BoxliteResult<BoxMetricsSampler> {
+        Ok(self.0.box_metrics_sampler())
+    }
+
     async fn remove(&self, id_or_name: &str, force: bool) -> BoxliteResult<()> {
         self.0.remove(id_or_name, force)
     }
@@ -1611,21 +1887,45 @@ impl super::backend::RuntimeBackend for LocalRuntime {
         self.0.import_box(archive, name).await
     }
 
+    async fn create_from_snapshot(
+        &self,
+        source: &str,
+        snapshot: &str,
+        options: BoxOptions,
+        name: Option<String>,
+    ) -> BoxliteResult<LiteBox> {
+        self.0
+            .create_from_snapshot(source, snapshot, options, name)
+            .await
+    }
+
+    async fn configure_warm_pool(&self, options: BoxOptions, size: usize) -> BoxliteResult<()> {
+        self.0.configure_warm_pool(options, size).await
+    }
+
     fn shutdown_sync(&self) {
         self.0.shutdown_sync();
     }
+
+    fn batch_writes(&self) -> Option<crate::db::WriteBatch> {
+        Some(self.0.box_manager.db().batch_writes())
+    }
 }
 
 // Image operations (separate from RuntimeBackend)
 #[async_trait::async_trait]
 impl super::images::ImageBackend for LocalRuntime {
-    async fn pull_image(&self, image_ref: &str) -> BoxliteResult<crate::images::ImageObject> {
+    async fn pull_image(
+        &self,
+        image_ref: &str,
+        options: &crate::images::ImagePullOptions,
+    ) -> BoxliteResult<crate::images::ImageObject> {
         if self.0.shutdown_token.is_cancelled() {
             return Err(BoxliteError::Stopped(
                 "Cannot pull image: runtime has been shut down".into(),
             ));
         }
-        self.0.image_manager.pull(image_ref).await
+        self.0.image_manager.pull_with(image_ref, options).await
     }
 
     async fn list_images(&self) -> BoxliteResult<Vec<crate::runtime::types::ImageInfo>> {
@@ -2633,7 +2933,9 @@ mod tests {
 
         runtime.shutdown(None).await.unwrap();
 
-        let result = local_runtime.pull_image("alpine:latest").await;
+        let result = local_runtime
+            .pull_image("alpine:latest", &Default::default())
+            .await;
 
         match result {
             Err(BoxliteError::Stopped(msg)) => {
@@ -10,6 +10,7 @@ use std::hash::Hash;
 
 pub use crate::litebox::{BoxState, BoxStatus, HealthStatus};
 use crate::runtime::id::BoxID;
+use crate::runtime::placement::BoxPlacement;
 
 // ============================================================================
 // RESOURCE LIMIT TYPES (C-NEWTYPE: Semantic newtypes for distinct concepts)
@@ -315,6 +316,10 @@ pub struct BoxInfo {
 
     /// Health status.
     pub health_status: HealthStatus,
+
+    /// Host CPUs and NUMA nodes the VMM is confined to (None if not
+    /// running or not placed).
+    pub placement: Option<BoxPlacement>,
 }
 
 impl BoxInfo {
@@ -338,6 +343,7 @@ impl BoxInfo {
             memory_mib: config.options.memory_mib.unwrap_or(DEFAULT_MEMORY_MIB),
             labels: HashMap::new(),
             health_status: state.health_status,
+            placement: state.placement.clone(),
         }
     }
 }
@@ -353,9 +359,73 @@ impl PartialEq for BoxInfo {
             && self.memory_mib == other.memory_mib
             && self.labels == other.labels
             && self.health_status == other.health_status
+            && self.placement == other.placement
+    }
+}
+
+/// Selects and pages boxes for `BoxliteRuntime::list_info_filtered`.
+///
+/// Every criterion that is set must match; the default selects every box.
+/// Pages are taken from the filtered list in `list_info` order (newest
+/// first), so boxes created between two calls shift later pages.
+#[derive(Debug, Clone, Default)]
+pub struct BoxListFilter {
+    /// Accepted statuses (empty = any).
+    pub statuses: Vec<BoxStatus>,
+    /// Exact image reference, as reported in [`BoxInfo::image`].
+    pub image: Option<String>,
+    /// Name prefix. Unnamed boxes never match.
+    pub name_prefix: Option<String>,
+    /// Labels that must all be present with exactly these values.
+    pub labels: Vec<(String, String)>,
+    /// Matching boxes to skip before the page starts.
+    pub offset: usize,
+    /// Maximum boxes in the page (None = no limit).
+    pub limit: Option<usize>,
+}
+
+impl BoxListFilter {
+    /// Whether `info` passes every criterion (paging aside).
+    pub fn matches(&self, info: &BoxInfo) -> bool {
+        (self.statuses.is_empty() || self.statuses.contains(&info.status))
+            && self.image.as_ref().is_none_or(|image| *image == info.image)
+            && self.name_prefix.as_ref().is_none_or(|prefix| {
+                info.name
+                    .as_ref()
+                    .is_some_and(|name| name.starts_with(prefix.as_str()))
+            })
+            && self
+                .labels
+                .iter()
+                .all(|(key, value)| info.labels.get(key) == Some(value))
+    }
+
+    /// Filter `boxes` (already in list order) and cut out the page.
+    pub fn apply(&self, boxes: Vec<BoxInfo>) -> BoxInfoPage {
+        let mut total = 0;
+        let mut items = Vec::new();
+        for info in boxes {
+            if !self.matches(&info) {
+                continue;
+            }
+            total += 1;
+            if total > self.offset && self.limit.is_none_or(|limit| items.len() < limit) {
+                items.push(info);
+            }
+        }
+        BoxInfoPage { items, total }
     }
 }
 
+/// One page of a filtered box listing.
+#[derive(Debug, Clone, Default)]
+pub struct BoxInfoPage {
+    /// Boxes in the page, newest first.
+    pub items: Vec<BoxInfo>,
+    /// Boxes matching the filter across all pages.
+    pub total: usize,
+}
+
 // ============================================================================
 // BOX STATE INFO (Docker-like State object)
 // ============================================================================
@@ -478,6 +548,80 @@ mod tests {
         assert_eq!(info.memory_mib, 1024);
     }
 
+    fn listed(name: Option<&str>, image: &str, status: BoxStatus) -> BoxInfo {
+        let now = Utc::now();
+        BoxInfo {
+            id: crate::runtime::id::BoxIDMint::mint(),
+            name: name.map(str::to_string),
+            status,
+            created_at: now,
+            last_updated: now,
+            pid: None,
+            image: image.to_string(),
+            cpus: 1,
+            memory_mib: 512,
+            labels: HashMap::new(),
+            health_status: HealthStatus::default(),
+            placement: None,
+        }
+    }
+
+    #[test]
+    fn test_list_filter_matches_every_criterion() {
+        let mut web = listed(Some("web-1"), "nginx", BoxStatus::Running);
+        web.labels.insert("tier".to_string(), "front".to_string());
+        let boxes = vec![
+            web,
+            listed(Some("web-2"), "nginx", BoxStatus::Stopped),
+            listed(None, "nginx", BoxStatus::Running),
+            listed(Some("db"), "postgres", BoxStatus::Running),
+        ];
+
+        let all = BoxListFilter::default().apply(boxes.clone());
+        assert_eq!((all.items.len(), all.total), (4, 4));
+
+        let filter = BoxListFilter {
+            statuses: vec![BoxStatus::Running],
+            image: Some("nginx".to_string()),
+            ..Default::default()
+        };
+        assert_eq!(filter.apply(boxes.clone()).total, 2);
+
+        let filter = BoxListFilter {
+            name_prefix: Some("web-".to_string()),
+            ..Default::default()
+        };
+        assert_eq!(filter.apply(boxes.clone()).total, 2);
+
+        let filter = BoxListFilter {
+            labels: vec![("tier".to_string(), "front".to_string())],
+            ..Default::default()
+        };
+        let page = filter.apply(boxes);
+        assert_eq!(page.total, 1);
+        assert_eq!(page.items[0].name.as_deref(), Some("web-1"));
+    }
+
+    #[test]
+    fn test_list_filter_pages_count_all_matches() {
+        let boxes: Vec<_> = (0..5)
+            .map(|i| listed(Some(&format!("b{i}")), "alpine", BoxStatus::Stopped))
+            .collect();
+        let filter = BoxListFilter {
+            offset: 3,
+            limit: Some(4),
+            ..Default::default()
+        };
+        let page = filter.apply(boxes);
+        assert_eq!(page.total, 5);
+        let names: Vec<_> = page
+            .items
+            .iter()
+            .filter_map(|b| b.name.as_deref())
+            .collect();
+        assert_eq!(names, ["b3", "b4"]);
+    }
+
     #[test]
     fn test_container_id_new() {
         let id1 = ContainerID::new();
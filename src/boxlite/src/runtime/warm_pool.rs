@@ -0,0 +1,373 @@
+//! Warm pool of pre-started boxes.
+//!
+//! Booting a box (VM spawn, guest connect, container init) dominates
+//! `create()` + first `exec()` latency. A runtime can keep a few boxes of
+//! one shape already running in the background; an unnamed `create()` with
+//! exactly that shape takes one instead of booting, and the pool refills
+//! itself behind the claim.
+//!
+//! The pool is keyed by the complete serialized [`BoxOptions`], not just
+//! image and resources: volumes, env, network and entrypoint are all fixed
+//! once the guest is initialized, so only an identical request can reuse a
+//! pooled box.
+//!
+//! This module only does the bookkeeping; booting and stopping boxes is
+//! driven by `RuntimeImpl`.
+
+use std::collections::{HashSet, VecDeque};
+use std::sync::Mutex;
+use std::sync::atomic::Ordering;
+
+use boxlite_shared::errors::{BoxliteError, BoxliteResult};
+
+use crate::litebox::SharedBoxImpl;
+use crate::metrics::RuntimeMetricsStorage;
+use crate::runtime::id::BoxID;
+use crate::runtime::options::BoxOptions;
+
+/// Pool bookkeeping, generic over the pooled entry so it can be tested
+/// without VMs.
+pub(crate) struct WarmPool<T = SharedBoxImpl> {
+    inner: Mutex<PoolInner<T>>,
+    metrics: RuntimeMetricsStorage,
+}
+
+struct PoolInner<T> {
+    template: Option<Template>,
+    /// Bumped whenever the template changes, so boots started for an old
+    /// template are discarded instead of joining the pool.
+    generation: u64,
+    ready: VecDeque<(BoxID, T)>,
+    /// Boots in flight for the current generation.
+    filling: usize,
+    /// Every box owned by the pool (booting or ready); hidden from listing.
+    members: HashSet<BoxID>,
+}
+
+struct Template {
+    options: BoxOptions,
+    key: String,
+    size: usize,
+}
+
+/// Permission to boot one pool entry, handed out by [`WarmPool::reserve`].
+pub(crate) struct RefillTicket {
+    pub(crate) options: BoxOptions,
+    generation: u64,
+}
+
+/// Outcome of [`WarmPool::take`].
+pub(crate) enum Take<T> {
+    /// A ready entry with the requested shape.
+    Hit(T),
+    /// The pool serves this shape but had nothing ready.
+    Miss,
+    /// The pool doesn't serve this shape (or is disabled).
+    Unpooled,
+}
+
+fn pool_key(options: &BoxOptions) -> BoxliteResult<String> {
+    serde_json::to_string(options)
+        .map_err(|e| BoxliteError::Internal(format!("failed to serialize box options: {}", e)))
+}
+
+impl<T> WarmPool<T> {
+    pub(crate) fn new(metrics: RuntimeMetricsStorage) -> Self {
+        Self {
+            inner: Mutex::new(PoolInner {
+                template: None,
+                generation: 0,
+                ready: VecDeque::new(),
+                filling: 0,
+                members: HashSet::new(),
+            }),
+            metrics,
+        }
+    }
+
+    /// Serve `options` with `size` pre-started boxes; `size == 0` disables
+    /// the pool. Returns the ready entries that no longer fit, which the
+    /// caller must stop.
+    ///
+    /// Pooled boxes must be `auto_remove` and not `detach`, so a pool that
+    /// dies with its process leaves nothing behind for recovery to list.
+    pub(crate) fn configure(&self, options: BoxOptions, size: usize) -> BoxliteResult<Vec<T>> {
+        if size > 0 && (options.detach || !options.auto_remove) {
+            return Err(BoxliteError::InvalidArgument(
+                "warm pool boxes must use auto_remove=true and detach=false".into(),
+            ));
+        }
+        let key = pool_key(&options)?;
+        let mut inner = self.inner.lock().unwrap();
+        let same_shape = inner.template.as_ref().is_some_and(|t| t.key == key);
+        let mut stale = Vec::new();
+        if !same_shape {
+            inner.generation += 1;
+            inner.filling = 0;
+            stale.extend(inner.ready.drain(..));
+        }
+        while inner.ready.len() > size {
+            stale.extend(inner.ready.pop_back());
+        }
+        for (id, _) in &stale {
+            inner.members.remove(id);
+        }
+        inner.template = (size > 0).then_some(Template { options, key, size });
+        self.metrics
+            .warm_pool_size
+            .store(size as u64, Ordering::Relaxed);
+        self.publish_ready(&inner);
+        Ok(stale.into_iter().map(|(_, entry)| entry).collect())
+    }
+
+    /// Take a ready entry for `options`. Entries failing `is_live` (e.g. a
+    /// VM that died while pooled) are skipped and returned in `dead` for the
+    /// caller to clean up.
+    pub(crate) fn take(
+        &self,
+        options: &BoxOptions,
+        is_live: impl Fn(&T) -> bool,
+        dead: &mut Vec<T>,
+    ) -> Take<T> {
+        let mut inner = self.inner.lock().unwrap();
+        let Some(template) = &inner.template else {
+            return Take::Unpooled;
+        };
+        if pool_key(options).ok().as_deref() != Some(template.key.as_str()) {
+            return Take::Unpooled;
+        }
+        let mut hit = None;
+        while let Some((id, entry)) = inner.ready.pop_front() {
+            inner.members.remove(&id);
+            if is_live(&entry) {
+                hit = Some(entry);
+                break;
+            }
+            dead.push(entry);
+        }
+        self.publish_ready(&inner);
+        match hit {
+            Some(entry) => {
+                self.metrics.warm_pool_hits.fetch_add(1, Ordering::Relaxed);
+                Take::Hit(entry)
+            }
+            None => {
+                self.metrics
+                    .warm_pool_misses
+                    .fetch_add(1, Ordering::Relaxed);
+                Take::Miss
+            }
+        }
+    }
+
+    /// Reserve boots for every missing entry.
+    pub(crate) fn reserve(&self) -> Vec<RefillTicket> {
+        let mut inner = self.inner.lock().unwrap();
+        let Some(template) = &inner.template else {
+            return Vec::new();
+        };
+        let missing = template
+            .size
+            .saturating_sub(inner.ready.len() + inner.filling);
+        let tickets = (0..missing)
+            .map(|_| RefillTicket {
+                options: template.options.clone(),
+                generation: inner.generation,
+            })
+            .collect();
+        inner.filling += missing;
+        tickets
+    }
+
+    /// Record that a ticket's box exists (persisted, still booting), so it
+    /// is hidden from listing from now on.
+    pub(crate) fn adopt(&self, id: &BoxID) {
+        self.inner.lock().unwrap().members.insert(id.clone());
+    }
+
+    /// Hand a booted entry to the pool. Returns it back if its template was
+    /// replaced while it booted or the pool is already full; the caller
+    /// then stops it.
+    pub(crate) fn fill(&self, ticket: RefillTicket, id: BoxID, entry: T) -> Option<T> {
+        let mut inner = self.inner.lock().unwrap();
+        if ticket.generation != inner.generation {
+            inner.members.remove(&id);
+            return Some(entry);
+        }
+        inner.filling = inner.filling.saturating_sub(1);
+        let size = inner.template.as_ref().map_or(0, |t| t.size);
+        if inner.ready.len() >= size {
+            inner.members.remove(&id);
+            return Some(entry);
+        }
+        inner.ready.push_back((id, entry));
+        self.metrics
+            .warm_pool_refills
+            .fetch_add(1, Ordering::Relaxed);
+        self.publish_ready(&inner);
+        None
+    }
+
+    /// Give back a ticket whose boot failed.
+    pub(crate) fn abandon(&self, ticket: RefillTicket, id: Option<&BoxID>) {
+        let mut inner = self.inner.lock().unwrap();
+        if ticket.generation == inner.generation {
+            inner.filling = inner.filling.saturating_sub(1);
+        }
+        if let Some(id) = id {
+            inner.members.remove(id);
+        }
+    }
+
+    /// Whether `id` belongs to the pool (not yet claimed).
+    pub(crate) fn is_member(&self, id: &BoxID) -> bool {
+        self.inner.lock().unwrap().members.contains(id)
+    }
+
+    /// Disable the pool and return every ready entry, for shutdown.
+    pub(crate) fn drain(&self) -> Vec<T> {
+        let mut inner = self.inner.lock().unwrap();
+        inner.template = None;
+        inner.generation += 1;
+        inner.filling = 0;
+        inner.members.clear();
+        let entries = inner.ready.drain(..).map(|(_, entry)| entry).collect();
+        self.metrics.warm_pool_size.store(0, Ordering::Relaxed);
+        self.publish_ready(&inner);
+        entries
+    }
+
+    fn publish_ready(&self, inner: &PoolInner<T>) {
+        self.metrics
+            .warm_pool_ready
+            .store(inner.ready.len() as u64, Ordering::Relaxed);
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::metrics::RuntimeMetrics;
+    use crate::runtime::id::BoxIDMint;
+
+    fn options(image: &str) -> BoxOptions {
+        BoxOptions {
+            rootfs: crate::runtime::options::RootfsSpec::Image(image.into()),
+            ..Default::default()
+        }
+    }
+
+    fn pool() -> (WarmPool<u32>, RuntimeMetrics) {
+        let storage = RuntimeMetricsStorage::new();
+        (WarmPool::new(storage.clone()), RuntimeMetrics::new(storage))
+    }
+
+    /// Boot one entry; any other reserved boots are given back.
+    fn boot(pool: &WarmPool<u32>, value: u32) -> BoxID {
+        let mut tickets = pool.reserve();
+        let ticket = tickets.pop().expect("ticket");
+        for other in tickets {
+            pool.abandon(other, None);
+        }
+        let id = BoxIDMint::mint();
+        pool.adopt(&id);
+        assert!(pool.fill(ticket, id.clone(), value).is_none());
+        id
+    }
+
+    #[test]
+    fn claims_matching_shape_and_counts_hits_and_misses() {
+        let (pool, metrics) = pool();
+        pool.configure(options("alpine"), 2).unwrap();
+        let tickets = pool.reserve();
+        assert_eq!(tickets.len(), 2);
+        pool.configure(options("alpine"), 2).unwrap();
+        assert!(pool.reserve().is_empty(), "boots already in flight");
+        for ticket in tickets {
+            pool.abandon(ticket, None);
+        }
+
+        let mut dead = Vec::new();
+        let id = boot(&pool, 7);
+        assert!(pool.is_member(&id));
+        assert_eq!(metrics.warm_pool_ready(), 1);
+
+        assert!(matches!(
+            pool.take(&options("ubuntu"), |_| true, &mut dead),
+            Take::Unpooled
+        ));
+        assert!(matches!(
+            pool.take(&options("alpine"), |_| true, &mut dead),
+            Take::Hit(7)
+        ));
+        assert!(!pool.is_member(&id));
+        assert!(matches!(
+            pool.take(&options("alpine"), |_| true, &mut dead),
+            Take::Miss
+        ));
+        assert_eq!(metrics.warm_pool_hits_total(), 1);
+        assert_eq!(metrics.warm_pool_misses_total(), 1);
+        assert_eq!(metrics.warm_pool_refills_total(), 1);
+        assert_eq!(metrics.warm_pool_size(), 2);
+    }
+
+    #[test]
+    fn dead_entries_are_skipped() {
+        let (pool, _) = pool();
+        pool.configure(options("alpine"), 2).unwrap();
+        boot(&pool, 1);
+        boot(&pool, 2);
+        let mut dead = Vec::new();
+        assert!(matches!(
+            pool.take(&options("alpine"), |v| *v != 1, &mut dead),
+            Take::Hit(2)
+        ));
+        assert_eq!(dead, vec![1]);
+    }
+
+    #[test]
+    fn reconfiguring_discards_old_entries_and_boots() {
+        let (pool, metrics) = pool();
+        pool.configure(options("alpine"), 1).unwrap();
+        boot(&pool, 1);
+        assert!(pool.reserve().is_empty());
+        pool.configure(options("alpine"), 2).unwrap();
+        let late = pool.reserve().pop().expect("ticket");
+
+        let stale = pool.configure(options("ubuntu"), 1).unwrap();
+        assert_eq!(stale, vec![1]);
+        assert_eq!(metrics.warm_pool_ready(), 0);
+        // A boot started for the old template is handed back.
+        assert_eq!(pool.fill(late, BoxIDMint::mint(), 9), Some(9));
+
+        assert!(pool.configure(options("ubuntu"), 0).unwrap().is_empty());
+        assert!(pool.reserve().is_empty());
+        assert_eq!(metrics.warm_pool_size(), 0);
+    }
+
+    #[test]
+    fn rejects_templates_that_outlive_the_pool() {
+        let (pool, _) = pool();
+        let detached = BoxOptions {
+            detach: true,
+            ..options("alpine")
+        };
+        assert!(pool.configure(detached, 1).is_err());
+        let kept = BoxOptions {
+            auto_remove: false,
+            ..options("alpine")
+        };
+        assert!(pool.configure(kept, 1).is_err());
+    }
+
+    #[test]
+    fn drain_returns_ready_entries() {
+        let (pool, metrics) = pool();
+        pool.configure(options("alpine"), 2).unwrap();
+        let id = boot(&pool, 1);
+        assert_eq!(pool.drain(), vec![1]);
+        assert!(!pool.is_member(&id));
+        assert_eq!(metrics.warm_pool_ready(), 0);
+        assert!(pool.reserve().is_empty());
+    }
+}
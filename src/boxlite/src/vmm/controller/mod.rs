@@ -29,6 +29,9 @@ pub use shim::{ShimController, ShimHandler};
 pub struct VmmMetrics {
     pub cpu_percent: Option<f32>,
     pub memory_bytes: Option<u64>,
+    /// Resident memory of every host process in the box's sandbox
+    /// (launcher, shim and VM), including guest RAM the VM has touched.
+    pub host_rss_bytes: Option<u64>,
     pub disk_bytes: Option<u64>,
 }
 
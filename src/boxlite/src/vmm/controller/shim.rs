@@ -5,6 +5,7 @@ use std::{path::PathBuf, process::Child, sync::Mutex, time::Instant};
 use crate::{
     BoxID,
     runtime::layout::BoxFilesystemLayout,
+    runtime::placement::BoxPlacement,
     vmm::{InstanceSpec, VmmKind},
 };
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
@@ -25,7 +26,6 @@ use super::{
 /// Works for both spawned VMs and reconnected VMs (same operations).
 pub struct ShimHandler {
     pid: u32,
-    #[allow(dead_code)]
     box_id: BoxID,
     /// Child process handle for proper lifecycle management.
     /// When we spawn the process, we keep the Child to properly wait() on stop.
@@ -201,9 +201,30 @@ impl VmmHandlerTrait for ShimHandler {
 
         // Try to get process information
         if let Some(proc_info) = sys.process(pid) {
+            let cpu_percent = Some(proc_info.cpu_usage());
+            let memory_bytes = Some(proc_info.memory());
+
+            // With the jailer, the recorded pid is the outer launcher and the
+            // VM's RSS lives in a descendant; sum the box's whole cgroup.
+            let pids = crate::jailer::box_pids(&self.box_id);
+            let host_rss_bytes = if pids.is_empty() {
+                memory_bytes
+            } else {
+                let mut total = 0;
+                for pid in pids.into_iter().map(Pid::from_u32) {
+                    if sys.refresh_process(pid)
+                        && let Some(proc_info) = sys.process(pid)
+                    {
+                        total += proc_info.memory();
+                    }
+                }
+                Some(total)
+            };
+
             return Ok(VmmMetrics {
-                cpu_percent: Some(proc_info.cpu_usage()),
-                memory_bytes: Some(proc_info.memory()),
+                cpu_percent,
+                memory_bytes,
+                host_rss_bytes,
                 disk_bytes: None, // Not available from process-level APIs
             });
         }
@@ -257,6 +278,8 @@ pub struct ShimController {
     options: crate::runtime::options::BoxOptions,
     /// Box filesystem layout (provides paths for stderr, sockets, etc.)
     layout: BoxFilesystemLayout,
+    /// Host CPU / NUMA placement resolved for this start.
+    placement: Option<BoxPlacement>,
 }
 
 impl ShimController {
@@ -293,8 +316,15 @@ impl ShimController {
             box_id,
             options,
             layout,
+            placement: None,
         })
     }
+
+    /// Spawn the shim confined to `placement`.
+    pub fn with_placement(mut self, placement: Option<BoxPlacement>) -> Self {
+        self.placement = placement;
+        self
+    }
 }
 
 #[async_trait::async_trait]
@@ -370,7 +400,8 @@ impl VmmController for ShimController {
             &self.layout,
             self.box_id.as_str(),
             &self.options,
-        );
+        )
+        .with_placement(self.placement.as_ref());
         let spawned = spawner.spawn(&config_json, config.detach)?;
         // spawn_duration: time to create Box subprocess
         let shim_spawn_duration = shim_spawn_start.elapsed();
@@ -8,6 +8,7 @@ use std::{
 use crate::jailer::{Jail, JailerBuilder, process_env::shim_process_env};
 use crate::runtime::layout::BoxFilesystemLayout;
 use crate::runtime::options::BoxOptions;
+use crate::runtime::placement::BoxPlacement;
 use crate::util::configure_library_env;
 use boxlite_shared::errors::{BoxliteError, BoxliteResult};
 
@@ -38,6 +39,7 @@ pub struct ShimSpawner<'a> {
     layout: &'a BoxFilesystemLayout,
     box_id: &'a str,
     options: &'a BoxOptions,
+    placement: Option<&'a BoxPlacement>,
 }
 
 impl<'a> ShimSpawner<'a> {
@@ -52,9 +54,16 @@ impl<'a> ShimSpawner<'a> {
             layout,
             box_id,
             options,
+            placement: None,
         }
     }
 
+    /// Confine the shim (and so every vCPU thread) to a resolved placement.
+    pub fn with_placement(mut self, placement: Option<&'a BoxPlacement>) -> Self {
+        self.placement = placement;
+        self
+    }
+
     /// Spawn the shim subprocess with jailer isolation and optional watchdog.
     ///
     /// When `detach` is false, creates a watchdog pipe so the shim detects
@@ -79,7 +88,8 @@ impl<'a> ShimSpawner<'a> {
             .with_layout(self.layout.clone())
             .with_security(self.options.advanced.security.clone())
             .with_volumes(self.options.volumes.clone())
-            .with_detach(detach);
+            .with_detach(detach)
+            .with_placement(self.placement.cloned());
 
         if let Some(ref setup) = child_setup {
             builder = builder.with_preserved_fd(setup.raw_fd(), watchdog::PIPE_FD);
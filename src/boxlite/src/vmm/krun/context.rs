@@ -398,13 +398,21 @@ impl KrunContext {
     /// * `host_path` - Path to directory on host to share
     /// * `mount_tag` - Tag used by guest to mount this share (e.g., "layer0", "upper")
     /// * `read_only` - If true, the filesystem is exposed as read-only at the hypervisor level
+    /// * `dax_window` - Size in bytes of the DAX shared-memory window (0 = no DAX)
     pub unsafe fn add_virtiofs(
         &self,
         mount_tag: &str,
         host_path: &str,
         read_only: bool,
+        dax_window: u64,
     ) -> BoxliteResult<()> {
-        tracing::debug!(host_path, mount_tag, read_only, "Adding virtiofs mount");
+        tracing::debug!(
+            host_path,
+            mount_tag,
+            read_only,
+            dax_window,
+            "Adding virtiofs mount"
+        );
 
         let host_path_c = CString::new(host_path)
             .map_err(|e| BoxliteError::Engine(format!("invalid host path: {e}")))?;
@@ -416,7 +424,7 @@ impl KrunContext {
                 self.ctx_id,
                 mount_tag_c.as_ptr(),
                 host_path_c.as_ptr(),
-                0,
+                dax_window,
                 read_only,
             )
         })
@@ -354,12 +354,13 @@ impl Vmm for Krun {
                 })?;
 
                 tracing::info!(
-                    "  {} → {} ({})",
+                    "  {} → {} ({}, dax window {} bytes)",
                     share.tag,
                     share.host_path.display(),
-                    if share.read_only { "ro" } else { "rw" }
+                    if share.read_only { "ro" } else { "rw" },
+                    share.dax_window
                 );
-                ctx.add_virtiofs(&share.tag, path_str, share.read_only)?;
+                ctx.add_virtiofs(&share.tag, path_str, share.read_only, share.dax_window)?;
             }
 
             // Attach disk images via virtio-blk
@@ -58,6 +58,9 @@ pub struct FsShare {
     pub host_path: PathBuf,
     /// Whether the share is read-only
     pub read_only: bool,
+    /// DAX window size in bytes (0 = no DAX)
+    #[serde(default)]
+    pub dax_window: u64,
 }
 
 /// Collection of filesystem shares from host to guest.
@@ -71,11 +74,12 @@ impl FsShares {
         Self { shares: Vec::new() }
     }
 
-    pub fn add(&mut self, tag: impl Into<String>, path: PathBuf, read_only: bool) {
+    pub fn add(&mut self, tag: impl Into<String>, path: PathBuf, read_only: bool, dax_window: u64) {
         self.shares.push(FsShare {
             tag: tag.into(),
             host_path: path,
             read_only,
+            dax_window,
         });
     }
 
@@ -10,6 +10,7 @@
 use std::path::PathBuf;
 
 use super::guest_volume::GuestVolumeManager;
+use crate::runtime::options::VolumeTuning;
 
 /// Container bind mount entry.
 ///
@@ -68,6 +69,7 @@ impl<'a> ContainerVolumeManager<'a> {
     /// * `host_path` - Path on host to share
     /// * `container_path` - Mount point in container (user-specified)
     /// * `read_only` - Whether the mount is read-only
+    /// * `tuning` - Sharing performance mode of the underlying virtiofs share
     #[allow(clippy::too_many_arguments)]
     pub fn add_volume(
         &mut self,
@@ -80,6 +82,7 @@ impl<'a> ContainerVolumeManager<'a> {
         owner_uid: u32,
         owner_gid: u32,
         subpath: Option<String>,
+        tuning: VolumeTuning,
     ) {
         // Add virtiofs share to guest with container_id
         // Guest will mount at convention path: /run/boxlite/shared/containers/{container_id}/volumes/{tag}
@@ -89,6 +92,7 @@ impl<'a> ContainerVolumeManager<'a> {
             None,
             read_only,
             Some(container_id.to_string()),
+            tuning,
         );
 
         // Record container bind mount - guest constructs source path from convention
@@ -141,6 +145,7 @@ mod tests {
             0,
             0,
             Some("app.conf".to_string()),
+            VolumeTuning::default(),
         );
 
         let mounts = mgr.build_container_mounts();
@@ -10,6 +10,7 @@ use std::path::{Path, PathBuf};
 
 use crate::disk::DiskFormat;
 use crate::portal::interfaces::VolumeConfig;
+use crate::runtime::options::VolumeTuning;
 use crate::vmm::{BlockDevice, BlockDevices, FsShares};
 
 /// Tracked virtiofs share entry.
@@ -23,6 +24,8 @@ pub struct FsShareEntry {
     pub read_only: bool,
     /// Optional container_id for convention-based paths.
     pub container_id: Option<String>,
+    /// DAX window and mount options.
+    pub tuning: VolumeTuning,
 }
 
 /// Tracked block device entry.
@@ -77,6 +80,7 @@ impl GuestVolumeManager {
     ///
     /// `guest_path`: Where to mount in guest. `None` = guest determines from tag.
     /// `container_id`: For user volumes, enables convention-based paths.
+    /// `tuning`: DAX window (VMM side) and mount options (guest side).
     pub fn add_fs_share(
         &mut self,
         tag: &str,
@@ -84,6 +88,7 @@ impl GuestVolumeManager {
         guest_path: Option<&str>,
         read_only: bool,
         container_id: Option<String>,
+        tuning: VolumeTuning,
     ) {
         self.fs_shares.push(FsShareEntry {
             tag: tag.to_string(),
@@ -91,6 +96,7 @@ impl GuestVolumeManager {
             guest_path: guest_path.map(String::from),
             read_only,
             container_id,
+            tuning,
         });
     }
 
@@ -154,7 +160,12 @@ impl GuestVolumeManager {
     pub fn build_vmm_config(&self) -> VmmMountConfig {
         let mut fs_shares = FsShares::new();
         for entry in &self.fs_shares {
-            fs_shares.add(&entry.tag, entry.host_path.clone(), entry.read_only);
+            fs_shares.add(
+                &entry.tag,
+                entry.host_path.clone(),
+                entry.read_only,
+                entry.tuning.dax_window_bytes,
+            );
         }
 
         let mut block_devices = BlockDevices::new();
@@ -192,6 +203,7 @@ impl GuestVolumeManager {
                 mount_point,
                 entry.read_only,
                 entry.container_id.clone(),
+                entry.tuning,
             ));
         }
 
@@ -731,6 +731,7 @@ impl VolumeFlags {
                 host_path,
                 guest_path: spec.guest_path,
                 read_only: spec.read_only,
+                tuning: None,
             });
         }
         Ok(())
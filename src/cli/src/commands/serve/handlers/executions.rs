@@ -5,13 +5,13 @@ use std::time::Duration;
 
 use axum::Json;
 use axum::extract::ws::{Message, WebSocket, WebSocketUpgrade};
-use axum::extract::{Path, State};
+use axum::extract::{Path, Query, State};
 use axum::http::StatusCode;
 use axum::response::{IntoResponse, Response};
 use futures::SinkExt;
 use futures::StreamExt;
 
-use super::super::types::{ExecRequest, ExecResponse, ResizeRequest, SignalRequest};
+use super::super::types::{AttachQuery, ExecRequest, ExecResponse, ResizeRequest, SignalRequest};
 use super::super::{
     ActiveExecution, AppState, build_box_command, error_from_boxlite, error_response,
     get_or_fetch_box,
@@ -225,6 +225,12 @@ pub(in crate::commands::serve) async fn resize_tty(
 // control messages (Text JSON: resize/signal/stdin_eof in; exit/error out).
 // Mirrors the Go runner's `/attach` wire format so the SDK speaks one
 // protocol regardless of which runtime backs the request.
+//
+// A reattaching client passes `?stdout_offset=N&stderr_offset=M` (bytes it
+// already has). Replay then starts at those offsets instead of the start of
+// the backlog, and the first frame is `{"type":"resume",...}` carrying the
+// offsets replay actually starts at, so the client can tell a clean resume
+// from one that lost bytes to backlog eviction.
 
 const ATTACH_KEEPALIVE_INTERVAL: Duration = Duration::from_secs(15);
 const ATTACH_WRITE_TIMEOUT: Duration = Duration::from_secs(20);
@@ -232,6 +238,7 @@ const ATTACH_WRITE_TIMEOUT: Duration = Duration::from_secs(20);
 pub(in crate::commands::serve) async fn attach_execution(
     State(state): State<Arc<AppState>>,
     Path((box_id, exec_id)): Path<(String, String)>,
+    Query(query): Query<AttachQuery>,
     ws: WebSocketUpgrade,
 ) -> Response {
     let executions = state.executions.read().await;
@@ -261,13 +268,18 @@ pub(in crate::commands::serve) async fn attach_execution(
         });
     })
     .on_upgrade(move |socket| async move {
-        run_attach_session(socket, active).await;
+        run_attach_session(socket, active, query).await;
     })
 }
 
-async fn run_attach_session(socket: WebSocket, active: Arc<ActiveExecution>) {
-    let mut stdout_rx = active.stdout_bus().subscribe();
-    let mut stderr_rx = active.stderr_bus().subscribe();
+async fn run_attach_session(socket: WebSocket, active: Arc<ActiveExecution>, query: AttachQuery) {
+    let resuming = query.stdout_offset.is_some() || query.stderr_offset.is_some();
+    let (mut stdout_rx, stdout_offset) = active
+        .stdout_bus()
+        .subscribe_from(query.stdout_offset.unwrap_or(0));
+    let (mut stderr_rx, stderr_offset) = active
+        .stderr_bus()
+        .subscribe_from(query.stderr_offset.unwrap_or(0));
     let mut done_rx = active.done_rx();
     let (mut sink, mut stream) = socket.split();
 
@@ -444,6 +456,17 @@ async fn run_attach_session(socket: WebSocket, active: Arc<ActiveExecution>) {
             }};
         }
 
+        if resuming {
+            let resume = serde_json::json!({
+                "type": "resume",
+                "stdout_offset": stdout_offset,
+                "stderr_offset": stderr_offset,
+            });
+            if !ws_send(&mut sink, Message::Text(resume.to_string().into())).await {
+                return;
+            }
+        }
+
         // Fast path: process already exited before WS connected.
         // done.store(true) is set after all stdout/stderr pumps finish,
         // so the backlog has every byte the process ever wrote.
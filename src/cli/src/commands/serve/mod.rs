@@ -156,6 +156,9 @@ struct BacklogBroadcast {
 struct BacklogState {
     backlog: std::collections::VecDeque<Vec<u8>>,
     total_bytes: usize,
+    /// Stream offset of the first backlog byte: everything before it has
+    /// been evicted. Lets a reconnecting client resume by byte offset.
+    start_offset: u64,
 }
 
 impl BacklogBroadcast {
@@ -166,6 +169,7 @@ impl BacklogBroadcast {
             state: std::sync::Mutex::new(BacklogState {
                 backlog: std::collections::VecDeque::new(),
                 total_bytes: 0,
+                start_offset: 0,
             }),
             cap: backlog_cap,
         }
@@ -180,6 +184,7 @@ impl BacklogBroadcast {
         while state.total_bytes > self.cap && state.backlog.len() > 1 {
             if let Some(old) = state.backlog.pop_front() {
                 state.total_bytes -= old.len();
+                state.start_offset += old.len() as u64;
             } else {
                 break;
             }
@@ -195,10 +200,28 @@ impl BacklogBroadcast {
     /// broadcast subscribe happen under the state lock, which `send()`
     /// also holds through its `tx.send()`, preventing duplicates.
     fn subscribe(&self) -> BacklogReceiver {
+        self.subscribe_from(0).0
+    }
+
+    /// Subscribe with replay starting at stream byte `offset`, for a client
+    /// resuming after a reconnect. Returns the receiver together with the
+    /// offset its first byte actually sits at: later than `offset` when
+    /// those bytes were already evicted, never past the end of the stream.
+    fn subscribe_from(&self, offset: u64) -> (BacklogReceiver, u64) {
         let state = self.state.lock().unwrap();
-        let replay: std::collections::VecDeque<Vec<u8>> = state.backlog.iter().cloned().collect();
+        let mut replay = std::collections::VecDeque::new();
+        let mut pos = state.start_offset;
+        for chunk in &state.backlog {
+            let end = pos + chunk.len() as u64;
+            if end > offset {
+                let skip = offset.saturating_sub(pos) as usize;
+                replay.push_back(chunk[skip..].to_vec());
+            }
+            pos = end;
+        }
+        let resumed_at = offset.clamp(state.start_offset, pos);
         let rx = self.tx.subscribe();
-        BacklogReceiver { replay, rx }
+        (BacklogReceiver { replay, rx }, resumed_at)
     }
 }
 
@@ -266,21 +289,26 @@ impl ActiveExecution {
         // fan out via the backlog-aware broadcast. Unlike raw broadcast,
         // BacklogBroadcast retains recent output so late subscribers
         // see the backlog on subscribe.
-        let stdout_handle = if let Some(mut out) = stdout {
+        //
+        // Output is read in byte mode: the attach protocol carries raw
+        // frames, so binary output must not be forced through UTF-8.
+        let stdout_handle = if let Some(out) = stdout {
             let bus = stdout_bus;
+            let mut out = out.into_bytes();
             Some(tokio::spawn(async move {
-                while let Some(line) = out.next().await {
-                    bus.send(line.into_bytes());
+                while let Some(chunk) = out.next().await {
+                    bus.send(Vec::from(chunk));
                 }
             }))
         } else {
             None
         };
-        let stderr_handle = if let Some(mut err) = stderr {
+        let stderr_handle = if let Some(err) = stderr {
             let bus = stderr_bus;
+            let mut err = err.into_bytes();
             Some(tokio::spawn(async move {
-                while let Some(line) = err.next().await {
-                    bus.send(line.into_bytes());
+                while let Some(chunk) = err.next().await {
+                    bus.send(Vec::from(chunk));
                 }
             }))
         } else {
@@ -1105,8 +1133,8 @@ mod tests {
     /// stdout/stderr/result channels we control from the test.
     fn make_test_active() -> (
         Arc<ActiveExecution>,
-        tokio::sync::mpsc::UnboundedSender<String>, // stdout driver
-        tokio::sync::mpsc::UnboundedSender<String>, // stderr driver
+        tokio::sync::mpsc::UnboundedSender<bytes::Bytes>, // stdout driver
+        tokio::sync::mpsc::UnboundedSender<bytes::Bytes>, // stderr driver
         tokio::sync::mpsc::UnboundedSender<boxlite::ExecResult>, // result driver
     ) {
         let (exec, stdout_tx, stderr_tx, _stdin_rx, result_tx) =
@@ -1135,7 +1163,7 @@ mod tests {
         // task inside ActiveExecution::new reads these and broadcasts
         // them.
         for i in 1..=5 {
-            stdout_tx.send(format!("line-{i}\n")).unwrap();
+            stdout_tx.send(format!("line-{i}\n").into()).unwrap();
         }
         // Give the pump task a tick to broadcast all 5 chunks.
         tokio::time::sleep(Duration::from_millis(50)).await;
@@ -1147,7 +1175,7 @@ mod tests {
 
         // Push one more line AFTER the subscribe so we can prove the
         // channel is alive.
-        stdout_tx.send("line-6\n".to_string()).unwrap();
+        stdout_tx.send("line-6\n".into()).unwrap();
         tokio::time::sleep(Duration::from_millis(20)).await;
 
         let mut received = Vec::new();
@@ -1167,6 +1195,34 @@ mod tests {
         );
     }
 
+    #[test]
+    fn subscribe_from_resumes_at_byte_offset() {
+        let bus = BacklogBroadcast::new(16, 8);
+        for chunk in ["abcd", "efgh", "ijkl"] {
+            bus.send(chunk.as_bytes().to_vec());
+        }
+        let drain = |mut rx: BacklogReceiver| {
+            let mut out = Vec::new();
+            while let Ok(chunk) = rx.try_recv() {
+                out.extend(chunk);
+            }
+            String::from_utf8(out).unwrap()
+        };
+
+        // Mid-chunk resume replays only the bytes the client is missing.
+        let (rx, at) = bus.subscribe_from(6);
+        assert_eq!((drain(rx).as_str(), at), ("ghijkl", 6));
+
+        // "abcd" was evicted by the 8-byte cap: replay starts later than
+        // asked and says so.
+        let (rx, at) = bus.subscribe_from(0);
+        assert_eq!((drain(rx).as_str(), at), ("efghijkl", 4));
+
+        // A client that already has everything gets only live data.
+        let (rx, at) = bus.subscribe_from(100);
+        assert_eq!((drain(rx).as_str(), at), ("", 12));
+    }
+
     // ---------------------------------------------------------------
     // Finding 2: final stdout chunk lost on fast process exit
     // ---------------------------------------------------------------
@@ -1194,7 +1250,7 @@ mod tests {
 
         // Push output, then signal exit immediately. The pump task
         // must read from ExecStdout and broadcast BEFORE done fires.
-        stdout_tx.send("final-line\n".to_string()).unwrap();
+        stdout_tx.send("final-line\n".into()).unwrap();
         drop(stdout_tx);
         drop(stderr_tx);
         result_tx
@@ -263,3 +263,13 @@ pub(super) struct RemoveQuery {
 pub(super) struct FileQuery {
     pub path: String,
 }
+
+/// Resume point for a reattaching client: bytes of each stream it has
+/// already received. Absent on a first attach, which replays the backlog.
+#[derive(Deserialize)]
+pub(super) struct AttachQuery {
+    #[serde(default)]
+    pub stdout_offset: Option<u64>,
+    #[serde(default)]
+    pub stderr_offset: Option<u64>,
+}
@@ -0,0 +1,165 @@
+//! Guest memory reclaim.
+//!
+//! The VMM's virtio-balloon device runs with free-page reporting: pages the
+//! guest kernel frees are handed back to the host. An idle guest never frees
+//! its page cache on its own, though, so reclaim drops clean cache and then
+//! compacts free memory into blocks large enough to be reported.
+
+use std::time::Duration;
+
+use boxlite_shared::{GuestMemory, MemoryReclaim};
+use tracing::{debug, info, warn};
+
+const MEMINFO: &str = "/proc/meminfo";
+const DROP_CACHES: &str = "/proc/sys/vm/drop_caches";
+const COMPACT_MEMORY: &str = "/proc/sys/vm/compact_memory";
+
+/// Memory before and after one reclaim pass.
+pub struct ReclaimOutcome {
+    pub before: GuestMemory,
+    pub after: GuestMemory,
+    /// False when in-use memory was already under the target.
+    pub reclaimed: bool,
+}
+
+/// Drop clean page cache and compact free memory, unless in-use memory
+/// (total - free) is already at or below `target_bytes`. A target of 0
+/// always reclaims.
+///
+/// Blocking: writes back dirty pages first, since only clean cache can be
+/// dropped.
+pub fn reclaim(target_bytes: u64) -> ReclaimOutcome {
+    let before = read_meminfo();
+    if target_bytes > 0 && in_use(&before) <= target_bytes {
+        return ReclaimOutcome {
+            after: before.clone(),
+            before,
+            reclaimed: false,
+        };
+    }
+
+    unsafe {
+        nix::libc::sync();
+    }
+    // 1 = page cache only. Dentries and inodes are small and stay hot.
+    write_knob(DROP_CACHES, "1");
+    // Needs CONFIG_COMPACTION; without it reporting still sees whatever
+    // free blocks happen to be large enough.
+    write_knob(COMPACT_MEMORY, "1");
+
+    let after = read_meminfo();
+    debug!(
+        in_use_before = in_use(&before),
+        in_use_after = in_use(&after),
+        "Reclaimed guest memory"
+    );
+    ReclaimOutcome {
+        before,
+        after,
+        reclaimed: true,
+    }
+}
+
+/// Run [`reclaim`] every `interval_secs` for the life of the agent.
+pub fn spawn_reclaim_loop(config: MemoryReclaim) {
+    let interval = Duration::from_secs(u64::from(config.interval_secs.max(1)));
+    let target_bytes = config.target_bytes;
+    info!(
+        target_bytes,
+        interval_secs = interval.as_secs(),
+        "Starting periodic memory reclaim"
+    );
+
+    tokio::spawn(async move {
+        let mut ticker = tokio::time::interval(interval);
+        ticker.set_missed_tick_behavior(tokio::time::MissedTickBehavior::Skip);
+        // The first tick completes immediately; nothing to reclaim at boot.
+        ticker.tick().await;
+        loop {
+            ticker.tick().await;
+            match tokio::task::spawn_blocking(move || reclaim(target_bytes)).await {
+                Ok(outcome) if outcome.reclaimed => debug!(
+                    freed_bytes = outcome
+                        .after
+                        .free_bytes
+                        .saturating_sub(outcome.before.free_bytes),
+                    "Periodic memory reclaim"
+                ),
+                Ok(_) => {}
+                Err(e) => warn!(error = %e, "Memory reclaim task failed"),
+            }
+        }
+    });
+}
+
+/// Current `/proc/meminfo` figures; zeros if it cannot be read.
+pub fn read_meminfo() -> GuestMemory {
+    match std::fs::read_to_string(MEMINFO) {
+        Ok(content) => parse_meminfo(&content),
+        Err(e) => {
+            warn!(error = %e, "Failed to read {}", MEMINFO);
+            GuestMemory::default()
+        }
+    }
+}
+
+fn parse_meminfo(content: &str) -> GuestMemory {
+    let mut memory = GuestMemory::default();
+    for line in content.lines() {
+        let mut fields = line.split_whitespace();
+        let (Some(key), Some(Ok(kib))) = (fields.next(), fields.next().map(str::parse::<u64>))
+        else {
+            continue;
+        };
+        let bytes = kib.saturating_mul(1024);
+        match key {
+            "MemTotal:" => memory.total_bytes = bytes,
+            "MemFree:" => memory.free_bytes = bytes,
+            "MemAvailable:" => memory.available_bytes = bytes,
+            "Cached:" => memory.cached_bytes = bytes,
+            _ => {}
+        }
+    }
+    memory
+}
+
+fn in_use(memory: &GuestMemory) -> u64 {
+    memory.total_bytes.saturating_sub(memory.free_bytes)
+}
+
+fn write_knob(path: &str, value: &str) {
+    if let Err(e) = std::fs::write(path, value) {
+        debug!(path, error = %e, "Failed to write memory knob");
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn parse_meminfo_reads_fields_in_bytes() {
+        let memory = parse_meminfo(
+            "MemTotal:        2028768 kB\n\
+             MemFree:          812340 kB\n\
+             MemAvailable:    1654020 kB\n\
+             Buffers:           21020 kB\n\
+             Cached:           803412 kB\n\
+             SwapCached:            0 kB\n\
+             HugePages_Total:       0\n",
+        );
+        assert_eq!(memory.total_bytes, 2_028_768 * 1024);
+        assert_eq!(memory.free_bytes, 812_340 * 1024);
+        assert_eq!(memory.available_bytes, 1_654_020 * 1024);
+        assert_eq!(memory.cached_bytes, 803_412 * 1024);
+        assert_eq!(in_use(&memory), (2_028_768 - 812_340) * 1024);
+    }
+
+    #[test]
+    fn parse_meminfo_ignores_malformed_lines() {
+        let memory = parse_meminfo("MemTotal: lots kB\nMemFree:\n\nCached: 4 kB\n");
+        assert_eq!(memory.total_bytes, 0);
+        assert_eq!(memory.free_bytes, 0);
+        assert_eq!(memory.cached_bytes, 4096);
+    }
+}
@@ -42,6 +42,9 @@ impl ExecStdin {
     }
 }
 
+/// Largest chunk read from a process pipe and sent as one output frame.
+const OUTPUT_CHUNK_BYTES: usize = 64 * 1024;
+
 // Shared output stream implementation
 struct OutputStream {
     inner: Pin<Box<dyn Stream<Item = Vec<u8>> + Send>>,
@@ -55,12 +58,14 @@ impl OutputStream {
 
         // Convert OwnedFd to tokio file
         let std_file = unsafe { std::fs::File::from_raw_fd(fd.into_raw_fd()) };
-        let file = tokio::fs::File::from_std(std_file);
-        let mut reader = tokio::io::BufReader::new(file);
+        let mut reader = tokio::fs::File::from_std(std_file);
 
-        // Read chunks as they arrive (works for both PTY and pipes)
+        // Read chunks as they arrive (works for both PTY and pipes). A read
+        // returns whatever the pipe holds, so a large buffer does not delay
+        // small writes; it lets a burst leave as one frame instead of many
+        // 1 KiB ones.
         let stream = stream! {
-            let mut buf = [0u8; 1024];
+            let mut buf = vec![0u8; OUTPUT_CHUNK_BYTES];
             loop {
                 match reader.read(&mut buf).await {
                     Ok(0) => break,  // EOF
@@ -29,9 +29,9 @@ pub(crate) use state::InitHealthCheck;
 use crate::service::exec::executor::{ContainerExecutor, GuestExecutor};
 use crate::service::server::GuestServer;
 use boxlite_shared::{
-    constants::executor as executor_const, AttachRequest, ExecError, ExecOutput, ExecRequest,
-    ExecResponse, ExecStdin, Execution, KillRequest, KillResponse, ResizeTtyRequest,
-    ResizeTtyResponse, SendInputAck, WaitRequest, WaitResponse,
+    constants::executor as executor_const, AttachRequest, ExecBatchRequest, ExecBatchResponse,
+    ExecError, ExecOutput, ExecRequest, ExecResponse, ExecStdin, Execution, KillRequest,
+    KillResponse, ResizeTtyRequest, ResizeTtyResponse, SendInputAck, WaitRequest, WaitResponse,
 };
 use futures::stream::Stream;
 use std::pin::Pin;
@@ -65,6 +65,34 @@ impl Execution for GuestServer {
         }
     }
 
+    async fn exec_batch(
+        &self,
+        request: Request<ExecBatchRequest>,
+    ) -> Result<Response<ExecBatchResponse>, Status> {
+        let requests = request.into_inner().requests;
+        debug!(count = requests.len(), "exec_batch request");
+
+        // Spawned in order: container builds serialize on the container
+        // mutex and the zygote socket anyway, so the win is the single
+        // round trip, not parallel spawning.
+        let mut responses = Vec::with_capacity(requests.len());
+        for req in requests {
+            let execution_id = req
+                .execution_id
+                .clone()
+                .unwrap_or_else(|| uuid::Uuid::new_v4().to_string());
+            let response = if self.registry.exists(&execution_id).await {
+                error_response(execution_id, "execution_exists", "Execution already exists")
+            } else {
+                spawn_execution(self, execution_id, req)
+                    .await
+                    .unwrap_or_else(|err_resp| err_resp)
+            };
+            responses.push(response);
+        }
+        Ok(Response::new(ExecBatchResponse { responses }))
+    }
+
     type AttachStream = Pin<Box<dyn Stream<Item = Result<ExecOutput, Status>> + Send + 'static>>;
 
     async fn attach(
@@ -177,17 +177,29 @@ impl ExecutionState {
         }
     }
 
-    /// Wait for a container process via zygote WNOHANG polling.
+    /// Wait for a container process via the zygote.
     ///
-    /// Container processes are children of the zygote (created by clone3).
-    /// Uses WNOHANG to avoid holding the zygote Mutex for the process lifetime.
-    /// Retries every 10ms until the process exits.
+    /// Container processes are children of the zygote (created by clone3),
+    /// so only it can reap them, and it uses WNOHANG to avoid holding the
+    /// zygote Mutex for the process lifetime. A pidfd tells us when the
+    /// process has exited, so the reaping request is sent once, as soon as
+    /// the exit happens. Without pidfd (pre-5.3 kernels) it falls back to
+    /// polling, starting at 1ms and backing off to 10ms so short commands
+    /// are not rounded up to a full poll interval.
     async fn wait_via_zygote(
         pid: nix::unistd::Pid,
     ) -> Result<crate::service::exec::exec_handle::ExitStatus, Status> {
         use crate::container::zygote;
         use crate::service::exec::exec_handle::ExitStatus;
 
+        const POLL_MIN: std::time::Duration = std::time::Duration::from_millis(1);
+        const POLL_MAX: std::time::Duration = std::time::Duration::from_millis(10);
+
+        if let Some(exited) = pidfd_exited(pid) {
+            exited.await;
+        }
+
+        let mut poll = POLL_MIN;
         loop {
             let result = tokio::task::spawn_blocking(move || {
                 zygote::ZYGOTE.get().expect("zygote not started").wait(pid)
@@ -198,7 +210,8 @@ impl ExecutionState {
 
             match result {
                 zygote::WaitResult::StillAlive => {
-                    tokio::time::sleep(std::time::Duration::from_millis(10)).await;
+                    tokio::time::sleep(poll).await;
+                    poll = (poll * 2).min(POLL_MAX);
                     continue;
                 }
                 zygote::WaitResult::Exited { code } => return Ok(ExitStatus::Code(code)),
@@ -281,7 +294,7 @@ impl ExecutionState {
             let handle = tokio::spawn(async move {
                 while let Some(chunk) = stdout.next().await {
                     let msg = ExecOutput {
-                        event: Some(exec_output::Event::Stdout(Stdout { data: chunk })),
+                        event: Some(exec_output::Event::Stdout(Stdout { data: chunk.into() })),
                     };
                     if tx.send(Ok(msg)).await.is_err() {
                         break;
@@ -299,7 +312,7 @@ impl ExecutionState {
             let handle = tokio::spawn(async move {
                 while let Some(chunk) = stderr.next().await {
                     let msg = ExecOutput {
-                        event: Some(exec_output::Event::Stderr(Stderr { data: chunk })),
+                        event: Some(exec_output::Event::Stderr(Stderr { data: chunk.into() })),
                     };
                     if tx.send(Ok(msg)).await.is_err() {
                         break;
@@ -371,3 +384,25 @@ impl ExecutionState {
         Ok(())
     }
 }
+
+/// Future that resolves once `pid` has exited, or `None` when the kernel
+/// has no pidfd support (or the process is already gone).
+///
+/// A pidfd becomes readable when its process exits, which works for any
+/// process in our PID namespace, not just our own children.
+fn pidfd_exited(pid: nix::unistd::Pid) -> Option<impl std::future::Future<Output = ()>> {
+    use std::os::fd::{FromRawFd, OwnedFd};
+    use tokio::io::unix::AsyncFd;
+    use tokio::io::Interest;
+
+    // SAFETY: pidfd_open takes no pointers; a non-negative result is a new fd we own.
+    let raw = unsafe { nix::libc::syscall(nix::libc::SYS_pidfd_open, pid.as_raw(), 0) };
+    if raw < 0 {
+        return None;
+    }
+    let fd = unsafe { OwnedFd::from_raw_fd(raw as i32) };
+    let fd = AsyncFd::with_interest(fd, Interest::READABLE).ok()?;
+    Some(async move {
+        let _ = fd.readable().await;
+    })
+}
@@ -2,11 +2,14 @@
 //! Files service implementation.
 //!
 //! Provides tar-based upload/download between host and the single container
-//! running inside the guest.
+//! running inside the guest, plus the manifest and patch calls behind delta
+//! sync (see `boxlite_shared::sync`).
 
 use crate::service::server::GuestServer;
+use boxlite_shared::sync::{PatchWriter, ScanOptions};
 use boxlite_shared::{
-    files_server::Files, DownloadChunk, DownloadRequest, UploadChunk, UploadResponse,
+    files_server::Files, DownloadChunk, DownloadRequest, ManifestChunk, ManifestRequest,
+    PatchChunk, UploadChunk, UploadResponse,
 };
 use std::path::{Path, PathBuf};
 use tokio::fs::File;
@@ -18,6 +21,7 @@ use tracing::info;
 
 const CHUNK_SIZE: usize = 1 << 20; // 1 MiB
 const MAX_UPLOAD_BYTES: u64 = 512 * 1024 * 1024; // 512 MiB safety cap
+const MANIFEST_BATCH: usize = 1024; // entries per ManifestChunk
 
 #[tonic::async_trait]
 impl Files for GuestServer {
@@ -51,6 +55,18 @@ impl Files for GuestServer {
         let mkdir_parents = first.mkdir_parents;
         let overwrite = first.overwrite;
 
+        // Delta sync clears entries whose kind changed before extracting.
+        if !first.remove_paths.is_empty() {
+            let root = dest_root.clone();
+            let remove = first.remove_paths.clone();
+            tokio::task::spawn_blocking(move || {
+                boxlite_shared::sync::remove_entries(&root, &remove)
+            })
+            .await
+            .map_err(|e| Status::internal(format!("remove task failed: {}", e)))?
+            .map_err(|e| Status::internal(e.to_string()))?;
+        }
+
         // Temp file to hold tar stream
         let temp_path =
             std::env::temp_dir().join(format!("boxlite-upload-{}.tar", uuid::Uuid::new_v4()));
@@ -207,6 +223,114 @@ impl Files for GuestServer {
 
         Ok(Response::new(ReceiverStream::new(rx)))
     }
+
+    type ManifestStream = ReceiverStream<Result<ManifestChunk, Status>>;
+
+    async fn manifest(
+        &self,
+        request: Request<ManifestRequest>,
+    ) -> Result<Response<Self::ManifestStream>, Status> {
+        let req = request.into_inner();
+        if req.path.is_empty() {
+            return Err(Status::invalid_argument("path is required"));
+        }
+        let container_id = self
+            .resolve_container_id(req.container_id.as_str())
+            .await
+            .map_err(Status::failed_precondition)?;
+        let root = self.container_rootfs(&container_id, &req.path)?;
+
+        let opts = ScanOptions {
+            checksum: req.checksum,
+            block_size: req.block_size,
+            follow_symlinks: false,
+        };
+        let paths = req.paths;
+        let entries = tokio::task::spawn_blocking(move || {
+            if paths.is_empty() {
+                boxlite_shared::sync::scan(&root, &opts)
+            } else {
+                boxlite_shared::sync::describe(&root, &paths, &opts)
+            }
+        })
+        .await
+        .map_err(|e| Status::internal(format!("manifest task failed: {}", e)))?
+        .map_err(|e| Status::internal(e.to_string()))?;
+
+        info!(
+            path = %req.path,
+            entries = entries.len(),
+            container_id = %container_id,
+            "manifest built"
+        );
+
+        let (tx, rx) = mpsc::channel::<Result<ManifestChunk, Status>>(4);
+        tokio::spawn(async move {
+            let mut entries = entries.into_iter().peekable();
+            while entries.peek().is_some() {
+                let chunk = ManifestChunk {
+                    entries: entries.by_ref().take(MANIFEST_BATCH).collect(),
+                };
+                if tx.send(Ok(chunk)).await.is_err() {
+                    break;
+                }
+            }
+        });
+
+        Ok(Response::new(ReceiverStream::new(rx)))
+    }
+
+    async fn patch(
+        &self,
+        request: Request<Streaming<PatchChunk>>,
+    ) -> Result<Response<UploadResponse>, Status> {
+        let mut stream = request.into_inner();
+
+        // First chunk must carry dest_path (and optional container_id)
+        let first = stream
+            .message()
+            .await?
+            .ok_or_else(|| Status::invalid_argument("empty patch stream"))?;
+        if first.dest_path.is_empty() {
+            return Err(Status::invalid_argument(
+                "dest_path is required in first chunk",
+            ));
+        }
+        let container_id = self
+            .resolve_container_id(first.container_id.as_str())
+            .await
+            .map_err(Status::failed_precondition)?;
+        let dest_root = self.container_rootfs(&container_id, &first.dest_path)?;
+
+        // Writes are blocking; the writer moves onto a blocking thread for
+        // each chunk and back.
+        let mut writer = PatchWriter::new(dest_root.clone());
+        let mut next = Some(first);
+        let mut total: u64 = 0;
+        while let Some(chunk) = next.take() {
+            total += chunk.data.len() as u64;
+            writer = tokio::task::spawn_blocking(move || writer.apply(&chunk).map(|()| writer))
+                .await
+                .map_err(|e| Status::internal(format!("patch task failed: {}", e)))?
+                .map_err(|e| Status::internal(e.to_string()))?;
+            next = stream.message().await?;
+        }
+        writer
+            .finish()
+            .map_err(|e| Status::invalid_argument(e.to_string()))?;
+
+        info!(
+            dest = %dest_root.display(),
+            bytes = total,
+            container_id = %container_id,
+            "patch completed"
+        );
+
+        Ok(Response::new(UploadResponse {
+            success: true,
+            error: None,
+        }))
+    }
 }
 
 impl GuestServer {
@@ -1,13 +1,14 @@
 //! Guest service implementation.
 //!
 //! Handles guest initialization and management (Init, Ping, Shutdown,
-//! Quiesce, Thaw RPCs).
+//! Quiesce, Thaw, ReclaimMemory RPCs).
 
 use crate::service::server::GuestServer;
 use boxlite_shared::{
     guest_init_response, Guest as GuestService, GuestInitError, GuestInitRequest,
     GuestInitResponse, GuestInitSuccess, PingRequest, PingResponse, QuiesceRequest,
-    QuiesceResponse, ShutdownRequest, ShutdownResponse, ThawRequest, ThawResponse,
+    QuiesceResponse, ReclaimMemoryRequest, ReclaimMemoryResponse, ShutdownRequest,
+    ShutdownResponse, ThawRequest, ThawResponse,
 };
 use tonic::{Request, Response, Status};
 use tracing::{debug, error, info};
@@ -19,6 +20,7 @@ impl GuestService for GuestServer {
     /// This must be called first after connection. It:
     /// 1. Mounts all volumes (virtiofs + block devices)
     /// 2. Configures network (if specified)
+    /// 3. Starts periodic memory reclaim (if specified)
     ///
     /// Note: Rootfs setup is handled by Container.Init.
     async fn init(
@@ -70,6 +72,11 @@ impl GuestService for GuestServer {
             }
         }
 
+        // Step 3: Start periodic memory reclaim (if specified)
+        if let Some(memory_reclaim) = req.memory_reclaim {
+            crate::memory::spawn_reclaim_loop(memory_reclaim);
+        }
+
         // Mark as initialized
         init_state.initialized = true;
 
@@ -153,4 +160,26 @@ impl GuestService for GuestServer {
 
         Ok(Response::new(ThawResponse { thawed_count }))
     }
+
+    /// Drop clean page cache and compact free memory, so free-page
+    /// reporting returns it to the host.
+    ///
+    /// Skipped when in-use memory is already under `target_bytes`.
+    async fn reclaim_memory(
+        &self,
+        request: Request<ReclaimMemoryRequest>,
+    ) -> Result<Response<ReclaimMemoryResponse>, Status> {
+        let target_bytes = request.into_inner().target_bytes;
+        info!(target_bytes, "Received memory reclaim request");
+
+        let outcome = tokio::task::spawn_blocking(move || crate::memory::reclaim(target_bytes))
+            .await
+            .map_err(|e| Status::internal(format!("memory reclaim task failed: {}", e)))?;
+
+        Ok(Response::new(ReclaimMemoryResponse {
+            before: Some(outcome.before),
+            after: Some(outcome.after),
+            reclaimed: outcome.reclaimed,
+        }))
+    }
 }
@@ -9,12 +9,24 @@ pub struct VirtiofsMount;
 
 impl VirtiofsMount {
     /// Mount virtiofs tag to mount point.
-    pub fn mount(tag: &str, mount_point: &Path, read_only: bool) -> BoxliteResult<()> {
+    ///
+    /// `dax` maps file pages through the DAX window the host reserved for
+    /// the share. If the kernel refuses it (no FUSE DAX support), the share
+    /// is mounted without DAX rather than failing the volume.
+    pub fn mount(
+        tag: &str,
+        mount_point: &Path,
+        read_only: bool,
+        dax: bool,
+        noatime: bool,
+    ) -> BoxliteResult<()> {
         tracing::info!(
-            "Mounting virtiofs: {} → {} ({})",
+            "Mounting virtiofs: {} → {} ({}, dax={}, noatime={})",
             tag,
             mount_point.display(),
-            if read_only { "ro" } else { "rw" }
+            if read_only { "ro" } else { "rw" },
+            dax,
+            noatime
         );
 
         // Create mount point
@@ -30,15 +42,25 @@ impl VirtiofsMount {
         if read_only {
             flags |= MsFlags::MS_RDONLY;
         }
+        if noatime {
+            flags |= MsFlags::MS_NOATIME;
+        }
 
-        mount(
-            Some(tag),
-            mount_point,
-            Some("virtiofs"),
-            flags,
-            None::<&str>,
-        )
-        .map_err(|e| {
+        let mount_with =
+            |data: Option<&str>| mount(Some(tag), mount_point, Some("virtiofs"), flags, data);
+        let mounted = if dax {
+            mount_with(Some("dax=always")).or_else(|e| {
+                tracing::warn!(
+                    "virtiofs {}: DAX mount refused ({}), mounting without DAX",
+                    tag,
+                    e
+                );
+                mount_with(None)
+            })
+        } else {
+            mount_with(None)
+        };
+        mounted.map_err(|e| {
             BoxliteError::Storage(format!(
                 "Failed to mount virtiofs {} to {}: {}",
                 tag,
@@ -29,7 +29,10 @@ fn get_protoc_version() -> Result<(u32, u32), Box<dyn std::error::Error>> {
 fn main() -> Result<(), Box<dyn std::error::Error>> {
     let mut config = tonic_build::configure()
         .build_server(true)
-        .build_client(true);
+        .build_client(true)
+        // Exec output chunks decode as refcounted `Bytes` slices of the
+        // received frame, so the host can forward them without copying.
+        .bytes([".boxlite.v1.Stdout.data", ".boxlite.v1.Stderr.data"]);
 
     // proto3 optional fields require protoc >= 3.12
     // For 3.12-3.14, we need --experimental_allow_proto3_optional
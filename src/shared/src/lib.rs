@@ -6,6 +6,7 @@
 pub mod constants;
 pub mod errors;
 pub mod layout;
+pub mod sync;
 pub mod tar;
 pub mod transport;
 
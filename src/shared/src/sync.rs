@@ -0,0 +1,1056 @@
+//! Delta sync of a directory tree between host and guest.
+//!
+//! The guest describes the destination tree as a manifest: kind, size,
+//! mtime and mode per entry, plus content or block hashes on request. The
+//! host diffs that against the same description of its source tree and
+//! sends only what changed: a tar of the new or modified entries (see
+//! [`pack_entries_to_writer`]) and, for large files modified in place, just
+//! the blocks that differ (see [`changed_ranges`] and [`PatchWriter`]).
+//!
+//! Like tar, manifests carry mtimes in whole seconds, so a file that was
+//! copied once compares equal on the next sync.
+//!
+//! The guest runs these as the agent on a tree the container controls, so
+//! paths below the root are resolved one component at a time with
+//! `O_NOFOLLOW` (see [`open_parent`]): a symlink planted anywhere in a path
+//! fails the operation instead of redirecting it outside the root. Readers
+//! asked to follow symlinks ([`ScanOptions::follow_symlinks`]) follow them
+//! on the way too.
+
+use crate::{BoxliteError, BoxliteResult, ManifestEntry, ManifestEntryKind, PatchChunk};
+use sha2::{Digest, Sha256};
+use std::collections::{HashMap, HashSet};
+use std::ffi::{CStr, CString, OsString};
+use std::fs::File;
+use std::io::Read;
+use std::os::fd::{AsFd, AsRawFd, BorrowedFd, FromRawFd, OwnedFd};
+use std::os::unix::ffi::{OsStrExt, OsStringExt};
+use std::os::unix::fs::{FileExt, MetadataExt, PermissionsExt};
+use std::path::{Component, Path, PathBuf};
+use std::time::{Duration, UNIX_EPOCH};
+
+/// Block size used for block-level deltas.
+pub const DELTA_BLOCK_SIZE: u32 = 256 * 1024;
+
+/// Regular files smaller than this are resent whole instead of diffed by block.
+pub const DELTA_MIN_FILE_SIZE: u64 = 8 * 1024 * 1024;
+
+// ── Manifest ──────────────────────────────────────────────────────
+
+/// Controls what a manifest records.
+#[derive(Clone, Debug, Default)]
+pub struct ScanOptions {
+    /// Hash regular file contents, so files compare by content rather than mtime.
+    pub checksum: bool,
+    /// If non-zero, hash regular files in blocks of this size.
+    pub block_size: u32,
+    /// Describe what symlinks point to instead of the links themselves
+    /// (matches `PackContext::follow_symlinks`).
+    pub follow_symlinks: bool,
+}
+
+/// Describe every entry below `root`, sorted by path.
+///
+/// `root` itself is not included; a missing `root` has no entries.
+pub fn scan(root: &Path, opts: &ScanOptions) -> BoxliteResult<Vec<ManifestEntry>> {
+    let mut entries = Vec::new();
+    if !root.is_dir() {
+        return Ok(entries);
+    }
+
+    let mut pending = vec![String::new()];
+    while let Some(dir) = pending.pop() {
+        let dir_path = root.join(&dir);
+        let read = std::fs::read_dir(&dir_path).map_err(|e| {
+            BoxliteError::Storage(format!("failed to read dir {}: {}", dir_path.display(), e))
+        })?;
+        for item in read {
+            let item = item
+                .map_err(|e| BoxliteError::Storage(format!("failed to read dir entry: {}", e)))?;
+            let name = item.file_name();
+            let name = name.to_str().ok_or_else(|| {
+                BoxliteError::Storage(format!(
+                    "cannot sync non-UTF-8 path {}",
+                    item.path().display()
+                ))
+            })?;
+            let rel = if dir.is_empty() {
+                name.to_string()
+            } else {
+                format!("{}/{}", dir, name)
+            };
+            // Listed by path, but described through a confined walk: a
+            // directory swapped for a symlink fails here instead.
+            let entry = describe_path(root, &rel, opts)?;
+            if entry.kind() == ManifestEntryKind::Directory {
+                pending.push(rel);
+            }
+            entries.push(entry);
+        }
+    }
+
+    entries.sort_by(|a, b| a.path.cmp(&b.path));
+    Ok(entries)
+}
+
+/// Describe only the given root-relative `paths`; missing ones are skipped.
+pub fn describe(
+    root: &Path,
+    paths: &[String],
+    opts: &ScanOptions,
+) -> BoxliteResult<Vec<ManifestEntry>> {
+    let mut entries = Vec::with_capacity(paths.len());
+    for rel in paths {
+        match describe_path(root, rel, opts) {
+            Ok(entry) => entries.push(entry),
+            Err(BoxliteError::NotFound(_)) => {}
+            Err(e) => return Err(e),
+        }
+    }
+    Ok(entries)
+}
+
+/// Fails with `NotFound` if `rel` does not exist.
+fn describe_path(root: &Path, rel: &str, opts: &ScanOptions) -> BoxliteResult<ManifestEntry> {
+    let follow = opts.follow_symlinks;
+    let (dir, name) = open_parent(root, rel, Links::for_read(follow))?;
+    let st = stat_at(dir.as_fd(), &name, follow).map_err(|e| resolve_err(rel, e))?;
+
+    let mut entry = ManifestEntry {
+        path: rel.to_string(),
+        mtime: st.st_mtime as i64,
+        mode: st.st_mode as u32 & 0o7777,
+        ..Default::default()
+    };
+    entry.set_kind(kind_of(&st));
+
+    match entry.kind() {
+        ManifestEntryKind::File => {
+            entry.size = st.st_size as u64;
+            if opts.checksum || opts.block_size > 0 {
+                let read_err = |e| BoxliteError::Storage(format!("failed to read {}: {}", rel, e));
+                let mut file = open_file_at(dir.as_fd(), &name, follow, &st).map_err(read_err)?;
+                let (sha256, block_sums) =
+                    hash_file(&mut file, opts.checksum, opts.block_size).map_err(read_err)?;
+                entry.sha256 = sha256;
+                entry.block_sums = block_sums;
+            }
+        }
+        ManifestEntryKind::Symlink => {
+            let target = read_link_at(dir.as_fd(), &name).map_err(|e| {
+                BoxliteError::Storage(format!("failed to read link {}: {}", rel, e))
+            })?;
+            entry.link_target = target.to_string_lossy().into_owned();
+        }
+        _ => {}
+    }
+    Ok(entry)
+}
+
+fn kind_of(st: &libc::stat) -> ManifestEntryKind {
+    match st.st_mode & libc::S_IFMT {
+        libc::S_IFREG => ManifestEntryKind::File,
+        libc::S_IFDIR => ManifestEntryKind::Directory,
+        libc::S_IFLNK => ManifestEntryKind::Symlink,
+        _ => ManifestEntryKind::Other,
+    }
+}
+
+/// Hash `file` in one pass: the whole content (if `whole`) and each
+/// `block_size` block (if non-zero).
+fn hash_file(
+    file: &mut File,
+    whole: bool,
+    block_size: u32,
+) -> std::io::Result<(Vec<u8>, Vec<Vec<u8>>)> {
+    let step = if block_size > 0 {
+        block_size as usize
+    } else {
+        1 << 20
+    };
+    let mut buf = vec![0u8; step];
+    let mut content = Sha256::new();
+    let mut blocks = Vec::new();
+    loop {
+        let n = read_full(file, &mut buf)?;
+        if n == 0 {
+            break;
+        }
+        if whole {
+            content.update(&buf[..n]);
+        }
+        if block_size > 0 {
+            blocks.push(Sha256::digest(&buf[..n]).to_vec());
+        }
+    }
+    let sha256 = if whole {
+        content.finalize().to_vec()
+    } else {
+        Vec::new()
+    };
+    Ok((sha256, blocks))
+}
+
+/// Fill `buf` unless EOF comes first; returns the bytes read.
+fn read_full(file: &mut File, buf: &mut [u8]) -> std::io::Result<usize> {
+    let mut filled = 0;
+    while filled < buf.len() {
+        match file.read(&mut buf[filled..]) {
+            Ok(0) => break,
+            Ok(n) => filled += n,
+            Err(e) if e.kind() == std::io::ErrorKind::Interrupted => {}
+            Err(e) => return Err(e),
+        }
+    }
+    Ok(filled)
+}
+
+/// Reject root-relative paths that are absolute or climb out of the root.
+pub fn checked_relative(rel: &str) -> BoxliteResult<&Path> {
+    let path = Path::new(rel);
+    let valid = !rel.is_empty()
+        && path
+            .components()
+            .all(|c| matches!(c, Component::Normal(_) | Component::CurDir));
+    if valid {
+        Ok(path)
+    } else {
+        Err(BoxliteError::InvalidArgument(format!(
+            "sync path must be relative and stay below the root: {:?}",
+            rel
+        )))
+    }
+}
+
+// ── Confined resolution ───────────────────────────────────────────
+
+/// How [`open_parent`] treats a symlink on the way to an entry.
+#[derive(Clone, Copy)]
+enum Links {
+    /// Refuse it, `root` included (the writers).
+    Refuse,
+    /// Refuse it below `root`; `root` itself is the caller's path and is
+    /// followed.
+    RefuseBelowRoot,
+    /// Follow it (readers asked to follow symlinks).
+    Follow,
+}
+
+impl Links {
+    fn for_read(follow_symlinks: bool) -> Self {
+        if follow_symlinks {
+            Links::Follow
+        } else {
+            Links::RefuseBelowRoot
+        }
+    }
+}
+
+/// Open the directory holding root-relative `rel`, walking from `root` one
+/// component at a time with `O_NOFOLLOW`, and return it with the final
+/// component. A symlink in any parent position fails with `ELOOP` (or
+/// `ENOTDIR`) rather than being followed, and the returned fd pins the
+/// directory, so later `*at` calls cannot be redirected by a rename.
+fn open_parent(root: &Path, rel: &str, links: Links) -> BoxliteResult<(OwnedFd, CString)> {
+    let mut names = Vec::new();
+    for component in checked_relative(rel)?.components() {
+        if let Component::Normal(name) = component {
+            names.push(c_name(name.as_bytes(), rel)?);
+        }
+    }
+    let Some(last) = names.pop() else {
+        return Err(BoxliteError::InvalidArgument(format!(
+            "sync path must name an entry below the root: {:?}",
+            rel
+        )));
+    };
+
+    let flags = libc::O_RDONLY | libc::O_DIRECTORY;
+    let (root_flags, below_flags) = match links {
+        Links::Refuse => (flags | libc::O_NOFOLLOW, flags | libc::O_NOFOLLOW),
+        Links::RefuseBelowRoot => (flags, flags | libc::O_NOFOLLOW),
+        Links::Follow => (flags, flags),
+    };
+    let root_c = c_name(root.as_os_str().as_bytes(), rel)?;
+    let mut dir = open_at(None, &root_c, root_flags).map_err(|e| resolve_err(rel, e))?;
+    for name in &names {
+        dir = open_at(Some(dir.as_fd()), name, below_flags).map_err(|e| resolve_err(rel, e))?;
+    }
+    Ok((dir, last))
+}
+
+fn c_name(bytes: &[u8], rel: &str) -> BoxliteResult<CString> {
+    CString::new(bytes).map_err(|_| {
+        BoxliteError::InvalidArgument(format!("sync path contains a NUL byte: {:?}", rel))
+    })
+}
+
+/// Map a resolution failure; `NotFound` stays distinguishable for callers
+/// that skip missing paths.
+fn resolve_err(rel: &str, e: std::io::Error) -> BoxliteError {
+    match e.raw_os_error() {
+        Some(libc::ENOENT) => BoxliteError::NotFound(format!("{}: {}", rel, e)),
+        Some(libc::ELOOP) | Some(libc::ENOTDIR) => BoxliteError::InvalidArgument(format!(
+            "sync path {} crosses a symlink or non-directory",
+            rel
+        )),
+        _ => BoxliteError::Storage(format!("failed to resolve {}: {}", rel, e)),
+    }
+}
+
+fn cvt(ret: libc::c_int) -> std::io::Result<libc::c_int> {
+    if ret < 0 {
+        Err(std::io::Error::last_os_error())
+    } else {
+        Ok(ret)
+    }
+}
+
+/// `openat` with `O_CLOEXEC`; `None` resolves relative to the cwd.
+fn open_at(
+    dir: Option<BorrowedFd<'_>>,
+    name: &CStr,
+    flags: libc::c_int,
+) -> std::io::Result<OwnedFd> {
+    let dirfd = dir.map_or(libc::AT_FDCWD, |d| d.as_raw_fd());
+    // SAFETY: `name` is NUL-terminated; a non-negative result is a new fd we own.
+    let fd = cvt(unsafe { libc::openat(dirfd, name.as_ptr(), flags | libc::O_CLOEXEC) })?;
+    Ok(unsafe { OwnedFd::from_raw_fd(fd) })
+}
+
+fn open_dir_at(dir: Option<BorrowedFd<'_>>, name: &CStr) -> std::io::Result<OwnedFd> {
+    open_at(
+        dir,
+        name,
+        libc::O_RDONLY | libc::O_DIRECTORY | libc::O_NOFOLLOW,
+    )
+}
+
+/// Open `name` in `dir` for reading and check, on the open fd, that it is
+/// still the regular file `st` describes. O_NONBLOCK keeps a FIFO swapped
+/// in from blocking the open.
+#[allow(clippy::unnecessary_cast)] // dev_t and ino_t widths differ across platforms
+fn open_file_at(
+    dir: BorrowedFd<'_>,
+    name: &CStr,
+    follow: bool,
+    st: &libc::stat,
+) -> std::io::Result<File> {
+    let fd = open_at(
+        Some(dir),
+        name,
+        libc::O_RDONLY | libc::O_NONBLOCK | if follow { 0 } else { libc::O_NOFOLLOW },
+    )?;
+    let file = File::from(fd);
+    let meta = file.metadata()?;
+    if !meta.is_file() || meta.dev() != st.st_dev as u64 || meta.ino() != st.st_ino as u64 {
+        return Err(std::io::Error::other("replaced while it was being read"));
+    }
+    Ok(file)
+}
+
+/// `fstatat` of `name` in `dir`; without `follow` a symlink describes itself.
+fn stat_at(dir: BorrowedFd<'_>, name: &CStr, follow: bool) -> std::io::Result<libc::stat> {
+    let flags = if follow { 0 } else { libc::AT_SYMLINK_NOFOLLOW };
+    let mut st = std::mem::MaybeUninit::<libc::stat>::uninit();
+    // SAFETY: `st` is written by a successful fstatat before being read.
+    cvt(unsafe { libc::fstatat(dir.as_raw_fd(), name.as_ptr(), st.as_mut_ptr(), flags) })?;
+    Ok(unsafe { st.assume_init() })
+}
+
+/// Whether `name` in `dir` is a directory, without following a symlink.
+/// `None` if it does not exist.
+fn stat_is_dir_at(dir: BorrowedFd<'_>, name: &CStr) -> std::io::Result<Option<bool>> {
+    match stat_at(dir, name, false) {
+        Ok(st) => Ok(Some((st.st_mode & libc::S_IFMT) == libc::S_IFDIR)),
+        Err(e) if e.raw_os_error() == Some(libc::ENOENT) => Ok(None),
+        Err(e) => Err(e),
+    }
+}
+
+/// Target of symlink `name` in `dir`.
+fn read_link_at(dir: BorrowedFd<'_>, name: &CStr) -> std::io::Result<PathBuf> {
+    let mut buf = vec![0u8; libc::PATH_MAX as usize];
+    // SAFETY: `buf` is writable for `buf.len()` bytes.
+    let n = unsafe {
+        libc::readlinkat(
+            dir.as_raw_fd(),
+            name.as_ptr(),
+            buf.as_mut_ptr().cast(),
+            buf.len(),
+        )
+    };
+    if n < 0 {
+        return Err(std::io::Error::last_os_error());
+    }
+    buf.truncate(n as usize);
+    Ok(PathBuf::from(OsString::from_vec(buf)))
+}
+
+fn unlink_at(dir: BorrowedFd<'_>, name: &CStr, flags: libc::c_int) -> std::io::Result<()> {
+    // SAFETY: `name` is NUL-terminated.
+    cvt(unsafe { libc::unlinkat(dir.as_raw_fd(), name.as_ptr(), flags) }).map(|_| ())
+}
+
+/// Remove directory `name` in `parent` and everything below it, opening
+/// each level with `O_NOFOLLOW` so a symlink swapped in mid-walk is
+/// unlinked, never descended into.
+fn remove_dir_at(parent: BorrowedFd<'_>, name: &CStr) -> std::io::Result<()> {
+    let dir = open_dir_at(Some(parent), name)?;
+    for child in list_dir(&dir)? {
+        match stat_is_dir_at(dir.as_fd(), &child)? {
+            Some(true) => remove_dir_at(dir.as_fd(), &child)?,
+            Some(false) => unlink_at(dir.as_fd(), &child, 0)?,
+            None => {}
+        }
+    }
+    unlink_at(parent, name, libc::AT_REMOVEDIR)
+}
+
+/// Names in `dir`, without `.` and `..`. A read error ends the listing
+/// early; the final `rmdir` then fails with `ENOTEMPTY`.
+fn list_dir(dir: &OwnedFd) -> std::io::Result<Vec<CString>> {
+    // fdopendir takes ownership of its fd, so hand it a duplicate.
+    let dup = cvt(unsafe { libc::fcntl(dir.as_raw_fd(), libc::F_DUPFD_CLOEXEC, 0) })?;
+    // SAFETY: `dup` is an open directory fd; the stream owns it from here.
+    let stream = unsafe { libc::fdopendir(dup) };
+    if stream.is_null() {
+        let e = std::io::Error::last_os_error();
+        unsafe { libc::close(dup) };
+        return Err(e);
+    }
+    let mut names = Vec::new();
+    loop {
+        // SAFETY: `stream` is open; the entry is valid until the next call.
+        let entry = unsafe { libc::readdir(stream) };
+        if entry.is_null() {
+            break;
+        }
+        let name = unsafe { CStr::from_ptr((*entry).d_name.as_ptr()) };
+        if name.to_bytes() != b"." && name.to_bytes() != b".." {
+            names.push(name.to_owned());
+        }
+    }
+    unsafe { libc::closedir(stream) };
+    Ok(names)
+}
+
+// ── Plan ──────────────────────────────────────────────────────────
+
+/// What a delta sync has to do to make the destination match the source.
+#[derive(Debug, Default, PartialEq)]
+pub struct SyncPlan {
+    /// Entries to send in the tar, parents before children.
+    pub send: Vec<String>,
+    /// Large regular files to update block by block.
+    pub patch: Vec<String>,
+    /// Destination entries to delete first because their kind changed.
+    pub remove: Vec<String>,
+}
+
+impl SyncPlan {
+    /// True when the destination is already up to date.
+    pub fn is_empty(&self) -> bool {
+        self.send.is_empty() && self.patch.is_empty() && self.remove.is_empty()
+    }
+}
+
+/// Diff a source manifest against a destination manifest.
+///
+/// Entries only in the destination are left alone, as a plain copy would.
+/// With `block_delta`, changed regular files of at least
+/// `DELTA_MIN_FILE_SIZE` that already exist at the destination are planned
+/// as patches instead of resends.
+pub fn plan(source: &[ManifestEntry], dest: &[ManifestEntry], block_delta: bool) -> SyncPlan {
+    let dest: HashMap<&str, &ManifestEntry> = dest.iter().map(|e| (e.path.as_str(), e)).collect();
+    let mut plan = SyncPlan::default();
+    let mut removed: HashSet<&str> = HashSet::new();
+
+    for src in source {
+        match dest.get(src.path.as_str()) {
+            None => plan.send.push(src.path.clone()),
+            Some(dst) if dst.kind != src.kind => {
+                // Deleting a directory takes its children with it.
+                if !has_removed_ancestor(&src.path, &removed) {
+                    plan.remove.push(dst.path.clone());
+                }
+                removed.insert(src.path.as_str());
+                plan.send.push(src.path.clone());
+            }
+            Some(dst) if unchanged(src, dst) => {}
+            Some(dst) => {
+                let patchable = block_delta
+                    && src.kind() == ManifestEntryKind::File
+                    && src.size >= DELTA_MIN_FILE_SIZE
+                    && dst.size > 0;
+                if patchable {
+                    plan.patch.push(src.path.clone());
+                } else {
+                    plan.send.push(src.path.clone());
+                }
+            }
+        }
+    }
+    plan
+}
+
+fn has_removed_ancestor(path: &str, removed: &HashSet<&str>) -> bool {
+    let mut current = path;
+    while let Some((parent, _)) = current.rsplit_once('/') {
+        if removed.contains(parent) {
+            return true;
+        }
+        current = parent;
+    }
+    false
+}
+
+fn unchanged(src: &ManifestEntry, dst: &ManifestEntry) -> bool {
+    match src.kind() {
+        ManifestEntryKind::File => {
+            let same_content = if !src.sha256.is_empty() && !dst.sha256.is_empty() {
+                src.sha256 == dst.sha256
+            } else {
+                src.mtime == dst.mtime
+            };
+            src.size == dst.size && src.mode == dst.mode && same_content
+        }
+        // Directory mtimes move whenever their contents do; only the
+        // permissions are worth comparing.
+        ManifestEntryKind::Directory => src.mode == dst.mode,
+        ManifestEntryKind::Symlink => src.link_target == dst.link_target,
+        _ => true,
+    }
+}
+
+// ── Transfer ──────────────────────────────────────────────────────
+
+/// Pack the root-relative `paths` under `root` as a tar stream written to
+/// `writer`, returning the writer once the archive is finished.
+///
+/// Directories are added as bare entries; their contents are only included
+/// when listed. Blocking.
+pub fn pack_entries_to_writer<W: std::io::Write>(
+    root: &Path,
+    paths: &[String],
+    writer: W,
+    follow_symlinks: bool,
+) -> BoxliteResult<W> {
+    let mut builder = tar::Builder::new(writer);
+
+    for rel in paths {
+        let (dir, name) = open_parent(root, rel, Links::for_read(follow_symlinks))?;
+        let st = stat_at(dir.as_fd(), &name, follow_symlinks)
+            .map_err(|e| BoxliteError::Storage(format!("failed to stat {}: {}", rel, e)))?;
+        let archive_err = |e| BoxliteError::Storage(format!("failed to archive {}: {}", rel, e));
+        match st.st_mode & libc::S_IFMT {
+            libc::S_IFREG => {
+                let mut file =
+                    open_file_at(dir.as_fd(), &name, follow_symlinks, &st).map_err(archive_err)?;
+                builder.append_file(rel, &mut file).map_err(archive_err)?;
+            }
+            libc::S_IFLNK => {
+                let target = read_link_at(dir.as_fd(), &name).map_err(archive_err)?;
+                let mut header = stat_header(&st, rel)?;
+                builder
+                    .append_link(&mut header, rel, target)
+                    .map_err(archive_err)?;
+            }
+            _ => {
+                let mut header = stat_header(&st, rel)?;
+                builder
+                    .append_data(&mut header, rel, std::io::empty())
+                    .map_err(archive_err)?;
+            }
+        }
+    }
+
+    builder
+        .into_inner()
+        .map_err(|e| BoxliteError::Storage(format!("failed to finish tar: {}", e)))
+}
+
+/// Header for the non-regular entry `st` describes, filled as tar's own
+/// `append_path` fills it.
+#[allow(clippy::unnecessary_cast)] // mode_t is narrower than u32 on macOS
+fn stat_header(st: &libc::stat, rel: &str) -> BoxliteResult<tar::Header> {
+    let entry_type = match st.st_mode & libc::S_IFMT {
+        libc::S_IFDIR => tar::EntryType::Directory,
+        libc::S_IFLNK => tar::EntryType::Symlink,
+        libc::S_IFIFO => tar::EntryType::Fifo,
+        libc::S_IFCHR => tar::EntryType::Char,
+        libc::S_IFBLK => tar::EntryType::Block,
+        _ => {
+            return Err(BoxliteError::Storage(format!(
+                "cannot archive {}: unsupported file type",
+                rel
+            )))
+        }
+    };
+    let mut header = tar::Header::new_gnu();
+    header.set_entry_type(entry_type);
+    header.set_mode(st.st_mode as u32);
+    header.set_uid(st.st_uid as u64);
+    header.set_gid(st.st_gid as u64);
+    header.set_mtime(st.st_mtime as u64);
+    header.set_size(0);
+    if matches!(entry_type, tar::EntryType::Char | tar::EntryType::Block) {
+        let device_err = |e| BoxliteError::Storage(format!("failed to archive {}: {}", rel, e));
+        header
+            .set_device_major(libc::major(st.st_rdev) as u32)
+            .map_err(device_err)?;
+        header
+            .set_device_minor(libc::minor(st.st_rdev) as u32)
+            .map_err(device_err)?;
+    }
+    Ok(header)
+}
+
+/// Delete the root-relative `paths` under `root`, recursively for
+/// directories. A symlink is removed itself, never followed, and a path
+/// through a symlinked parent is an error. Missing paths are ignored.
+/// Blocking.
+pub fn remove_entries(root: &Path, paths: &[String]) -> BoxliteResult<()> {
+    for rel in paths {
+        let (dir, name) = match open_parent(root, rel, Links::Refuse) {
+            Ok(resolved) => resolved,
+            Err(BoxliteError::NotFound(_)) => continue,
+            Err(e) => return Err(e),
+        };
+        let removed = match stat_is_dir_at(dir.as_fd(), &name) {
+            Ok(None) => continue,
+            Ok(Some(true)) => remove_dir_at(dir.as_fd(), &name),
+            Ok(Some(false)) => unlink_at(dir.as_fd(), &name, 0),
+            Err(e) => Err(e),
+        };
+        removed.map_err(|e| BoxliteError::Storage(format!("failed to remove {}: {}", rel, e)))?;
+    }
+    Ok(())
+}
+
+/// Byte ranges `(offset, len)` of `path` whose blocks differ from
+/// `dest_sums`, the destination's per-block hashes for `block_size`.
+///
+/// Blocks past the end of the destination always differ; adjacent ranges
+/// are merged. Blocking.
+pub fn changed_ranges(
+    path: &Path,
+    dest_sums: &[Vec<u8>],
+    block_size: u32,
+) -> BoxliteResult<Vec<(u64, u64)>> {
+    let read_err = |e| BoxliteError::Storage(format!("failed to read {}: {}", path.display(), e));
+    let mut file = File::open(path).map_err(read_err)?;
+    let (_, sums) = hash_file(&mut file, false, block_size).map_err(read_err)?;
+    let size = file.metadata().map_err(read_err)?.len();
+    merge_changed(&sums, dest_sums, block_size, size).ok_or_else(|| {
+        BoxliteError::Storage(format!("{} shrank while it was hashed", path.display()))
+    })
+}
+
+/// Ranges of the blocks in `sums` that differ from `dest_sums`, for a file
+/// of `size` bytes. `None` if `sums` has blocks starting at or past `size`.
+fn merge_changed(
+    sums: &[Vec<u8>],
+    dest_sums: &[Vec<u8>],
+    block_size: u32,
+    size: u64,
+) -> Option<Vec<(u64, u64)>> {
+    let block = block_size as u64;
+    let mut ranges: Vec<(u64, u64)> = Vec::new();
+    for (i, sum) in sums.iter().enumerate() {
+        let offset = (i as u64).checked_mul(block)?;
+        let remaining = size.checked_sub(offset).filter(|&r| r > 0)?;
+        if dest_sums.get(i) == Some(sum) {
+            continue;
+        }
+        let len = block.min(remaining);
+        match ranges.last_mut() {
+            Some((start, run)) if *start + *run == offset => *run += len,
+            _ => ranges.push((offset, len)),
+        }
+    }
+    Some(ranges)
+}
+
+/// Applies a `Patch` stream to files under a sync root (guest side).
+///
+/// Files are rewritten in place, so a failed patch can leave one partly
+/// updated; the next sync sees it as changed and fixes it.
+pub struct PatchWriter {
+    root: PathBuf,
+    open: Option<(String, File)>,
+}
+
+impl PatchWriter {
+    pub fn new(root: PathBuf) -> Self {
+        Self { root, open: None }
+    }
+
+    /// Apply one chunk. Blocking.
+    pub fn apply(&mut self, chunk: &PatchChunk) -> BoxliteResult<()> {
+        let file = self.file_for(&chunk.path)?;
+        if !chunk.data.is_empty() {
+            file.write_all_at(&chunk.data, chunk.offset).map_err(|e| {
+                BoxliteError::Storage(format!("failed to patch {}: {}", chunk.path, e))
+            })?;
+        }
+        if chunk.commit {
+            let (_, file) = self.open.take().expect("file opened above");
+            commit(&file, chunk).map_err(|e| {
+                BoxliteError::Storage(format!("failed to patch {}: {}", chunk.path, e))
+            })?;
+        }
+        Ok(())
+    }
+
+    /// Error unless the last file's patch was committed.
+    pub fn finish(self) -> BoxliteResult<()> {
+        match self.open {
+            Some((path, _)) => Err(BoxliteError::InvalidArgument(format!(
+                "patch stream ended before {} was committed",
+                path
+            ))),
+            None => Ok(()),
+        }
+    }
+
+    fn file_for(&mut self, rel: &str) -> BoxliteResult<&File> {
+        if let Some((open, _)) = &self.open {
+            if open != rel {
+                return Err(BoxliteError::InvalidArgument(format!(
+                    "patch for {} started before {} was committed",
+                    rel, open
+                )));
+            }
+        } else {
+            let not_regular = || {
+                BoxliteError::NotFound(format!(
+                    "patch target {} is not an existing regular file",
+                    rel
+                ))
+            };
+            let (dir, name) = open_parent(&self.root, rel, Links::Refuse)?;
+            // O_NOFOLLOW refuses a final symlink; O_NONBLOCK keeps a FIFO
+            // from blocking the open. The type is checked on the open fd,
+            // so nothing can be swapped in between.
+            let fd = match open_at(
+                Some(dir.as_fd()),
+                &name,
+                libc::O_WRONLY | libc::O_NOFOLLOW | libc::O_NONBLOCK,
+            ) {
+                Ok(fd) => fd,
+                Err(e) if matches!(e.raw_os_error(), Some(libc::ENOENT | libc::ELOOP)) => {
+                    return Err(not_regular());
+                }
+                Err(e) => {
+                    return Err(BoxliteError::Storage(format!(
+                        "failed to open {}: {}",
+                        rel, e
+                    )))
+                }
+            };
+            let file = File::from(fd);
+            let is_file = file.metadata().map(|m| m.is_file()).unwrap_or(false);
+            if !is_file {
+                return Err(not_regular());
+            }
+            self.open = Some((rel.to_string(), file));
+        }
+        Ok(&self.open.as_ref().expect("just set").1)
+    }
+}
+
+fn commit(file: &File, chunk: &PatchChunk) -> std::io::Result<()> {
+    file.set_len(chunk.size)?;
+    file.set_permissions(std::fs::Permissions::from_mode(chunk.mode))?;
+    let mtime = UNIX_EPOCH + Duration::from_secs(chunk.mtime.max(0) as u64);
+    file.set_modified(mtime)
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use tempfile::TempDir;
+
+    fn write(root: &Path, rel: &str, data: &[u8]) {
+        let path = root.join(rel);
+        std::fs::create_dir_all(path.parent().unwrap()).unwrap();
+        std::fs::write(path, data).unwrap();
+    }
+
+    fn paths(entries: &[ManifestEntry]) -> Vec<&str> {
+        entries.iter().map(|e| e.path.as_str()).collect()
+    }
+
+    fn copy_tree(src: &Path, dest: &Path) {
+        let entries = scan(src, &ScanOptions::default()).unwrap();
+        let all: Vec<String> = entries.iter().map(|e| e.path.clone()).collect();
+        let tar = pack_entries_to_writer(src, &all, Vec::new(), false).unwrap();
+        tar::Archive::new(&tar[..]).unpack(dest).unwrap();
+    }
+
+    #[test]
+    fn scan_lists_entries_sorted_and_relative() {
+        let tmp = TempDir::new().unwrap();
+        write(tmp.path(), "b.txt", b"bb");
+        write(tmp.path(), "a/x.txt", b"x");
+        std::os::unix::fs::symlink("b.txt", tmp.path().join("link")).unwrap();
+
+        let entries = scan(tmp.path(), &ScanOptions::default()).unwrap();
+        assert_eq!(paths(&entries), ["a", "a/x.txt", "b.txt", "link"]);
+        assert_eq!(entries[0].kind(), ManifestEntryKind::Directory);
+        assert_eq!(entries[2].size, 2);
+        assert_eq!(entries[3].kind(), ManifestEntryKind::Symlink);
+        assert_eq!(entries[3].link_target, "b.txt");
+        assert!(scan(&tmp.path().join("missing"), &ScanOptions::default())
+            .unwrap()
+            .is_empty());
+    }
+
+    #[test]
+    fn copied_tree_plans_nothing_until_a_file_changes() {
+        let tmp = TempDir::new().unwrap();
+        let (src, dest) = (tmp.path().join("src"), tmp.path().join("dest"));
+        write(&src, "keep.txt", b"same");
+        write(&src, "dir/edit.txt", b"before");
+        copy_tree(&src, &dest);
+
+        let opts = ScanOptions::default();
+        let first = plan(
+            &scan(&src, &opts).unwrap(),
+            &scan(&dest, &opts).unwrap(),
+            false,
+        );
+        assert!(first.is_empty(), "{first:?}");
+
+        write(&src, "dir/edit.txt", b"after, longer");
+        write(&src, "dir/new.txt", b"new");
+        let second = plan(
+            &scan(&src, &opts).unwrap(),
+            &scan(&dest, &opts).unwrap(),
+            false,
+        );
+        assert_eq!(second.send, ["dir/edit.txt", "dir/new.txt"]);
+        assert!(second.patch.is_empty() && second.remove.is_empty());
+    }
+
+    #[test]
+    fn checksum_mode_ignores_mtime() {
+        let entry = |mtime, sha: &[u8]| {
+            let mut e = ManifestEntry {
+                path: "f".into(),
+                size: 3,
+                mtime,
+                mode: 0o644,
+                sha256: sha.to_vec(),
+                ..Default::default()
+            };
+            e.set_kind(ManifestEntryKind::File);
+            e
+        };
+        assert!(plan(&[entry(1, b"h")], &[entry(2, b"h")], false).is_empty());
+        assert_eq!(
+            plan(&[entry(1, b"h")], &[entry(1, b"g")], false).send,
+            ["f"]
+        );
+    }
+
+    #[test]
+    fn kind_change_removes_once_and_resends_subtree() {
+        let tmp = TempDir::new().unwrap();
+        let (src, dest) = (tmp.path().join("src"), tmp.path().join("dest"));
+        write(&src, "was_file/inner.txt", b"i");
+        write(&src, "was_dir", b"now a file");
+        write(&dest, "was_file", b"f");
+        write(&dest, "was_dir/old.txt", b"o");
+
+        let opts = ScanOptions::default();
+        let plan = plan(
+            &scan(&src, &opts).unwrap(),
+            &scan(&dest, &opts).unwrap(),
+            false,
+        );
+        assert_eq!(plan.remove, ["was_dir", "was_file"]);
+        assert_eq!(plan.send, ["was_dir", "was_file", "was_file/inner.txt"]);
+
+        remove_entries(&dest, &plan.remove).unwrap();
+        let tar = pack_entries_to_writer(&src, &plan.send, Vec::new(), false).unwrap();
+        tar::Archive::new(&tar[..]).unpack(&dest).unwrap();
+        assert_eq!(std::fs::read(dest.join("was_dir")).unwrap(), b"now a file");
+        assert_eq!(
+            std::fs::read(dest.join("was_file/inner.txt")).unwrap(),
+            b"i"
+        );
+    }
+
+    #[test]
+    fn block_delta_patches_only_changed_blocks() {
+        let tmp = TempDir::new().unwrap();
+        let (src, dest) = (tmp.path().join("src"), tmp.path().join("dest"));
+        let block = 4096u32;
+        let mut data: Vec<u8> = (0..block as usize * 4).map(|i| (i % 251) as u8).collect();
+        write(&dest, "big.bin", &data);
+        data[block as usize + 7] ^= 0xff;
+        data.extend_from_slice(b"appended tail");
+        write(&src, "big.bin", &data);
+
+        let dest_entry = describe(
+            &dest,
+            &["big.bin".to_string()],
+            &ScanOptions {
+                block_size: block,
+                ..Default::default()
+            },
+        )
+        .unwrap();
+        let ranges =
+            changed_ranges(&src.join("big.bin"), &dest_entry[0].block_sums, block).unwrap();
+        assert_eq!(
+            ranges,
+            [(block as u64, block as u64), (block as u64 * 4, 13)]
+        );
+
+        let mut writer = PatchWriter::new(dest.clone());
+        let source = std::fs::read(src.join("big.bin")).unwrap();
+        for (offset, len) in ranges {
+            writer
+                .apply(&PatchChunk {
+                    path: "big.bin".into(),
+                    offset,
+                    data: source[offset as usize..(offset + len) as usize].to_vec(),
+                    ..Default::default()
+                })
+                .unwrap();
+        }
+        writer
+            .apply(&PatchChunk {
+                path: "big.bin".into(),
+                commit: true,
+                size: source.len() as u64,
+                mtime: 1_700_000_000,
+                mode: 0o600,
+                ..Default::default()
+            })
+            .unwrap();
+        writer.finish().unwrap();
+
+        assert_eq!(std::fs::read(dest.join("big.bin")).unwrap(), source);
+        let meta = std::fs::metadata(dest.join("big.bin")).unwrap();
+        assert_eq!(meta.mtime(), 1_700_000_000);
+        assert_eq!(meta.mode() & 0o7777, 0o600);
+    }
+
+    #[test]
+    fn changed_ranges_reject_a_file_that_shrank() {
+        let sums = vec![b"a".to_vec(), b"b".to_vec(), b"c".to_vec()];
+        assert_eq!(
+            merge_changed(&sums, &[], 4, 9),
+            Some(vec![(0, 9)]),
+            "last block is short"
+        );
+        assert_eq!(merge_changed(&sums, &sums[..1], 4, 9), Some(vec![(4, 5)]));
+        assert_eq!(merge_changed(&sums, &[], 4, 8), None);
+        assert_eq!(merge_changed(&sums, &[], 4, 3), None);
+    }
+
+    #[test]
+    fn writers_do_not_follow_symlinks_out_of_the_root() {
+        let tmp = TempDir::new().unwrap();
+        let (root, outside) = (tmp.path().join("root"), tmp.path().join("outside"));
+        write(&outside, "victim", b"keep me");
+        write(&outside, "sub/inner", b"keep me too");
+        write(&root, "plain", b"p");
+        std::os::unix::fs::symlink(&outside, root.join("dir")).unwrap();
+        std::os::unix::fs::symlink(outside.join("victim"), root.join("link")).unwrap();
+
+        // Through a symlinked parent: refused, target untouched.
+        for rel in ["dir/victim", "dir/sub", "dir/sub/inner"] {
+            assert!(remove_entries(&root, &[rel.to_string()]).is_err(), "{rel}");
+        }
+        let mut writer = PatchWriter::new(root.clone());
+        for rel in ["dir/victim", "link"] {
+            let chunk = PatchChunk {
+                path: rel.into(),
+                data: b"pwned".to_vec(),
+                ..Default::default()
+            };
+            assert!(writer.apply(&chunk).is_err(), "{rel}");
+        }
+        assert_eq!(std::fs::read(outside.join("victim")).unwrap(), b"keep me");
+        assert_eq!(
+            std::fs::read(outside.join("sub/inner")).unwrap(),
+            b"keep me too"
+        );
+
+        // A symlink named directly is removed itself.
+        remove_entries(&root, &["link".to_string(), "dir".to_string()]).unwrap();
+        assert!(root.join("link").symlink_metadata().is_err());
+        assert!(root.join("dir").symlink_metadata().is_err());
+        assert!(outside.join("victim").exists());
+        assert!(outside.join("sub/inner").exists());
+    }
+
+    #[test]
+    fn readers_do_not_follow_symlinks_out_of_the_root() {
+        let tmp = TempDir::new().unwrap();
+        let (root, outside) = (tmp.path().join("root"), tmp.path().join("outside"));
+        write(&outside, "victim", b"secret!");
+        write(&root, "plain", b"p");
+        std::os::unix::fs::symlink(&outside, root.join("dir")).unwrap();
+        std::os::unix::fs::symlink(outside.join("victim"), root.join("link")).unwrap();
+        let opts = ScanOptions {
+            checksum: true,
+            ..Default::default()
+        };
+
+        // Through a symlinked parent: refused.
+        let through = ["dir/victim".to_string()];
+        assert!(describe(&root, &through, &opts).is_err());
+        assert!(pack_entries_to_writer(&root, &through, Vec::new(), false).is_err());
+
+        // A symlink named directly is described and packed as a link.
+        let link = describe(&root, &["link".to_string()], &opts).unwrap();
+        assert_eq!(link[0].kind(), ManifestEntryKind::Symlink);
+        assert!(link[0].sha256.is_empty());
+        let tar = pack_entries_to_writer(&root, &["link".to_string()], Vec::new(), false).unwrap();
+        let mut archive = tar::Archive::new(&tar[..]);
+        let entry = archive.entries().unwrap().next().unwrap().unwrap();
+        assert_eq!(entry.header().entry_type(), tar::EntryType::Symlink);
+
+        // Asked to follow symlinks, readers still do; so does a symlinked root.
+        let follow = ScanOptions {
+            follow_symlinks: true,
+            ..opts
+        };
+        let followed = describe(&root, &through, &follow).unwrap();
+        assert_eq!(followed[0].kind(), ManifestEntryKind::File);
+        assert_eq!(followed[0].size, 7);
+        std::os::unix::fs::symlink(&root, tmp.path().join("alias")).unwrap();
+        let entries = scan(&tmp.path().join("alias"), &ScanOptions::default()).unwrap();
+        assert_eq!(paths(&entries), ["dir", "link", "plain"]);
+    }
+
+    #[test]
+    fn remove_entries_removes_nested_directories() {
+        let tmp = TempDir::new().unwrap();
+        write(tmp.path(), "a/b/c.txt", b"c");
+        write(tmp.path(), "a/d.txt", b"d");
+        std::os::unix::fs::symlink("/", tmp.path().join("a/b/root")).unwrap();
+
+        remove_entries(tmp.path(), &["a".to_string(), "missing/x".to_string()]).unwrap();
+        assert!(!tmp.path().join("a").exists());
+    }
+
+    #[test]
+    fn patch_writer_rejects_escapes_and_missing_files() {
+        let tmp = TempDir::new().unwrap();
+        let mut writer = PatchWriter::new(tmp.path().to_path_buf());
+        for path in ["../x", "/etc/passwd", "missing"] {
+            let chunk = PatchChunk {
+                path: path.into(),
+                ..Default::default()
+            };
+            assert!(writer.apply(&chunk).is_err(), "{path}");
+        }
+    }
+}
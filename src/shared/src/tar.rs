@@ -34,7 +34,20 @@ fn pack_blocking(src: &Path, tar_path: &Path, opts: &PackContext) -> BoxliteResu
             e
         ))
     })?;
-    let mut builder = tar::Builder::new(tar_file);
+    pack_to_writer(src, tar_file, opts).map(drop)
+}
+
+/// Pack `src` (file or directory) as a tar stream written to `writer`,
+/// returning the writer once the archive is finished.
+///
+/// Blocking; async callers run it on `spawn_blocking`. Lets callers stream
+/// the archive without staging it on disk.
+pub fn pack_to_writer<W: std::io::Write>(
+    src: &Path,
+    writer: W,
+    opts: &PackContext,
+) -> BoxliteResult<W> {
+    let mut builder = tar::Builder::new(writer);
     builder.follow_symlinks(opts.follow_symlinks);
 
     if src.is_dir() {
@@ -78,7 +91,7 @@ fn pack_blocking(src: &Path, tar_path: &Path, opts: &PackContext) -> BoxliteResu
     }
 
     builder
-        .finish()
+        .into_inner()
         .map_err(|e| BoxliteError::Storage(format!("failed to finish tar: {}", e)))
 }
 
@@ -332,6 +345,24 @@ mod tests {
         assert_eq!(entries.len(), 1);
     }
 
+    #[test]
+    fn pack_to_writer_streams_archive() {
+        let tmp = TempDir::new().unwrap();
+        let src_dir = tmp.path().join("mydir");
+        std::fs::create_dir(&src_dir).unwrap();
+        std::fs::write(src_dir.join("a.txt"), "aaa").unwrap();
+
+        let bytes = pack_to_writer(&src_dir, Vec::new(), &default_pack()).unwrap();
+
+        let mut archive = tar::Archive::new(&bytes[..]);
+        let names: Vec<String> = archive
+            .entries()
+            .unwrap()
+            .map(|e| e.unwrap().path().unwrap().to_string_lossy().into_owned())
+            .collect();
+        assert!(names.iter().any(|n| n == "mydir/a.txt"), "{names:?}");
+    }
+
     #[tokio::test]
     async fn pack_empty_file() {
         let tmp = TempDir::new().unwrap();